@@ -0,0 +1,99 @@
+#pragma once
+#include <linc/Preprocessor.hpp>
+#include <linc/System.hpp>
+#include <linc/Lexer.hpp>
+#include <linc/Tree.hpp>
+#include <linc/Parser.hpp>
+#include <linc/BoundTree.hpp>
+#include <linc/Binder.hpp>
+#include <linc/Generator.hpp>
+#include <chrono>
+
+namespace linc
+{
+    /// @brief Minimal timing harness shared by the linc benchmarks.
+    class Benchmark final
+    {
+    public:
+        Benchmark() = delete;
+
+        /// @brief Run a callable the given number of times and print the average time taken per iteration.
+        /// @param name The name displayed alongside the measurement.
+        /// @param iterations The number of times the callable is invoked.
+        /// @param function The callable to measure.
+        /// @return The average duration of a single iteration, in nanoseconds.
+        template <typename Function>
+        static Types::f64 measure(std::string_view name, std::size_t iterations, Function function)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            for(std::size_t i{0ul}; i < iterations; ++i)
+                function();
+
+            const auto elapsed = static_cast<Types::f64>(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+            const auto average = elapsed / static_cast<Types::f64>(iterations == 0ul? 1ul: iterations);
+
+            Logger::println("[BENCHMARK] `$` took $ ns/iteration ($ iterations, $ ms total).", name, average, iterations,
+                elapsed / static_cast<Types::f64>(1.0e6));
+            return average;
+        }
+
+        /// @brief Prevent the compiler from discarding a value computed inside of a benchmark.
+        template <typename T>
+        static inline void keep(const T& value)
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+
+        /// @brief Lex, preprocess and parse a complete program.
+        /// @param parser The parser used, retaining its definitions afterwards.
+        /// @param source The raw source code of the program.
+        static Program parseProgram(Parser& parser, const std::string& source)
+        {
+            const auto path = "benchmark";
+            auto code = Code::toSource(source, path);
+            Lexer lexer(code, true);
+            Preprocessor preprocessor(lexer(), path);
+            parser.set(preprocessor(), path);
+
+            return parser();
+        }
+
+        /// @brief Lex, preprocess, parse and bind a complete program.
+        /// @param parser The parser used, retaining its definitions afterwards.
+        /// @param binder The binder used, retaining its symbols afterwards.
+        /// @param source The raw source code of the program.
+        static BoundProgram bindProgram(Parser& parser, Binder& binder, const std::string& source)
+        {
+            auto program = parseProgram(parser, source);
+            return binder.bindProgram(&program);
+        }
+
+        /// @brief Lex, preprocess, parse and bind a single expression.
+        /// @param parser The parser used, which must know of any symbols referenced by the expression.
+        /// @param binder The binder used, which must know of any symbols referenced by the expression.
+        /// @param source The raw source code of the expression.
+        static std::unique_ptr<const BoundExpression> bindExpression(Parser& parser, Binder& binder, const std::string& source)
+        {
+            const auto path = "benchmark";
+            auto code = Code::toSource(source, path);
+            Lexer lexer(code, true);
+            Preprocessor preprocessor(lexer(), path);
+            parser.set(preprocessor(), path);
+
+            auto expression = parser.parseExpression();
+            return expression? binder.bindExpression(expression.get()): nullptr;
+        }
+
+        /// @brief Report any errors pushed while preparing a benchmark.
+        /// @return Whether the benchmark may proceed.
+        static bool check()
+        {
+            if(!Reporting::hasError())
+                return true;
+
+            Logger::println("[BENCHMARK] Benchmark setup failed.");
+            return false;
+        }
+    };
+}
@@ -0,0 +1,144 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#ifdef LINC_LINUX
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <csignal>
+#endif
+
+// Measures a compiled program building strings by concatenation in a loop, which allocates through the runtime's
+// `__memory_alloc` several times per iteration: its running time and, on Linux, the system calls it makes and its peak
+// resident set size. Requires `nasm` (for the runtime) and `ld` in PATH.
+
+static constexpr auto s_source = R"(
+fn main(): i32 {
+    matches: mut i32 = 0;
+    index: mut u32 = 0u;
+
+    while index < 20000u {
+        line: string = "value " + @(index % 100u) + '!';
+        if line == "value 42!" { ++matches; };
+        ++index;
+    };
+
+    matches % 256
+}
+)";
+
+static constexpr int s_expectedStatus{200};
+
+#ifdef LINC_LINUX
+/// @brief Run an executable to completion, stopping it at every system call to count them.
+static std::optional<std::pair<std::size_t, long>> trace(const std::string& executable)
+{
+    const auto child = fork();
+    if(child == 0)
+    {
+        if(ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0)
+            _exit(EXIT_FAILURE);
+
+        dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+        execl(executable.c_str(), executable.c_str(), nullptr);
+        _exit(EXIT_FAILURE);
+    }
+
+    int status{};
+    rusage usage{};
+    std::size_t stops{0ul};
+
+    // the child stops once it executes the program, unless it could not be traced
+    if(wait4(child, &status, 0, &usage) < 0 || !WIFSTOPPED(status))
+        return std::nullopt;
+
+    ptrace(PTRACE_SETOPTIONS, child, nullptr, PTRACE_O_TRACESYSGOOD);
+
+    while(ptrace(PTRACE_SYSCALL, child, nullptr, nullptr) == 0 && wait4(child, &status, 0, &usage) >= 0
+        && !WIFEXITED(status) && !WIFSIGNALED(status))
+        if(WIFSTOPPED(status) && WSTOPSIG(status) == (SIGTRAP | 0x80))
+            ++stops;
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+        return std::nullopt;
+
+    // every system call stops on entry and on exit, but for the final `exit`
+    return std::pair{(stops + 1ul) / 2ul, usage.ru_maxrss};
+}
+#endif
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+
+    if(!linc::Benchmark::check())
+        return EXIT_FAILURE;
+
+    const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+    auto [assembly, has_main] = linc::Generator::operator()(&program, target, true);
+
+    if(!linc::Benchmark::check() || !has_main)
+        return EXIT_FAILURE;
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executable.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_allocator";
+    std::filesystem::create_directories(directory);
+
+    const auto object = (directory / "concatenation.o").string(), runtime = (directory / "runtime.o").string(),
+        executable = (directory / "concatenation").string();
+    linc::Files::write(object, linc::AssemblerAMD64::assemble(assembly).write());
+
+    const auto link = linc::Logger::format("nasm -felf64 $ -o $ && ld -o $ $ $", LINC_BENCHMARK_RUNTIME, runtime, executable,
+        object, runtime);
+
+    if(std::system(link.c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to link the generated code.");
+        return EXIT_FAILURE;
+    }
+
+    int status{};
+
+    linc::Benchmark::measure("compiled string concatenation", iterations, [&]()
+    {
+        status = std::system(executable.c_str());
+    });
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+    {
+        linc::Logger::println("[BENCHMARK] Compiled concatenation exited with status $ instead of $.", WEXITSTATUS(status),
+            s_expectedStatus);
+        return EXIT_FAILURE;
+    }
+
+#ifdef LINC_LINUX
+    if(auto result = trace(executable))
+        linc::Logger::println("[BENCHMARK] compiled string concatenation made $ system calls, with a peak resident set of $ KiB.",
+            result->first, result->second);
+    else linc::Logger::println("[BENCHMARK] Could not trace the system calls of the compiled concatenation.");
+#endif
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,116 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures compiled programs building a long string a character at a time, by appending to it (which reuses the capacity of
+// the string) and by concatenating it with the character (which copies it every time), reading its length at every step.
+// Requires `nasm` (for the runtime) and `ld` in PATH.
+
+static constexpr auto s_appendSource = R"(
+fn main(): i32 {
+    text: mut string;
+    total: mut u64 = 0u64;
+
+    while +text < 20000u64 {
+        text += 'x';
+        total = total + +text;
+    };
+
+    as i32 (total % 251u64)
+}
+)";
+
+static constexpr auto s_concatenationSource = R"(
+fn main(): i32 {
+    text: mut string;
+    total: mut u64 = 0u64;
+
+    while +text < 20000u64 {
+        text = text + 'x';
+        total = total + +text;
+    };
+
+    as i32 (total % 251u64)
+}
+)";
+
+// the sum of the lengths from 1 to 20000, modulo 251
+static constexpr int s_expectedStatus{static_cast<int>((20000ul * 20001ul / 2ul) % 251ul)};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executables.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_appends";
+    std::filesystem::create_directories(directory);
+
+    const auto runtime = (directory / "runtime.o").string();
+    if(std::system(linc::Logger::format("nasm -felf64 $ -o $", LINC_BENCHMARK_RUNTIME, runtime).c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to assemble the runtime.");
+        return EXIT_FAILURE;
+    }
+
+    for(auto [name, source]: {std::pair{"append", s_appendSource}, std::pair{"concatenation", s_concatenationSource}})
+    {
+        linc::Parser parser;
+        linc::Binder binder;
+        auto program = linc::Benchmark::bindProgram(parser, binder, source);
+
+        if(!linc::Benchmark::check())
+            return EXIT_FAILURE;
+
+        const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+        auto [assembly, has_main] = linc::Generator::operator()(&program, target, true);
+
+        if(!linc::Benchmark::check() || !has_main)
+            return EXIT_FAILURE;
+
+        const auto object = (directory / name).string() + ".o", executable = (directory / name).string();
+        linc::Files::write(object, linc::AssemblerAMD64::assemble(assembly).write());
+
+        if(std::system(linc::Logger::format("ld -o $ $ $", executable, object, runtime).c_str()) != 0)
+        {
+            linc::Logger::println("[BENCHMARK] Failed to link the generated code.");
+            return EXIT_FAILURE;
+        }
+
+        int status{};
+
+        linc::Benchmark::measure(linc::Logger::format("compiled string building by $", name), iterations, [&]()
+        {
+            status = std::system(executable.c_str());
+        });
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+        {
+            linc::Logger::println("[BENCHMARK] Compiled string building by $ exited with status $ instead of $.", name,
+                WEXITSTATUS(status), s_expectedStatus);
+            return EXIT_FAILURE;
+        }
+    }
+#else
+    static_cast<void>(iterations);
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
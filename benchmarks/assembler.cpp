@@ -0,0 +1,151 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures encoding the generated AMD64 assembly to an ELF64 object file in-process, and, when `nasm` and `ld` are found in
+// PATH, compares it to assembling the same code with `nasm` and checks that the in-process object links and runs correctly.
+
+static constexpr auto s_source = R"(
+fn triangle(count: u64): u64 {
+    total: mut u64 = 0u64;
+    index: mut u64 = 0u64;
+
+    while index < count {
+        total = total + index;
+        ++index;
+    };
+
+    total
+}
+
+fn digits(value: u32): u32 {
+    count: mut u32 = 1u;
+    rest: mut u32 = value;
+
+    while rest >= 10u {
+        rest = rest / 10u;
+        ++count;
+    };
+
+    count
+}
+
+fn checksum(count: i32): i32 {
+    hash: mut i32 = 7;
+    index: mut i32 = 0;
+
+    while index < count {
+        hash = if index % 3 == 0 { hash * 5 - index } else { hash + index * 11 };
+        hash = hash % 100003;
+        ++index;
+    };
+
+    hash
+}
+
+fn main(): i32 {
+    total: mut u64 = 0u64;
+    round: mut i32 = 0;
+
+    while round < 500 {
+        total = total + triangle(1000u64) + as u64 (digits(4000000000u)) + as u64 (checksum(200));
+        ++round;
+    };
+
+    as i32 (total % 199u64)
+}
+)";
+
+static constexpr int s_expectedStatus{131};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+
+    if(!linc::Benchmark::check())
+        return EXIT_FAILURE;
+
+    const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+    auto [assembly, has_main] = linc::Generator::operator()(&program, target, true);
+
+    if(!linc::Benchmark::check() || !has_main)
+        return EXIT_FAILURE;
+
+    auto object = linc::AssemblerAMD64::assemble(assembly);
+    linc::Logger::println("[BENCHMARK] encoded $ bytes of assembly to $ bytes of code, $ of data, $ symbols and $ relocations.",
+        assembly.size(), object.text.size(), object.data.size(), object.symbols.size(), object.relocations.size());
+
+    linc::Benchmark::measure("assemble in-process", iterations * 100ul, [&]()
+    {
+        linc::Benchmark::keep(linc::AssemblerAMD64::assemble(assembly).write().size());
+    });
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the comparison.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_assembler";
+    std::filesystem::create_directories(directory);
+
+    const auto source = (directory / "program.asm").string(), nasm_object = (directory / "program_nasm.o").string(),
+        linc_object = (directory / "program.o").string(), runtime = (directory / "runtime.o").string();
+    linc::Files::write(source, assembly);
+    linc::Files::write(linc_object, object.write());
+
+    const auto assemble = linc::Logger::format("nasm -felf64 $ -o $", source, nasm_object);
+    int status{};
+
+    linc::Benchmark::measure("assemble with nasm", iterations, [&]()
+    {
+        status = std::system(assemble.c_str());
+    });
+
+    if(status != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to assemble the generated code with `nasm`.");
+        return EXIT_FAILURE;
+    }
+
+    for(const auto& [name, path]: {std::pair{"nasm", nasm_object}, std::pair{"in-process", linc_object}})
+    {
+        const auto executable = (directory / (std::string{name} + "_program")).string();
+        const auto link = linc::Logger::format("nasm -felf64 $ -o $ && ld -o $ $ $", LINC_BENCHMARK_RUNTIME, runtime, executable,
+            path, runtime);
+
+        if(std::system(link.c_str()) != 0)
+        {
+            linc::Logger::println("[BENCHMARK] Failed to link the $ object file.", name);
+            return EXIT_FAILURE;
+        }
+
+        status = std::system(executable.c_str());
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+        {
+            linc::Logger::println("[BENCHMARK] The $ executable exited with status $ instead of $.", name, WEXITSTATUS(status),
+                s_expectedStatus);
+            return EXIT_FAILURE;
+        }
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,39 @@
+add_custom_target(benchmarks)
+
+macro(linc_benchmark name)
+    add_executable(bench_${name} ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/${name}.cpp)
+    target_link_libraries(bench_${name} linc_core)
+    add_custom_command(TARGET benchmarks POST_BUILD
+        COMMAND bench_${name}
+        COMMENT "Running benchmark `${name}`")
+    add_dependencies(benchmarks bench_${name})
+endmacro()
+
+linc_benchmark(dispatch)
+linc_benchmark(vm)
+linc_benchmark(control_flow)
+linc_benchmark(indexing)
+linc_benchmark(types)
+linc_benchmark(symbols)
+linc_benchmark(calls)
+linc_benchmark(codegen)
+target_compile_definitions(bench_codegen PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(emitter)
+linc_benchmark(assembler)
+target_compile_definitions(bench_assembler PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(peephole)
+target_compile_definitions(bench_peephole PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(allocator)
+target_compile_definitions(bench_allocator PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(strings)
+target_compile_definitions(bench_strings PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+target_link_libraries(bench_strings ${CMAKE_DL_LIBS})
+linc_benchmark(appends)
+target_compile_definitions(bench_appends PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(inlining)
+target_compile_definitions(bench_inlining PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
+linc_benchmark(propagation)
+linc_benchmark(evaluation)
+linc_benchmark(memoization)
+linc_benchmark(match)
+target_compile_definitions(bench_match PRIVATE LINC_BENCHMARK_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+
+// Measures the interpreter's function table: evaluating the declarations of many functions with large bodies, as done at
+// startup for every program including the standard library, and a loop dominated by calls to small functions.
+
+static std::string generateSource(std::size_t function_count)
+{
+    std::string source;
+
+    for(std::size_t function{0ul}; function < function_count; ++function)
+    {
+        source.append("fn work" + std::to_string(function) + "(value: i32): i32 {\n    total: mut i32 = value;\n");
+        for(std::size_t statement{0ul}; statement < 32ul; ++statement)
+            source.append("    if total > " + std::to_string(statement) + " total = total - 1 else total = total + 2;\n");
+        source.append("    total\n}\n");
+    }
+
+    source.append(R"(
+fn increment(value: i32): i32 { value + 1 }
+fn twice(value: i32): i32 { increment(increment(value)) }
+
+fn calls(count: i32): i32 {
+    total: mut i32 = 0;
+    for(index: mut i32 = 0 index < count ++index;)
+        total = twice(total);
+    total
+}
+)");
+    return source;
+}
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, generateSource(256ul));
+    auto calls = linc::Benchmark::bindExpression(parser, binder, "calls(1000)");
+
+    if(!linc::Benchmark::check() || !calls)
+        return EXIT_FAILURE;
+
+    linc::Benchmark::measure("interpreter declare 258 functions", iterations, [&]()
+    {
+        linc::Interpreter interpreter;
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+    });
+
+    linc::Interpreter interpreter;
+    for(const auto& declaration: program.declarations)
+        interpreter.evaluateDeclaration(declaration.get());
+
+    linc::Benchmark::measure("interpreter calls(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(calls.get()).getPrimitive().getI32());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,170 @@
+#include "Benchmark.hpp"
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures the AMD64 code generator on loop-heavy kernels (an iterative fibonacci loop, nested collatz loops and a hashing
+// loop), without and with the optimization passes over the intermediate representation: the size of the generated code, how
+// many of its instructions access memory, and, when `nasm` and `ld` are found in PATH, the running time of the assembled
+// executables.
+
+static constexpr auto s_source = R"(
+fn fibonacci_loop(count: u64): u64 {
+    first: mut u64 = 0u64;
+    second: mut u64 = 1u64;
+    index: mut u64 = 0u64;
+
+    while index < count {
+        first = first + second;
+        second = first - second;
+        ++index;
+    };
+
+    first
+}
+
+fn collatz(limit: u32): u32 {
+    steps: mut u32 = 0u;
+    start: mut u32 = 1u;
+
+    while start < limit {
+        value: mut u32 = start;
+        while value != 1u {
+            value = if value % 2u == 0u { value / 2u } else { value * 3u + 1u };
+            ++steps;
+        };
+        ++start;
+    };
+
+    steps
+}
+
+fn mix(count: u32): u32 {
+    hash: mut u32 = 17u;
+    index: mut u32 = 0u;
+
+    while index < count {
+        hash = (hash * 31u + index) ^ (hash >> 3u8);
+        hash = hash - (index & 255u) * 7u;
+        ++index;
+    };
+
+    hash
+}
+
+fn main(): i32 {
+    total: mut u64 = 0u64;
+    round: mut i32 = 0;
+
+    while round < 2000 {
+        total = total + fibonacci_loop(90u64) + as u64 (collatz(300u)) + as u64 (mix(1000u));
+        ++round;
+    };
+
+    as i32 (total % 251u64)
+}
+)";
+
+static constexpr int s_expectedStatus{79};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+
+    if(!linc::Benchmark::check())
+        return EXIT_FAILURE;
+
+    const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+    std::array<std::string, 2ul> assemblies;
+
+    for(bool optimization: {false, true})
+    {
+        auto [assembly, has_main] = linc::Generator::operator()(&program, target, optimization);
+
+        if(!linc::Benchmark::check() || !has_main)
+            return EXIT_FAILURE;
+
+        std::size_t instructions{0ul}, memory_accesses{0ul}, stack_accesses{0ul};
+        std::istringstream lines(assembly);
+
+        for(std::string line; std::getline(lines, line);)
+        {
+            // instructions are the only indented lines that are neither local labels nor directives
+            if(!line.starts_with("    ") || line.ends_with(':') || line.find("global") != std::string::npos)
+                continue;
+
+            ++instructions;
+            if(line.find('[') != std::string::npos)
+                ++memory_accesses;
+            if(line.find("push ") != std::string::npos || line.find("pop ") != std::string::npos)
+                ++stack_accesses;
+        }
+
+        linc::Logger::println("[BENCHMARK] generated $ instructions, $ accessing memory and $ pushes or pops$.", instructions,
+            memory_accesses, stack_accesses, optimization? " with optimization": "");
+
+        linc::Benchmark::measure(optimization? "generate optimized amd64 assembly": "generate amd64 assembly", iterations * 100ul, [&]()
+        {
+            linc::Benchmark::keep(linc::Generator::operator()(&program, target, optimization).first.size());
+        });
+
+        assemblies[optimization] = std::move(assembly);
+    }
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executable.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_codegen";
+    std::filesystem::create_directories(directory);
+
+    for(bool optimization: {false, true})
+    {
+        const std::string name = optimization? "kernels_optimized": "kernels";
+        const auto source = (directory / (name + ".asm")).string(), object = (directory / (name + ".o")).string(),
+            runtime = (directory / "runtime.o").string(), executable = (directory / name).string();
+        linc::Files::write(source, assemblies[optimization]);
+
+        const auto build = linc::Logger::format("nasm -felf64 $ -o $ && nasm -felf64 $ -o $ && ld -o $ $ $", source, object,
+            LINC_BENCHMARK_RUNTIME, runtime, executable, object, runtime);
+
+        if(std::system(build.c_str()) != 0)
+        {
+            linc::Logger::println("[BENCHMARK] Failed to assemble or link the generated code.");
+            return EXIT_FAILURE;
+        }
+
+        int status{};
+
+        linc::Benchmark::measure(optimization? "optimized compiled kernels": "compiled kernels", iterations, [&]()
+        {
+            status = std::system(executable.c_str());
+        });
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+        {
+            linc::Logger::println("[BENCHMARK] Compiled kernels exited with status $ instead of $.", WEXITSTATUS(status), s_expectedStatus);
+            return EXIT_FAILURE;
+        }
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
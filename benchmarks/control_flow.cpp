@@ -0,0 +1,110 @@
+#include "Benchmark.hpp"
+
+// Measures interpreted control flow: early returns out of nested loops, labeled breaks and continues taken on most
+// iterations, compared with the cost of throwing and catching a control-flow exception (as the interpreter used to).
+
+static constexpr auto s_source = R"(
+fn find_first(limit: i32, target: i32): i32 {
+    for(index: mut i32 = 0 index < limit ++index;) {
+        if index == target { return index; };
+    };
+    -1
+}
+
+fn early_returns(count: i32): i32 {
+    total: mut i32 = 0;
+    for(index: mut i32 = 0 index < count ++index;) {
+        total = total + find_first(8, index % 8);
+    };
+    total
+}
+
+fn labeled(count: i32): i32 {
+    hits: mut i32 = 0;
+    for(round: mut i32 = 0 round < count ++round;) {
+        ~search for(i: mut i32 = 0 i < 8 ++i;) {
+            j: mut i32 = 0;
+            while j < 8 {
+                ++j;
+                if (i + j) % 2 == 1 { continue; };
+                if i * j >= round % 16 { ++hits; break search; };
+            };
+        };
+    };
+    hits
+}
+)";
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 20ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+    auto early_returns = linc::Benchmark::bindExpression(parser, binder, "early_returns(1000)");
+    auto labeled = linc::Benchmark::bindExpression(parser, binder, "labeled(1000)");
+
+    if(!linc::Benchmark::check() || !early_returns || !labeled)
+        return EXIT_FAILURE;
+
+    linc::Interpreter interpreter;
+    for(const auto& declaration: program.declarations)
+        interpreter.evaluateDeclaration(declaration.get());
+
+    // The virtual machine implements the same label semantics independently, so it serves as a reference.
+    for(const auto call: {early_returns.get(), labeled.get()})
+    {
+        linc::BytecodeCompiler compiler;
+        linc::VirtualMachine virtual_machine;
+        auto bytecode = compiler.compileProgram(&program, call);
+
+        if(!bytecode)
+        {
+            linc::Logger::println("[BENCHMARK] Could not compile to bytecode: $", compiler.getUnsupportedReason());
+            return EXIT_FAILURE;
+        }
+
+        const auto expected = virtual_machine.execute(*bytecode);
+        const auto actual = interpreter.evaluateExpression(call);
+
+        if(expected != actual)
+        {
+            linc::Logger::println("[BENCHMARK] Result mismatch: interpreter returned $, virtual machine returned $.", actual, expected);
+            return EXIT_FAILURE;
+        }
+    }
+
+    linc::Benchmark::measure("interpreter early_returns(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(early_returns.get()).getPrimitive().getI32());
+    });
+
+    linc::Benchmark::measure("interpreter labeled(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(labeled.get()).getPrimitive().getI32());
+    });
+
+    linc::Benchmark::measure("throw/catch BreakException x1000", iterations, [&]()
+    {
+        int caught{0};
+        for(int i{0}; i < 1000; ++i)
+        {
+            try { throw linc::BreakException{"search"}; }
+            catch(const linc::BreakException& exception) { caught += static_cast<int>(exception.label.size()); }
+        }
+        linc::Benchmark::keep(caught);
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,159 @@
+#include "Benchmark.hpp"
+
+// Compares the cost of resolving the concrete type of a bound node through a chain of dynamic_casts (as the interpreter,
+// optimizer and generator used to) with a switch over BoundNode::getKind(), then measures end-to-end interpretation.
+
+static constexpr auto s_source = R"(
+fn work(limit: i32): i32 {
+    total: mut i32 = 0;
+    index: mut i32 = 0;
+
+    while index < limit {
+        if index % 3 == 0 { total += index * 2; } else { total -= 1; };
+        ++index;
+    };
+
+    total
+}
+)";
+
+static void collectNodes(const linc::BoundNode* node, std::vector<const linc::BoundNode*>& nodes)
+{
+    nodes.push_back(node);
+
+    for(auto child: node->getChildren())
+        if(child)
+            collectNodes(child, nodes);
+}
+
+static int classifyDynamic(const linc::BoundNode* node)
+{
+    using namespace linc;
+
+    if(dynamic_cast<const BoundLiteralExpression*>(node)) return 0;
+    else if(dynamic_cast<const BoundBlockExpression*>(node)) return 1;
+    else if(dynamic_cast<const BoundIfExpression*>(node)) return 2;
+    else if(dynamic_cast<const BoundForExpression*>(node)) return 3;
+    else if(dynamic_cast<const BoundWhileExpression*>(node)) return 4;
+    else if(dynamic_cast<const BoundMatchExpression*>(node)) return 5;
+    else if(dynamic_cast<const BoundBinaryExpression*>(node)) return 6;
+    else if(dynamic_cast<const BoundUnaryExpression*>(node)) return 7;
+    else if(dynamic_cast<const BoundIdentifierExpression*>(node)) return 8;
+    else if(dynamic_cast<const BoundTypeExpression*>(node)) return 9;
+    else if(dynamic_cast<const BoundFunctionCallExpression*>(node)) return 10;
+    else if(dynamic_cast<const BoundExternalCallExpression*>(node)) return 11;
+    else if(dynamic_cast<const BoundConversionExpression*>(node)) return 12;
+    else if(dynamic_cast<const BoundArrayInitializerExpression*>(node)) return 13;
+    else if(dynamic_cast<const BoundStructureInitializerExpression*>(node)) return 14;
+    else if(dynamic_cast<const BoundIndexExpression*>(node)) return 15;
+    else if(dynamic_cast<const BoundAccessExpression*>(node)) return 16;
+    else if(dynamic_cast<const BoundEnumeratorExpression*>(node)) return 17;
+    else if(dynamic_cast<const BoundDeclarationStatement*>(node)) return 18;
+    else if(dynamic_cast<const BoundExpressionStatement*>(node)) return 19;
+    else if(dynamic_cast<const BoundReturnStatement*>(node)) return 20;
+    else if(dynamic_cast<const BoundBreakStatement*>(node)) return 21;
+    else if(dynamic_cast<const BoundContinueStatement*>(node)) return 22;
+    else if(dynamic_cast<const BoundVariableDeclaration*>(node)) return 23;
+    else if(dynamic_cast<const BoundFunctionDeclaration*>(node)) return 24;
+    else return -1;
+}
+
+static int classifyKind(const linc::BoundNode* node)
+{
+    using Kind = linc::BoundNode::Kind;
+
+    switch(node->getKind())
+    {
+    case Kind::LiteralExpression: return 0;
+    case Kind::BlockExpression: return 1;
+    case Kind::IfExpression: return 2;
+    case Kind::ForExpression: return 3;
+    case Kind::WhileExpression: return 4;
+    case Kind::MatchExpression: return 5;
+    case Kind::BinaryExpression: return 6;
+    case Kind::UnaryExpression: return 7;
+    case Kind::IdentifierExpression: return 8;
+    case Kind::TypeExpression: return 9;
+    case Kind::FunctionCallExpression: return 10;
+    case Kind::ExternalCallExpression: return 11;
+    case Kind::ConversionExpression: return 12;
+    case Kind::ArrayInitializerExpression: return 13;
+    case Kind::StructureInitializerExpression: return 14;
+    case Kind::IndexExpression: return 15;
+    case Kind::AccessExpression: return 16;
+    case Kind::EnumeratorExpression: return 17;
+    case Kind::DeclarationStatement: return 18;
+    case Kind::ExpressionStatement: return 19;
+    case Kind::ReturnStatement: return 20;
+    case Kind::BreakStatement: return 21;
+    case Kind::ContinueStatement: return 22;
+    case Kind::VariableDeclaration: return 23;
+    case Kind::FunctionDeclaration: return 24;
+    default: return -1;
+    }
+}
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 20000ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+    auto call = linc::Benchmark::bindExpression(parser, binder, "work(1000)");
+
+    if(!linc::Benchmark::check() || !call)
+        return EXIT_FAILURE;
+
+    std::vector<const linc::BoundNode*> nodes;
+    for(const auto& declaration: program.declarations)
+        collectNodes(declaration.get(), nodes);
+    collectNodes(call.get(), nodes);
+
+    for(auto node: nodes)
+        if(classifyDynamic(node) != classifyKind(node))
+        {
+            linc::Logger::println("[BENCHMARK] Node kind mismatch for node `$`.", node->toString());
+            return EXIT_FAILURE;
+        }
+
+    linc::Logger::println("[BENCHMARK] Dispatching over $ bound nodes.", nodes.size());
+
+    linc::Benchmark::measure("dynamic_cast chain", iterations, [&]()
+    {
+        int sum{0};
+        for(auto node: nodes)
+            sum += classifyDynamic(node);
+        linc::Benchmark::keep(sum);
+    });
+
+    linc::Benchmark::measure("kind switch", iterations, [&]()
+    {
+        int sum{0};
+        for(auto node: nodes)
+            sum += classifyKind(node);
+        linc::Benchmark::keep(sum);
+    });
+
+    linc::Interpreter interpreter;
+    for(const auto& declaration: program.declarations)
+        interpreter.evaluateDeclaration(declaration.get());
+
+    linc::Benchmark::measure("interpreter work(1000)", std::max(iterations / 1000ul, 1ul), [&]()
+    {
+        auto result = interpreter.evaluateExpression(call.get());
+        linc::Benchmark::keep(result.getPrimitive().getI32());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
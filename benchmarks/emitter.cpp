@@ -0,0 +1,82 @@
+#include "Benchmark.hpp"
+
+// Measures recording instructions with the AMD64 emitter, given structured operands as the instruction selector does and
+// as text as the direct code generator does, and rendering the recorded instructions to NASM assembly as a final step.
+
+static constexpr std::size_t s_instructionCount{20000ul};
+
+int main(int argument_count, const char** arguments)
+try {
+    using Emitter = linc::EmitterAMD64;
+    using Size = linc::Registers::Size;
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+
+    auto recordStructured = [](Emitter& emitter)
+    {
+        const auto loop = emitter.getSymbol(emitter.reserveLabel());
+        emitter.label(loop);
+
+        for(std::size_t i{0ul}; i < s_instructionCount / 4ul; ++i)
+        {
+            const auto order = static_cast<std::uint8_t>(8ul + i % 4ul);
+            emitter.binary(Emitter::BinaryInstruction::Move, Emitter::getRegister(order, Size::QuadWord),
+                Emitter::getMemory(LINC_REGISTERS_BASE, -8l * static_cast<linc::Types::i64>(i % 16ul + 1ul), Size::QuadWord));
+            emitter.binary(Emitter::BinaryInstruction::Add, Emitter::getRegister(order, Size::DoubleWord), Emitter::getImmediate(static_cast<linc::Types::i64>(i)));
+            emitter.binary(Emitter::BinaryInstruction::Compare, Emitter::getRegister(order, Size::DoubleWord), Emitter::getImmediate(100l));
+            emitter.unary(Emitter::UnaryInstruction::JumpIfLess, loop);
+        }
+    };
+
+    auto recordText = [](Emitter& emitter)
+    {
+        const auto loop = emitter.label();
+
+        for(std::size_t i{0ul}; i < s_instructionCount / 4ul; ++i)
+        {
+            const auto order = static_cast<std::uint8_t>(8ul + i % 4ul);
+            emitter.binary(Emitter::BinaryInstruction::Move, linc::Registers::getRegister(order, Size::QuadWord),
+                emitter.unaryAddress(linc::Logger::format("rbp - $", 8ul * (i % 16ul + 1ul)), Size::QuadWord));
+            emitter.binary(Emitter::BinaryInstruction::Add, linc::Registers::getRegister(order, Size::DoubleWord), std::to_string(i));
+            emitter.binary(Emitter::BinaryInstruction::Compare, linc::Registers::getRegister(order, Size::DoubleWord), "100");
+            emitter.unary(Emitter::UnaryInstruction::JumpIfLess, loop);
+        }
+    };
+
+    Emitter emitter;
+    recordStructured(emitter);
+    const auto assembly = emitter.get();
+
+    linc::Logger::println("[BENCHMARK] recorded $ instructions of $ bytes each, rendered to $ bytes of assembly.",
+        emitter.getInstructions().size(), sizeof(Emitter::Instruction), assembly.size());
+
+    linc::Benchmark::measure("record structured operands", iterations, [&]()
+    {
+        Emitter emitter;
+        recordStructured(emitter);
+        linc::Benchmark::keep(emitter.getInstructions().size());
+    });
+
+    linc::Benchmark::measure("record text operands", iterations, [&]()
+    {
+        Emitter emitter;
+        recordText(emitter);
+        linc::Benchmark::keep(emitter.getInstructions().size());
+    });
+
+    linc::Benchmark::measure("render assembly", iterations, [&]()
+    {
+        linc::Benchmark::keep(emitter.get().size());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+#include "Benchmark.hpp"
+#include <linc/generator/Optimizer.hpp>
+
+// Measures an interpreted loop whose body calls pure functions with literal arguments, without and with the optimizer,
+// which evaluates those calls ahead of time into literals. Inlining is disabled, so that only the evaluation is measured.
+
+static constexpr auto s_source = R"(
+fn fibonacci(n: u64): u64 {
+    previous: mut u64 = 0u64;
+    current: mut u64 = 1u64;
+    index: mut u64 = 0u64;
+
+    while index < n {
+        next: u64 = previous + current;
+        previous = current;
+        current = next;
+        ++index;
+    };
+
+    previous
+}
+
+fn weigh(count: u64): u64 {
+    total: mut u64 = 0u64;
+    index: mut u64 = 0u64;
+
+    while index < count {
+        total = total + fibonacci(30u64) % 7u64 + fibonacci(12u64);
+        ++index;
+    };
+
+    total
+}
+)";
+
+// fibonacci(30) is 832040, which leaves 6 modulo 7, and fibonacci(12) is 144
+static constexpr linc::Types::u64 s_expected{1000ul * (6ul + 144ul)};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+    linc::Optimizer::setInliningThreshold(0ul);
+
+    for(bool optimize: {false, true})
+    {
+        const auto name = optimize? "optimized": "unoptimized";
+
+        linc::Parser parser;
+        linc::Binder binder;
+        auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+        auto call = linc::Benchmark::bindExpression(parser, binder, "weigh(1000u64)");
+
+        if(!linc::Benchmark::check() || !call)
+            return EXIT_FAILURE;
+
+        if(optimize)
+            program = linc::Optimizer::optimizeProgram(program);
+
+        linc::Interpreter interpreter;
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+
+        linc::Types::u64 result{};
+
+        linc::Benchmark::measure(linc::Logger::format("interpreted $ pure calls", name), iterations, [&]()
+        {
+            result = interpreter.evaluateExpression(call.get()).getPrimitive().getU64();
+        });
+
+        if(result != s_expected)
+        {
+            linc::Logger::println("[BENCHMARK] The $ loop returned $ instead of $.", name, result, s_expected);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+#include "Benchmark.hpp"
+
+// Measures indexing into large arrays held in variables: reads and in-place updates of a brainfuck-sized tape, as well as
+// updates through a structure field. None of these should copy the array they index into, nor should passing the tape
+// to a function that only reads it.
+
+static constexpr auto s_source = R"(
+tape: mut u8[32768u64]
+
+struct Machine {
+    position: mut u64
+    cells: mut u8[32768u64]
+}
+
+fn sweep(count: u64): u8 {
+    total: mut u8 = 0u8;
+    for(index: mut u64 = 0u64 index < count ++index;) {
+        ++tape[index % 32768u64];
+        tape[index % 7u64] += 2u8;
+        total = total + tape[index % 32768u64];
+    };
+    total
+}
+
+fn machine(count: u64): u8 {
+    state: mut Machine = Machine{.position = 0u64, .cells = tape};
+    for(index: mut u64 = 0u64 index < count ++index;) {
+        ++state.cells[state.position];
+        state.position = (state.position + 1u64) % 32768u64;
+    };
+    state.cells[0u64]
+}
+
+fn peek(cells: u8[32768u64], index: u64): u8 { cells[index] }
+
+fn pass(count: u64): u8 {
+    total: mut u8 = 0u8;
+    for(index: mut u64 = 0u64 index < count ++index;) {
+        total = total + peek(tape, index % 32768u64);
+    };
+    total
+}
+)";
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+    auto sweep = linc::Benchmark::bindExpression(parser, binder, "sweep(1000u64)");
+    auto machine = linc::Benchmark::bindExpression(parser, binder, "machine(1000u64)");
+    auto pass = linc::Benchmark::bindExpression(parser, binder, "pass(1000u64)");
+
+    if(!linc::Benchmark::check() || !sweep || !machine || !pass)
+        return EXIT_FAILURE;
+
+    linc::Interpreter interpreter;
+    for(const auto& declaration: program.declarations)
+        interpreter.evaluateDeclaration(declaration.get());
+
+    linc::Benchmark::measure("interpreter sweep(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(sweep.get()).getPrimitive().getU8());
+    });
+
+    linc::Benchmark::measure("interpreter machine(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(machine.get()).getPrimitive().getU8());
+    });
+
+    linc::Benchmark::measure("interpreter pass(1000)", iterations, [&]()
+    {
+        linc::Benchmark::keep(interpreter.evaluateExpression(pass.get()).getPrimitive().getU8());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#include <linc/generator/Optimizer.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures a loop dominated by calls to small character classification helpers, like those of the standard library, with
+// the optimizer's inlining pass disabled and enabled: interpreted, and compiled when `nasm` (for the runtime) and `ld` are
+// in PATH.
+
+static constexpr auto s_source = R"(
+fn to_lower_char(ch: char)
+    if +ch >= +'A' && +ch <= +'Z'
+        as char (+ch + (+'a' - +'A'))
+    else ch
+
+fn is_digit(ch: char) +ch >= +'0' && +ch <= +'9'
+fn is_alpha(ch: char) +ch >= +'A' && +ch <= +'z'
+fn is_alnum(ch: char) is_digit(ch) || is_alpha(ch)
+
+fn classify(count: u64): i32 {
+    text: string = "Linc 0.6, The Quick Brown Fox!";
+    total: mut i32 = 0;
+    index: mut u64 = 0u64;
+
+    while index < count {
+        ch: char = text[index % +text];
+        if is_alnum(ch) { ++total; };
+        if to_lower_char(ch) == 'q' { total = total + 7; };
+        ++index;
+    };
+
+    total % 256
+}
+
+fn main(): i32 classify(20000u64)
+)";
+
+// 22 alphanumeric characters and one 'Q' in every 30 characters, the last 20 holding 14 of them and the 'Q'
+static constexpr int s_expectedStatus{(666 * 22 + 14 + 7 * 667) % 256};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+#ifndef LINC_WINDOWS
+    const bool compile = std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") == 0;
+    if(!compile)
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executables.");
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_inlining";
+    const auto runtime = (directory / "runtime.o").string();
+    std::filesystem::create_directories(directory);
+
+    if(compile && std::system(linc::Logger::format("nasm -felf64 $ -o $", LINC_BENCHMARK_RUNTIME, runtime).c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to assemble the runtime.");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    for(auto threshold: {0ul, linc::Optimizer::defaultInliningThreshold})
+    {
+        const auto name = threshold == 0ul? "without inlining": "with inlining";
+        linc::Optimizer::setInliningThreshold(threshold);
+
+        linc::Parser parser;
+        linc::Binder binder;
+        auto bound_program = linc::Benchmark::bindProgram(parser, binder, s_source);
+        auto call = linc::Benchmark::bindExpression(parser, binder, "classify(20000u64)");
+
+        if(!linc::Benchmark::check() || !call)
+            return EXIT_FAILURE;
+
+        auto program = linc::Optimizer::optimizeProgram(bound_program);
+
+        linc::Interpreter interpreter;
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+
+        int result{};
+
+        linc::Benchmark::measure(linc::Logger::format("interpreted classification $", name), iterations, [&]()
+        {
+            result = interpreter.evaluateExpression(call.get()).getPrimitive().getI32();
+        });
+
+        if(result != s_expectedStatus)
+        {
+            linc::Logger::println("[BENCHMARK] Interpreted classification $ returned $ instead of $.", name, result, s_expectedStatus);
+            return EXIT_FAILURE;
+        }
+
+#ifndef LINC_WINDOWS
+        if(!compile)
+            continue;
+
+        const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+        auto [assembly, has_main] = linc::Generator::operator()(&program, target, true);
+
+        if(!linc::Benchmark::check() || !has_main)
+            return EXIT_FAILURE;
+
+        const auto stem = (directory / (threshold == 0ul? "called": "inlined")).string();
+        linc::Files::write(stem + ".o", linc::AssemblerAMD64::assemble(assembly).write());
+
+        if(std::system(linc::Logger::format("ld -o $ $.o $", stem, stem, runtime).c_str()) != 0)
+        {
+            linc::Logger::println("[BENCHMARK] Failed to link the generated code.");
+            return EXIT_FAILURE;
+        }
+
+        int status{};
+
+        linc::Benchmark::measure(linc::Logger::format("compiled classification $", name), iterations, [&]()
+        {
+            status = std::system(stem.c_str());
+        });
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+        {
+            linc::Logger::println("[BENCHMARK] Compiled classification $ exited with status $ instead of $.", name,
+                WEXITSTATUS(status), s_expectedStatus);
+            return EXIT_FAILURE;
+        }
+#endif
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
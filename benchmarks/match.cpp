@@ -0,0 +1,149 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures a loop dominated by a match expression over 2, 8 and 64 integer arms: interpreted, on the bytecode virtual machine,
+// and compiled when `nasm` (for the runtime) and `ld` are in PATH. Two arms are tested in turn, while more are dispatched on
+// through a jump table.
+
+static constexpr linc::Types::u64 s_count{20000ul};
+
+static std::string makeSource(std::size_t arms)
+{
+    const auto modulus = std::to_string(arms) + "u64";
+    std::string source = "fn dispatch(count: u64): u64 {\n    total: mut u64 = 0u64;\n    index: mut u64 = 0u64;\n\n"
+        "    while index < count {\n        total = total + match index % " + modulus + " {\n";
+
+    for(std::size_t arm{0ul}; arm < arms; ++arm)
+        source.append("            " + std::to_string(arm) + "u64 => " + std::to_string(arm * 7ul + 3ul) + "u64"
+            + (arm + 1ul < arms? ",\n": "\n"));
+
+    source.append("        };\n        ++index;\n    };\n\n    total\n}\n\nfn main(): i32 as i32 (dispatch(");
+    source.append(std::to_string(s_count) + "u64) % 256u64)\n");
+    return source;
+}
+
+static linc::Types::u64 expected(std::size_t arms)
+{
+    linc::Types::u64 total{0ul};
+    for(linc::Types::u64 index{0ul}; index < s_count; ++index)
+        total += index % arms * 7ul + 3ul;
+
+    return total;
+}
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+#ifndef LINC_WINDOWS
+    const bool compile = std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") == 0;
+    if(!compile)
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executables.");
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_match";
+    const auto runtime = (directory / "runtime.o").string();
+    std::filesystem::create_directories(directory);
+
+    if(compile && std::system(linc::Logger::format("nasm -felf64 $ -o $", LINC_BENCHMARK_RUNTIME, runtime).c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to assemble the runtime.");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    for(auto arms: {2ul, 8ul, 64ul})
+    {
+        const auto name = linc::Logger::format("match over $ arms", arms);
+        const auto expected_total = expected(arms);
+
+        linc::Parser parser;
+        linc::Binder binder;
+        auto program = linc::Benchmark::bindProgram(parser, binder, makeSource(arms));
+        auto call = linc::Benchmark::bindExpression(parser, binder, "dispatch(" + std::to_string(s_count) + "u64)");
+
+        if(!linc::Benchmark::check() || !call)
+            return EXIT_FAILURE;
+
+        linc::Interpreter interpreter;
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+
+        linc::BytecodeCompiler compiler;
+        auto bytecode = compiler.compileProgram(&program, call.get());
+
+        if(!bytecode)
+        {
+            linc::Logger::println("[BENCHMARK] The $ could not be compiled to bytecode: $", name, compiler.getUnsupportedReason());
+            return EXIT_FAILURE;
+        }
+
+        linc::VirtualMachine virtual_machine;
+        linc::Types::u64 interpreted{}, executed{};
+
+        linc::Benchmark::measure("interpreted " + name, iterations, [&]()
+        {
+            interpreted = interpreter.evaluateExpression(call.get()).getPrimitive().getU64();
+        });
+
+        linc::Benchmark::measure("virtual machine " + name, iterations, [&]()
+        {
+            executed = virtual_machine.execute(*bytecode).getPrimitive().getU64();
+        });
+
+        if(interpreted != expected_total || executed != expected_total)
+        {
+            linc::Logger::println("[BENCHMARK] The $ returned $ interpreted and $ on the virtual machine instead of $.", name,
+                interpreted, executed, expected_total);
+            return EXIT_FAILURE;
+        }
+
+#ifndef LINC_WINDOWS
+        if(!compile)
+            continue;
+
+        const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+        auto [assembly, has_main] = linc::Generator::operator()(&program, target, true);
+
+        if(!linc::Benchmark::check() || !has_main)
+            return EXIT_FAILURE;
+
+        const auto stem = (directory / ("arms" + std::to_string(arms))).string();
+        linc::Files::write(stem + ".o", linc::AssemblerAMD64::assemble(assembly).write());
+
+        if(std::system(linc::Logger::format("ld -o $ $.o $", stem, stem, runtime).c_str()) != 0)
+        {
+            linc::Logger::println("[BENCHMARK] Failed to link the generated code.");
+            return EXIT_FAILURE;
+        }
+
+        int status{};
+
+        linc::Benchmark::measure("compiled " + name, iterations, [&]()
+        {
+            status = std::system(stem.c_str());
+        });
+
+        const auto expected_status = static_cast<int>(expected_total % 256ul);
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != expected_status)
+        {
+            linc::Logger::println("[BENCHMARK] The compiled $ exited with status $ instead of $.", name, WEXITSTATUS(status), expected_status);
+            return EXIT_FAILURE;
+        }
+#endif
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+#include "Benchmark.hpp"
+
+// Measures an interpreted loop calling a pure function on a small domain of arguments, without memoization and with caches
+// smaller and larger than the domain: the cyclic calls evict every result from the smaller cache before it is used again.
+// The loop counts its runs in a global variable, so that it is not pure, and is not itself memoized.
+
+static constexpr auto s_source = R"(
+fn collatz(n: u64): u64 {
+    steps: mut u64 = 0u64;
+    value: mut u64 = n;
+
+    while value != 1u64 {
+        if value % 2u64 == 0u64 { value = value / 2u64; } else { value = 3u64 * value + 1u64; };
+        ++steps;
+    };
+
+    steps
+}
+
+sums: mut u64 = 0u64
+
+fn sum(count: u64): u64 {
+    total: mut u64 = 0u64;
+    index: mut u64 = 0u64;
+    ++sums;
+
+    while index < count {
+        total = total + collatz(index % 32u64 + 1u64);
+        ++index;
+    };
+
+    total
+}
+)";
+
+static constexpr linc::Types::u64 s_count{3200ul};
+
+static constexpr linc::Types::u64 collatz(linc::Types::u64 value)
+{
+    linc::Types::u64 steps{0ul};
+    for(; value != 1ul; ++steps)
+        value = value % 2ul == 0ul? value / 2ul: 3ul * value + 1ul;
+
+    return steps;
+}
+
+static constexpr linc::Types::u64 s_expected = []()
+{
+    linc::Types::u64 total{0ul};
+    for(linc::Types::u64 index{0ul}; index < s_count; ++index)
+        total += collatz(index % 32ul + 1ul);
+
+    return total;
+}();
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+    auto call = linc::Benchmark::bindExpression(parser, binder, "sum(" + std::to_string(s_count) + "u64)");
+
+    if(!linc::Benchmark::check() || !call)
+        return EXIT_FAILURE;
+
+    for(auto capacity: {0ul, 16ul, 64ul})
+    {
+        linc::Interpreter interpreter;
+        interpreter.setMemoizationCapacity(capacity);
+
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+
+        linc::Types::u64 result{};
+
+        linc::Benchmark::measure(linc::Logger::format("interpreted pure calls (memoization capacity of $)", capacity), iterations, [&]()
+        {
+            result = interpreter.evaluateExpression(call.get()).getPrimitive().getU64();
+        });
+
+        if(result != s_expected)
+        {
+            linc::Logger::println("[BENCHMARK] The loop returned $ instead of $ with a memoization capacity of $.", result, s_expected,
+                capacity);
+            return EXIT_FAILURE;
+        }
+
+        const auto& statistics = interpreter.getMemoizationStatistics();
+        linc::Logger::println("[BENCHMARK] $ hit(s), $ miss(es) and $ eviction(s) with a memoization capacity of $.", statistics.hits,
+            statistics.misses, statistics.evictions, capacity);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
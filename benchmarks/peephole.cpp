@@ -0,0 +1,195 @@
+#include "Benchmark.hpp"
+#include <linc/generator/AssemblerAMD64.hpp>
+#include <linc/generator/PeepholeOptimizerAMD64.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#endif
+
+// Measures the peephole optimizer over a synthetic instruction stream made of the patterns it rewrites, reports how many
+// instructions each of its rules removes from the optimized code generated for branch-heavy kernels, and, when `ld` and `nasm`
+// are found in PATH, checks that the rewritten code still runs correctly.
+
+static constexpr auto s_source = R"(
+fn classify(value: i32): i32 {
+    if value < 0 { 0 - 1 } else if value == 0 { 0 } else if value < 100 { 1 } else { 2 }
+}
+
+fn gcd(first: u32, second: u32): u32 {
+    a: mut u32 = first;
+    b: mut u32 = second;
+
+    while b != 0u {
+        rest: u32 = a % b;
+        a = b;
+        b = rest;
+    };
+
+    a
+}
+
+fn count_between(count: i32, low: i32, high: i32): i32 {
+    total: mut i32 = 0;
+    index: mut i32 = 0;
+
+    while index < count {
+        if index >= low && index <= high { ++total; };
+        if index % 7 == 0 || index % 11 == 0 { total = total + classify(index - 50); };
+        ++index;
+    };
+
+    total
+}
+
+fn main(): i32 {
+    total: mut u32 = 0u;
+    round: mut i32 = 0;
+
+    while round < 300 {
+        total = total + gcd(as u32 (round * 12 + 30), 84u) + as u32 (count_between(500, 100, 400));
+        ++round;
+    };
+
+    as i32 (total % 233u)
+}
+)";
+
+static constexpr int s_expectedStatus{19};
+static constexpr std::size_t s_blockCount{2000ul};
+
+int main(int argument_count, const char** arguments)
+try {
+    using Emitter = linc::EmitterAMD64;
+    using Peephole = linc::PeepholeOptimizerAMD64;
+    using Size = linc::Registers::Size;
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+
+    auto report = [](const Peephole::Statistics& statistics, std::string_view name)
+    {
+        for(std::size_t rule{0ul}; rule < Peephole::ruleCount; ++rule)
+            linc::Logger::println("[BENCHMARK] ($) $ removed $ instruction(s) in $ rewrite(s).", name,
+                Peephole::getRuleName(static_cast<Peephole::Rule>(rule)), statistics[rule].removed, statistics[rule].applied);
+    };
+
+    // every block saves a register around a load, reloads a value it just stored, branches on a comparison through a boolean
+    // and jumps over an unreachable instruction to a jump to the next block
+    Emitter synthetic;
+    std::vector<Emitter::Operand> labels;
+    for(std::size_t i{0ul}; i <= s_blockCount; ++i)
+        labels.push_back(synthetic.getSymbol(synthetic.reserveLabel()));
+
+    const auto rax = Emitter::getRegister(LINC_REGISTERS_A, Size::QuadWord), rcx = Emitter::getRegister(LINC_REGISTERS_C, Size::QuadWord),
+        rdx = Emitter::getRegister(LINC_REGISTERS_D, Size::QuadWord), al = Emitter::getRegister(LINC_REGISTERS_A, Size::Byte),
+        eax = Emitter::getRegister(LINC_REGISTERS_A, Size::DoubleWord);
+
+    for(std::size_t i{0ul}; i < s_blockCount; ++i)
+    {
+        const auto slot = Emitter::getMemory(LINC_REGISTERS_BASE, -8l * static_cast<linc::Types::i64>(i % 8ul + 1ul), Size::QuadWord);
+        const auto trampoline = synthetic.getSymbol(synthetic.reserveLabel());
+
+        synthetic.label(labels[i]);
+        synthetic.push(rax);
+        synthetic.binary(Emitter::BinaryInstruction::Move, rcx, slot);
+        synthetic.pop(rax);
+        synthetic.binary(Emitter::BinaryInstruction::Move, slot, rcx);
+        synthetic.binary(Emitter::BinaryInstruction::Move, rdx, slot);
+        synthetic.binary(Emitter::BinaryInstruction::Compare, rdx, Emitter::getImmediate(static_cast<linc::Types::i64>(i)));
+        synthetic.unary(Emitter::UnaryInstruction::SetIfLess, al);
+        synthetic.binary(Emitter::BinaryInstruction::MoveExtend, eax, al);
+        synthetic.binary(Emitter::BinaryInstruction::Test, al, al);
+        synthetic.unary(Emitter::UnaryInstruction::JumpIfZero, labels[i + 1ul]);
+        synthetic.unary(Emitter::UnaryInstruction::Jump, trampoline);
+        synthetic.binary(Emitter::BinaryInstruction::Add, rax, rcx);
+        synthetic.label(trampoline);
+        synthetic.unary(Emitter::UnaryInstruction::Jump, labels[i + 1ul]);
+    }
+    synthetic.label(labels[s_blockCount]);
+    synthetic.nullary(Emitter::NullaryInstruction::Return);
+
+    {
+        Emitter optimized = synthetic;
+        Peephole peephole(optimized);
+        peephole.run();
+
+        linc::Logger::println("[BENCHMARK] synthetic stream: $ instructions rewritten to $.", synthetic.getInstructions().size(),
+            optimized.getInstructions().size());
+        report(peephole.getStatistics(), "synthetic stream");
+    }
+
+    linc::Benchmark::measure("peephole synthetic stream", iterations, [&]()
+    {
+        Emitter optimized = synthetic;
+        Peephole peephole(optimized);
+        peephole.run();
+        linc::Benchmark::keep(optimized.getInstructions().size());
+    });
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+
+    if(!linc::Benchmark::check())
+        return EXIT_FAILURE;
+
+    linc::GeneratorAMD64 generator(&program, linc::Target::Platform::Unix, true);
+    auto [assembly, has_main] = generator.generateProgram();
+
+    if(!linc::Benchmark::check() || !has_main)
+        return EXIT_FAILURE;
+
+    report(generator.getPeepholeStatistics(), "kernels");
+
+    linc::Benchmark::measure("generate optimized amd64 assembly", iterations * 10ul, [&]()
+    {
+        linc::GeneratorAMD64 generator(&program, linc::Target::Platform::Unix, true);
+        linc::Benchmark::keep(generator.generateProgram().first.size());
+    });
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the executable.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_peephole";
+    std::filesystem::create_directories(directory);
+
+    const auto object = (directory / "kernels.o").string(), runtime = (directory / "runtime.o").string(),
+        executable = (directory / "kernels").string();
+    linc::Files::write(object, linc::AssemblerAMD64::assemble(assembly).write());
+
+    const auto link = linc::Logger::format("nasm -felf64 $ -o $ && ld -o $ $ $", LINC_BENCHMARK_RUNTIME, runtime, executable,
+        object, runtime);
+
+    if(std::system(link.c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to link the generated code.");
+        return EXIT_FAILURE;
+    }
+
+    int status{};
+
+    linc::Benchmark::measure("optimized compiled kernels", iterations, [&]()
+    {
+        status = std::system(executable.c_str());
+    });
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != s_expectedStatus)
+    {
+        linc::Logger::println("[BENCHMARK] Compiled kernels exited with status $ instead of $.", WEXITSTATUS(status), s_expectedStatus);
+        return EXIT_FAILURE;
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
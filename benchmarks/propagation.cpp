@@ -0,0 +1,80 @@
+#include "Benchmark.hpp"
+#include <linc/generator/Optimizer.hpp>
+
+// Measures an interpreted loop whose body computes with immutable variables initialized from literals, without and with
+// the optimizer, which folds them into literals and removes the declarations left unused. Inlining is disabled, so that
+// only the folding, propagation and elimination of dead code are measured.
+
+static constexpr auto s_source = R"(
+fn scale(count: u64): u64 {
+    total: mut u64 = 0u64;
+    index: mut u64 = 0u64;
+
+    while index < count {
+        width: u64 = 16u64;
+        height: u64 = width * 2u64;
+        area: u64 = width * height;
+        margin: u64 = area / 64u64 - 4u64;
+        unused: u64 = area + margin;
+
+        if area > 500u64 { total = total + index % margin; } else { total = total + 1u64; };
+        ++index;
+    };
+
+    total
+}
+)";
+
+// the sum of `index % 4` over 50000 consecutive indices
+static constexpr linc::Types::u64 s_expected{50000ul / 4ul * 6ul};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 5ul;
+    linc::Optimizer::setInliningThreshold(0ul);
+
+    for(bool optimize: {false, true})
+    {
+        const auto name = optimize? "optimized": "unoptimized";
+
+        linc::Parser parser;
+        linc::Binder binder;
+        auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+        auto call = linc::Benchmark::bindExpression(parser, binder, "scale(50000u64)");
+
+        if(!linc::Benchmark::check() || !call)
+            return EXIT_FAILURE;
+
+        if(optimize)
+            program = linc::Optimizer::optimizeProgram(program);
+
+        linc::Interpreter interpreter;
+        for(const auto& declaration: program.declarations)
+            interpreter.evaluateDeclaration(declaration.get());
+
+        linc::Types::u64 result{};
+
+        linc::Benchmark::measure(linc::Logger::format("interpreted $ constants", name), iterations, [&]()
+        {
+            result = interpreter.evaluateExpression(call.get()).getPrimitive().getU64();
+        });
+
+        if(result != s_expected)
+        {
+            linc::Logger::println("[BENCHMARK] The $ loop returned $ instead of $.", name, result, s_expected);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,142 @@
+#include "Benchmark.hpp"
+#ifndef LINC_WINDOWS
+#include <dlfcn.h>
+#endif
+
+// Measures the scalar, SSE2 and AVX2 implementations of the runtime's `__cstring_length`, `__string_equals` and `__memory_copy`
+// across string lengths, checking that they agree. The runtime is assembled and linked into a shared object which is loaded
+// into the benchmark, so this requires `nasm` and `ld` in PATH; the AVX2 implementations are skipped without AVX2 support.
+
+static constexpr std::size_t s_lengths[]{0ul, 7ul, 16ul, 31ul, 64ul, 255ul, 1024ul, 4095ul, 65536ul};
+static constexpr std::size_t s_bytesPerIteration{1ul << 20ul};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+
+#ifndef LINC_WINDOWS
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[BENCHMARK] `nasm` or `ld` not found in PATH; skipping the runtime primitives.");
+        return EXIT_SUCCESS;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / "linc_benchmark_strings";
+    std::filesystem::create_directories(directory);
+
+    const auto runtime = (directory / "runtime.o").string(), library = (directory / "runtime.so").string();
+    const auto link = linc::Logger::format("nasm -felf64 $ -o $ && ld -shared -Bsymbolic -o $ $", LINC_BENCHMARK_RUNTIME, runtime,
+        library, runtime);
+
+    if(std::system(link.c_str()) != 0)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to link the runtime into a shared object.");
+        return EXIT_FAILURE;
+    }
+
+    auto handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(!handle)
+    {
+        linc::Logger::println("[BENCHMARK] Failed to load the runtime: $", dlerror());
+        return EXIT_FAILURE;
+    }
+
+    // the primitives follow the System V calling convention for these signatures
+    using Length = std::uint64_t(*)(const char*);
+    using Equals = std::uint64_t(*)(const char*, const char*);
+    using Copy = void(*)(char*, const char*, std::uint64_t);
+
+    struct Implementation final
+    {
+        std::string_view name;
+        Length length;
+        Equals equals;
+        Copy copy;
+    };
+
+    std::vector<Implementation> implementations;
+    for(std::string_view name: {"scalar", "sse2", "avx2"})
+    {
+        if(name == "avx2" && !__builtin_cpu_supports("avx2"))
+        {
+            linc::Logger::println("[BENCHMARK] The processor does not support AVX2; skipping its implementations.");
+            continue;
+        }
+
+        auto get = [&](std::string_view primitive){ return dlsym(handle, linc::Logger::format("__$_$", primitive, name).c_str()); };
+        implementations.push_back(Implementation{.name = name, .length = reinterpret_cast<Length>(get("cstring_length")),
+            .equals = reinterpret_cast<Equals>(get("string_equals")), .copy = reinterpret_cast<Copy>(get("memory_copy"))});
+
+        if(!implementations.back().length || !implementations.back().equals || !implementations.back().copy)
+        {
+            linc::Logger::println("[BENCHMARK] The runtime does not define the $ primitives.", name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for(auto length: s_lengths)
+    {
+        // misaligned strings, so that the vector implementations handle their first and last blocks
+        std::vector<char> first(length + 64ul, 'a'), second(length + 64ul, 'a'), destination(length + 64ul);
+        auto first_string = first.data() + 3ul, second_string = second.data() + 5ul;
+        first_string[length] = second_string[length] = '\0';
+
+        const auto calls = std::max(s_bytesPerIteration / std::max(length, 16ul), 1ul);
+
+        for(const auto& implementation: implementations)
+        {
+            if(implementation.length(first_string) != length || implementation.equals(first_string, second_string) != ~0ul
+            || (length != 0ul && implementation.equals(first_string, second_string + 1ul) != 0ul))
+            {
+                linc::Logger::println("[BENCHMARK] The $ string primitives are incorrect for $ byte(s).", implementation.name, length);
+                return EXIT_FAILURE;
+            }
+
+            implementation.copy(destination.data() + 1ul, first_string, length);
+            if(!std::equal(first_string, first_string + length, destination.data() + 1ul))
+            {
+                linc::Logger::println("[BENCHMARK] The $ memory copy is incorrect for $ byte(s).", implementation.name, length);
+                return EXIT_FAILURE;
+            }
+
+            linc::Benchmark::measure(linc::Logger::format("$ string length ($ bytes, $ calls)", implementation.name, length, calls),
+                iterations, [&]()
+            {
+                for(std::size_t i{0ul}; i < calls; ++i)
+                    linc::Benchmark::keep(implementation.length(first_string));
+            });
+
+            linc::Benchmark::measure(linc::Logger::format("$ string equality ($ bytes, $ calls)", implementation.name, length, calls),
+                iterations, [&]()
+            {
+                for(std::size_t i{0ul}; i < calls; ++i)
+                    linc::Benchmark::keep(implementation.equals(first_string, second_string));
+            });
+
+            linc::Benchmark::measure(linc::Logger::format("$ memory copy ($ bytes, $ calls)", implementation.name, length, calls),
+                iterations, [&]()
+            {
+                for(std::size_t i{0ul}; i < calls; ++i)
+                    implementation.copy(destination.data() + 1ul, first_string, length);
+                linc::Benchmark::keep(destination.data());
+            });
+        }
+    }
+
+    dlclose(handle);
+#else
+    static_cast<void>(iterations);
+#endif
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,59 @@
+#include "Benchmark.hpp"
+
+// Measures binding a generated program with thousands of call sites. Each call looks up a function whose body is large,
+// which should cost the same as looking up a variable, keeping binding linear in the size of the program.
+
+static std::string generateSource(std::size_t function_count, std::size_t call_count)
+{
+    std::string source;
+
+    for(std::size_t function{0ul}; function < function_count; ++function)
+    {
+        source.append("fn f" + std::to_string(function) + "(value: i32): i32 {\n    total: mut i32 = value;\n");
+        for(std::size_t statement{0ul}; statement < 32ul; ++statement)
+            source.append("    if total > " + std::to_string(statement) + " total = total - 1 else total = total + 2;\n");
+        source.append("    total\n}\n");
+    }
+
+    source.append("fn calls(): i32 {\n    total: mut i32 = 0;\n");
+    for(std::size_t call{0ul}; call < call_count; ++call)
+        source.append("    total = total + f" + std::to_string(call % function_count) + "(total);\n");
+    source.append("    total\n}\n");
+    return source;
+}
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+    const auto source = generateSource(16ul, 4096ul);
+
+    linc::Parser parser;
+    const auto program = linc::Benchmark::parseProgram(parser, source);
+
+    {
+        linc::Binder binder;
+        auto bound_program = binder.bindProgram(&program);
+
+        if(!linc::Benchmark::check())
+            return EXIT_FAILURE;
+    }
+
+    linc::Benchmark::measure("bind 4096 call sites", iterations, [&]()
+    {
+        linc::Binder binder;
+        auto bound_program = binder.bindProgram(&program);
+        linc::Benchmark::keep(bound_program.declarations.size());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
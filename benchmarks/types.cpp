@@ -0,0 +1,63 @@
+#include "Benchmark.hpp"
+
+// Measures binding a program whose structure types nest arrays of structures several levels deep. Every field, argument
+// and access expression copies or compares such types, which should not depend on the size of their expanded tree.
+
+static std::string generateSource(std::size_t depth)
+{
+    std::string source{"struct S0 {\n    values: mut i32[4u64]\n    scale: f64\n}\n"};
+
+    for(std::size_t level{1ul}; level <= depth; ++level)
+    {
+        const auto name = "S" + std::to_string(level), inner = "S" + std::to_string(level - 1ul);
+        source.append("struct " + name + " {\n    inner: mut " + inner + "[2u64]\n    other: mut " + inner + "\n    count: mut i32\n}\n");
+        source.append("fn touch" + std::to_string(level) + "(value: mut " + name + "): i32 {\n"
+            "    value.other = value.inner[1u64];\n"
+            "    value.count = value.count + 1;\n"
+            "    copy: " + name + " = value;\n"
+            "    copy.count\n}\n");
+    }
+
+    std::string chain{"value"};
+    for(std::size_t level{depth}; level != 0ul; --level)
+        chain.append(level % 2ul == 0ul? ".inner[0u64]": ".other");
+
+    const auto top = "S" + std::to_string(depth);
+    source.append("fn deep(value: mut " + top + "): i32 {\n    " + chain + ".values[1u64] = 7;\n    " + chain + ".values[1u64]\n}\n");
+    return source;
+}
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t iterations = argument_count > 1? std::stoul(arguments[1ul]): 10ul;
+    const auto source = generateSource(8ul);
+
+    {
+        linc::Parser parser;
+        linc::Binder binder;
+        linc::Benchmark::bindProgram(parser, binder, source);
+
+        if(!linc::Benchmark::check())
+            return EXIT_FAILURE;
+    }
+
+    linc::Benchmark::measure("bind nested types (depth 8)", iterations, [&]()
+    {
+        linc::Parser parser;
+        linc::Binder binder;
+        auto program = linc::Benchmark::bindProgram(parser, binder, source);
+        linc::Benchmark::keep(program.declarations.size());
+    });
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
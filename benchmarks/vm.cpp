@@ -0,0 +1,169 @@
+#include "Benchmark.hpp"
+
+// Compares the tree-walking interpreter with the register-based bytecode virtual machine on loop-heavy kernels:
+// an iterative fibonacci loop, a loop of function calls, floating point and signed arithmetic, and a brainfuck interpreter
+// loop over a global tape.
+
+static constexpr auto s_source = R"(
+tape: mut u8[16u64]
+position: mut u64
+
+fn fibonacci_loop(count: u64): u64 {
+    first: mut u64 = 0u64;
+    second: mut u64 = 1u64;
+
+    for(index: mut u64 = 0u64 index < count ++index;) {
+        first = first + second;
+        second = first - second;
+    };
+
+    first
+}
+
+fn step(value: u32, index: u32): u32 {
+    if index % 2u == 0u { return value + index; };
+    value ^ index
+}
+
+fn calls(count: u32): u32 {
+    total: mut u32 = 0u;
+    for(index: mut u32 = 0u index < count ++index;) {
+        total = step(total, index);
+    };
+    total
+}
+
+fn series(count: i32): f64 {
+    sum: mut f64 = 0f64;
+    term: mut f64 = 1f64;
+    sign: mut i32 = 1;
+
+    for(index: mut i32 = 0 index < count ++index;) {
+        sum = sum + term * 0.5f64 - term / 3f64;
+        term = term * 0.999f64;
+        sign = -sign * (index % 7 - 3);
+    };
+
+    sum
+}
+
+fn brainfuck(input: string): u64 {
+    current_char: mut char;
+    loop: mut u32 = 0u;
+    steps: mut u64 = 0u64;
+
+    for(i: mut u64 = 0u64 i < +input ++i;) {
+        current_char = input[i];
+        ++steps;
+
+        match current_char {
+            '>' => ++position,
+            '<' => --position,
+            '+' => ++tape[position],
+            '-' => --tape[position],
+            '[' => {
+                if(tape[position] == 0u8) {
+                    loop = 1u;
+                    while(loop > 0u) {
+                        current_char = input[++i];
+                        if current_char == '[' { ++loop; } else if current_char == ']' { --loop; };
+                    };
+                };
+            },
+            ']' => {
+                if(tape[position] != 0u8) {
+                    loop = 1u;
+                    while(loop > 0u) {
+                        current_char = input[--i];
+                        if current_char == '[' { --loop; } else if current_char == ']' { ++loop; };
+                    };
+                };
+            }
+        };
+    };
+
+    steps
+}
+)";
+
+struct Kernel
+{
+    std::string name, call;
+    std::size_t iterations;
+};
+
+int main(int argument_count, const char** arguments)
+try {
+    const std::size_t scale = argument_count > 1? std::stoul(arguments[1ul]): 1ul;
+
+    linc::Parser parser;
+    linc::Binder binder;
+    auto program = linc::Benchmark::bindProgram(parser, binder, s_source);
+
+    if(!linc::Benchmark::check())
+        return EXIT_FAILURE;
+
+    const std::vector<Kernel> kernels{
+        Kernel{.name = "fibonacci_loop(10000)", .call = "fibonacci_loop(10000u64)", .iterations = 5ul},
+        Kernel{.name = "calls(1000)", .call = "calls(1000u)", .iterations = 5ul},
+        Kernel{.name = "series(10000)", .call = "series(10000)", .iterations = 5ul},
+        Kernel{.name = "brainfuck", .call = "brainfuck(\"++++[>++++[>++<-]<-]\")", .iterations = 5ul},
+    };
+
+    linc::Interpreter interpreter;
+    for(const auto& declaration: program.declarations)
+        interpreter.evaluateDeclaration(declaration.get());
+
+    for(const auto& kernel: kernels)
+    {
+        auto call = linc::Benchmark::bindExpression(parser, binder, kernel.call);
+
+        if(!linc::Benchmark::check() || !call)
+            return EXIT_FAILURE;
+
+        linc::BytecodeCompiler compiler;
+        auto bytecode = compiler.compileProgram(&program, call.get());
+
+        if(!bytecode)
+        {
+            linc::Logger::println("[BENCHMARK] `$` could not be compiled to bytecode: $", kernel.name, compiler.getUnsupportedReason());
+            return EXIT_FAILURE;
+        }
+
+        linc::VirtualMachine virtual_machine;
+        const auto expected = interpreter.evaluateExpression(call.get());
+        const auto actual = virtual_machine.execute(*bytecode);
+
+        if(expected != actual)
+        {
+            linc::Logger::println("[BENCHMARK] `$` result mismatch: interpreter returned $, virtual machine returned $.", kernel.name,
+                expected, actual);
+            return EXIT_FAILURE;
+        }
+
+        const auto iterations = kernel.iterations * scale;
+        const auto tree = linc::Benchmark::measure("interpreter " + kernel.name, iterations, [&]()
+        {
+            linc::Benchmark::keep(interpreter.evaluateExpression(call.get()).getKind());
+        });
+
+        const auto vm = linc::Benchmark::measure("virtual machine " + kernel.name, iterations, [&]()
+        {
+            linc::Benchmark::keep(virtual_machine.execute(*bytecode).getKind());
+        });
+
+        linc::Logger::println("[BENCHMARK] `$` speedup: $x.", kernel.name, tree / vm);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch(const linc::Exception& e)
+{
+    linc::Logger::println("[LINC EXCEPTION] $", e.info());
+    return EXIT_FAILURE;
+}
+catch(const std::exception& e)
+{
+    linc::Logger::println("[STANDARD EXCEPTION] $", e.what());
+    return EXIT_FAILURE;
+}
@@ -1,6 +1,10 @@
 #pragma once
 #include <linc/generator/Interpreter.hpp>
+#include <linc/generator/Bytecode.hpp>
+#include <linc/generator/BytecodeCompiler.hpp>
+#include <linc/generator/VirtualMachine.hpp>
 #include <linc/generator/ControlFlowExceptions.hpp>
+#include <linc/generator/RegisterAllocator.hpp>
 #include <linc/generator/GeneratorAMD64.hpp>
 #include <linc/generator/Generator.hpp>
 #include <linc/generator/EmitterAMD64.hpp>
@@ -6,6 +6,7 @@
 #include <linc/bound_tree/BoundBinaryExpression.hpp>
 #include <linc/bound_tree/BoundUnaryExpression.hpp>
 #include <linc/bound_tree/BoundTypeExpression.hpp>
+#include <linc/bound_tree/BoundIdentifierExpression.hpp>
 #include <linc/tree/TypeExpression.hpp>
 
 namespace linc
@@ -22,7 +23,9 @@ namespace linc
         BoundSymbols();
         void clear();
         
-        [[nodiscard]] std::unique_ptr<const class BoundDeclaration> find(const std::string& name, bool top_only = false) const;
+        /// @brief Look up a declared symbol by name, without copying it.
+        /// @return The declaration owned by the symbol table, valid until the scope declaring it ends, or nullptr if not found.
+        [[nodiscard]] const class BoundDeclaration* find(const std::string& name, bool top_only = false) const;
         [[nodiscard]] bool push(std::unique_ptr<const class BoundDeclaration> symbol);
 
         [[nodiscard]] inline std::string findLabel(const std::string& name)
@@ -32,16 +35,62 @@ namespace linc
 
         inline void pushLabel(const std::string& name) { m_labels.push(name); }
         inline void popLabel() { m_labels.pop(); }
-        inline void beginScope() { m_scopes.beginScope(); }
-        inline void endScope() { m_scopes.endScope(); }
+
+        inline void beginScope()
+        {
+            m_scopes.beginScope();
+            m_scopeSlots.push_back(m_frames.back().next);
+        }
+
+        /// @brief End the current scope, releasing the slots of the variables declared in it for reuse.
+        inline void endScope()
+        {
+            m_scopes.endScope();
+            m_frames.back().next = m_scopeSlots.back();
+            m_scopeSlots.pop_back();
+        }
+
+        /// @brief Begin the frame of a function nested in the current one (the global frame being the outermost).
+        inline void beginFrame() { m_frames.push_back(Frame{}); }
+
+        /// @brief End the current function's frame.
+        /// @return The number of slots needed by the frame.
+        [[nodiscard]] inline Types::u64 endFrame()
+        {
+            auto size = m_frames.back().size;
+            m_frames.pop_back();
+            return size;
+        }
+
+        [[nodiscard]] inline Types::u64 getDepth() const { return m_frames.size() - 1ul; }
+
+        /// @brief Reserve a slot for a new variable in the current frame.
+        [[nodiscard]] inline BoundIdentifierExpression::Slot allocateSlot()
+        {
+            auto& frame = m_frames.back();
+            auto slot = BoundIdentifierExpression::Slot{.depth = getDepth(), .index = frame.next++};
+            frame.size = std::max(frame.size, frame.next);
+            return slot;
+        }
+
+        /// @brief Reserve the function table index of a new function declaration.
+        [[nodiscard]] inline Types::u64 allocateFunction() { return m_functionCount++; }
 
         [[nodiscard]] inline std::vector<const std::unique_ptr<const class BoundDeclaration>*> getSymbols() const
         {
             return m_scopes.getSymbols();
         } 
     private:
+        struct Frame final
+        {
+            Types::u64 next{}, size{};
+        };
+
         ScopeStack<std::unique_ptr<const class BoundDeclaration>> m_scopes;
         StringStack m_labels;
+        std::vector<Frame> m_frames{Frame{}};
+        std::vector<Types::u64> m_scopeSlots;
+        Types::u64 m_functionCount{};
     };
 
     /// @brief Class responsible for the binding stage of compilation.
@@ -118,9 +167,19 @@ namespace linc
         [[nodiscard]] BoundBinaryOperator::Kind bindBinaryOperatorKind(Token::Type token_type);
         [[nodiscard]] BoundTypeExpression::BoundArraySpecifiers bindArraySpecifiers(const std::vector<TypeExpression::ArraySpecifier>& specifiers);
 
+        /// @brief Record that the function being bound, if any, is not pure (see BoundFunctionDeclaration::isPure()).
+        inline void markImpure()
+        {
+            if(!m_functionPurity.empty())
+                m_functionPurity.back() = false;
+        }
+
         BoundSymbols m_boundDeclarations;
         Types::u64 m_inLoop{}, m_inFunction{};
         std::stack<std::string> m_matchIdentifiers{};
+
+        /// @brief Whether each of the (nested) functions being bound is pure so far.
+        std::vector<bool> m_functionPurity;
         Types::type m_currentFunctionType{Types::voidType};
     };
 }
\ No newline at end of file
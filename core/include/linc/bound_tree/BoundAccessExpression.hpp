@@ -9,7 +9,7 @@ namespace linc
     {
     public:
         BoundAccessExpression(std::unique_ptr<const BoundExpression> base, Types::u64 index, const Types::type& type)
-            :BoundExpression(type), m_base(std::move(base)), m_index(index)
+            :BoundExpression(Kind::AccessExpression, type), m_base(std::move(base)), m_index(index)
         {}
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override
@@ -12,6 +12,9 @@ namespace linc
         [[nodiscard]] inline const std::vector<std::unique_ptr<const BoundStatement>>& getStatements() const { return m_statements; }
         [[nodiscard]] inline const BoundExpression* const getTail() const { return m_tail? m_tail.get(): nullptr; }
 
+        /// @brief Whether the block directly declares functions or enumerations, which are scoped to it by name.
+        [[nodiscard]] inline bool hasScopedDeclarations() const { return m_hasScopedDeclarations; }
+
         virtual std::unique_ptr<const BoundExpression> clone() const final override;
 
         inline virtual std::vector<const BoundNode*> getChildren() const final override
@@ -26,5 +29,6 @@ namespace linc
         virtual std::string toStringInner() const final override;
         const std::vector<std::unique_ptr<const BoundStatement>> m_statements;
         const std::unique_ptr<const BoundExpression> m_tail;
+        bool m_hasScopedDeclarations{false};
     };
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace linc
     {
     public:
         explicit BoundBreakStatement(std::string_view label_identifier)
-            :m_label(label_identifier)
+            :BoundStatement(Kind::BreakStatement), m_label(label_identifier)
         {}
 
         [[nodiscard]] inline const std::string& getLabel() const { return m_label; }
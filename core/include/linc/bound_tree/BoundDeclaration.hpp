@@ -5,7 +5,11 @@ namespace linc
 {
     class BoundDeclaration : public BoundNode
     {
-    public:        
+    public:
+        BoundDeclaration(Kind kind)
+            :BoundNode(kind)
+        {}
+
         virtual ~BoundDeclaration() = default;
         virtual std::unique_ptr<const BoundDeclaration> clone() const = 0;
     };
@@ -10,7 +10,7 @@ namespace linc
     {
     public:
         BoundEnumerationDeclaration(const std::string& name, std::unique_ptr<const BoundNodeListClause<BoundEnumeratorClause>> enumerators)
-            :m_name(name), m_enumerators(std::move(enumerators)), m_actualType(calculateActualType(m_enumerators.get()))
+            :BoundDeclaration(Kind::EnumerationDeclaration), m_name(name), m_enumerators(std::move(enumerators)), m_actualType(calculateActualType(m_enumerators.get()))
         {}
 
         virtual std::unique_ptr<const BoundDeclaration> clone() const final override
@@ -8,17 +8,21 @@ namespace linc
     {
     public:
         BoundEnumeratorExpression(const std::string& enumeration_name, Types::u64 enumerator_index,
-            std::unique_ptr<const BoundExpression> value, const Types::type& type)
-            :BoundExpression(type), m_enumerationName(std::move(enumeration_name)), m_enumeratorIndex(enumerator_index), m_value(std::move(value))
+            std::unique_ptr<const BoundExpression> value, const Types::type& type, bool binds_value = false)
+            :BoundExpression(Kind::EnumeratorExpression, type), m_enumerationName(std::move(enumeration_name)), m_enumeratorIndex(enumerator_index), m_value(std::move(value)),
+            m_bindsValue(binds_value)
         {}
 
         [[nodiscard]] inline const std::string& getEnumerationName() const { return m_enumerationName; }
         [[nodiscard]] inline Types::u64 getEnumeratorIndex() const { return m_enumeratorIndex; }
         [[nodiscard]] inline const BoundExpression* const getValue() const { return m_value? m_value.get(): nullptr; }
 
+        /// @brief Whether the value is an identifier declared by this (match clause) enumerator, to which the matched value is bound.
+        [[nodiscard]] inline bool bindsValue() const { return m_bindsValue; }
+
         virtual std::unique_ptr<const BoundExpression> clone() const final override
         {
-            return std::make_unique<const BoundEnumeratorExpression>(m_enumerationName, m_enumeratorIndex, m_value? m_value->clone(): nullptr, getType());
+            return std::make_unique<const BoundEnumeratorExpression>(m_enumerationName, m_enumeratorIndex, m_value? m_value->clone(): nullptr, getType(), m_bindsValue);
         }
     private:
         virtual std::string toStringInner() const final override
@@ -28,5 +32,6 @@ namespace linc
         const std::string m_enumerationName;
         const Types::u64 m_enumeratorIndex;
         const std::unique_ptr<const BoundExpression> m_value;
+        const bool m_bindsValue;
     };
 }
\ No newline at end of file
@@ -6,8 +6,8 @@ namespace linc
     class BoundExpression : public BoundNode
     {
     public:
-        BoundExpression(const Types::type& type)
-            :m_type(type)
+        BoundExpression(Kind kind, const Types::type& type)
+            :BoundNode(kind), m_type(type)
         {}
         
         [[nodiscard]] inline const Types::type& getType() const { return m_type; };
@@ -14,9 +14,13 @@ namespace linc
             std::unique_ptr<const BoundExpression> value;
         };
 
-        BoundFunctionCallExpression(Types::type type, const std::string& name, std::vector<Argument> arguments);
+        BoundFunctionCallExpression(Types::type type, const std::string& name, std::vector<Argument> arguments,
+            std::optional<Types::u64> index = std::nullopt);
 
         [[nodiscard]] inline const std::string& getName() const { return m_name; }
+
+        /// @brief The function table index of the called function (see BoundFunctionDeclaration::getIndex()), if it was resolved.
+        [[nodiscard]] inline const std::optional<Types::u64>& getIndex() const { return m_index; }
         [[nodiscard]] inline const std::vector<Argument>& getArguments() const { return m_arguments; }
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override;
@@ -24,5 +28,6 @@ namespace linc
         virtual std::string toStringInner() const final override;
         const std::string m_name;
         const std::vector<Argument> m_arguments;
+        const std::optional<Types::u64> m_index;
     };
 }
\ No newline at end of file
@@ -10,7 +10,8 @@ namespace linc
     {
     public:
         BoundFunctionDeclaration(const Types::type& function_type, const std::string& name,
-            std::vector<std::unique_ptr<const BoundVariableDeclaration>> arguments, std::unique_ptr<const BoundExpression> body);
+            std::vector<std::unique_ptr<const BoundVariableDeclaration>> arguments, std::shared_ptr<const BoundExpression> body,
+            Types::u64 depth, Types::u64 frame_size, Types::u64 index, bool pure);
 
         [[nodiscard]] inline const Types::type& getReturnType() const { return *m_functionType.function.returnType; }
         [[nodiscard]] inline const Types::type& getFunctionType() const { return m_functionType; }
@@ -18,6 +19,23 @@ namespace linc
         [[nodiscard]] inline const std::vector<std::unique_ptr<const BoundVariableDeclaration>>& getArguments() const { return m_arguments; }
         [[nodiscard]] inline const BoundExpression* const getBody() const { return m_body.get(); }
 
+        /// @brief The body is immutable, so that clones of the declaration and function tables can share it instead of copying it.
+        [[nodiscard]] inline const std::shared_ptr<const BoundExpression>& getSharedBody() const { return m_body; }
+        
+        /// @brief The function nesting depth of the function's frame, shared by the slots of its arguments and locals.
+        [[nodiscard]] inline Types::u64 getDepth() const { return m_depth; }
+
+        /// @brief The number of slots needed by the function's frame (its arguments come first).
+        [[nodiscard]] inline Types::u64 getFrameSize() const { return m_frameSize; }
+
+        /// @brief The index of the function in the function table, unique among the functions declared by a binder.
+        [[nodiscard]] inline Types::u64 getIndex() const { return m_index; }
+
+        /// @brief Whether the function's result only depends on its arguments and it has no effects: it accesses no variables
+        /// outside of its frame (but global constants initialized with literals), and makes no external calls or calls to
+        /// functions that are not pure.
+        [[nodiscard]] inline bool isPure() const { return m_pure; }
+
         [[nodiscard]] inline auto getDefaultArgumentCount() const
         {
             std::vector<std::unique_ptr<const BoundVariableDeclaration>>::size_type count{};
@@ -46,6 +64,8 @@ namespace linc
         const Types::type m_functionType;
         const std::string m_name;
         const std::vector<std::unique_ptr<const BoundVariableDeclaration>> m_arguments;
-        const std::unique_ptr<const BoundExpression> m_body;
+        const std::shared_ptr<const BoundExpression> m_body;
+        const Types::u64 m_depth, m_frameSize, m_index;
+        const bool m_pure;
     };
 }
\ No newline at end of file
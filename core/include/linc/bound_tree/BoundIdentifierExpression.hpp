@@ -6,12 +6,21 @@ namespace linc
     class BoundIdentifierExpression final : public BoundExpression
     {
     public:
-        BoundIdentifierExpression(const std::string& value, const Types::type type);
+        /// @brief Location of a variable resolved at bind time: the function nesting depth of the frame holding it
+        /// (0 being the global frame) and its index within that frame.
+        struct Slot final
+        {
+            Types::u64 depth{}, index{};
+        };
+
+        BoundIdentifierExpression(const std::string& value, const Types::type type, std::optional<Slot> slot = std::nullopt);
         [[nodiscard]] const std::string& getValue() const;
+        [[nodiscard]] inline const std::optional<Slot>& getSlot() const { return m_slot; }
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override;
     private:
         virtual std::string toStringInner() const final override;
         const std::string m_value;
+        const std::optional<Slot> m_slot;
     };
-}
\ No newline at end of file
+}
@@ -8,10 +8,51 @@ namespace linc
     class BoundMatchExpression final : public BoundExpression
     {
     public:
+        /// @brief How the clause matching the tested value is found without testing every value in order, when all of them are known
+        /// at compile time: literals, or enumerators (of an enumeration test) whose value is void or bound by the clause. Integral,
+        /// character and boolean values, along with the indices of enumerators, are keyed as 64-bit integers and looked up in a table
+        /// when they are dense, or by binary search over the sorted keys otherwise; strings are hashed.
+        struct Dispatch final
+        {
+            enum class Kind: unsigned char
+            {
+                Table, Tree, Hash
+            };
+
+            static constexpr std::size_t noClause{std::numeric_limits<std::size_t>::max()};
+
+            /// @brief The fewest values worth dispatching over, below which testing them in order is as fast.
+            static constexpr std::size_t minimumValues{4ul};
+
+            /// @brief The largest table, and the lowest ratio of values to its entries, for which keys are looked up in a table.
+            static constexpr std::size_t maximumTableSize{4096ul}, minimumTableDensity{3ul};
+
+            Kind kind;
+
+            /// @brief Whether the keys are ordered as signed integers.
+            bool isSigned{};
+
+            /// @brief The key of the first entry of the table.
+            Types::u64 minimum{};
+
+            /// @brief The clause matching every key from the minimum on, noClause for the keys no clause matches.
+            std::vector<std::size_t> table{};
+
+            /// @brief The key of every value along with the first clause it belongs to, sorted by key.
+            std::vector<std::pair<Types::u64, std::size_t>> cases{};
+
+            std::unordered_map<Types::string, std::size_t> strings{};
+
+            /// @brief Get the key of a primitive value, if it can be keyed as an integer.
+            [[nodiscard]] static std::optional<Types::u64> getKey(const PrimitiveValue& value);
+
+            /// @brief Get the index of the clause matching a key, or noClause.
+            [[nodiscard]] std::size_t find(Types::u64 key) const;
+            [[nodiscard]] std::size_t find(const Types::string& key) const;
+        };
+
         BoundMatchExpression(std::unique_ptr<const BoundExpression> test_expression,
-            std::unique_ptr<const BoundNodeListClause<BoundMatchClause>> clauses, const Types::type& type)
-            :BoundExpression(type), m_testExpression(std::move(test_expression)), m_clauses(std::move(clauses))
-        {}
+            std::unique_ptr<const BoundNodeListClause<BoundMatchClause>> clauses, const Types::type& type);
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override
         {
@@ -25,9 +66,15 @@ namespace linc
 
         [[nodiscard]] inline const BoundExpression* const getTestExpression() const { return m_testExpression.get(); }
         [[nodiscard]] inline const BoundNodeListClause<BoundMatchClause>* const getClauses() const { return m_clauses.get(); }
+
+        /// @brief The dispatch of the match expression, if its clauses can be found without testing their values in order.
+        [[nodiscard]] inline const std::optional<Dispatch>& getDispatch() const { return m_dispatch; }
     private:
         virtual std::string toStringInner() const final override { return "Match Expression"; }
+        std::optional<Dispatch> computeDispatch() const;
+
         const std::unique_ptr<const BoundExpression> m_testExpression;
         const std::unique_ptr<const BoundNodeListClause<BoundMatchClause>> m_clauses;
+        const std::optional<Dispatch> m_dispatch;
     };
-}
\ No newline at end of file
+}
@@ -10,12 +10,29 @@ namespace linc
     class BoundNode 
     {
     public:
-        BoundNode(const Token::Info& info = Token::Info{.file = {}, .line = {}})
-            :m_info(info)
+        /// @brief Tag identifying the concrete type of a bound node, allowing consumers of the bound tree to dispatch with a
+        /// switch and static_cast instead of chained dynamic_casts. Expressions, declarations and statements are kept in
+        /// contiguous ranges, in that order.
+        enum class Kind: unsigned char
+        {
+            LiteralExpression, IdentifierExpression, BlockExpression, TypeExpression, IfExpression, WhileExpression,
+            MatchExpression, ForExpression, UnaryExpression, BinaryExpression, FunctionCallExpression, ExternalCallExpression,
+            ConversionExpression, ArrayInitializerExpression, StructureInitializerExpression, IndexExpression, AccessExpression,
+            EnumeratorExpression, ShellExpression,
+            VariableDeclaration, FunctionDeclaration, ExternalDeclaration, StructureDeclaration, EnumerationDeclaration,
+            DeclarationStatement, ExpressionStatement, ReturnStatement, BreakStatement, ContinueStatement
+        };
+
+        BoundNode(Kind kind, const Token::Info& info = Token::Info{.file = {}, .line = {}})
+            :m_kind(kind), m_info(info)
         {}
         virtual ~BoundNode() = default;
         virtual std::vector<const BoundNode*> getChildren() const { return std::vector<const BoundNode*>{}; }
 
+        [[nodiscard]] inline Kind getKind() const { return m_kind; }
+        [[nodiscard]] inline bool isExpression() const { return m_kind <= Kind::ShellExpression; }
+        [[nodiscard]] inline bool isDeclaration() const { return m_kind >= Kind::VariableDeclaration && m_kind <= Kind::EnumerationDeclaration; }
+        [[nodiscard]] inline bool isStatement() const { return m_kind >= Kind::DeclarationStatement; }
         [[nodiscard]] inline const Token::Info& getInfo() const { return m_info; }
         [[nodiscard]] virtual std::string toString() const
         {
@@ -27,6 +44,7 @@ namespace linc
     protected:
         virtual std::string toStringInner() const = 0;
     private:
+        const Kind m_kind;
         const Token::Info m_info;
     };
 }
\ No newline at end of file
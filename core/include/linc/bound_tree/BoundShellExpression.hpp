@@ -8,7 +8,7 @@ namespace linc
     {
     public:
         BoundShellExpression(std::unique_ptr<const BoundExpression> expression)
-            :BoundExpression(Types::fromKind(Types::Kind::string)), m_expression(std::move(expression))
+            :BoundExpression(Kind::ShellExpression, Types::fromKind(Types::Kind::string)), m_expression(std::move(expression))
         {}
 
         [[nodiscard]] const BoundExpression* const getExpression() const { return m_expression.get(); }
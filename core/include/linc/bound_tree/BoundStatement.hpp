@@ -6,6 +6,10 @@ namespace linc
     class BoundStatement : public BoundNode
     {
     public:
+        BoundStatement(Kind kind)
+            :BoundNode(kind)
+        {}
+
         virtual ~BoundStatement() = default;
         virtual std::unique_ptr<const BoundStatement> clone() const = 0;
     };
@@ -9,7 +9,7 @@ namespace linc
     {
     public:
         BoundStructureDeclaration(const std::string& name, std::vector<std::unique_ptr<const BoundVariableDeclaration>> fields)
-            :m_name(name), m_fields(std::move(fields))
+            :BoundDeclaration(Kind::StructureDeclaration), m_name(name), m_fields(std::move(fields))
         {}
 
         virtual std::unique_ptr<const BoundDeclaration> clone() const final override
@@ -31,7 +31,7 @@ namespace linc
             Types::type::Structure types;
             
             for(const auto& field: m_fields)
-                types.push_back(std::pair(field->getName(), field->getActualType().clone()));
+                types.push_back(std::pair(field->getName(), field->getActualType().intern()));
 
             return Types::type(std::move(types));
         }
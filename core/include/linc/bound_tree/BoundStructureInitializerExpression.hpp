@@ -8,7 +8,7 @@ namespace linc
     {
     public:
         BoundStructureInitializerExpression(const std::string& name, std::vector<std::unique_ptr<const BoundExpression>> fields, const Types::type& type)
-            :BoundExpression(type), m_name(name), m_fields(std::move(fields))
+            :BoundExpression(Kind::StructureInitializerExpression, type), m_name(name), m_fields(std::move(fields))
         {}
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override
@@ -21,34 +21,16 @@ namespace linc
         [[nodiscard]] inline const Root& getBase() const { return m_root; }
         [[nodiscard]] inline Types::type getActualType() const
         {
-            std::unique_ptr<Types::type> root{nullptr};
-            if(auto kind = std::get_if<Types::type::Primitive>(&m_root))
-                root = std::make_unique<Types::type>(*kind, m_isMutable);
-            else if(auto structure = std::get_if<Types::type::Structure>(&m_root))
-                root = std::make_unique<Types::type>(Types::type::cloneStructure(structure, m_isMutable), m_isMutable);
-            else if(auto enumeration = std::get_if<Types::type::Enumeration>(&m_root))
-                root = std::make_unique<Types::type>(*enumeration, m_isMutable);
-            else root = std::make_unique<Types::type>(Types::type::cloneFunction(&std::get<Types::type::Function>(m_root)), m_isMutable);
+            auto root = std::visit([&](const auto& base){ return Types::type(base, m_isMutable); }, m_root);
 
             if(m_arraySpecifiers.empty())
-                return *root;
-            else
-            {
-                Types::type result(Types::type::Array{.baseType = root->clone(),
-                    .count = m_arraySpecifiers.back()}, m_isMutable);
-                auto cursor = &result;
+                return root;
 
-                for(std::size_t i{m_arraySpecifiers.size()}; i != 1ul; --i)
-                {
-                    cursor->array.baseType = std::make_unique<Types::type>(Types::type::Array{
-                        .baseType = i == 2ul? root->clone() :nullptr,
-                        .count = m_arraySpecifiers[i - 2ul]
-                    }, m_isMutable);
-                    cursor = const_cast<Types::type*>(cursor->array.baseType.get());
-                }
+            const Types::type* base_type = root.intern();
+            for(std::size_t i{0ul}; i + 1ul < m_arraySpecifiers.size(); ++i)
+                base_type = Types::type(Types::type::Array{.baseType = base_type, .count = m_arraySpecifiers[i]}, m_isMutable).intern();
 
-                return result;
-            }
+            return Types::type(Types::type::Array{.baseType = base_type, .count = m_arraySpecifiers.back()}, m_isMutable);
         }
 
         virtual std::unique_ptr<const BoundExpression> clone() const final override;
@@ -10,10 +10,14 @@ namespace linc
     class BoundVariableDeclaration final : public BoundDeclaration
     {
     public:
-        BoundVariableDeclaration(Types::type type, const std::string& name, std::optional<std::unique_ptr<const BoundExpression>> default_value);
+        using Slot = BoundIdentifierExpression::Slot;
+
+        BoundVariableDeclaration(Types::type type, const std::string& name, std::optional<std::unique_ptr<const BoundExpression>> default_value,
+            Slot slot);
 
         [[nodiscard]] inline const Types::type& getActualType() const { return m_actualType; }
         [[nodiscard]] inline const std::string& getName() const { return m_name; }
+        [[nodiscard]] inline const Slot& getSlot() const { return m_slot; }
         [[nodiscard]] inline const std::optional<const BoundExpression* const> getDefaultValue() const
         {
             return m_defaultValue.has_value()?
@@ -33,5 +37,6 @@ namespace linc
         const Types::type m_actualType;
         const std::string m_name;
         const std::optional<std::unique_ptr<const BoundExpression>> m_defaultValue;
+        const Slot m_slot;
     };
 }
\ No newline at end of file
@@ -0,0 +1,994 @@
+#pragma once
+#include <linc/generator/ObjectFileELF64.hpp>
+#include <linc/system/Logger.hpp>
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief Encodes the NASM assembly produced by EmitterAMD64 to x86-64 machine code in-process, without going through an
+    /// external assembler. Only the subset of NASM the emitter produces is supported: `segment`, `global` and `extern` directives,
+    /// labels, `db`/`dw`/`dd`/`dq` data definitions (`dq` in the data section may also list labels), and the general purpose and scalar SSE instructions it emits, with register,
+    /// immediate and `[base + index + displacement]` or `[label]` memory operands. Anything else is reported by throwing.
+    class AssemblerAMD64 final
+    {
+    public:
+        /// @brief Assemble a complete program to a relocatable object file.
+        static ObjectFileELF64 assemble(std::string_view source)
+        {
+            AssemblerAMD64 assembler;
+
+            for(std::size_t start{0ul}, end{}; start < source.size(); start = end + 1ul)
+            {
+                end = source.find('\n', start);
+                if(end == std::string_view::npos)
+                    end = source.size();
+
+                assembler.assembleLine(source.substr(start, end - start));
+            }
+
+            return assembler.link();
+        }
+    private:
+        using RelocationType = ObjectFileELF64::RelocationType;
+        using Section = ObjectFileELF64::Section;
+
+        struct Operand final
+        {
+            enum class Kind: unsigned char
+            {
+                Register, Vector, Memory, Immediate, Symbol
+            };
+
+            Kind kind;
+
+            /// @brief The size in bytes of a register, or of a memory access (zero if not specified).
+            std::size_t size{};
+            std::uint8_t code{};
+            bool isHighByte{}, requiresPrefix{};
+
+            std::optional<std::uint8_t> base{}, index{};
+            Types::i64 value{};
+            std::string symbol{};
+        };
+
+        struct Fixup final
+        {
+            std::size_t offset;
+            std::string symbol;
+            RelocationType type;
+            Types::i64 addend;
+        };
+
+        enum class Branch: unsigned char
+        {
+            None, Jump, Conditional, Call
+        };
+
+        /// @brief An encoded instruction of the text section, or a jump or call to a label whose encoding depends on the final
+        /// layout.
+        struct Item final
+        {
+            std::string bytes{};
+            std::vector<Fixup> fixups{};
+            Branch branch{Branch::None};
+            std::uint8_t condition{};
+            std::string target{};
+            bool isLong{};
+        };
+
+        struct Label final
+        {
+            Section section;
+            std::size_t position;
+        };
+
+        AssemblerAMD64() = default;
+
+        [[noreturn]] static void fail(std::string_view message, std::string_view line)
+        {
+            throw LINC_EXCEPTION_INVALID_INPUT(Logger::format("Cannot assemble `$`: $", line, message));
+        }
+
+        static std::string_view trim(std::string_view string)
+        {
+            auto start = string.find_first_not_of(" \t\r");
+            if(start == std::string_view::npos)
+                return std::string_view{};
+
+            auto end = string.find_last_not_of(" \t\r");
+            return string.substr(start, end - start + 1ul);
+        }
+
+        /// @brief Split a list on commas outside of quotes and brackets.
+        static std::vector<std::string_view> split(std::string_view list)
+        {
+            std::vector<std::string_view> items;
+            std::size_t start{0ul}, depth{0ul};
+            char quote{};
+
+            for(std::size_t i{0ul}; i < list.size(); ++i)
+            {
+                auto character = list[i];
+                if(quote)
+                {
+                    if(character == quote)
+                        quote = '\0';
+                }
+                else if(character == '"' || character == '\'' || character == '`')
+                    quote = character;
+                else if(character == '[')
+                    ++depth;
+                else if(character == ']' && depth != 0ul)
+                    --depth;
+                else if(character == ',' && depth == 0ul)
+                {
+                    items.push_back(trim(list.substr(start, i - start)));
+                    start = i + 1ul;
+                }
+            }
+
+            if(auto last = trim(list.substr(start)); !last.empty() || !items.empty())
+                items.push_back(last);
+
+            return items;
+        }
+
+        static bool isIdentifierCharacter(char character)
+        {
+            return std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '.' || character == '$'
+                || character == '@' || character == '?';
+        }
+
+        static std::optional<Types::i64> parseNumber(std::string_view text)
+        {
+            bool negative{};
+            if(!text.empty() && (text.front() == '-' || text.front() == '+'))
+            {
+                negative = text.front() == '-';
+                text = trim(text.substr(1ul));
+            }
+
+            if(text.empty() || !std::isdigit(static_cast<unsigned char>(text.front())))
+                return std::nullopt;
+
+            int base{10};
+            if(text.size() > 2ul && text[0ul] == '0' && (text[1ul] == 'x' || text[1ul] == 'X'))
+            {
+                base = 16;
+                text.remove_prefix(2ul);
+            }
+
+            Types::u64 value{};
+            for(auto character: text)
+            {
+                auto digit = std::isdigit(static_cast<unsigned char>(character))? character - '0':
+                    base == 16 && std::isxdigit(static_cast<unsigned char>(character))? std::tolower(character) - 'a' + 10: -1;
+                if(digit < 0)
+                    return std::nullopt;
+
+                value = value * static_cast<Types::u64>(base) + static_cast<Types::u64>(digit);
+            }
+
+            return static_cast<Types::i64>(negative? ~value + 1ul: value);
+        }
+
+        static std::optional<Operand> parseRegister(std::string_view name)
+        {
+            static const std::array<std::string_view, 16ul> quad{"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi"},
+                double_word{"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi"}, word{"ax", "cx", "dx", "bx", "sp", "bp", "si", "di"},
+                byte{"al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil"};
+            static const std::array<std::string_view, 4ul> high{"ah", "ch", "dh", "bh"};
+
+            for(std::uint8_t code{0u}; code < 8u; ++code)
+            {
+                if(name == quad[code]) return Operand{.kind = Operand::Kind::Register, .size = 8ul, .code = code};
+                if(name == double_word[code]) return Operand{.kind = Operand::Kind::Register, .size = 4ul, .code = code};
+                if(name == word[code]) return Operand{.kind = Operand::Kind::Register, .size = 2ul, .code = code};
+                if(name == byte[code]) return Operand{.kind = Operand::Kind::Register, .size = 1ul, .code = code, .requiresPrefix = code >= 4u};
+            }
+
+            for(std::uint8_t code{0u}; code < 4u; ++code)
+                if(name == high[code])
+                    return Operand{.kind = Operand::Kind::Register, .size = 1ul, .code = static_cast<std::uint8_t>(code + 4u), .isHighByte = true};
+
+            auto numbered = [&](std::string_view prefix, std::size_t size, Operand::Kind kind) -> std::optional<Operand>
+            {
+                if(!name.starts_with(prefix))
+                    return std::nullopt;
+
+                auto rest = name.substr(prefix.size());
+                std::size_t digits{0ul};
+                while(digits < rest.size() && std::isdigit(static_cast<unsigned char>(rest[digits])))
+                    ++digits;
+
+                if(digits == 0ul)
+                    return std::nullopt;
+
+                auto number = std::stoul(std::string{rest.substr(0ul, digits)});
+                auto suffix = rest.substr(digits);
+
+                if(kind == Operand::Kind::Register)
+                {
+                    if(number < 8ul || number > 15ul)
+                        return std::nullopt;
+
+                    size = suffix == "d"? 4ul: suffix == "w"? 2ul: suffix == "b"? 1ul: suffix.empty()? 8ul: 0ul;
+                }
+                else if(number > 15ul || !suffix.empty())
+                    return std::nullopt;
+
+                if(size == 0ul)
+                    return std::nullopt;
+
+                return Operand{.kind = kind, .size = size, .code = static_cast<std::uint8_t>(number)};
+            };
+
+            if(auto vector = numbered("xmm", 16ul, Operand::Kind::Vector))
+                return vector;
+
+            return numbered("r", 8ul, Operand::Kind::Register);
+        }
+
+        static Operand parseOperand(std::string_view text, std::string_view line)
+        {
+            static const std::array<std::pair<std::string_view, std::size_t>, 4ul> sizes{
+                std::pair{"byte", 1ul}, std::pair{"word", 2ul}, std::pair{"dword", 4ul}, std::pair{"qword", 8ul}
+            };
+
+            std::size_t size{};
+            for(const auto& [keyword, keyword_size]: sizes)
+                if(text.starts_with(keyword) && text.size() > keyword.size() && !isIdentifierCharacter(text[keyword.size()]))
+                {
+                    size = keyword_size;
+                    text = trim(text.substr(keyword.size()));
+                    break;
+                }
+
+            if(text.starts_with('['))
+            {
+                if(!text.ends_with(']'))
+                    fail("unterminated memory operand", line);
+
+                Operand memory{.kind = Operand::Kind::Memory, .size = size};
+                auto expression = text.substr(1ul, text.size() - 2ul);
+                bool negative{};
+
+                for(std::size_t i{0ul}; i < expression.size();)
+                {
+                    auto character = expression[i];
+                    if(character == ' ' || character == '\t') { ++i; continue; }
+                    if(character == '+' || character == '-') { negative = character == '-'; ++i; continue; }
+
+                    auto end = i;
+                    while(end < expression.size() && isIdentifierCharacter(expression[end]))
+                        ++end;
+
+                    if(end == i)
+                        fail("unsupported memory operand", line);
+
+                    auto term = expression.substr(i, end - i);
+                    i = end;
+
+                    if(auto number = parseNumber(term))
+                        memory.value += negative? -*number: *number;
+                    else if(auto reg = parseRegister(term); reg && reg->kind == Operand::Kind::Register && reg->size == 8ul && !negative)
+                    {
+                        if(!memory.base) memory.base = reg->code;
+                        else if(!memory.index && reg->code != 4u) memory.index = reg->code;
+                        else fail("unsupported memory operand", line);
+                    }
+                    else if(memory.symbol.empty() && !negative && !reg)
+                        memory.symbol = std::string{term};
+                    else fail("unsupported memory operand", line);
+
+                    negative = false;
+                }
+
+                if(!memory.symbol.empty() && memory.base)
+                    fail("a label cannot be combined with registers", line);
+
+                return memory;
+            }
+
+            if(size != 0ul)
+                fail("size specifier on a non-memory operand", line);
+
+            if(auto reg = parseRegister(text))
+                return *reg;
+
+            if(auto number = parseNumber(text))
+                return Operand{.kind = Operand::Kind::Immediate, .value = *number};
+
+            if(!text.empty() && std::all_of(text.begin(), text.end(), isIdentifierCharacter))
+                return Operand{.kind = Operand::Kind::Symbol, .symbol = std::string{text}};
+
+            fail("unsupported operand", line);
+        }
+
+        /// @brief Get the full name of a label, local labels (starting with a period) belonging to the last non-local one.
+        std::string qualify(std::string_view name) const
+        {
+            return name.starts_with('.')? m_scope + std::string{name}: std::string{name};
+        }
+
+        void assembleLine(std::string_view line)
+        {
+            auto text = trim(line.substr(0ul, findComment(line)));
+            if(text.empty())
+                return;
+
+            auto space = text.find_first_of(" \t");
+            auto word = text.substr(0ul, space);
+            auto rest = space == std::string_view::npos? std::string_view{}: trim(text.substr(space));
+
+            if(word == "segment" || word == "section")
+            {
+                if(rest == ".data") m_section = Section::Data;
+                else if(rest == ".text") m_section = Section::Text;
+                else fail("unsupported section", line);
+                return;
+            }
+
+            if(word == "global" || word == "extern")
+            {
+                for(auto name: split(rest))
+                    (word == "global"? m_globals: m_externals).insert(std::string{name});
+                return;
+            }
+
+            if(word == "default" || word == "bits")
+                fail("unsupported directive", line);
+
+            // a label, optionally followed by a definition or an instruction on the same line
+            if(auto colon = text.find(':'); colon != std::string_view::npos && colon != 0ul
+                && std::all_of(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(colon), isIdentifierCharacter))
+            {
+                defineLabel(text.substr(0ul, colon), line);
+                return assembleLine(text.substr(colon + 1ul));
+            }
+
+            if(word == "db" || word == "dw" || word == "dd" || word == "dq")
+                return define(word, rest, line);
+
+            if(m_section != Section::Text)
+                fail("instruction outside of the text section", line);
+
+            std::string mnemonic{word};
+            std::transform(mnemonic.begin(), mnemonic.end(), mnemonic.begin(), [](unsigned char c){ return std::tolower(c); });
+
+            std::vector<Operand> operands;
+            for(auto operand: split(rest))
+                operands.push_back(parseOperand(operand, line));
+
+            encode(mnemonic, operands, line);
+        }
+
+        static std::size_t findComment(std::string_view line)
+        {
+            char quote{};
+            for(std::size_t i{0ul}; i < line.size(); ++i)
+                if(quote)
+                {
+                    if(line[i] == quote)
+                        quote = '\0';
+                }
+                else if(line[i] == '"' || line[i] == '\'' || line[i] == '`')
+                    quote = line[i];
+                else if(line[i] == ';')
+                    return i;
+
+            return line.size();
+        }
+
+        void defineLabel(std::string_view name, std::string_view line)
+        {
+            auto full_name = qualify(name);
+            if(!name.starts_with('.'))
+                m_scope = full_name;
+
+            if(m_section == Section::Undefined)
+                fail("label outside of any section", line);
+
+            auto position = m_section == Section::Data? m_data.size(): m_items.size();
+            if(!m_labels.emplace(full_name, Label{.section = m_section, .position = position}).second)
+                fail("label redefined", line);
+
+            m_labelOrder.push_back(full_name);
+            m_isLabelPending = m_section == Section::Text;
+        }
+
+        void define(std::string_view directive, std::string_view list, std::string_view line)
+        {
+            const std::size_t size = directive == "db"? 1ul: directive == "dw"? 2ul: directive == "dd"? 4ul: 8ul;
+            auto& output = m_section == Section::Data? m_data: current().bytes;
+
+            for(auto item: split(list))
+            {
+                if(item.size() >= 2ul && (item.front() == '"' || item.front() == '\'') && item.back() == item.front())
+                {
+                    auto contents = item.substr(1ul, item.size() - 2ul);
+                    output.append(contents);
+                    output.append((size - contents.size() % size) % size, '\0');
+                }
+                else if(auto number = parseNumber(item))
+                    put(output, static_cast<Types::u64>(*number), size);
+                else if(m_section == Section::Data && size == 8ul && !item.empty() && std::all_of(item.begin(), item.end(), isIdentifierCharacter))
+                {
+                    m_dataFixups.push_back(Fixup{.offset = output.size(), .symbol = qualify(item), .type = RelocationType::Absolute64, .addend = 0l});
+                    put(output, 0ul, size);
+                }
+                else fail("unsupported data definition", line);
+            }
+        }
+
+        /// @brief Get the item raw bytes are appended to, starting a new one if the last item is a branch.
+        Item& current()
+        {
+            // a label defined after the last item refers to the next one, which must then not be appended to the last
+            if(m_items.empty() || m_items.back().branch != Branch::None || m_isLabelPending)
+                m_items.emplace_back();
+
+            m_isLabelPending = false;
+            return m_items.back();
+        }
+
+        static void put(std::string& output, Types::u64 value, std::size_t size)
+        {
+            for(std::size_t i{0ul}; i < size; ++i)
+                output.push_back(static_cast<char>((value >> (8ul * i)) & 0xFFu));
+        }
+
+        static bool fitsByte(Types::i64 value) { return value >= -128l && value <= 127l; }
+        static bool fitsDoubleWord(Types::i64 value) { return value >= -2147483648l && value <= 2147483647l; }
+
+        /// @brief Truncate an immediate to the size it is encoded with, rejecting values that do not fit.
+        static Types::i64 immediate(Types::i64 value, std::size_t size, std::string_view line)
+        {
+            switch(size)
+            {
+            case 1ul: if(value < -128l || value > 255l) fail("immediate out of range", line); break;
+            case 2ul: if(value < -32768l || value > 65535l) fail("immediate out of range", line); break;
+            case 4ul: if(value < -2147483648l || value > 4294967295l) fail("immediate out of range", line); break;
+            default: break;
+            }
+
+            return value;
+        }
+
+        struct Encoding final
+        {
+            std::string_view prefix{};
+            std::string_view opcode;
+            std::uint8_t reg{};
+            bool isWide{}, hasOperandSizePrefix{};
+            std::size_t immediateSize{};
+            Types::i64 immediateValue{};
+        };
+
+        /// @brief Append an instruction with a ModRM byte addressing the specified register or memory operand.
+        void emitModRM(const Encoding& encoding, const Operand& rm, std::string_view line, const Operand* reg_operand = nullptr)
+        {
+            auto& item = current();
+            auto& bytes = item.bytes;
+
+            if(encoding.hasOperandSizePrefix)
+                bytes.push_back('\x66');
+            bytes.append(encoding.prefix);
+
+            std::uint8_t rex = encoding.isWide? 0x48u: 0x40u;
+            bool requires_prefix = (reg_operand && reg_operand->requiresPrefix) || rm.requiresPrefix;
+            bool has_high_byte = (reg_operand && reg_operand->isHighByte) || rm.isHighByte;
+
+            if(encoding.reg >= 8u) rex |= 0x04u;
+            if(rm.kind == Operand::Kind::Memory)
+            {
+                if(rm.index && *rm.index >= 8u) rex |= 0x02u;
+                if(rm.base && *rm.base >= 8u) rex |= 0x01u;
+            }
+            else if(rm.code >= 8u) rex |= 0x01u;
+
+            if(rex != 0x40u || requires_prefix)
+            {
+                if(has_high_byte)
+                    fail("high byte register used with a REX prefix", line);
+                bytes.push_back(static_cast<char>(rex));
+            }
+
+            bytes.append(encoding.opcode);
+            const auto reg_bits = static_cast<std::uint8_t>((encoding.reg & 7u) << 3u);
+
+            if(rm.kind != Operand::Kind::Memory)
+                bytes.push_back(static_cast<char>(0xC0u | reg_bits | (rm.code & 7u)));
+            else if(!rm.symbol.empty() || (!rm.base && !rm.index))
+            {
+                if(rm.symbol.empty())
+                {
+                    // absolute address, which requires a SIB byte without base or index
+                    bytes.push_back(static_cast<char>(reg_bits | 4u));
+                    bytes.push_back('\x25');
+                    put(bytes, static_cast<Types::u64>(rm.value), 4ul);
+                }
+                else
+                {
+                    // labels are addressed relatively to the instruction pointer, which points past the immediate
+                    bytes.push_back(static_cast<char>(reg_bits | 5u));
+                    item.fixups.push_back(Fixup{.offset = bytes.size(), .symbol = qualify(rm.symbol), .type = RelocationType::Relative32,
+                        .addend = rm.value - 4l - static_cast<Types::i64>(encoding.immediateSize)});
+                    put(bytes, 0ul, 4ul);
+                }
+            }
+            else
+            {
+                auto base = rm.base.value_or(5u);
+                const bool needs_base_displacement = !rm.base || (base & 7u) == 5u;
+                std::uint8_t mode = !rm.base? 0u: rm.value == 0l && !needs_base_displacement? 0u: fitsByte(rm.value)? 1u: 2u;
+
+                if(!fitsDoubleWord(rm.value))
+                    fail("displacement out of range", line);
+
+                if(rm.index || (base & 7u) == 4u)
+                {
+                    bytes.push_back(static_cast<char>((mode << 6u) | reg_bits | 4u));
+                    bytes.push_back(static_cast<char>(((rm.index.value_or(4u) & 7u) << 3u) | (base & 7u)));
+                }
+                else bytes.push_back(static_cast<char>((mode << 6u) | reg_bits | (base & 7u)));
+
+                if(mode == 1u)
+                    put(bytes, static_cast<Types::u64>(rm.value), 1ul);
+                else if(mode == 2u || !rm.base)
+                    put(bytes, static_cast<Types::u64>(rm.value), 4ul);
+            }
+
+            if(encoding.immediateSize != 0ul)
+                put(bytes, static_cast<Types::u64>(encoding.immediateValue), encoding.immediateSize);
+        }
+
+        /// @brief Append an instruction without a ModRM byte, with an optional register encoded in the low bits of the opcode.
+        void emitPlain(std::string_view opcode, std::optional<std::uint8_t> reg = std::nullopt, bool is_wide = false,
+            std::size_t immediate_size = 0ul, Types::i64 immediate_value = 0l, bool has_operand_size_prefix = false)
+        {
+            auto& bytes = current().bytes;
+            if(has_operand_size_prefix)
+                bytes.push_back('\x66');
+
+            std::uint8_t rex = is_wide? 0x48u: 0x40u;
+            if(reg && *reg >= 8u)
+                rex |= 0x01u;
+            if(rex != 0x40u)
+                bytes.push_back(static_cast<char>(rex));
+
+            std::string code{opcode};
+            if(reg)
+                code.back() = static_cast<char>(static_cast<std::uint8_t>(code.back()) + (*reg & 7u));
+
+            bytes.append(code);
+            if(immediate_size != 0ul)
+                put(bytes, static_cast<Types::u64>(immediate_value), immediate_size);
+        }
+
+        static std::optional<std::uint8_t> getCondition(std::string_view suffix)
+        {
+            static const std::array<std::pair<std::string_view, std::uint8_t>, 30ul> conditions{
+                std::pair{"o", 0u}, std::pair{"no", 1u}, std::pair{"b", 2u}, std::pair{"c", 2u}, std::pair{"nae", 2u},
+                std::pair{"ae", 3u}, std::pair{"nb", 3u}, std::pair{"nc", 3u}, std::pair{"e", 4u}, std::pair{"z", 4u},
+                std::pair{"ne", 5u}, std::pair{"nz", 5u}, std::pair{"be", 6u}, std::pair{"na", 6u}, std::pair{"a", 7u},
+                std::pair{"nbe", 7u}, std::pair{"s", 8u}, std::pair{"ns", 9u}, std::pair{"p", 10u}, std::pair{"pe", 10u},
+                std::pair{"np", 11u}, std::pair{"po", 11u}, std::pair{"l", 12u}, std::pair{"nge", 12u}, std::pair{"ge", 13u},
+                std::pair{"nl", 13u}, std::pair{"le", 14u}, std::pair{"ng", 14u}, std::pair{"g", 15u}, std::pair{"nle", 15u}
+            };
+
+            for(const auto& [name, code]: conditions)
+                if(name == suffix)
+                    return code;
+
+            return std::nullopt;
+        }
+
+        void encode(const std::string& mnemonic, std::vector<Operand>& operands, std::string_view line)
+        {
+            using Kind = Operand::Kind;
+            auto count = operands.size();
+            auto is = [&](std::size_t index, Kind kind){ return index < count && operands[index].kind == kind; };
+            auto isRegisterOrMemory = [&](std::size_t index){ return is(index, Kind::Register) || is(index, Kind::Memory); };
+
+            // the size of the operation, given by a register operand or the size specifier of a memory operand
+            auto getSize = [&]()
+            {
+                for(const auto& operand: operands)
+                    if(operand.kind == Kind::Register)
+                        return operand.size;
+                for(const auto& operand: operands)
+                    if(operand.kind == Kind::Memory && operand.size != 0ul)
+                        return operand.size;
+
+                fail("operand size not specified", line);
+            };
+
+            auto sized = [&](std::size_t size, std::string_view byte_opcode, std::string_view opcode, std::uint8_t reg, const Operand& rm,
+                std::size_t immediate_size = 0ul, Types::i64 immediate_value = 0l, const Operand* reg_operand = nullptr)
+            {
+                emitModRM(Encoding{.opcode = size == 1ul? byte_opcode: opcode, .reg = reg, .isWide = size == 8ul,
+                    .hasOperandSizePrefix = size == 2ul, .immediateSize = immediate_size, .immediateValue = immediate_value}, rm, line, reg_operand);
+            };
+
+            static const std::unordered_map<std::string_view, std::uint8_t> arithmetic{
+                {"add", 0u}, {"or", 1u}, {"adc", 2u}, {"sbb", 3u}, {"and", 4u}, {"sub", 5u}, {"xor", 6u}, {"cmp", 7u}
+            };
+
+            if(auto find = arithmetic.find(mnemonic); find != arithmetic.end() && count == 2ul)
+            {
+                const auto size = getSize();
+                const auto base = static_cast<char>(find->second << 3u);
+
+                if(isRegisterOrMemory(0ul) && is(1ul, Kind::Register))
+                    return sized(size, std::string{base}, std::string(1ul, static_cast<char>(base + 1)), operands[1ul].code, operands[0ul],
+                        0ul, 0l, &operands[1ul]);
+                if(is(0ul, Kind::Register) && is(1ul, Kind::Memory))
+                    return sized(size, std::string(1ul, static_cast<char>(base + 2)), std::string(1ul, static_cast<char>(base + 3)),
+                        operands[0ul].code, operands[1ul], 0ul, 0l, &operands[0ul]);
+                if(isRegisterOrMemory(0ul) && is(1ul, Kind::Immediate))
+                {
+                    auto value = immediate(operands[1ul].value, std::min(size, 4ul), line);
+                    if(size == 1ul)
+                        return sized(size, "\x80", "\x80", find->second, operands[0ul], 1ul, value);
+                    if(fitsByte(size == 2ul? static_cast<Types::i16>(value): size == 4ul? static_cast<Types::i32>(value): value))
+                        return sized(size, "\x83", "\x83", find->second, operands[0ul], 1ul, value);
+                    if(size == 8ul && !fitsDoubleWord(value))
+                        fail("immediate out of range", line);
+                    return sized(size, "\x81", "\x81", find->second, operands[0ul], size == 2ul? 2ul: 4ul, value);
+                }
+            }
+            else if(mnemonic == "test" && count == 2ul && isRegisterOrMemory(0ul))
+            {
+                const auto size = getSize();
+                if(is(1ul, Kind::Register))
+                    return sized(size, "\x84", "\x85", operands[1ul].code, operands[0ul], 0ul, 0l, &operands[1ul]);
+                if(is(1ul, Kind::Immediate))
+                    return sized(size, "\xF6", "\xF7", 0u, operands[0ul], std::min(size, 4ul), immediate(operands[1ul].value, std::min(size, 4ul), line));
+            }
+            else if(mnemonic == "mov" && count == 2ul)
+            {
+                if(isRegisterOrMemory(0ul) && is(1ul, Kind::Register))
+                    return sized(getSize(), "\x88", "\x89", operands[1ul].code, operands[0ul], 0ul, 0l, &operands[1ul]);
+                if(is(0ul, Kind::Register) && is(1ul, Kind::Memory))
+                    return sized(getSize(), "\x8A", "\x8B", operands[0ul].code, operands[1ul], 0ul, 0l, &operands[0ul]);
+                if(is(0ul, Kind::Register) && is(1ul, Kind::Immediate))
+                {
+                    const auto& target = operands[0ul];
+                    auto value = operands[1ul].value;
+
+                    if(target.requiresPrefix || target.isHighByte || target.size == 1ul)
+                        return sized(1ul, "\xC6", "\xC6", 0u, target, 1ul, immediate(value, 1ul, line));
+                    if(target.size == 8ul && fitsDoubleWord(value))
+                        return sized(8ul, "", "\xC7", 0u, target, 4ul, value);
+                    if(target.size == 8ul && value >= 0l && value <= 4294967295l)
+                        return emitPlain("\xB8", target.code, false, 4ul, value);
+                    return emitPlain("\xB8", target.code, target.size == 8ul, target.size, immediate(value, target.size, line), target.size == 2ul);
+                }
+                if(is(0ul, Kind::Memory) && is(1ul, Kind::Immediate))
+                {
+                    const auto size = getSize();
+                    if(size == 8ul && !fitsDoubleWord(operands[1ul].value))
+                        fail("immediate out of range", line);
+                    return sized(size, "\xC6", "\xC7", 0u, operands[0ul], std::min(size, 4ul), immediate(operands[1ul].value, std::min(size, 4ul), line));
+                }
+                if(is(0ul, Kind::Register) && operands[0ul].size == 8ul && is(1ul, Kind::Symbol))
+                {
+                    emitPlain("\xB8", operands[0ul].code, true);
+                    auto& item = current();
+                    item.fixups.push_back(Fixup{.offset = item.bytes.size(), .symbol = qualify(operands[1ul].symbol),
+                        .type = RelocationType::Absolute64, .addend = 0l});
+                    return put(item.bytes, 0ul, 8ul);
+                }
+            }
+            else if((mnemonic == "movzx" || mnemonic == "movsx") && count == 2ul && is(0ul, Kind::Register) && isRegisterOrMemory(1ul))
+            {
+                const auto source_size = operands[1ul].size;
+                if(source_size != 1ul && source_size != 2ul)
+                    fail("unsupported source size", line);
+
+                const bool is_signed = mnemonic == "movsx";
+                std::string opcode{'\x0F', static_cast<char>((is_signed? 0xBEu: 0xB6u) + (source_size == 2ul? 1u: 0u))};
+                return emitModRM(Encoding{.opcode = opcode, .reg = operands[0ul].code, .isWide = operands[0ul].size == 8ul,
+                    .hasOperandSizePrefix = operands[0ul].size == 2ul}, operands[1ul], line, &operands[0ul]);
+            }
+            else if(mnemonic == "movsxd" && count == 2ul && is(0ul, Kind::Register) && isRegisterOrMemory(1ul))
+                return emitModRM(Encoding{.opcode = "\x63", .reg = operands[0ul].code, .isWide = true}, operands[1ul], line);
+            else if(mnemonic.starts_with("cmov") && count == 2ul && is(0ul, Kind::Register) && isRegisterOrMemory(1ul))
+            {
+                if(auto condition = getCondition(std::string_view{mnemonic}.substr(4ul)))
+                    return emitModRM(Encoding{.opcode = std::string{'\x0F', static_cast<char>(0x40u + *condition)}, .reg = operands[0ul].code,
+                        .isWide = operands[0ul].size == 8ul, .hasOperandSizePrefix = operands[0ul].size == 2ul}, operands[1ul], line);
+            }
+            else if(mnemonic == "imul" && count >= 2ul && is(0ul, Kind::Register))
+            {
+                const auto size = operands[0ul].size;
+                if(count == 2ul && isRegisterOrMemory(1ul))
+                    return emitModRM(Encoding{.opcode = "\x0F\xAF", .reg = operands[0ul].code, .isWide = size == 8ul,
+                        .hasOperandSizePrefix = size == 2ul}, operands[1ul], line);
+
+                const auto& source = count == 3ul? operands[1ul]: operands[0ul];
+                const auto& factor = operands[count - 1ul];
+                if(factor.kind == Kind::Immediate && (source.kind == Kind::Register || source.kind == Kind::Memory))
+                {
+                    auto value = immediate(factor.value, std::min(size, 4ul), line);
+                    bool is_byte = fitsByte(size == 2ul? static_cast<Types::i16>(value): size == 4ul? static_cast<Types::i32>(value): value);
+                    return emitModRM(Encoding{.opcode = is_byte? "\x6B": "\x69", .reg = operands[0ul].code, .isWide = size == 8ul,
+                        .hasOperandSizePrefix = size == 2ul, .immediateSize = is_byte? 1ul: size == 2ul? 2ul: 4ul, .immediateValue = value},
+                        source, line);
+                }
+            }
+
+            static const std::unordered_map<std::string_view, std::uint8_t> group{
+                {"not", 2u}, {"neg", 3u}, {"mul", 4u}, {"imul", 5u}, {"div", 6u}, {"idiv", 7u}
+            };
+
+            if(auto find = group.find(mnemonic); find != group.end() && count == 1ul && isRegisterOrMemory(0ul))
+                return sized(getSize(), "\xF6", "\xF7", find->second, operands[0ul]);
+
+            if((mnemonic == "inc" || mnemonic == "dec") && count == 1ul && isRegisterOrMemory(0ul))
+                return sized(getSize(), "\xFE", "\xFF", mnemonic == "inc"? 0u: 1u, operands[0ul]);
+
+            static const std::unordered_map<std::string_view, std::uint8_t> shifts{
+                {"rol", 0u}, {"ror", 1u}, {"shl", 4u}, {"sal", 4u}, {"shr", 5u}, {"sar", 7u}
+            };
+
+            if(auto find = shifts.find(mnemonic); find != shifts.end() && count == 2ul && isRegisterOrMemory(0ul))
+            {
+                const auto size = operands[0ul].size;
+                if(size == 0ul)
+                    fail("operand size not specified", line);
+
+                if(is(1ul, Kind::Register) && operands[1ul].size == 1ul && operands[1ul].code == 1u && !operands[1ul].isHighByte)
+                    return sized(size, "\xD2", "\xD3", find->second, operands[0ul]);
+                if(is(1ul, Kind::Immediate))
+                {
+                    auto value = operands[1ul].value & 0xFFl;
+                    if(value == 1l)
+                        return sized(size, "\xD0", "\xD1", find->second, operands[0ul]);
+                    return sized(size, "\xC0", "\xC1", find->second, operands[0ul], 1ul, value);
+                }
+            }
+
+            if(mnemonic == "push" && count == 1ul)
+            {
+                if(is(0ul, Kind::Register) && operands[0ul].size == 8ul)
+                    return emitPlain("\x50", operands[0ul].code);
+                if(is(0ul, Kind::Immediate))
+                {
+                    auto value = operands[0ul].value;
+                    if(fitsByte(value))
+                        return emitPlain("\x6A", std::nullopt, false, 1ul, value);
+                    if(!fitsDoubleWord(value))
+                        fail("immediate out of range", line);
+                    return emitPlain("\x68", std::nullopt, false, 4ul, value);
+                }
+                if(is(0ul, Kind::Memory))
+                    return emitModRM(Encoding{.opcode = "\xFF", .reg = 6u}, operands[0ul], line);
+            }
+
+            if(mnemonic == "pop" && count == 1ul)
+            {
+                if(is(0ul, Kind::Register) && operands[0ul].size == 8ul)
+                    return emitPlain("\x58", operands[0ul].code);
+                if(is(0ul, Kind::Memory))
+                    return emitModRM(Encoding{.opcode = "\x8F", .reg = 0u}, operands[0ul], line);
+            }
+
+            if(mnemonic.starts_with("set") && count == 1ul && isRegisterOrMemory(0ul))
+                if(auto condition = getCondition(std::string_view{mnemonic}.substr(3ul)))
+                    return emitModRM(Encoding{.opcode = std::string{'\x0F', static_cast<char>(0x90u + *condition)}}, operands[0ul], line);
+
+            if((mnemonic == "jmp" || mnemonic == "call") && count == 1ul)
+            {
+                if(is(0ul, Kind::Symbol))
+                    return branch(mnemonic == "jmp"? Branch::Jump: Branch::Call, 0u, operands[0ul].symbol);
+                if(isRegisterOrMemory(0ul))
+                    return emitModRM(Encoding{.opcode = "\xFF", .reg = static_cast<std::uint8_t>(mnemonic == "jmp"? 4u: 2u)}, operands[0ul], line);
+            }
+
+            if(mnemonic.starts_with('j') && count == 1ul && is(0ul, Kind::Symbol))
+                if(auto condition = getCondition(std::string_view{mnemonic}.substr(1ul)))
+                    return branch(Branch::Conditional, *condition, operands[0ul].symbol);
+
+            static const std::unordered_map<std::string_view, std::string_view> nullary{
+                {"ret", "\xC3"}, {"leave", "\xC9"}, {"syscall", "\x0F\x05"}, {"cbw", "\x66\x98"}, {"cwde", "\x98"},
+                {"cdqe", "\x48\x98"}, {"cwd", "\x66\x99"}, {"cdq", "\x99"}, {"cqo", "\x48\x99"}, {"nop", "\x90"}, {"hlt", "\xF4"}
+            };
+
+            if(auto find = nullary.find(mnemonic); find != nullary.end() && count == 0ul)
+            {
+                current().bytes.append(find->second);
+                return;
+            }
+
+            if(encodeVector(mnemonic, operands, line))
+                return;
+
+            fail("unsupported instruction or operands", line);
+        }
+
+        /// @brief Encode scalar SSE instructions. The mandatory prefix precedes the REX prefix, which precedes the opcode.
+        bool encodeVector(const std::string& mnemonic, std::vector<Operand>& operands, std::string_view line)
+        {
+            using Kind = Operand::Kind;
+            if(operands.size() != 2ul)
+                return false;
+
+            const auto& first = operands[0ul];
+            const auto& second = operands[1ul];
+            auto isVectorOrMemory = [](const Operand& operand){ return operand.kind == Kind::Vector || operand.kind == Kind::Memory; };
+            auto isGeneralOrMemory = [](const Operand& operand){ return operand.kind == Kind::Register || operand.kind == Kind::Memory; };
+            auto emit = [&](const Encoding& encoding, const Operand& rm)
+            {
+                emitModRM(encoding, rm, line);
+                return true;
+            };
+
+            static const std::unordered_map<std::string_view, std::pair<std::string_view, std::string_view>> arithmetic{
+                {"addss", {"\xF3", "\x0F\x58"}}, {"addsd", {"\xF2", "\x0F\x58"}}, {"subss", {"\xF3", "\x0F\x5C"}},
+                {"subsd", {"\xF2", "\x0F\x5C"}}, {"mulss", {"\xF3", "\x0F\x59"}}, {"mulsd", {"\xF2", "\x0F\x59"}},
+                {"divss", {"\xF3", "\x0F\x5E"}}, {"divsd", {"\xF2", "\x0F\x5E"}}, {"sqrtss", {"\xF3", "\x0F\x51"}},
+                {"sqrtsd", {"\xF2", "\x0F\x51"}}, {"ucomiss", {"", "\x0F\x2E"}}, {"ucomisd", {"\x66", "\x0F\x2E"}},
+                {"cvtss2sd", {"\xF3", "\x0F\x5A"}}, {"cvtsd2ss", {"\xF2", "\x0F\x5A"}}, {"movss", {"\xF3", "\x0F\x10"}},
+                {"movsd", {"\xF2", "\x0F\x10"}}
+            };
+
+            if(auto find = arithmetic.find(mnemonic); find != arithmetic.end() && first.kind == Kind::Vector && isVectorOrMemory(second))
+                return emit(Encoding{.prefix = find->second.first, .opcode = find->second.second, .reg = first.code}, second);
+
+            if((mnemonic == "movss" || mnemonic == "movsd") && first.kind == Kind::Memory && second.kind == Kind::Vector)
+                return emit(Encoding{.prefix = mnemonic == "movss"? "\xF3": "\xF2", .opcode = "\x0F\x11", .reg = second.code}, first);
+
+            static const std::unordered_map<std::string_view, std::pair<std::string_view, std::string_view>> conversions{
+                {"cvttss2si", {"\xF3", "\x0F\x2C"}}, {"cvttsd2si", {"\xF2", "\x0F\x2C"}}, {"cvtss2si", {"\xF3", "\x0F\x2D"}},
+                {"cvtsd2si", {"\xF2", "\x0F\x2D"}}
+            };
+
+            if(auto find = conversions.find(mnemonic); find != conversions.end() && first.kind == Kind::Register && isVectorOrMemory(second))
+                return emit(Encoding{.prefix = find->second.first, .opcode = find->second.second, .reg = first.code,
+                    .isWide = first.size == 8ul}, second);
+
+            if((mnemonic == "cvtsi2ss" || mnemonic == "cvtsi2sd") && first.kind == Kind::Vector && isGeneralOrMemory(second))
+            {
+                if(second.size != 4ul && second.size != 8ul)
+                    fail("operand size not specified", line);
+
+                return emit(Encoding{.prefix = mnemonic == "cvtsi2ss"? "\xF3": "\xF2", .opcode = "\x0F\x2A", .reg = first.code,
+                    .isWide = second.size == 8ul}, second);
+            }
+
+            if(mnemonic == "movd" || mnemonic == "movq")
+            {
+                const bool is_wide = mnemonic == "movq";
+                if(first.kind == Kind::Vector && isGeneralOrMemory(second) && !(is_wide && second.kind == Kind::Memory))
+                    return emit(Encoding{.prefix = "\x66", .opcode = "\x0F\x6E", .reg = first.code, .isWide = is_wide}, second);
+                if(isGeneralOrMemory(first) && second.kind == Kind::Vector && !(is_wide && first.kind == Kind::Memory))
+                    return emit(Encoding{.prefix = "\x66", .opcode = "\x0F\x7E", .reg = second.code, .isWide = is_wide}, first);
+                if(is_wide && first.kind == Kind::Vector && isVectorOrMemory(second))
+                    return emit(Encoding{.prefix = "\xF3", .opcode = "\x0F\x7E", .reg = first.code}, second);
+                if(is_wide && first.kind == Kind::Memory && second.kind == Kind::Vector)
+                    return emit(Encoding{.prefix = "\x66", .opcode = "\x0F\xD6", .reg = second.code}, first);
+            }
+
+            return false;
+        }
+
+        void branch(Branch kind, std::uint8_t condition, const std::string& target)
+        {
+            m_items.push_back(Item{.branch = kind, .condition = condition, .target = qualify(target)});
+        }
+
+        [[nodiscard]] bool isTextLabel(const std::string& name) const
+        {
+            auto find = m_labels.find(name);
+            return find != m_labels.end() && find->second.section == Section::Text;
+        }
+
+        static std::size_t getBranchSize(const Item& item)
+        {
+            switch(item.branch)
+            {
+            case Branch::Jump: return item.isLong? 5ul: 2ul;
+            case Branch::Conditional: return item.isLong? 6ul: 2ul;
+            case Branch::Call: return 5ul;
+            default: return item.bytes.size();
+            }
+        }
+
+        /// @brief Lay out the text section, choosing the shortest encoding of every jump to a label, then resolve the symbols.
+        ObjectFileELF64 link()
+        {
+            // jumps start short and are lengthened until every displacement fits
+            for(auto& item: m_items)
+                item.isLong = item.branch != Branch::None && !isTextLabel(item.target);
+
+            std::vector<std::size_t> offsets(m_items.size() + 1ul);
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+                for(std::size_t i{0ul}; i < m_items.size(); ++i)
+                    offsets[i + 1ul] = offsets[i] + getBranchSize(m_items[i]);
+
+                for(std::size_t i{0ul}; i < m_items.size(); ++i)
+                {
+                    auto& item = m_items[i];
+                    if(item.isLong || (item.branch != Branch::Jump && item.branch != Branch::Conditional))
+                        continue;
+
+                    auto displacement = static_cast<Types::i64>(offsets[m_labels.at(item.target).position])
+                        - static_cast<Types::i64>(offsets[i + 1ul]);
+                    if(!fitsByte(displacement))
+                        item.isLong = changed = true;
+                }
+            }
+
+            ObjectFileELF64 object;
+            object.data = std::move(m_data);
+
+            for(const auto& name: m_labelOrder)
+            {
+                const auto& label = m_labels.at(name);
+                object.symbols.push_back(ObjectFileELF64::Symbol{.name = name, .section = label.section,
+                    .offset = label.section == Section::Text? offsets[label.position]: label.position, .isGlobal = m_globals.contains(name)});
+            }
+
+            for(const auto& name: m_externals)
+                static_cast<void>(object.symbol(name));
+
+            for(const auto& fixup: m_dataFixups)
+                object.dataRelocations.push_back(ObjectFileELF64::Relocation{.offset = fixup.offset, .symbol = object.symbol(fixup.symbol),
+                    .type = fixup.type, .addend = fixup.addend});
+
+            for(std::size_t i{0ul}; i < m_items.size(); ++i)
+            {
+                auto& item = m_items[i];
+                const auto offset = offsets[i];
+
+                for(const auto& fixup: item.fixups)
+                    object.relocations.push_back(ObjectFileELF64::Relocation{.offset = offset + fixup.offset,
+                        .symbol = object.symbol(fixup.symbol), .type = fixup.type, .addend = fixup.addend});
+
+                if(item.branch == Branch::None)
+                {
+                    object.text.append(item.bytes);
+                    continue;
+                }
+
+                std::string opcode;
+                switch(item.branch)
+                {
+                case Branch::Jump: opcode = item.isLong? "\xE9": "\xEB"; break;
+                case Branch::Call: opcode = "\xE8"; break;
+                default:
+                    opcode = item.isLong? std::string{'\x0F', static_cast<char>(0x80u + item.condition)}: std::string(1ul, static_cast<char>(0x70u + item.condition));
+                    break;
+                }
+
+                object.text.append(opcode);
+                const auto size = item.isLong || item.branch == Branch::Call? 4ul: 1ul;
+
+                if(isTextLabel(item.target))
+                    put(object.text, static_cast<Types::u64>(static_cast<Types::i64>(offsets[m_labels.at(item.target).position])
+                        - static_cast<Types::i64>(offsets[i + 1ul])), size);
+                else
+                {
+                    object.relocations.push_back(ObjectFileELF64::Relocation{.offset = object.text.size(), .symbol = object.symbol(item.target),
+                        .type = m_labels.contains(item.target)? RelocationType::Relative32: RelocationType::ProcedureLinkage32, .addend = -4l});
+                    put(object.text, 0ul, 4ul);
+                }
+            }
+
+            return object;
+        }
+
+        Section m_section{Section::Undefined};
+        bool m_isLabelPending{};
+        std::string m_data, m_scope;
+        std::vector<Item> m_items;
+        std::vector<Fixup> m_dataFixups;
+        std::unordered_map<std::string, Label> m_labels;
+        std::vector<std::string> m_labelOrder;
+        std::unordered_set<std::string> m_globals, m_externals;
+    };
+}
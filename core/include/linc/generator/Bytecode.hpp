@@ -0,0 +1,154 @@
+#pragma once
+#include <linc/bound_tree/BoundMatchExpression.hpp>
+#include <linc/system/Value.hpp>
+#include <linc/system/Logger.hpp>
+#include <linc/Include.hpp>
+
+/// Every opcode understood by the virtual machine, along with the meaning of its (a, b, c) operands. Registers are relative to the
+/// current call frame; the instruction's kind is the primitive type integral results are narrowed to.
+#define LINC_BYTECODE_OPCODES(X) \
+    X(Move) /* a = b */ \
+    X(LoadConstant) /* a = constants[b] */ \
+    X(LoadGlobal) /* a = globals[b] */ \
+    X(StoreGlobal) /* globals[a] = b */ \
+    X(Jump) /* goto a */ \
+    X(JumpIfFalse) /* if !a goto b */ \
+    X(JumpIfTrue) /* if a goto b */ \
+    X(JumpIfEquals) /* if a == b goto c */ \
+    X(JumpIfNotEquals) /* if a != b goto c */ \
+    X(JumpIfGreater) /* if a > b goto c */ \
+    X(JumpIfLess) /* if a < b goto c */ \
+    X(JumpIfGreaterEqual) /* if a >= b goto c */ \
+    X(JumpIfLessEqual) /* if a <= b goto c */ \
+    X(Switch) /* goto switches[b].targets[clause of a], or switches[b].targets.back() if no clause matches a */ \
+    X(Test) /* a = bool(b) */ \
+    X(Narrow) /* a = b */ \
+    X(Add) /* a = b + c */ \
+    X(Subtract) /* a = b - c */ \
+    X(Multiply) /* a = b * c */ \
+    X(Divide) /* a = b / c */ \
+    X(Modulo) /* a = b % c */ \
+    X(BitwiseAnd) /* a = b & c */ \
+    X(BitwiseOr) /* a = b | c */ \
+    X(BitwiseXor) /* a = b ^ c */ \
+    X(ShiftLeft) /* a = b << c */ \
+    X(ShiftRight) /* a = b >> c */ \
+    X(Equals) /* a = b == c */ \
+    X(NotEquals) /* a = b != c */ \
+    X(Greater) /* a = b > c */ \
+    X(Less) /* a = b < c */ \
+    X(GreaterEqual) /* a = b >= c */ \
+    X(LessEqual) /* a = b <= c */ \
+    X(Negate) /* a = -b */ \
+    X(BitwiseNot) /* a = ~b */ \
+    X(LogicalNot) /* a = !b */ \
+    X(Stringify) /* a = @b */ \
+    X(Count) /* a = +b */ \
+    X(Convert) /* a = b as kind */ \
+    X(Index) /* a = b[c] */ \
+    X(IndexGlobal) /* a = globals[b][c] */ \
+    X(SetIndex) /* a[b] = c */ \
+    X(SetIndexGlobal) /* globals[a][b] = c */ \
+    X(Access) /* a = b.c */ \
+    X(AccessGlobal) /* a = globals[b].c */ \
+    X(SetAccess) /* a.b = c */ \
+    X(SetAccessGlobal) /* globals[a].b = c */ \
+    X(ArrayPush) /* a.push(b) */ \
+    X(StructurePush) /* a.fields.push(b) */ \
+    X(Enumerator) /* a = enumerators[b](c) */ \
+    X(EnumeratorValue) /* a = value held by enumerator b */ \
+    X(Call) /* a = functions[b](c...), the callee's frame starting at register c */ \
+    X(ExternalCall) /* a = externals[b](c...) */ \
+    X(Return) /* return a */
+
+namespace linc
+{
+    /// @brief Linear, register-based instruction set executed by the linc virtual machine.
+    class Bytecode final
+    {
+    public:
+        Bytecode() = delete;
+
+        using Register = std::uint32_t;
+
+        enum class OpCode: unsigned char
+        {
+        #define LINC_BYTECODE_OPCODE_ENUMERATOR(name) name,
+            LINC_BYTECODE_OPCODES(LINC_BYTECODE_OPCODE_ENUMERATOR)
+        #undef LINC_BYTECODE_OPCODE_ENUMERATOR
+        };
+
+        struct Instruction final
+        {
+            OpCode code;
+            Types::Kind kind{Types::Kind::invalid};
+            Register a{}, b{}, c{};
+        };
+
+        /// @brief The jump table of a match expression: the dispatch finding the clause matching a value, and the instruction
+        /// every clause starts at, followed by the instruction the default value is produced at.
+        struct Switch final
+        {
+            BoundMatchExpression::Dispatch dispatch;
+            std::vector<Register> targets;
+        };
+
+        struct Function final
+        {
+            std::string name;
+            std::vector<Instruction> instructions;
+            std::vector<Switch> switches;
+            Register argumentCount{}, registerCount{};
+        };
+
+        struct External final
+        {
+            std::string name;
+            Register argumentCount{};
+        };
+
+        struct Enumerator final
+        {
+            std::string name;
+            Types::u64 index{};
+        };
+
+        struct Program final
+        {
+            std::vector<Function> functions;
+            std::vector<Value> constants;
+            std::vector<External> externals;
+            std::vector<Enumerator> enumerators;
+            std::size_t globalCount{}, entryPoint{};
+        };
+
+        static std::string opCodeToString(OpCode code)
+        {
+            switch(code)
+            {
+            #define LINC_BYTECODE_OPCODE_STRING(name) case OpCode::name: return #name;
+                LINC_BYTECODE_OPCODES(LINC_BYTECODE_OPCODE_STRING)
+            #undef LINC_BYTECODE_OPCODE_STRING
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(code);
+            }
+        }
+
+        /// @brief Produce a human-readable listing of a compiled function.
+        static std::string disassemble(const Function& function)
+        {
+            std::string result = Logger::format("fn $ ($ arguments, $ registers):\n", function.name,
+                std::to_string(function.argumentCount), std::to_string(function.registerCount));
+
+            for(std::size_t i{0ul}; i < function.instructions.size(); ++i)
+            {
+                const auto& instruction = function.instructions[i];
+                // `$:` would start a formatting option, so the instruction's offset is appended separately
+                result += "  " + std::to_string(i) + ": ";
+                Logger::append(result, "$ $, $, $\n", opCodeToString(instruction.code), std::to_string(instruction.a),
+                    std::to_string(instruction.b), std::to_string(instruction.c));
+            }
+
+            return result;
+        }
+    };
+}
@@ -0,0 +1,1285 @@
+#pragma once
+#include <linc/BoundTree.hpp>
+#include <linc/generator/Bytecode.hpp>
+#include <linc/Include.hpp>
+#include <algorithm>
+#include <bit>
+#include <map>
+
+namespace linc
+{
+    /// @brief Lowers a bound program to the linear bytecode executed by the VirtualMachine. Variables are resolved to frame registers
+    /// and control flow to absolute jump targets at compile time. Programs using constructs the virtual machine does not support are
+    /// rejected as a whole, so that the caller may fall back to the tree-walking Interpreter.
+    class BytecodeCompiler final
+    {
+    public:
+        using Register = Bytecode::Register;
+        using OpCode = Bytecode::OpCode;
+
+        /// @brief Compile every declaration of a program, along with an entry point initializing its globals and evaluating the given call.
+        /// @param program The bound program to compile.
+        /// @param entry_call The expression evaluated by the entry point, usually a call to main().
+        /// @return The compiled program, or nullopt if the program cannot be run by the virtual machine (see getUnsupportedReason()).
+        std::optional<Bytecode::Program> compileProgram(const BoundProgram* program, const BoundExpression* entry_call)
+        {
+            m_program = Bytecode::Program{};
+            m_functionIndices.clear();
+            m_functionDeclarations.clear();
+            m_globals.clear();
+            m_unsupportedReason.clear();
+
+            try
+            {
+                for(const auto& declaration: program->declarations)
+                    switch(declaration->getKind())
+                    {
+                    case BoundNode::Kind::FunctionDeclaration:
+                    {
+                        auto function = static_cast<const BoundFunctionDeclaration*>(declaration.get());
+                        auto [find, inserted] = m_functionIndices.try_emplace(function->getName(), m_program.functions.size());
+
+                        if(inserted)
+                        {
+                            m_program.functions.push_back(Bytecode::Function{.name = function->getName()});
+                            m_functionDeclarations.push_back(function);
+                        }
+                        else m_functionDeclarations[find->second] = function;
+                        break;
+                    }
+                    case BoundNode::Kind::VariableDeclaration:
+                    {
+                        auto variable = static_cast<const BoundVariableDeclaration*>(declaration.get());
+                        m_globals.try_emplace(variable->getName(), static_cast<Register>(m_globals.size()));
+                        break;
+                    }
+                    default: break;
+                    }
+
+                m_program.globalCount = m_globals.size();
+
+                for(std::size_t i{0ul}; i < m_functionDeclarations.size(); ++i)
+                    compileFunction(i);
+
+                m_program.entryPoint = m_program.functions.size();
+                m_program.functions.push_back(Bytecode::Function{.name = "<entry>"});
+                beginFunction(m_program.entryPoint);
+
+                for(const auto& declaration: program->declarations)
+                    if(declaration->getKind() == BoundNode::Kind::VariableDeclaration)
+                    {
+                        auto variable = static_cast<const BoundVariableDeclaration*>(declaration.get());
+                        auto value = compileVariableValue(variable);
+                        emit(OpCode::StoreGlobal, m_globals.at(variable->getName()), value);
+                        m_top = 0u;
+                    }
+
+                auto result = allocate();
+                compileExpression(entry_call, result);
+                emit(OpCode::Return, result);
+            }
+            catch(const Unsupported& unsupported)
+            {
+                m_unsupportedReason = unsupported.reason;
+                return std::nullopt;
+            }
+
+            return std::move(m_program);
+        }
+
+        /// @brief The reason for which the last program compiled was rejected.
+        [[nodiscard]] inline const std::string& getUnsupportedReason() const { return m_unsupportedReason; }
+    private:
+        struct Unsupported final
+        {
+            std::string reason;
+        };
+
+        struct Loop final
+        {
+            std::string label;
+            std::vector<std::size_t> breaks, continues;
+        };
+
+        /// @brief A mutable location, as assigned to by (compound) assignments, increments and decrements.
+        struct Place final
+        {
+            enum class Kind: char
+            {
+                Local, Global, LocalIndex, GlobalIndex, LocalAccess, GlobalAccess
+            };
+
+            Kind kind;
+            Register base{}, index{};
+        };
+
+        void beginFunction(std::size_t index)
+        {
+            m_function = &m_program.functions[index];
+            m_scopes.assign(1ul, {});
+            m_loops.clear();
+            m_hoisted.clear();
+            m_top = 0u;
+        }
+
+        void compileFunction(std::size_t index)
+        {
+            auto declaration = m_functionDeclarations[index];
+            beginFunction(index);
+
+            for(const auto& argument: declaration->getArguments())
+                m_scopes.back()[argument->getName()] = allocate();
+
+            m_function->argumentCount = static_cast<Register>(declaration->getArguments().size());
+            hoistLoopConstants(declaration->getBody());
+
+            auto result = allocate();
+            compileExpression(declaration->getBody(), result);
+            emit(OpCode::Return, result);
+        }
+
+        std::size_t emit(OpCode code, Register a = 0u, Register b = 0u, Register c = 0u, Types::Kind kind = Types::Kind::invalid)
+        {
+            m_function->instructions.push_back(Bytecode::Instruction{.code = code, .kind = kind, .a = a, .b = b, .c = c});
+            return m_function->instructions.size() - 1ul;
+        }
+
+        inline Register here() const { return static_cast<Register>(m_function->instructions.size()); }
+
+        void patch(std::size_t instruction, Register target)
+        {
+            auto& patched = m_function->instructions[instruction];
+
+            switch(patched.code)
+            {
+            case OpCode::Jump: patched.a = target; break;
+            case OpCode::JumpIfFalse:
+            case OpCode::JumpIfTrue: patched.b = target; break;
+            default: patched.c = target; break;
+            }
+        }
+
+        /// @return The jump comparing its operands directly that a comparison compiles to when it is tested, taken when the
+        /// comparison evaluates to the given value. Orderings of floating-point operands are excluded, as they cannot be negated
+        /// into the opposite ordering when either operand is NaN.
+        static std::optional<OpCode> comparisonJump(const BoundExpression* test, bool when)
+        {
+            if(test->getKind() != BoundNode::Kind::BinaryExpression)
+                return std::nullopt;
+
+            auto binary = static_cast<const BoundBinaryExpression*>(test);
+            auto is_floating = [](const BoundExpression* operand)
+            {
+                auto kind = primitiveKind(operand->getType());
+                return kind == Types::Kind::f32 || kind == Types::Kind::f64;
+            };
+
+            if(is_floating(binary->getLeft()) || is_floating(binary->getRight()))
+                return std::nullopt;
+
+            switch(binary->getOperator()->getKind())
+            {
+            case BoundBinaryOperator::Kind::Equals: return when? OpCode::JumpIfEquals: OpCode::JumpIfNotEquals;
+            case BoundBinaryOperator::Kind::NotEquals: return when? OpCode::JumpIfNotEquals: OpCode::JumpIfEquals;
+            case BoundBinaryOperator::Kind::Greater: return when? OpCode::JumpIfGreater: OpCode::JumpIfLessEqual;
+            case BoundBinaryOperator::Kind::Less: return when? OpCode::JumpIfLess: OpCode::JumpIfGreaterEqual;
+            case BoundBinaryOperator::Kind::GreaterEqual: return when? OpCode::JumpIfGreaterEqual: OpCode::JumpIfLess;
+            case BoundBinaryOperator::Kind::LessEqual: return when? OpCode::JumpIfLessEqual: OpCode::JumpIfGreater;
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Emit a jump taken when a test evaluates to the given value.
+        /// @return The index of the jump, to be patched unless its target is given.
+        std::size_t emitTestJump(const BoundExpression* test, bool when, Register target = 0u)
+        {
+            if(auto code = comparisonJump(test, when))
+            {
+                auto binary = static_cast<const BoundBinaryExpression*>(test);
+                auto left = compileOperand(binary->getLeft(),
+                    !isPure(binary->getRight(), placeVariable(binary->getLeft()).value_or(std::string_view{})));
+                auto right = compileOperand(binary->getRight());
+                return emit(*code, left, right, target);
+            }
+
+            return emit(when? OpCode::JumpIfTrue: OpCode::JumpIfFalse, compileOperand(test), target);
+        }
+
+        Register allocate()
+        {
+            m_function->registerCount = std::max(m_function->registerCount, m_top + 1u);
+            return m_top++;
+        }
+
+        /// @brief Scalar constants are identified by their kind and bits, so that e.g. 0.0 and -0.0 are kept apart.
+        using ConstantKey = std::pair<PrimitiveValue::Kind, Types::u64>;
+
+        static std::optional<ConstantKey> constantKey(const PrimitiveValue& value)
+        {
+            switch(value.getKind())
+            {
+            case PrimitiveValue::Kind::Boolean: return ConstantKey{value.getKind(), value.getBool()};
+            case PrimitiveValue::Kind::Character: return ConstantKey{value.getKind(), static_cast<unsigned char>(value.getChar())};
+            case PrimitiveValue::Kind::Unsigned: return ConstantKey{value.getKind(), value.getU64()};
+            case PrimitiveValue::Kind::Signed: return ConstantKey{value.getKind(), std::bit_cast<Types::u64>(value.getI64())};
+            case PrimitiveValue::Kind::Float: return ConstantKey{value.getKind(), std::bit_cast<Types::u32>(value.getF32())};
+            case PrimitiveValue::Kind::Double: return ConstantKey{value.getKind(), std::bit_cast<Types::u64>(value.getF64())};
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Collect the scalar constants read inside loops: literals, and the ones added by increments and decrements.
+        static void collectLoopConstants(const BoundNode* node, bool in_loop, std::vector<PrimitiveValue>& constants)
+        {
+            switch(node->getKind())
+            {
+            case BoundNode::Kind::LiteralExpression:
+                if(in_loop)
+                    constants.push_back(static_cast<const BoundLiteralExpression*>(node)->getValue());
+                return;
+            case BoundNode::Kind::UnaryExpression:
+            {
+                auto unary = static_cast<const BoundUnaryExpression*>(node);
+                auto kind = unary->getOperator()->getKind();
+
+                if(in_loop && (kind == BoundUnaryOperator::Kind::Increment || kind == BoundUnaryOperator::Kind::Decrement))
+                    constants.push_back(PrimitiveValue{1}.convert(primitiveKind(unary->getType())));
+                break;
+            }
+            case BoundNode::Kind::WhileExpression:
+                in_loop = true;
+                break;
+            case BoundNode::Kind::ForExpression:
+            {
+                // the condition and the statement of the specifier are not children of the loop
+                auto specifier = std::get_if<const BoundForExpression::BoundVariableForSpecifier>(
+                    &static_cast<const BoundForExpression*>(node)->getSpecifier());
+
+                if(specifier)
+                {
+                    collectLoopConstants(specifier->variableDeclaration.get(), in_loop, constants);
+                    collectLoopConstants(specifier->expression.get(), true, constants);
+                    collectLoopConstants(specifier->statement.get(), true, constants);
+                }
+
+                in_loop = true;
+                break;
+            }
+            case BoundNode::Kind::MatchExpression:
+                // neither are the clauses of a match expression
+                for(const auto& clause: static_cast<const BoundMatchExpression*>(node)->getClauses()->getList())
+                {
+                    for(const auto& value: clause->getValues()->getList())
+                        collectLoopConstants(value.get(), in_loop, constants);
+
+                    collectLoopConstants(clause->getExpression(), in_loop, constants);
+                }
+                break;
+            default: break;
+            }
+
+            for(const auto* child: node->getChildren())
+                if(child)
+                    collectLoopConstants(child, in_loop, constants);
+        }
+
+        /// @brief Load the scalar constants read inside the loops of a function once, when the function is entered, into registers
+        /// no instruction writes to, instead of on every iteration.
+        void hoistLoopConstants(const BoundExpression* body)
+        {
+            std::vector<PrimitiveValue> constants;
+            collectLoopConstants(body, false, constants);
+
+            for(const auto& value: constants)
+                if(auto key = constantKey(value); key && !m_hoisted.contains(*key))
+                {
+                    auto hoisted = allocate();
+                    emit(OpCode::LoadConstant, hoisted, constant(value));
+                    m_hoisted.emplace(*key, hoisted);
+                }
+        }
+
+        /// @return The register holding a constant that may be read, which is only loaded if it was not hoisted.
+        Register loadConstant(const PrimitiveValue& value)
+        {
+            if(auto key = constantKey(value))
+                if(auto find = m_hoisted.find(*key); find != m_hoisted.end())
+                    return find->second;
+
+            auto result = allocate();
+            emit(OpCode::LoadConstant, result, constant(value));
+            return result;
+        }
+
+        Register constant(const Value& value)
+        {
+            m_program.constants.push_back(value);
+            return static_cast<Register>(m_program.constants.size() - 1ul);
+        }
+
+        Register external(const std::string& name, Register argument_count)
+        {
+            for(std::size_t i{0ul}; i < m_program.externals.size(); ++i)
+                if(m_program.externals[i].name == name && m_program.externals[i].argumentCount == argument_count)
+                    return static_cast<Register>(i);
+
+            m_program.externals.push_back(Bytecode::External{.name = name, .argumentCount = argument_count});
+            return static_cast<Register>(m_program.externals.size() - 1ul);
+        }
+
+        Register defaultConstant(const Types::type& type)
+        {
+            try
+            {
+                return constant(Value::fromDefault(type));
+            }
+            catch(const Exception&)
+            {
+                throw Unsupported{Logger::format("no default value exists for type `$`", type)};
+            }
+        }
+
+        std::optional<Register> findLocal(const std::string& name) const
+        {
+            for(auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+                if(auto find = scope->find(name); find != scope->end())
+                    return find->second;
+
+            return std::nullopt;
+        }
+
+        std::optional<Register> findGlobal(const std::string& name) const
+        {
+            if(auto find = m_globals.find(name); find != m_globals.end())
+                return find->second;
+
+            return std::nullopt;
+        }
+
+        void beginScope() { m_scopes.emplace_back(); }
+        void endScope() { m_scopes.pop_back(); }
+
+        static inline Types::Kind primitiveKind(const Types::type& type)
+        {
+            return type.kind == Types::type::Kind::Primitive? type.primitive: Types::Kind::invalid;
+        }
+
+        /// @return The variable a place expression (a variable, or an element or member of one) refers to, if any.
+        static std::optional<std::string_view> placeVariable(const BoundExpression* expression)
+        {
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::IdentifierExpression: return static_cast<const BoundIdentifierExpression*>(expression)->getValue();
+            case BoundNode::Kind::IndexExpression: return placeVariable(static_cast<const BoundIndexExpression*>(expression)->getArray());
+            case BoundNode::Kind::AccessExpression: return placeVariable(static_cast<const BoundAccessExpression*>(expression)->getBase());
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Whether evaluating the expression cannot modify any variable, such that operands read before it need not be copied.
+        /// @param variable If not empty, only modifications of this variable are considered, e.g. `input[++i]` may read `input` in
+        /// place.
+        static bool isPure(const BoundExpression* expression, std::string_view variable = {})
+        {
+            auto modifies = [variable](const BoundExpression* place)
+            {
+                auto modified = placeVariable(place);
+                return variable.empty() || !modified || *modified == variable;
+            };
+
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::LiteralExpression:
+            case BoundNode::Kind::IdentifierExpression:
+            case BoundNode::Kind::TypeExpression:
+                return true;
+            case BoundNode::Kind::ConversionExpression:
+                return isPure(static_cast<const BoundConversionExpression*>(expression)->getExpression(), variable);
+            case BoundNode::Kind::AccessExpression:
+                return isPure(static_cast<const BoundAccessExpression*>(expression)->getBase(), variable);
+            case BoundNode::Kind::IndexExpression:
+            {
+                auto index = static_cast<const BoundIndexExpression*>(expression);
+                return isPure(index->getArray(), variable) && isPure(index->getIndex(), variable);
+            }
+            case BoundNode::Kind::UnaryExpression:
+            {
+                auto unary = static_cast<const BoundUnaryExpression*>(expression);
+                auto kind = unary->getOperator()->getKind();
+                return !((kind == BoundUnaryOperator::Kind::Increment || kind == BoundUnaryOperator::Kind::Decrement) && modifies(unary->getOperand()))
+                    && isPure(unary->getOperand(), variable);
+            }
+            case BoundNode::Kind::BinaryExpression:
+            {
+                auto binary = static_cast<const BoundBinaryExpression*>(expression);
+                return !(isAssignment(binary->getOperator()->getKind()) && modifies(binary->getLeft()))
+                    && isPure(binary->getLeft(), variable) && isPure(binary->getRight(), variable);
+            }
+            default: return false;
+            }
+        }
+
+        static inline bool isAssignment(BoundBinaryOperator::Kind kind)
+        {
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::Assignment:
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+            case BoundBinaryOperator::Kind::SubtractionAssignment:
+            case BoundBinaryOperator::Kind::MultiplicationAssignment:
+            case BoundBinaryOperator::Kind::DivisionAssignment:
+            case BoundBinaryOperator::Kind::ModuloAssignment:
+                return true;
+            default: return false;
+            }
+        }
+
+        /// @brief Whether an expression only writes to its destination register after having read all of its operands, so that it
+        /// may directly target a variable it reads from.
+        static bool writesLast(const BoundExpression* expression)
+        {
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::LiteralExpression:
+            case BoundNode::Kind::IdentifierExpression:
+            case BoundNode::Kind::TypeExpression:
+            case BoundNode::Kind::ConversionExpression:
+            case BoundNode::Kind::IndexExpression:
+            case BoundNode::Kind::AccessExpression:
+            case BoundNode::Kind::FunctionCallExpression:
+            case BoundNode::Kind::ExternalCallExpression:
+                return true;
+            case BoundNode::Kind::UnaryExpression:
+                return static_cast<const BoundUnaryExpression*>(expression)->getOperator()->getKind() != BoundUnaryOperator::Kind::Typeof;
+            case BoundNode::Kind::BinaryExpression:
+            {
+                auto kind = static_cast<const BoundBinaryExpression*>(expression)->getOperator()->getKind();
+                return !isAssignment(kind) && kind != BoundBinaryOperator::Kind::LogicalAnd && kind != BoundBinaryOperator::Kind::LogicalOr;
+            }
+            default: return false;
+            }
+        }
+
+        /// @brief Evaluate an expression into a register that may be read, reusing the register of a local variable if possible.
+        /// @param copy Whether the value must be copied out of variables, as the expressions evaluated afterwards may modify them.
+        Register compileOperand(const BoundExpression* expression, bool copy = false)
+        {
+            if(expression->getKind() == BoundNode::Kind::LiteralExpression)
+                return loadConstant(static_cast<const BoundLiteralExpression*>(expression)->getValue());
+            else if(!copy && expression->getKind() == BoundNode::Kind::UnaryExpression)
+            {
+                // an incremented or decremented local variable holds the value of the expression
+                auto unary = static_cast<const BoundUnaryExpression*>(expression);
+                auto kind = unary->getOperator()->getKind();
+
+                if((kind == BoundUnaryOperator::Kind::Increment || kind == BoundUnaryOperator::Kind::Decrement)
+                && unary->getOperand()->getKind() == BoundNode::Kind::IdentifierExpression)
+                    if(auto local = findLocal(static_cast<const BoundIdentifierExpression*>(unary->getOperand())->getValue()))
+                    {
+                        compileExpression(expression, std::nullopt);
+                        return *local;
+                    }
+            }
+            else if(!copy && expression->getKind() == BoundNode::Kind::IdentifierExpression)
+            {
+                auto identifier = static_cast<const BoundIdentifierExpression*>(expression);
+                if(identifier->getType().kind != Types::type::Kind::Function)
+                    if(auto local = findLocal(identifier->getValue()))
+                        return *local;
+            }
+
+            auto result = allocate();
+            compileExpression(expression, result);
+            return result;
+        }
+
+        /// @brief Evaluate a variable's initializer (or its type's default value) into a newly allocated register.
+        Register compileVariableValue(const BoundVariableDeclaration* variable)
+        {
+            auto result = allocate();
+
+            if(variable->getDefaultValue())
+                compileExpression(*variable->getDefaultValue(), result);
+            else emit(OpCode::LoadConstant, result, defaultConstant(variable->getActualType()));
+
+            return result;
+        }
+
+        void compileStatement(const BoundStatement* statement)
+        {
+            switch(statement->getKind())
+            {
+            case BoundNode::Kind::DeclarationStatement:
+                compileDeclaration(static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration());
+                return;
+            case BoundNode::Kind::ExpressionStatement:
+            {
+                auto mark = m_top;
+                compileExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression(), std::nullopt);
+                m_top = mark;
+                return;
+            }
+            case BoundNode::Kind::ReturnStatement:
+            {
+                auto return_statement = static_cast<const BoundReturnStatement*>(statement);
+                auto mark = m_top;
+                auto result = allocate();
+
+                if(return_statement->getExpression())
+                    compileExpression(return_statement->getExpression(), result);
+                else emit(OpCode::LoadConstant, result, constant(PrimitiveValue::voidValue));
+
+                emit(OpCode::Return, result);
+                m_top = mark;
+                return;
+            }
+            case BoundNode::Kind::BreakStatement:
+                findLoop(static_cast<const BoundBreakStatement*>(statement)->getLabel()).breaks.push_back(emit(OpCode::Jump));
+                return;
+            case BoundNode::Kind::ContinueStatement:
+                findLoop(static_cast<const BoundContinueStatement*>(statement)->getLabel()).continues.push_back(emit(OpCode::Jump));
+                return;
+            default:
+                throw Unsupported{"unrecognized statement"};
+            }
+        }
+
+        void compileDeclaration(const BoundDeclaration* declaration)
+        {
+            switch(declaration->getKind())
+            {
+            case BoundNode::Kind::VariableDeclaration:
+            {
+                auto variable = static_cast<const BoundVariableDeclaration*>(declaration);
+                auto value = compileVariableValue(variable);
+                m_top = value + 1u;
+                m_scopes.back()[variable->getName()] = value;
+                return;
+            }
+            case BoundNode::Kind::ExternalDeclaration:
+            case BoundNode::Kind::StructureDeclaration:
+            case BoundNode::Kind::EnumerationDeclaration:
+                return;
+            case BoundNode::Kind::FunctionDeclaration:
+                throw Unsupported{Logger::format("nested function declaration `$`",
+                    static_cast<const BoundFunctionDeclaration*>(declaration)->getName())};
+            default:
+                throw Unsupported{"unrecognized declaration"};
+            }
+        }
+
+        Loop& findLoop(const std::string& label)
+        {
+            for(auto loop = m_loops.rbegin(); loop != m_loops.rend(); ++loop)
+                if(label.empty() || loop->label == label)
+                    return *loop;
+
+            throw Unsupported{Logger::format("control flow statement outside of a loop (with label '$')", label)};
+        }
+
+        /// @brief Resolve the jumps of the innermost loop, which is then exited.
+        void endLoop(Register continue_target, Register break_target)
+        {
+            for(auto jump: m_loops.back().continues)
+                patch(jump, continue_target);
+
+            for(auto jump: m_loops.back().breaks)
+                patch(jump, break_target);
+
+            m_loops.pop_back();
+        }
+
+        /// @brief Compile the body of a loop, storing its value into the destination only once it has been completely evaluated.
+        void compileLoopBody(const BoundExpression* body, std::optional<Register> destination)
+        {
+            auto mark = m_top;
+
+            if(destination)
+            {
+                auto value = allocate();
+                compileExpression(body, value);
+                emit(OpCode::Move, *destination, value);
+            }
+            else compileExpression(body, std::nullopt);
+
+            m_top = mark;
+        }
+
+        /// @brief Compile an expression, storing its value into the given register (if any).
+        void compileExpression(const BoundExpression* expression, std::optional<Register> destination)
+        {
+            auto mark = m_top;
+            compileExpressionInner(expression, destination);
+            m_top = mark;
+        }
+
+        Register target(std::optional<Register> destination)
+        {
+            return destination? *destination: allocate();
+        }
+
+        void compileExpressionInner(const BoundExpression* expression, std::optional<Register> destination)
+        {
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::LiteralExpression:
+                if(destination)
+                    emit(OpCode::LoadConstant, *destination, constant(static_cast<const BoundLiteralExpression*>(expression)->getValue()));
+                return;
+            case BoundNode::Kind::TypeExpression:
+                if(destination)
+                    emit(OpCode::LoadConstant, *destination,
+                        constant(PrimitiveValue(static_cast<const BoundTypeExpression*>(expression)->getActualType())));
+                return;
+            case BoundNode::Kind::IdentifierExpression:
+            {
+                auto identifier = static_cast<const BoundIdentifierExpression*>(expression);
+
+                if(identifier->getType().kind == Types::type::Kind::Function)
+                {
+                    if(!m_functionIndices.contains(identifier->getValue()))
+                        throw Unsupported{Logger::format("reference to unknown function `$`", identifier->getValue())};
+                    else if(destination)
+                        emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue::voidValue));
+                }
+                else if(auto local = findLocal(identifier->getValue()))
+                {
+                    if(destination && *destination != *local)
+                        emit(OpCode::Move, *destination, *local);
+                }
+                else if(auto global = findGlobal(identifier->getValue()))
+                {
+                    if(destination)
+                        emit(OpCode::LoadGlobal, *destination, *global);
+                }
+                else throw Unsupported{Logger::format("reference to unknown variable `$`", identifier->getValue())};
+                return;
+            }
+            case BoundNode::Kind::BlockExpression:
+            {
+                auto block = static_cast<const BoundBlockExpression*>(expression);
+                beginScope();
+
+                for(const auto& statement: block->getStatements())
+                    compileStatement(statement.get());
+
+                if(block->getTail())
+                    compileExpression(block->getTail(), destination);
+                else if(destination)
+                    emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue::voidValue));
+
+                endScope();
+                return;
+            }
+            case BoundNode::Kind::IfExpression:
+            {
+                auto if_expression = static_cast<const BoundIfExpression*>(expression);
+                auto jump_else = emitTestJump(if_expression->getTestExpression(), false);
+
+                compileExpression(if_expression->getIfBody(), destination);
+
+                if(!if_expression->getElseBody() && !destination)
+                {
+                    patch(jump_else, here());
+                    return;
+                }
+
+                auto jump_end = emit(OpCode::Jump);
+                patch(jump_else, here());
+
+                if(if_expression->getElseBody())
+                    compileExpression(if_expression->getElseBody(), destination);
+                else emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue::voidValue));
+
+                patch(jump_end, here());
+                return;
+            }
+            case BoundNode::Kind::WhileExpression:
+            {
+                auto while_expression = static_cast<const BoundWhileExpression*>(expression);
+
+                if(destination)
+                    emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue::voidValue));
+
+                auto mark = m_top;
+                auto jump_else = emitTestJump(while_expression->getTestExpression(), false);
+                m_top = mark;
+
+                auto loop = here();
+                m_loops.push_back(Loop{.label = while_expression->getLabel()});
+                compileLoopBody(while_expression->getWhileBody(), destination);
+
+                auto continue_target = here();
+                emitTestJump(while_expression->getTestExpression(), true, loop);
+                m_top = mark;
+
+                auto break_target = here();
+                endLoop(continue_target, break_target);
+
+                if(while_expression->getFinallyBody())
+                    compileExpression(while_expression->getFinallyBody(), destination);
+
+                if(while_expression->getElseBody())
+                {
+                    auto jump_end = emit(OpCode::Jump);
+                    patch(jump_else, here());
+                    compileExpression(while_expression->getElseBody(), destination);
+                    patch(jump_end, here());
+                }
+                else patch(jump_else, here());
+                return;
+            }
+            case BoundNode::Kind::ForExpression:
+                compileForExpression(static_cast<const BoundForExpression*>(expression), destination);
+                return;
+            case BoundNode::Kind::MatchExpression:
+                compileMatchExpression(static_cast<const BoundMatchExpression*>(expression), destination);
+                return;
+            case BoundNode::Kind::UnaryExpression:
+                compileUnaryExpression(static_cast<const BoundUnaryExpression*>(expression), destination);
+                return;
+            case BoundNode::Kind::BinaryExpression:
+                compileBinaryExpression(static_cast<const BoundBinaryExpression*>(expression), destination);
+                return;
+            case BoundNode::Kind::FunctionCallExpression:
+            {
+                auto call = static_cast<const BoundFunctionCallExpression*>(expression);
+                auto find = m_functionIndices.find(call->getName());
+
+                if(find == m_functionIndices.end())
+                    throw Unsupported{Logger::format("call to unknown function `$`", call->getName())};
+
+                auto declaration = m_functionDeclarations[find->second];
+                const auto& parameters = declaration->getArguments();
+
+                if(call->getArguments().size() != parameters.size())
+                    throw Unsupported{Logger::format("call to function `$` with missing arguments", call->getName())};
+
+                auto result = target(destination);
+                auto base = m_top;
+
+                for(std::size_t i{0ul}; i < parameters.size(); ++i)
+                    allocate();
+
+                for(const auto& argument: call->getArguments())
+                {
+                    auto parameter = std::find_if(parameters.begin(), parameters.end(), [&](const auto& parameter)
+                    {
+                        return parameter->getName() == argument.name;
+                    });
+
+                    if(parameter == parameters.end())
+                        throw Unsupported{Logger::format("call to function `$` with unknown argument `$`", call->getName(), argument.name)};
+
+                    compileExpression(argument.value.get(), base + static_cast<Register>(parameter - parameters.begin()));
+                }
+
+                emit(OpCode::Call, result, static_cast<Register>(find->second), base);
+                return;
+            }
+            case BoundNode::Kind::ExternalCallExpression:
+            {
+                auto call = static_cast<const BoundExternalCallExpression*>(expression);
+                const auto& arguments = call->getArguments();
+                auto result = target(destination);
+                auto base = m_top;
+
+                for(std::size_t i{0ul}; i < arguments.size(); ++i)
+                    allocate();
+
+                for(std::size_t i{0ul}; i < arguments.size(); ++i)
+                    compileExpression(arguments[i].get(), base + static_cast<Register>(i));
+
+                emit(OpCode::ExternalCall, result, external(call->getName(), static_cast<Register>(arguments.size())), base);
+
+                if(call->getName() == "sys_read")
+                {
+                    if(arguments.size() < 2ul || arguments[1ul]->getKind() != BoundNode::Kind::IdentifierExpression)
+                        throw Unsupported{"string argument in sys_read is not an identifier"};
+
+                    storePlace(resolvePlace(arguments[1ul].get()), base + 1u);
+                }
+                return;
+            }
+            case BoundNode::Kind::ConversionExpression:
+            {
+                auto conversion = static_cast<const BoundConversionExpression*>(expression);
+                auto value = compileOperand(conversion->getExpression());
+                emit(OpCode::Convert, target(destination), value, 0u, primitiveKind(conversion->getType()));
+                return;
+            }
+            case BoundNode::Kind::ArrayInitializerExpression:
+            {
+                auto array = static_cast<const BoundArrayInitializerExpression*>(expression);
+                auto result = target(destination);
+                emit(OpCode::LoadConstant, result, constant(ArrayValue::fromDefault(*expression->getType().array.baseType)));
+
+                for(const auto& value: array->getValues())
+                {
+                    auto mark = m_top;
+                    emit(OpCode::ArrayPush, result, compileOperand(value.get()));
+                    m_top = mark;
+                }
+                return;
+            }
+            case BoundNode::Kind::StructureInitializerExpression:
+            {
+                auto structure = static_cast<const BoundStructureInitializerExpression*>(expression);
+                auto result = target(destination);
+                emit(OpCode::LoadConstant, result, constant(Value(std::vector<Value>{})));
+
+                for(const auto& value: structure->getFields())
+                {
+                    auto mark = m_top;
+                    emit(OpCode::StructurePush, result, compileOperand(value.get()));
+                    m_top = mark;
+                }
+                return;
+            }
+            case BoundNode::Kind::IndexExpression:
+            {
+                auto index_expression = static_cast<const BoundIndexExpression*>(expression);
+                const auto& type = index_expression->getArray()->getType();
+
+                if(type.kind != Types::type::Kind::Array && !(type.kind == Types::type::Kind::Primitive && type.primitive == Types::Kind::string))
+                    throw Unsupported{"index expression on a value that is neither an array nor a string"};
+
+                if(auto global = findGlobalIdentifier(index_expression->getArray()))
+                {
+                    auto index = compileOperand(index_expression->getIndex());
+                    emit(OpCode::IndexGlobal, target(destination), *global, index);
+                    return;
+                }
+
+                auto array = compileOperand(index_expression->getArray(),
+                    !isPure(index_expression->getIndex(), placeVariable(index_expression->getArray()).value_or(std::string_view{})));
+                auto index = compileOperand(index_expression->getIndex());
+                emit(OpCode::Index, target(destination), array, index);
+                return;
+            }
+            case BoundNode::Kind::AccessExpression:
+            {
+                auto access = static_cast<const BoundAccessExpression*>(expression);
+                auto index = static_cast<Register>(access->getIndex());
+
+                if(auto global = findGlobalIdentifier(access->getBase()))
+                    emit(OpCode::AccessGlobal, target(destination), *global, index);
+                else emit(OpCode::Access, target(destination), compileOperand(access->getBase()), index);
+                return;
+            }
+            case BoundNode::Kind::EnumeratorExpression:
+            {
+                auto enumerator = static_cast<const BoundEnumeratorExpression*>(expression);
+                const auto& type = enumerator->getType();
+
+                if(type.kind != Types::type::Kind::Enumeration || enumerator->getEnumeratorIndex() >= type.enumeration.size())
+                    throw Unsupported{Logger::format("enumerator of unknown enumeration `$`", enumerator->getEnumerationName())};
+
+                Register value{};
+                if(enumerator->getValue())
+                    value = compileOperand(enumerator->getValue());
+                else emit(OpCode::LoadConstant, value = allocate(), constant(PrimitiveValue::voidValue));
+
+                m_program.enumerators.push_back(Bytecode::Enumerator{
+                    .name = type.enumeration.at(enumerator->getEnumeratorIndex()).first,
+                    .index = enumerator->getEnumeratorIndex()
+                });
+                emit(OpCode::Enumerator, target(destination), static_cast<Register>(m_program.enumerators.size() - 1ul), value);
+                return;
+            }
+            default:
+                throw Unsupported{Logger::format("unsupported expression `$`", expression->toString())};
+            }
+        }
+
+        std::optional<Register> findGlobalIdentifier(const BoundExpression* expression) const
+        {
+            if(expression->getKind() != BoundNode::Kind::IdentifierExpression)
+                return std::nullopt;
+
+            const auto& name = static_cast<const BoundIdentifierExpression*>(expression)->getValue();
+            return findLocal(name)? std::nullopt: findGlobal(name);
+        }
+
+        void compileForExpression(const BoundForExpression* for_expression, std::optional<Register> destination)
+        {
+            const auto& specifier = for_expression->getSpecifier();
+            beginScope();
+
+            if(destination)
+                emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue::voidValue));
+
+            if(auto variable_specifier = std::get_if<const BoundForExpression::BoundVariableForSpecifier>(&specifier))
+            {
+                compileDeclaration(variable_specifier->variableDeclaration.get());
+                auto jump_condition = emit(OpCode::Jump);
+
+                auto loop = here();
+                m_loops.push_back(Loop{.label = for_expression->getLabel()});
+                compileLoopBody(for_expression->getBody(), destination);
+
+                auto continue_target = here();
+                compileStatement(variable_specifier->statement.get());
+
+                patch(jump_condition, here());
+                auto mark = m_top;
+                emitTestJump(variable_specifier->expression.get(), true, loop);
+                m_top = mark;
+
+                endLoop(continue_target, here());
+            }
+            else if(auto range_specifier = std::get_if<const BoundForExpression::BoundRangeForSpecifier>(&specifier))
+            {
+                const auto& type = range_specifier->arrayIdentifier->getType();
+
+                if(type.kind != Types::type::Kind::Array && !(type.kind == Types::type::Kind::Primitive && type.primitive == Types::Kind::string))
+                    throw Unsupported{"ranged for expression over a value that is neither an array nor a string"};
+
+                auto array = allocate(), count = allocate(), index = allocate(), one = allocate(), condition = allocate();
+                compileExpression(range_specifier->arrayIdentifier.get(), array);
+                emit(OpCode::Count, count, array, 0u, Types::Kind::u64);
+                emit(OpCode::LoadConstant, index, constant(PrimitiveValue(Types::u64{0ul})));
+                emit(OpCode::LoadConstant, one, constant(PrimitiveValue(Types::u64{1ul})));
+
+                auto value = allocate();
+                m_scopes.back()[range_specifier->valueIdentifier->getValue()] = value;
+                auto jump_condition = emit(OpCode::Jump);
+
+                auto loop = here();
+                m_loops.push_back(Loop{.label = for_expression->getLabel()});
+                emit(OpCode::Index, value, array, index);
+                compileLoopBody(for_expression->getBody(), destination);
+
+                auto continue_target = here();
+                emit(OpCode::Add, index, index, one, Types::Kind::u64);
+
+                patch(jump_condition, here());
+                emit(OpCode::Less, condition, index, count);
+                emit(OpCode::JumpIfTrue, condition, loop);
+
+                endLoop(continue_target, here());
+            }
+            else throw Unsupported{"unrecognized for expression specifier"};
+
+            endScope();
+        }
+
+        void compileMatchExpression(const BoundMatchExpression* match_expression, std::optional<Register> destination)
+        {
+            // with a dispatch, the tested value is read before any clause is evaluated, so a variable is read in place
+            auto test = match_expression->getDispatch()? compileOperand(match_expression->getTestExpression()): allocate();
+
+            if(!match_expression->getDispatch())
+                compileExpression(match_expression->getTestExpression(), test);
+            std::vector<std::size_t> jumps_end;
+
+            auto bind = [&](const BoundExpression* value)
+            {
+                if(value->getKind() != BoundNode::Kind::EnumeratorExpression
+                || match_expression->getTestExpression()->getType().kind != Types::type::Kind::Enumeration)
+                    return;
+
+                auto enumerator = static_cast<const BoundEnumeratorExpression*>(value);
+
+                if(enumerator->getValue() && enumerator->getValue()->getKind() == BoundNode::Kind::IdentifierExpression)
+                {
+                    const auto& name = static_cast<const BoundIdentifierExpression*>(enumerator->getValue())->getValue();
+
+                    if(!findLocal(name) && !findGlobal(name))
+                    {
+                        auto bound_value = allocate();
+                        emit(OpCode::EnumeratorValue, bound_value, test);
+                        m_scopes.back()[name] = bound_value;
+                    }
+                }
+            };
+
+            if(const auto& dispatch = match_expression->getDispatch())
+            {
+                auto index = static_cast<Register>(m_function->switches.size());
+                m_function->switches.push_back(Bytecode::Switch{.dispatch = *dispatch, .targets = {}});
+                emit(OpCode::Switch, test, index);
+
+                std::vector<Register> targets;
+                for(const auto& clause: match_expression->getClauses()->getList())
+                {
+                    auto mark = m_top;
+                    beginScope();
+                    targets.push_back(here());
+
+                    for(const auto& value: clause->getValues()->getList())
+                        bind(value.get());
+
+                    compileExpression(clause->getExpression(), destination);
+                    jumps_end.push_back(emit(OpCode::Jump));
+
+                    endScope();
+                    m_top = mark;
+                }
+
+                targets.push_back(here());
+                m_function->switches[index].targets = std::move(targets);
+            }
+            else for(const auto& clause: match_expression->getClauses()->getList())
+                for(const auto& value: clause->getValues()->getList())
+                {
+                    auto mark = m_top;
+                    beginScope();
+                    bind(value.get());
+
+                    auto matches = allocate();
+                    emit(OpCode::Equals, matches, compileOperand(value.get()), test);
+                    auto jump_next = emit(OpCode::JumpIfFalse, matches);
+
+                    compileExpression(clause->getExpression(), destination);
+                    jumps_end.push_back(emit(OpCode::Jump));
+                    patch(jump_next, here());
+
+                    endScope();
+                    m_top = mark;
+                }
+
+            if(destination)
+                emit(OpCode::LoadConstant, *destination, defaultConstant(match_expression->getType()));
+
+            for(auto jump: jumps_end)
+                patch(jump, here());
+        }
+
+        void compileUnaryExpression(const BoundUnaryExpression* unary_expression, std::optional<Register> destination)
+        {
+            auto kind = primitiveKind(unary_expression->getType());
+            OpCode code{};
+
+            switch(unary_expression->getOperator()->getKind())
+            {
+            case BoundUnaryOperator::Kind::Typeof:
+                if(destination)
+                    emit(OpCode::LoadConstant, *destination, constant(PrimitiveValue(unary_expression->getOperand()->getType())));
+                return;
+            case BoundUnaryOperator::Kind::Increment:
+            case BoundUnaryOperator::Kind::Decrement:
+            {
+                auto place = resolvePlace(unary_expression->getOperand());
+                auto one = loadConstant(PrimitiveValue{1}.convert(kind));
+
+                auto current = loadPlace(place);
+                auto value = place.kind == Place::Kind::Local? current: allocate();
+                emit(unary_expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Increment? OpCode::Add: OpCode::Subtract,
+                    value, current, one, kind);
+                storePlace(place, value);
+
+                if(destination)
+                    emit(OpCode::Move, *destination, value);
+                return;
+            }
+            case BoundUnaryOperator::Kind::UnaryPlus: code = OpCode::Count; break;
+            case BoundUnaryOperator::Kind::UnaryMinus: code = OpCode::Negate; break;
+            case BoundUnaryOperator::Kind::LogicalNot: code = OpCode::LogicalNot; break;
+            case BoundUnaryOperator::Kind::BitwiseNot: code = OpCode::BitwiseNot; break;
+            case BoundUnaryOperator::Kind::Stringify: code = OpCode::Stringify; break;
+            default: throw Unsupported{"invalid unary operator"};
+            }
+
+            auto operand = compileOperand(unary_expression->getOperand());
+            emit(code, target(destination), operand, 0u, kind);
+        }
+
+        static std::optional<OpCode> binaryOpCode(BoundBinaryOperator::Kind kind)
+        {
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::Addition:
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+                return OpCode::Add;
+            case BoundBinaryOperator::Kind::Subtraction:
+            case BoundBinaryOperator::Kind::SubtractionAssignment:
+                return OpCode::Subtract;
+            case BoundBinaryOperator::Kind::Multiplication:
+            case BoundBinaryOperator::Kind::MultiplicationAssignment:
+                return OpCode::Multiply;
+            case BoundBinaryOperator::Kind::Division:
+            case BoundBinaryOperator::Kind::DivisionAssignment:
+                return OpCode::Divide;
+            case BoundBinaryOperator::Kind::Modulo:
+            case BoundBinaryOperator::Kind::ModuloAssignment:
+                return OpCode::Modulo;
+            case BoundBinaryOperator::Kind::Equals: return OpCode::Equals;
+            case BoundBinaryOperator::Kind::NotEquals: return OpCode::NotEquals;
+            case BoundBinaryOperator::Kind::Greater: return OpCode::Greater;
+            case BoundBinaryOperator::Kind::Less: return OpCode::Less;
+            case BoundBinaryOperator::Kind::GreaterEqual: return OpCode::GreaterEqual;
+            case BoundBinaryOperator::Kind::LessEqual: return OpCode::LessEqual;
+            case BoundBinaryOperator::Kind::BitwiseAnd: return OpCode::BitwiseAnd;
+            case BoundBinaryOperator::Kind::BitwiseOr: return OpCode::BitwiseOr;
+            case BoundBinaryOperator::Kind::BitwiseXor: return OpCode::BitwiseXor;
+            case BoundBinaryOperator::Kind::BitwiseShiftLeft: return OpCode::ShiftLeft;
+            case BoundBinaryOperator::Kind::BitwiseShiftRight: return OpCode::ShiftRight;
+            default: return std::nullopt;
+            }
+        }
+
+        void compileBinaryExpression(const BoundBinaryExpression* binary_expression, std::optional<Register> destination)
+        {
+            auto operator_kind = binary_expression->getOperator()->getKind();
+            auto kind = primitiveKind(binary_expression->getType());
+
+            if(operator_kind == BoundBinaryOperator::Kind::LogicalAnd || operator_kind == BoundBinaryOperator::Kind::LogicalOr)
+            {
+                auto result = target(destination);
+                auto left = compileOperand(binary_expression->getLeft());
+                auto jump_short = emit(operator_kind == BoundBinaryOperator::Kind::LogicalAnd? OpCode::JumpIfFalse: OpCode::JumpIfTrue, left);
+                auto right = compileOperand(binary_expression->getRight());
+                emit(OpCode::Test, result, right);
+                auto jump_end = emit(OpCode::Jump);
+                patch(jump_short, here());
+                emit(OpCode::LoadConstant, result, constant(PrimitiveValue(operator_kind == BoundBinaryOperator::Kind::LogicalOr)));
+                patch(jump_end, here());
+                return;
+            }
+            else if(operator_kind == BoundBinaryOperator::Kind::Assignment)
+            {
+                auto place = resolvePlace(binary_expression->getLeft());
+
+                if(place.kind == Place::Kind::Local && writesLast(binary_expression->getRight()))
+                {
+                    compileExpression(binary_expression->getRight(), place.base);
+
+                    if(destination)
+                        emit(OpCode::Narrow, *destination, place.base, 0u, kind);
+                    return;
+                }
+
+                auto value = compileOperand(binary_expression->getRight(), place.kind == Place::Kind::Local);
+                storePlace(place, value);
+
+                if(destination)
+                    emit(OpCode::Narrow, *destination, value, 0u, kind);
+                return;
+            }
+
+            auto code = binaryOpCode(operator_kind);
+            if(!code)
+                throw Unsupported{"invalid binary operator"};
+
+            if(isAssignment(operator_kind))
+            {
+                auto place = resolvePlace(binary_expression->getLeft());
+                auto current = loadPlace(place, !isPure(binary_expression->getRight()));
+                auto right = compileOperand(binary_expression->getRight());
+                auto value = place.kind == Place::Kind::Local? place.base: allocate();
+
+                emit(*code, value, current, right, kind);
+                storePlace(place, value);
+
+                if(destination)
+                    emit(OpCode::Move, *destination, value);
+                return;
+            }
+
+            auto left = compileOperand(binary_expression->getLeft(),
+                !isPure(binary_expression->getRight(), placeVariable(binary_expression->getLeft()).value_or(std::string_view{})));
+            auto right = compileOperand(binary_expression->getRight());
+            emit(*code, target(destination), left, right, kind);
+        }
+
+        Place resolvePlace(const BoundExpression* expression)
+        {
+            auto resolve_variable = [this](const BoundExpression* variable, Place::Kind local_kind, Place::Kind global_kind) -> std::optional<Place>
+            {
+                if(variable->getKind() != BoundNode::Kind::IdentifierExpression)
+                    return std::nullopt;
+
+                const auto& name = static_cast<const BoundIdentifierExpression*>(variable)->getValue();
+
+                if(auto local = findLocal(name))
+                    return Place{.kind = local_kind, .base = *local};
+                else if(auto global = findGlobal(name))
+                    return Place{.kind = global_kind, .base = *global};
+                else return std::nullopt;
+            };
+
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::IdentifierExpression:
+                if(auto place = resolve_variable(expression, Place::Kind::Local, Place::Kind::Global))
+                    return *place;
+                break;
+            case BoundNode::Kind::IndexExpression:
+            {
+                auto index_expression = static_cast<const BoundIndexExpression*>(expression);
+
+                if(auto place = resolve_variable(index_expression->getArray(), Place::Kind::LocalIndex, Place::Kind::GlobalIndex))
+                {
+                    place->index = compileOperand(index_expression->getIndex(), true);
+                    return *place;
+                }
+                break;
+            }
+            case BoundNode::Kind::AccessExpression:
+            {
+                auto access_expression = static_cast<const BoundAccessExpression*>(expression);
+
+                if(auto place = resolve_variable(access_expression->getBase(), Place::Kind::LocalAccess, Place::Kind::GlobalAccess))
+                {
+                    place->index = static_cast<Register>(access_expression->getIndex());
+                    return *place;
+                }
+                break;
+            }
+            default: break;
+            }
+
+            throw Unsupported{"mutable operator on a temporary operand"};
+        }
+
+        /// @brief Read the current value of a place into a register.
+        /// @param copy Whether local variables must be copied, as the expressions evaluated afterwards may modify them.
+        Register loadPlace(const Place& place, bool copy = false)
+        {
+            if(place.kind == Place::Kind::Local && !copy)
+                return place.base;
+
+            auto result = allocate();
+
+            switch(place.kind)
+            {
+            case Place::Kind::Local: emit(OpCode::Move, result, place.base); break;
+            case Place::Kind::Global: emit(OpCode::LoadGlobal, result, place.base); break;
+            case Place::Kind::LocalIndex: emit(OpCode::Index, result, place.base, place.index); break;
+            case Place::Kind::GlobalIndex: emit(OpCode::IndexGlobal, result, place.base, place.index); break;
+            case Place::Kind::LocalAccess: emit(OpCode::Access, result, place.base, place.index); break;
+            case Place::Kind::GlobalAccess: emit(OpCode::AccessGlobal, result, place.base, place.index); break;
+            }
+
+            return result;
+        }
+
+        void storePlace(const Place& place, Register value)
+        {
+            switch(place.kind)
+            {
+            case Place::Kind::Local:
+                if(place.base != value)
+                    emit(OpCode::Move, place.base, value);
+                break;
+            case Place::Kind::Global: emit(OpCode::StoreGlobal, place.base, value); break;
+            case Place::Kind::LocalIndex: emit(OpCode::SetIndex, place.base, place.index, value); break;
+            case Place::Kind::GlobalIndex: emit(OpCode::SetIndexGlobal, place.base, place.index, value); break;
+            case Place::Kind::LocalAccess: emit(OpCode::SetAccess, place.base, place.index, value); break;
+            case Place::Kind::GlobalAccess: emit(OpCode::SetAccessGlobal, place.base, place.index, value); break;
+            }
+        }
+
+        Bytecode::Program m_program;
+        Bytecode::Function* m_function{};
+        std::unordered_map<std::string, std::size_t> m_functionIndices;
+        std::vector<const BoundFunctionDeclaration*> m_functionDeclarations;
+        std::unordered_map<std::string, Register> m_globals;
+        std::vector<std::unordered_map<std::string, Register>> m_scopes;
+        std::vector<Loop> m_loops;
+        std::map<ConstantKey, Register> m_hoisted;
+        Register m_top{};
+        std::string m_unsupportedReason;
+    };
+}
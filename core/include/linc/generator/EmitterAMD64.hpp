@@ -1,6 +1,7 @@
 #pragma once
 #include <linc/System.hpp>
 #include <linc/Include.hpp>
+#include <charconv>
 #define LINC_EMITTER_LITERAL_INDENT "    "
 
 namespace linc
@@ -12,18 +13,19 @@ namespace linc
         {
             Push, Pop, Call, Jump, JumpIfZero, JumpIfNotZero, JumpIfEqual, JumpIfNotEqual, JumpIfGreater, JumpIfLess, JumpIfGreaterEqual, JumpIfLessEqual,
             Negate, Increment, Decrement, Not, UnsignedMultiply, SignedMultiply, UnsignedDivide, SignedDivide, SetIfEqual, SetIfNotEqual,
-            SetIfGreater, SetIfGreaterEqual, SetIfLess, SetIfLessEqual
+            SetIfGreater, SetIfGreaterEqual, SetIfLess, SetIfLessEqual, JumpIfAbove, JumpIfBelow, JumpIfAboveEqual, JumpIfBelowEqual,
+            SetIfAbove, SetIfAboveEqual, SetIfBelow, SetIfBelowEqual
         };
 
         enum class NullaryInstruction: unsigned char
         {
-            Syscall, Leave, Return, ConvertDoubleQuad, ConvertQuadOctal
+            Syscall, Leave, Return, ConvertByteWord, ConvertWordDouble, ConvertDoubleQuad, ConvertQuadOctal
         };
 
         enum class BinaryInstruction: unsigned char
         {
-            Move, MoveExtend, MoveIfZero, And, Or, Xor, Add, Subtract, Multiply, Divide, Compare, Test, ConvertFloatToInt, ConvertDoubleToInt, ConvertIntToFloat,
-            ConvertIntToDouble, ConvertFloatToDouble, ConvertDoubleToFloat, BitShiftLeft, BitShiftRight
+            Move, MoveExtend, MoveSignExtend, MoveSignExtendDoubleWord, MoveIfZero, And, Or, Xor, Add, Subtract, Multiply, Divide, Compare, Test, ConvertFloatToInt, ConvertDoubleToInt, ConvertIntToFloat,
+            ConvertIntToDouble, ConvertFloatToDouble, ConvertDoubleToFloat, BitShiftLeft, BitShiftRight, ArithmeticShiftRight
         };
 
         enum class InstructionKind: unsigned char
@@ -31,35 +33,133 @@ namespace linc
             General, Float, Double
         };
 
+        /// @brief An instruction operand: a general purpose or vector register, a memory location addressed by a base and an
+        /// index register or by a symbol plus a displacement, an immediate, or a symbol standing for its address.
+        struct Operand final
+        {
+            enum class Kind: unsigned char
+            {
+                None, Register, Vector, Memory, Immediate, Symbol
+            };
+
+            static constexpr std::uint8_t noRegister{0xFFu};
+            static constexpr std::uint32_t noSymbol{0xFFFFFFFFu};
+
+            Kind kind{Kind::None};
+            Registers::Size size{Registers::Size::QuadWord};
+
+            /// @brief The register of register operands, or the base register of memory operands.
+            std::uint8_t order{noRegister}, index{noRegister};
+            std::uint32_t symbol{noSymbol};
+
+            /// @brief The value of immediates, or the displacement of memory operands.
+            Types::i64 value{};
+
+            [[nodiscard]] bool operator==(const Operand& other) const = default;
+        };
+
+        /// @brief An instruction recorded by the emitter, or the definition of a label (with the label as its operand).
+        struct Instruction final
+        {
+            enum class Form: unsigned char
+            {
+                Label, Nullary, Unary, Binary
+            };
+
+            Form form;
+            InstructionKind kind{InstructionKind::General};
+            NullaryInstruction nullary{};
+            UnaryInstruction unary{};
+            BinaryInstruction binary{};
+            std::array<Operand, 2ul> operands{};
+        };
+
+        /// @brief Offsets of the header preceding the characters of compiled strings: the capacity they may be appended to in place
+        /// (zero for strings which may be shared, such as literals) and their length.
+        static constexpr Types::i64 stringCapacityOffset{-16l}, stringLengthOffset{-8l};
+
         [[nodiscard]] inline const std::string& getDataSegment() const { return m_dataSegment; }
-        [[nodiscard]] inline const std::string& getCodeSegment() const { return m_codeSegment; }
+        [[nodiscard]] inline std::string getCodeSegment() const
+        {
+            std::string code;
+            code.reserve(m_instructions.size() * 24ul);
+
+            for(const auto& instruction: m_instructions)
+                render(code, instruction);
+
+            return code;
+        }
+
         [[nodiscard]] inline std::string get() const
         {
-            std::string directives;
+            std::string output{"segment .data\n"};
+            output.append(m_dataSegment).append("\nsegment .text\n");
+
             for(const auto& global: m_globalSymbols)
-                directives.append(std::string{s_indent} + "global " + global + '\n');
+                output.append(s_indent).append("global ").append(global).push_back('\n');
             
             for(const auto& external: m_externalSymbols)
-                directives.append(std::string{s_indent} + "extern " + external + '\n');
+                output.append(s_indent).append("extern ").append(external).push_back('\n');
 
-            return Logger::format("segment .data\n$\nsegment .text\n$\n$", m_dataSegment, directives, m_codeSegment);
+            output.push_back('\n');
+            output.append(getCodeSegment());
+            return output;
         }
         [[nodiscard]] inline std::size_t getStackPosition() const { return m_stackPosition; } 
+        [[nodiscard]] inline std::vector<Instruction>& getInstructions() { return m_instructions; }
+        [[nodiscard]] inline const std::vector<Instruction>& getInstructions() const { return m_instructions; }
+        [[nodiscard]] inline const std::string& getSymbolName(std::uint32_t symbol) const { return m_symbols.at(symbol); }
+        [[nodiscard]] inline bool isGlobal(const std::string& symbol_name) const { return m_globalSymbols.contains(symbol_name); }
+        [[nodiscard]] inline const std::vector<std::uint32_t>& getDataReferences() const { return m_dataReferences; }
+
+        [[nodiscard]] static Operand getRegister(std::uint8_t order, Registers::Size size)
+        {
+            return Operand{.kind = Operand::Kind::Register, .size = size, .order = order};
+        }
+
+        [[nodiscard]] static Operand getVector(std::uint8_t index)
+        {
+            return Operand{.kind = Operand::Kind::Vector, .order = index};
+        }
+
+        [[nodiscard]] static Operand getImmediate(Types::i64 value)
+        {
+            return Operand{.kind = Operand::Kind::Immediate, .value = value};
+        }
+
+        [[nodiscard]] static Operand getMemory(std::uint8_t base, Types::i64 displacement, Registers::Size size)
+        {
+            return Operand{.kind = Operand::Kind::Memory, .size = size, .order = base, .value = displacement};
+        }
+
+        /// @brief Get a symbol operand, standing for the address of a label.
+        [[nodiscard]] Operand getSymbol(std::string_view name)
+        {
+            return Operand{.kind = Operand::Kind::Symbol, .symbol = intern(name)};
+        }
+
+        /// @brief Get a memory operand at the address of a label.
+        [[nodiscard]] Operand getAddress(std::string_view name, Registers::Size size)
+        {
+            return Operand{.kind = Operand::Kind::Memory, .size = size, .symbol = intern(name)};
+        }
 
-        [[nodiscard]] inline std::string unaryAddress(std::string_view register_name, Registers::Size size)
+        [[nodiscard]] inline std::string unaryAddress(std::string_view register_name, Registers::Size size, Types::i64 displacement = 0l)
         {
-            return registerSizeToAddressString(size) + " [" + std::string{register_name} + ']';
+            return std::string{registerSizeToAddressString(size)} + " [" + std::string{register_name} + (displacement == 0l? std::string{}:
+                displacement > 0l? Logger::format(" + $", displacement): Logger::format(" - $", -displacement)) + ']';
         }
 
         [[nodiscard]] inline std::string binaryAddress(std::string_view first_register, std::string_view second_register, Registers::Size size)
         {
-            return registerSizeToAddressString(size) + " [" + std::string{first_register} + " + " + std::string{second_register} + ']';
+            return std::string{registerSizeToAddressString(size)} + " [" + std::string{first_register} + " + " + std::string{second_register} + ']';
         }
 
-        inline void reset() { m_dataSegment = m_codeSegment = std::string{}; }
-        inline void emit(const std::string& line, bool has_indent = true)
+        inline void reset()
         {
-            m_codeSegment.append((has_indent? s_indent: std::string{}) + line + '\n');
+            m_dataSegment = std::string{};
+            m_instructions.clear();
+            m_dataReferences.clear();
         }
 
         inline void emitData(const std::string& line, bool has_indent = true)
@@ -72,10 +172,15 @@ namespace linc
         std::string label(std::string_view name = std::string{})
         {
             std::string label_name = name.empty()? Logger::format("L$", m_labelCounter++): std::string{name};
-            emit(label_name + ':', false);
+            label(getSymbol(label_name));
             return label_name;
         }
 
+        void label(const Operand& symbol)
+        {
+            m_instructions.push_back(Instruction{.form = Instruction::Form::Label, .operands = {symbol, Operand{}}});
+        }
+
         inline std::string getLocalLabel(std::size_t label_identifier_index) const { return m_localLabelMap.at(label_identifier_index); }
         std::string localLabel(std::size_t label_identifier_index)
         {
@@ -84,7 +189,7 @@ namespace linc
                 return find->second;
 
             std::string label_name = std::string{".L"} + std::to_string(m_localLabelCounter++);
-            emit(label_name + ':');
+            label(getSymbol(label_name));
             m_localLabelMap.insert(std::pair<std::size_t, std::string>(label_identifier_index, label_name));
             return label_name;
         }
@@ -96,12 +201,39 @@ namespace linc
             return label_name;
         }
 
-        inline void push(std::string_view register_name) { unary(UnaryInstruction::Push, register_name); ++m_stackPosition; }
-        inline void pop(std::string_view register_name) { unary(UnaryInstruction::Pop, register_name); --m_stackPosition; }
-        inline void test(std::string_view register_name) { binary(BinaryInstruction::Test, register_name, register_name); }
+        /// @brief Define a table of the addresses of the specified labels in the data segment, for indirect jumps.
+        std::string defineJumpTable(const std::vector<Operand>& labels)
+        {
+            std::string entries;
+            for(const auto& label: labels)
+            {
+                entries.append(entries.empty()? "dq ": ", ").append(m_symbols.at(label.symbol));
+                m_dataReferences.push_back(label.symbol);
+            }
+
+            return identifier(entries);
+        }
+
+        inline void push(std::string_view register_name) { push(parse(register_name)); }
+        inline void push(const Operand& operand) { unary(UnaryInstruction::Push, operand); ++m_stackPosition; }
+        inline void pop(std::string_view register_name) { pop(parse(register_name)); }
+        inline void pop(const Operand& operand) { unary(UnaryInstruction::Pop, operand); --m_stackPosition; }
+        inline void discard(std::size_t count)
+        {
+            if(count == 0ul) return;
+            binary(BinaryInstruction::Add, getRegister(LINC_REGISTERS_STACK, Registers::Size::QuadWord), getImmediate(static_cast<Types::i64>(8ul * count)));
+            m_stackPosition -= count;
+        }
+        inline void test(std::string_view register_name) { test(parse(register_name)); }
+        inline void test(const Operand& operand) { binary(BinaryInstruction::Test, operand, operand); }
         inline void external(std::string_view symbol_name) { m_externalSymbols.insert(std::string{symbol_name}); }
         inline void global(std::string_view symbol_name) { m_globalSymbols.insert(std::string{symbol_name}); }
-        inline void prologue() { push(Registers::getBase()); binary(BinaryInstruction::Move, Registers::getBase(), Registers::getStack()); m_localLabelCounter = {}; }
+        inline void prologue()
+        {
+            push(getRegister(LINC_REGISTERS_BASE, Registers::Size::QuadWord));
+            binary(BinaryInstruction::Move, getRegister(LINC_REGISTERS_BASE, Registers::Size::QuadWord), getRegister(LINC_REGISTERS_STACK, Registers::Size::QuadWord));
+            m_localLabelCounter = {};
+        }
         inline void epilogue() { nullary(NullaryInstruction::Leave); nullary(NullaryInstruction::Return); }
 
         std::string getStackOffset(std::size_t offset)
@@ -111,10 +243,14 @@ namespace linc
                 signed_offset > 0l? Logger::format(" + $]", signed_offset): Logger::format(" - $]", -signed_offset));
         }
 
+        /// @brief Define the characters of a string literal, preceded by the header of compiled strings (with no capacity).
         std::string defineStringLiteral(std::string_view contents, bool unique = false)
         {
             if(contents.empty())
-                return identifier("db 0"); 
+            {
+                emitData("dq 0, 0");
+                return identifier("db 0");
+            }
 
             if(!unique)
             {
@@ -151,6 +287,7 @@ namespace linc
                 }
             }
 
+            emitData(Logger::format("dq 0, $", contents.size()));
             auto result = identifier(Logger::format("db $0", literal));
             
             if(!unique)
@@ -170,25 +307,212 @@ namespace linc
             case Registers::Size::QuadWord: define_directive.push_back('q'); break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(size);
             }
-            return identifier(Logger::format("$ $0", define_directive, numeral));
+            return identifier(Logger::format("$ $", define_directive, numeral));
         }
 
         inline void binary(BinaryInstruction instruction, std::string_view destination, std::string_view source, InstructionKind kind = InstructionKind::General)
         {
-            emit(binaryInstructionToString(instruction, kind) + ' ' + std::string{destination} + ", " + std::string{source});
+            binary(instruction, parse(destination), parse(source), kind);
+        }
+
+        inline void binary(BinaryInstruction instruction, const Operand& destination, const Operand& source, InstructionKind kind = InstructionKind::General)
+        {
+            m_instructions.push_back(Instruction{.form = Instruction::Form::Binary, .kind = kind, .binary = instruction, .operands = {destination, source}});
         }
 
         inline void unary(UnaryInstruction instruction, std::string_view operand, InstructionKind kind = InstructionKind::General)
         {
-            emit(unaryInstructionToString(instruction, kind) + ' ' + std::string{operand});
+            unary(instruction, parse(operand), kind);
+        }
+
+        inline void unary(UnaryInstruction instruction, const Operand& operand, InstructionKind kind = InstructionKind::General)
+        {
+            m_instructions.push_back(Instruction{.form = Instruction::Form::Unary, .kind = kind, .unary = instruction, .operands = {operand, Operand{}}});
         }
 
         inline void nullary(NullaryInstruction instruction)
         {
-            emit(nullaryInstructionToString(instruction));
+            m_instructions.push_back(Instruction{.form = Instruction::Form::Nullary, .nullary = instruction});
+        }
+
+        /// @brief Append the text of an instruction, in NASM syntax.
+        void render(std::string& output, const Instruction& instruction) const
+        {
+            switch(instruction.form)
+            {
+            case Instruction::Form::Label:
+            {
+                const auto& name = m_symbols[instruction.operands[0ul].symbol];
+                if(name.starts_with('.'))
+                    output.append(s_indent);
+                output.append(name).append(":\n");
+                return;
+            }
+            case Instruction::Form::Nullary:
+                output.append(s_indent).append(nullaryInstructionToString(instruction.nullary)).push_back('\n');
+                return;
+            case Instruction::Form::Unary:
+                output.append(s_indent).append(unaryInstructionToString(instruction.unary, instruction.kind)).push_back(' ');
+                render(output, instruction.operands[0ul]);
+                output.push_back('\n');
+                return;
+            case Instruction::Form::Binary:
+                output.append(s_indent).append(binaryInstructionToString(instruction.binary, instruction.kind)).push_back(' ');
+                render(output, instruction.operands[0ul]);
+                output.append(", ");
+                render(output, instruction.operands[1ul]);
+                output.push_back('\n');
+                return;
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(instruction.form);
+            }
+        }
+
+        void render(std::string& output, const Operand& operand) const
+        {
+            switch(operand.kind)
+            {
+            case Operand::Kind::Register:
+                output.append(s_registerNames.at(operand.order).at(static_cast<std::size_t>(operand.size)));
+                return;
+            case Operand::Kind::Vector:
+                output.append("xmm");
+                appendNumber(output, operand.order);
+                return;
+            case Operand::Kind::Immediate:
+                appendNumber(output, operand.value);
+                return;
+            case Operand::Kind::Symbol:
+                output.append(m_symbols[operand.symbol]);
+                return;
+            case Operand::Kind::Memory:
+                output.append(registerSizeToAddressString(operand.size)).append(" [");
+
+                if(operand.symbol != Operand::noSymbol)
+                    output.append(m_symbols[operand.symbol]);
+                else output.append(s_registerNames.at(operand.order).back());
+
+                if(operand.index != Operand::noRegister)
+                    output.append(" + ").append(s_registerNames.at(operand.index).back());
+
+                if(operand.value != 0l)
+                {
+                    output.append(operand.value < 0l? " - ": " + ");
+                    appendNumber(output, operand.value < 0l? -operand.value: operand.value);
+                }
+
+                output.push_back(']');
+                return;
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(operand.kind);
+            }
         }
     private:
-        static std::string registerSizeToAddressString(Registers::Size size)
+        /// @brief The names of the general purpose registers by order and size.
+        static constexpr std::array<std::array<std::string_view, 4ul>, 16ul> s_registerNames{{
+            {"al", "ax", "eax", "rax"}, {"bl", "bx", "ebx", "rbx"}, {"cl", "cx", "ecx", "rcx"}, {"dl", "dx", "edx", "rdx"},
+            {"sil", "si", "esi", "rsi"}, {"dil", "di", "edi", "rdi"}, {"bpl", "bp", "ebp", "rbp"}, {"spl", "sp", "esp", "rsp"},
+            {"r8b", "r8w", "r8d", "r8"}, {"r9b", "r9w", "r9d", "r9"}, {"r10b", "r10w", "r10d", "r10"}, {"r11b", "r11w", "r11d", "r11"},
+            {"r12b", "r12w", "r12d", "r12"}, {"r13b", "r13w", "r13d", "r13"}, {"r14b", "r14w", "r14d", "r14"}, {"r15b", "r15w", "r15d", "r15"}
+        }};
+
+        template <typename T>
+        static void appendNumber(std::string& output, T value)
+        {
+            std::array<char, 24ul> buffer;
+            auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            output.append(buffer.data(), result.ptr);
+        }
+
+        std::uint32_t intern(std::string_view name)
+        {
+            auto find = m_symbolMap.find(std::string{name});
+            if(find != m_symbolMap.end())
+                return find->second;
+
+            auto symbol = static_cast<std::uint32_t>(m_symbols.size());
+            m_symbols.emplace_back(name);
+            m_symbolMap.emplace(m_symbols.back(), symbol);
+            return symbol;
+        }
+
+        [[nodiscard]] static std::optional<Operand> parseRegister(std::string_view name)
+        {
+            for(std::uint8_t order{0u}; order < s_registerNames.size(); ++order)
+                for(std::size_t size{0ul}; size < s_registerNames[order].size(); ++size)
+                    if(s_registerNames[order][size] == name)
+                        return getRegister(order, static_cast<Registers::Size>(size));
+
+            if(name.starts_with("xmm"))
+            {
+                std::uint8_t index{};
+                auto result = std::from_chars(name.data() + 3ul, name.data() + name.size(), index);
+                if(result.ec == std::errc{} && result.ptr == name.data() + name.size())
+                    return getVector(index);
+            }
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] static std::optional<Types::i64> parseNumber(std::string_view text)
+        {
+            const bool is_negative = text.starts_with('-');
+            Types::u64 value{};
+            auto result = std::from_chars(text.data() + (is_negative? 1ul: 0ul), text.data() + text.size(), value);
+
+            if(result.ec != std::errc{} || result.ptr != text.data() + text.size() || text.size() == (is_negative? 1ul: 0ul))
+                return std::nullopt;
+
+            return static_cast<Types::i64>(is_negative? ~value + 1ul: value);
+        }
+
+        /// @brief Parse an operand given as text: a register, a sized memory access, a number or a symbol.
+        Operand parse(std::string_view text)
+        {
+            for(auto size: {Registers::Size::Byte, Registers::Size::Word, Registers::Size::DoubleWord, Registers::Size::QuadWord})
+                if(auto prefix = registerSizeToAddressString(size); text.starts_with(prefix) && text.size() > prefix.size() + 2ul
+                    && text[prefix.size()] == ' ' && text[prefix.size() + 1ul] == '[' && text.back() == ']')
+                    return parseAddress(text.substr(prefix.size() + 2ul, text.size() - prefix.size() - 3ul), size);
+
+            if(auto operand = parseRegister(text))
+                return *operand;
+
+            if(auto number = parseNumber(text))
+                return getImmediate(*number);
+
+            return getSymbol(text);
+        }
+
+        /// @brief Parse the expression of a memory operand, a sum of up to two registers and a displacement, or a symbol.
+        Operand parseAddress(std::string_view expression, Registers::Size size)
+        {
+            Operand operand{.kind = Operand::Kind::Memory, .size = size};
+            bool is_negative{};
+
+            while(!expression.empty())
+            {
+                auto end = expression.find_first_of("+-");
+                auto term = expression.substr(0ul, end);
+                while(term.starts_with(' ')) term.remove_prefix(1ul);
+                while(term.ends_with(' ')) term.remove_suffix(1ul);
+
+                if(auto number = parseNumber(term))
+                    operand.value += is_negative? -*number: *number;
+                else if(auto reg = parseRegister(term); reg && reg->kind == Operand::Kind::Register && !is_negative)
+                    (operand.order == Operand::noRegister? operand.order: operand.index) = reg->order;
+                else if(!term.empty() && !is_negative)
+                    operand.symbol = intern(term);
+                else throw LINC_EXCEPTION_INVALID_INPUT("Unsupported memory operand expression.");
+
+                if(end == std::string_view::npos)
+                    break;
+
+                is_negative = expression[end] == '-';
+                expression.remove_prefix(end + 1ul);
+            }
+
+            return operand;
+        }
+
+        static std::string_view registerSizeToAddressString(Registers::Size size)
         {
             switch(size)
             {
@@ -199,7 +523,7 @@ namespace linc
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(size);
             }
         }
-        static std::string unaryInstructionToString(UnaryInstruction instruction, InstructionKind kind)
+        static std::string_view unaryInstructionToString(UnaryInstruction instruction, InstructionKind kind)
         {
             switch(kind)
             {
@@ -232,6 +556,14 @@ namespace linc
                 case UnaryInstruction::SetIfGreaterEqual: return "setge";
                 case UnaryInstruction::SetIfLess: return "setl";
                 case UnaryInstruction::SetIfLessEqual: return "setle";
+                case UnaryInstruction::JumpIfAbove: return "ja";
+                case UnaryInstruction::JumpIfBelow: return "jb";
+                case UnaryInstruction::JumpIfAboveEqual: return "jae";
+                case UnaryInstruction::JumpIfBelowEqual: return "jbe";
+                case UnaryInstruction::SetIfAbove: return "seta";
+                case UnaryInstruction::SetIfAboveEqual: return "setae";
+                case UnaryInstruction::SetIfBelow: return "setb";
+                case UnaryInstruction::SetIfBelowEqual: return "setbe";
                 default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(instruction);
                 }
             case InstructionKind::Float:
@@ -257,7 +589,7 @@ namespace linc
             }
         }
 
-        static std::string binaryInstructionToString(BinaryInstruction instruction, InstructionKind kind)
+        static std::string_view binaryInstructionToString(BinaryInstruction instruction, InstructionKind kind)
         {
             switch(kind)
             {
@@ -266,12 +598,15 @@ namespace linc
                 {
                 case BinaryInstruction::Move: return "mov";
                 case BinaryInstruction::MoveExtend: return "movzx";
+                case BinaryInstruction::MoveSignExtend: return "movsx";
+                case BinaryInstruction::MoveSignExtendDoubleWord: return "movsxd";
                 case BinaryInstruction::MoveIfZero: return "cmovz";
                 case BinaryInstruction::And: return "and";
                 case BinaryInstruction::Or: return "or";
                 case BinaryInstruction::Xor: return "xor";
                 case BinaryInstruction::Add: return "add";
                 case BinaryInstruction::Subtract: return "sub";
+                case BinaryInstruction::Multiply: return "imul";
                 case BinaryInstruction::Compare: return "cmp";
                 case BinaryInstruction::Test: return "test";
                 case BinaryInstruction::ConvertFloatToInt: return "cvttss2si";
@@ -282,6 +617,7 @@ namespace linc
                 case BinaryInstruction::ConvertDoubleToFloat: return "cvtsd2ss";
                 case BinaryInstruction::BitShiftLeft: return "shl";
                 case BinaryInstruction::BitShiftRight: return "shr";
+                case BinaryInstruction::ArithmeticShiftRight: return "sar";
                 default: throw LINC_EXCEPTION_ILLEGAL_VALUE(instruction);
                 }
             case InstructionKind::Float:
@@ -310,13 +646,15 @@ namespace linc
             }
         }
 
-        static std::string nullaryInstructionToString(NullaryInstruction instruction)
+        static std::string_view nullaryInstructionToString(NullaryInstruction instruction)
         {
             switch(instruction)
             {
             case NullaryInstruction::Syscall: return "syscall";
             case NullaryInstruction::Leave: return "leave";
             case NullaryInstruction::Return: return "ret";
+            case NullaryInstruction::ConvertByteWord: return "cbw";
+            case NullaryInstruction::ConvertWordDouble: return "cwd";
             case NullaryInstruction::ConvertDoubleQuad: return "cdq";
             case NullaryInstruction::ConvertQuadOctal: return "cqo";
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(instruction);
@@ -337,7 +675,11 @@ namespace linc
             return result;
         }
 
-        std::string m_dataSegment, m_codeSegment;
+        std::string m_dataSegment;
+        std::vector<Instruction> m_instructions;
+        std::vector<std::uint32_t> m_dataReferences;
+        std::vector<std::string> m_symbols;
+        std::unordered_map<std::string, std::uint32_t> m_symbolMap;
         std::size_t m_labelCounter{0ul}, m_localLabelCounter{0ul}, m_stackPosition{0ul};
         std::unordered_map<std::string, std::string> m_literalMap;
         std::unordered_map<std::size_t, std::string> m_localLabelMap;
@@ -9,13 +9,13 @@ namespace linc
     {
     public:
         Generator() = delete;
-        static std::pair<std::string, bool> operator()(const BoundProgram* program, Target target)
+        static std::pair<std::string, bool> operator()(const BoundProgram* program, Target target, bool optimization = false)
         {
             switch(target.architecture)
             {
             case Target::Architecture::AMD64:
             {
-                GeneratorAMD64 generator(program, target.platform);
+                GeneratorAMD64 generator(program, target.platform, optimization);
                 return generator.generateProgram();
             }
             case Target::Architecture::I386:
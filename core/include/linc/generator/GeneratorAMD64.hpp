@@ -1,7 +1,12 @@
 #pragma once
 #include <linc/generator/Registers.hpp>
+#include <linc/generator/RegisterAllocator.hpp>
 #include <linc/generator/Target.hpp>
 #include <linc/generator/EmitterAMD64.hpp>
+#include <linc/generator/IRCompiler.hpp>
+#include <linc/generator/IRPasses.hpp>
+#include <linc/generator/InstructionSelectorAMD64.hpp>
+#include <linc/generator/PeepholeOptimizerAMD64.hpp>
 
 #define LINC_EXIT_PROGRAM_FAILURE 5
 #define LINC_EXIT_PROGRAM_SUCCESS 0
@@ -11,62 +16,112 @@
 
 namespace linc
 {
+    /// @brief Generates NASM assembly for a bound program. Expressions are evaluated into registers of the caller-saved pool
+    /// (see Registers), and the arguments and local variables of every function are kept in registers assigned by the
+    /// RegisterAllocator. Values only go through the stack when registers run out, or to survive function calls. Functions
+    /// the IRCompiler supports are instead lowered through the intermediate representation and the InstructionSelectorAMD64.
     class GeneratorAMD64 final
     {
     public:
         using Emitter = EmitterAMD64;
-        GeneratorAMD64(const BoundProgram* program, Target::Platform platform)
-            :m_program(program), m_platform(platform)
+        GeneratorAMD64(const BoundProgram* program, Target::Platform platform, bool optimization = false)
+            :m_program(program), m_platform(platform), m_optimization(optimization)
         {}
 
-        using Variable = std::variant<std::string, std::size_t>;
+        /// @brief The register holding the value of an expression. Temporaries are owned by the consumer of the expression, which
+        /// must release them, while other operands are the registers of local variables and must not be written to.
+        struct Operand final
+        {
+            std::uint8_t index;
+            bool isTemporary{true};
+        };
+
+        struct Register final
+        {
+            std::uint8_t index;
+        };
+
+        using Variable = std::variant<std::string, std::size_t, Register>;
+
+        /// @brief A function call argument, held either in a register or, under register pressure, on the stack.
+        using Argument = std::variant<Operand, std::size_t>;
 
         std::pair<std::string, bool> generateProgram()
         {
             m_variables = ScopeStack<Variable>();
             m_variables.beginScope();
             m_hasMain = {};
+            m_function = nullptr;
+            m_locals.clear();
             m_emitter.reset();
+            Registers::reset();
+
+            IRCompiler compiler;
+            m_module = compiler.compileProgram(m_program);
+            IRPassManager::makePipeline(m_optimization).run(m_module);
+
+            m_functions.clear();
+            for(const auto& declaration: m_program->declarations)
+                if(declaration->getKind() == BoundNode::Kind::FunctionDeclaration)
+                    if(auto index = compiler.findFunction(static_cast<const BoundFunctionDeclaration*>(declaration.get())))
+                        m_functions[static_cast<const BoundFunctionDeclaration*>(declaration.get())] = *index;
 
             for(const auto& declaration: m_program->declarations)
                 generateDeclaration(declaration.get());
 
             m_variables.endScope();
+
+            if(m_optimization)
+            {
+                PeepholeOptimizerAMD64 peephole(m_emitter);
+                peephole.run();
+                m_peepholeStatistics = peephole.getStatistics();
+            }
+
             return std::pair<std::string, bool>{m_emitter.get(), m_hasMain};
         }
 
+        /// @brief Get what each peephole rule did during the last optimized generation of the program.
+        [[nodiscard]] inline const PeepholeOptimizerAMD64::Statistics& getPeepholeStatistics() const { return m_peepholeStatistics; }
+
         void generateDeclaration(const BoundDeclaration* declaration)
         {
-            if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(declaration))
-                generateFunctionDeclaration(function);
-
-            else if(auto variable = dynamic_cast<const BoundVariableDeclaration*>(declaration))
-                generateVariableDeclaration(variable);
-
-            else if(auto external_function = dynamic_cast<const BoundExternalDeclaration*>(declaration))
-                m_emitter.external(external_function->getName());
-
-            else throw LINC_EXCEPTION("Declaration type not yet implemented.");
+            switch(declaration->getKind())
+            {
+            case BoundNode::Kind::FunctionDeclaration:
+                generateFunctionDeclaration(static_cast<const BoundFunctionDeclaration*>(declaration));
+                break;
+            case BoundNode::Kind::VariableDeclaration:
+                generateVariableDeclaration(static_cast<const BoundVariableDeclaration*>(declaration));
+                break;
+            case BoundNode::Kind::ExternalDeclaration:
+                m_emitter.external(static_cast<const BoundExternalDeclaration*>(declaration)->getName());
+                break;
+            default: throw LINC_EXCEPTION("Declaration type not yet implemented.");
+            }
         }
 
         void generateStatement(const BoundStatement* statement)
         {
-            if(auto expression_statement = dynamic_cast<const BoundExpressionStatement*>(statement))
+            expireLocals(m_allocator.getPosition(statement));
+
+            switch(statement->getKind())
             {
-                generateExpression(expression_statement->getExpression());
-                m_emitter.pop(Registers::getReturn());
+            case BoundNode::Kind::ExpressionStatement:
+                m_discardedExpression = static_cast<const BoundExpressionStatement*>(statement)->getExpression();
+                release(generateExpression(m_discardedExpression));
+                break;
+            case BoundNode::Kind::DeclarationStatement:
+                generateDeclaration(static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration());
+                break;
+            case BoundNode::Kind::ReturnStatement:
+                generateReturnStatement(static_cast<const BoundReturnStatement*>(statement));
+                break;
+            default: throw LINC_EXCEPTION("Statement type not yet implemented.");
             }
-
-            else if(auto declaration_statement = dynamic_cast<const BoundDeclarationStatement*>(statement))
-                generateDeclaration(declaration_statement->getDeclaration());
-
-            else if(auto return_statement = dynamic_cast<const BoundReturnStatement*>(statement))
-                generateReturnStatement(return_statement);
-
-            else throw LINC_EXCEPTION("Statement type not yet implemented.");
         }
 
-        void generateBlockExpression(const BoundBlockExpression* expression)
+        Operand generateBlockExpression(const BoundBlockExpression* expression)
         {
             auto stack_position = m_emitter.getStackPosition();
             m_variables.beginScope();
@@ -74,181 +129,195 @@ namespace linc
             for(const auto& item: expression->getStatements())
                 generateStatement(item.get());
 
-            if(auto tail = expression->getTail())
-            {
-                generateExpression(tail);
-                m_emitter.pop(Registers::getReturn());
-            }
-            
-            auto offset = m_emitter.getStackPosition() - stack_position;
-            if(offset)
-            {
-                auto bytes = static_cast<Types::i64>(8ul * offset);
-                m_emitter.binary(bytes > 0l? Emitter::BinaryInstruction::Add: Emitter::BinaryInstruction::Subtract, Registers::getStack(), std::to_string(std::abs(bytes)));
-            }
-            
-            m_emitter.push(Registers::getReturn());
-            m_variables.endScope();
+            auto result = expression->getTail()? own(generateExpression(expression->getTail())): Registers::allocate();
+
+            endScope();
+            m_emitter.discard(m_emitter.getStackPosition() - stack_position);
+            return Operand{result};
         }
 
-        void generateExpression(const BoundExpression* expression)
+        Operand generateExpression(const BoundExpression* expression)
         {
-            if(auto literal = dynamic_cast<const BoundLiteralExpression*>(expression))
-                generateLiteralExpression(literal);
-            else if(auto identifier = dynamic_cast<const BoundIdentifierExpression*>(expression))
+            switch(expression->getKind())
             {
-                auto variable = m_variables.get(identifier->getValue());
-                
-                if(const auto static_identifier = std::get_if<std::string>(variable))
-                    m_emitter.push(*static_identifier);
-                else m_emitter.push(m_emitter.getStackOffset(std::get<std::size_t>(*variable)));
+            case BoundNode::Kind::LiteralExpression:
+                return generateLiteralExpression(static_cast<const BoundLiteralExpression*>(expression));
+            case BoundNode::Kind::IdentifierExpression:
+                return generateIdentifierExpression(static_cast<const BoundIdentifierExpression*>(expression));
+            case BoundNode::Kind::IfExpression:
+                return generateIfExpression(static_cast<const BoundIfExpression*>(expression));
+            case BoundNode::Kind::WhileExpression:
+                return generateWhileExpression(static_cast<const BoundWhileExpression*>(expression));
+            case BoundNode::Kind::UnaryExpression:
+                return generateUnaryExpression(static_cast<const BoundUnaryExpression*>(expression));
+            case BoundNode::Kind::BinaryExpression:
+                return generateBinaryExpression(static_cast<const BoundBinaryExpression*>(expression));
+            case BoundNode::Kind::BlockExpression:
+                return generateBlockExpression(static_cast<const BoundBlockExpression*>(expression));
+            case BoundNode::Kind::ExternalCallExpression:
+                return generateExternalCallExpression(static_cast<const BoundExternalCallExpression*>(expression));
+            case BoundNode::Kind::FunctionCallExpression:
+                return generateFunctionCallExpression(static_cast<const BoundFunctionCallExpression*>(expression));
+            case BoundNode::Kind::ConversionExpression:
+                return generateConversionExpression(static_cast<const BoundConversionExpression*>(expression));
+            case BoundNode::Kind::TypeExpression:
+                return generateTypeExpression(static_cast<const BoundTypeExpression*>(expression));
+            case BoundNode::Kind::IndexExpression:
+                return generateIndexExpression(static_cast<const BoundIndexExpression*>(expression));
+            default: throw LINC_EXCEPTION_ILLEGAL_STATE(expression);
             }
-            else if(auto if_expression = dynamic_cast<const BoundIfExpression*>(expression))
-                generateIfExpression(if_expression);
-
-            else if(auto while_expression = dynamic_cast<const BoundWhileExpression*>(expression))
-                generateWhileExpression(while_expression);
-
-            else if(auto unary_expression = dynamic_cast<const BoundUnaryExpression*>(expression))
-                generateUnaryExpression(unary_expression);
-
-            else if(auto binary_expression = dynamic_cast<const BoundBinaryExpression*>(expression))
-                generateBinaryExpression(binary_expression);
-
-            else if(auto block_expression = dynamic_cast<const BoundBlockExpression*>(expression))
-                generateBlockExpression(block_expression);
+        }
 
-            else if(auto external_call = dynamic_cast<const BoundExternalCallExpression*>(expression))
-                generateExternalCallExpression(external_call);
+        Operand generateIdentifierExpression(const BoundIdentifierExpression* expression)
+        {
+            auto variable = m_variables.get(expression->getValue());
 
-            else if(auto function_call = dynamic_cast<const BoundFunctionCallExpression*>(expression))
-                generateFunctionCallExpression(function_call);
+            auto is_shared = expression->getType().primitive == Types::Kind::string && !m_borrowedExpressions.contains(expression);
 
-            else if(auto conversion = dynamic_cast<const BoundConversionExpression*>(expression))
-                generateConversionExpression(conversion);
+            if(auto local = std::get_if<Register>(variable))
+            {
+                if(is_shared)
+                    shareString(local->index);
+                return Operand{local->index, false};
+            }
 
-            else if(auto type_expression = dynamic_cast<const BoundTypeExpression*>(expression))
-                generateTypeExpression(type_expression);
+            auto result = Registers::allocate();
 
-            else if(auto index_expression = dynamic_cast<const BoundIndexExpression*>(expression))
-                generateIndexExpression(index_expression);
+            if(auto stack_position = std::get_if<std::size_t>(variable))
+            {
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), m_emitter.getStackOffset(*stack_position));
+                if(is_shared)
+                    shareString(result);
+            }
+            else if(expression->getType().primitive == Types::Kind::string)
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), std::get<std::string>(*variable));
+            else
+            {
+                auto size = getRegisterOperandSize(expression->getType().primitive);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result, size),
+                    m_emitter.unaryAddress(std::get<std::string>(*variable), size));
+            }
 
-            else throw LINC_EXCEPTION_ILLEGAL_STATE(expression);
+            return Operand{result};
         }
 
         void generateReturnStatement(const BoundReturnStatement* statement)
         {
+            auto value = generateExpression(statement->getExpression());
+
             if(m_isMain)
             {
                 m_emitter.external(s_systemExit);
-                generateExpression(statement->getExpression());
 
                 if(statement->getExpression()->getType().primitive == Types::Kind::_void)
                     m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), std::to_string(0));
-                else m_emitter.pop(Registers::getArgumentName(0));
+                else m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), Registers::getName(value.index));
 
                 m_emitter.unary(Emitter::UnaryInstruction::Call, s_systemExit);
+                release(value);
                 return;
             }
-            generateExpression(statement->getExpression());
-            m_emitter.pop(Registers::getReturn());
+
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getReturn(), Registers::getName(value.index));
             m_emitter.nullary(Emitter::NullaryInstruction::Leave);
             m_emitter.nullary(Emitter::NullaryInstruction::Return);
+            release(value);
         }
 
-        void generateIndexExpression(const BoundIndexExpression* expression)
+        Operand generateIndexExpression(const BoundIndexExpression* expression)
         {
             if(expression->getType().kind != Types::type::Kind::Primitive)
                 throw LINC_EXCEPTION("Indexing non-primitive expression not implemented");
 
-            generateExpression(expression->getArray());
-            generateExpression(expression->getIndex());
-            m_emitter.pop(Registers::getPrimary());
-            m_emitter.pop(Registers::getSecondary());
-            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::Byte),
-                m_emitter.binaryAddress(Registers::getPrimary(), Registers::getSecondary(), Registers::Size::Byte));
-            m_emitter.push(Registers::getPrimary());
+            borrow({expression->getArray()});
+            auto [array, index] = generateOperands(expression->getArray(), expression->getIndex());
+            m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getName(array),
+                m_emitter.binaryAddress(Registers::getName(array), Registers::getName(index.index), Registers::Size::Byte));
+            release(index);
+            return Operand{array};
         }
 
-        void generateTypeExpression(const BoundTypeExpression* expression)
+        Operand generateTypeExpression(const BoundTypeExpression* expression)
         {
             auto actual_type = expression->getActualType();
             auto literal = m_emitter.defineStringLiteral(actual_type.toString());
-            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), literal);
-            m_emitter.push(Registers::getPrimary());
+            auto result = Registers::allocate();
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), literal);
+            return Operand{result};
         }
 
-        void generateConversionExpression(const BoundConversionExpression* expression)
+        Operand generateConversionExpression(const BoundConversionExpression* expression)
         {
             auto initial_type = expression->getConversion()->getInitialType().primitive;
             auto return_type = expression->getConversion()->getReturnType().primitive;
-            auto operand_size = getRegisterOperandSize(expression->getConversion()->getReturnType().primitive);
+            auto operand_size = getRegisterOperandSize(return_type);
+            auto result = own(generateExpression(expression->getExpression()));
+            const auto& name = Registers::getName(result);
+
+            // SSE conversions only operate on 32 and 64-bit general purpose registers
+            auto integral_size = operand_size == Registers::Size::QuadWord? Registers::Size::QuadWord: Registers::Size::DoubleWord;
 
-            generateExpression(expression->getExpression());
-            m_emitter.pop(Registers::getPrimary());
+            if(Types::isIntegral(initial_type) || initial_type == Types::Kind::_char || initial_type == Types::Kind::_bool)
+                extend(result, getRegisterOperandSize(initial_type), Types::isSigned(initial_type));
 
             if(initial_type == Types::Kind::f32 && Types::isIntegral(return_type))
             {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(Registers::Size::DoubleWord),
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getName(result, Registers::Size::DoubleWord),
                     Emitter::InstructionKind::Float);
-                m_emitter.binary(Emitter::BinaryInstruction::ConvertFloatToInt, Registers::getPrimary(operand_size), Registers::getPrimaryFloating());
+                m_emitter.binary(Emitter::BinaryInstruction::ConvertFloatToInt, Registers::getName(result, integral_size), Registers::getPrimaryFloating());
             }
             else if(initial_type == Types::Kind::f64 && Types::isIntegral(return_type))
             {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(), Emitter::InstructionKind::Double);
-                m_emitter.binary(Emitter::BinaryInstruction::ConvertDoubleToInt, Registers::getPrimary(operand_size), Registers::getPrimaryFloating());   
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), name, Emitter::InstructionKind::Double);
+                m_emitter.binary(Emitter::BinaryInstruction::ConvertDoubleToInt, Registers::getName(result, integral_size), Registers::getPrimaryFloating());
             }
             else if(Types::isIntegral(initial_type) && return_type == Types::Kind::f32)
             {
-                m_emitter.binary(Emitter::BinaryInstruction::ConvertIntToFloat, Registers::getPrimaryFloating(), Registers::getPrimary(operand_size));
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::DoubleWord), Registers::getPrimaryFloating(),
+                m_emitter.binary(Emitter::BinaryInstruction::ConvertIntToFloat, Registers::getPrimaryFloating(), name);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result, Registers::Size::DoubleWord), Registers::getPrimaryFloating(),
                     Emitter::InstructionKind::Float);
             }
             else if(Types::isIntegral(initial_type) && return_type == Types::Kind::f64)
             {
-                m_emitter.binary(Emitter::BinaryInstruction::ConvertIntToDouble, Registers::getPrimaryFloating(), Registers::getPrimary(operand_size));
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::QuadWord), Registers::getPrimaryFloating(),
-                    Emitter::InstructionKind::Double);
+                m_emitter.binary(Emitter::BinaryInstruction::ConvertIntToDouble, Registers::getPrimaryFloating(), name);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, name, Registers::getPrimaryFloating(), Emitter::InstructionKind::Double);
             }
             else if(initial_type == Types::Kind::f32 && return_type == Types::Kind::f64)
             {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(Registers::Size::DoubleWord),
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getName(result, Registers::Size::DoubleWord),
                     Emitter::InstructionKind::Float);
                 m_emitter.binary(Emitter::BinaryInstruction::ConvertFloatToDouble, Registers::getPrimaryFloating(), Registers::getPrimaryFloating());
+                m_emitter.binary(Emitter::BinaryInstruction::Move, name, Registers::getPrimaryFloating(), Emitter::InstructionKind::Double);
             }
             else if(initial_type == Types::Kind::f64 && return_type == Types::Kind::f32)
             {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(Registers::Size::QuadWord),
-                    Emitter::InstructionKind::Double);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), name, Emitter::InstructionKind::Double);
                 m_emitter.binary(Emitter::BinaryInstruction::ConvertDoubleToFloat, Registers::getPrimaryFloating(), Registers::getPrimaryFloating());
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result, Registers::Size::DoubleWord), Registers::getPrimaryFloating(),
+                    Emitter::InstructionKind::Float);
             }
 
-            m_emitter.push(Registers::getPrimary());
+            return Operand{result};
         }
 
-        void generateFunctionCallExpression(const BoundFunctionCallExpression* expression)
+        Operand generateFunctionCallExpression(const BoundFunctionCallExpression* expression)
         {
-            const auto& name = expression->getName();
+            std::vector<const BoundExpression*> arguments;
+            for(const auto& argument: expression->getArguments())
+                arguments.push_back(argument.value.get());
 
-            for(std::size_t i{0ul}; i < expression->getArguments().size(); ++i)
-            {
-                generateExpression(expression->getArguments()[i].value.get());
-                m_emitter.pop(Registers::getArgumentName(static_cast<std::uint8_t>(i)));
-            }
-            m_emitter.unary(Emitter::UnaryInstruction::Call, name);
-            m_emitter.push(Registers::getReturn());
+            return generateCall(expression->getName(), generateArguments(arguments), m_allocator.getPosition(expression));
         }
 
-        void generateExternalCallExpression(const BoundExternalCallExpression* expression)
+        Operand generateExternalCallExpression(const BoundExternalCallExpression* expression)
         {
             const auto& name = expression->getName();
-            
-            for(std::size_t i{0ul}; i < expression->getArguments().size(); ++i)
-            {
-                generateExpression(expression->getArguments()[i].get());
-                m_emitter.pop(Registers::getArgumentName(static_cast<std::uint8_t>(i)));
-            }
-            
+
+            std::vector<const BoundExpression*> arguments;
+            for(const auto& argument: expression->getArguments())
+                arguments.push_back(argument.get());
+
+            auto evaluated_arguments = generateArguments(arguments);
             auto find = m_externalDefinitions.find(name);
 
             if(find == m_externalDefinitions.end())
@@ -256,63 +325,61 @@ namespace linc
                 m_emitter.external(name);
                 m_externalDefinitions.insert(name);
             }
-            m_emitter.unary(Emitter::UnaryInstruction::Call, name);
-            m_emitter.push(Registers::getReturn());
+            return generateCall(name, std::move(evaluated_arguments), m_allocator.getPosition(expression));
         }
 
-        void generateUnaryExpression(const BoundUnaryExpression* expression)
+        Operand generateUnaryExpression(const BoundUnaryExpression* expression)
         {
             if(expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Typeof)
             {
                 auto actual_type = expression->getOperand()->getType();
                 auto literal = m_emitter.defineStringLiteral(actual_type.toString());
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), literal);
-                m_emitter.push(Registers::getPrimary());
-                return;
+                auto result = Registers::allocate();
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), literal);
+                return Operand{result};
             }
 
-            generateExpression(expression->getOperand());
-            m_emitter.pop(Registers::getReturn());
+            if(expression->getOperator()->getKind() == BoundUnaryOperator::Kind::UnaryPlus)
+                borrow({expression->getOperand()});
+
+            auto operand = generateExpression(expression->getOperand());
+            auto operand_type = expression->getOperand()->getType().primitive;
+            auto operand_size = getRegisterOperandSize(operand_type);
+            auto position = m_allocator.getPosition(expression);
+            Emitter::UnaryInstruction instruction{};
 
-            Registers::Size operand_size = getRegisterOperandSize(expression->getOperand()->getType().primitive);
-            
             switch(expression->getOperator()->getKind())
             {
             case BoundUnaryOperator::Kind::UnaryPlus:
-                if(expression->getOperand()->getType().primitive == Types::Kind::string)
+                if(operand_type == Types::Kind::string)
                 {
-                    static constexpr auto string_length_function{"__string_length"};
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), Registers::getReturn());
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, string_length_function);
-                    m_emitter.external(string_length_function);
+                    auto result = own(operand);
+                    const auto& name = Registers::getName(result);
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, name, m_emitter.unaryAddress(name, Registers::Size::QuadWord,
+                        Emitter::stringLengthOffset));
+                    return Operand{result};
                 }
-                m_emitter.push(Registers::getReturn());
-                break;
-            case BoundUnaryOperator::Kind::UnaryMinus:
-                m_emitter.unary(Emitter::UnaryInstruction::Negate, Registers::getPrimary(operand_size));
-                break;
-            case BoundUnaryOperator::Kind::Increment:
-                m_emitter.unary(Emitter::UnaryInstruction::Increment, Registers::getPrimary(operand_size));
-                break;
-            case BoundUnaryOperator::Kind::Decrement:
-                m_emitter.unary(Emitter::UnaryInstruction::Decrement, Registers::getPrimary(operand_size));
-                break;
+                return operand;
+            case BoundUnaryOperator::Kind::UnaryMinus: instruction = Emitter::UnaryInstruction::Negate; break;
+            case BoundUnaryOperator::Kind::Increment: instruction = Emitter::UnaryInstruction::Increment; break;
+            case BoundUnaryOperator::Kind::Decrement: instruction = Emitter::UnaryInstruction::Decrement; break;
             case BoundUnaryOperator::Kind::BitwiseNot:
-            case BoundUnaryOperator::Kind::LogicalNot:
-                m_emitter.unary(Emitter::UnaryInstruction::Not, Registers::getPrimary(operand_size));
-                break;
+            case BoundUnaryOperator::Kind::LogicalNot: instruction = Emitter::UnaryInstruction::Not; break;
             case BoundUnaryOperator::Kind::Stringify:
             {
                 std::string to_string_symbol;
-                switch(expression->getOperand()->getType().primitive)
+                switch(operand_type)
                 {
                 case Types::Kind::type:
-                case Types::Kind::string: m_emitter.push(Registers::getPrimary()); return;
+                case Types::Kind::string: return operand;
                 case Types::Kind::_void:
                 {
-                    static const auto void_literal = m_emitter.defineStringLiteral(LINC_GENERATORAMD64_STRING_LITERAL_VOID, "__literal_void");
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), void_literal);
-                    return;
+                    // not a static, as every program must define the literal in its own data segment
+                    const auto void_literal = m_emitter.defineStringLiteral(LINC_GENERATORAMD64_STRING_LITERAL_VOID);
+                    release(operand);
+                    auto result = Registers::allocate();
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), void_literal);
+                    return Operand{result};
                 }
                 case Types::Kind::u8:
                 case Types::Kind::u16:
@@ -328,35 +395,39 @@ namespace linc
                     break;
                 case Types::Kind::_char:
                 case Types::Kind::_bool:
-                    to_string_symbol = Logger::format("__$_to_string", Types::kindToString(expression->getOperand()->getType().primitive));
+                    to_string_symbol = Logger::format("__$_to_string", Types::kindToString(operand_type));
                     break;
                 default:
                     throw LINC_EXCEPTION("Unimplemented type for to-string convertion");
                 }
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), Registers::getPrimary());
-                m_emitter.unary(Emitter::UnaryInstruction::Call, to_string_symbol);
-                m_emitter.external(to_string_symbol);
-                break;
+
+                auto value = own(operand);
+                extend(value, operand_size, Types::isSigned(operand_type));
+                return generateRuntimeCall(to_string_symbol, {Operand{value}}, position);
             }
             default: throw LINC_EXCEPTION("Unimplemented unary expression type");
             }
-            m_emitter.push(Registers::getPrimary());
 
-            if(expression->getOperator()->getReturnType().isMutable)
+            if(!expression->getOperator()->getReturnType().isMutable)
             {
-                auto name = dynamic_cast<const BoundIdentifierExpression*>(expression->getOperand())->getValue();
-                auto variable = m_variables.get(name);
-                std::string destination;
+                auto result = own(operand);
+                m_emitter.unary(instruction, Registers::getName(result, operand_size));
+                return Operand{result};
+            }
 
-                if(auto static_identifier = std::get_if<std::string>(variable))
-                    destination = *static_identifier;
-                else destination = m_emitter.getStackOffset(std::get<std::size_t>(*variable)); 
-                
-                m_emitter.binary(Emitter::BinaryInstruction::Move, destination, Registers::getPrimary());
+            // variables held in registers are updated in place
+            if(!operand.isTemporary)
+            {
+                m_emitter.unary(instruction, Registers::getName(operand.index, operand_size));
+                return operand;
             }
+
+            m_emitter.unary(instruction, Registers::getName(operand.index, operand_size));
+            store(expression->getOperand(), operand);
+            return operand;
         }
 
-        void generateWhileExpression(const BoundWhileExpression* expression)
+        Operand generateWhileExpression(const BoundWhileExpression* expression)
         {
             m_variables.beginScope();
             auto has_else = expression->hasElse();
@@ -370,9 +441,9 @@ namespace linc
             auto jump_instruction = generateConditional(expression->getTestExpression());
             m_emitter.unary(jump_instruction, exit_label);
 
-            generateExpression(expression->getWhileBody());
-            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getConditional(), std::to_string(-1));
-            m_emitter.pop(Registers::getReturn());
+            release(generateExpression(expression->getWhileBody()));
+            if(has_else || has_finally)
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getConditional(), std::to_string(-1));
 
             m_emitter.unary(Emitter::UnaryInstruction::Jump, test_label);
             m_emitter.label(exit_label);
@@ -383,18 +454,16 @@ namespace linc
                 auto label_else = m_emitter.reserveLabel();
 
                 m_emitter.unary(Emitter::UnaryInstruction::JumpIfZero, label_else);
-                generateExpression(expression->getFinallyBody());
-                m_emitter.pop(Registers::getReturn());
-                
+                release(generateExpression(expression->getFinallyBody()));
+
                 if(has_else)
                     m_emitter.unary(Emitter::UnaryInstruction::Jump, label_finally);
-                
+
                 m_emitter.label(label_else);
 
                 if(has_else)
                 {
-                    generateExpression(expression->getElseBody());
-                    m_emitter.pop(Registers::getReturn());
+                    release(generateExpression(expression->getElseBody()));
                     m_emitter.label(label_finally);
                 }
             }
@@ -403,15 +472,15 @@ namespace linc
                 auto label_exit = m_emitter.reserveLabel();
                 m_emitter.binary(Emitter::BinaryInstruction::Test, Registers::getConditional(), Registers::getConditional());
                 m_emitter.unary(Emitter::UnaryInstruction::JumpIfNotZero, label_exit);
-                generateExpression(expression->getElseBody());
-                m_emitter.pop(Registers::getReturn());
+                release(generateExpression(expression->getElseBody()));
                 m_emitter.label(label_exit);
             }
-            
-            m_variables.endScope();
+
+            endScope();
+            return Operand{Registers::allocate()};
         }
 
-        void generateIfExpression(const BoundIfExpression* expression)
+        Operand generateIfExpression(const BoundIfExpression* expression)
         {
             m_variables.beginScope();
             auto jump_instruction = generateConditional(expression->getTestExpression());
@@ -420,86 +489,61 @@ namespace linc
             auto label_false = m_emitter.reserveLabel();
 
             m_emitter.unary(jump_instruction, label_false);
-            generateExpression(expression->getIfBody());
-            m_emitter.pop(Registers::getReturn());
+            auto result = own(generateExpression(expression->getIfBody()));
 
             auto has_else = expression->hasElse();
 
             if(has_else)
+            {
+                // both branches leave their value in the same register, which is free again while the else branch is generated
+                Registers::free(result);
                 m_emitter.unary(Emitter::UnaryInstruction::Jump, label_true);
+            }
 
             m_emitter.label(label_false);
 
             if(has_else)
             {
-                generateExpression(expression->getElseBody());
-                m_emitter.pop(Registers::getReturn());
+                auto else_result = own(generateExpression(expression->getElseBody()));
+                if(else_result != result)
+                {
+                    Registers::free(else_result);
+                    Registers::reserve(result);
+                    move(result, else_result);
+                }
                 m_emitter.label(label_true);
             }
-            m_variables.endScope();
+            endScope();
+            return Operand{result};
         }
 
-        void generateLiteralExpression(const BoundLiteralExpression* expression)
+        Operand generateLiteralExpression(const BoundLiteralExpression* expression)
         {
+            auto result = Registers::allocate();
+            std::string value;
+
             switch(expression->getType().primitive)
             {
-            case Types::Kind::string:
-            {
-                auto value = m_emitter.defineStringLiteral(expression->getValue().getString());
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getReturn(), value);
-                m_emitter.push(Registers::getReturn());
-                break;
-            }
+            case Types::Kind::string: value = m_emitter.defineStringLiteral(expression->getValue().getString()); break;
             case Types::Kind::i64:
-            case Types::Kind::u64:
-                if((expression->getValue().getU64() & 0xf000000000000000) == 0)
-                    m_emitter.push(std::to_string(expression->getValue().getU64()));
-                else
-                {
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::QuadWord), std::to_string(expression->getValue().getI64()));
-                    m_emitter.push(Registers::getPrimary());
-                }
-                break;
+            case Types::Kind::u64: value = std::to_string(expression->getValue().getI64()); break;
             case Types::Kind::u8:
-            case Types::Kind::i8:
-                m_emitter.push(std::to_string(expression->getValue().getU8()));
-                break;
+            case Types::Kind::i8: value = std::to_string(expression->getValue().getU8()); break;
             case Types::Kind::u16:
-            case Types::Kind::i16:
-                m_emitter.push(std::to_string(expression->getValue().getU16()));
-                break;
+            case Types::Kind::i16: value = std::to_string(expression->getValue().getU16()); break;
             case Types::Kind::i32:
-            case Types::Kind::u32:
-                if((expression->getValue().getU32() & 0xf0000000) == 0)
-                    m_emitter.push(std::to_string(expression->getValue().getU32()));
-                else
-                {
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::DoubleWord), std::to_string(expression->getValue().getI32()));
-                    m_emitter.push(Registers::getPrimary());
-                }
-                break;
-            case Types::Kind::_bool:
-                m_emitter.push(expression->getValue().getBool()? std::to_string(-1): std::to_string(0));
-                break;
-            case Types::Kind::_char:
-                m_emitter.push(std::to_string(+expression->getValue().getChar()));
-                break;
-            case Types::Kind::f32:
-            {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), std::to_string(std::bit_cast<Types::i32>(
-                    expression->getValue().getF32())));
-                m_emitter.push(Registers::getPrimary());
-                break;
-            }
-            case Types::Kind::f64:
-            {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), std::to_string(std::bit_cast<Types::i64>(
-                    expression->getValue().getF64())));
-                m_emitter.push(Registers::getPrimary());
-                break;
-            }
+            case Types::Kind::u32: value = std::to_string(expression->getValue().getU32()); break;
+            case Types::Kind::_bool: value = expression->getValue().getBool()? std::to_string(-1): std::to_string(0); break;
+            case Types::Kind::_char: value = std::to_string(+expression->getValue().getChar()); break;
+            case Types::Kind::f32: value = std::to_string(std::bit_cast<Types::u32>(expression->getValue().getF32())); break;
+            case Types::Kind::f64: value = std::to_string(std::bit_cast<Types::i64>(expression->getValue().getF64())); break;
             default: throw LINC_EXCEPTION("Literal type not yet implemented.");
             }
+
+            auto size = getRegisterOperandSize(expression->getType().primitive);
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result, size == Registers::Size::QuadWord?
+                Registers::Size::QuadWord: Registers::Size::DoubleWord), value);
+            return Operand{result};
         }
 
         void generateVariableDeclaration(const BoundVariableDeclaration* declaration)
@@ -507,10 +551,10 @@ namespace linc
             const auto& default_value = declaration->getDefaultValue();
             const auto& name = declaration->getName();
 
-            if(m_variables.getScopeSize() == 1ul)
+            if(!m_function)
             {
                 auto size = getRegisterOperandSize(declaration->getActualType().primitive);
-                if(auto literal = dynamic_cast<const BoundLiteralExpression*>(*default_value); literal && default_value)
+                if(default_value && default_value.value()->getKind() == BoundNode::Kind::LiteralExpression)
                 {
                     auto value = static_cast<const BoundLiteralExpression*>(*default_value)->getValue();
                     std::string label_name;
@@ -529,305 +573,295 @@ namespace linc
                 return;
             }
 
+            Operand value{};
             if(default_value)
-                generateExpression(*default_value);
-            else m_emitter.push(std::to_string(0));
+                value = generateExpression(*default_value);
+            else if(declaration->getActualType().kind == Types::type::Kind::Primitive && declaration->getActualType().primitive == Types::Kind::string)
+            {
+                value.index = Registers::allocate();
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(value.index), m_emitter.defineStringLiteral({}));
+            }
+            else
+            {
+                value.index = Registers::allocate();
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(value.index), std::to_string(0));
+            }
 
-            m_variables.append(name, m_emitter.getStackPosition());
+            declareLocal(name, value);
         }
 
         void generateFunctionDeclaration(const BoundFunctionDeclaration* declaration)
         {
+            if(auto find = m_functions.find(declaration); find != m_functions.end())
+            {
+                InstructionSelectorAMD64 selector(m_emitter, m_module, [this](const std::string& name)
+                {
+                    return std::get<std::string>(*m_variables.get(name));
+                });
+
+                selector.select(m_module.functions[find->second]);
+                m_hasMain = m_hasMain || declaration->getName() == "main";
+                return;
+            }
+
             m_variables.beginScope();
+            m_function = declaration;
+            m_allocator.allocate(declaration);
+            m_interval = 0ul;
+
             if(declaration->getName() == "main")
             {
                 const static auto entry_point = "_start";
+                m_interval = declaration->getArguments().size();
                 m_emitter.global(entry_point);
                 m_emitter.label(entry_point);
 
                 m_isMain = true;
-                generateExpression(declaration->getBody());
-                m_emitter.pop(Registers::getArgumentName(0));
+                auto result = generateExpression(declaration->getBody());
                 m_isMain = false;
 
                 if(declaration->getReturnType().primitive == Types::Kind::_void)
                     m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), std::to_string(0));
-                    
+                else m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), Registers::getName(result.index));
+                release(result);
+
                 m_emitter.unary(Emitter::UnaryInstruction::Call, s_systemExit);
                 m_emitter.external(s_systemExit);
                 m_hasMain = true;
-                m_variables.endScope();
+                endFunction();
                 return;
             }
 
             m_emitter.global(declaration->getName());
             m_emitter.label(declaration->getName());
             m_emitter.prologue();
-            
+
             for(std::size_t i{0ul}; i < declaration->getArguments().size(); ++i)
             {
-                m_emitter.push(Registers::getArgumentName(i));
-                m_variables.append(declaration->getArguments()[i]->getName(), m_emitter.getStackPosition());
+                const auto& interval = m_allocator.getInterval(m_interval++);
+                const auto& name = declaration->getArguments()[i]->getName();
+
+                if(interval.location)
+                {
+                    Registers::reserve(*interval.location);
+                    m_locals.emplace_back(*interval.location, interval.end);
+                    m_variables.update(name, Register{*interval.location});
+                }
+                else
+                {
+                    m_emitter.push(Registers::getArgumentName(i));
+                    m_variables.update(name, m_emitter.getStackPosition());
+                }
             }
 
-            generateExpression(declaration->getBody());
-            m_emitter.pop(Registers::getReturn());
+            auto result = generateExpression(declaration->getBody());
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getReturn(), Registers::getName(result.index));
+            release(result);
             m_emitter.epilogue();
-            m_variables.endScope();
+            endFunction();
         }
 
-        void generateBinaryExpression(const BoundBinaryExpression* expression)
+        Operand generateBinaryExpression(const BoundBinaryExpression* expression)
         {
-            generateExpression(expression->getLeft());
-            generateExpression(expression->getRight());
+            auto operator_kind = expression->getOperator()->getKind();
+            auto position = m_allocator.getPosition(expression);
 
-            if(expression->getOperator()->getReturnType().primitive == Types::Kind::string && expression->getOperator()->getKind() == BoundBinaryOperator::Kind::Addition)
+            if(operator_kind == BoundBinaryOperator::Kind::Assignment)
+            {
+                auto value = generateExpression(expression->getRight());
+                return store(expression->getLeft(), value);
+            }
+
+            auto left_type = expression->getLeft()->getType().primitive;
+            auto is_primitive = expression->getOperator()->getReturnType().kind == Types::type::Kind::Primitive;
+            auto is_mutable = expression->getOperator()->getReturnType().isMutable;
+            Registers::Size operand_size = getRegisterOperandSize(left_type);
+
+            if(is_primitive && left_type == Types::Kind::string && operator_kind == BoundBinaryOperator::Kind::AdditionAssignment)
+            {
+                // the variable appended to keeps its string to itself, so that the string may grow in place
+                auto right_is_char = expression->getOperator()->getRightType().primitive == Types::Kind::_char;
+                borrow({expression->getLeft(), expression->getRight()});
+                auto [left, right] = generateOperands(expression->getLeft(), expression->getRight());
+
+                auto result = store(expression->getLeft(),
+                    generateRuntimeCall(right_is_char? "__string_char_append": "__string_append", {Operand{left}, right}, position));
+
+                if(expression != m_discardedExpression)
+                    shareString(result.index);
+                return result;
+            }
+            else if(is_primitive && expression->getOperator()->getReturnType().primitive == Types::Kind::string && operator_kind == BoundBinaryOperator::Kind::Addition)
             {
                 auto left_is_char = expression->getOperator()->getLeftType().primitive == Types::Kind::_char;
                 auto right_is_char = expression->getOperator()->getRightType().primitive == Types::Kind::_char;
-                
-                m_emitter.pop(Registers::getArgumentName(1));
-                m_emitter.pop(Registers::getArgumentName(0));
+                borrow({expression->getLeft(), expression->getRight()});
+                auto [left, right] = generateOperands(expression->getLeft(), expression->getRight());
 
-                if(left_is_char && right_is_char)
-                {
-                    static constexpr auto char_concat_function{"__char_concat"}; 
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, char_concat_function);
-                    m_emitter.external(char_concat_function);
-                }
-                else if(left_is_char)
-                {
-                    static constexpr auto char_string_concat_function{"__char_string_concat"};
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, char_string_concat_function);
-                    m_emitter.external(char_string_concat_function);
-                }
-                else if(expression->getOperator()->getRightType().primitive == Types::Kind::_char)
-                {
-                    static constexpr auto string_char_concat_function{"__string_char_concat"};
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, string_char_concat_function);
-                    m_emitter.external(string_char_concat_function);
-                }
-                else
-                {
-                    static constexpr auto string_concat_function{"__string_concat"};
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, string_concat_function);
-                    m_emitter.external(string_concat_function);
-                }
-                m_emitter.push(Registers::getReturn());
-                return;
+                const char* function_name = left_is_char && right_is_char? "__char_concat":
+                    left_is_char? "__char_string_concat":
+                    right_is_char? "__string_char_concat": "__string_concat";
+
+                return generateRuntimeCall(function_name, {Operand{left}, right}, position);
             }
-            else
+            else if(operator_kind == BoundBinaryOperator::Kind::Equals && left_type == Types::Kind::string)
             {
-                m_emitter.pop(Registers::getSecondary());
-                m_emitter.pop(Registers::getPrimary());
+                borrow({expression->getLeft(), expression->getRight()});
+                auto [left, right] = generateOperands(expression->getLeft(), expression->getRight());
+                return generateRuntimeCall("__string_equals", {Operand{left}, right}, position);
             }
 
-            std::string instruction;
-            auto is_primitive = expression->getOperator()->getReturnType().kind == Types::type::Kind::Primitive;
             Emitter::InstructionKind kind{Emitter::InstructionKind::General};
 
-            if(is_primitive && expression->getLeft()->getType().primitive == Types::Kind::f32)
-            {
+            if(is_primitive && left_type == Types::Kind::f32)
                 kind = Emitter::InstructionKind::Float;
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(Registers::Size::DoubleWord), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getSecondaryFloating(), Registers::getSecondary(Registers::Size::DoubleWord), kind);
-            }
-            else if(is_primitive && expression->getLeft()->getType().primitive == Types::Kind::f64)
-            {
+            else if(is_primitive && left_type == Types::Kind::f64)
                 kind = Emitter::InstructionKind::Double;
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getPrimary(Registers::Size::QuadWord), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getSecondaryFloating(), Registers::getSecondary(Registers::Size::QuadWord), kind);
+
+            // compound assignments to variables held in registers are applied in place
+            if(is_mutable && kind == Emitter::InstructionKind::General)
+                if(auto instruction = getInPlaceInstruction(operator_kind))
+                    if(auto local = getRegisterVariable(expression->getLeft()))
+                    {
+                        auto value = generateExpression(expression->getRight());
+                        m_emitter.binary(*instruction, Registers::getName(*local, operand_size), Registers::getName(value.index, operand_size));
+                        release(value);
+                        return Operand{*local, false};
+                    }
+
+            auto [left, right] = generateOperands(expression->getLeft(), expression->getRight());
+            const auto& right_name = Registers::getName(right.index, operand_size);
+            bool is_sse = kind != Emitter::InstructionKind::General, is_signed = Types::isSigned(left_type);
+
+            if(is_sse)
+            {
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimaryFloating(), Registers::getName(left, operand_size), kind);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getSecondaryFloating(), right_name, kind);
             }
-            bool is_sse = kind != Emitter::InstructionKind::General, is_signed = Types::isSigned(expression->getLeft()->getType().primitive);
 
-            Registers::Size operand_size = getRegisterOperandSize(expression->getLeft()->getType().primitive);
-            
-            switch(expression->getOperator()->getKind())
+            auto generate_comparison = [&](Emitter::UnaryInstruction set_instruction)
+            {
+                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
+                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getName(left, operand_size), right_name);
+                m_emitter.unary(set_instruction, Registers::getName(left, Registers::Size::Byte), kind);
+                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getName(left), Registers::getName(left, Registers::Size::Byte));
+            };
+
+            auto generate_arithmetic = [&](Emitter::BinaryInstruction instruction)
             {
-            case BoundBinaryOperator::Kind::Addition:
-            case BoundBinaryOperator::Kind::AdditionAssignment:
                 if(is_sse)
                 {
-                    m_emitter.binary(Emitter::BinaryInstruction::Add, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(operand_size), Registers::getPrimaryFloating(), kind);
+                    m_emitter.binary(instruction, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(left, operand_size), Registers::getPrimaryFloating(), kind);
                 }
-                else m_emitter.binary(Emitter::BinaryInstruction::Add, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind);
+                else m_emitter.binary(instruction, Registers::getName(left, operand_size), right_name);
+            };
 
-                m_emitter.push(Registers::getPrimary());
+            switch(operator_kind)
+            {
+            case BoundBinaryOperator::Kind::Addition:
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+                generate_arithmetic(Emitter::BinaryInstruction::Add);
                 break;
             case BoundBinaryOperator::Kind::Subtraction:
             case BoundBinaryOperator::Kind::SubtractionAssignment:
-                if(is_sse)
-                {
-                    m_emitter.binary(Emitter::BinaryInstruction::Subtract, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(operand_size), Registers::getPrimaryFloating(), kind);
-                }
-                else m_emitter.binary(Emitter::BinaryInstruction::Subtract, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind);
-
-                m_emitter.push(Registers::getPrimary());
+                generate_arithmetic(Emitter::BinaryInstruction::Subtract);
                 break;
             case BoundBinaryOperator::Kind::Multiplication:
             case BoundBinaryOperator::Kind::MultiplicationAssignment:
                 if(is_sse)
                 {
-                    m_emitter.binary(Emitter::BinaryInstruction::Multiply, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(operand_size), Registers::getPrimaryFloating(), kind);
+                    generate_arithmetic(Emitter::BinaryInstruction::Multiply);
+                    break;
                 }
-                else if(is_signed) m_emitter.unary(Emitter::UnaryInstruction::SignedMultiply, Registers::getSecondary(operand_size), kind);
-                else m_emitter.unary(Emitter::UnaryInstruction::UnsignedMultiply, Registers::getSecondary(operand_size), kind);
 
-                m_emitter.push(Registers::getPrimary());
-                break;
+                // the lower bits of the product do not depend on signedness, and there is no two-operand form for bytes
+                if(operand_size == Registers::Size::QuadWord)
+                    m_emitter.binary(Emitter::BinaryInstruction::Multiply, Registers::getName(left), Registers::getName(right.index));
+                else m_emitter.binary(Emitter::BinaryInstruction::Multiply, Registers::getName(left, Registers::Size::DoubleWord),
+                    Registers::getName(right.index, Registers::Size::DoubleWord));
                 break;
             case BoundBinaryOperator::Kind::Division:
             case BoundBinaryOperator::Kind::DivisionAssignment:
-                if(is_sse)
-                {
-                    m_emitter.binary(Emitter::BinaryInstruction::Divide, Registers::getPrimaryFloating(), Registers::getSecondaryFloating(), kind);
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(operand_size), Registers::getPrimaryFloating(), kind);
-                }
-                else if(is_signed)
-                {
-                    m_emitter.nullary(operand_size == Registers::Size::DoubleWord? Emitter::NullaryInstruction::ConvertDoubleQuad:
-                        Emitter::NullaryInstruction::ConvertQuadOctal);
-                    m_emitter.unary(Emitter::UnaryInstruction::SignedDivide, Registers::getSecondary(operand_size), kind);
-                }
-                else
-                {
-                    m_emitter.binary(Emitter::BinaryInstruction::Xor, Registers::getRemainder(operand_size), Registers::getRemainder(operand_size), kind);
-                    m_emitter.unary(Emitter::UnaryInstruction::UnsignedDivide, Registers::getSecondary(operand_size), kind);
-                }
-                m_emitter.push(Registers::getPrimary());
+                if(is_sse) generate_arithmetic(Emitter::BinaryInstruction::Divide);
+                else generateDivision(left, right.index, operand_size, is_signed, false);
                 break;
             case BoundBinaryOperator::Kind::Modulo:
             case BoundBinaryOperator::Kind::ModuloAssignment:
                 switch(kind)
                 {
                 case Emitter::InstructionKind::General:
-                    m_emitter.binary(Emitter::BinaryInstruction::Xor, Registers::getRemainder(operand_size), Registers::getRemainder(operand_size), kind);
-                    m_emitter.unary(Emitter::UnaryInstruction::UnsignedDivide, Registers::getSecondary(operand_size), kind);
-                    m_emitter.push(Registers::getRemainder());
+                    generateDivision(left, right.index, operand_size, is_signed, true);
                     break;
                 case Emitter::InstructionKind::Float:
-                {
-                    static constexpr auto function_name{"__mod_f32"};
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, function_name);
-                    m_emitter.push(Registers::getReturn());
-                    m_emitter.external(function_name);
-                    break;
-                }
                 case Emitter::InstructionKind::Double:
                 {
-                    static constexpr auto function_name{"__mod_f64"};
+                    // the runtime modulo only uses SSE registers, so there is nothing to preserve across the call
+                    const auto function_name = kind == Emitter::InstructionKind::Float? "__mod_f32": "__mod_f64";
                     m_emitter.unary(Emitter::UnaryInstruction::Call, function_name);
-                    m_emitter.push(Registers::getReturn());
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(left, operand_size), Registers::getPrimaryFloating(), kind);
                     m_emitter.external(function_name);
                     break;
                 }
                 default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
                 }
-                
                 break;
             case BoundBinaryOperator::Kind::NotEquals:
             case BoundBinaryOperator::Kind::BitwiseXor:
-                m_emitter.binary(Emitter::BinaryInstruction::Xor, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind);
-                m_emitter.push(Registers::getPrimary());
+                m_emitter.binary(Emitter::BinaryInstruction::Xor, Registers::getName(left, operand_size), right_name);
                 break;
             case BoundBinaryOperator::Kind::Less:
-                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getPrimaryFloating(), kind);
-                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind); 
-                m_emitter.unary(Emitter::UnaryInstruction::SetIfLess, Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(), Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generate_comparison(Emitter::UnaryInstruction::SetIfLess);
                 break;
             case BoundBinaryOperator::Kind::Greater:
-                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getPrimaryFloating(), kind);
-                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind); 
-                m_emitter.unary(Emitter::UnaryInstruction::SetIfGreater, Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(), Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generate_comparison(Emitter::UnaryInstruction::SetIfGreater);
                 break;
             case BoundBinaryOperator::Kind::LessEqual:
-                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getPrimaryFloating(), kind);
-                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind); 
-                m_emitter.unary(Emitter::UnaryInstruction::SetIfLessEqual, Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(), Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generate_comparison(Emitter::UnaryInstruction::SetIfLessEqual);
                 break;
             case BoundBinaryOperator::Kind::GreaterEqual:
-                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getPrimaryFloating(), kind);
-                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind); 
-                m_emitter.unary(Emitter::UnaryInstruction::SetIfGreaterEqual, Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(), Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generate_comparison(Emitter::UnaryInstruction::SetIfGreaterEqual);
                 break;
             case BoundBinaryOperator::Kind::Equals:
-                if(expression->getLeft()->getType().primitive == Types::Kind::string)
-                {
-                    static constexpr auto string_equals_function{"__string_equals"};
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(0), Registers::getPrimary());
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getArgumentName(1), Registers::getSecondary());
-                    m_emitter.unary(Emitter::UnaryInstruction::Call, string_equals_function);
-                    m_emitter.external(string_equals_function);
-                    m_emitter.push(Registers::getReturn());
-                    break;
-                }
-                if(is_sse) m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimaryFloating(), Registers::getPrimaryFloating(), kind);
-                else m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(operand_size), Registers::getSecondary(operand_size), kind); 
-                m_emitter.unary(Emitter::UnaryInstruction::SetIfEqual, Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(), Registers::getPrimary(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generate_comparison(Emitter::UnaryInstruction::SetIfEqual);
                 break;
-            case BoundBinaryOperator::Kind::Assignment:
-            {
-                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), Registers::getSecondary(), kind);
-                m_emitter.push(Registers::getPrimary());
-            }
             case BoundBinaryOperator::Kind::LogicalAnd:
             case BoundBinaryOperator::Kind::BitwiseAnd:
-                m_emitter.binary(Emitter::BinaryInstruction::And, Registers::getPrimary(), Registers::getSecondary(), kind);
-                m_emitter.push(Registers::getPrimary());
+                m_emitter.binary(Emitter::BinaryInstruction::And, Registers::getName(left, operand_size), right_name);
                 break;
             case BoundBinaryOperator::Kind::LogicalOr:
             case BoundBinaryOperator::Kind::BitwiseOr:
-                m_emitter.binary(Emitter::BinaryInstruction::Or, Registers::getPrimary(), Registers::getSecondary(), kind);
-                m_emitter.push(Registers::getPrimary());
+                m_emitter.binary(Emitter::BinaryInstruction::Or, Registers::getName(left, operand_size), right_name);
                 break;
             case BoundBinaryOperator::Kind::BitwiseShiftLeft:
-                if constexpr(Registers::getCount() != Registers::getSecondary())
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getCount(), Registers::getSecondary());
-                m_emitter.binary(Emitter::BinaryInstruction::BitShiftLeft, Registers::getPrimary(), Registers::getCount(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generateShift(left, right.index, operand_size, Emitter::BinaryInstruction::BitShiftLeft);
                 break;
             case BoundBinaryOperator::Kind::BitwiseShiftRight:
-                if constexpr(Registers::getCount() != Registers::getSecondary())
-                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getCount(), Registers::getSecondary());
-                m_emitter.binary(Emitter::BinaryInstruction::BitShiftRight, Registers::getPrimary(), Registers::getCount(Registers::Size::Byte), kind);
-                m_emitter.push(Registers::getPrimary());
+                generateShift(left, right.index, operand_size, Emitter::BinaryInstruction::BitShiftRight);
                 break;
             default: throw LINC_EXCEPTION("Unimplemented binary expresssion kind.");
             }
 
-            if(expression->getOperator()->getReturnType().isMutable)
-            {
-                auto name = dynamic_cast<const BoundIdentifierExpression*>(expression->getLeft())->getValue();
-                auto variable = m_variables.get(name);
-                std::string destination;
-                if(auto static_identifier = std::get_if<std::string>(variable))
-                    destination = *static_identifier;
-                else destination = m_emitter.getStackOffset(std::get<std::size_t>(*variable)); 
-                m_emitter.binary(Emitter::BinaryInstruction::Move, destination, Registers::getPrimary(), Emitter::InstructionKind::General);
-            }
+            release(right);
+
+            if(is_mutable)
+                store(expression->getLeft(), Operand{left, false});
+            return Operand{left};
         }
 
         Emitter::UnaryInstruction generateConditional(const BoundExpression* expression)
         {
-            if(auto binary = dynamic_cast<const BoundBinaryExpression*>(expression))
+            if(expression->getKind() == BoundNode::Kind::BinaryExpression)
             {
+                auto binary = static_cast<const BoundBinaryExpression*>(expression);
+                auto left_type = binary->getLeft()->getType().primitive;
+
+                if(Types::isFloating(left_type) || left_type == Types::Kind::string)
+                    return generateTestConditional(expression);
+
                 switch(binary->getOperator()->getKind())
                 {
                 case BoundBinaryOperator::Kind::Equals:
-                    if(binary->getLeft()->getType().primitive == Types::Kind::string) break;
                     return generateAndCompare(binary->getLeft(), binary->getRight(), Emitter::UnaryInstruction::JumpIfNotEqual);
                 case BoundBinaryOperator::Kind::NotEquals:
                     return generateAndCompare(binary->getLeft(), binary->getRight(), Emitter::UnaryInstruction::JumpIfEqual);
@@ -842,21 +876,26 @@ namespace linc
                 default: break;
                 }
             }
-            
-            generateExpression(expression);
-            m_emitter.pop(Registers::getPrimary());
-            m_emitter.test(Registers::getPrimary());
+
+            return generateTestConditional(expression);
+        }
+
+        Emitter::UnaryInstruction generateTestConditional(const BoundExpression* expression)
+        {
+            auto value = generateExpression(expression);
+            m_emitter.test(Registers::getName(value.index, getRegisterOperandSize(expression->getType().primitive)));
+            release(value);
             return Emitter::UnaryInstruction::JumpIfZero;
         }
 
         Emitter::UnaryInstruction generateAndCompare(const BoundExpression* left, const BoundExpression* right, Emitter::UnaryInstruction jump_instruction)
         {
-            generateExpression(left);
-            generateExpression(right);
+            auto size = getRegisterOperandSize(left->getType().primitive);
+            auto [left_operand, right_operand] = generateOperands(left, right);
 
-            m_emitter.pop(Registers::getSecondary());
-            m_emitter.pop(Registers::getPrimary());
-            m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getPrimary(), Registers::getSecondary());
+            m_emitter.binary(Emitter::BinaryInstruction::Compare, Registers::getName(left_operand, size), Registers::getName(right_operand.index, size));
+            Registers::free(left_operand);
+            release(right_operand);
 
             return jump_instruction;
         }
@@ -885,11 +924,404 @@ namespace linc
             }
         }
     private:
+        /// @brief Evaluate the two operands of a binary operation, the left one into a temporary. When the right operand could not
+        /// be evaluated without spilling, the left one is kept on the stack meanwhile.
+        std::pair<std::uint8_t, Operand> generateOperands(const BoundExpression* left, const BoundExpression* right)
+        {
+            auto left_index = own(generateExpression(left));
+
+            if(Registers::getAvailable() >= RegisterAllocator::getReservedCount())
+                return std::pair<std::uint8_t, Operand>(left_index, generateExpression(right));
+
+            m_emitter.push(Registers::getName(left_index));
+            Registers::free(left_index);
+
+            auto right_operand = generateExpression(right);
+            left_index = Registers::allocate();
+            m_emitter.pop(Registers::getName(left_index));
+            return std::pair<std::uint8_t, Operand>(left_index, right_operand);
+        }
+
+        std::vector<Argument> generateArguments(const std::vector<const BoundExpression*>& arguments)
+        {
+            std::vector<Argument> result;
+            result.reserve(arguments.size());
+
+            for(std::size_t i{0ul}; i < arguments.size(); ++i)
+            {
+                if(Registers::getAvailable() < RegisterAllocator::getReservedCount())
+                    for(auto& argument: result)
+                        if(auto operand = std::get_if<Operand>(&argument))
+                        {
+                            m_emitter.push(Registers::getName(operand->index));
+                            Registers::free(operand->index);
+                            argument = m_emitter.getStackPosition();
+                        }
+
+                auto operand = generateExpression(arguments[i]);
+
+                // variables may be reassigned or expire while the arguments that follow are evaluated
+                if(i + 1ul != arguments.size())
+                    operand = Operand{own(operand)};
+                result.push_back(operand);
+            }
+
+            return result;
+        }
+
+        Operand generateRuntimeCall(const std::string& name, std::vector<Argument> arguments, std::size_t position)
+        {
+            m_emitter.external(name);
+            return generateCall(name, std::move(arguments), position);
+        }
+
+        /// @brief Call a function with evaluated arguments. Registers holding temporaries and variables still live after the call are
+        /// saved on the stack around it, as every register of the pool may be overwritten by the callee.
+        Operand generateCall(const std::string& name, std::vector<Argument> arguments, std::size_t position)
+        {
+            std::vector<std::uint8_t> saved_registers;
+            std::size_t stack_arguments{0ul};
+
+            for(std::uint8_t index{0}; index < Registers::getPoolSize(); ++index)
+            {
+                if(!Registers::isAllocated(index) || std::ranges::any_of(arguments, [&](const Argument& argument)
+                {
+                    auto operand = std::get_if<Operand>(&argument);
+                    return operand && operand->isTemporary && operand->index == index;
+                })) continue;
+
+                auto local = std::ranges::find(m_locals, index, &std::pair<std::uint8_t, std::size_t>::first);
+                if(local == m_locals.end() || local->second > position)
+                    saved_registers.push_back(index);
+            }
+
+            for(auto index: saved_registers)
+                m_emitter.push(Registers::getName(index));
+
+            std::vector<std::pair<std::string, std::string>> moves;
+            for(std::size_t i{0ul}; i < arguments.size(); ++i)
+            {
+                auto destination = Registers::getArgumentName(static_cast<std::uint8_t>(i));
+                std::string source;
+
+                if(auto operand = std::get_if<Operand>(&arguments[i]))
+                    source = Registers::getName(operand->index);
+                else
+                {
+                    source = m_emitter.getStackOffset(std::get<std::size_t>(arguments[i]));
+                    ++stack_arguments;
+                }
+
+                if(source != destination)
+                    moves.emplace_back(std::move(destination), std::move(source));
+            }
+            generateParallelMove(moves);
+
+            m_emitter.unary(Emitter::UnaryInstruction::Call, name);
+
+            for(auto it = saved_registers.rbegin(); it != saved_registers.rend(); ++it)
+                m_emitter.pop(Registers::getName(*it));
+            m_emitter.discard(stack_arguments);
+
+            for(const auto& argument: arguments)
+                if(auto operand = std::get_if<Operand>(&argument))
+                    release(*operand);
+
+            auto result = Registers::allocate();
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(result), Registers::getReturn());
+            return Operand{result};
+        }
+
+        /// @brief Emit moves whose destinations are all distinct, in an order where no source is overwritten before being read.
+        /// Cycles are broken by going through the accumulator, which never holds a value across expressions.
+        void generateParallelMove(std::vector<std::pair<std::string, std::string>>& moves)
+        {
+            while(!moves.empty())
+            {
+                auto ready = std::ranges::find_if(moves, [&](const auto& move)
+                {
+                    return std::ranges::none_of(moves, [&](const auto& other){ return other.second == move.first; });
+                });
+
+                if(ready != moves.end())
+                {
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, ready->first, ready->second);
+                    moves.erase(ready);
+                    continue;
+                }
+
+                auto blocked = moves.front().first;
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), blocked);
+
+                for(auto& move: moves)
+                    if(move.second == blocked)
+                        move.second = Registers::getPrimary();
+            }
+        }
+
+        void generateDivision(std::uint8_t left, std::uint8_t right, Registers::Size size, bool is_signed, bool remainder)
+        {
+            auto instruction = is_signed? Emitter::UnaryInstruction::SignedDivide: Emitter::UnaryInstruction::UnsignedDivide;
+
+            // byte division leaves both results in ax and does not involve rdx
+            if(size == Registers::Size::Byte)
+            {
+                if(is_signed)
+                {
+                    m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(Registers::Size::Byte), Registers::getName(left, size));
+                    m_emitter.nullary(Emitter::NullaryInstruction::ConvertByteWord);
+                }
+                else m_emitter.binary(Emitter::BinaryInstruction::MoveExtend, Registers::getPrimary(Registers::Size::DoubleWord), Registers::getName(left, size));
+
+                m_emitter.unary(instruction, Registers::getName(right, size));
+                if(remainder)
+                    m_emitter.binary(Emitter::BinaryInstruction::BitShiftRight, Registers::getPrimary(Registers::Size::DoubleWord), std::to_string(8));
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(left, size), Registers::getPrimary(Registers::Size::Byte));
+                return;
+            }
+
+            const auto remainder_index = Registers::getArgument(2);
+            auto save_remainder = Registers::isAllocated(remainder_index) && left != remainder_index;
+            auto divisor = Registers::getName(right, size);
+
+            if(save_remainder)
+            {
+                m_emitter.push(Registers::getRemainder());
+                if(right == remainder_index)
+                    divisor = m_emitter.unaryAddress(Registers::getStack(), size);
+            }
+
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(size), Registers::getName(left, size));
+            if(!is_signed)
+                m_emitter.binary(Emitter::BinaryInstruction::Xor, Registers::getRemainder(Registers::Size::DoubleWord), Registers::getRemainder(Registers::Size::DoubleWord));
+            else m_emitter.nullary(size == Registers::Size::Word? Emitter::NullaryInstruction::ConvertWordDouble:
+                size == Registers::Size::DoubleWord? Emitter::NullaryInstruction::ConvertDoubleQuad: Emitter::NullaryInstruction::ConvertQuadOctal);
+
+            m_emitter.unary(instruction, divisor);
+
+            auto result = remainder? Registers::getRemainder(size): Registers::getPrimary(size);
+            if(Registers::getName(left, size) != result)
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(left, size), result);
+
+            if(save_remainder)
+                m_emitter.pop(Registers::getRemainder());
+        }
+
+        void generateShift(std::uint8_t left, std::uint8_t right, Registers::Size size, Emitter::BinaryInstruction instruction)
+        {
+            const auto count_index = Registers::getArgument(3);
+
+            if(right == count_index)
+            {
+                m_emitter.binary(instruction, Registers::getName(left, size), Registers::getCount(Registers::Size::Byte));
+                return;
+            }
+            else if(left == count_index)
+            {
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getPrimary(), Registers::getName(left));
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getCount(), Registers::getName(right));
+                m_emitter.binary(instruction, Registers::getPrimary(size), Registers::getCount(Registers::Size::Byte));
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(left), Registers::getPrimary());
+                return;
+            }
+
+            auto save_count = Registers::isAllocated(count_index);
+            if(save_count)
+                m_emitter.push(Registers::getCount());
+
+            m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getCount(), Registers::getName(right));
+            m_emitter.binary(instruction, Registers::getName(left, size), Registers::getCount(Registers::Size::Byte));
+
+            if(save_count)
+                m_emitter.pop(Registers::getCount());
+        }
+
+        /// @brief Assign a value to the variable referred to by an identifier expression.
+        /// @return The operand holding the assigned value.
+        Operand store(const BoundExpression* target, Operand value)
+        {
+            if(target->getKind() != BoundNode::Kind::IdentifierExpression)
+                throw LINC_EXCEPTION("Mutable operators are only implemented for identifier operands.");
+
+            auto identifier = static_cast<const BoundIdentifierExpression*>(target);
+            auto variable = m_variables.get(identifier->getValue());
+
+            if(auto local = std::get_if<Register>(variable))
+            {
+                move(local->index, value.index);
+                release(value);
+                return Operand{local->index, false};
+            }
+            else if(auto stack_position = std::get_if<std::size_t>(variable))
+                m_emitter.binary(Emitter::BinaryInstruction::Move, m_emitter.getStackOffset(*stack_position), Registers::getName(value.index));
+            else
+            {
+                auto size = getRegisterOperandSize(identifier->getType().primitive);
+                m_emitter.binary(Emitter::BinaryInstruction::Move, m_emitter.unaryAddress(std::get<std::string>(*variable), size),
+                    Registers::getName(value.index, size));
+            }
+            return value;
+        }
+
+        void declareLocal(const std::string& name, Operand value)
+        {
+            const auto& interval = m_allocator.getInterval(m_interval++);
+            expireLocals(interval.start);
+
+            if(interval.location)
+            {
+                auto location = *interval.location;
+                auto owns_location = value.isTemporary && value.index == location;
+                auto available = Registers::getAvailable() + (value.isTemporary? 1ul: 0ul);
+
+                // keep enough registers for temporaries when declaring a variable in the middle of an expression
+                if((owns_location || !Registers::isAllocated(location)) && available > RegisterAllocator::getReservedCount())
+                {
+                    if(!owns_location)
+                    {
+                        Registers::reserve(location);
+                        move(location, value.index);
+                        release(value);
+                    }
+
+                    m_locals.emplace_back(location, interval.end);
+                    m_variables.update(name, Register{location});
+                    return;
+                }
+            }
+
+            m_emitter.push(Registers::getName(value.index));
+            release(value);
+            m_variables.update(name, m_emitter.getStackPosition());
+        }
+
+        /// @brief Free the registers of variables that are no longer used past the given position.
+        void expireLocals(std::size_t position)
+        {
+            std::erase_if(m_locals, [&](const std::pair<std::uint8_t, std::size_t>& local)
+            {
+                if(local.second >= position)
+                    return false;
+
+                Registers::free(local.first);
+                return true;
+            });
+        }
+
+        void endScope()
+        {
+            for(const auto& [name, variable]: m_variables.top())
+                if(auto local = std::get_if<Register>(&variable))
+                {
+                    auto find = std::ranges::find(m_locals, local->index, &std::pair<std::uint8_t, std::size_t>::first);
+                    if(find != m_locals.end())
+                    {
+                        Registers::free(find->first);
+                        m_locals.erase(find);
+                    }
+                }
+            m_variables.endScope();
+        }
+
+        void endFunction()
+        {
+            endScope();
+            m_function = nullptr;
+            m_locals.clear();
+            Registers::reset();
+        }
+
+        std::optional<std::uint8_t> getRegisterVariable(const BoundExpression* expression)
+        {
+            if(expression->getKind() != BoundNode::Kind::IdentifierExpression)
+                return std::nullopt;
+
+            auto local = std::get_if<Register>(m_variables.get(static_cast<const BoundIdentifierExpression*>(expression)->getValue()));
+            return local? std::optional<std::uint8_t>{local->index}: std::nullopt;
+        }
+
+        static std::optional<Emitter::BinaryInstruction> getInPlaceInstruction(BoundBinaryOperator::Kind kind)
+        {
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::AdditionAssignment: return Emitter::BinaryInstruction::Add;
+            case BoundBinaryOperator::Kind::SubtractionAssignment: return Emitter::BinaryInstruction::Subtract;
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Extend the value of a register to 64 bits.
+        void extend(std::uint8_t index, Registers::Size size, bool is_signed)
+        {
+            switch(size)
+            {
+            case Registers::Size::Byte:
+            case Registers::Size::Word:
+                m_emitter.binary(is_signed? Emitter::BinaryInstruction::MoveSignExtend: Emitter::BinaryInstruction::MoveExtend,
+                    Registers::getName(index), Registers::getName(index, size));
+                break;
+            case Registers::Size::DoubleWord:
+                if(is_signed) m_emitter.binary(Emitter::BinaryInstruction::MoveSignExtendDoubleWord, Registers::getName(index), Registers::getName(index, size));
+                else m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(index, size), Registers::getName(index, size));
+                break;
+            default: break;
+            }
+        }
+
+        /// @brief Get a temporary holding the value of an operand, copying it if the operand belongs to a variable.
+        std::uint8_t own(Operand operand)
+        {
+            if(operand.isTemporary)
+                return operand.index;
+
+            auto result = Registers::allocate();
+            move(result, operand.index);
+            return result;
+        }
+
+        /// @brief Read the strings of variables used as the given operands without sharing them, as they are not copied anywhere.
+        void borrow(std::initializer_list<const BoundExpression*> expressions)
+        {
+            for(auto expression: expressions)
+                if(expression->getKind() == BoundNode::Kind::IdentifierExpression)
+                    m_borrowedExpressions.insert(expression);
+        }
+
+        /// @brief Clear the capacity of the string of a variable being read, which may then be copied anywhere: strings with a
+        /// capacity are only appended to in place by the one variable holding them.
+        void shareString(std::uint8_t index)
+        {
+            m_emitter.binary(Emitter::BinaryInstruction::Move, m_emitter.unaryAddress(Registers::getName(index), Registers::Size::QuadWord,
+                Emitter::stringCapacityOffset), std::to_string(0));
+        }
+
+        void move(std::uint8_t destination, std::uint8_t source)
+        {
+            if(destination != source)
+                m_emitter.binary(Emitter::BinaryInstruction::Move, Registers::getName(destination), Registers::getName(source));
+        }
+
+        static void release(Operand operand)
+        {
+            if(operand.isTemporary)
+                Registers::free(operand.index);
+        }
+
         const BoundProgram* const m_program;
         const Target::Platform m_platform;
+        const bool m_optimization;
         Emitter m_emitter;
+        IR::Module m_module;
+        PeepholeOptimizerAMD64::Statistics m_peepholeStatistics{};
+        std::unordered_map<const BoundFunctionDeclaration*, std::size_t> m_functions;
+        RegisterAllocator m_allocator;
         std::unordered_set<std::string> m_externalDefinitions;
         ScopeStack<Variable> m_variables;
+        std::vector<std::pair<std::uint8_t, std::size_t>> m_locals;
+        const BoundFunctionDeclaration* m_function{nullptr};
+        std::unordered_set<const BoundExpression*> m_borrowedExpressions;
+        const BoundExpression* m_discardedExpression{nullptr};
+        std::size_t m_interval{0ul};
         bool m_hasMain{false}, m_isMain{false};
         constexpr static auto s_systemExit{"sys_exit"};
     };
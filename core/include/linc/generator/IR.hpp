@@ -0,0 +1,543 @@
+#pragma once
+#include <linc/system/Types.hpp>
+#include <linc/system/Logger.hpp>
+#include <linc/Include.hpp>
+#include <algorithm>
+
+/// Every instruction of the intermediate representation, along with the meaning of its operands (a, b, ...). Every instruction
+/// defines the value of the same index; its kind is the primitive type of that value (void for instructions without a result).
+#define LINC_IR_OPCODES(X) \
+    X(Argument) /* the function argument at index immediate */ \
+    X(Constant) /* immediate, canonicalized to the instruction's kind */ \
+    X(Allocate) /* a stack slot holding a value of the instruction's kind */ \
+    X(Load) /* *a */ \
+    X(Store) /* *a = b */ \
+    X(LoadGlobal) /* symbols[immediate] */ \
+    X(StoreGlobal) /* symbols[immediate] = a */ \
+    X(Phi) /* the operand at the position of the predecessor control was transferred from */ \
+    X(Add) /* a + b */ \
+    X(Subtract) /* a - b */ \
+    X(Multiply) /* a * b */ \
+    X(Divide) /* a / b */ \
+    X(Modulo) /* a % b */ \
+    X(BitwiseAnd) /* a & b */ \
+    X(BitwiseOr) /* a | b */ \
+    X(BitwiseXor) /* a ^ b */ \
+    X(ShiftLeft) /* a << b */ \
+    X(ShiftRight) /* a >> b, arithmetic for signed kinds */ \
+    X(Equals) /* a == b */ \
+    X(NotEquals) /* a != b */ \
+    X(Greater) /* a > b */ \
+    X(Less) /* a < b */ \
+    X(GreaterEqual) /* a >= b */ \
+    X(LessEqual) /* a <= b */ \
+    X(Negate) /* -a */ \
+    X(BitwiseNot) /* ~a */ \
+    X(LogicalNot) /* !a */ \
+    X(Convert) /* a converted to the instruction's kind */ \
+    X(Call) /* symbols[immediate](a, b, ...) */ \
+    X(ExternalCall) /* symbols[immediate](a, b, ...), an external symbol */ \
+    X(Jump) /* goto targets[0] */ \
+    X(Branch) /* if a goto targets[0] else goto targets[1] */ \
+    X(Switch) /* goto cases[a - immediate] if a - immediate indexes the cases, else goto targets[0] */ \
+    X(Return) /* return a, if any */
+
+namespace linc
+{
+    /// @brief Typed SSA intermediate representation, sitting between the bound tree and native code generation. A function is a
+    /// control flow graph of basic blocks, each holding a list of instructions ending with a terminator (Jump, Branch, Switch or Return).
+    /// Values are only ever of integral, character or boolean kinds, kept canonicalized (sign or zero-extended to 64 bits).
+    class IR final
+    {
+    public:
+        IR() = delete;
+
+        using Value = std::uint32_t;
+        using Block = std::uint32_t;
+        static constexpr Value none{std::numeric_limits<Value>::max()};
+
+        enum class OpCode: unsigned char
+        {
+        #define LINC_IR_OPCODE_ENUMERATOR(name) name,
+            LINC_IR_OPCODES(LINC_IR_OPCODE_ENUMERATOR)
+        #undef LINC_IR_OPCODE_ENUMERATOR
+        };
+
+        struct Instruction final
+        {
+            OpCode code;
+            Types::Kind kind{Types::Kind::_void};
+            std::vector<Value> operands{};
+            std::array<Block, 2ul> targets{};
+            Types::u64 immediate{};
+
+            /// @brief The block every value of a switch's range goes to, from the lowest (the immediate) on.
+            std::vector<Block> cases{};
+        };
+
+        struct BasicBlock final
+        {
+            /// @brief The instructions of the block, phi nodes first and the terminator last.
+            std::vector<Value> instructions;
+
+            /// @brief The blocks control may arrive from, in the order of the operands of phi nodes.
+            std::vector<Block> predecessors;
+        };
+
+        struct Function final
+        {
+            std::string name;
+            Types::Kind returnKind{Types::Kind::_void};
+            std::vector<Types::Kind> argumentKinds;
+            std::vector<Instruction> values;
+            std::vector<BasicBlock> blocks;
+            bool isEntryPoint{};
+
+            Block appendBlock()
+            {
+                blocks.emplace_back();
+                return static_cast<Block>(blocks.size() - 1ul);
+            }
+
+            Value append(Block block, Instruction instruction)
+            {
+                values.push_back(std::move(instruction));
+                auto value = static_cast<Value>(values.size() - 1ul);
+                blocks[block].instructions.push_back(value);
+                return value;
+            }
+
+            /// @brief Insert an instruction right before the terminator of a block.
+            Value insertBeforeTerminator(Block block, Instruction instruction)
+            {
+                values.push_back(std::move(instruction));
+                auto value = static_cast<Value>(values.size() - 1ul);
+                auto& instructions = blocks[block].instructions;
+                instructions.insert(instructions.end() - 1, value);
+                return value;
+            }
+
+            [[nodiscard]] const Instruction* getTerminator(Block block) const
+            {
+                const auto& instructions = blocks[block].instructions;
+                if(instructions.empty() || !isTerminator(values[instructions.back()].code))
+                    return nullptr;
+
+                return &values[instructions.back()];
+            }
+
+            [[nodiscard]] std::vector<Block> getSuccessors(Block block) const
+            {
+                auto terminator = getTerminator(block);
+                if(!terminator) return {};
+
+                switch(terminator->code)
+                {
+                case OpCode::Jump: return {terminator->targets[0ul]};
+                case OpCode::Branch: return {terminator->targets[0ul], terminator->targets[1ul]};
+                case OpCode::Switch:
+                {
+                    // the cases of a switch mostly share their targets, which are only successors once
+                    std::vector<Block> successors{terminator->targets[0ul]};
+                    for(auto target: terminator->cases)
+                        if(std::find(successors.begin(), successors.end(), target) == successors.end())
+                            successors.push_back(target);
+
+                    return successors;
+                }
+                default: return {};
+                }
+            }
+
+            /// @brief Recompute the predecessors of every block from the terminators. Only valid before phi nodes are introduced.
+            void computePredecessors()
+            {
+                for(auto& block: blocks)
+                    block.predecessors.clear();
+
+                for(Block block{0u}; block < blocks.size(); ++block)
+                    for(auto successor: getSuccessors(block))
+                        blocks[successor].predecessors.push_back(block);
+            }
+
+            /// @brief Remove a single control flow edge, along with the matching operands of the phi nodes of its target.
+            void removeEdge(Block from, Block to)
+            {
+                auto& predecessors = blocks[to].predecessors;
+                auto find = std::find(predecessors.begin(), predecessors.end(), from);
+                if(find == predecessors.end())
+                    return;
+
+                auto index = find - predecessors.begin();
+                predecessors.erase(find);
+
+                for(auto value: blocks[to].instructions)
+                    if(auto& instruction = values[value]; instruction.code == OpCode::Phi)
+                        instruction.operands.erase(instruction.operands.begin() + index);
+                    else break;
+            }
+
+            /// @brief Redirect every use of a value to its replacement, if it has one (following chains of replacements).
+            void replaceUses(const std::vector<Value>& replacements)
+            {
+                auto resolve = [&](Value value)
+                {
+                    while(value < replacements.size() && replacements[value] != none)
+                        value = replacements[value];
+                    return value;
+                };
+
+                for(const auto& block: blocks)
+                    for(auto value: block.instructions)
+                        for(auto& operand: values[value].operands)
+                            operand = resolve(operand);
+            }
+
+            /// @brief Remove the instructions of every block for which the predicate holds.
+            template <typename Predicate>
+            void removeInstructions(Predicate predicate)
+            {
+                for(auto& block: blocks)
+                    std::erase_if(block.instructions, predicate);
+            }
+        };
+
+        struct Module final
+        {
+            std::vector<Function> functions;
+            std::vector<std::string> symbols;
+
+            /// @brief Get the index of a symbol (function or global variable name), adding it if needed.
+            Types::u64 symbol(const std::string& name)
+            {
+                auto find = std::find(symbols.begin(), symbols.end(), name);
+                if(find != symbols.end())
+                    return static_cast<Types::u64>(find - symbols.begin());
+
+                symbols.push_back(name);
+                return symbols.size() - 1ul;
+            }
+        };
+
+        /// @brief The dominator tree of the blocks reachable from the entry block.
+        struct Dominance final
+        {
+            /// @brief The reachable blocks in reverse postorder.
+            std::vector<Block> order;
+            std::vector<Block> immediateDominators;
+            std::vector<std::vector<Block>> children;
+            std::vector<std::uint32_t> orderIndices;
+
+            [[nodiscard]] inline bool isReachable(Block block) const { return immediateDominators[block] != none; }
+
+            [[nodiscard]] bool dominates(Block dominator, Block block) const
+            {
+                if(!isReachable(block))
+                    return false;
+
+                while(block != dominator && block != 0u)
+                    block = immediateDominators[block];
+
+                return block == dominator;
+            }
+        };
+
+        /// @brief Compute the dominator tree of a function, using the iterative algorithm of Cooper, Harvey and Kennedy.
+        static Dominance computeDominance(const Function& function)
+        {
+            Dominance dominance;
+            const auto count = function.blocks.size();
+            dominance.immediateDominators.assign(count, none);
+            dominance.children.resize(count);
+            dominance.orderIndices.assign(count, none);
+
+            std::vector<Block> postorder;
+            std::vector<bool> visited(count, false);
+            std::vector<std::pair<Block, std::size_t>> stack{{0u, 0ul}};
+            visited[0ul] = true;
+
+            while(!stack.empty())
+            {
+                auto [block, next] = stack.back();
+                auto successors = function.getSuccessors(block);
+
+                // successors are visited last to first, so that the first target of a branch directly follows it in reverse postorder
+                if(next < successors.size())
+                {
+                    ++stack.back().second;
+                    auto successor = successors[successors.size() - 1ul - next];
+                    if(!visited[successor])
+                    {
+                        visited[successor] = true;
+                        stack.emplace_back(successor, 0ul);
+                    }
+                }
+                else
+                {
+                    postorder.push_back(block);
+                    stack.pop_back();
+                }
+            }
+
+            dominance.order.assign(postorder.rbegin(), postorder.rend());
+            for(std::uint32_t i{0u}; i < dominance.order.size(); ++i)
+                dominance.orderIndices[dominance.order[i]] = i;
+
+            auto& dominators = dominance.immediateDominators;
+            dominators[0ul] = 0u;
+
+            auto intersect = [&](Block first, Block second)
+            {
+                while(first != second)
+                {
+                    while(dominance.orderIndices[first] > dominance.orderIndices[second])
+                        first = dominators[first];
+                    while(dominance.orderIndices[second] > dominance.orderIndices[first])
+                        second = dominators[second];
+                }
+                return first;
+            };
+
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+
+                for(auto block: dominance.order)
+                {
+                    if(block == 0u)
+                        continue;
+
+                    auto dominator = none;
+                    for(auto predecessor: function.blocks[block].predecessors)
+                        if(dominators[predecessor] != none)
+                            dominator = dominator == none? predecessor: intersect(predecessor, dominator);
+
+                    if(dominators[block] != dominator)
+                    {
+                        dominators[block] = dominator;
+                        changed = true;
+                    }
+                }
+            }
+
+            for(auto block: dominance.order)
+                if(block != 0u)
+                    dominance.children[dominators[block]].push_back(block);
+
+            return dominance;
+        }
+
+        /// @brief Compute the dominance frontier of every reachable block.
+        static std::vector<std::vector<Block>> computeFrontiers(const Function& function, const Dominance& dominance)
+        {
+            std::vector<std::vector<Block>> frontiers(function.blocks.size());
+
+            for(auto block: dominance.order)
+            {
+                const auto& predecessors = function.blocks[block].predecessors;
+                if(predecessors.size() < 2ul)
+                    continue;
+
+                for(auto predecessor: predecessors)
+                    for(auto runner = predecessor; dominance.isReachable(runner) && runner != dominance.immediateDominators[block];
+                        runner = dominance.immediateDominators[runner])
+                    {
+                        auto& frontier = frontiers[runner];
+                        if(std::find(frontier.begin(), frontier.end(), block) == frontier.end())
+                            frontier.push_back(block);
+                    }
+            }
+
+            return frontiers;
+        }
+
+        [[nodiscard]] static bool isTerminator(OpCode code)
+        {
+            return code == OpCode::Jump || code == OpCode::Branch || code == OpCode::Switch || code == OpCode::Return;
+        }
+
+        /// @brief Whether an instruction must be kept even if its value is unused.
+        [[nodiscard]] static bool hasSideEffects(OpCode code)
+        {
+            switch(code)
+            {
+            case OpCode::Store:
+            case OpCode::StoreGlobal:
+            case OpCode::Call:
+            case OpCode::ExternalCall:
+                return true;
+            default: return isTerminator(code);
+            }
+        }
+
+        /// @brief Whether an instruction's value only depends on its operands, such that it may be computed anywhere they are available.
+        [[nodiscard]] static bool isPure(OpCode code)
+        {
+            return code == OpCode::Constant || code == OpCode::Convert || (code >= OpCode::Add && code <= OpCode::LogicalNot);
+        }
+
+        [[nodiscard]] static bool isComparison(OpCode code)
+        {
+            return code >= OpCode::Equals && code <= OpCode::LessEqual;
+        }
+
+        [[nodiscard]] static bool isCommutative(OpCode code)
+        {
+            switch(code)
+            {
+            case OpCode::Add:
+            case OpCode::Multiply:
+            case OpCode::BitwiseAnd:
+            case OpCode::BitwiseOr:
+            case OpCode::BitwiseXor:
+            case OpCode::Equals:
+            case OpCode::NotEquals:
+                return true;
+            default: return false;
+            }
+        }
+
+        /// @brief Whether a kind is compared and extended as a signed integer.
+        [[nodiscard]] static bool isSigned(Types::Kind kind)
+        {
+            return Types::isSigned(kind) || kind == Types::Kind::_char;
+        }
+
+        /// @brief Whether a kind can be held by values of the intermediate representation.
+        [[nodiscard]] static bool isScalar(Types::Kind kind)
+        {
+            return Types::isIntegral(kind) || kind == Types::Kind::_char || kind == Types::Kind::_bool;
+        }
+
+        /// @brief Truncate a value to the width of a kind, then sign or zero-extend it back to 64 bits.
+        static Types::u64 canonicalize(Types::Kind kind, Types::u64 bits)
+        {
+            switch(kind)
+            {
+            case Types::Kind::i8:
+            case Types::Kind::_char:
+                return static_cast<Types::u64>(static_cast<Types::i64>(static_cast<Types::i8>(bits)));
+            case Types::Kind::i16: return static_cast<Types::u64>(static_cast<Types::i64>(static_cast<Types::i16>(bits)));
+            case Types::Kind::i32: return static_cast<Types::u64>(static_cast<Types::i64>(static_cast<Types::i32>(bits)));
+            case Types::Kind::u8: return bits & 0xFFul;
+            case Types::Kind::u16: return bits & 0xFFFFul;
+            case Types::Kind::u32: return bits & 0xFFFFFFFFul;
+            case Types::Kind::_bool: return bits & 1ul;
+            default: return bits;
+            }
+        }
+
+        /// @brief Compute the result of a pure instruction whose operands are all constant.
+        /// @param operand_kind The kind of the instruction's first operand.
+        /// @return The canonicalized result, or nullopt if it cannot be computed at compile time (e.g. division by zero).
+        static std::optional<Types::u64> evaluate(const Instruction& instruction, Types::Kind operand_kind, const std::vector<Types::u64>& operands)
+        {
+            const auto kind = instruction.kind;
+            const auto is_signed = isSigned(operand_kind);
+            const auto a = operands.empty()? 0ul: operands[0ul], b = operands.size() < 2ul? 0ul: operands[1ul];
+            const auto shift_mask = Types::sizeFromKind(operand_kind) == Types::Size::QuadWord? 63ul: 31ul;
+            const auto signed_a = static_cast<Types::i64>(a), signed_b = static_cast<Types::i64>(b);
+
+            switch(instruction.code)
+            {
+            case OpCode::Constant: return instruction.immediate;
+            case OpCode::Add: return canonicalize(kind, a + b);
+            case OpCode::Subtract: return canonicalize(kind, a - b);
+            case OpCode::Multiply: return canonicalize(kind, a * b);
+            case OpCode::Divide:
+            case OpCode::Modulo:
+            {
+                const auto minimum = Types::sizeFromKind(kind) == Types::Size::QuadWord? std::numeric_limits<Types::i64>::min():
+                    static_cast<Types::i64>(std::numeric_limits<Types::i32>::min());
+
+                if(b == 0ul || (is_signed && signed_a == minimum && signed_b == -1l))
+                    return std::nullopt;
+                else if(is_signed)
+                    return canonicalize(kind, static_cast<Types::u64>(instruction.code == OpCode::Divide? signed_a / signed_b: signed_a % signed_b));
+                else return canonicalize(kind, instruction.code == OpCode::Divide? a / b: a % b);
+            }
+            case OpCode::BitwiseAnd: return canonicalize(kind, a & b);
+            case OpCode::BitwiseOr: return canonicalize(kind, a | b);
+            case OpCode::BitwiseXor: return canonicalize(kind, a ^ b);
+            case OpCode::ShiftLeft: return canonicalize(kind, a << (b & shift_mask));
+            case OpCode::ShiftRight:
+                return canonicalize(kind, is_signed? static_cast<Types::u64>(signed_a >> (b & shift_mask)): a >> (b & shift_mask));
+            case OpCode::Equals: return a == b;
+            case OpCode::NotEquals: return a != b;
+            case OpCode::Greater: return is_signed? signed_a > signed_b: a > b;
+            case OpCode::Less: return is_signed? signed_a < signed_b: a < b;
+            case OpCode::GreaterEqual: return is_signed? signed_a >= signed_b: a >= b;
+            case OpCode::LessEqual: return is_signed? signed_a <= signed_b: a <= b;
+            case OpCode::Negate: return canonicalize(kind, -a);
+            case OpCode::BitwiseNot: return canonicalize(kind, ~a);
+            case OpCode::LogicalNot: return a == 0ul;
+            case OpCode::Convert: return kind == Types::Kind::_bool? static_cast<Types::u64>(a != 0ul): canonicalize(kind, a);
+            default: return std::nullopt;
+            }
+        }
+
+        static std::string opCodeToString(OpCode code)
+        {
+            switch(code)
+            {
+            #define LINC_IR_OPCODE_STRING(name) case OpCode::name: return #name;
+                LINC_IR_OPCODES(LINC_IR_OPCODE_STRING)
+            #undef LINC_IR_OPCODE_STRING
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(code);
+            }
+        }
+
+        /// @brief Produce a human-readable listing of a function.
+        static std::string toString(const Function& function, const Module& module)
+        {
+            std::string result = Logger::format("fn $ ($ arguments):\n", function.name, std::to_string(function.argumentKinds.size()));
+
+            for(Block block{0u}; block < function.blocks.size(); ++block)
+            {
+                if(function.blocks[block].instructions.empty())
+                    continue;
+
+                Logger::append(result, "b$:", std::to_string(block));
+                for(auto predecessor: function.blocks[block].predecessors)
+                    Logger::append(result, " b$", std::to_string(predecessor));
+                result.push_back('\n');
+
+                for(auto value: function.blocks[block].instructions)
+                {
+                    const auto& instruction = function.values[value];
+                    Logger::append(result, "  %$ = $ $", std::to_string(value), Types::kindToString(instruction.kind), opCodeToString(instruction.code));
+
+                    for(auto operand: instruction.operands)
+                        Logger::append(result, " %$", std::to_string(operand));
+
+                    switch(instruction.code)
+                    {
+                    case OpCode::Argument: Logger::append(result, " #$", std::to_string(instruction.immediate)); break;
+                    case OpCode::Constant: Logger::append(result, " $", std::to_string(static_cast<Types::i64>(instruction.immediate))); break;
+                    case OpCode::LoadGlobal:
+                    case OpCode::StoreGlobal:
+                    case OpCode::Call:
+                    case OpCode::ExternalCall:
+                        Logger::append(result, " @$", module.symbols.at(instruction.immediate));
+                        break;
+                    case OpCode::Jump: Logger::append(result, " b$", std::to_string(instruction.targets[0ul])); break;
+                    case OpCode::Branch:
+                        Logger::append(result, " b$ b$", std::to_string(instruction.targets[0ul]), std::to_string(instruction.targets[1ul]));
+                        break;
+                    case OpCode::Switch:
+                        Logger::append(result, " $ b$ [", std::to_string(static_cast<Types::i64>(instruction.immediate)),
+                            std::to_string(instruction.targets[0ul]));
+                        for(std::size_t i{0ul}; i < instruction.cases.size(); ++i)
+                            Logger::append(result, i == 0ul? "b$": " b$", std::to_string(instruction.cases[i]));
+                        result.push_back(']');
+                        break;
+                    default: break;
+                    }
+                    result.push_back('\n');
+                }
+            }
+
+            return result;
+        }
+    };
+}
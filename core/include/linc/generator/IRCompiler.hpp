@@ -0,0 +1,770 @@
+#pragma once
+#include <linc/BoundTree.hpp>
+#include <linc/generator/IR.hpp>
+#include <linc/Include.hpp>
+#include <span>
+
+namespace linc
+{
+    /// @brief Lowers the functions of a bound program to the SSA intermediate representation. Every variable is given a stack slot
+    /// (see IR::OpCode::Allocate) accessed through explicit loads and stores, which the PromoteMemory pass later turns into SSA values.
+    /// Functions using constructs the intermediate representation does not support (strings, floating-point values, arrays, ...) are
+    /// skipped one by one, so that the caller may generate them another way.
+    class IRCompiler final
+    {
+    public:
+        using Value = IR::Value;
+        using Block = IR::Block;
+        using OpCode = IR::OpCode;
+
+        /// @brief Compile every supported function of a program. Global variables are visible to the functions declared after them.
+        IR::Module compileProgram(const BoundProgram* program)
+        {
+            m_module = IR::Module{};
+            m_functionIndices.clear();
+            m_functionDeclarations.clear();
+            m_globals.clear();
+            m_unsupportedReasons.clear();
+
+            for(const auto& declaration: program->declarations)
+                if(declaration->getKind() == BoundNode::Kind::FunctionDeclaration)
+                {
+                    auto function = static_cast<const BoundFunctionDeclaration*>(declaration.get());
+                    m_functionDeclarations[function->getName()] = function;
+                }
+
+            for(const auto& declaration: program->declarations)
+                switch(declaration->getKind())
+                {
+                case BoundNode::Kind::VariableDeclaration:
+                {
+                    auto variable = static_cast<const BoundVariableDeclaration*>(declaration.get());
+                    m_globals[variable->getName()] = primitiveKind(variable->getActualType());
+                    break;
+                }
+                case BoundNode::Kind::FunctionDeclaration:
+                {
+                    auto function = static_cast<const BoundFunctionDeclaration*>(declaration.get());
+
+                    try
+                    {
+                        compileFunction(function);
+                        m_functionIndices[function] = m_module.functions.size() - 1ul;
+                    }
+                    catch(const Unsupported& unsupported)
+                    {
+                        m_module.functions.pop_back();
+                        m_unsupportedReasons.emplace_back(function->getName(), unsupported.reason);
+                    }
+                    break;
+                }
+                default: break;
+                }
+
+            return std::move(m_module);
+        }
+
+        /// @brief Get the index within the compiled module of the function compiled from a declaration, if it was supported.
+        [[nodiscard]] std::optional<std::size_t> findFunction(const BoundFunctionDeclaration* declaration) const
+        {
+            auto find = m_functionIndices.find(declaration);
+            return find != m_functionIndices.end()? std::make_optional(find->second): std::nullopt;
+        }
+
+        /// @brief The functions skipped by the last compilation, along with the reason they were rejected for.
+        [[nodiscard]] inline const std::vector<std::pair<std::string, std::string>>& getUnsupportedReasons() const { return m_unsupportedReasons; }
+    private:
+        struct Unsupported final
+        {
+            std::string reason;
+        };
+
+        struct Loop final
+        {
+            std::string label;
+            Block breakBlock, continueBlock;
+        };
+
+        /// @brief The number of arguments passed in registers by the System V calling convention.
+        static constexpr std::size_t s_argumentLimit{6ul};
+
+        /// @brief The most keys of a decision tree tested one after the other rather than halved again.
+        static constexpr std::size_t s_decisionTreeLeafSize{3ul};
+
+        static inline Types::Kind primitiveKind(const Types::type& type)
+        {
+            return type.kind == Types::type::Kind::Primitive? type.primitive: Types::Kind::invalid;
+        }
+
+        /// @brief Get the kind of a value of the given type, which must be representable by the intermediate representation.
+        static Types::Kind scalarKind(const Types::type& type, bool allow_void = false)
+        {
+            auto kind = primitiveKind(type);
+
+            if(IR::isScalar(kind) || (allow_void && kind == Types::Kind::_void))
+                return kind;
+
+            throw Unsupported{Logger::format("value of type `$`", type)};
+        }
+
+        void compileFunction(const BoundFunctionDeclaration* declaration)
+        {
+            const auto& arguments = declaration->getArguments();
+            m_module.functions.push_back(IR::Function{.name = declaration->getName(), .isEntryPoint = declaration->getName() == "main"});
+            m_function = &m_module.functions.back();
+
+            if(arguments.size() > s_argumentLimit || (m_function->isEntryPoint && !arguments.empty()))
+                throw Unsupported{"unsupported argument count"};
+
+            m_function->returnKind = scalarKind(declaration->getReturnType(), true);
+            m_block = m_function->appendBlock();
+            m_scopes.assign(1ul, {});
+            m_loops.clear();
+
+            for(std::size_t i{0ul}; i < arguments.size(); ++i)
+            {
+                auto kind = scalarKind(arguments[i]->getActualType());
+                m_function->argumentKinds.push_back(kind);
+                m_scopes.back()[arguments[i]->getName()] = allocate(kind);
+            }
+
+            for(std::size_t i{0ul}; i < arguments.size(); ++i)
+            {
+                auto value = emit(OpCode::Argument, m_function->argumentKinds[i], {}, i);
+                emit(OpCode::Store, Types::Kind::_void, {m_scopes.back().at(arguments[i]->getName()), value});
+            }
+
+            auto result = compileExpression(declaration->getBody());
+            emitReturn(result);
+            m_function->computePredecessors();
+        }
+
+        Value emit(OpCode code, Types::Kind kind, std::vector<Value> operands = {}, Types::u64 immediate = 0ul)
+        {
+            return m_function->append(m_block, IR::Instruction{.code = code, .kind = kind, .operands = std::move(operands), .immediate = immediate});
+        }
+
+        Value constant(Types::Kind kind, Types::u64 value)
+        {
+            return emit(OpCode::Constant, kind, {}, IR::canonicalize(kind, value));
+        }
+
+        /// @brief Create a stack slot in the entry block, where it dominates every access to it.
+        Value allocate(Types::Kind kind)
+        {
+            m_function->values.push_back(IR::Instruction{.code = OpCode::Allocate, .kind = kind});
+            auto value = static_cast<Value>(m_function->values.size() - 1ul);
+            auto& entry = m_function->blocks[0ul].instructions;
+            entry.insert(entry.begin(), value);
+            return value;
+        }
+
+        /// @brief Convert a value to the given kind, if it is not already of that kind.
+        Value convert(Value value, Types::Kind kind)
+        {
+            if(value == IR::none || kind == Types::Kind::_void || m_function->values[value].kind == kind)
+                return value;
+
+            return emit(OpCode::Convert, kind, {value});
+        }
+
+        void jump(Block target)
+        {
+            m_function->append(m_block, IR::Instruction{.code = OpCode::Jump, .targets = {target, 0u}});
+        }
+
+        void branch(Value condition, Block if_true, Block if_false)
+        {
+            m_function->append(m_block, IR::Instruction{.code = OpCode::Branch, .operands = {condition}, .targets = {if_true, if_false}});
+        }
+
+        /// @brief Terminate the current block, continuing in a new one that is only reachable if it is jumped to later on.
+        void terminate(IR::Instruction terminator)
+        {
+            m_function->append(m_block, std::move(terminator));
+            m_block = m_function->appendBlock();
+        }
+
+        void emitReturn(Value value)
+        {
+            IR::Instruction instruction{.code = OpCode::Return};
+            if(m_function->returnKind != Types::Kind::_void && value != IR::none)
+                instruction.operands.push_back(convert(value, m_function->returnKind));
+            else if(m_function->returnKind != Types::Kind::_void)
+                instruction.operands.push_back(constant(m_function->returnKind, 0ul));
+
+            terminate(std::move(instruction));
+        }
+
+        std::optional<Value> findLocal(const std::string& name) const
+        {
+            for(auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+                if(auto find = scope->find(name); find != scope->end())
+                    return find->second;
+
+            return std::nullopt;
+        }
+
+        /// @brief A variable that may be read and written, either a stack slot or a global variable.
+        struct Place final
+        {
+            std::optional<Value> slot;
+            Types::u64 symbol{};
+            Types::Kind kind;
+        };
+
+        Place resolvePlace(const BoundExpression* expression)
+        {
+            if(expression->getKind() != BoundNode::Kind::IdentifierExpression)
+                throw Unsupported{"mutable operator on an operand that is not a variable"};
+
+            auto identifier = static_cast<const BoundIdentifierExpression*>(expression);
+            const auto& name = identifier->getValue();
+
+            if(identifier->getType().kind == Types::type::Kind::Function)
+                throw Unsupported{Logger::format("reference to function `$`", name)};
+            else if(auto local = findLocal(name))
+                return Place{.slot = *local, .kind = m_function->values[*local].kind};
+            else if(auto global = m_globals.find(name); global != m_globals.end() && IR::isScalar(global->second))
+                return Place{.slot = std::nullopt, .symbol = m_module.symbol(name), .kind = global->second};
+
+            throw Unsupported{Logger::format("reference to variable `$`", name)};
+        }
+
+        Value load(const Place& place)
+        {
+            if(place.slot)
+                return emit(OpCode::Load, place.kind, {*place.slot});
+
+            return emit(OpCode::LoadGlobal, place.kind, {}, place.symbol);
+        }
+
+        void store(const Place& place, Value value)
+        {
+            if(place.slot)
+                emit(OpCode::Store, Types::Kind::_void, {*place.slot, value});
+            else emit(OpCode::StoreGlobal, Types::Kind::_void, {value}, place.symbol);
+        }
+
+        void compileStatement(const BoundStatement* statement)
+        {
+            switch(statement->getKind())
+            {
+            case BoundNode::Kind::ExpressionStatement:
+                compileExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression());
+                return;
+            case BoundNode::Kind::DeclarationStatement:
+                compileDeclaration(static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration());
+                return;
+            case BoundNode::Kind::ReturnStatement:
+            {
+                auto expression = static_cast<const BoundReturnStatement*>(statement)->getExpression();
+                emitReturn(expression? compileExpression(expression): IR::none);
+                return;
+            }
+            case BoundNode::Kind::BreakStatement:
+                terminate(IR::Instruction{.code = OpCode::Jump,
+                    .targets = {findLoop(static_cast<const BoundBreakStatement*>(statement)->getLabel()).breakBlock, 0u}});
+                return;
+            case BoundNode::Kind::ContinueStatement:
+                terminate(IR::Instruction{.code = OpCode::Jump,
+                    .targets = {findLoop(static_cast<const BoundContinueStatement*>(statement)->getLabel()).continueBlock, 0u}});
+                return;
+            default:
+                throw Unsupported{"unrecognized statement"};
+            }
+        }
+
+        void compileDeclaration(const BoundDeclaration* declaration)
+        {
+            switch(declaration->getKind())
+            {
+            case BoundNode::Kind::VariableDeclaration:
+            {
+                auto variable = static_cast<const BoundVariableDeclaration*>(declaration);
+                auto kind = scalarKind(variable->getActualType());
+                auto value = variable->getDefaultValue()? convert(compileExpression(*variable->getDefaultValue()), kind): constant(kind, 0ul);
+
+                if(value == IR::none)
+                    throw Unsupported{Logger::format("variable `$` initialized with no value", variable->getName())};
+
+                auto slot = allocate(kind);
+                emit(OpCode::Store, Types::Kind::_void, {slot, value});
+                m_scopes.back()[variable->getName()] = slot;
+                return;
+            }
+            case BoundNode::Kind::ExternalDeclaration:
+            case BoundNode::Kind::StructureDeclaration:
+            case BoundNode::Kind::EnumerationDeclaration:
+                return;
+            default:
+                throw Unsupported{"nested declaration"};
+            }
+        }
+
+        Loop& findLoop(const std::string& label)
+        {
+            for(auto loop = m_loops.rbegin(); loop != m_loops.rend(); ++loop)
+                if(label.empty() || loop->label == label)
+                    return *loop;
+
+            throw Unsupported{Logger::format("control flow statement outside of a loop (with label '$')", label)};
+        }
+
+        /// @brief Create the slot holding the value of a control flow expression of the given type, if it has one.
+        std::optional<Value> resultSlot(const Types::type& type)
+        {
+            auto kind = primitiveKind(type);
+            if(!IR::isScalar(kind))
+                return std::nullopt;
+
+            auto slot = allocate(kind);
+            emit(OpCode::Store, Types::Kind::_void, {slot, constant(kind, 0ul)});
+            return slot;
+        }
+
+        void storeResult(std::optional<Value> slot, Value value)
+        {
+            if(slot && value != IR::none)
+                emit(OpCode::Store, Types::Kind::_void, {*slot, convert(value, m_function->values[*slot].kind)});
+        }
+
+        Value loadResult(std::optional<Value> slot)
+        {
+            return slot? emit(OpCode::Load, m_function->values[*slot].kind, {*slot}): IR::none;
+        }
+
+        /// @brief Compile an expression, returning its value (or IR::none for expressions without a value).
+        Value compileExpression(const BoundExpression* expression)
+        {
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::LiteralExpression:
+            {
+                auto literal = static_cast<const BoundLiteralExpression*>(expression);
+                auto kind = primitiveKind(literal->getType());
+
+                if(kind == Types::Kind::_void)
+                    return IR::none;
+                else if(!IR::isScalar(kind))
+                    throw Unsupported{Logger::format("literal of type `$`", literal->getType())};
+
+                return constant(kind, literal->getValue().convert<Types::u64>());
+            }
+            case BoundNode::Kind::IdentifierExpression:
+                return load(resolvePlace(expression));
+            case BoundNode::Kind::BlockExpression:
+            {
+                auto block = static_cast<const BoundBlockExpression*>(expression);
+                m_scopes.emplace_back();
+
+                for(const auto& statement: block->getStatements())
+                    compileStatement(statement.get());
+
+                auto result = block->getTail()? compileExpression(block->getTail()): IR::none;
+                m_scopes.pop_back();
+                return result;
+            }
+            case BoundNode::Kind::IfExpression:
+                return compileIfExpression(static_cast<const BoundIfExpression*>(expression));
+            case BoundNode::Kind::WhileExpression:
+                return compileWhileExpression(static_cast<const BoundWhileExpression*>(expression));
+            case BoundNode::Kind::ForExpression:
+                return compileForExpression(static_cast<const BoundForExpression*>(expression));
+            case BoundNode::Kind::MatchExpression:
+                return compileMatchExpression(static_cast<const BoundMatchExpression*>(expression));
+            case BoundNode::Kind::UnaryExpression:
+                return compileUnaryExpression(static_cast<const BoundUnaryExpression*>(expression));
+            case BoundNode::Kind::BinaryExpression:
+                return compileBinaryExpression(static_cast<const BoundBinaryExpression*>(expression));
+            case BoundNode::Kind::ConversionExpression:
+            {
+                auto conversion = static_cast<const BoundConversionExpression*>(expression);
+                scalarKind(conversion->getExpression()->getType());
+                return convert(compileExpression(conversion->getExpression()), scalarKind(conversion->getType()));
+            }
+            case BoundNode::Kind::FunctionCallExpression:
+            {
+                auto call = static_cast<const BoundFunctionCallExpression*>(expression);
+                auto find = m_functionDeclarations.find(call->getName());
+
+                if(find == m_functionDeclarations.end())
+                    throw Unsupported{Logger::format("call to unknown function `$`", call->getName())};
+
+                const auto& parameters = find->second->getArguments();
+                if(call->getArguments().size() != parameters.size() || parameters.size() > s_argumentLimit)
+                    throw Unsupported{Logger::format("call to function `$` with unsupported arguments", call->getName())};
+
+                auto kind = scalarKind(find->second->getReturnType(), true);
+                std::vector<Value> arguments;
+
+                for(std::size_t i{0ul}; i < parameters.size(); ++i)
+                    arguments.push_back(convert(compileExpression(call->getArguments()[i].value.get()), scalarKind(parameters[i]->getActualType())));
+
+                auto result = emit(OpCode::Call, kind, std::move(arguments), m_module.symbol(call->getName()));
+                return kind == Types::Kind::_void? IR::none: result;
+            }
+            case BoundNode::Kind::ExternalCallExpression:
+            {
+                auto call = static_cast<const BoundExternalCallExpression*>(expression);
+                const auto& arguments = call->getArguments();
+
+                if(arguments.size() > s_argumentLimit)
+                    throw Unsupported{Logger::format("call to external function `$` with too many arguments", call->getName())};
+
+                auto kind = scalarKind(call->getType(), true);
+                std::vector<Value> values;
+
+                for(const auto& argument: arguments)
+                {
+                    scalarKind(argument->getType());
+                    values.push_back(compileExpression(argument.get()));
+                }
+
+                auto result = emit(OpCode::ExternalCall, kind, std::move(values), m_module.symbol(call->getName()));
+                return kind == Types::Kind::_void? IR::none: result;
+            }
+            default:
+                throw Unsupported{Logger::format("unsupported expression `$`", expression->toString())};
+            }
+        }
+
+        Value compileIfExpression(const BoundIfExpression* expression)
+        {
+            auto slot = resultSlot(expression->getType());
+            m_scopes.emplace_back();
+
+            auto condition = compileExpression(expression->getTestExpression());
+            auto if_block = m_function->appendBlock(), end_block = m_function->appendBlock();
+            auto else_block = expression->hasElse()? m_function->appendBlock(): end_block;
+            branch(condition, if_block, else_block);
+
+            m_block = if_block;
+            storeResult(slot, compileExpression(expression->getIfBody()));
+            jump(end_block);
+
+            if(expression->hasElse())
+            {
+                m_block = else_block;
+                storeResult(slot, compileExpression(expression->getElseBody()));
+                jump(end_block);
+            }
+
+            m_scopes.pop_back();
+            m_block = end_block;
+            return loadResult(slot);
+        }
+
+        /// @brief Compile the rotated form of a loop: the test is evaluated once before entering the loop, which then runs its body
+        /// and re-evaluates the test at its latch. The block entering the loop (its preheader) only jumps to the body.
+        /// @param step The statement executed at the latch before the test (the step of for expressions), if any.
+        /// The loop is left in the block reached by failing the test at its latch or by breaking out of it.
+        void compileLoop(const std::string& label, const BoundExpression* test, const BoundExpression* body, const BoundStatement* step,
+            std::optional<Value> slot, Block exit_block)
+        {
+            auto preheader = m_function->appendBlock(), body_block = m_function->appendBlock();
+            auto latch = m_function->appendBlock(), break_block = m_function->appendBlock();
+
+            m_scopes.emplace_back();
+            branch(compileExpression(test), preheader, exit_block);
+            m_scopes.pop_back();
+
+            m_block = preheader;
+            jump(body_block);
+
+            m_block = body_block;
+            m_loops.push_back(Loop{.label = label, .breakBlock = break_block, .continueBlock = latch});
+            m_scopes.emplace_back();
+            storeResult(slot, compileExpression(body));
+            m_scopes.pop_back();
+            m_loops.pop_back();
+            jump(latch);
+
+            m_block = latch;
+            m_scopes.emplace_back();
+            if(step)
+                compileStatement(step);
+            branch(compileExpression(test), body_block, break_block);
+            m_scopes.pop_back();
+
+            m_block = break_block;
+        }
+
+        Value compileWhileExpression(const BoundWhileExpression* expression)
+        {
+            auto slot = resultSlot(expression->getType());
+            auto end_block = m_function->appendBlock();
+            auto else_block = expression->hasElse()? m_function->appendBlock(): end_block;
+
+            compileLoop(expression->getLabel(), expression->getTestExpression(), expression->getWhileBody(), nullptr, slot, else_block);
+
+            if(expression->hasFinally())
+                storeResult(slot, compileExpression(expression->getFinallyBody()));
+            jump(end_block);
+
+            if(expression->hasElse())
+            {
+                m_block = else_block;
+                storeResult(slot, compileExpression(expression->getElseBody()));
+                jump(end_block);
+            }
+
+            m_block = end_block;
+            return loadResult(slot);
+        }
+
+        Value compileForExpression(const BoundForExpression* expression)
+        {
+            auto variable_specifier = std::get_if<const BoundForExpression::BoundVariableForSpecifier>(&expression->getSpecifier());
+            if(!variable_specifier)
+                throw Unsupported{"ranged for expression"};
+
+            auto slot = resultSlot(expression->getType());
+            auto end_block = m_function->appendBlock();
+            m_scopes.emplace_back();
+
+            compileDeclaration(variable_specifier->variableDeclaration.get());
+            compileLoop(expression->getLabel(), variable_specifier->expression.get(), expression->getBody(), variable_specifier->statement.get(),
+                slot, end_block);
+            jump(end_block);
+
+            m_scopes.pop_back();
+            m_block = end_block;
+            return loadResult(slot);
+        }
+
+        /// @brief Compile a match expression to a chain of comparisons, in the order its clauses are declared in.
+        Value compileMatchExpression(const BoundMatchExpression* expression)
+        {
+            auto slot = resultSlot(expression->getType());
+            auto test = compileExpression(expression->getTestExpression());
+            auto kind = scalarKind(expression->getTestExpression()->getType());
+            auto end_block = m_function->appendBlock();
+
+            if(const auto& dispatch = expression->getDispatch())
+            {
+                const auto& clauses = expression->getClauses()->getList();
+                std::vector<Block> clause_blocks;
+                for(std::size_t i{0ul}; i < clauses.size(); ++i)
+                    clause_blocks.push_back(m_function->appendBlock());
+
+                auto default_block = m_function->appendBlock();
+
+                if(dispatch->kind == BoundMatchExpression::Dispatch::Kind::Table)
+                {
+                    IR::Instruction instruction{.code = OpCode::Switch, .operands = {test}, .targets = {default_block, 0u},
+                        .immediate = dispatch->minimum};
+
+                    for(auto clause: dispatch->table)
+                        instruction.cases.push_back(clause == BoundMatchExpression::Dispatch::noClause? default_block: clause_blocks[clause]);
+
+                    m_function->append(m_block, std::move(instruction));
+                }
+                else compileDecisionTree(test, kind, dispatch->cases, clause_blocks, default_block);
+
+                for(std::size_t i{0ul}; i < clauses.size(); ++i)
+                {
+                    m_block = clause_blocks[i];
+                    m_scopes.emplace_back();
+                    storeResult(slot, compileExpression(clauses[i]->getExpression()));
+                    m_scopes.pop_back();
+                    jump(end_block);
+                }
+
+                m_block = default_block;
+                jump(end_block);
+                m_block = end_block;
+                return loadResult(slot);
+            }
+
+            for(const auto& clause: expression->getClauses()->getList())
+            {
+                auto clause_block = m_function->appendBlock();
+
+                for(const auto& value: clause->getValues()->getList())
+                {
+                    auto next_block = m_function->appendBlock();
+                    auto matches = emit(OpCode::Equals, Types::Kind::_bool, {convert(compileExpression(value.get()), kind), test});
+                    branch(matches, clause_block, next_block);
+                    m_block = next_block;
+                }
+
+                auto next_block = m_block;
+                m_block = clause_block;
+                m_scopes.emplace_back();
+                storeResult(slot, compileExpression(clause->getExpression()));
+                m_scopes.pop_back();
+                jump(end_block);
+                m_block = next_block;
+            }
+
+            jump(end_block);
+            m_block = end_block;
+            return loadResult(slot);
+        }
+
+        /// @brief Branch to the clause of a value among keys sorted in ascending order, halving them with a comparison until few
+        /// enough are left to be tested in order.
+        void compileDecisionTree(Value test, Types::Kind kind, std::span<const std::pair<Types::u64, std::size_t>> cases,
+            const std::vector<Block>& clause_blocks, Block default_block)
+        {
+            if(cases.size() <= s_decisionTreeLeafSize)
+            {
+                for(const auto& [key, clause]: cases)
+                {
+                    auto next_block = m_function->appendBlock();
+                    branch(emit(OpCode::Equals, Types::Kind::_bool, {test, constant(kind, key)}), clause_blocks[clause], next_block);
+                    m_block = next_block;
+                }
+
+                jump(default_block);
+                return;
+            }
+
+            const auto middle = cases.size() / 2ul;
+            auto lower_block = m_function->appendBlock(), upper_block = m_function->appendBlock();
+            branch(emit(OpCode::Less, Types::Kind::_bool, {test, constant(kind, cases[middle].first)}), lower_block, upper_block);
+
+            m_block = lower_block;
+            compileDecisionTree(test, kind, cases.first(middle), clause_blocks, default_block);
+            m_block = upper_block;
+            compileDecisionTree(test, kind, cases.subspan(middle), clause_blocks, default_block);
+        }
+
+        Value compileUnaryExpression(const BoundUnaryExpression* expression)
+        {
+            auto operator_kind = expression->getOperator()->getKind();
+
+            if(operator_kind == BoundUnaryOperator::Kind::Increment || operator_kind == BoundUnaryOperator::Kind::Decrement)
+            {
+                auto place = resolvePlace(expression->getOperand());
+                auto current = load(place);
+                auto value = emit(operator_kind == BoundUnaryOperator::Kind::Increment? OpCode::Add: OpCode::Subtract, place.kind,
+                    {current, constant(place.kind, 1ul)});
+                store(place, value);
+                return value;
+            }
+
+            scalarKind(expression->getOperand()->getType());
+            auto kind = scalarKind(expression->getType());
+            auto operand = compileExpression(expression->getOperand());
+
+            switch(operator_kind)
+            {
+            case BoundUnaryOperator::Kind::UnaryPlus: return convert(operand, kind);
+            case BoundUnaryOperator::Kind::UnaryMinus: return emit(OpCode::Negate, kind, {operand});
+            case BoundUnaryOperator::Kind::LogicalNot: return emit(OpCode::LogicalNot, kind, {operand});
+            case BoundUnaryOperator::Kind::BitwiseNot: return emit(OpCode::BitwiseNot, kind, {operand});
+            default: throw Unsupported{"unsupported unary operator"};
+            }
+        }
+
+        static std::optional<OpCode> binaryOpCode(BoundBinaryOperator::Kind kind)
+        {
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::Addition:
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+                return OpCode::Add;
+            case BoundBinaryOperator::Kind::Subtraction:
+            case BoundBinaryOperator::Kind::SubtractionAssignment:
+                return OpCode::Subtract;
+            case BoundBinaryOperator::Kind::Multiplication:
+            case BoundBinaryOperator::Kind::MultiplicationAssignment:
+                return OpCode::Multiply;
+            case BoundBinaryOperator::Kind::Division:
+            case BoundBinaryOperator::Kind::DivisionAssignment:
+                return OpCode::Divide;
+            case BoundBinaryOperator::Kind::Modulo:
+            case BoundBinaryOperator::Kind::ModuloAssignment:
+                return OpCode::Modulo;
+            case BoundBinaryOperator::Kind::Equals: return OpCode::Equals;
+            case BoundBinaryOperator::Kind::NotEquals: return OpCode::NotEquals;
+            case BoundBinaryOperator::Kind::Greater: return OpCode::Greater;
+            case BoundBinaryOperator::Kind::Less: return OpCode::Less;
+            case BoundBinaryOperator::Kind::GreaterEqual: return OpCode::GreaterEqual;
+            case BoundBinaryOperator::Kind::LessEqual: return OpCode::LessEqual;
+            case BoundBinaryOperator::Kind::BitwiseAnd: return OpCode::BitwiseAnd;
+            case BoundBinaryOperator::Kind::BitwiseOr: return OpCode::BitwiseOr;
+            case BoundBinaryOperator::Kind::BitwiseXor: return OpCode::BitwiseXor;
+            case BoundBinaryOperator::Kind::BitwiseShiftLeft: return OpCode::ShiftLeft;
+            case BoundBinaryOperator::Kind::BitwiseShiftRight: return OpCode::ShiftRight;
+            default: return std::nullopt;
+            }
+        }
+
+        static inline bool isCompoundAssignment(BoundBinaryOperator::Kind kind)
+        {
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+            case BoundBinaryOperator::Kind::SubtractionAssignment:
+            case BoundBinaryOperator::Kind::MultiplicationAssignment:
+            case BoundBinaryOperator::Kind::DivisionAssignment:
+            case BoundBinaryOperator::Kind::ModuloAssignment:
+                return true;
+            default: return false;
+            }
+        }
+
+        Value compileBinaryExpression(const BoundBinaryExpression* expression)
+        {
+            auto operator_kind = expression->getOperator()->getKind();
+            scalarKind(expression->getLeft()->getType());
+            scalarKind(expression->getRight()->getType());
+            auto kind = scalarKind(expression->getType());
+
+            if(operator_kind == BoundBinaryOperator::Kind::LogicalAnd || operator_kind == BoundBinaryOperator::Kind::LogicalOr)
+            {
+                auto is_and = operator_kind == BoundBinaryOperator::Kind::LogicalAnd;
+                auto slot = allocate(Types::Kind::_bool);
+                emit(OpCode::Store, Types::Kind::_void, {slot, constant(Types::Kind::_bool, is_and? 0ul: 1ul)});
+
+                auto left = convert(compileExpression(expression->getLeft()), Types::Kind::_bool);
+                auto right_block = m_function->appendBlock(), end_block = m_function->appendBlock();
+                branch(left, is_and? right_block: end_block, is_and? end_block: right_block);
+
+                m_block = right_block;
+                emit(OpCode::Store, Types::Kind::_void, {slot, convert(compileExpression(expression->getRight()), Types::Kind::_bool)});
+                jump(end_block);
+
+                m_block = end_block;
+                return emit(OpCode::Load, Types::Kind::_bool, {slot});
+            }
+            else if(operator_kind == BoundBinaryOperator::Kind::Assignment)
+            {
+                auto place = resolvePlace(expression->getLeft());
+                auto value = convert(compileExpression(expression->getRight()), place.kind);
+                store(place, value);
+                return convert(value, kind);
+            }
+
+            auto code = binaryOpCode(operator_kind);
+            if(!code)
+                throw Unsupported{"unsupported binary operator"};
+
+            if(isCompoundAssignment(operator_kind))
+            {
+                auto place = resolvePlace(expression->getLeft());
+                auto current = load(place);
+                auto value = emit(*code, place.kind, {current, convert(compileExpression(expression->getRight()), place.kind)});
+                store(place, value);
+                return convert(value, kind);
+            }
+
+            auto left = compileExpression(expression->getLeft());
+            auto right = compileExpression(expression->getRight());
+            return emit(*code, kind, {left, right});
+        }
+
+        IR::Module m_module;
+        IR::Function* m_function{};
+        Block m_block{};
+        std::unordered_map<const BoundFunctionDeclaration*, std::size_t> m_functionIndices;
+        std::unordered_map<std::string, const BoundFunctionDeclaration*> m_functionDeclarations;
+        std::unordered_map<std::string, Types::Kind> m_globals;
+        std::vector<std::unordered_map<std::string, Value>> m_scopes;
+        std::vector<Loop> m_loops;
+        std::vector<std::pair<std::string, std::string>> m_unsupportedReasons;
+    };
+}
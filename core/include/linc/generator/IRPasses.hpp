@@ -0,0 +1,727 @@
+#pragma once
+#include <linc/generator/IR.hpp>
+#include <linc/Include.hpp>
+#include <algorithm>
+#include <map>
+
+namespace linc
+{
+    /// @brief A transformation of the functions of an IR::Module, run by the IRPassManager.
+    class IRPass
+    {
+    public:
+        virtual ~IRPass() = default;
+        [[nodiscard]] virtual std::string getName() const = 0;
+
+        /// @brief Transform a function.
+        /// @return The number of changes made to the function (instructions or blocks simplified, removed or moved).
+        virtual std::size_t run(IR::Function& function) = 0;
+    };
+
+    /// @brief Runs a pipeline of passes over every function of a module, in the order they were added in.
+    class IRPassManager final
+    {
+    public:
+        template <typename Pass, typename... Args>
+        IRPassManager& add(Args&&... args)
+        {
+            m_passes.push_back(std::make_unique<Pass>(std::forward<Args>(args)...));
+            m_changes.push_back(0ul);
+            return *this;
+        }
+
+        void run(IR::Module& module)
+        {
+            for(auto& function: module.functions)
+                for(std::size_t i{0ul}; i < m_passes.size(); ++i)
+                    m_changes[i] += m_passes[i]->run(function);
+        }
+
+        /// @brief The name of every pass of the pipeline along with the changes it made, summed over every function it was run on.
+        [[nodiscard]] std::vector<std::pair<std::string, std::size_t>> getStatistics() const
+        {
+            std::vector<std::pair<std::string, std::size_t>> statistics;
+            for(std::size_t i{0ul}; i < m_passes.size(); ++i)
+                statistics.emplace_back(m_passes[i]->getName(), m_changes[i]);
+
+            return statistics;
+        }
+
+        /// @brief Build the pipeline run before instruction selection. Without optimization, only the passes needed to get
+        /// code in SSA form are run.
+        static IRPassManager makePipeline(bool optimization);
+    private:
+        std::vector<std::unique_ptr<IRPass>> m_passes;
+        std::vector<std::size_t> m_changes;
+    };
+
+    /// @brief Folds branches and switches on constant conditions, removes unreachable blocks and merges blocks into their single
+    /// predecessor.
+    class SimplifyControlFlow final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "simplify-control-flow"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            using OpCode = IR::OpCode;
+            std::size_t changes{0ul};
+
+            for(IR::Block block{0u}; block < function.blocks.size(); ++block)
+            {
+                if(function.blocks[block].instructions.empty())
+                    continue;
+
+                auto& terminator = function.values[function.blocks[block].instructions.back()];
+                if(terminator.code == OpCode::Switch && function.values[terminator.operands[0ul]].code == OpCode::Constant)
+                {
+                    auto index = function.values[terminator.operands[0ul]].immediate - terminator.immediate;
+                    auto taken = index < terminator.cases.size()? terminator.cases[index]: terminator.targets[0ul];
+
+                    for(auto successor: function.getSuccessors(block))
+                        if(successor != taken)
+                            function.removeEdge(block, successor);
+
+                    terminator = IR::Instruction{.code = OpCode::Jump, .targets = {taken, 0u}};
+                    ++changes;
+                    continue;
+                }
+                else if(terminator.code != OpCode::Branch)
+                    continue;
+
+                const auto& condition = function.values[terminator.operands[0ul]];
+                if(condition.code != OpCode::Constant && terminator.targets[0ul] != terminator.targets[1ul])
+                    continue;
+
+                auto taken = condition.code != OpCode::Constant || condition.immediate != 0ul? terminator.targets[0ul]: terminator.targets[1ul];
+                auto other = taken == terminator.targets[0ul]? terminator.targets[1ul]: terminator.targets[0ul];
+
+                terminator = IR::Instruction{.code = OpCode::Jump, .targets = {taken, 0u}};
+                function.removeEdge(block, other);
+                ++changes;
+            }
+
+            changes += removeUnreachable(function);
+
+            for(IR::Block block{0u}; block < function.blocks.size(); ++block)
+                while(mergeSuccessor(function, block))
+                    ++changes;
+
+            return changes;
+        }
+
+        /// @brief Remove the blocks that cannot be reached from the entry block, leaving them empty.
+        static std::size_t removeUnreachable(IR::Function& function)
+        {
+            std::vector<bool> reachable(function.blocks.size(), false);
+            std::vector<IR::Block> stack{0u};
+            reachable[0ul] = true;
+
+            while(!stack.empty())
+            {
+                auto block = stack.back();
+                stack.pop_back();
+
+                for(auto successor: function.getSuccessors(block))
+                    if(!reachable[successor])
+                    {
+                        reachable[successor] = true;
+                        stack.push_back(successor);
+                    }
+            }
+
+            std::size_t changes{0ul};
+            for(IR::Block block{0u}; block < function.blocks.size(); ++block)
+            {
+                if(reachable[block] || function.blocks[block].instructions.empty())
+                    continue;
+
+                for(auto successor: function.getSuccessors(block))
+                    function.removeEdge(block, successor);
+
+                function.blocks[block].instructions.clear();
+                function.blocks[block].predecessors.clear();
+                ++changes;
+            }
+
+            return changes;
+        }
+    private:
+        /// @brief Merge the successor of a block ending with a jump into it, if the block is its only predecessor.
+        static bool mergeSuccessor(IR::Function& function, IR::Block block)
+        {
+            auto terminator = function.getTerminator(block);
+            if(!terminator || terminator->code != IR::OpCode::Jump)
+                return false;
+
+            auto successor = terminator->targets[0ul];
+            if(successor == block || successor == 0u || function.blocks[successor].predecessors.size() != 1ul)
+                return false;
+
+            // phi nodes of a block with a single predecessor simply forward their operand
+            std::vector<IR::Value> replacements(function.values.size(), IR::none);
+            auto& instructions = function.blocks[successor].instructions;
+
+            while(!instructions.empty() && function.values[instructions.front()].code == IR::OpCode::Phi)
+            {
+                replacements[instructions.front()] = function.values[instructions.front()].operands[0ul];
+                instructions.erase(instructions.begin());
+            }
+            function.replaceUses(replacements);
+
+            auto& merged = function.blocks[block].instructions;
+            merged.pop_back();
+            merged.insert(merged.end(), instructions.begin(), instructions.end());
+            instructions.clear();
+            function.blocks[successor].predecessors.clear();
+
+            for(auto next: function.getSuccessors(block))
+                std::ranges::replace(function.blocks[next].predecessors, successor, block);
+
+            return true;
+        }
+    };
+
+    /// @brief Promotes the stack slots of variables to SSA values, placing phi nodes on the iterated dominance frontier of the blocks
+    /// storing to them and renaming their loads over the dominator tree. Trivial phi nodes (merging a single value) are then removed.
+    class PromoteMemory final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "promote-memory"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            using OpCode = IR::OpCode;
+            std::vector<IR::Value> slots;
+            std::vector<std::uint32_t> slot_indices(function.values.size(), s_notPromoted);
+
+            for(auto value: function.blocks[0ul].instructions)
+                if(function.values[value].code == OpCode::Allocate)
+                {
+                    slot_indices[value] = static_cast<std::uint32_t>(slots.size());
+                    slots.push_back(value);
+                }
+
+            if(slots.empty())
+                return 0ul;
+
+            auto dominance = IR::computeDominance(function);
+            auto frontiers = IR::computeFrontiers(function, dominance);
+
+            // the blocks in which a phi node was placed for every slot, mapping the phi nodes back to their slot
+            std::vector<std::vector<bool>> has_phi(slots.size(), std::vector<bool>(function.blocks.size(), false));
+            std::vector<std::uint32_t> phi_slots;
+
+            for(std::uint32_t slot{0u}; slot < slots.size(); ++slot)
+            {
+                std::vector<IR::Block> worklist;
+                for(auto block: dominance.order)
+                    for(auto value: function.blocks[block].instructions)
+                        if(const auto& instruction = function.values[value]; instruction.code == OpCode::Store && instruction.operands[0ul] == slots[slot])
+                        {
+                            worklist.push_back(block);
+                            break;
+                        }
+
+                while(!worklist.empty())
+                {
+                    auto block = worklist.back();
+                    worklist.pop_back();
+
+                    for(auto frontier: frontiers[block])
+                    {
+                        if(has_phi[slot][frontier])
+                            continue;
+
+                        has_phi[slot][frontier] = true;
+                        function.values.push_back(IR::Instruction{
+                            .code = OpCode::Phi,
+                            .kind = function.values[slots[slot]].kind,
+                            .operands = std::vector<IR::Value>(function.blocks[frontier].predecessors.size(), IR::none)
+                        });
+
+                        auto& instructions = function.blocks[frontier].instructions;
+                        instructions.insert(instructions.begin(), static_cast<IR::Value>(function.values.size() - 1ul));
+                        phi_slots.resize(function.values.size(), s_notPromoted);
+                        phi_slots.back() = slot;
+                        worklist.push_back(frontier);
+                    }
+                }
+            }
+
+            // variables are always initialized when declared, so only phi nodes merging paths where they are not declared read this
+            std::vector<IR::Value> undefined(slots.size());
+            auto& entry = function.blocks[0ul].instructions;
+            for(std::uint32_t slot{0u}; slot < slots.size(); ++slot)
+            {
+                function.values.push_back(IR::Instruction{.code = OpCode::Constant, .kind = function.values[slots[slot]].kind});
+                undefined[slot] = static_cast<IR::Value>(function.values.size() - 1ul);
+                entry.insert(entry.begin(), undefined[slot]);
+            }
+
+            phi_slots.resize(function.values.size(), s_notPromoted);
+            slot_indices.resize(function.values.size(), s_notPromoted);
+
+            std::vector<IR::Value> replacements(function.values.size(), IR::none);
+            std::vector<std::vector<IR::Value>> stacks(slots.size());
+            for(std::uint32_t slot{0u}; slot < slots.size(); ++slot)
+                stacks[slot].push_back(undefined[slot]);
+
+            rename(function, dominance, 0u, slot_indices, phi_slots, stacks, replacements);
+
+            std::size_t changes{0ul};
+            function.replaceUses(replacements);
+            function.removeInstructions([&](IR::Value value)
+            {
+                const auto& instruction = function.values[value];
+                auto promoted = (instruction.code == OpCode::Allocate && slot_indices[value] != s_notPromoted)
+                    || ((instruction.code == OpCode::Load || instruction.code == OpCode::Store) && slot_indices[instruction.operands[0ul]] != s_notPromoted);
+
+                changes += promoted? 1ul: 0ul;
+                return promoted;
+            });
+
+            return changes + removeTrivialPhis(function);
+        }
+
+        /// @brief Remove the phi nodes that only merge a single value (besides themselves), along with those whose value is never
+        /// used by anything else than other phi nodes.
+        static std::size_t removeTrivialPhis(IR::Function& function)
+        {
+            using OpCode = IR::OpCode;
+            std::size_t changes{0ul};
+            std::vector<IR::Value> replacements(function.values.size(), IR::none);
+
+            auto resolve = [&](IR::Value value)
+            {
+                while(replacements[value] != IR::none)
+                    value = replacements[value];
+                return value;
+            };
+
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+
+                for(const auto& block: function.blocks)
+                    for(auto value: block.instructions)
+                    {
+                        const auto& instruction = function.values[value];
+                        if(instruction.code != OpCode::Phi)
+                            break;
+                        else if(replacements[value] != IR::none)
+                            continue;
+
+                        auto unique = IR::none;
+                        auto trivial = std::ranges::all_of(instruction.operands, [&](IR::Value operand)
+                        {
+                            operand = resolve(operand);
+                            if(operand == value || operand == unique)
+                                return true;
+                            else if(unique != IR::none)
+                                return false;
+
+                            unique = operand;
+                            return true;
+                        });
+
+                        if(trivial && unique != IR::none)
+                        {
+                            replacements[value] = unique;
+                            changed = true;
+                            ++changes;
+                        }
+                    }
+            }
+
+            function.replaceUses(replacements);
+
+            // phi nodes are live if they are used by another instruction, or by a live phi node
+            std::vector<bool> live(function.values.size(), false);
+            std::vector<IR::Value> worklist;
+
+            for(const auto& block: function.blocks)
+                for(auto value: block.instructions)
+                    if(function.values[value].code != OpCode::Phi && replacements[value] == IR::none)
+                        for(auto operand: function.values[value].operands)
+                            if(function.values[operand].code == OpCode::Phi && !live[operand])
+                            {
+                                live[operand] = true;
+                                worklist.push_back(operand);
+                            }
+
+            while(!worklist.empty())
+            {
+                auto value = worklist.back();
+                worklist.pop_back();
+
+                for(auto operand: function.values[value].operands)
+                    if(function.values[operand].code == OpCode::Phi && !live[operand])
+                    {
+                        live[operand] = true;
+                        worklist.push_back(operand);
+                    }
+            }
+
+            function.removeInstructions([&](IR::Value value)
+            {
+                if(function.values[value].code != OpCode::Phi || (live[value] && replacements[value] == IR::none))
+                    return false;
+
+                changes += replacements[value] == IR::none? 1ul: 0ul;
+                return true;
+            });
+
+            return changes;
+        }
+    private:
+        static constexpr std::uint32_t s_notPromoted{std::numeric_limits<std::uint32_t>::max()};
+
+        static void rename(IR::Function& function, const IR::Dominance& dominance, IR::Block block, const std::vector<std::uint32_t>& slot_indices,
+            const std::vector<std::uint32_t>& phi_slots, std::vector<std::vector<IR::Value>>& stacks, std::vector<IR::Value>& replacements)
+        {
+            using OpCode = IR::OpCode;
+            std::vector<std::uint32_t> pushed;
+
+            for(auto value: function.blocks[block].instructions)
+            {
+                const auto& instruction = function.values[value];
+
+                if(instruction.code == OpCode::Phi && phi_slots[value] != s_notPromoted)
+                {
+                    stacks[phi_slots[value]].push_back(value);
+                    pushed.push_back(phi_slots[value]);
+                }
+                else if(instruction.code == OpCode::Load && slot_indices[instruction.operands[0ul]] != s_notPromoted)
+                    replacements[value] = stacks[slot_indices[instruction.operands[0ul]]].back();
+                else if(instruction.code == OpCode::Store && slot_indices[instruction.operands[0ul]] != s_notPromoted)
+                {
+                    auto slot = slot_indices[instruction.operands[0ul]];
+                    stacks[slot].push_back(instruction.operands[1ul]);
+                    pushed.push_back(slot);
+                }
+            }
+
+            auto successors = function.getSuccessors(block);
+            std::ranges::sort(successors);
+            successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+
+            for(auto successor: successors)
+            {
+                const auto& predecessors = function.blocks[successor].predecessors;
+
+                for(auto value: function.blocks[successor].instructions)
+                {
+                    auto& instruction = function.values[value];
+                    if(instruction.code != OpCode::Phi)
+                        break;
+                    else if(phi_slots[value] == s_notPromoted)
+                        continue;
+
+                    for(std::size_t i{0ul}; i < predecessors.size(); ++i)
+                        if(predecessors[i] == block)
+                            instruction.operands[i] = stacks[phi_slots[value]].back();
+                }
+            }
+
+            for(auto child: dominance.children[block])
+                rename(function, dominance, child, slot_indices, phi_slots, stacks, replacements);
+
+            for(auto slot: pushed)
+                stacks[slot].pop_back();
+        }
+    };
+
+    /// @brief Folds pure instructions whose operands are all constant, along with phi nodes merging a single constant.
+    class PropagateConstants final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "propagate-constants"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            using OpCode = IR::OpCode;
+            auto dominance = IR::computeDominance(function);
+            std::size_t changes{0ul};
+
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+
+                for(auto block: dominance.order)
+                    for(auto value: function.blocks[block].instructions)
+                    {
+                        auto& instruction = function.values[value];
+                        if(instruction.code == OpCode::Constant || instruction.operands.empty())
+                            continue;
+
+                        std::vector<Types::u64> operands;
+                        for(auto operand: instruction.operands)
+                            if(function.values[operand].code == OpCode::Constant)
+                                operands.push_back(function.values[operand].immediate);
+                            else break;
+
+                        if(operands.size() != instruction.operands.size())
+                            continue;
+
+                        std::optional<Types::u64> result;
+                        if(instruction.code == OpCode::Phi)
+                        {
+                            if(std::ranges::all_of(operands, [&](Types::u64 operand){ return operand == operands.front(); }))
+                                result = operands.front();
+                        }
+                        else if(IR::isPure(instruction.code))
+                            result = IR::evaluate(instruction, function.values[instruction.operands[0ul]].kind, operands);
+
+                        if(!result)
+                            continue;
+
+                        instruction = IR::Instruction{.code = OpCode::Constant, .kind = instruction.kind, .immediate = *result};
+                        changed = true;
+                        ++changes;
+                    }
+            }
+
+            // constant phi nodes are now constants themselves, and must follow the remaining phi nodes of their block
+            for(auto& block: function.blocks)
+                std::ranges::stable_partition(block.instructions, [&](IR::Value value){ return function.values[value].code == OpCode::Phi; });
+
+            return changes + PromoteMemory::removeTrivialPhis(function);
+        }
+    };
+
+    /// @brief Removes the instructions whose value is never used and that have no side effects.
+    class EliminateDeadCode final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "eliminate-dead-code"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            std::vector<bool> live(function.values.size(), false);
+            std::vector<IR::Value> worklist;
+
+            for(const auto& block: function.blocks)
+                for(auto value: block.instructions)
+                    if(IR::hasSideEffects(function.values[value].code))
+                    {
+                        live[value] = true;
+                        worklist.push_back(value);
+                    }
+
+            while(!worklist.empty())
+            {
+                auto value = worklist.back();
+                worklist.pop_back();
+
+                for(auto operand: function.values[value].operands)
+                    if(!live[operand])
+                    {
+                        live[operand] = true;
+                        worklist.push_back(operand);
+                    }
+            }
+
+            std::size_t changes{0ul};
+            function.removeInstructions([&](IR::Value value)
+            {
+                changes += live[value]? 0ul: 1ul;
+                return !live[value];
+            });
+
+            return changes;
+        }
+    };
+
+    /// @brief Global value numbering: replaces pure instructions by an identical instruction dominating them, if any.
+    class NumberValues final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "number-values"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            auto dominance = IR::computeDominance(function);
+            std::vector<IR::Value> replacements(function.values.size(), IR::none);
+            std::map<Key, IR::Value> table;
+
+            number(function, dominance, 0u, table, replacements);
+
+            std::size_t changes{0ul};
+            function.replaceUses(replacements);
+            function.removeInstructions([&](IR::Value value)
+            {
+                changes += replacements[value] != IR::none? 1ul: 0ul;
+                return replacements[value] != IR::none;
+            });
+
+            return changes;
+        }
+    private:
+        using Key = std::tuple<IR::OpCode, Types::Kind, std::vector<IR::Value>, Types::u64>;
+
+        static void number(IR::Function& function, const IR::Dominance& dominance, IR::Block block, std::map<Key, IR::Value>& table,
+            std::vector<IR::Value>& replacements)
+        {
+            std::vector<Key> inserted;
+
+            for(auto value: function.blocks[block].instructions)
+            {
+                const auto& instruction = function.values[value];
+                if(!IR::isPure(instruction.code))
+                    continue;
+
+                std::vector<IR::Value> operands;
+                for(auto operand: instruction.operands)
+                    operands.push_back(replacements[operand] != IR::none? replacements[operand]: operand);
+
+                if(IR::isCommutative(instruction.code))
+                    std::ranges::sort(operands);
+
+                Key key{instruction.code, instruction.kind, std::move(operands), instruction.immediate};
+
+                if(auto find = table.find(key); find != table.end())
+                    replacements[value] = find->second;
+                else
+                {
+                    table.emplace(key, value);
+                    inserted.push_back(std::move(key));
+                }
+            }
+
+            for(auto child: dominance.children[block])
+                number(function, dominance, child, table, replacements);
+
+            for(const auto& key: inserted)
+                table.erase(key);
+        }
+    };
+
+    /// @brief Loop-invariant code motion: hoists pure instructions that cannot trap and whose operands are all defined outside of a
+    /// loop to the loop's preheader, the single block entering it. Inner loops are processed first, so that invariants may then be
+    /// hoisted out of their enclosing loops.
+    class HoistLoopInvariants final : public IRPass
+    {
+    public:
+        [[nodiscard]] virtual std::string getName() const final override { return "hoist-loop-invariants"; }
+
+        virtual std::size_t run(IR::Function& function) final override
+        {
+            auto dominance = IR::computeDominance(function);
+            std::map<IR::Block, std::vector<bool>> loops;
+
+            // every back edge (to a block dominating its source) closes a natural loop, whose blocks reach the edge without
+            // going through the loop's header
+            for(auto block: dominance.order)
+                for(auto successor: function.getSuccessors(block))
+                {
+                    if(!dominance.dominates(successor, block))
+                        continue;
+
+                    auto [find, inserted] = loops.try_emplace(successor, std::vector<bool>(function.blocks.size(), false));
+                    auto& body = find->second;
+                    body[successor] = true;
+                    std::vector<IR::Block> stack;
+
+                    if(!body[block])
+                    {
+                        body[block] = true;
+                        stack.push_back(block);
+                    }
+
+                    while(!stack.empty())
+                    {
+                        auto current = stack.back();
+                        stack.pop_back();
+
+                        for(auto predecessor: function.blocks[current].predecessors)
+                            if(!body[predecessor] && dominance.isReachable(predecessor))
+                            {
+                                body[predecessor] = true;
+                                stack.push_back(predecessor);
+                            }
+                    }
+                }
+
+            std::vector<std::pair<IR::Block, const std::vector<bool>*>> order;
+            for(const auto& [header, body]: loops)
+                order.emplace_back(header, &body);
+
+            std::ranges::sort(order, {}, [](const auto& loop){ return std::ranges::count(*loop.second, true); });
+
+            std::vector<IR::Block> definitions(function.values.size(), IR::none);
+            for(IR::Block block{0u}; block < function.blocks.size(); ++block)
+                for(auto value: function.blocks[block].instructions)
+                    definitions[value] = block;
+
+            std::size_t changes{0ul};
+            for(const auto& [header, body]: order)
+                changes += hoist(function, dominance, header, *body, definitions);
+
+            return changes;
+        }
+    private:
+        static std::size_t hoist(IR::Function& function, const IR::Dominance& dominance, IR::Block header, const std::vector<bool>& body,
+            std::vector<IR::Block>& definitions)
+        {
+            auto preheader = IR::none;
+            for(auto predecessor: function.blocks[header].predecessors)
+                if(!body[predecessor])
+                {
+                    if(preheader != IR::none && preheader != predecessor)
+                        return 0ul;
+                    preheader = predecessor;
+                }
+
+            if(preheader == IR::none || function.getSuccessors(preheader).size() != 1ul)
+                return 0ul;
+
+            std::size_t changes{0ul};
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+
+                for(auto block: dominance.order)
+                {
+                    if(!body[block])
+                        continue;
+
+                    std::erase_if(function.blocks[block].instructions, [&](IR::Value value)
+                    {
+                        const auto& instruction = function.values[value];
+                        if(!isHoistable(instruction.code) || std::ranges::any_of(instruction.operands, [&](IR::Value operand)
+                        {
+                            return definitions[operand] == IR::none || body[definitions[operand]];
+                        })) return false;
+
+                        auto& instructions = function.blocks[preheader].instructions;
+                        instructions.insert(instructions.end() - 1, value);
+                        definitions[value] = preheader;
+                        changed = true;
+                        ++changes;
+                        return true;
+                    });
+                }
+            }
+
+            return changes;
+        }
+
+        [[nodiscard]] static bool isHoistable(IR::OpCode code)
+        {
+            return IR::isPure(code) && code != IR::OpCode::Divide && code != IR::OpCode::Modulo;
+        }
+    };
+
+    inline IRPassManager IRPassManager::makePipeline(bool optimization)
+    {
+        IRPassManager manager;
+        manager.add<SimplifyControlFlow>().add<PromoteMemory>().add<SimplifyControlFlow>();
+
+        if(optimization)
+            manager.add<PropagateConstants>().add<SimplifyControlFlow>().add<NumberValues>().add<HoistLoopInvariants>()
+                .add<EliminateDeadCode>().add<PropagateConstants>().add<SimplifyControlFlow>();
+
+        return manager;
+    }
+}
@@ -0,0 +1,1247 @@
+#pragma once
+#include <linc/generator/EmitterAMD64.hpp>
+#include <linc/generator/Registers.hpp>
+#include <linc/generator/IR.hpp>
+#include <linc/Include.hpp>
+#include <functional>
+
+namespace linc
+{
+    /// @brief Lowers functions of the intermediate representation to AMD64 assembly. Values are assigned to registers by linear
+    /// scan over live intervals computed from the control flow graph, and spilled to stack slots when the registers run out.
+    /// Values of kinds narrower than 64 bits are operated on as 32-bit values, kept sign or zero-extended to 32 bits.
+    class InstructionSelectorAMD64 final
+    {
+    public:
+        using Value = IR::Value;
+        using Block = IR::Block;
+        using OpCode = IR::OpCode;
+        using Size = Registers::Size;
+        using UnaryInstruction = EmitterAMD64::UnaryInstruction;
+        using BinaryInstruction = EmitterAMD64::BinaryInstruction;
+        using NullaryInstruction = EmitterAMD64::NullaryInstruction;
+        using Operand = EmitterAMD64::Operand;
+
+        /// @brief Maps the name of a global variable to the label of its storage.
+        using GlobalResolver = std::function<std::string(const std::string&)>;
+
+        InstructionSelectorAMD64(EmitterAMD64& emitter, const IR::Module& module, GlobalResolver resolve_global)
+            :m_emitter(emitter), m_module(module), m_resolveGlobal(std::move(resolve_global))
+        {}
+
+        void select(IR::Function function)
+        {
+            m_function = std::move(function);
+            splitCriticalEdges();
+
+            m_layout = IR::computeDominance(m_function).order;
+            countUses();
+            fuseComparisons();
+            number();
+            computeIntervals();
+            allocate();
+
+            const auto name = m_function.isEntryPoint? std::string{"_start"}: m_function.name;
+            m_emitter.global(name);
+            m_emitter.label(name);
+
+            m_isFramed = m_spillCount != 0u;
+            if(m_isFramed)
+            {
+                m_emitter.prologue();
+                m_emitter.binary(BinaryInstruction::Subtract, getRegister(LINC_REGISTERS_STACK, Size::QuadWord), EmitterAMD64::getImmediate(8l * m_spillCount));
+            }
+
+            moveArguments();
+            forwardJumps();
+
+            std::vector<Block> blocks;
+            for(auto block: m_layout)
+                if(block == m_layout.front() || m_forwards[block] == IR::none)
+                    blocks.push_back(block);
+
+            for(std::size_t index{0ul}; index < blocks.size(); ++index)
+            {
+                auto block = blocks[index];
+                m_next = index + 1ul < blocks.size()? blocks[index + 1ul]: IR::none;
+
+                if(index != 0ul || !m_function.blocks[block].predecessors.empty())
+                    m_emitter.label(m_labels[block]);
+
+                for(auto value: m_function.blocks[block].instructions)
+                    generate(value, block);
+            }
+        }
+    private:
+        struct Location final
+        {
+            enum class Kind: unsigned char
+            {
+                None, Register, Stack, Constant
+            };
+
+            Kind kind{Kind::None};
+            std::uint8_t order{};
+            std::uint32_t slot{};
+            Types::u64 constant{};
+
+            [[nodiscard]] bool operator==(const Location& other) const
+            {
+                return kind == other.kind && (kind == Kind::Register? order == other.order: kind == Kind::Stack? slot == other.slot:
+                    kind == Kind::Constant? constant == other.constant: true);
+            }
+        };
+
+        struct Interval final
+        {
+            std::uint32_t start{}, end{};
+        };
+
+        struct Move final
+        {
+            Location destination, source;
+        };
+
+        static constexpr std::uint8_t s_accumulator{LINC_REGISTERS_A}, s_count{LINC_REGISTERS_C}, s_remainder{LINC_REGISTERS_D};
+
+        /// @brief The registers values are allocated to, in order of preference. The accumulator, count and remainder registers
+        /// are left out as scratch registers for division, shifts, calls and parallel moves.
+        static constexpr std::array<std::uint8_t, 6ul> s_pool{10u, 11u, 8u, 9u, LINC_REGISTERS_SOURCE, LINC_REGISTERS_DEST};
+        static constexpr std::array<std::uint8_t, 6ul> s_arguments{LINC_REGISTERS_DEST, LINC_REGISTERS_SOURCE, LINC_REGISTERS_D,
+            LINC_REGISTERS_C, 8u, 9u};
+
+        [[nodiscard]] inline const IR::Instruction& at(Value value) const { return m_function.values[value]; }
+
+        [[nodiscard]] static bool isWide(Types::Kind kind)
+        {
+            return kind == Types::Kind::i64 || kind == Types::Kind::u64;
+        }
+
+        /// @brief The size of the registers a value of the specified kind is operated on in.
+        [[nodiscard]] static Size getOperationSize(Types::Kind kind)
+        {
+            return isWide(kind)? Size::QuadWord: Size::DoubleWord;
+        }
+
+        /// @brief The size of the storage of a global variable of the specified kind.
+        [[nodiscard]] static Size getStorageSize(Types::Kind kind)
+        {
+            switch(kind)
+            {
+            case Types::Kind::u8:
+            case Types::Kind::i8:
+            case Types::Kind::_bool:
+            case Types::Kind::_char:
+                return Size::Byte;
+            case Types::Kind::u16:
+            case Types::Kind::i16:
+                return Size::Word;
+            case Types::Kind::u32:
+            case Types::Kind::i32:
+                return Size::DoubleWord;
+            default: return Size::QuadWord;
+            }
+        }
+
+        [[nodiscard]] static Operand getRegister(std::uint8_t order, Size size)
+        {
+            return EmitterAMD64::getRegister(order, size);
+        }
+
+        [[nodiscard]] static Operand getSlot(std::uint32_t slot, Size size)
+        {
+            return EmitterAMD64::getMemory(LINC_REGISTERS_BASE, -8l * (slot + 1l), size);
+        }
+
+        [[nodiscard]] static Operand getImmediate(Types::u64 value, Size size)
+        {
+            return EmitterAMD64::getImmediate(size == Size::QuadWord? static_cast<Types::i64>(value):
+                static_cast<Types::i32>(static_cast<Types::u32>(value)));
+        }
+
+        /// @brief Whether a constant can be encoded as the (sign-extended 32-bit) immediate operand of an instruction.
+        [[nodiscard]] static bool isEncodable(Types::u64 value, Size size)
+        {
+            return size != Size::QuadWord || static_cast<Types::i64>(value) == static_cast<Types::i32>(value);
+        }
+
+        [[nodiscard]] Location locate(Value value) const
+        {
+            if(const auto& instruction = at(value); instruction.code == OpCode::Constant)
+                return Location{.kind = Location::Kind::Constant, .constant = instruction.immediate};
+
+            return m_locations[value];
+        }
+
+        [[nodiscard]] bool isIn(Value value, std::uint8_t order) const
+        {
+            auto location = locate(value);
+            return location.kind == Location::Kind::Register && location.order == order;
+        }
+
+        /// @brief Get the register a value should be computed in: its own, or the accumulator if it lives on the stack.
+        [[nodiscard]] std::uint8_t getTarget(Value value) const
+        {
+            auto location = locate(value);
+            return location.kind == Location::Kind::Register? location.order: s_accumulator;
+        }
+
+        /// @brief Get a register, memory or immediate operand holding a value, using a scratch register for large constants.
+        Operand getOperand(Value value, Size size, std::uint8_t scratch)
+        {
+            switch(auto location = locate(value); location.kind)
+            {
+            case Location::Kind::Register: return getRegister(location.order, size);
+            case Location::Kind::Stack: return getSlot(location.slot, size);
+            case Location::Kind::Constant:
+                if(isEncodable(location.constant, size))
+                    return getImmediate(location.constant, size);
+
+                m_emitter.binary(BinaryInstruction::Move, getRegister(scratch, size), getImmediate(location.constant, size));
+                return getRegister(scratch, size);
+            default: throw LINC_EXCEPTION_ILLEGAL_STATE(location.kind);
+            }
+        }
+
+        /// @brief Get a register holding a value, loading it into the scratch register unless it already lives in one.
+        Operand getRegisterOperand(Value value, Size size, std::uint8_t scratch)
+        {
+            if(auto location = locate(value); location.kind == Location::Kind::Register)
+                return getRegister(location.order, size);
+
+            moveTo(scratch, value, size);
+            return getRegister(scratch, size);
+        }
+
+        void moveTo(std::uint8_t order, Value value, Size size)
+        {
+            if(isIn(value, order))
+                return;
+
+            auto location = locate(value);
+            m_emitter.binary(BinaryInstruction::Move, getRegister(order, size), location.kind == Location::Kind::Constant?
+                getImmediate(location.constant, size): getOperand(value, size, order));
+        }
+
+        /// @brief Move a value computed in a register to its location.
+        void commit(Value value, std::uint8_t order)
+        {
+            switch(auto location = locate(value); location.kind)
+            {
+            case Location::Kind::Register:
+                if(location.order != order)
+                    m_emitter.binary(BinaryInstruction::Move, getRegister(location.order, Size::QuadWord), getRegister(order, Size::QuadWord));
+                break;
+            case Location::Kind::Stack:
+                m_emitter.binary(BinaryInstruction::Move, getSlot(location.slot, Size::QuadWord), getRegister(order, Size::QuadWord));
+                break;
+            default: break;
+            }
+        }
+
+        /// @brief Sign or zero-extend the low bits of a register holding a value narrower than 32 bits.
+        void extend(std::uint8_t order, Types::Kind kind)
+        {
+            switch(kind)
+            {
+            case Types::Kind::i8:
+            case Types::Kind::_char:
+                m_emitter.binary(BinaryInstruction::MoveSignExtend, getRegister(order, Size::DoubleWord), getRegister(order, Size::Byte));
+                break;
+            case Types::Kind::u8:
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(order, Size::DoubleWord), getRegister(order, Size::Byte));
+                break;
+            case Types::Kind::i16:
+                m_emitter.binary(BinaryInstruction::MoveSignExtend, getRegister(order, Size::DoubleWord), getRegister(order, Size::Word));
+                break;
+            case Types::Kind::u16:
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(order, Size::DoubleWord), getRegister(order, Size::Word));
+                break;
+            default: break;
+            }
+        }
+
+        /// @brief Canonicalize a value received from code that does not follow the conventions of the selector (arguments and
+        /// results of calls): booleans may be any non-zero byte, and narrow values may carry garbage in their upper bits.
+        void normalize(std::uint8_t order, Types::Kind kind)
+        {
+            if(kind == Types::Kind::_bool)
+            {
+                m_emitter.binary(BinaryInstruction::Test, getRegister(order, Size::Byte), getRegister(order, Size::Byte));
+                m_emitter.unary(UnaryInstruction::SetIfNotEqual, getRegister(order, Size::Byte));
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(order, Size::DoubleWord), getRegister(order, Size::Byte));
+            }
+            else extend(order, kind);
+        }
+
+        /// @brief Get the conditional jump and set instructions of a comparison.
+        static std::pair<UnaryInstruction, UnaryInstruction> getCondition(OpCode code, bool is_signed, bool negate = false)
+        {
+            if(negate)
+                switch(code)
+                {
+                case OpCode::Equals: code = OpCode::NotEquals; break;
+                case OpCode::NotEquals: code = OpCode::Equals; break;
+                case OpCode::Greater: code = OpCode::LessEqual; break;
+                case OpCode::LessEqual: code = OpCode::Greater; break;
+                case OpCode::Less: code = OpCode::GreaterEqual; break;
+                case OpCode::GreaterEqual: code = OpCode::Less; break;
+                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(code);
+                }
+
+            switch(code)
+            {
+            case OpCode::Equals: return {UnaryInstruction::JumpIfEqual, UnaryInstruction::SetIfEqual};
+            case OpCode::NotEquals: return {UnaryInstruction::JumpIfNotEqual, UnaryInstruction::SetIfNotEqual};
+            case OpCode::Greater: return is_signed? std::pair{UnaryInstruction::JumpIfGreater, UnaryInstruction::SetIfGreater}:
+                std::pair{UnaryInstruction::JumpIfAbove, UnaryInstruction::SetIfAbove};
+            case OpCode::Less: return is_signed? std::pair{UnaryInstruction::JumpIfLess, UnaryInstruction::SetIfLess}:
+                std::pair{UnaryInstruction::JumpIfBelow, UnaryInstruction::SetIfBelow};
+            case OpCode::GreaterEqual: return is_signed? std::pair{UnaryInstruction::JumpIfGreaterEqual, UnaryInstruction::SetIfGreaterEqual}:
+                std::pair{UnaryInstruction::JumpIfAboveEqual, UnaryInstruction::SetIfAboveEqual};
+            case OpCode::LessEqual: return is_signed? std::pair{UnaryInstruction::JumpIfLessEqual, UnaryInstruction::SetIfLessEqual}:
+                std::pair{UnaryInstruction::JumpIfBelowEqual, UnaryInstruction::SetIfBelowEqual};
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(code);
+            }
+        }
+
+        /// @brief Split every edge from a conditional branch or a switch to a block with phi nodes, so that the moves resolving
+        /// the phi nodes can be placed on the edge.
+        void splitCriticalEdges()
+        {
+            const auto count = static_cast<Block>(m_function.blocks.size());
+
+            for(Block block{0u}; block < count; ++block)
+            {
+                if(m_function.blocks[block].instructions.empty())
+                    continue;
+
+                auto terminator = m_function.blocks[block].instructions.back();
+                if(at(terminator).code == OpCode::Switch)
+                {
+                    splitSwitchEdges(block, terminator);
+                    continue;
+                }
+                else if(at(terminator).code != OpCode::Branch)
+                    continue;
+
+                for(std::size_t index{0ul}; index < 2ul; ++index)
+                {
+                    auto target = m_function.values[terminator].targets[index];
+                    const auto& instructions = m_function.blocks[target].instructions;
+
+                    if(instructions.empty() || at(instructions.front()).code != OpCode::Phi)
+                        continue;
+
+                    auto edge = m_function.appendBlock();
+                    m_function.append(edge, IR::Instruction{.code = OpCode::Jump, .targets = {target, 0u}});
+                    m_function.blocks[edge].predecessors.push_back(block);
+                    m_function.values[terminator].targets[index] = edge;
+
+                    // both targets may be the same block, with one predecessor entry per edge
+                    auto& predecessors = m_function.blocks[target].predecessors;
+                    *std::find(predecessors.begin(), predecessors.end(), block) = edge;
+                }
+            }
+        }
+
+        /// @brief Split the edges of a switch to blocks with phi nodes. Every case going to the same block shares the edge.
+        void splitSwitchEdges(Block block, Value terminator)
+        {
+            for(auto target: m_function.getSuccessors(block))
+            {
+                const auto& instructions = m_function.blocks[target].instructions;
+                if(instructions.empty() || at(instructions.front()).code != OpCode::Phi)
+                    continue;
+
+                auto edge = m_function.appendBlock();
+                m_function.append(edge, IR::Instruction{.code = OpCode::Jump, .targets = {target, 0u}});
+                m_function.blocks[edge].predecessors.push_back(block);
+
+                auto& instruction = m_function.values[terminator];
+                std::ranges::replace(instruction.cases, target, edge);
+                if(instruction.targets[0ul] == target)
+                    instruction.targets[0ul] = edge;
+
+                auto& predecessors = m_function.blocks[target].predecessors;
+                *std::find(predecessors.begin(), predecessors.end(), block) = edge;
+            }
+        }
+
+        void countUses()
+        {
+            m_uses.assign(m_function.values.size(), 0u);
+
+            for(auto block: m_layout)
+                for(auto value: m_function.blocks[block].instructions)
+                    for(auto operand: at(value).operands)
+                        ++m_uses[operand];
+        }
+
+        /// @brief Find comparisons only used by the branch directly following them, which are emitted as a compare and a
+        /// conditional jump instead of materializing a boolean.
+        void fuseComparisons()
+        {
+            m_isFused.assign(m_function.values.size(), false);
+
+            for(auto block: m_layout)
+            {
+                const auto& instructions = m_function.blocks[block].instructions;
+                if(instructions.size() < 2ul)
+                    continue;
+
+                const auto& terminator = at(instructions.back());
+                auto condition = instructions[instructions.size() - 2ul];
+
+                if(terminator.code == OpCode::Branch && terminator.operands.front() == condition && IR::isComparison(at(condition).code)
+                    && m_uses[condition] == 1u)
+                    m_isFused[condition] = true;
+            }
+        }
+
+        /// @brief Whether a value needs a register or a stack slot. Constants are rematerialized at every use instead.
+        [[nodiscard]] bool needsLocation(Value value) const
+        {
+            const auto& instruction = at(value);
+            return instruction.kind != Types::Kind::_void && instruction.code != OpCode::Constant && !m_isFused[value] && m_uses[value] != 0u;
+        }
+
+        /// @brief Number the instructions in layout order, two positions apart.
+        void number()
+        {
+            m_positions.assign(m_function.values.size(), 0u);
+            m_blockStarts.assign(m_function.blocks.size(), 0u);
+            m_blockEnds.assign(m_function.blocks.size(), 0u);
+            m_labels.assign(m_function.blocks.size(), Operand{});
+
+            std::uint32_t position{0u};
+            for(auto block: m_layout)
+            {
+                m_labels[block] = m_emitter.getSymbol(m_emitter.reserveLabel());
+                m_blockStarts[block] = position;
+
+                for(auto value: m_function.blocks[block].instructions)
+                {
+                    m_positions[value] = at(value).code == OpCode::Phi? m_blockStarts[block]: position;
+                    position += 2u;
+                }
+
+                m_blockEnds[block] = position - 2u;
+            }
+        }
+
+        /// @brief Compute the live interval of every value needing a location from the liveness of the control flow graph.
+        void computeIntervals()
+        {
+            const auto value_count = m_function.values.size();
+            std::vector<std::vector<bool>> live_in(m_function.blocks.size(), std::vector<bool>(value_count, false));
+            std::vector<std::vector<bool>> live_out(live_in);
+
+            auto use = [&](Value value, std::vector<bool>& live) { if(needsLocation(value)) live[value] = true; };
+
+            for(bool changed{true}; changed;)
+            {
+                changed = false;
+
+                for(auto it = m_layout.rbegin(); it != m_layout.rend(); ++it)
+                {
+                    auto block = *it;
+                    std::vector<bool> live(value_count, false);
+
+                    for(auto successor: m_function.getSuccessors(block))
+                    {
+                        for(std::size_t value{0ul}; value < value_count; ++value)
+                            if(live_in[successor][value])
+                                live[value] = true;
+
+                        const auto& predecessors = m_function.blocks[successor].predecessors;
+                        auto index = std::find(predecessors.begin(), predecessors.end(), block) - predecessors.begin();
+
+                        for(auto value: m_function.blocks[successor].instructions)
+                            if(const auto& instruction = at(value); instruction.code == OpCode::Phi)
+                                use(instruction.operands[index], live);
+                            else break;
+                    }
+
+                    live_out[block] = live;
+                    const auto& instructions = m_function.blocks[block].instructions;
+
+                    for(auto instruction = instructions.rbegin(); instruction != instructions.rend(); ++instruction)
+                    {
+                        live[*instruction] = false;
+                        if(at(*instruction).code != OpCode::Phi)
+                            for(auto operand: getReadOperands(*instruction))
+                                use(operand, live);
+                    }
+
+                    if(live != live_in[block])
+                    {
+                        live_in[block] = std::move(live);
+                        changed = true;
+                    }
+                }
+            }
+
+            m_intervals.assign(value_count, Interval{});
+            for(auto block: m_layout)
+                for(auto value: m_function.blocks[block].instructions)
+                    m_intervals[value] = Interval{.start = m_positions[value], .end = m_positions[value] + 1u};
+
+            auto cover = [&](Value value, std::uint32_t position)
+            {
+                if(!needsLocation(value))
+                    return;
+
+                auto& interval = m_intervals[value];
+                interval.start = std::min(interval.start, position);
+                interval.end = std::max(interval.end, position);
+            };
+
+            for(auto block: m_layout)
+            {
+                for(std::size_t value{0ul}; value < value_count; ++value)
+                {
+                    if(live_in[block][value])
+                        cover(static_cast<Value>(value), m_blockStarts[block]);
+                    if(live_out[block][value])
+                        cover(static_cast<Value>(value), m_blockEnds[block]);
+                }
+
+                for(auto value: m_function.blocks[block].instructions)
+                {
+                    const auto& instruction = at(value);
+                    // the operands of phi nodes are read by the moves at the end of every predecessor, whose only successor
+                    // is the block of the phi nodes once critical edges are split: the registers written by the moves can
+                    // therefore only be shared with values that are dead by then
+                    if(instruction.code == OpCode::Phi)
+                    {
+                        for(std::size_t index{0ul}; index < instruction.operands.size(); ++index)
+                            cover(instruction.operands[index], m_blockEnds[m_function.blocks[block].predecessors[index]]);
+                        continue;
+                    }
+
+                    // arguments are all moved to their locations on entry
+                    if(instruction.code == OpCode::Argument)
+                        cover(value, 0u);
+
+                    // the operands of a fused comparison are read by the branch following it
+                    auto position = m_isFused[value]? m_positions[value] + 2u: m_positions[value];
+                    for(auto operand: instruction.operands)
+                        cover(operand, position);
+                }
+            }
+        }
+
+        /// @brief Get the values read by an instruction, looking through fused comparisons.
+        [[nodiscard]] std::vector<Value> getReadOperands(Value value) const
+        {
+            auto operands = at(value).operands;
+            if(at(value).code == OpCode::Branch && m_isFused[operands.front()])
+                return at(operands.front()).operands;
+
+            return operands;
+        }
+
+        /// @brief Assign registers to values by linear scan, spilling the value whose interval ends last when none is free.
+        void allocate()
+        {
+            m_locations.assign(m_function.values.size(), Location{});
+            m_spillCount = 0u;
+
+            std::vector<Value> order;
+            for(auto block: m_layout)
+                for(auto value: m_function.blocks[block].instructions)
+                    if(needsLocation(value))
+                        order.push_back(value);
+
+            std::stable_sort(order.begin(), order.end(), [&](Value first, Value second)
+            {
+                return m_intervals[first].start < m_intervals[second].start;
+            });
+
+            std::vector<Value> active;
+            std::array<bool, 16ul> used{};
+
+            auto spill = [&](Value value) { m_locations[value] = Location{.kind = Location::Kind::Stack, .slot = m_spillCount++}; };
+
+            for(auto value: order)
+            {
+                const auto& interval = m_intervals[value];
+
+                std::erase_if(active, [&](Value other)
+                {
+                    if(m_intervals[other].end > interval.start)
+                        return false;
+
+                    used[m_locations[other].order] = false;
+                    return true;
+                });
+
+                auto hint = getHint(value);
+                auto choice = hint && !used[*hint]? hint: std::nullopt;
+
+                for(auto candidate: s_pool)
+                    if(!choice && !used[candidate])
+                        choice = candidate;
+
+                if(!choice)
+                {
+                    auto victim = std::max_element(active.begin(), active.end(), [&](Value first, Value second)
+                    {
+                        return m_intervals[first].end < m_intervals[second].end;
+                    });
+
+                    if(m_intervals[*victim].end <= interval.end)
+                    {
+                        spill(value);
+                        continue;
+                    }
+
+                    choice = m_locations[*victim].order;
+                    spill(*victim);
+                    active.erase(victim);
+                }
+
+                m_locations[value] = Location{.kind = Location::Kind::Register, .order = *choice};
+                used[*choice] = true;
+                active.push_back(value);
+            }
+        }
+
+        /// @brief Get the register a value would preferably live in: arguments prefer the register they are passed in, and other
+        /// values the register of their first operand, saving a move when it is its last use.
+        [[nodiscard]] std::optional<std::uint8_t> getHint(Value value) const
+        {
+            const auto& instruction = at(value);
+
+            if(instruction.code == OpCode::Argument)
+            {
+                auto order = s_arguments[instruction.immediate];
+                if(std::find(s_pool.begin(), s_pool.end(), order) != s_pool.end())
+                    return order;
+            }
+            else if(!instruction.operands.empty() && instruction.code != OpCode::Phi && instruction.code != OpCode::Call
+                && instruction.code != OpCode::ExternalCall)
+            {
+                if(auto location = m_locations[instruction.operands.front()]; location.kind == Location::Kind::Register)
+                    return location.order;
+            }
+
+            return std::nullopt;
+        }
+
+        /// @brief Perform a set of moves as if simultaneously, breaking cycles through the accumulator.
+        void parallelMove(std::vector<Move> moves)
+        {
+            std::erase_if(moves, [](const Move& move){ return move.destination == move.source; });
+
+            while(!moves.empty())
+            {
+                auto ready = std::find_if(moves.begin(), moves.end(), [&](const Move& move)
+                {
+                    return std::none_of(moves.begin(), moves.end(), [&](const Move& other){ return other.source == move.destination; });
+                });
+
+                if(ready != moves.end())
+                {
+                    emitMove(ready->destination, ready->source);
+                    moves.erase(ready);
+                    continue;
+                }
+
+                // every remaining move overwrites the source of another: the moves form cycles
+                const Location accumulator{.kind = Location::Kind::Register, .order = s_accumulator};
+                auto blocked = moves.front().destination;
+                emitMove(accumulator, blocked);
+
+                for(auto& move: moves)
+                    if(move.source == blocked)
+                        move.source = accumulator;
+            }
+        }
+
+        void emitMove(const Location& destination, const Location& source)
+        {
+            Operand operand;
+            switch(source.kind)
+            {
+            case Location::Kind::Register: operand = getRegister(source.order, Size::QuadWord); break;
+            case Location::Kind::Constant: operand = getImmediate(source.constant, Size::QuadWord); break;
+            case Location::Kind::Stack:
+                operand = getSlot(source.slot, Size::QuadWord);
+
+                if(destination.kind == Location::Kind::Stack)
+                {
+                    m_emitter.binary(BinaryInstruction::Move, getRegister(s_count, Size::QuadWord), operand);
+                    operand = getRegister(s_count, Size::QuadWord);
+                }
+                break;
+            default: throw LINC_EXCEPTION_ILLEGAL_STATE(source.kind);
+            }
+
+            if(destination.kind == Location::Kind::Register)
+                m_emitter.binary(BinaryInstruction::Move, getRegister(destination.order, Size::QuadWord), operand);
+            else
+            {
+                if(source.kind == Location::Kind::Constant && !isEncodable(source.constant, Size::QuadWord))
+                {
+                    m_emitter.binary(BinaryInstruction::Move, getRegister(s_count, Size::QuadWord), operand);
+                    operand = getRegister(s_count, Size::QuadWord);
+                }
+
+                m_emitter.binary(BinaryInstruction::Move, getSlot(destination.slot, Size::QuadWord), operand);
+            }
+        }
+
+        /// @brief Move the arguments of the function from the registers they are passed in to their locations.
+        void moveArguments()
+        {
+            std::vector<Move> moves;
+
+            for(auto value: m_function.blocks[0ul].instructions)
+            {
+                const auto& instruction = at(value);
+                if(instruction.code != OpCode::Argument || !needsLocation(value))
+                    continue;
+
+                auto order = s_arguments[instruction.immediate];
+                normalize(order, instruction.kind);
+                moves.push_back(Move{.destination = m_locations[value], .source = Location{.kind = Location::Kind::Register, .order = order}});
+            }
+
+            parallelMove(std::move(moves));
+        }
+
+        void generate(Value value, Block block)
+        {
+            const auto& instruction = at(value);
+
+            switch(instruction.code)
+            {
+            case OpCode::Argument:
+            case OpCode::Constant:
+            case OpCode::Phi:
+                return;
+            case OpCode::Call:
+            case OpCode::ExternalCall:
+                return generateCall(value);
+            case OpCode::StoreGlobal:
+                return generateStoreGlobal(instruction);
+            case OpCode::Jump:
+                return generateJump(instruction, block);
+            case OpCode::Branch:
+                return generateBranch(instruction);
+            case OpCode::Switch:
+                return generateSwitch(instruction);
+            case OpCode::Return:
+                return generateReturn(instruction);
+            case OpCode::Allocate:
+            case OpCode::Load:
+            case OpCode::Store:
+                throw LINC_EXCEPTION_ILLEGAL_STATE(instruction.code);
+            default: break;
+            }
+
+            // the remaining instructions have no side effects and only need to be computed if they are used
+            if(!needsLocation(value))
+                return;
+
+            switch(instruction.code)
+            {
+            case OpCode::LoadGlobal: return generateLoadGlobal(value);
+            case OpCode::Divide:
+            case OpCode::Modulo:
+                return generateDivision(value);
+            case OpCode::ShiftLeft:
+            case OpCode::ShiftRight:
+                return generateShift(value);
+            case OpCode::Negate:
+            case OpCode::BitwiseNot:
+                return generateUnary(value);
+            case OpCode::LogicalNot: return generateLogicalNot(value);
+            case OpCode::Convert: return generateConversion(value);
+            default:
+                if(IR::isComparison(instruction.code))
+                    return generateComparison(value);
+                return generateArithmetic(value);
+            }
+        }
+
+        void generateLoadGlobal(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto label = m_resolveGlobal(m_module.symbols[instruction.immediate]);
+            const auto size = getStorageSize(instruction.kind);
+            auto target = getTarget(value);
+
+            if(instruction.kind == Types::Kind::_bool)
+            {
+                m_emitter.binary(BinaryInstruction::Compare, m_emitter.getAddress(label, Size::Byte), EmitterAMD64::getImmediate(0l));
+                m_emitter.unary(UnaryInstruction::SetIfNotEqual, getRegister(target, Size::Byte));
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(target, Size::DoubleWord), getRegister(target, Size::Byte));
+            }
+            else if(size == Size::Byte || size == Size::Word)
+                m_emitter.binary(IR::isSigned(instruction.kind)? BinaryInstruction::MoveSignExtend: BinaryInstruction::MoveExtend,
+                    getRegister(target, Size::DoubleWord), m_emitter.getAddress(label, size));
+            else m_emitter.binary(BinaryInstruction::Move, getRegister(target, size), m_emitter.getAddress(label, size));
+
+            commit(value, target);
+        }
+
+        void generateStoreGlobal(const IR::Instruction& instruction)
+        {
+            auto operand = instruction.operands.front();
+            const auto label = m_resolveGlobal(m_module.symbols[instruction.immediate]);
+            const auto size = getStorageSize(at(operand).kind);
+
+            Operand source;
+            switch(auto location = locate(operand); location.kind)
+            {
+            case Location::Kind::Register: source = getRegister(location.order, size); break;
+            case Location::Kind::Constant:
+                source = size == Size::Byte? EmitterAMD64::getImmediate(static_cast<Types::i8>(location.constant)):
+                    size == Size::Word? EmitterAMD64::getImmediate(static_cast<Types::i16>(location.constant)): getOperand(operand, size, s_accumulator);
+                break;
+            default:
+                moveTo(s_accumulator, operand, Size::QuadWord);
+                source = getRegister(s_accumulator, size);
+                break;
+            }
+
+            m_emitter.binary(BinaryInstruction::Move, m_emitter.getAddress(label, size), source);
+        }
+
+        void generateArithmetic(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto size = getOperationSize(instruction.kind);
+            auto first = instruction.operands[0ul], second = instruction.operands[1ul];
+            auto target = getTarget(value);
+
+            if(isIn(second, target) && !isIn(first, target))
+            {
+                if(IR::isCommutative(instruction.code))
+                    std::swap(first, second);
+                else target = s_accumulator;
+            }
+
+            moveTo(target, first, size);
+            auto source = getOperand(second, size, s_count);
+
+            switch(instruction.code)
+            {
+            case OpCode::Add: m_emitter.binary(BinaryInstruction::Add, getRegister(target, size), source); break;
+            case OpCode::Subtract: m_emitter.binary(BinaryInstruction::Subtract, getRegister(target, size), source); break;
+            case OpCode::Multiply: m_emitter.binary(BinaryInstruction::Multiply, getRegister(target, size), source); break;
+            case OpCode::BitwiseAnd: m_emitter.binary(BinaryInstruction::And, getRegister(target, size), source); break;
+            case OpCode::BitwiseOr: m_emitter.binary(BinaryInstruction::Or, getRegister(target, size), source); break;
+            case OpCode::BitwiseXor: m_emitter.binary(BinaryInstruction::Xor, getRegister(target, size), source); break;
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(instruction.code);
+            }
+
+            if(instruction.code == OpCode::Add || instruction.code == OpCode::Subtract || instruction.code == OpCode::Multiply)
+                extend(target, instruction.kind);
+
+            commit(value, target);
+        }
+
+        void generateDivision(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto size = getOperationSize(instruction.kind);
+            const auto is_signed = IR::isSigned(instruction.kind);
+            auto divisor = instruction.operands[1ul];
+
+            moveTo(s_accumulator, instruction.operands[0ul], size);
+
+            Operand source;
+            if(locate(divisor).kind == Location::Kind::Constant)
+            {
+                moveTo(s_count, divisor, size);
+                source = getRegister(s_count, size);
+            }
+            else source = getOperand(divisor, size, s_count);
+
+            if(is_signed)
+                m_emitter.nullary(size == Size::QuadWord? NullaryInstruction::ConvertQuadOctal: NullaryInstruction::ConvertDoubleQuad);
+            else m_emitter.binary(BinaryInstruction::Xor, getRegister(s_remainder, Size::DoubleWord), getRegister(s_remainder, Size::DoubleWord));
+
+            m_emitter.unary(is_signed? UnaryInstruction::SignedDivide: UnaryInstruction::UnsignedDivide, source);
+
+            auto result = instruction.code == OpCode::Divide? s_accumulator: s_remainder;
+            extend(result, instruction.kind);
+            commit(value, result);
+        }
+
+        void generateShift(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto size = getOperationSize(instruction.kind);
+            auto count = instruction.operands[1ul];
+
+            Operand source;
+            if(auto location = locate(count); location.kind == Location::Kind::Constant)
+                source = EmitterAMD64::getImmediate(static_cast<Types::i64>(location.constant & (size == Size::QuadWord? 63ul: 31ul)));
+            else
+            {
+                moveTo(s_count, count, Size::DoubleWord);
+                source = getRegister(s_count, Size::Byte);
+            }
+
+            auto target = getTarget(value);
+            moveTo(target, instruction.operands[0ul], size);
+
+            auto operation = instruction.code == OpCode::ShiftLeft? BinaryInstruction::BitShiftLeft:
+                IR::isSigned(instruction.kind)? BinaryInstruction::ArithmeticShiftRight: BinaryInstruction::BitShiftRight;
+            m_emitter.binary(operation, getRegister(target, size), source);
+
+            if(instruction.code == OpCode::ShiftLeft)
+                extend(target, instruction.kind);
+
+            commit(value, target);
+        }
+
+        void generateUnary(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto size = getOperationSize(instruction.kind);
+            auto target = getTarget(value);
+
+            moveTo(target, instruction.operands.front(), size);
+
+            if(instruction.kind == Types::Kind::_bool)
+                m_emitter.binary(BinaryInstruction::Xor, getRegister(target, Size::DoubleWord), EmitterAMD64::getImmediate(1l));
+            else
+            {
+                m_emitter.unary(instruction.code == OpCode::Negate? UnaryInstruction::Negate: UnaryInstruction::Not, getRegister(target, size));
+                extend(target, instruction.kind);
+            }
+
+            commit(value, target);
+        }
+
+        void generateLogicalNot(Value value)
+        {
+            const auto& instruction = at(value);
+            auto operand = instruction.operands.front();
+            auto target = getTarget(value);
+
+            if(at(operand).kind == Types::Kind::_bool)
+            {
+                moveTo(target, operand, Size::DoubleWord);
+                m_emitter.binary(BinaryInstruction::Xor, getRegister(target, Size::DoubleWord), EmitterAMD64::getImmediate(1l));
+            }
+            else
+            {
+                testZero(operand, s_accumulator);
+                m_emitter.unary(UnaryInstruction::SetIfEqual, getRegister(target, Size::Byte));
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(target, Size::DoubleWord), getRegister(target, Size::Byte));
+            }
+
+            commit(value, target);
+        }
+
+        /// @brief Set the flags according to whether a value is zero.
+        void testZero(Value value, std::uint8_t scratch)
+        {
+            const auto size = getOperationSize(at(value).kind);
+
+            if(auto location = locate(value); location.kind == Location::Kind::Stack)
+                m_emitter.binary(BinaryInstruction::Compare, getSlot(location.slot, size), EmitterAMD64::getImmediate(0l));
+            else
+            {
+                auto operand = getRegisterOperand(value, size, scratch);
+                m_emitter.test(operand);
+            }
+        }
+
+        void generateConversion(Value value)
+        {
+            const auto& instruction = at(value);
+            auto operand = instruction.operands.front();
+            const auto from = at(operand).kind, to = instruction.kind;
+            auto target = getTarget(value);
+
+            if(auto location = locate(operand); location.kind == Location::Kind::Constant)
+            {
+                auto result = IR::evaluate(instruction, from, {location.constant}).value();
+                m_emitter.binary(BinaryInstruction::Move, getRegister(target, getOperationSize(to)), getImmediate(result, getOperationSize(to)));
+            }
+            else if(to == Types::Kind::_bool)
+            {
+                testZero(operand, s_accumulator);
+                m_emitter.unary(UnaryInstruction::SetIfNotEqual, getRegister(target, Size::Byte));
+                m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(target, Size::DoubleWord), getRegister(target, Size::Byte));
+            }
+            else if(isWide(to))
+            {
+                if(isWide(from))
+                    moveTo(target, operand, Size::QuadWord);
+                else if(IR::isSigned(from))
+                    m_emitter.binary(BinaryInstruction::MoveSignExtendDoubleWord, getRegister(target, Size::QuadWord),
+                        getOperand(operand, Size::DoubleWord, target));
+                // writing the low 32 bits of a register clears its upper bits
+                else m_emitter.binary(BinaryInstruction::Move, getRegister(target, Size::DoubleWord), getOperand(operand, Size::DoubleWord, target));
+            }
+            else
+            {
+                moveTo(target, operand, Size::DoubleWord);
+                extend(target, to);
+            }
+
+            commit(value, target);
+        }
+
+        /// @brief Compare the operands of a comparison, setting the flags.
+        /// @return The comparison the flags are to be tested for, mirrored if a constant first operand was swapped to the right.
+        OpCode compare(const IR::Instruction& instruction)
+        {
+            auto first = instruction.operands[0ul], second = instruction.operands[1ul];
+            const auto size = getOperationSize(at(first).kind);
+            auto code = instruction.code;
+
+            if(locate(first).kind == Location::Kind::Constant && locate(second).kind != Location::Kind::Constant)
+            {
+                std::swap(first, second);
+                switch(code)
+                {
+                case OpCode::Greater: code = OpCode::Less; break;
+                case OpCode::Less: code = OpCode::Greater; break;
+                case OpCode::GreaterEqual: code = OpCode::LessEqual; break;
+                case OpCode::LessEqual: code = OpCode::GreaterEqual; break;
+                default: break;
+                }
+            }
+
+            Operand left;
+            if(auto location = locate(first); location.kind == Location::Kind::Stack && locate(second).kind != Location::Kind::Stack)
+                left = getSlot(location.slot, size);
+            else left = getRegisterOperand(first, size, s_accumulator);
+
+            m_emitter.binary(BinaryInstruction::Compare, left, getOperand(second, size, s_count));
+            return code;
+        }
+
+        void generateComparison(Value value)
+        {
+            if(m_isFused[value])
+                return;
+
+            const auto& instruction = at(value);
+            auto target = getTarget(value);
+
+            auto code = compare(instruction);
+            m_emitter.unary(getCondition(code, IR::isSigned(at(instruction.operands.front()).kind)).second,
+                getRegister(target, Size::Byte));
+            m_emitter.binary(BinaryInstruction::MoveExtend, getRegister(target, Size::DoubleWord), getRegister(target, Size::Byte));
+
+            commit(value, target);
+        }
+
+        void generateCall(Value value)
+        {
+            const auto& instruction = at(value);
+            const auto position = m_positions[value];
+
+            // values living across the call are saved, as every allocatable register is caller-saved
+            std::vector<std::uint8_t> saved;
+            for(auto block: m_layout)
+                for(auto other: m_function.blocks[block].instructions)
+                    if(auto location = m_locations[other]; location.kind == Location::Kind::Register
+                        && m_intervals[other].start < position && m_intervals[other].end > position
+                        && std::find(saved.begin(), saved.end(), location.order) == saved.end())
+                        saved.push_back(location.order);
+
+            for(auto order: saved)
+                m_emitter.push(getRegister(order, Size::QuadWord));
+
+            std::vector<Move> moves;
+            for(std::size_t index{0ul}; index < instruction.operands.size(); ++index)
+                moves.push_back(Move{.destination = Location{.kind = Location::Kind::Register, .order = s_arguments[index]},
+                    .source = locate(instruction.operands[index])});
+
+            parallelMove(std::move(moves));
+
+            const auto& symbol = m_module.symbols[instruction.immediate];
+            if(instruction.code == OpCode::ExternalCall)
+                m_emitter.external(symbol);
+
+            m_emitter.unary(UnaryInstruction::Call, m_emitter.getSymbol(symbol));
+
+            for(auto order = saved.rbegin(); order != saved.rend(); ++order)
+                m_emitter.pop(getRegister(*order, Size::QuadWord));
+
+            if(needsLocation(value))
+            {
+                normalize(s_accumulator, instruction.kind);
+                commit(value, s_accumulator);
+            }
+        }
+
+        /// @brief Get the moves resolving the phi nodes of a block for the edge from one of its predecessors.
+        [[nodiscard]] std::vector<Move> getPhiMoves(Block from, Block to) const
+        {
+            const auto& predecessors = m_function.blocks[to].predecessors;
+            auto index = std::find(predecessors.begin(), predecessors.end(), from) - predecessors.begin();
+
+            std::vector<Move> moves;
+            for(auto value: m_function.blocks[to].instructions)
+            {
+                const auto& phi = at(value);
+                if(phi.code != OpCode::Phi)
+                    break;
+
+                if(auto source = locate(phi.operands[index]); needsLocation(value) && !(source == m_locations[value]))
+                    moves.push_back(Move{.destination = m_locations[value], .source = source});
+            }
+
+            return moves;
+        }
+
+        /// @brief Find the blocks that only jump to another without moving any value (mostly split edges whose phi nodes were
+        /// allocated to the registers of their operands), so that control is transferred to their target directly instead.
+        void forwardJumps()
+        {
+            m_forwards.assign(m_function.blocks.size(), IR::none);
+
+            for(auto block: m_layout)
+                if(const auto& instructions = m_function.blocks[block].instructions; block != m_layout.front() && instructions.size() == 1ul
+                    && at(instructions.front()).code == OpCode::Jump && getPhiMoves(block, at(instructions.front()).targets[0ul]).empty())
+                    m_forwards[block] = at(instructions.front()).targets[0ul];
+
+            // blocks jumping to each other in a cycle (an empty infinite loop) are kept
+            for(auto block: m_layout)
+            {
+                auto destination = block;
+                for(std::size_t step{0ul}; destination != IR::none && step <= m_layout.size(); ++step)
+                    destination = m_forwards[destination];
+
+                if(destination != IR::none)
+                    m_forwards[block] = IR::none;
+            }
+        }
+
+        /// @brief Get the block control is eventually transferred to when jumping to a block, following forwarded jumps.
+        [[nodiscard]] Block getDestination(Block block) const
+        {
+            while(m_forwards[block] != IR::none)
+                block = m_forwards[block];
+
+            return block;
+        }
+
+        void generateJump(const IR::Instruction& instruction, Block block)
+        {
+            auto target = instruction.targets[0ul];
+            parallelMove(getPhiMoves(block, target));
+
+            if(auto destination = getDestination(target); destination != m_next)
+                m_emitter.unary(UnaryInstruction::Jump, m_labels[destination]);
+        }
+
+        void generateBranch(const IR::Instruction& instruction)
+        {
+            auto condition = instruction.operands.front();
+            auto on_true = getDestination(instruction.targets[0ul]), on_false = getDestination(instruction.targets[1ul]);
+
+            if(auto location = locate(condition); location.kind == Location::Kind::Constant)
+            {
+                if(auto target = location.constant? on_true: on_false; target != m_next)
+                    m_emitter.unary(UnaryInstruction::Jump, m_labels[target]);
+                return;
+            }
+
+            UnaryInstruction jump_if_true{UnaryInstruction::JumpIfNotZero}, jump_if_false{UnaryInstruction::JumpIfZero};
+
+            if(m_isFused[condition])
+            {
+                const auto& comparison = at(condition);
+                const auto is_signed = IR::isSigned(at(comparison.operands.front()).kind);
+
+                auto code = compare(comparison);
+                jump_if_true = getCondition(code, is_signed).first;
+                jump_if_false = getCondition(code, is_signed, true).first;
+            }
+            else testZero(condition, s_accumulator);
+
+            if(on_true == m_next)
+                m_emitter.unary(jump_if_false, m_labels[on_false]);
+            else
+            {
+                m_emitter.unary(jump_if_true, m_labels[on_true]);
+                if(on_false != m_next)
+                    m_emitter.unary(UnaryInstruction::Jump, m_labels[on_false]);
+            }
+        }
+
+        /// @brief Jump through a table of the labels of the cases, indexed by the value less the lowest one. Values outside of the
+        /// range wrap around to indices past its end, such that a single unsigned comparison sends them to the default block.
+        void generateSwitch(const IR::Instruction& instruction)
+        {
+            auto test = instruction.operands.front();
+            auto on_default = getDestination(instruction.targets[0ul]);
+            const auto size = getOperationSize(at(test).kind);
+
+            std::vector<Operand> labels;
+            for(auto target: instruction.cases)
+                labels.push_back(m_labels[getDestination(target)]);
+
+            moveTo(s_accumulator, test, size);
+            if(instruction.immediate != 0ul && isEncodable(instruction.immediate, size))
+                m_emitter.binary(BinaryInstruction::Subtract, getRegister(s_accumulator, size), getImmediate(instruction.immediate, size));
+            else if(instruction.immediate != 0ul)
+            {
+                m_emitter.binary(BinaryInstruction::Move, getRegister(s_count, size), getImmediate(instruction.immediate, size));
+                m_emitter.binary(BinaryInstruction::Subtract, getRegister(s_accumulator, size), getRegister(s_count, size));
+            }
+
+            // the index is zero-extended to 64 bits by the 32-bit operations on narrower values
+            m_emitter.binary(BinaryInstruction::Compare, getRegister(s_accumulator, size), getImmediate(labels.size() - 1ul, size));
+            m_emitter.unary(UnaryInstruction::JumpIfAbove, m_labels[on_default]);
+            m_emitter.binary(BinaryInstruction::BitShiftLeft, getRegister(s_accumulator, size), getImmediate(3ul, size));
+            m_emitter.binary(BinaryInstruction::Move, getRegister(s_count, Size::QuadWord), m_emitter.getSymbol(m_emitter.defineJumpTable(labels)));
+
+            auto entry = EmitterAMD64::getMemory(s_count, 0l, Size::QuadWord);
+            entry.index = s_accumulator;
+            m_emitter.unary(UnaryInstruction::Jump, entry);
+        }
+
+        void generateReturn(const IR::Instruction& instruction)
+        {
+            if(m_function.isEntryPoint)
+            {
+                if(instruction.operands.empty())
+                    m_emitter.binary(BinaryInstruction::Xor, getRegister(LINC_REGISTERS_DEST, Size::DoubleWord),
+                        getRegister(LINC_REGISTERS_DEST, Size::DoubleWord));
+                else moveTo(LINC_REGISTERS_DEST, instruction.operands.front(), getOperationSize(at(instruction.operands.front()).kind));
+
+                m_emitter.external("sys_exit");
+                m_emitter.unary(UnaryInstruction::Call, m_emitter.getSymbol("sys_exit"));
+                return;
+            }
+
+            if(!instruction.operands.empty())
+                moveTo(s_accumulator, instruction.operands.front(), getOperationSize(at(instruction.operands.front()).kind));
+
+            if(m_isFramed)
+                m_emitter.epilogue();
+            else m_emitter.nullary(NullaryInstruction::Return);
+        }
+
+        EmitterAMD64& m_emitter;
+        const IR::Module& m_module;
+        GlobalResolver m_resolveGlobal;
+
+        IR::Function m_function;
+        std::vector<Block> m_layout;
+        std::vector<Block> m_forwards;
+        std::vector<Operand> m_labels;
+        std::vector<std::uint32_t> m_uses, m_positions, m_blockStarts, m_blockEnds;
+        std::vector<bool> m_isFused;
+        std::vector<Interval> m_intervals;
+        std::vector<Location> m_locations;
+        std::uint32_t m_spillCount{};
+        Block m_next{IR::none};
+        bool m_isFramed{};
+    };
+}
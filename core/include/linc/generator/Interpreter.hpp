@@ -4,6 +4,8 @@
 #include <linc/Include.hpp>
 #include <linc/Binder.hpp>
 #include <linc/generator/ControlFlowExceptions.hpp>
+#include <list>
+#include <bit>
 #ifdef LINC_LINUX
 #include <unistd.h>
 #endif
@@ -21,7 +23,19 @@ namespace linc
         {
             for(const auto& declaration: program->declarations)
                 evaluateDeclaration(declaration.get());
-        
+
+            auto bound_main_call = bindEntryPoint(binder, std::move(argument_list));
+
+            if(!bound_main_call)
+                return LINC_EXIT_PROGRAM_FAILURE;
+
+            return toExitCode(bound_main_call->getType(), complete(evaluateExpression(bound_main_call.get())));
+        }
+
+        /// @brief Bind a call to the entry-point function main(), passing it the argument list if it takes one.
+        /// @return The bound call expression, or nullptr if main() is missing or invalid (in which case an error is reported).
+        static std::unique_ptr<const BoundExpression> bindEntryPoint(Binder& binder, std::unique_ptr<const ArrayInitializerExpression> argument_list)
+        {
             auto main_name = linc::PrimitiveValue(std::string{"main"});
             auto find_main = binder.find(main_name.getString());
             if(!find_main)
@@ -30,19 +44,19 @@ namespace linc
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
                     .message = Logger::format("Call to undeclared entry-point function $.", main_name)
                 });
-                return LINC_EXIT_PROGRAM_FAILURE;
+                return nullptr;
             }
-            else if(auto main = dynamic_cast<const BoundFunctionDeclaration*>(find_main.get()); !main)
+            else if(find_main->getKind() != BoundNode::Kind::FunctionDeclaration)
             {
                 Reporting::push(Reporting::Report{
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
                     .message = Logger::format("The symbol-name $ is reserved for the entry point function, and cannot be used for other symbol types.",
                         main_name)
                 });
-                return LINC_EXIT_PROGRAM_FAILURE;
+                return nullptr;
             }
 
-            auto main = static_cast<const BoundFunctionDeclaration*>(find_main.get());
+            auto main = static_cast<const BoundFunctionDeclaration*>(find_main);
             auto main_argument_list = std::vector<NodeListClause<Expression>::DelimitedNode>{};
 
             if(!main->getArguments().empty())
@@ -65,17 +79,16 @@ namespace linc
                     errors = true;
 
             if(errors)
-                return LINC_EXIT_PROGRAM_FAILURE;
+                return nullptr;
 
             switch(bound_main_call->getType().primitive)
             {
-            case Types::Kind::u8: return evaluateExpression(bound_main_call.get()).getPrimitive().getU8();
-            case Types::Kind::i8: return evaluateExpression(bound_main_call.get()).getPrimitive().getI8();
-            case Types::Kind::i16: return evaluateExpression(bound_main_call.get()).getPrimitive().getI16();
-            case Types::Kind::i32: return evaluateExpression(bound_main_call.get()).getPrimitive().getI32();
+            case Types::Kind::u8:
+            case Types::Kind::i8:
+            case Types::Kind::i16:
+            case Types::Kind::i32:
             case Types::Kind::_void:
-                evaluateExpression(bound_main_call.get());
-                return LINC_EXIT_PROGRAM_SUCCESS;
+                return bound_main_call;
             default:
                 Reporting::push({Reporting::Report{
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
@@ -84,112 +97,222 @@ namespace linc
                         "as well as 8-bit unsigned integers.",
                         bound_main_call->getType())
                 }});
-                return LINC_EXIT_PROGRAM_FAILURE;
+                return nullptr;
+            }
+        }
+
+        /// @brief Convert the value returned by main() to the exit code of the program.
+        static int toExitCode(const Types::type& type, const Value& value)
+        {
+            switch(type.primitive)
+            {
+            case Types::Kind::u8: return value.getPrimitive().getU8();
+            case Types::Kind::i8: return value.getPrimitive().getI8();
+            case Types::Kind::i16: return value.getPrimitive().getI16();
+            case Types::Kind::i32: return value.getPrimitive().getI32();
+            default: return LINC_EXIT_PROGRAM_SUCCESS;
             }
         }
 
+        /// @brief Evaluate an expression within a budget of steps (function calls and loop iterations), so that evaluating
+        /// it is guaranteed to terminate. The evaluation is also abandoned at operations whose result differs in compiled
+        /// code, so that a value computed here can stand in for the expression in any backend.
+        /// @return The value of the expression, or std::nullopt if the evaluation was abandoned before it completed.
+        /// @note Exceptions thrown by the evaluation (e.g. indexing out of bounds) propagate, but leave the budget, the
+        /// completion state and the frames stack as they were before the call.
+        std::optional<Value> evaluateBounded(const BoundExpression* expression, Types::u64 steps)
+        {
+            struct Restore final
+            {
+                Interpreter& interpreter;
+                const std::size_t locals;
+
+                ~Restore()
+                {
+                    interpreter.m_steps.reset();
+                    interpreter.m_completion = Completion::Normal;
+                    interpreter.m_locals.erase(interpreter.m_locals.begin() + locals, interpreter.m_locals.end());
+                }
+            } restore{*this, m_locals.size()};
+
+            m_steps = steps;
+            auto value = evaluateExpression(expression);
+
+            if(m_completion != Completion::Normal)
+                return std::nullopt;
+
+            return value;
+        }
+
+        /// @brief Counters of the calls to pure functions looked up in the memoization cache.
+        struct MemoizationStatistics final
+        {
+            Types::u64 hits{0ul}, misses{0ul}, evictions{0ul};
+        };
+
+        /// @brief Cache the results of calls to pure functions by the values of their arguments, keeping the given number of
+        /// most recently used results (0, the default, disables the cache).
+        inline void setMemoizationCapacity(std::size_t capacity)
+        {
+            m_memoizationCapacity = capacity;
+            m_memoized.clear();
+            m_memoizationOrder.clear();
+        }
+
+        [[nodiscard]] inline const MemoizationStatistics& getMemoizationStatistics() const { return m_memoizationStatistics; }
+
         Value evaluateNode(const BoundNode* node)
         {
-            if(auto expression = dynamic_cast<const BoundExpression*>(node))
-                return evaluateExpression(std::move(expression));
+            if(node->isExpression())
+                return complete(evaluateExpression(static_cast<const BoundExpression*>(node)));
 
-            else if(auto statement = dynamic_cast<const BoundStatement*>(node))
-                return evaluateStatement(std::move(statement));
+            else if(node->isStatement())
+                return complete(evaluateStatement(static_cast<const BoundStatement*>(node)));
             
-            else if(auto declaration = dynamic_cast<const BoundDeclaration*>(node))
-                return evaluateDeclaration(std::move(declaration));
+            else if(node->isDeclaration())
+                return complete(evaluateDeclaration(static_cast<const BoundDeclaration*>(node)));
 
             throw LINC_EXCEPTION_INVALID_INPUT("Encountered unreognized node during evaluation");
         }
 
+        /// @brief Evaluate a statement. Return, break and continue statements don't throw, but leave a pending completion
+        /// (see interrupted()) that every enclosing construct propagates until the function call or loop it targets.
         Value evaluateStatement(const BoundStatement* statement)
         {
-            if(auto declaration_statement = dynamic_cast<const BoundDeclarationStatement*>(statement))
-                return evaluateDeclaration(declaration_statement->getDeclaration());
+            switch(statement->getKind())
+            {
+            case BoundNode::Kind::DeclarationStatement:
+                return evaluateDeclaration(static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration());
             
-            else if(auto expression_statement = dynamic_cast<const BoundExpressionStatement*>(statement))
-                return (evaluateExpression(expression_statement->getExpression()), PrimitiveValue::voidValue);
+            case BoundNode::Kind::ExpressionStatement:
+                return (evaluateExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression()), PrimitiveValue::voidValue);
+
+            case BoundNode::Kind::ReturnStatement:
+            {
+                auto return_statement = static_cast<const BoundReturnStatement*>(statement);
+                auto value = return_statement->getExpression()? evaluateExpression(return_statement->getExpression()): PrimitiveValue::voidValue;
 
-            else if(auto return_statement = dynamic_cast<const BoundReturnStatement*>(statement))
-                throw ReturnException{return_statement->getExpression()? evaluateExpression(return_statement->getExpression()): PrimitiveValue::voidValue};
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
 
-            else if(auto break_statement = dynamic_cast<const BoundBreakStatement*>(statement))
-                throw BreakException{break_statement->getLabel()};
+                assign(m_returnValue, value);
+                m_completion = Completion::Return;
+                return PrimitiveValue::voidValue;
+            }
+            case BoundNode::Kind::BreakStatement:
+                m_completion = Completion::Break;
+                m_completionLabel = static_cast<const BoundBreakStatement*>(statement)->getLabel();
+                return PrimitiveValue::voidValue;
 
-            else if(auto continue_statement = dynamic_cast<const BoundContinueStatement*>(statement))
-                throw ContinueException{continue_statement->getLabel()};
+            case BoundNode::Kind::ContinueStatement:
+                m_completion = Completion::Continue;
+                m_completionLabel = static_cast<const BoundContinueStatement*>(statement)->getLabel();
+                return PrimitiveValue::voidValue;
 
-            else
-            {
+            default:
                 throw LINC_EXCEPTION("Encountered unrecognized statement type while evaluating program"); 
-                return PrimitiveValue::invalidValue;
             }
         }
 
         Value evaluateDeclaration(const BoundDeclaration* declaration)
         {
-            if(auto variable_declaration = dynamic_cast<const BoundVariableDeclaration*>(declaration))
+            switch(declaration->getKind())
+            {
+            case BoundNode::Kind::VariableDeclaration:
             {
+                auto variable_declaration = static_cast<const BoundVariableDeclaration*>(declaration);
                 auto value = variable_declaration->getDefaultValue()? evaluateExpression(*variable_declaration->getDefaultValue()):
                     Value::fromDefault(variable_declaration->getActualType());
-                m_variables.append(variable_declaration->getName(), value);
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                assign(getSlot(variable_declaration->getSlot()), value);
 
                 return PrimitiveValue::voidValue;
             }
-            else if(auto function_declaration = dynamic_cast<const BoundFunctionDeclaration*>(declaration))
+            case BoundNode::Kind::FunctionDeclaration:
             {
-                m_functions.append(function_declaration->getName(), function_declaration->getBody()->clone());
+                auto function_declaration = static_cast<const BoundFunctionDeclaration*>(declaration);
+                const auto index = function_declaration->getIndex();
+
+                if(m_functions.size() <= index)
+                    m_functions.resize(index + 1ul);
+
+                m_functions[index] = Function{
+                    .body = function_declaration->getSharedBody(),
+                    .depth = function_declaration->getDepth(),
+                    .frameSize = function_declaration->getFrameSize(),
+                    .pure = function_declaration->isPure()
+                };
                 return PrimitiveValue::voidValue;
             }
-            else if(dynamic_cast<const BoundExternalDeclaration*>(declaration))
-                return PrimitiveValue::voidValue;
-            else if(dynamic_cast<const BoundStructureDeclaration*>(declaration))
+            case BoundNode::Kind::ExternalDeclaration:
+            case BoundNode::Kind::StructureDeclaration:
                 return PrimitiveValue::voidValue;
-            else if(auto enumeration_declaration = dynamic_cast<const BoundEnumerationDeclaration*>(declaration))
+            case BoundNode::Kind::EnumerationDeclaration:
             {
+                auto enumeration_declaration = static_cast<const BoundEnumerationDeclaration*>(declaration);
                 m_enumerations.append(enumeration_declaration->getName(), enumeration_declaration->getActualType().enumeration);
                 return PrimitiveValue::voidValue;
             }
-            else
-            {
+            default:
                 throw LINC_EXCEPTION("Encountered unrecognized declaration type while evaluating program"); 
-                return PrimitiveValue::invalidValue;
             }
         }
 
         Value evaluateExpression(const BoundExpression* expression)
         {
-            if(auto literal_expression = dynamic_cast<const BoundLiteralExpression*>(expression))
+            switch(expression->getKind())
             {
+            case BoundNode::Kind::LiteralExpression:
+            {
+                auto literal_expression = static_cast<const BoundLiteralExpression*>(expression);
                 return literal_expression->getValue();
             }
-            else if(auto block_expression = dynamic_cast<const BoundBlockExpression*>(expression))
+            case BoundNode::Kind::BlockExpression:
             {
+                auto block_expression = static_cast<const BoundBlockExpression*>(expression);
                 Value value = PrimitiveValue::voidValue; 
-                beginScope();
+                const bool scoped = block_expression->hasScopedDeclarations();
+                
+                if(scoped)
+                    beginScope();
+
                 for(std::size_t i{0ul}; i < block_expression->getStatements().size(); ++i)
                 {
                     const auto& statement = block_expression->getStatements()[i];
                     evaluateStatement(statement.get());
+
+                    if(interrupted())
+                        break;
                 }
                 
-                value = block_expression->getTail()? evaluateExpression(block_expression->getTail()): value;
-                endScope();
+                if(block_expression->getTail() && !interrupted())
+                    value = evaluateExpression(block_expression->getTail());
+                
+                if(scoped)
+                    endScope();
+
                 return value;
             }
-            else if(auto if_expression = dynamic_cast<const BoundIfExpression*>(expression))
+            case BoundNode::Kind::IfExpression:
             {
-                auto test = evaluateExpression(if_expression->getTestExpression()).getPrimitive().getBool();
+                auto if_expression = static_cast<const BoundIfExpression*>(expression);
+                auto test = evaluateExpression(if_expression->getTestExpression());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
 
-                if(test)
+                if(test.getPrimitive().getBool())
                     return evaluateExpression(if_expression->getIfBody());
                 else if(if_expression->hasElse())
                     return evaluateExpression(if_expression->getElseBody());
                 else return PrimitiveValue::voidValue;
             }
-            else if(auto for_expression = dynamic_cast<const BoundForExpression*>(expression))
+            case BoundNode::Kind::ForExpression:
             {
-                beginScope();
+                auto for_expression = static_cast<const BoundForExpression*>(expression);
                 const auto& specifier = for_expression->getSpecifier();
 
                 if(auto variable_specifier = std::get_if<const BoundForExpression::BoundVariableForSpecifier>(&specifier))
@@ -197,89 +320,75 @@ namespace linc
                     evaluateDeclaration(variable_specifier->variableDeclaration.get());
                     Value return_value = PrimitiveValue::voidValue;
 
-                    for(;evaluateExpression(variable_specifier->expression.get()).getPrimitive().getBool();
+                    for(;!interrupted() && evaluateCondition(variable_specifier->expression.get());
                         evaluateStatement(variable_specifier->statement.get()))
                     {
-                        try
-                        {
-                            return_value = evaluateExpression(for_expression->getBody());
-                        }
-                        catch(const BreakException& break_exception)
-                        {
-                            if(for_expression->getLabel() == break_exception.label || break_exception.label.empty())
-                                break;
-                            else throw break_exception;
-                        }
-                        catch(const ContinueException& continue_exception)
-                        {
-                            if(for_expression->getLabel() == continue_exception.label || continue_exception.label.empty())
-                                continue;
-                            else throw continue_exception;
-                        }
+                        auto value = evaluateExpression(for_expression->getBody());
+
+                        if(!interrupted())
+                            return_value = value;
+                        else if(exitsLoop(for_expression->getLabel()))
+                            break;
                     }
-                    endScope();
+
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+
                     return return_value;
                 }
                 else if(auto range_specifier = std::get_if<const BoundForExpression::BoundRangeForSpecifier>(&specifier))
                 {
-                    auto variable = m_variables.get(range_specifier->arrayIdentifier->getValue());
-                    auto type = range_specifier->arrayIdentifier->getType();
-                    std::size_t count{};
-                    ArrayValue array(Types::voidType, 0ul);
+                    auto variable = findVariable(range_specifier->arrayIdentifier.get());
+                    auto value_slot = range_specifier->valueIdentifier->getSlot();
+                    const auto& type = range_specifier->arrayIdentifier->getType();
+                    const bool is_string = type.kind == Types::type::Kind::Primitive && type.primitive == Types::Kind::string;
 
-                    if(type.kind == Types::type::Kind::Primitive && type.primitive == Types::Kind::string)
-                    {
-                        auto string = variable->getPrimitive().getString();
+                    if(!variable || !value_slot || (!is_string && type.kind != Types::type::Kind::Array))
+                        return PrimitiveValue::invalidValue;
 
-                        count = string.size();
-                        array = ArrayValue(std::vector<char>(string.c_str(), string.c_str() + count));
-                    }
-                    else if(type.kind == Types::type::Kind::Array)
-                    {
-                        count = variable->getArray().getCount();
-                        array = variable->getArray();
-                    }
-                    else return (endScope(), PrimitiveValue::invalidValue);
+                    // The loop iterates over the value the container had when it began (copying it only shares its storage).
+                    const Value container{*variable};
+                    const auto count = is_string? container.getPrimitive().getStringReference().size(): container.getArray().getCount();
                     Value return_value{PrimitiveValue::voidValue};
-                    
-                    m_variables.append(range_specifier->valueIdentifier->getValue(), PrimitiveValue::voidValue);
 
                     for(std::size_t i{0ul}; i < count; ++i)
                     {
-                        *m_variables.get(range_specifier->valueIdentifier->getValue()) = array.get(i);
-                        return_value = evaluateExpression(for_expression->getBody());
+                        assign(getSlot(*value_slot), is_string? Value(PrimitiveValue(container.getPrimitive().getStringReference()[i])):
+                            container.getArray().get(i));
+                        auto value = evaluateExpression(for_expression->getBody());
+
+                        if(!interrupted())
+                            return_value = value;
+                        else if(exitsLoop(for_expression->getLabel()))
+                            break;
                     }
 
-                    endScope();
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+
                     return return_value;
                 }
-                else return (endScope(), PrimitiveValue::invalidValue);
+                else return PrimitiveValue::invalidValue;
             }
-            else if(auto while_expression = dynamic_cast<const BoundWhileExpression*>(expression))
+            case BoundNode::Kind::WhileExpression:
             {
+                auto while_expression = static_cast<const BoundWhileExpression*>(expression);
                 Value return_value = PrimitiveValue::voidValue;
                 bool evaluated{false};
 
-                while(evaluateExpression(while_expression->getTestExpression()).getPrimitive().getBool())
+                while(evaluateCondition(while_expression->getTestExpression()))
                 {
                     evaluated = true;
-                    try
-                    {
-                        return_value = evaluateExpression(while_expression->getWhileBody());
-                    }
-                    catch(const BreakException& break_exception)
-                    {
-                        if(while_expression->getLabel() == break_exception.label || break_exception.label.empty())
-                            break;
-                        else throw break_exception;
-                    }
-                    catch(const ContinueException& continue_exception)
-                    {
-                        if(while_expression->getLabel() == continue_exception.label || continue_exception.label.empty())
-                            continue;
-                        else throw continue_exception;
-                    }
+                    auto value = evaluateExpression(while_expression->getWhileBody());
+
+                    if(!interrupted())
+                        return_value = value;
+                    else if(exitsLoop(while_expression->getLabel()))
+                        break;
                 }
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
                 
                 auto finally = while_expression->getFinallyBody();
                 auto _else = while_expression->getElseBody();
@@ -291,75 +400,134 @@ namespace linc
 
                 return return_value;
             }
-            else if(auto match_expression = dynamic_cast<const BoundMatchExpression*>(expression))
+            case BoundNode::Kind::MatchExpression:
             {
+                auto match_expression = static_cast<const BoundMatchExpression*>(expression);
                 auto test_expression = evaluateExpression(match_expression->getTestExpression());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                auto bind = [&, this](const BoundExpression* value)
+                {
+                    if(test_expression.getKind() != Value::Kind::Enumerator) return;
+                    if(value->getKind() != BoundNode::Kind::EnumeratorExpression
+                    || match_expression->getTestExpression()->getType().kind != Types::type::Kind::Enumeration) return;
+                    auto enumerator = static_cast<const BoundEnumeratorExpression*>(value);
+                    if(!enumerator->bindsValue() || enumerator->getValue()->getKind() != BoundNode::Kind::IdentifierExpression) return;
+                    auto variable = findVariable(static_cast<const BoundIdentifierExpression*>(enumerator->getValue()));
+                    if(variable) assign(*variable, test_expression.getEnumerator().getValue());
+                };
+
+                if(const auto& dispatch = match_expression->getDispatch())
+                {
+                    auto clause_index = BoundMatchExpression::Dispatch::noClause;
+
+                    if(test_expression.getKind() == Value::Kind::Enumerator)
+                        clause_index = dispatch->find(test_expression.getEnumerator().getIndex());
+                    else if(dispatch->kind == BoundMatchExpression::Dispatch::Kind::Hash)
+                        clause_index = dispatch->find(test_expression.getPrimitive().getStringReference());
+                    else if(auto key = BoundMatchExpression::Dispatch::getKey(test_expression.getPrimitive()))
+                        clause_index = dispatch->find(*key);
+
+                    if(clause_index == BoundMatchExpression::Dispatch::noClause)
+                        return Value::fromDefault(match_expression->getType());
+
+                    const auto& clause = match_expression->getClauses()->getList()[clause_index];
+                    for(const auto& value: clause->getValues()->getList())
+                        bind(value.get());
+
+                    return evaluateExpression(clause->getExpression());
+                }
+
                 for(const auto& clause: match_expression->getClauses()->getList())
                 {
                     for(const auto& value: clause->getValues()->getList())
                     {
-                        beginScope();
-                        [&, this]()
-                        {
-                            if(!test_expression.getIfEnumerator()) return;
-                            auto enumerator = dynamic_cast<const BoundEnumeratorExpression*>(value.get());
-                            if(!enumerator || match_expression->getTestExpression()->getType().kind != Types::type::Kind::Enumeration) return;
-                            auto identifier = dynamic_cast<const BoundIdentifierExpression*>(enumerator->getValue());
-                            if(!identifier || m_variables.find(identifier->getValue())) return;
-                            m_variables.append(identifier->getValue(), test_expression.getEnumerator().getValue());    
-                        }();
-                        if(evaluateExpression(value.get()) == test_expression)
-                        {
-                            auto result = evaluateExpression(clause->getExpression());
-                            endScope();
-                            return result;
-                        }
-                        else endScope();
+                        bind(value.get());
+                        auto clause_value = evaluateExpression(value.get());
+
+                        if(interrupted())
+                            return PrimitiveValue::voidValue;
+
+                        if(clause_value == test_expression)
+                            return evaluateExpression(clause->getExpression());
                     }
                 }
                 return Value::fromDefault(match_expression->getType());
             }
-            else if(auto binary_expression = dynamic_cast<const BoundBinaryExpression*>(expression))
+            case BoundNode::Kind::BinaryExpression:
             {
+                auto binary_expression = static_cast<const BoundBinaryExpression*>(expression);
                 Value result = Value::fromDefault(binary_expression->getType());
                 
-                if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalAnd)
-                {
-                    if(evaluateExpression(binary_expression->getLeft()).getPrimitive().getBool())
-                        return PrimitiveValue(evaluateExpression(binary_expression->getRight()).getPrimitive().getBool());
-                    else return PrimitiveValue(false);
-                }
-                else if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalOr)
-                {
-                    if(evaluateExpression(binary_expression->getLeft()).getPrimitive().getBool())
-                        return PrimitiveValue(true);
-                    else return PrimitiveValue(evaluateExpression(binary_expression->getRight()).getPrimitive().getBool());
-                }
-                else if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::Addition)
+                if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalAnd
+                || binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalOr)
                 {
+                    const bool is_or = binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalOr;
                     auto left = evaluateExpression(binary_expression->getLeft());
+
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+                    else if(left.getPrimitive().getBool() == is_or)
+                        return PrimitiveValue(is_or);
+
                     auto right = evaluateExpression(binary_expression->getRight());
 
-                    result = left + right;
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+
+                    return PrimitiveValue(right.getPrimitive().getBool());
                 }
 
-                auto left = evaluateExpression(binary_expression->getLeft());
-                auto right = evaluateExpression(binary_expression->getRight());
+                const auto& type = binary_expression->getType();
+                const auto target = binary_expression->getLeft(), operand = binary_expression->getRight();
 
                 switch(binary_expression->getOperator()->getKind())
                 {
                 case BoundBinaryOperator::Kind::Assignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), right);
+                    return evaluateMutableOperator(type, target, operand, [](const Reference&, const Value& right){ return right; });
                 case BoundBinaryOperator::Kind::AdditionAssignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), left + right);
+                    return evaluateMutableOperator(type, target, operand, [](const Reference& left, const Value& right){ return load(left) + right; });
                 case BoundBinaryOperator::Kind::SubtractionAssignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), left.getPrimitive() - right.getPrimitive());
+                    return evaluateMutableOperator(type, target, operand, [](const Reference& left, const Value& right)
+                        { return Value(load(left).getPrimitive() - right.getPrimitive()); });
                 case BoundBinaryOperator::Kind::MultiplicationAssignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), left.getPrimitive() * right.getPrimitive());
+                    return evaluateMutableOperator(type, target, operand, [](const Reference& left, const Value& right)
+                        { return Value(load(left).getPrimitive() * right.getPrimitive()); });
                 case BoundBinaryOperator::Kind::DivisionAssignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), left.getPrimitive() / right.getPrimitive());
+                    return evaluateMutableOperator(type, target, operand, [&](const Reference& left, const Value& right)
+                    {
+                        auto value = load(left);
+                        return abandonDivergent(BoundBinaryOperator::Kind::Division, type.primitive, value, right)?
+                            value: Value(value.getPrimitive() / right.getPrimitive());
+                    });
                 case BoundBinaryOperator::Kind::ModuloAssignment:
-                    return evaluateMutableOperator(binary_expression->getType(), binary_expression->getLeft(), left.getPrimitive() % right.getPrimitive());
+                    return evaluateMutableOperator(type, target, operand, [&](const Reference& left, const Value& right)
+                    {
+                        auto value = load(left);
+                        return abandonDivergent(BoundBinaryOperator::Kind::Modulo, type.primitive, value, right)?
+                            value: Value(value.getPrimitive() % right.getPrimitive());
+                    });
+                default: break;
+                }
+
+                auto left = evaluateExpression(binary_expression->getLeft());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                auto right = evaluateExpression(binary_expression->getRight());
+
+                if(interrupted() || abandonDivergent(binary_expression->getOperator()->getKind(),
+                    binary_expression->getLeft()->getType().primitive, left, right))
+                    return PrimitiveValue::voidValue;
+
+                switch(binary_expression->getOperator()->getKind())
+                {
+                case BoundBinaryOperator::Kind::Addition:
+                    result = left + right;
+                    break;
                 case BoundBinaryOperator::Kind::Subtraction:
                     result = left - right;
                     break;
@@ -420,35 +588,41 @@ namespace linc
                 default: break;
                 }
 
-                if(result.getIfPrimitive() && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
+                if(result.getKind() == Value::Kind::Primitive && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
                     || result.getPrimitive().getKind() == PrimitiveValue::Kind::Unsigned))
                     return result.getPrimitive().convert(binary_expression->getType().primitive);
                 else return result;
             }
-            else if(auto unary_expression = dynamic_cast<const BoundUnaryExpression*>(expression))
+            case BoundNode::Kind::UnaryExpression:
             {
+                auto unary_expression = static_cast<const BoundUnaryExpression*>(expression);
                 Value result = PrimitiveValue::fromDefault(unary_expression->getType().primitive);
                 
                 if(unary_expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Typeof)
                     return PrimitiveValue(unary_expression->getOperand()->getType());
 
+                else if(unary_expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Increment
+                || unary_expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Decrement)
+                {
+                    const bool increment = unary_expression->getOperator()->getKind() == BoundUnaryOperator::Kind::Increment;
+                    const Value one = PrimitiveValue{1}.convert(unary_expression->getType().primitive);
+
+                    return evaluateMutableOperator(unary_expression->getType(), unary_expression->getOperand(), nullptr,
+                        [&](const Reference& operand, const Value&){ return increment? load(operand) + one: load(operand) - one; });
+                }
+
                 auto operand = evaluateExpression(unary_expression->getOperand());
 
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
                 switch(unary_expression->getOperator()->getKind())
                 {
-                case BoundUnaryOperator::Kind::Increment:
-                    result = evaluateMutableOperator(unary_expression->getType(), unary_expression->getOperand(),
-                        operand + PrimitiveValue{1}.convert(unary_expression->getType().primitive));
-                    break;
-                case BoundUnaryOperator::Kind::Decrement:
-                    result = evaluateMutableOperator(unary_expression->getType(), unary_expression->getOperand(), 
-                        operand - PrimitiveValue{1}.convert(unary_expression->getType().primitive));
-                    break;
                 case BoundUnaryOperator::Kind::Stringify:
                     result = PrimitiveValue(operand.toApplicationString());
                     break;
                 case BoundUnaryOperator::Kind::UnaryPlus:
-                    if(operand.getIfArray())
+                    if(operand.getKind() == Value::Kind::Array)
                         result = PrimitiveValue(operand.getArray().getCount());
                     else if(operand.getPrimitive().getKind() == PrimitiveValue::Kind::String)
                         result = PrimitiveValue(static_cast<Types::u64>(operand.getPrimitive().getString().size()));
@@ -471,27 +645,18 @@ namespace linc
                     result = PrimitiveValue::invalidValue;
                 }
 
-                if(result.getIfPrimitive() && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
+                if(result.getKind() == Value::Kind::Primitive && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
                     || result.getPrimitive().getKind() == PrimitiveValue::Kind::Unsigned))
                     return result.getPrimitive().convert(unary_expression->getType().primitive);
                 else return result;
             }
-            else if(auto identifier_expression = dynamic_cast<const BoundIdentifierExpression*>(expression))
+            case BoundNode::Kind::IdentifierExpression:
             {
+                auto identifier_expression = static_cast<const BoundIdentifierExpression*>(expression);
                 if(identifier_expression->getType().kind == Types::type::Kind::Function)
-                {
-                    auto find = m_functions.get(identifier_expression->getValue());
-
-                    if(!find)
-                        return (Reporting::push(Reporting::Report{
-                            .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                            .message = Logger::format("Function `$` does not exist!", identifier_expression->getValue())
-                        }), PrimitiveValue::invalidValue);
-
                     return PrimitiveValue::voidValue;
-                }
 
-                auto find = m_variables.find(identifier_expression->getValue());
+                auto find = findVariable(identifier_expression);
                 
                 if(!find)
                     return (Reporting::push(Reporting::Report{
@@ -501,209 +666,206 @@ namespace linc
 
                 return *find;
             }
-            else if(auto type_expression = dynamic_cast<const BoundTypeExpression*>(expression))
+            case BoundNode::Kind::TypeExpression:
             {
+                auto type_expression = static_cast<const BoundTypeExpression*>(expression);
                 return PrimitiveValue(type_expression->getActualType());
             }
-            else if(auto function_call_expression = dynamic_cast<const BoundFunctionCallExpression*>(expression))
+            case BoundNode::Kind::FunctionCallExpression:
             {
-                beginScope();
-                for(const auto& argument: function_call_expression->getArguments())
+                auto function_call_expression = static_cast<const BoundFunctionCallExpression*>(expression);
+                const auto& index = function_call_expression->getIndex();
+
+                if(exhausted())
+                    return PrimitiveValue::voidValue;
+
+                if(!index || *index >= m_functions.size() || !m_functions[*index].body)
+                    return (Reporting::push(Reporting::Report{
+                        .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
+                        .message = Logger::format("Function `$` does not exist!", function_call_expression->getName())
+                    }), PrimitiveValue::invalidValue);
+
+                // Read out of the table up front, since declarations evaluated by the call may grow it (the table keeps the body alive).
+                const auto* body = m_functions[*index].body.get();
+                const auto depth = m_functions[*index].depth, frame_size = m_functions[*index].frameSize;
+                const auto& arguments = function_call_expression->getArguments();
+                
+                // The callee's frame is reserved before its arguments are evaluated, so that calls made while evaluating them
+                // are stacked on top of it. The arguments occupy the first slots of the frame.
+                const auto base = m_locals.size();
+                m_locals.resize(base + std::max<std::size_t>(frame_size, arguments.size()), Value(PrimitiveValue::voidValue));
+
+                for(std::size_t i{0ul}; i < arguments.size(); ++i)
                 {
-                    auto value = evaluateExpression(argument.value.get());
-                    m_variables.append(argument.name, value);
+                    auto value = evaluateExpression(arguments[i].value.get());
+
+                    if(interrupted())
+                    {
+                        m_locals.erase(m_locals.begin() + base, m_locals.end());
+                        return PrimitiveValue::voidValue;
+                    }
+
+                    assign(m_locals[base + i], value);
                 }
 
-                try
+                // the result of a pure function only depends on its arguments, so it is looked up before calling it
+                auto call = m_memoizationCapacity != 0ul && m_functions[*index].pure? keyCall(*index, base, arguments.size()): std::nullopt;
+
+                if(call)
                 {
-                    auto result = evaluateExpression(m_functions.get(function_call_expression->getName())->get());
-                    endScope();
-                    return result;
+                    if(auto find = m_memoized.find(*call); find != m_memoized.end())
+                    {
+                        ++m_memoizationStatistics.hits;
+                        m_memoizationOrder.splice(m_memoizationOrder.begin(), m_memoizationOrder, find->second.use);
+                        m_locals.erase(m_locals.begin() + base, m_locals.end());
+                        return find->second.value;
+                    }
+                    else ++m_memoizationStatistics.misses;
                 }
-                catch(const ReturnException& return_exception)
+
+                if(m_frames.size() <= depth)
+                    m_frames.resize(depth + 1ul);
+
+                const auto previous_base = std::exchange(m_frames[depth], base);
+                auto result = evaluateExpression(body);
+                
+                m_frames[depth] = previous_base;
+                m_locals.erase(m_locals.begin() + base, m_locals.end());
+
+                if(m_completion == Completion::Return)
                 {
-                    endScope();
-                    return return_exception.returnValue;
+                    m_completion = Completion::Normal;
+
+                    if(call)
+                        memoize(std::move(*call), m_returnValue);
+
+                    return m_returnValue;
                 }
+
+                if(call && !interrupted())
+                    memoize(std::move(*call), result);
+
+                return result;
             }
-            else if(auto external_call = dynamic_cast<const BoundExternalCallExpression*>(expression))
+            case BoundNode::Kind::ExternalCallExpression:
             {
+                auto external_call = static_cast<const BoundExternalCallExpression*>(expression);
                 const auto& name = external_call->getName();
-                
-                if(name == "puts")
-                {
-                    fputs(evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getString().c_str(), stdout);
-                    return PrimitiveValue::voidValue;
-                }
-                else if(name == "putln")
-                {
-                    fputs((evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getString() + '\n').c_str(), stdout);
-                    return PrimitiveValue::voidValue;
-                }
-                else if(name == "putc")
-                {
-                    fputc(evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getChar(), stdout);
-                    return PrimitiveValue::voidValue;
-                }
-                else if(name == "readc")
-                {
-                    return PrimitiveValue(static_cast<char>(std::getchar()));
-                }
-                else if(name == "readraw")
-                {
-                    std::string result;
-                    std::getline(std::cin, result);
-                    return linc::PrimitiveValue(result);
-                }
-                else if(name == "readln")
-                {
-                    auto prompt = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getString();
-                    return linc::PrimitiveValue(Logger::read(prompt));
-                }
-                else if(name == "sys_write")
-                {
-                #ifdef LINC_LINUX                        
-                    auto file_descriptor = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive();
-                    auto string = evaluateExpression(external_call->getArguments().at(1ul).get()).getPrimitive();
-                    auto size = evaluateExpression(external_call->getArguments().at(2ul).get()).getPrimitive();
-                    auto result = syscall(SYS_write, file_descriptor.getI32(), string.getString().c_str(), size.getU64());
-                    return PrimitiveValue(result < 0? -errno: result);
-
-                #else
-                    return PrimitiveValue::invalidValue;
-                #endif
-                }
-                else if(name == "sys_exit")
-                {
-                #ifdef LINC_LINUX                    
-                    auto arg_0 = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive();
-                    auto result = syscall(SYS_exit, arg_0.getI32());
-                    return PrimitiveValue(result < 0? -errno: result);
-                #else
-                    return PrimitiveValue::invalidValue;
-                #endif
-                }
-                else if(name == "sys_open")
-                {
-                #ifdef LINC_LINUX
-                    auto filename = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getString();
-                    auto flags = evaluateExpression(external_call->getArguments().at(1ul).get()).getPrimitive().getI32();
-                    auto mode = evaluateExpression(external_call->getArguments().at(2ul).get()).getPrimitive().getU16();
-
-                    auto result = syscall(SYS_open, filename.c_str(), flags, mode);
-                    return PrimitiveValue(result < 0? -errno: result);
-                #else
-                    return PrimitiveValue::invalidValue;
-                #endif
-                }
-                else if(name == "sys_read")
-                {
-                #ifdef LINC_LINUX
-                    auto identifier = dynamic_cast<const BoundIdentifierExpression*>(external_call->getArguments().at(1ul).get());
-                    if(!identifier)
-                        return (Reporting::push(Reporting::Report{
-                            .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                            .message = "String argument in sys_read must be an identifier"
-                        }), PrimitiveValue::invalidValue);
-
-                    auto file = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getI32();
-                    auto buffer = evaluateExpression(external_call->getArguments().at(1ul).get()).getPrimitive().getString();
-                    auto count = evaluateExpression(external_call->getArguments().at(2ul).get()).getPrimitive().getU64();
-                    buffer.resize(count);
+                std::vector<Value> arguments;
+                arguments.reserve(external_call->getArguments().size());
 
-                    auto result = syscall(SYS_read, file, &buffer[0ul], count);
+                if(name == "sys_read" && (external_call->getArguments().size() < 2ul
+                || external_call->getArguments().at(1ul)->getKind() != BoundNode::Kind::IdentifierExpression))
+                    return (Reporting::push(Reporting::Report{
+                        .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
+                        .message = "String argument in sys_read must be an identifier"
+                    }), PrimitiveValue::invalidValue);
 
-                    *m_variables.get(identifier->getValue()) = PrimitiveValue(buffer);
-                    return PrimitiveValue(result < 0? -errno: result);
-                #else
-                    return PrimitiveValue::invalidValue;
-                #endif
-                }
-                else if(name == "sys_close")
+                for(const auto& argument: external_call->getArguments())
                 {
-                #ifdef LINC_LINUX
-                    auto file_descriptor = evaluateExpression(external_call->getArguments().at(0ul).get()).getPrimitive().getI32();
-                    auto result = syscall(SYS_close, file_descriptor);
-                    return PrimitiveValue(result < 0? -errno: result);
-                #else
-                    return PrimitiveValue::invalidValue;
-                #endif
-                }
-                else if(name == "system")
-                {
-                    class Deleter
-                    {
-                    public:
-                        inline void operator()(std::FILE* file){ pclose(file); }
-                    };
+                    arguments.push_back(evaluateExpression(argument.get()));
 
-                    static std::array<char, 128ul> buffer;
-                    auto argument = evaluateExpression(external_call->getArguments().at(0ul).get());
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+                }
 
-                    std::string result, command = argument.getPrimitive().getString();
+                auto result = evaluateExternalCall(name, arguments);
 
-                    std::unique_ptr<std::FILE, Deleter> pipe(popen(command.c_str(), "r"));
+                if(name == "sys_read")
+                {
+                    auto identifier = static_cast<const BoundIdentifierExpression*>(external_call->getArguments().at(1ul).get());
                     
-                    if(!pipe)
-                        return (Reporting::push(Reporting::Report{
-                            .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                            .message = Logger::format("Failed to open pipe while evaluating shell expression (with command '$').", command)
-                        }), PrimitiveValue::invalidValue);
-
-                    while(std::fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) result += buffer.data();
-                    return PrimitiveValue(result);
+                    if(auto variable = findVariable(identifier))
+                        assign(*variable, arguments.at(1ul));
                 }
-                
-                Reporting::push(Reporting::Report{
-                    .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                    .message = Logger::format("Internal function `$` has not been implemented.", name)
-                });
 
-                return PrimitiveValue::invalidValue;
+                return result;
             }
-            else if(auto conversion_expression = dynamic_cast<const BoundConversionExpression*>(expression))
+            case BoundNode::Kind::ConversionExpression:
             {
+                auto conversion_expression = static_cast<const BoundConversionExpression*>(expression);
                 auto value = evaluateExpression(conversion_expression->getExpression());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
                 return value.getPrimitive().convert(conversion_expression->getType().primitive);
             }
-            else if(auto array_initializer_expression = dynamic_cast<const BoundArrayInitializerExpression*>(expression))
+            case BoundNode::Kind::ArrayInitializerExpression:
             {
+                auto array_initializer_expression = static_cast<const BoundArrayInitializerExpression*>(expression);
                 ArrayValue result = ArrayValue::fromDefault(*expression->getType().array.baseType);
 
                 for(const auto& value: array_initializer_expression->getValues())
+                {
                     result.push(evaluateExpression(value.get()));
 
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+                }
+
                 return std::move(result);
             }
-            else if(auto structure_initializer_expression = dynamic_cast<const BoundStructureInitializerExpression*>(expression))
+            case BoundNode::Kind::StructureInitializerExpression:
             {
+                auto structure_initializer_expression = static_cast<const BoundStructureInitializerExpression*>(expression);
                 std::vector<Value> values;
 
                 for(const auto& value: structure_initializer_expression->getFields())
+                {
                     values.push_back(evaluateExpression(value.get()));
 
+                    if(interrupted())
+                        return PrimitiveValue::voidValue;
+                }
+
                 return Value(std::move(values));
             }
-            else if(auto index_expression = dynamic_cast<const BoundIndexExpression*>(expression))
+            case BoundNode::Kind::IndexExpression:
             {
-                auto array = evaluateExpression(index_expression->getArray());
+                auto index_expression = static_cast<const BoundIndexExpression*>(expression);
+
+                if(auto path = evaluatePath(index_expression))
+                    return loadPath(*path);
+                else if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                const auto array = evaluateExpression(index_expression->getArray());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
                 auto index = evaluateExpression(index_expression->getIndex());
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
                 auto type = index_expression->getArray()->getType();
 
                 if(type.kind == Types::type::Kind::Primitive && type.primitive == Types::Kind::string)
-                    return PrimitiveValue(array.getPrimitive().getString().at(index.getPrimitive().getU64()));
+                    return PrimitiveValue(array.getPrimitive().getStringReference().at(index.getPrimitive().getU64()));
 
                 else if(type.kind == Types::type::Kind::Array)
                     return array.getArray().get(index.getPrimitive().getU64());
                 
                 else return PrimitiveValue::invalidValue;
             }
-            else if(auto access_expression = dynamic_cast<const BoundAccessExpression*>(expression))
+            case BoundNode::Kind::AccessExpression:
             {
-                auto base = evaluateExpression(access_expression->getBase());
+                auto access_expression = static_cast<const BoundAccessExpression*>(expression);
+
+                if(auto path = evaluatePath(access_expression))
+                    return loadPath(*path);
+                else if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                const auto base = evaluateExpression(access_expression->getBase());
                 auto index = access_expression->getIndex();
 
-                if(!base.getIfStructure())
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
+
+                if(base.getKind() != Value::Kind::Structure)
                     return (Reporting::push(Reporting::Report{
                         .type = Reporting::Type::Info, .stage = Reporting::Stage::Generator,
                         .message = "Tried to evaluate access expression on non structure operand."
@@ -717,38 +879,48 @@ namespace linc
 
                 return base.getStructure().at(index);
             }
-            else if(auto enumerator_expression = dynamic_cast<const BoundEnumeratorExpression*>(expression))
+            case BoundNode::Kind::EnumeratorExpression:
             {
+                auto enumerator_expression = static_cast<const BoundEnumeratorExpression*>(expression);
                 auto index = enumerator_expression->getEnumeratorIndex();
                 auto value = enumerator_expression->getValue()? evaluateExpression(enumerator_expression->getValue()): PrimitiveValue::voidValue;
+
+                if(interrupted())
+                    return PrimitiveValue::voidValue;
                 auto name = m_enumerations.get(enumerator_expression->getEnumerationName())->at(enumerator_expression->getEnumeratorIndex()).first;
 
                 return EnumeratorValue(name, index, std::move(value));
             }
-            else
-            {
+            default:
                 throw LINC_EXCEPTION("Encountered unrecognized expression type while evaluating program"); 
-                return PrimitiveValue::invalidValue;
             }
         }
 
         inline void reset()
         {
-            m_variables = ScopeStack<Value>{};
+            m_globals.clear();
+            m_locals.clear();
+            m_frames.clear();
+            m_functions.clear();
+            m_enumerations = ScopeStack<Types::type::Enumeration>{};
+            m_completion = Completion::Normal;
+            m_memoized.clear();
+            m_memoizationOrder.clear();
+            m_memoizationStatistics = MemoizationStatistics{};
         }
 
         static void printNodeTree(const BoundNode* node, std::string indent = "", bool last = true)
         {
             auto marker = last? "└──" : "├──";
             
-            if(auto expression_statement = dynamic_cast<const BoundExpressionStatement*>(node))
+            if(node->getKind() == BoundNode::Kind::ExpressionStatement)
             {
-                printNodeTree(expression_statement->getExpression(), indent, last);
+                printNodeTree(static_cast<const BoundExpressionStatement*>(node)->getExpression(), indent, last);
                 return;
             }
-            else if(auto declaration_statement = dynamic_cast<const BoundDeclarationStatement*>(node))
+            else if(node->getKind() == BoundNode::Kind::DeclarationStatement)
             {
-                printNodeTree(declaration_statement->getDeclaration(), indent, last);
+                printNodeTree(static_cast<const BoundDeclarationStatement*>(node)->getDeclaration(), indent, last);
                 return;
             }
 
@@ -760,91 +932,605 @@ namespace linc
             for(auto child: node->getChildren())
                 printNodeTree(child, indent, child == last_child);
         }
-    private:
-        Value evaluateMutableOperator(const Types::type& type, const BoundExpression* expression, const Value& new_value)
-        {
-            Value result = Value::fromDefault(type);
 
-            if(auto identifier = dynamic_cast<const BoundIdentifierExpression*>(expression))
+        /// @brief Invoke one of the internal functions backing external declarations, using already evaluated arguments.
+        /// @param name The name of the internal function.
+        /// @param arguments The argument values. `sys_read` stores the buffer it read in place of its second argument.
+        /// @return The value returned by the internal function.
+        static Value evaluateExternalCall(const std::string& name, std::vector<Value>& arguments)
+        {
+            if(name == "puts")
+            {
+                fputs(arguments.at(0ul).getPrimitive().getString().c_str(), stdout);
+                return PrimitiveValue::voidValue;
+            }
+            else if(name == "putln")
+            {
+                fputs((arguments.at(0ul).getPrimitive().getString() + '\n').c_str(), stdout);
+                return PrimitiveValue::voidValue;
+            }
+            else if(name == "putc")
+            {
+                fputc(arguments.at(0ul).getPrimitive().getChar(), stdout);
+                return PrimitiveValue::voidValue;
+            }
+            else if(name == "readc")
+            {
+                return PrimitiveValue(static_cast<char>(std::getchar()));
+            }
+            else if(name == "readraw")
+            {
+                std::string result;
+                std::getline(std::cin, result);
+                return linc::PrimitiveValue(result);
+            }
+            else if(name == "readln")
+            {
+                auto prompt = arguments.at(0ul).getPrimitive().getString();
+                return linc::PrimitiveValue(Logger::read(prompt));
+            }
+            else if(name == "sys_write")
+            {
+            #ifdef LINC_LINUX
+                auto file_descriptor = arguments.at(0ul).getPrimitive();
+                auto string = arguments.at(1ul).getPrimitive();
+                auto size = arguments.at(2ul).getPrimitive();
+                auto result = syscall(SYS_write, file_descriptor.getI32(), string.getString().c_str(), size.getU64());
+                return PrimitiveValue(result < 0? -errno: result);
+
+            #else
+                return PrimitiveValue::invalidValue;
+            #endif
+            }
+            else if(name == "sys_exit")
+            {
+            #ifdef LINC_LINUX
+                auto arg_0 = arguments.at(0ul).getPrimitive();
+                auto result = syscall(SYS_exit, arg_0.getI32());
+                return PrimitiveValue(result < 0? -errno: result);
+            #else
+                return PrimitiveValue::invalidValue;
+            #endif
+            }
+            else if(name == "sys_open")
             {
-                *m_variables.get(identifier->getValue()) = new_value;
-                result = new_value;
+            #ifdef LINC_LINUX
+                auto filename = arguments.at(0ul).getPrimitive().getString();
+                auto flags = arguments.at(1ul).getPrimitive().getI32();
+                auto mode = arguments.at(2ul).getPrimitive().getU16();
+
+                auto result = syscall(SYS_open, filename.c_str(), flags, mode);
+                return PrimitiveValue(result < 0? -errno: result);
+            #else
+                return PrimitiveValue::invalidValue;
+            #endif
             }
-            else if(auto index_expression = dynamic_cast<const BoundIndexExpression*>(expression))
+            else if(name == "sys_read")
             {
-                auto index = evaluateExpression(index_expression->getIndex()).getPrimitive().getU64();
-                auto array = index_expression->getArray();
+            #ifdef LINC_LINUX
+                auto file = arguments.at(0ul).getPrimitive().getI32();
+                auto buffer = arguments.at(1ul).getPrimitive().getString();
+                auto count = arguments.at(2ul).getPrimitive().getU64();
+                buffer.resize(count);
+
+                auto result = syscall(SYS_read, file, &buffer[0ul], count);
 
-                if(auto identifier = dynamic_cast<const BoundIdentifierExpression*>(array))
+                arguments.at(1ul) = PrimitiveValue(buffer);
+                return PrimitiveValue(result < 0? -errno: result);
+            #else
+                return PrimitiveValue::invalidValue;
+            #endif
+            }
+            else if(name == "sys_close")
+            {
+            #ifdef LINC_LINUX
+                auto file_descriptor = arguments.at(0ul).getPrimitive().getI32();
+                auto result = syscall(SYS_close, file_descriptor);
+                return PrimitiveValue(result < 0? -errno: result);
+            #else
+                return PrimitiveValue::invalidValue;
+            #endif
+            }
+            else if(name == "system")
+            {
+                class Deleter
                 {
-                    auto find = m_variables.find(identifier->getValue());
-                    
-                    if(!find)
-                        return PrimitiveValue::invalidValue;
+                public:
+                    inline void operator()(std::FILE* file){ pclose(file); }
+                };
+
+                static std::array<char, 128ul> buffer;
+                std::string result, command = arguments.at(0ul).getPrimitive().getString();
+
+                std::unique_ptr<std::FILE, Deleter> pipe(popen(command.c_str(), "r"));
+
+                if(!pipe)
+                    return (Reporting::push(Reporting::Report{
+                        .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
+                        .message = Logger::format("Failed to open pipe while evaluating shell expression (with command '$').", command)
+                    }), PrimitiveValue::invalidValue);
+
+                while(std::fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) result += buffer.data();
+                return PrimitiveValue(result);
+            }
+
+            Reporting::push(Reporting::Report{
+                .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
+                .message = Logger::format("Internal function `$` has not been implemented.", name)
+            });
+
+            return PrimitiveValue::invalidValue;
+        }
+    private:
+        /// @brief Lvalue chain made of a variable followed by index and access expressions (e.g. `s.field[i]`), whose indices
+        /// have already been evaluated, so that the storage it denotes can be resolved without evaluating anything else.
+        struct Path final
+        {
+            static constexpr std::size_t maxDepth{8ul};
+
+            const BoundIdentifierExpression* root{};
+            std::array<const BoundExpression*, maxDepth> steps{};
+            std::array<Types::u64, maxDepth> indices{};
+            std::size_t depth{};
+        };
+
+        /// @brief Storage denoted by a path: a whole value, an element of an array or a character of a string.
+        /// Paths that are only read are resolved through const references, so that no shared storage is copied.
+        template <typename VALUE>
+        struct BasicReference final
+        {
+            VALUE* value{};
+            std::conditional_t<std::is_const_v<VALUE>, const ArrayValue, ArrayValue>* array{};
+            Types::u64 index{};
+            bool isCharacter{};
+        };
+
+        using Reference = BasicReference<Value>;
+        using ConstReference = BasicReference<const Value>;
+
+        /// @brief Evaluate the index operands of an lvalue chain, in the order in which they appear.
+        /// @return The path, or std::nullopt if either the expression isn't a chain rooted at a variable (in which case nothing
+        /// was evaluated), or its evaluation was interrupted.
+        std::optional<Path> evaluatePath(const BoundExpression* expression)
+        {
+            Path path;
+
+            while(expression->getKind() == BoundNode::Kind::IndexExpression || expression->getKind() == BoundNode::Kind::AccessExpression)
+            {
+                if(path.depth == Path::maxDepth)
+                    return std::nullopt;
+
+                path.steps[path.depth++] = expression;
+                expression = expression->getKind() == BoundNode::Kind::IndexExpression?
+                    static_cast<const BoundIndexExpression*>(expression)->getArray():
+                    static_cast<const BoundAccessExpression*>(expression)->getBase();
+            }
+
+            if(expression->getKind() != BoundNode::Kind::IdentifierExpression
+            || !static_cast<const BoundIdentifierExpression*>(expression)->getSlot())
+                return std::nullopt;
 
-                    find->getArray().set(index, new_value);
-                    result = new_value;
-                    return result;
+            path.root = static_cast<const BoundIdentifierExpression*>(expression);
+
+            for(auto i = path.depth; i-- > 0ul;)
+            {
+                if(path.steps[i]->getKind() == BoundNode::Kind::AccessExpression)
+                {
+                    path.indices[i] = static_cast<const BoundAccessExpression*>(path.steps[i])->getIndex();
+                    continue;
                 }
-                
-                Reporting::push(Reporting::Report{
-                    .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                    .message = "Cannot use mutable operator on temporary array operands."
-                });
 
-                return PrimitiveValue::invalidValue;
+                auto index = evaluateExpression(static_cast<const BoundIndexExpression*>(path.steps[i])->getIndex());
+
+                if(interrupted())
+                    return std::nullopt;
+
+                path.indices[i] = index.getPrimitive().getU64();
             }
-            else if(auto access_expression = dynamic_cast<const BoundAccessExpression*>(expression))
+
+            return path;
+        }
+
+        /// @return The storage denoted by the path, or std::nullopt if its operands aren't of the expected kinds.
+        template <typename REFERENCE>
+        std::optional<REFERENCE> resolvePath(const Path& path)
+        {
+            REFERENCE reference{.value = findVariable(path.root)};
+
+            for(auto i = path.depth; i-- > 0ul;)
             {
-                auto index = access_expression->getIndex();
-                auto base = access_expression->getBase();
+                const auto index = path.indices[i];
 
-                if(auto identifier = dynamic_cast<const BoundIdentifierExpression*>(base))
+                if(reference.isCharacter)
+                    return std::nullopt;
+
+                else if(path.steps[i]->getKind() == BoundNode::Kind::AccessExpression)
                 {
-                    auto find = m_variables.find(identifier->getValue());
-                    
-                    if(!find)
-                        return PrimitiveValue::invalidValue;
+                    if(!reference.value || reference.value->getKind() != Value::Kind::Structure)
+                        return std::nullopt;
 
-                    find->getStructure().at(index) = new_value;
-                    result = new_value;
-                    return result;
+                    reference.value = &reference.value->getStructure().at(index);
                 }
+                else if(reference.array)
+                {
+                    reference.array = &reference.array->getNested(reference.index);
+                    reference.index = index;
+                }
+                else if(reference.value->getKind() == Value::Kind::Array)
+                    reference = REFERENCE{.array = &reference.value->getArray(), .index = index};
 
-                Reporting::push(Reporting::Report{
+                else if(reference.value->getKind() == Value::Kind::Primitive
+                && reference.value->getPrimitive().getKind() == PrimitiveValue::Kind::String)
+                {
+                    reference.index = index;
+                    reference.isCharacter = true;
+                }
+                else return std::nullopt;
+            }
+
+            return reference;
+        }
+
+        Value loadPath(const Path& path)
+        {
+            auto reference = resolvePath<ConstReference>(path);
+
+            if(!reference)
+                return (Reporting::push(Reporting::Report{
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                    .message = "Cannot use mutable operator on temporary structure operands."
-                });
+                    .message = Logger::format("Invalid operand in index or access expression on `$`.", path.root->getValue())
+                }), PrimitiveValue::invalidValue);
 
-                return PrimitiveValue::invalidValue;
-            }
-            else return (Reporting::push(Reporting::Report{
+            return load(*reference);
+        }
+
+        template <typename REFERENCE>
+        static Value load(const REFERENCE& reference)
+        {
+            if(reference.array)
+                return reference.array->get(reference.index);
+            else if(reference.isCharacter)
+                return PrimitiveValue(reference.value->getPrimitive().getStringReference().at(reference.index));
+            else return *reference.value;
+        }
+
+        static void store(const Reference& reference, const Value& value)
+        {
+            if(reference.array)
+                reference.array->set(reference.index, value);
+            else if(reference.isCharacter)
+                reference.value->getPrimitive().getStringReference().at(reference.index) = value.getPrimitive().getChar();
+            else assign(*reference.value, value);
+        }
+
+        /// @brief Evaluate an operator that modifies its target in place (i.e. assignments, increments and decrements).
+        /// The target's index operands are evaluated once, before the operand, and its storage is only resolved afterwards.
+        /// @param compute Callable computing the new value of the target from its storage and the value of the operand.
+        template <typename Function>
+        Value evaluateMutableOperator(const Types::type& type, const BoundExpression* target, const BoundExpression* operand, Function compute)
+        {
+            auto path = evaluatePath(target);
+
+            if(interrupted())
+                return PrimitiveValue::voidValue;
+
+            else if(!path)
+                return (Reporting::push(Reporting::Report{
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
-                    .message = "Cannot use mutable operator on temporary operands."
+                    .message = target->getKind() == BoundNode::Kind::IndexExpression? "Cannot use mutable operator on temporary array operands.":
+                        target->getKind() == BoundNode::Kind::AccessExpression? "Cannot use mutable operator on temporary structure operands.":
+                        "Cannot use mutable operator on temporary operands."
                 }), PrimitiveValue::invalidValue);
 
-            if(result.getIfPrimitive() && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
+            auto value = operand? evaluateExpression(operand): Value(PrimitiveValue::voidValue);
+
+            if(interrupted())
+                return PrimitiveValue::voidValue;
+
+            auto reference = resolvePath<Reference>(*path);
+
+            if(!reference)
+                return PrimitiveValue::invalidValue;
+
+            auto result = compute(*reference, value);
+            store(*reference, result);
+
+            if(result.getKind() == Value::Kind::Primitive && (result.getPrimitive().getKind() == PrimitiveValue::Kind::Signed
                 || result.getPrimitive().getKind() == PrimitiveValue::Kind::Unsigned))
                 return result.getPrimitive().convert(type.primitive);
             else return result;
         }
 
+        /// @brief Entry of the function table, indexed by BoundFunctionDeclaration::getIndex().
+        struct Function final
+        {
+            std::shared_ptr<const BoundExpression> body;
+            Types::u64 depth, frameSize;
+            bool pure;
+        };
+
+        /// @brief Call to a pure function, identified by the function's index and the values of its arguments.
+        struct MemoizedCall final
+        {
+            Types::u64 function;
+            std::vector<PrimitiveValue> arguments;
+            std::size_t hash;
+
+            bool operator==(const MemoizedCall& other) const
+            {
+                return function == other.function && std::ranges::equal(arguments, other.arguments, identicalPrimitives);
+            }
+        };
+
+        struct MemoizedCallHash final
+        {
+            std::size_t operator()(const MemoizedCall& call) const { return call.hash; }
+        };
+
+        /// @brief Result of a memoized call, and its position in the order of use of the cache.
+        struct MemoizedResult final
+        {
+            PrimitiveValue value;
+            std::list<const MemoizedCall*>::iterator use;
+        };
+
+        /// @brief Floating-point arguments are keyed by their bit pattern, so that calls with 0.0 and -0.0 (which compare
+        /// equal but may produce different results) are kept apart, and calls with NaN are found again.
+        static bool identicalPrimitives(const PrimitiveValue& left, const PrimitiveValue& right)
+        {
+            if(left.getKind() != right.getKind())
+                return false;
+
+            switch(left.getKind())
+            {
+            case PrimitiveValue::Kind::Float: return std::bit_cast<Types::u32>(left.getF32()) == std::bit_cast<Types::u32>(right.getF32());
+            case PrimitiveValue::Kind::Double: return std::bit_cast<Types::u64>(left.getF64()) == std::bit_cast<Types::u64>(right.getF64());
+            default: return left == right;
+            }
+        }
+
+        /// @return The hash of a primitive value, or std::nullopt if the kind of the value cannot key the memoization cache.
+        static std::optional<std::size_t> hashPrimitive(const PrimitiveValue& value)
+        {
+            switch(value.getKind())
+            {
+            case PrimitiveValue::Kind::Boolean: return std::hash<bool>{}(value.getBool());
+            case PrimitiveValue::Kind::Character: return std::hash<Types::_char>{}(value.getChar());
+            case PrimitiveValue::Kind::Unsigned: return std::hash<Types::u64>{}(value.getU64());
+            case PrimitiveValue::Kind::Signed: return std::hash<Types::i64>{}(value.getI64());
+            case PrimitiveValue::Kind::Float: return std::hash<Types::u32>{}(std::bit_cast<Types::u32>(value.getF32()));
+            case PrimitiveValue::Kind::Double: return std::hash<Types::u64>{}(std::bit_cast<Types::u64>(value.getF64()));
+            case PrimitiveValue::Kind::String: return std::hash<Types::string>{}(value.getStringReference());
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Key a call to a function with the arguments stored at the base of its frame.
+        /// @return The key of the call, or std::nullopt if any of its arguments cannot key the memoization cache.
+        std::optional<MemoizedCall> keyCall(Types::u64 function, std::size_t base, std::size_t argument_count) const
+        {
+            MemoizedCall call{.function = function, .arguments = {}, .hash = std::hash<Types::u64>{}(function)};
+            call.arguments.reserve(argument_count);
+
+            for(std::size_t i{0ul}; i < argument_count; ++i)
+            {
+                auto argument = m_locals[base + i].getIfPrimitive();
+                auto hash = argument? hashPrimitive(*argument): std::nullopt;
+
+                if(!hash)
+                    return std::nullopt;
+
+                call.hash = call.hash * 31ul + *hash;
+                call.arguments.push_back(*argument);
+            }
+
+            return call;
+        }
+
+        /// @brief Cache the result of a call, evicting the least recently used result if the cache is full.
+        void memoize(MemoizedCall call, const Value& result)
+        {
+            auto value = result.getIfPrimitive();
+            if(!value || value->getKind() == PrimitiveValue::Kind::Invalid || value->getKind() == PrimitiveValue::Kind::Void)
+                return;
+
+            // the call may have been cached while it was evaluated, in which case it is only marked as used
+            if(auto find = m_memoized.find(call); find != m_memoized.end())
+            {
+                m_memoizationOrder.splice(m_memoizationOrder.begin(), m_memoizationOrder, find->second.use);
+                return;
+            }
+
+            if(m_memoized.size() >= m_memoizationCapacity)
+            {
+                m_memoized.erase(m_memoized.find(*m_memoizationOrder.back()));
+                m_memoizationOrder.pop_back();
+                ++m_memoizationStatistics.evictions;
+            }
+
+            auto find = m_memoized.emplace(std::move(call), MemoizedResult{.value = *value, .use = {}}).first;
+            m_memoizationOrder.push_front(&find->first);
+            find->second.use = m_memoizationOrder.begin();
+        }
+
+        /// @brief Access the storage of a variable slot, growing the global frame if needed.
+        Value& getSlot(const BoundIdentifierExpression::Slot& slot)
+        {
+            if(slot.depth == 0ul)
+            {
+                if(m_globals.size() <= slot.index)
+                    m_globals.resize(slot.index + 1ul, Value(PrimitiveValue::voidValue));
+
+                return m_globals[slot.index];
+            }
+
+            return m_locals[m_frames.at(slot.depth) + slot.index];
+        }
+
+        /// @return The storage of the variable referenced by the identifier, or nullptr if it wasn't resolved to a slot.
+        Value* findVariable(const BoundIdentifierExpression* identifier)
+        {
+            return identifier->getSlot()? &getSlot(*identifier->getSlot()): nullptr;
+        }
+
+        /// @brief Abrupt completion left pending by a return, break or continue statement, or by abandoning a bounded
+        /// evaluation (see evaluateBounded()).
+        enum class Completion: Types::u8 { Normal, Break, Continue, Return, Abandoned };
+
+        /// @return Whether a return, break or continue is pending, in which case the result of the current evaluation is
+        /// discarded and it must return immediately.
+        [[nodiscard]] inline bool interrupted() const { return m_completion != Completion::Normal; }
+
+        /// @brief Take a step of a bounded evaluation, abandoning it if none are left.
+        /// @return Whether the evaluation ran out of steps.
+        bool exhausted()
+        {
+            if(!m_steps) [[likely]]
+                return false;
+            else if(*m_steps == 0ul)
+                return (m_completion = Completion::Abandoned, true);
+
+            --*m_steps;
+            return false;
+        }
+
+        /// @brief Abandon a bounded evaluation at an operation whose result differs in compiled code.
+        /// @return Whether the evaluation was abandoned.
+        bool abandonDivergent(BoundBinaryOperator::Kind kind, Types::Kind type, const Value& left, const Value& right)
+        {
+            if(!m_steps) [[likely]]
+                return false;
+
+            auto left_value = left.getIfPrimitive(), right_value = right.getIfPrimitive();
+
+            if(!left_value || !right_value || !divergesFromCompiledCode(kind, type, *left_value, *right_value))
+                return false;
+
+            m_completion = Completion::Abandoned;
+            return true;
+        }
+
+        /// @return Whether compiled code computes a different result for an integral operation than the interpreter does:
+        /// there, signed remainders take the sign of the dividend, shift counts are masked to the width of the operation and
+        /// dividing by zero or overflowing a signed division traps. Operations on narrower kinds are 32-bit wide.
+        static bool divergesFromCompiledCode(BoundBinaryOperator::Kind kind, Types::Kind type, const PrimitiveValue& left,
+            const PrimitiveValue& right)
+        {
+            auto integral = [](const PrimitiveValue& value) -> std::optional<Types::i64> {
+                switch(value.getKind())
+                {
+                case PrimitiveValue::Kind::Signed: return value.getI64();
+                case PrimitiveValue::Kind::Unsigned: return static_cast<Types::i64>(value.getU64());
+                default: return std::nullopt;
+                }
+            };
+
+            const auto dividend = integral(left), divisor = integral(right);
+
+            if(!dividend || !divisor)
+                return false;
+
+            const auto is_wide = Types::sizeFromKind(type) == Types::Size::QuadWord;
+            const auto is_signed = left.getKind() == PrimitiveValue::Kind::Signed;
+
+            switch(kind)
+            {
+            case BoundBinaryOperator::Kind::Division:
+            case BoundBinaryOperator::Kind::Modulo:
+                if(*divisor == 0l)
+                    return true;
+                else if(!is_signed)
+                    return false;
+                else if(*divisor == -1l)
+                    return *dividend == (is_wide? std::numeric_limits<Types::i64>::min(): std::numeric_limits<Types::i32>::min());
+                else if(kind == BoundBinaryOperator::Kind::Division)
+                    return false;
+                else
+                {
+                    const auto remainder = *dividend % *divisor;
+                    return remainder != 0l && (remainder < 0l) != (*divisor < 0l);
+                }
+            case BoundBinaryOperator::Kind::BitwiseShiftLeft:
+            case BoundBinaryOperator::Kind::BitwiseShiftRight:
+                return static_cast<Types::u64>(*divisor) >= (is_wide? 64ul: 32ul);
+            default: return false;
+            }
+        }
+
+        /// @return Whether a loop condition holds, false if evaluating it was interrupted.
+        bool evaluateCondition(const BoundExpression* condition)
+        {
+            if(exhausted())
+                return false;
+
+            auto value = evaluateExpression(condition);
+            return !interrupted() && value.getPrimitive().getBool();
+        }
+
+        /// @brief Handle the pending completion after evaluating the body of a loop, consuming a break or continue that
+        /// targets it (i.e. has no label or the loop's label).
+        /// @return Whether the loop must stop: either it was broken out of, or the completion targets an enclosing construct.
+        bool exitsLoop(const std::string& label)
+        {
+            if((m_completion == Completion::Break || m_completion == Completion::Continue)
+            && (m_completionLabel.empty() || m_completionLabel == label))
+                return std::exchange(m_completion, Completion::Normal) == Completion::Break;
+
+            return true;
+        }
+
+        /// @brief Report a completion that escaped every construct able to handle it, as its corresponding control-flow exception.
+        Value complete(Value value)
+        {
+            auto completion = std::exchange(m_completion, Completion::Normal);
+
+            switch(completion)
+            {
+            case Completion::Normal: return value;
+            case Completion::Break: throw BreakException{std::string{m_completionLabel}};
+            case Completion::Continue: throw ContinueException{std::string{m_completionLabel}};
+            case Completion::Return: throw ReturnException{m_returnValue};
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(completion);
+            }
+        }
+
+        /// @brief Overwrite a stored value, destroying the previous one in place.
+        static void assign(Value& target, const Value& value)
+        {
+            if(&target == &value)
+                return;
+
+            std::destroy_at(&target);
+            std::construct_at(&target, value);
+        }
+
+        /// @brief Scopes are only needed for enumerations, since variables and functions are resolved to slots and function table
+        /// indices by the binder.
         void beginScope()
         {
-            m_variables.beginScope();
-            m_functions.beginScope();
             m_enumerations.beginScope();
         }
 
         void endScope()
         {
-            m_variables.endScope();
-            m_functions.endScope();
             m_enumerations.endScope();
         }
 
-        ScopeStack<Value> m_variables;
+        /// Global variables (slots of depth 0), followed by the stack of the frames of all active function calls, each of
+        /// which begins at the index recorded for its function nesting depth.
+        std::vector<Value> m_globals, m_locals;
+        std::vector<std::size_t> m_frames;
+        Completion m_completion{Completion::Normal};
+        std::string_view m_completionLabel;
+        Value m_returnValue{PrimitiveValue::voidValue};
+        std::optional<Types::u64> m_steps;
         ScopeStack<Types::type::Enumeration> m_enumerations;
-        ScopeStack<std::unique_ptr<const BoundExpression>> m_functions;
+        std::vector<Function> m_functions;
+
+        /// Results of calls to pure functions, and the calls ordered from the most to the least recently used.
+        std::unordered_map<MemoizedCall, MemoizedResult, MemoizedCallHash> m_memoized;
+        std::list<const MemoizedCall*> m_memoizationOrder;
+        std::size_t m_memoizationCapacity{0ul};
+        MemoizationStatistics m_memoizationStatistics;
     };
 }
@@ -0,0 +1,212 @@
+#pragma once
+#include <linc/system/Types.hpp>
+#include <linc/system/Exception.hpp>
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief A relocatable x86-64 ELF64 object file with a data and a text section, the symbols defined in or referenced by
+    /// them, and the relocations of both sections. Serialized in the layout expected by `ld`.
+    class ObjectFileELF64 final
+    {
+    public:
+        enum class Section: std::uint16_t
+        {
+            Undefined, Data, Text
+        };
+
+        enum class RelocationType: std::uint32_t
+        {
+            Absolute64 = 1u, Relative32 = 2u, ProcedureLinkage32 = 4u, SignedAbsolute32 = 11u
+        };
+
+        struct Symbol final
+        {
+            std::string name;
+            Section section{Section::Undefined};
+            Types::u64 offset{};
+            bool isGlobal{};
+        };
+
+        /// @brief A location in the text or data section to be patched by the linker with the address of a symbol.
+        struct Relocation final
+        {
+            Types::u64 offset;
+            std::size_t symbol;
+            RelocationType type;
+            Types::i64 addend{};
+        };
+
+        std::string data, text;
+        std::vector<Symbol> symbols;
+        std::vector<Relocation> relocations, dataRelocations;
+
+        /// @brief Get the index of a symbol, adding it as undefined if it is not known yet.
+        std::size_t symbol(const std::string& name)
+        {
+            auto find = std::find_if(symbols.begin(), symbols.end(), [&](const Symbol& symbol){ return symbol.name == name; });
+            if(find != symbols.end())
+                return static_cast<std::size_t>(find - symbols.begin());
+
+            symbols.push_back(Symbol{.name = name});
+            return symbols.size() - 1ul;
+        }
+
+        /// @brief Serialize the object file.
+        [[nodiscard]] std::string write() const
+        {
+            // the symbol table starts with the null symbol and the section symbols; local symbols must precede global ones
+            std::vector<std::size_t> order, indices(symbols.size());
+            for(std::size_t i{0ul}; i < symbols.size(); ++i)
+                if(!isGlobal(symbols[i]))
+                    order.push_back(i);
+
+            const auto first_global = static_cast<std::uint32_t>(s_firstSymbol + order.size());
+            for(std::size_t i{0ul}; i < symbols.size(); ++i)
+                if(isGlobal(symbols[i]))
+                    order.push_back(i);
+
+            for(std::size_t i{0ul}; i < order.size(); ++i)
+                indices[order[i]] = s_firstSymbol + i;
+
+            std::string string_table(1ul, '\0'), symbol_table;
+            symbol_table.append(s_symbolSize, '\0');
+            putSymbol(symbol_table, 0u, s_sectionSymbol, static_cast<std::uint16_t>(Section::Data), 0ul);
+            putSymbol(symbol_table, 0u, s_sectionSymbol, static_cast<std::uint16_t>(Section::Text), 0ul);
+
+            for(auto index: order)
+            {
+                const auto& symbol = symbols[index];
+                auto name = static_cast<std::uint32_t>(string_table.size());
+                string_table.append(symbol.name).push_back('\0');
+
+                const std::uint8_t info = isGlobal(symbol)? s_globalBinding << 4u: 0u;
+                putSymbol(symbol_table, name, info, static_cast<std::uint16_t>(symbol.section), symbol.offset);
+            }
+
+            auto relocation_table = [&](const std::vector<Relocation>& entries)
+            {
+                std::string table;
+                for(const auto& relocation: entries)
+                {
+                    put<Types::u64>(table, relocation.offset);
+                    put<Types::u64>(table, (static_cast<Types::u64>(indices[relocation.symbol]) << 32u)
+                        | static_cast<Types::u64>(relocation.type));
+                    put<Types::i64>(table, relocation.addend);
+                }
+
+                return table;
+            };
+
+            const std::array<std::string_view, s_sectionCount> names{
+                "", ".data", ".text", ".rela.text", ".rela.data", ".note.GNU-stack", ".symtab", ".strtab", ".shstrtab"
+            };
+            std::string section_names;
+            std::array<std::uint32_t, s_sectionCount> name_offsets{};
+
+            for(std::size_t i{0ul}; i < s_sectionCount; ++i)
+            {
+                name_offsets[i] = static_cast<std::uint32_t>(section_names.size());
+                section_names.append(names[i]).push_back('\0');
+            }
+
+            // section contents follow the file header, each aligned to 16 bytes, then the section header table
+            std::string contents(s_headerSize, '\0');
+            std::array<std::pair<Types::u64, Types::u64>, s_sectionCount> placements{};
+
+            auto place = [&](std::size_t section, const std::string& bytes)
+            {
+                contents.append((16ul - contents.size() % 16ul) % 16ul, '\0');
+                placements[section] = {contents.size(), bytes.size()};
+                contents.append(bytes);
+            };
+
+            place(1ul, data);
+            place(2ul, text);
+            place(3ul, relocation_table(relocations));
+            place(4ul, relocation_table(dataRelocations));
+            place(5ul, std::string{});
+            place(6ul, symbol_table);
+            place(7ul, string_table);
+            place(8ul, section_names);
+            contents.append((8ul - contents.size() % 8ul) % 8ul, '\0');
+
+            const auto section_headers = static_cast<Types::u64>(contents.size());
+            std::string header{"\x7f" "ELF", 4ul};
+            header.append({2, 1, 1, 0});
+            header.append(8ul, '\0');
+            put<std::uint16_t>(header, 1u); // relocatable
+            put<std::uint16_t>(header, 62u); // x86-64
+            put<std::uint32_t>(header, 1u);
+            put<Types::u64>(header, 0ul);
+            put<Types::u64>(header, 0ul);
+            put<Types::u64>(header, section_headers);
+            put<std::uint32_t>(header, 0u);
+            put<std::uint16_t>(header, static_cast<std::uint16_t>(s_headerSize));
+            put<std::uint16_t>(header, 0u);
+            put<std::uint16_t>(header, 0u);
+            put<std::uint16_t>(header, static_cast<std::uint16_t>(s_sectionHeaderSize));
+            put<std::uint16_t>(header, static_cast<std::uint16_t>(s_sectionCount));
+            put<std::uint16_t>(header, static_cast<std::uint16_t>(s_sectionCount - 1ul));
+            contents.replace(0ul, s_headerSize, header);
+
+            contents.append(s_sectionHeaderSize, '\0');
+            auto section = [&](std::size_t index, std::uint32_t type, Types::u64 flags, std::uint32_t link, std::uint32_t info,
+                Types::u64 alignment, Types::u64 entry_size)
+            {
+                put<std::uint32_t>(contents, name_offsets[index]);
+                put<std::uint32_t>(contents, type);
+                put<Types::u64>(contents, flags);
+                put<Types::u64>(contents, 0ul);
+                put<Types::u64>(contents, placements[index].first);
+                put<Types::u64>(contents, placements[index].second);
+                put<std::uint32_t>(contents, link);
+                put<std::uint32_t>(contents, info);
+                put<Types::u64>(contents, alignment);
+                put<Types::u64>(contents, entry_size);
+            };
+
+            constexpr std::uint32_t progbits{1u}, symtab{2u}, strtab{3u}, rela{4u};
+            constexpr Types::u64 write{1ul}, alloc{2ul}, execute{4ul}, info_link{0x40ul};
+
+            section(1ul, progbits, write | alloc, 0u, 0u, 8ul, 0ul);
+            section(2ul, progbits, alloc | execute, 0u, 0u, 16ul, 0ul);
+            section(3ul, rela, info_link, 6u, 2u, 8ul, s_relocationSize);
+            section(4ul, rela, info_link, 6u, 1u, 8ul, s_relocationSize);
+            section(5ul, progbits, 0ul, 0u, 0u, 1ul, 0ul);
+            section(6ul, symtab, 0ul, 7u, first_global, 8ul, s_symbolSize);
+            section(7ul, strtab, 0ul, 0u, 0u, 1ul, 0ul);
+            section(8ul, strtab, 0ul, 0u, 0u, 1ul, 0ul);
+
+            return contents;
+        }
+    private:
+        static constexpr std::size_t s_sectionCount{9ul}, s_headerSize{64ul}, s_sectionHeaderSize{64ul}, s_symbolSize{24ul},
+            s_relocationSize{24ul}, s_firstSymbol{3ul};
+        static constexpr std::uint8_t s_sectionSymbol{3u}, s_globalBinding{1u};
+
+        /// @brief Undefined symbols are global, as they are to be resolved by the linker.
+        [[nodiscard]] static bool isGlobal(const Symbol& symbol)
+        {
+            return symbol.isGlobal || symbol.section == Section::Undefined;
+        }
+
+        template <typename T>
+        static void put(std::string& output, T value)
+        {
+            auto bits = static_cast<std::make_unsigned_t<T>>(value);
+            for(std::size_t i{0ul}; i < sizeof(T); ++i)
+                output.push_back(static_cast<char>((bits >> (8ul * i)) & 0xFFu));
+        }
+
+        static void putSymbol(std::string& output, std::uint32_t name, std::uint8_t info, std::uint16_t section, Types::u64 value)
+        {
+            put<std::uint32_t>(output, name);
+            output.push_back(static_cast<char>(info));
+            output.push_back('\0');
+            put<std::uint16_t>(output, section);
+            put<Types::u64>(output, value);
+            put<Types::u64>(output, 0ul);
+        }
+    };
+}
@@ -1,38 +1,74 @@
 #pragma once
 #include <linc/BoundTree.hpp>
 #include <linc/Include.hpp>
+#include <map>
 
 namespace linc
 {
+    class Interpreter;
+
     class Optimizer final
     {
     public:
+        /// @brief The default cost threshold of the inlining pass (see setInliningThreshold()).
+        static constexpr Types::u64 defaultInliningThreshold{24ul};
+
         Optimizer() = delete;
 
         static std::unique_ptr<const BoundNode> optimizeNode(const BoundNode* node);
+
+        /// @brief Set the largest cost of the functions whose calls are inlined: the number of nodes in their body. Only small,
+        /// non-recursive functions made of simple expressions and variable declarations are inlined, into the bodies of other
+        /// functions. A threshold of 0 disables inlining.
+        static inline void setInliningThreshold(Types::u64 threshold) { s_inliningThreshold = threshold; }
         
         static std::unique_ptr<const BoundExpression> optimizeBlockExpression(const BoundBlockExpression* expression)
         {
+            // the constants declared by the block go out of scope with it, after which the binder may reuse their slots
+            const auto constants = s_constants;
             std::vector<std::unique_ptr<const linc::BoundStatement>> statements;
             statements.reserve(expression->getStatements().size());
 
+            bool reachable{true};
             for(const auto& statement: expression->getStatements())
-                statements.push_back(optimizeStatement(statement.get()));
+            {
+                auto optimized_statement = optimizeStatement(statement.get());
+                const auto kind = optimized_statement->getKind();
 
-            auto tail = expression->getTail()? optimizeExpression(expression->getTail()): nullptr;
-            return std::make_unique<const BoundBlockExpression>(std::move(statements), std::move(tail));
+                if(kind == BoundNode::Kind::ExpressionStatement
+                && isPure(static_cast<const BoundExpressionStatement*>(optimized_statement.get())->getExpression()))
+                    continue;
+
+                statements.push_back(std::move(optimized_statement));
+
+                // statements following a jump out of the block are never executed
+                if(kind == BoundNode::Kind::ReturnStatement || kind == BoundNode::Kind::BreakStatement
+                || kind == BoundNode::Kind::ContinueStatement)
+                {
+                    reachable = false;
+                    break;
+                }
+            }
+
+            // the tail still gives the block its type when it is unreachable
+            auto tail = expression->getTail() && (reachable || expression->getTail()->getType().primitive != Types::Kind::_void)?
+                optimizeExpression(expression->getTail()): nullptr;
+
+            s_constants = constants;
+            return eliminateDeadDeclarations(std::move(statements), std::move(tail));
         }
 
         static std::unique_ptr<const BoundExpression> optimizeIfExpression(const BoundIfExpression* expression)
         {
             auto test_expression = optimizeExpression(expression->getTestExpression());
 
-            if(auto literal = dynamic_cast<const BoundLiteralExpression*>(test_expression.get()))
+            if(test_expression->getKind() == BoundNode::Kind::LiteralExpression)
             {
+                auto literal = static_cast<const BoundLiteralExpression*>(test_expression.get());
                 if(literal->getValue().getBool())
-                    return expression->getIfBody()->clone();
+                    return optimizeExpression(expression->getIfBody());
                 else if(auto else_body = expression->getElseBody())
-                    return else_body->clone();
+                    return optimizeExpression(else_body);
                 else return std::make_unique<const BoundBlockExpression>(std::vector<std::unique_ptr<const BoundStatement>>{}, nullptr);
             }
             auto if_body = optimizeExpression(expression->getIfBody());
@@ -46,10 +82,12 @@ namespace linc
             const auto& specifier = expression->getSpecifier();
             if(auto variable_specifier = std::get_if<0ul>(&specifier))
             {
-                auto body = optimizeExpression(expression->getBody());
+                const auto constants = s_constants;
                 auto variable_declaration = optimizeVariableDeclaration(variable_specifier->variableDeclaration.get());
+                auto body = optimizeExpression(expression->getBody());
                 auto _expression = variable_specifier->expression->clone();
                 auto statement = variable_specifier->statement->clone();
+                s_constants = constants;
                 return std::make_unique<const BoundForExpression>(expression->getLabel(), std::move(variable_declaration), std::move(_expression), std::move(statement), std::move(body));
             }
             auto body = optimizeExpression(expression->getBody());
@@ -60,11 +98,23 @@ namespace linc
         
         static std::unique_ptr<const BoundExpression> optimizeExpression(const BoundExpression* expression)
         {
-            if(auto if_expression = dynamic_cast<const BoundIfExpression*>(expression))
-                return optimizeIfExpression(if_expression);
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::IdentifierExpression:
+            {
+                auto identifier_expression = static_cast<const BoundIdentifierExpression*>(expression);
+                const auto& slot = identifier_expression->getSlot();
 
-            else if(auto while_expression = dynamic_cast<const BoundWhileExpression*>(expression))
+                if(auto find = slot? s_constants.find(std::pair{slot->depth, slot->index}): s_constants.end(); find != s_constants.end())
+                    return std::make_unique<const BoundLiteralExpression>(find->second, identifier_expression->getType());
+                else return expression->clone();
+            }
+            case BoundNode::Kind::IfExpression:
+                return optimizeIfExpression(static_cast<const BoundIfExpression*>(expression));
+
+            case BoundNode::Kind::WhileExpression:
             {
+                auto while_expression = static_cast<const BoundWhileExpression*>(expression);
                 auto test = optimizeExpression(while_expression->getTestExpression());
                 auto while_body = optimizeExpression(while_expression->getWhileBody());
                 auto finally_body = while_expression->hasFinally()? optimizeExpression(while_expression->getFinallyBody()): nullptr;
@@ -74,76 +124,106 @@ namespace linc
                 return std::make_unique<const BoundWhileExpression>(label, while_expression->getType(), std::move(test), std::move(while_body),
                     std::move(finally_body), std::move(else_body));
             }
-            else if(auto unary_expression = dynamic_cast<const BoundUnaryExpression*>(expression))
+            case BoundNode::Kind::UnaryExpression:
             {
+                auto unary_expression = static_cast<const BoundUnaryExpression*>(expression);
                 auto operand = optimizeExpression(unary_expression->getOperand());
+                auto optimized_expression = std::make_unique<const BoundUnaryExpression>(unary_expression->getOperator()->clone(),
+                    std::move(operand));
 
-                if(auto literal = dynamic_cast<const BoundLiteralExpression*>(operand.get()))
-                    return std::make_unique<const BoundLiteralExpression>(
-                        optimizeConstantUnaryExpression(unary_expression->getOperator()->getKind(), literal->getValue(), unary_expression->getType()),
-                        unary_expression->getType());
+                if(optimized_expression->getOperand()->getKind() == BoundNode::Kind::LiteralExpression)
+                    return foldConstantExpression(std::move(optimized_expression));
                 
-                else return std::make_unique<const BoundUnaryExpression>(unary_expression->getOperator()->clone(), std::move(operand));
+                else return optimized_expression;
             }
-            else if(auto binary_expression = dynamic_cast<const BoundBinaryExpression*>(expression))
+            case BoundNode::Kind::BinaryExpression:
             {
+                auto binary_expression = static_cast<const BoundBinaryExpression*>(expression);
                 if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalAnd)
                 {
                     auto left = optimizeExpression(binary_expression->getLeft());
-                    if(auto left_literal = dynamic_cast<const BoundLiteralExpression*>(left.get()))
+                    if(left->getKind() == BoundNode::Kind::LiteralExpression)
                     {
-                        if(!left_literal->getValue().getBool())
+                        if(!static_cast<const BoundLiteralExpression*>(left.get())->getValue().getBool())
                             return std::make_unique<const BoundLiteralExpression>(false, binary_expression->getType());
                         else return optimizeExpression(binary_expression->getRight());
                     }
                     else return std::make_unique<const BoundBinaryExpression>(binary_expression->getOperator()->clone(),
-                        std::move(left), binary_expression->getRight()->clone());
+                        std::move(left), optimizeExpression(binary_expression->getRight()));
                 }
                 else if(binary_expression->getOperator()->getKind() == BoundBinaryOperator::Kind::LogicalOr)
                 {
                     auto left = optimizeExpression(binary_expression->getLeft());
-                    if(auto left_literal = dynamic_cast<const BoundLiteralExpression*>(left.get()))
+                    if(left->getKind() == BoundNode::Kind::LiteralExpression)
                     {
-                        if(left_literal->getValue().getBool())
+                        if(static_cast<const BoundLiteralExpression*>(left.get())->getValue().getBool())
                             return std::make_unique<const BoundLiteralExpression>(true, binary_expression->getType());
                         else return optimizeExpression(binary_expression->getRight());
                     }
                     else return std::make_unique<const BoundBinaryExpression>(binary_expression->getOperator()->clone(),
-                        std::move(left), binary_expression->getRight()->clone());
+                        std::move(left), optimizeExpression(binary_expression->getRight()));
                 }
   
                 auto left = optimizeExpression(binary_expression->getLeft());
                 auto right = optimizeExpression(binary_expression->getRight());
+                const bool constant = left->getKind() == BoundNode::Kind::LiteralExpression && right->getKind() == BoundNode::Kind::LiteralExpression;
+                auto optimized_expression = std::make_unique<const BoundBinaryExpression>(binary_expression->getOperator()->clone(),
+                    std::move(left), std::move(right));
 
-                if(auto left_literal = dynamic_cast<const BoundLiteralExpression*>(left.get()), right_literal = dynamic_cast<const BoundLiteralExpression*>(right.get()); left_literal && right_literal)
-                    return std::make_unique<const BoundLiteralExpression>(
-                        optimizeConstantBinaryExpression(binary_expression->getOperator()->getKind(), left_literal->getValue(), right_literal->getValue()),
-                        binary_expression->getType());
+                if(constant)
+                    return foldConstantExpression(std::move(optimized_expression));
                 
-                else return std::make_unique<const BoundBinaryExpression>(binary_expression->getOperator()->clone(), std::move(left), std::move(right));
+                else return optimized_expression;
             }
-            else if(auto block_expression = dynamic_cast<const BoundBlockExpression*>(expression))
+            case BoundNode::Kind::ConversionExpression:
             {
-                std::vector<std::unique_ptr<const BoundStatement>> statements;
-                for(const auto& statement: block_expression->getStatements())
-                    statements.push_back(optimizeStatement(statement.get()));
-                auto tail = block_expression->getTail()? optimizeExpression(block_expression->getTail()): nullptr;
+                auto conversion_expression = static_cast<const BoundConversionExpression*>(expression);
+                auto operand = optimizeExpression(conversion_expression->getExpression());
+                const bool constant = operand->getKind() == BoundNode::Kind::LiteralExpression;
+                auto optimized_expression = std::make_unique<const BoundConversionExpression>(std::move(operand),
+                    conversion_expression->getConversion()->clone());
 
-                return std::make_unique<const BoundBlockExpression>(std::move(statements), std::move(tail));
+                if(constant)
+                    return foldConstantExpression(std::move(optimized_expression));
+
+                else return optimized_expression;
             }
+            case BoundNode::Kind::BlockExpression:
+                return optimizeBlockExpression(static_cast<const BoundBlockExpression*>(expression));
+
+            case BoundNode::Kind::FunctionCallExpression:
+                return optimizeFunctionCallExpression(static_cast<const BoundFunctionCallExpression*>(expression));
+
+            case BoundNode::Kind::ExternalCallExpression:
+            {
+                auto external_call_expression = static_cast<const BoundExternalCallExpression*>(expression);
+                std::vector<std::unique_ptr<const BoundExpression>> arguments;
+                arguments.reserve(external_call_expression->getArguments().size());
+
+                for(const auto& argument: external_call_expression->getArguments())
+                    arguments.push_back(optimizeExpression(argument.get()));
 
-            return expression->clone();
+                return std::make_unique<const BoundExternalCallExpression>(external_call_expression->getType(),
+                    external_call_expression->getName(), std::move(arguments));
+            }
+            default: return expression->clone();
+            }
         }
 
         static std::unique_ptr<const BoundStatement> optimizeStatement(const BoundStatement* statement)
         {
-            if(auto expression = dynamic_cast<const BoundExpressionStatement*>(statement))
-                return std::make_unique<const BoundExpressionStatement>(optimizeExpression(expression->getExpression()));
+            switch(statement->getKind())
+            {
+            case BoundNode::Kind::ExpressionStatement:
+                return std::make_unique<const BoundExpressionStatement>(
+                    optimizeExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression()));
             
-            else if(auto declaration = dynamic_cast<const BoundDeclarationStatement*>(statement))
-                return std::make_unique<const BoundDeclarationStatement>(optimizeDeclaration(declaration->getDeclaration()));
+            case BoundNode::Kind::DeclarationStatement:
+                return std::make_unique<const BoundDeclarationStatement>(
+                    optimizeDeclaration(static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration()));
 
-            return statement->clone();
+            default: return statement->clone();
+            }
         }
         
         static std::unique_ptr<const BoundVariableDeclaration> optimizeVariableDeclaration(const BoundVariableDeclaration* declaration)
@@ -151,19 +231,38 @@ namespace linc
             auto value = declaration->getDefaultValue()? std::make_optional(optimizeExpression(declaration->getDefaultValue().value()))
                 :std::nullopt;
 
-            return std::make_unique<const BoundVariableDeclaration>(declaration->getActualType(), declaration->getName(), std::move(value));
+            declareConstant(declaration, value? value->get(): nullptr);
+            return std::make_unique<const BoundVariableDeclaration>(declaration->getActualType(), declaration->getName(), std::move(value),
+                declaration->getSlot());
         }
 
         static std::unique_ptr<const BoundDeclaration> optimizeDeclaration(const BoundDeclaration* declaration)
         {
-            if(auto variable_declaration = dynamic_cast<const BoundVariableDeclaration*>(declaration))
-                return optimizeVariableDeclaration(std::move(variable_declaration));
+            switch(declaration->getKind())
+            {
+            case BoundNode::Kind::VariableDeclaration:
+                return optimizeVariableDeclaration(static_cast<const BoundVariableDeclaration*>(declaration));
 
-            else if(auto function_declaration = dynamic_cast<const BoundFunctionDeclaration*>(declaration))
+            case BoundNode::Kind::FunctionDeclaration:
             {
+                auto function_declaration = static_cast<const BoundFunctionDeclaration*>(declaration);
+
+                // the constants known from the enclosing scope remain valid in the body, but not those of its parameters' defaults
+                const auto constants = s_constants;
+
+                // calls inlined into the body declare their arguments and locals in additional slots of the function's frame
+                const auto previous_frame = std::exchange(s_frame, Frame{.depth = function_declaration->getDepth(),
+                    .size = function_declaration->getFrameSize()});
+                s_inlining.push_back(function_declaration->getIndex());
+
                 auto body = optimizeExpression(function_declaration->getBody());
+                const auto frame_size = s_frame->size;
+
+                s_inlining.pop_back();
+                s_frame = previous_frame;
+
                 std::vector<std::unique_ptr<const BoundVariableDeclaration>> arguments;
-                std::vector<std::unique_ptr<const Types::type>> argument_types;
+                std::vector<const Types::type*> argument_types;
                 arguments.reserve(function_declaration->getArguments().size());
                 argument_types.reserve(function_declaration->getArguments().size());
 
@@ -173,18 +272,31 @@ namespace linc
                     arguments.push_back(std::move(optimized_argument));
                 }
 
+                s_constants = constants;
                 for(const auto& argument: arguments)
-                    argument_types.push_back(argument->getActualType().clone());
+                    argument_types.push_back(argument->getActualType().intern());
+
+                auto function_type = Types::type{Types::type::Function{function_declaration->getReturnType().intern(), std::move(argument_types)}};
+                auto optimized_declaration = std::make_unique<const BoundFunctionDeclaration>(function_type, function_declaration->getName(),
+                    std::move(arguments), std::move(body), function_declaration->getDepth(), frame_size, function_declaration->getIndex(),
+                    function_declaration->isPure());
 
-                auto function_type = Types::type{Types::type::Function{function_declaration->getReturnType().clone(), std::move(argument_types)}};
-                return std::make_unique<const BoundFunctionDeclaration>(function_type, function_declaration->getName(), std::move(arguments), std::move(body));
+                registerDeclaration(optimized_declaration.get());
+                return optimized_declaration;
+            }
+            default: return declaration->clone();
             }
-            return declaration->clone();
         }
 
         static BoundProgram optimizeProgram(BoundProgram& program)
         {
             std::vector<std::unique_ptr<const BoundDeclaration>> declarations;
+
+            // functions may be inlined into the functions declared before them
+            reset();
+            for(const auto& declaration: program.declarations)
+                if(declaration->getKind() == BoundNode::Kind::FunctionDeclaration || declaration->getKind() == BoundNode::Kind::EnumerationDeclaration)
+                    registerDeclaration(declaration.get());
             
             for(const auto& declaration: program.declarations)
                 declarations.push_back(optimizeDeclaration(declaration.get()));
@@ -192,37 +304,77 @@ namespace linc
             return BoundProgram{.declarations = std::move(declarations)};
         }
     private:
-        static PrimitiveValue optimizeConstantUnaryExpression(BoundUnaryOperator::Kind kind, const PrimitiveValue& operand, const Types::type& type)
+        /// @brief The frame of the function being optimized, whose size grows with the calls inlined into it.
+        struct Frame final
         {
-            switch(kind)
-            {
-            case BoundUnaryOperator::Kind::Stringify: return operand.toApplicationString();
-            case BoundUnaryOperator::Kind::Typeof: return type;
-            case BoundUnaryOperator::Kind::LogicalNot: return !operand.getBool();
-            case BoundUnaryOperator::Kind::UnaryPlus: return +operand;
-            case BoundUnaryOperator::Kind::UnaryMinus: return -operand;
-            case BoundUnaryOperator::Kind::BitwiseNot: return ~operand;
-            default: return PrimitiveValue::invalidValue;
-            }
-        }
+            Types::u64 depth, size;
+        };
 
-        static PrimitiveValue optimizeConstantBinaryExpression(BoundBinaryOperator::Kind kind, const PrimitiveValue& left, const PrimitiveValue& right)
+        /// @brief How the body of an inlined function is moved into the frame of its caller: its variables (the slots of the
+        /// callee's own frame) are renamed with a unique prefix and offset into the caller's frame.
+        struct Substitution final
         {
-            switch(kind)
-            {
-            case BoundBinaryOperator::Kind::Addition: return left + right;
-            case BoundBinaryOperator::Kind::Equals: return left == right;
-            case BoundBinaryOperator::Kind::NotEquals: return left != right;
-            case BoundBinaryOperator::Kind::Subtraction: return left - right;
-            case BoundBinaryOperator::Kind::Multiplication: return left * right;
-            case BoundBinaryOperator::Kind::Division: return left / right;
-            case BoundBinaryOperator::Kind::Greater: return left > right;
-            case BoundBinaryOperator::Kind::Less: return left < right;
-            case BoundBinaryOperator::Kind::GreaterEqual: return left >= right;
-            case BoundBinaryOperator::Kind::LessEqual: return left <= right;
-            case BoundBinaryOperator::Kind::Modulo: return left % right;
-            default: return PrimitiveValue::invalidValue;
-            }
-        }
+            Types::u64 calleeDepth, callerDepth, base;
+            std::string prefix;
+            Types::u64 cost;
+        };
+
+        static std::unique_ptr<const BoundExpression> optimizeFunctionCallExpression(const BoundFunctionCallExpression* expression);
+
+        /// @return The inlined body of the called function, or nullptr if the call is not worth inlining or cannot be inlined.
+        static std::unique_ptr<const BoundExpression> inlineFunctionCall(const BoundFunctionCallExpression* expression);
+
+        /// @brief Evaluate a call to a pure function with literal arguments ahead of time, within a budget of steps.
+        /// @return The literal result of the call, or nullptr if it cannot be evaluated (in which case it is left to run).
+        static std::unique_ptr<const BoundExpression> evaluateFunctionCall(const BoundFunctionCallExpression* expression);
+
+        /// @brief Make a function available to the calls inlined or evaluated ahead of time (unless it already is), or an
+        /// enumeration to the calls evaluated ahead of time.
+        static void registerDeclaration(const BoundDeclaration* declaration);
+
+        /// @brief Forget the functions and constants of the program previously optimized by the thread.
+        static void reset();
+
+        /// @return The expression moved into the caller's frame, or nullptr if it cannot be inlined or exceeds the threshold.
+        static std::unique_ptr<const BoundExpression> substituteExpression(const BoundExpression* expression, Substitution& substitution);
+        static std::unique_ptr<const BoundStatement> substituteStatement(const BoundStatement* statement, Substitution& substitution);
+
+        /// @brief Evaluate an operation on literals, the way the interpreter would at runtime.
+        /// @return The resulting literal, or the expression itself if it cannot be evaluated ahead of time.
+        static std::unique_ptr<const BoundExpression> foldConstantExpression(std::unique_ptr<const BoundExpression> expression);
+
+        /// @brief Record the value of an immutable variable initialized with a literal, so that it replaces the variable's uses,
+        /// or forget the previous constant in the variable's slot. Global constants are also made available to the calls
+        /// evaluated ahead of time.
+        static void declareConstant(const BoundVariableDeclaration* declaration, const BoundExpression* value);
+
+        /// @brief Whether evaluating the expression has no effects (it may be removed if its value is unused).
+        [[nodiscard]] static bool isPure(const BoundExpression* expression);
+
+        /// @brief Whether the variable in the given slot may be read or written by a node, conservatively true for nodes of
+        /// unknown kinds.
+        [[nodiscard]] static bool references(const BoundNode* node, const BoundVariableDeclaration::Slot& slot);
+
+        /// @brief Make a block without the declarations of variables that are initialized without effects and never used.
+        static std::unique_ptr<const BoundExpression> eliminateDeadDeclarations(std::vector<std::unique_ptr<const BoundStatement>> statements,
+            std::unique_ptr<const BoundExpression> tail);
+
+        /// @brief The steps (function calls and loop iterations) a call evaluated ahead of time may take.
+        static constexpr Types::u64 s_evaluationSteps{1ul << 16ul};
+
+        /// @brief Functions in nested inlined calls are not inlined past this depth, bounding the growth of their callers.
+        static constexpr std::size_t s_maximumInliningDepth{4ul};
+
+        static Types::u64 s_inliningThreshold;
+
+        /// @brief The state of the pass is kept per thread, so that concurrent compilations do not inline each other's functions.
+        static thread_local std::unordered_map<Types::u64, std::unique_ptr<const BoundDeclaration>> s_functions;
+        static thread_local std::optional<Frame> s_frame;
+        static thread_local std::map<std::pair<Types::u64, Types::u64>, PrimitiveValue> s_constants;
+
+        /// @brief Evaluates constant expressions and the calls evaluated ahead of time, knowing the program's functions.
+        static thread_local Interpreter s_evaluator;
+        static thread_local std::vector<Types::u64> s_inlining;
+        static thread_local Types::u64 s_inlinedCount;
     };
 }
\ No newline at end of file
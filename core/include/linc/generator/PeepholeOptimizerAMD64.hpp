@@ -0,0 +1,594 @@
+#pragma once
+#include <linc/generator/EmitterAMD64.hpp>
+#include <linc/generator/Registers.hpp>
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief Rewrites short windows of the instructions recorded by an EmitterAMD64 according to a table of patterns, until none
+    /// of them applies anymore. Every pattern preserves the behavior of the code, assuming that stack adjustments are never
+    /// relied on for their flags, and counts how many instructions it removed.
+    class PeepholeOptimizerAMD64 final
+    {
+    public:
+        using Instruction = EmitterAMD64::Instruction;
+        using Operand = EmitterAMD64::Operand;
+        using UnaryInstruction = EmitterAMD64::UnaryInstruction;
+        using BinaryInstruction = EmitterAMD64::BinaryInstruction;
+        using NullaryInstruction = EmitterAMD64::NullaryInstruction;
+        using InstructionKind = EmitterAMD64::InstructionKind;
+
+        enum class Rule: unsigned char
+        {
+            SelfMove, PushPop, StackAdjustment, StoreForwarding, ConditionalChain, JumpThreading, UnreachableCode, DeadLabel
+        };
+
+        static constexpr std::size_t ruleCount{8ul};
+
+        /// @brief How many times a rule applied, and how many instructions it removed in total.
+        struct Statistic final
+        {
+            std::size_t applied{}, removed{};
+        };
+
+        using Statistics = std::array<Statistic, ruleCount>;
+
+        PeepholeOptimizerAMD64(EmitterAMD64& emitter)
+            :m_emitter(emitter), m_instructions(emitter.getInstructions())
+        {}
+
+        void run()
+        {
+            for(bool changed{true}; changed;)
+            {
+                prepare();
+                changed = false;
+
+                for(std::size_t position{0ul}; position < m_instructions.size(); ++position)
+                    for(const auto& pattern: s_patterns)
+                    {
+                        if(m_removed[position])
+                            break;
+
+                        if((this->*pattern.apply)(position))
+                        {
+                            ++m_statistics[static_cast<std::size_t>(pattern.rule)].applied;
+                            changed = true;
+                        }
+                    }
+
+                compact();
+            }
+        }
+
+        [[nodiscard]] inline const Statistics& getStatistics() const { return m_statistics; }
+
+        [[nodiscard]] static std::string_view getRuleName(Rule rule)
+        {
+            switch(rule)
+            {
+            case Rule::SelfMove: return "self moves";
+            case Rule::PushPop: return "push/pop elimination";
+            case Rule::StackAdjustment: return "stack adjustments";
+            case Rule::StoreForwarding: return "store-to-load forwarding";
+            case Rule::ConditionalChain: return "set-test chains";
+            case Rule::JumpThreading: return "jump threading";
+            case Rule::UnreachableCode: return "unreachable code";
+            case Rule::DeadLabel: return "dead labels";
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(rule);
+            }
+        }
+    private:
+        struct Pattern final
+        {
+            Rule rule;
+            bool (PeepholeOptimizerAMD64::*apply)(std::size_t);
+        };
+
+        static constexpr std::uint8_t s_stack{LINC_REGISTERS_STACK};
+
+        /// @brief The longest chain of jumps to jumps followed when threading a jump.
+        static constexpr std::size_t s_maximumHops{16ul};
+
+        /// @brief Index the labels and count the references to every symbol, by the instructions or by the data segment, before
+        /// a sweep over the instructions.
+        void prepare()
+        {
+            m_removed.assign(m_instructions.size(), false);
+            m_labels.clear();
+            m_references.clear();
+
+            for(auto symbol: m_emitter.getDataReferences())
+                ++m_references[symbol];
+
+            for(std::size_t position{0ul}; position < m_instructions.size(); ++position)
+            {
+                const auto& instruction = m_instructions[position];
+                if(instruction.form == Instruction::Form::Label)
+                    m_labels[instruction.operands[0ul].symbol] = position;
+                else reference(instruction, 1);
+            }
+        }
+
+        void compact()
+        {
+            std::size_t count{0ul};
+            for(std::size_t position{0ul}; position < m_instructions.size(); ++position)
+                if(!m_removed[position])
+                    m_instructions[count++] = m_instructions[position];
+
+            m_instructions.resize(count);
+        }
+
+        void reference(const Instruction& instruction, int difference)
+        {
+            for(const auto& operand: instruction.operands)
+                if(operand.symbol != Operand::noSymbol)
+                    m_references[operand.symbol] += difference;
+        }
+
+        void remove(std::size_t position, Rule rule)
+        {
+            if(m_instructions[position].form != Instruction::Form::Label)
+                reference(m_instructions[position], -1);
+
+            m_removed[position] = true;
+            ++m_statistics[static_cast<std::size_t>(rule)].removed;
+        }
+
+        void replace(std::size_t position, const Instruction& instruction)
+        {
+            reference(m_instructions[position], -1);
+            m_instructions[position] = instruction;
+            reference(instruction, 1);
+        }
+
+        /// @brief Get the position of the next instruction that was not removed.
+        [[nodiscard]] std::size_t next(std::size_t position) const
+        {
+            do ++position;
+            while(position < m_instructions.size() && m_removed[position]);
+
+            return position;
+        }
+
+        /// @brief Get the position of the first instruction at or after a position that is neither removed nor a label.
+        [[nodiscard]] std::size_t skipLabels(std::size_t position) const
+        {
+            while(position < m_instructions.size() && (m_removed[position] || m_instructions[position].form == Instruction::Form::Label))
+                ++position;
+
+            return position;
+        }
+
+        [[nodiscard]] bool is(std::size_t position, BinaryInstruction binary) const
+        {
+            return position < m_instructions.size() && m_instructions[position].form == Instruction::Form::Binary
+                && m_instructions[position].binary == binary && m_instructions[position].kind == InstructionKind::General;
+        }
+
+        [[nodiscard]] bool is(std::size_t position, UnaryInstruction unary) const
+        {
+            return position < m_instructions.size() && m_instructions[position].form == Instruction::Form::Unary
+                && m_instructions[position].unary == unary;
+        }
+
+        [[nodiscard]] static bool isRegister(const Operand& operand, std::optional<std::uint8_t> order = std::nullopt)
+        {
+            return operand.kind == Operand::Kind::Register && (!order || operand.order == *order);
+        }
+
+        [[nodiscard]] static bool isJump(UnaryInstruction unary)
+        {
+            switch(unary)
+            {
+            case UnaryInstruction::Jump:
+            case UnaryInstruction::JumpIfZero:
+            case UnaryInstruction::JumpIfNotZero:
+            case UnaryInstruction::JumpIfEqual:
+            case UnaryInstruction::JumpIfNotEqual:
+            case UnaryInstruction::JumpIfGreater:
+            case UnaryInstruction::JumpIfLess:
+            case UnaryInstruction::JumpIfGreaterEqual:
+            case UnaryInstruction::JumpIfLessEqual:
+            case UnaryInstruction::JumpIfAbove:
+            case UnaryInstruction::JumpIfBelow:
+            case UnaryInstruction::JumpIfAboveEqual:
+            case UnaryInstruction::JumpIfBelowEqual:
+                return true;
+            default: return false;
+            }
+        }
+
+        /// @brief Get the jump taken exactly when the specified one is not.
+        [[nodiscard]] static std::optional<UnaryInstruction> negate(UnaryInstruction jump)
+        {
+            switch(jump)
+            {
+            case UnaryInstruction::JumpIfZero: return UnaryInstruction::JumpIfNotZero;
+            case UnaryInstruction::JumpIfNotZero: return UnaryInstruction::JumpIfZero;
+            case UnaryInstruction::JumpIfEqual: return UnaryInstruction::JumpIfNotEqual;
+            case UnaryInstruction::JumpIfNotEqual: return UnaryInstruction::JumpIfEqual;
+            case UnaryInstruction::JumpIfGreater: return UnaryInstruction::JumpIfLessEqual;
+            case UnaryInstruction::JumpIfLessEqual: return UnaryInstruction::JumpIfGreater;
+            case UnaryInstruction::JumpIfLess: return UnaryInstruction::JumpIfGreaterEqual;
+            case UnaryInstruction::JumpIfGreaterEqual: return UnaryInstruction::JumpIfLess;
+            case UnaryInstruction::JumpIfAbove: return UnaryInstruction::JumpIfBelowEqual;
+            case UnaryInstruction::JumpIfBelowEqual: return UnaryInstruction::JumpIfAbove;
+            case UnaryInstruction::JumpIfBelow: return UnaryInstruction::JumpIfAboveEqual;
+            case UnaryInstruction::JumpIfAboveEqual: return UnaryInstruction::JumpIfBelow;
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Get the general purpose jump testing the same condition as a set instruction (floating-point comparisons
+        /// set the flags as unsigned ones do).
+        [[nodiscard]] static std::optional<UnaryInstruction> getJump(const Instruction& set)
+        {
+            const bool is_unsigned = set.kind != InstructionKind::General;
+
+            switch(set.unary)
+            {
+            case UnaryInstruction::SetIfEqual: return UnaryInstruction::JumpIfEqual;
+            case UnaryInstruction::SetIfNotEqual: return UnaryInstruction::JumpIfNotEqual;
+            case UnaryInstruction::SetIfGreater: return is_unsigned? UnaryInstruction::JumpIfAbove: UnaryInstruction::JumpIfGreater;
+            case UnaryInstruction::SetIfGreaterEqual: return is_unsigned? UnaryInstruction::JumpIfAboveEqual: UnaryInstruction::JumpIfGreaterEqual;
+            case UnaryInstruction::SetIfLess: return is_unsigned? UnaryInstruction::JumpIfBelow: UnaryInstruction::JumpIfLess;
+            case UnaryInstruction::SetIfLessEqual: return is_unsigned? UnaryInstruction::JumpIfBelowEqual: UnaryInstruction::JumpIfLessEqual;
+            case UnaryInstruction::SetIfAbove: return UnaryInstruction::JumpIfAbove;
+            case UnaryInstruction::SetIfAboveEqual: return UnaryInstruction::JumpIfAboveEqual;
+            case UnaryInstruction::SetIfBelow: return UnaryInstruction::JumpIfBelow;
+            case UnaryInstruction::SetIfBelowEqual: return UnaryInstruction::JumpIfBelowEqual;
+            default: return std::nullopt;
+            }
+        }
+
+        /// @brief Whether an instruction transfers control, other than by falling through to the next one.
+        [[nodiscard]] static bool isControlFlow(const Instruction& instruction)
+        {
+            return instruction.form == Instruction::Form::Label
+                || (instruction.form == Instruction::Form::Unary && (isJump(instruction.unary) || instruction.unary == UnaryInstruction::Call))
+                || (instruction.form == Instruction::Form::Nullary && (instruction.nullary == NullaryInstruction::Return
+                    || instruction.nullary == NullaryInstruction::Syscall));
+        }
+
+        /// @brief Whether an instruction reads or writes the stack pointer, or memory relative to it.
+        [[nodiscard]] static bool usesStack(const Instruction& instruction)
+        {
+            if(instruction.form == Instruction::Form::Nullary && instruction.nullary == NullaryInstruction::Leave)
+                return true;
+
+            if(instruction.form == Instruction::Form::Unary && (instruction.unary == UnaryInstruction::Push || instruction.unary == UnaryInstruction::Pop))
+                return true;
+
+            return std::any_of(instruction.operands.begin(), instruction.operands.end(), [](const Operand& operand)
+            {
+                return (operand.kind == Operand::Kind::Register && operand.order == s_stack)
+                    || (operand.kind == Operand::Kind::Memory && (operand.order == s_stack || operand.index == s_stack));
+            });
+        }
+
+        /// @brief Whether an instruction may write a general purpose register. Control flow is not accounted for.
+        [[nodiscard]] static bool writes(const Instruction& instruction, std::uint8_t order)
+        {
+            switch(instruction.form)
+            {
+            case Instruction::Form::Nullary:
+                switch(instruction.nullary)
+                {
+                case NullaryInstruction::ConvertByteWord: return order == LINC_REGISTERS_A;
+                case NullaryInstruction::ConvertWordDouble:
+                case NullaryInstruction::ConvertDoubleQuad:
+                case NullaryInstruction::ConvertQuadOctal:
+                    return order == LINC_REGISTERS_D;
+                default: return true;
+                }
+            case Instruction::Form::Unary:
+                switch(instruction.unary)
+                {
+                case UnaryInstruction::Push: return false;
+                case UnaryInstruction::UnsignedMultiply:
+                case UnaryInstruction::SignedMultiply:
+                case UnaryInstruction::UnsignedDivide:
+                case UnaryInstruction::SignedDivide:
+                    return order == LINC_REGISTERS_A || order == LINC_REGISTERS_D;
+                default: return isRegister(instruction.operands[0ul], order) || isJump(instruction.unary);
+                }
+            case Instruction::Form::Binary:
+                if(instruction.binary == BinaryInstruction::Compare || instruction.binary == BinaryInstruction::Test)
+                    return false;
+                return isRegister(instruction.operands[0ul], order);
+            default: return true;
+            }
+        }
+
+        /// @brief `mov reg, reg`, unless it is a 32-bit move, which clears the upper bits of the register.
+        bool eliminateSelfMove(std::size_t position)
+        {
+            const auto& instruction = m_instructions[position];
+            if(!is(position, BinaryInstruction::Move) || !isRegister(instruction.operands[0ul])
+                || instruction.operands[0ul] != instruction.operands[1ul] || instruction.operands[0ul].size == Registers::Size::DoubleWord)
+                return false;
+
+            remove(position, Rule::SelfMove);
+            return true;
+        }
+
+        /// @brief `push a` followed by `pop b`, with no instruction in between touching the stack or writing `a`: removed if `a`
+        /// and `b` are the same register, and otherwise replaced by `mov b, a` if the instructions are adjacent.
+        bool eliminatePushPop(std::size_t position)
+        {
+            const auto& push = m_instructions[position];
+            if(!is(position, UnaryInstruction::Push) || !isRegister(push.operands[0ul]))
+                return false;
+
+            const auto pushed = push.operands[0ul];
+            bool is_adjacent{true};
+
+            for(auto current = next(position); current < m_instructions.size(); current = next(current), is_adjacent = false)
+            {
+                const auto& instruction = m_instructions[current];
+
+                if(is(current, UnaryInstruction::Pop) && isRegister(instruction.operands[0ul]))
+                {
+                    if(instruction.operands[0ul] == pushed)
+                    {
+                        remove(position, Rule::PushPop);
+                        remove(current, Rule::PushPop);
+                        return true;
+                    }
+                    else if(!is_adjacent)
+                        return false;
+
+                    replace(position, Instruction{.form = Instruction::Form::Binary, .binary = BinaryInstruction::Move,
+                        .operands = {instruction.operands[0ul], pushed}});
+                    remove(current, Rule::PushPop);
+                    return true;
+                }
+
+                if(isControlFlow(instruction) || usesStack(instruction) || writes(instruction, pushed.order))
+                    return false;
+            }
+
+            return false;
+        }
+
+        /// @brief `add rsp, 0` or `sub rsp, 0` are removed, and consecutive stack adjustments merged.
+        bool mergeStackAdjustments(std::size_t position)
+        {
+            auto getAdjustment = [&](std::size_t current) -> std::optional<Types::i64>
+            {
+                if(!is(current, BinaryInstruction::Add) && !is(current, BinaryInstruction::Subtract))
+                    return std::nullopt;
+
+                const auto& instruction = m_instructions[current];
+                if(!isRegister(instruction.operands[0ul], s_stack) || instruction.operands[1ul].kind != Operand::Kind::Immediate)
+                    return std::nullopt;
+
+                return instruction.binary == BinaryInstruction::Add? instruction.operands[1ul].value: -instruction.operands[1ul].value;
+            };
+
+            auto adjustment = getAdjustment(position);
+            if(!adjustment)
+                return false;
+
+            if(*adjustment == 0l)
+            {
+                remove(position, Rule::StackAdjustment);
+                return true;
+            }
+
+            auto following = next(position);
+            auto next_adjustment = getAdjustment(following);
+            if(!next_adjustment)
+                return false;
+
+            auto total = *adjustment + *next_adjustment;
+            auto& instruction = m_instructions[position];
+            instruction.binary = total < 0l? BinaryInstruction::Subtract: BinaryInstruction::Add;
+            instruction.operands[1ul] = EmitterAMD64::getImmediate(total < 0l? -total: total);
+            remove(following, Rule::StackAdjustment);
+
+            if(total == 0l)
+                remove(position, Rule::StackAdjustment);
+            return true;
+        }
+
+        /// @brief A load directly following a store to the same location reads the stored register instead.
+        bool forwardStore(std::size_t position)
+        {
+            const auto& store = m_instructions[position];
+            if(!is(position, BinaryInstruction::Move) || store.operands[0ul].kind != Operand::Kind::Memory || !isRegister(store.operands[1ul]))
+                return false;
+
+            const auto load = next(position);
+            if(load >= m_instructions.size() || m_instructions[load].form != Instruction::Form::Binary
+                || m_instructions[load].kind != InstructionKind::General || m_instructions[load].operands[1ul] != store.operands[0ul]
+                || !isRegister(m_instructions[load].operands[0ul]))
+                return false;
+
+            switch(m_instructions[load].binary)
+            {
+            case BinaryInstruction::Move:
+            case BinaryInstruction::MoveExtend:
+            case BinaryInstruction::MoveSignExtend:
+            case BinaryInstruction::MoveSignExtendDoubleWord:
+                break;
+            default: return false;
+            }
+
+            m_instructions[load].operands[1ul] = store.operands[1ul];
+            return true;
+        }
+
+        /// @brief `setcc r8`, optionally extended into its own register, then `test r8, r8` and a jump on whether it is zero:
+        /// the jump tests the flags of the comparison directly instead (the value set is kept, as it may still be used).
+        bool shortenConditionalChain(std::size_t position)
+        {
+            const auto& set = m_instructions[position];
+            if(set.form != Instruction::Form::Unary || !isRegister(set.operands[0ul]) || set.operands[0ul].size != Registers::Size::Byte)
+                return false;
+
+            auto condition = getJump(set);
+            if(!condition)
+                return false;
+
+            const auto value = set.operands[0ul];
+            auto test = next(position);
+
+            while((is(test, BinaryInstruction::MoveExtend) || is(test, BinaryInstruction::MoveSignExtend))
+                && isRegister(m_instructions[test].operands[0ul], value.order) && m_instructions[test].operands[1ul] == value)
+                test = next(test);
+
+            if(!is(test, BinaryInstruction::Test) || m_instructions[test].operands[0ul] != value || m_instructions[test].operands[1ul] != value)
+                return false;
+
+            const auto jump = next(test);
+            if(jump >= m_instructions.size() || m_instructions[jump].form != Instruction::Form::Unary
+                || m_instructions[jump].kind != InstructionKind::General)
+                return false;
+
+            switch(m_instructions[jump].unary)
+            {
+            case UnaryInstruction::JumpIfZero:
+            case UnaryInstruction::JumpIfEqual:
+                condition = negate(*condition);
+                break;
+            case UnaryInstruction::JumpIfNotZero:
+            case UnaryInstruction::JumpIfNotEqual:
+                break;
+            default: return false;
+            }
+
+            m_instructions[jump].unary = *condition;
+            remove(test, Rule::ConditionalChain);
+            return true;
+        }
+
+        /// @brief Jumps to a jump go to its target directly, jumps to the next instruction are removed, and a conditional jump
+        /// over an unconditional one is inverted to replace it.
+        bool threadJump(std::size_t position)
+        {
+            auto& jump = m_instructions[position];
+            if(jump.form != Instruction::Form::Unary || !isJump(jump.unary) || jump.operands[0ul].kind != Operand::Kind::Symbol)
+                return false;
+
+            const auto target = jump.operands[0ul].symbol;
+            auto label = m_labels.find(target);
+            if(label == m_labels.end())
+                return false;
+
+            // jumping to the next instruction
+            if(skipLabels(next(position)) >= label->second && label->second > position)
+            {
+                remove(position, Rule::JumpThreading);
+                return true;
+            }
+
+            // jumping to a chain of unconditional jumps, which must end
+            auto destination = target;
+            for(std::size_t hop{0ul}; hop <= s_maximumHops; ++hop)
+            {
+                auto find = m_labels.find(destination);
+                if(find == m_labels.end())
+                    break;
+
+                auto first = skipLabels(find->second);
+                if(!is(first, UnaryInstruction::Jump) || m_instructions[first].operands[0ul].kind != Operand::Kind::Symbol)
+                    break;
+                if(hop == s_maximumHops)
+                    return false;
+
+                destination = m_instructions[first].operands[0ul].symbol;
+            }
+
+            if(destination != target)
+            {
+                auto threaded = jump;
+                threaded.operands[0ul].symbol = destination;
+                replace(position, threaded);
+                return true;
+            }
+
+            // a conditional jump over an unconditional one
+            const auto following = next(position);
+            if(jump.unary == UnaryInstruction::Jump || !is(following, UnaryInstruction::Jump)
+                || m_instructions[following].operands[0ul].kind != Operand::Kind::Symbol
+                || label->second <= following || skipLabels(next(following)) < label->second)
+                return false;
+
+            auto negated = negate(jump.unary);
+            if(!negated)
+                return false;
+
+            auto inverted = jump;
+            inverted.unary = *negated;
+            inverted.operands[0ul] = m_instructions[following].operands[0ul];
+            replace(position, inverted);
+            remove(following, Rule::JumpThreading);
+            return true;
+        }
+
+        /// @brief Instructions following an unconditional jump or a return, up to the next label, are never executed.
+        bool removeUnreachableCode(std::size_t position)
+        {
+            const auto& instruction = m_instructions[position];
+            if(!is(position, UnaryInstruction::Jump) && !(instruction.form == Instruction::Form::Nullary && instruction.nullary == NullaryInstruction::Return))
+                return false;
+
+            bool removed{};
+            for(auto current = next(position); current < m_instructions.size() && m_instructions[current].form != Instruction::Form::Label;
+                current = next(current))
+            {
+                remove(current, Rule::UnreachableCode);
+                removed = true;
+            }
+
+            return removed;
+        }
+
+        /// @brief Labels that are neither referenced nor global. Local labels belong to the last non-local label, which is kept
+        /// when followed by any.
+        bool removeDeadLabel(std::size_t position)
+        {
+            const auto& instruction = m_instructions[position];
+            if(instruction.form != Instruction::Form::Label)
+                return false;
+
+            const auto symbol = instruction.operands[0ul].symbol;
+            const auto& name = m_emitter.getSymbolName(symbol);
+            if(m_references[symbol] > 0 || m_emitter.isGlobal(name))
+                return false;
+
+            if(!name.starts_with('.'))
+                for(auto current = next(position); current < m_instructions.size(); current = next(current))
+                    if(const auto& other = m_instructions[current]; other.form == Instruction::Form::Label)
+                    {
+                        if(m_emitter.getSymbolName(other.operands[0ul].symbol).starts_with('.'))
+                            return false;
+                        break;
+                    }
+
+            remove(position, Rule::DeadLabel);
+            return true;
+        }
+
+        static constexpr std::array<Pattern, ruleCount> s_patterns{
+            Pattern{Rule::UnreachableCode, &PeepholeOptimizerAMD64::removeUnreachableCode},
+            Pattern{Rule::DeadLabel, &PeepholeOptimizerAMD64::removeDeadLabel},
+            Pattern{Rule::JumpThreading, &PeepholeOptimizerAMD64::threadJump},
+            Pattern{Rule::ConditionalChain, &PeepholeOptimizerAMD64::shortenConditionalChain},
+            Pattern{Rule::StoreForwarding, &PeepholeOptimizerAMD64::forwardStore},
+            Pattern{Rule::PushPop, &PeepholeOptimizerAMD64::eliminatePushPop},
+            Pattern{Rule::StackAdjustment, &PeepholeOptimizerAMD64::mergeStackAdjustments},
+            Pattern{Rule::SelfMove, &PeepholeOptimizerAMD64::eliminateSelfMove}
+        };
+
+        EmitterAMD64& m_emitter;
+        std::vector<Instruction>& m_instructions;
+        std::vector<bool> m_removed;
+        std::unordered_map<std::uint32_t, std::size_t> m_labels;
+        std::unordered_map<std::uint32_t, int> m_references;
+        Statistics m_statistics{};
+    };
+}
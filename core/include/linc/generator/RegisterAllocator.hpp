@@ -0,0 +1,241 @@
+#pragma once
+#include <linc/BoundTree.hpp>
+#include <linc/generator/Registers.hpp>
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief Linear-scan register allocator for the arguments and local variables of a function. A pre-pass numbers the nodes
+    /// of the function body in evaluation order and computes the live interval of every variable, extended over the loops it is
+    /// used in. Intervals are then assigned to the caller-saved register pool, spilling those that end last to the stack when
+    /// more of them overlap than there are registers left over by the temporaries.
+    class RegisterAllocator final
+    {
+    public:
+        struct Interval final
+        {
+            std::size_t start, end;
+            std::optional<std::uint8_t> fixedRegister, location;
+        };
+
+        /// @brief Compute the live intervals of a function and assign them their locations.
+        /// Intervals are indexed in declaration order, starting with the arguments of the function.
+        void allocate(const BoundFunctionDeclaration* declaration)
+        {
+            m_positions.clear();
+            m_intervals.clear();
+            m_loops.clear();
+            m_names = ScopeStack<std::size_t>();
+            m_position = 0ul;
+
+            const auto& arguments = declaration->getArguments();
+            for(std::size_t i{0ul}; i < arguments.size(); ++i)
+                declare(arguments[i]->getName(), Registers::getArgument(static_cast<std::uint8_t>(i)));
+
+            numberExpression(declaration->getBody());
+            scan();
+        }
+
+        /// @brief Get the position of a node within the function. Expressions are positioned after their operands have been
+        /// evaluated, while statements are positioned before any of their contents.
+        [[nodiscard]] inline std::size_t getPosition(const BoundNode* node) const { return m_positions.at(node); }
+        [[nodiscard]] inline const Interval& getInterval(std::size_t index) const { return m_intervals.at(index); }
+
+        /// @brief The number of registers never assigned to variables, so that any expression can be evaluated without spilling them.
+        [[nodiscard]] static constexpr std::size_t getReservedCount() { return s_reservedCount; }
+    private:
+        struct Loop final
+        {
+            std::size_t start;
+            std::vector<std::size_t> intervals;
+        };
+
+        void declare(const std::string& name, std::optional<std::uint8_t> fixed_register = std::nullopt)
+        {
+            const auto position = m_position++;
+            m_names.update(name, m_intervals.size());
+            m_intervals.push_back(Interval{.start = position, .end = position, .fixedRegister = fixed_register, .location = std::nullopt});
+        }
+
+        void use(const std::string& name, std::size_t position)
+        {
+            auto find = m_names.find(name);
+            if(!find) return;
+
+            auto& interval = m_intervals[*find];
+            interval.end = std::max(interval.end, position);
+
+            for(auto& loop: m_loops)
+                if(interval.start < loop.start)
+                    loop.intervals.push_back(*find);
+        }
+
+        void numberStatement(const BoundStatement* statement)
+        {
+            m_positions[statement] = m_position;
+
+            switch(statement->getKind())
+            {
+            case BoundNode::Kind::ExpressionStatement:
+                numberExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression());
+                break;
+            case BoundNode::Kind::ReturnStatement:
+                numberExpression(static_cast<const BoundReturnStatement*>(statement)->getExpression());
+                break;
+            case BoundNode::Kind::DeclarationStatement:
+            {
+                auto declaration = static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration();
+                if(declaration->getKind() != BoundNode::Kind::VariableDeclaration)
+                    break;
+
+                auto variable = static_cast<const BoundVariableDeclaration*>(declaration);
+                if(auto default_value = variable->getDefaultValue())
+                    numberExpression(*default_value);
+                declare(variable->getName());
+                break;
+            }
+            default: break;
+            }
+        }
+
+        void numberExpression(const BoundExpression* expression)
+        {
+            switch(expression->getKind())
+            {
+            case BoundNode::Kind::IdentifierExpression:
+                use(static_cast<const BoundIdentifierExpression*>(expression)->getValue(), m_position);
+                break;
+            case BoundNode::Kind::UnaryExpression:
+                numberExpression(static_cast<const BoundUnaryExpression*>(expression)->getOperand());
+                break;
+            case BoundNode::Kind::BinaryExpression:
+                numberExpression(static_cast<const BoundBinaryExpression*>(expression)->getLeft());
+                numberExpression(static_cast<const BoundBinaryExpression*>(expression)->getRight());
+                break;
+            case BoundNode::Kind::ConversionExpression:
+                numberExpression(static_cast<const BoundConversionExpression*>(expression)->getExpression());
+                break;
+            case BoundNode::Kind::IndexExpression:
+                numberExpression(static_cast<const BoundIndexExpression*>(expression)->getArray());
+                numberExpression(static_cast<const BoundIndexExpression*>(expression)->getIndex());
+                break;
+            case BoundNode::Kind::FunctionCallExpression:
+                for(const auto& argument: static_cast<const BoundFunctionCallExpression*>(expression)->getArguments())
+                    numberExpression(argument.value.get());
+                break;
+            case BoundNode::Kind::ExternalCallExpression:
+                for(const auto& argument: static_cast<const BoundExternalCallExpression*>(expression)->getArguments())
+                    numberExpression(argument.get());
+                break;
+            case BoundNode::Kind::BlockExpression:
+            {
+                auto block = static_cast<const BoundBlockExpression*>(expression);
+                m_names.beginScope();
+
+                for(const auto& statement: block->getStatements())
+                    numberStatement(statement.get());
+
+                if(auto tail = block->getTail())
+                    numberExpression(tail);
+
+                m_names.endScope();
+                break;
+            }
+            case BoundNode::Kind::IfExpression:
+            {
+                auto if_expression = static_cast<const BoundIfExpression*>(expression);
+                m_names.beginScope();
+                numberExpression(if_expression->getTestExpression());
+                numberExpression(if_expression->getIfBody());
+
+                if(if_expression->hasElse())
+                    numberExpression(if_expression->getElseBody());
+
+                m_names.endScope();
+                break;
+            }
+            case BoundNode::Kind::WhileExpression:
+            {
+                auto while_expression = static_cast<const BoundWhileExpression*>(expression);
+                m_names.beginScope();
+                m_loops.push_back(Loop{.start = m_position, .intervals = {}});
+                numberExpression(while_expression->getTestExpression());
+                numberExpression(while_expression->getWhileBody());
+
+                // variables used within the loop must survive until its back edge
+                for(auto index: m_loops.back().intervals)
+                    m_intervals[index].end = std::max(m_intervals[index].end, m_position);
+                m_loops.pop_back();
+
+                if(while_expression->hasFinally())
+                    numberExpression(while_expression->getFinallyBody());
+                if(while_expression->hasElse())
+                    numberExpression(while_expression->getElseBody());
+
+                m_names.endScope();
+                break;
+            }
+            default: break;
+            }
+
+            m_positions[expression] = m_position++;
+        }
+
+        void scan()
+        {
+            constexpr auto variable_limit = Registers::getPoolSize() - s_reservedCount;
+            std::vector<std::size_t> active;
+            std::array<bool, Registers::getPoolSize()> occupied{};
+
+            for(std::size_t index{0ul}; index < m_intervals.size(); ++index)
+            {
+                auto& interval = m_intervals[index];
+
+                std::erase_if(active, [&](std::size_t active_index)
+                {
+                    const auto& active_interval = m_intervals[active_index];
+                    if(active_interval.end >= interval.start)
+                        return false;
+
+                    occupied[*active_interval.location] = false;
+                    return true;
+                });
+
+                if(interval.fixedRegister && !occupied[*interval.fixedRegister])
+                    interval.location = interval.fixedRegister;
+                else if(active.size() < variable_limit)
+                {
+                    for(auto i = static_cast<std::uint8_t>(Registers::getPoolSize()); i-- > 0;)
+                        if(!occupied[i])
+                        {
+                            interval.location = i;
+                            break;
+                        }
+                }
+                else
+                {
+                    auto spill = std::ranges::max_element(active, {}, [&](std::size_t active_index){ return m_intervals[active_index].end; });
+                    auto& spill_interval = m_intervals[*spill];
+
+                    if(spill_interval.end <= interval.end)
+                        continue;
+
+                    interval.location = spill_interval.location;
+                    spill_interval.location = std::nullopt;
+                    active.erase(spill);
+                    occupied[*interval.location] = false;
+                }
+
+                occupied[*interval.location] = true;
+                active.push_back(index);
+            }
+        }
+
+        std::unordered_map<const BoundNode*, std::size_t> m_positions;
+        std::vector<Interval> m_intervals;
+        std::vector<Loop> m_loops;
+        ScopeStack<std::size_t> m_names;
+        std::size_t m_position{0ul};
+        static constexpr std::size_t s_reservedCount{2ul};
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <linc/System.hpp>
 #include <linc/Include.hpp>
+#include <algorithm>
 #define LINC_REGISTERS_A 0
 #define LINC_REGISTERS_B 1
 #define LINC_REGISTERS_C 2
@@ -23,7 +24,7 @@ namespace linc
         
         static auto& get()
         {
-            static std::array<bool, s_registerCount> registers = {false};
+            static thread_local std::array<bool, s_registerCount> registers = {false};
             return registers;
         }
 
@@ -35,6 +36,21 @@ namespace linc
             return string_map.at(index); 
         }
 
+        static std::string getName(std::uint8_t index, Size size)
+        {
+            static constexpr std::array<unsigned char, s_registerCount> order_map{
+                LINC_REGISTERS_C, LINC_REGISTERS_D, LINC_REGISTERS_SOURCE, LINC_REGISTERS_DEST, 8, 9, 10, 11
+            };
+            return getRegister(order_map.at(index), size);
+        }
+
+        /// @brief Get the index within the allocatable pool of the register holding the specified function argument.
+        static std::uint8_t getArgument(std::uint8_t index)
+        {
+            static constexpr std::array<std::uint8_t, s_argumentCount> index_map{3, 2, 1, 0, 4, 5};
+            return index_map.at(index);
+        }
+
         static std::string getArgumentName(std::uint8_t index, Size size = Size::QuadWord)
         {
             const std::array<std::string, s_argumentCount> string_map{
@@ -115,6 +131,16 @@ namespace linc
             throw LINC_EXCEPTION_INVALID_INPUT("Ran out of available registers to allocate.");
         }
 
+        static void reserve(std::uint8_t register_index)
+        {
+            auto& _register = get().at(register_index);
+
+            if(_register)
+                throw LINC_EXCEPTION_INVALID_INPUT("Tried to reserve a register, but it was already allocated.");
+
+            _register = true;
+        }
+
         static void free(std::uint8_t register_index)
         {
             auto& _register = get().at(register_index);
@@ -124,6 +150,11 @@ namespace linc
 
             _register = false;
         }
+
+        static void reset() { get().fill(false); }
+        [[nodiscard]] static bool isAllocated(std::uint8_t register_index) { return get().at(register_index); }
+        [[nodiscard]] static std::size_t getAvailable() { return static_cast<std::size_t>(std::ranges::count(get(), false)); }
+        [[nodiscard]] static constexpr std::size_t getPoolSize() { return s_registerCount; }
     private:
         static constexpr std::size_t s_registerCount{8ul}, s_argumentCount{6ul};
     };
@@ -0,0 +1,679 @@
+#pragma once
+#include <linc/generator/Bytecode.hpp>
+#include <linc/generator/BytecodeCompiler.hpp>
+#include <linc/generator/Interpreter.hpp>
+#include <linc/system/CompactValue.hpp>
+#include <linc/Include.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LINC_VIRTUAL_MACHINE_COMPUTED_GOTO
+#endif
+
+namespace linc
+{
+    /// @brief Register-based virtual machine, executing programs lowered to bytecode by the BytecodeCompiler. Call frames are
+    /// windows into a single contiguous register stack, with each callee's frame starting at the caller's argument registers.
+    /// Registers hold compact values, so that arithmetic on scalars never constructs nor destroys a Value.
+    class VirtualMachine final
+    {
+    public:
+        using Register = Bytecode::Register;
+
+        /// @brief Compile a program to bytecode and run it, calling its entry point main().
+        /// @return The exit code of the program, or nullopt if it cannot be run by the virtual machine (see getUnsupportedReason()).
+        [[nodiscard("The return value of this function must match that of the environment's entry point (i.e. main()).")]]
+        std::optional<int> evaluateProgram(const BoundProgram* program, Binder& binder, std::unique_ptr<const ArrayInitializerExpression> argument_list)
+        {
+            auto bound_main_call = Interpreter::bindEntryPoint(binder, std::move(argument_list));
+
+            if(!bound_main_call)
+                return LINC_EXIT_PROGRAM_FAILURE;
+
+            auto bytecode = m_compiler.compileProgram(program, bound_main_call.get());
+
+            if(!bytecode)
+                return std::nullopt;
+
+            return Interpreter::toExitCode(bound_main_call->getType(), execute(*bytecode));
+        }
+
+        /// @brief The reason for which the last program could not be compiled to bytecode.
+        [[nodiscard]] inline const std::string& getUnsupportedReason() const { return m_compiler.getUnsupportedReason(); }
+
+        /// @brief Run the entry point of a compiled program.
+        /// @return The value returned by the entry point.
+        Value execute(const Bytecode::Program& program)
+        {
+            struct Frame final
+            {
+                const Bytecode::Function* function;
+                const Bytecode::Instruction* instruction;
+                std::size_t base;
+                Register destination;
+            };
+
+            std::vector<Frame> frames;
+            m_stack.clear();
+            m_boxes.clear();
+            m_freeBoxes.clear();
+            m_globals.assign(program.globalCount, CompactValue{});
+            m_constants.clear();
+            m_constants.reserve(program.constants.size());
+
+            for(const auto& constant: program.constants)
+                m_constants.push_back(compact(constant));
+
+            const Bytecode::Function* function = &program.functions.at(program.entryPoint);
+            const Bytecode::Instruction* code = function->instructions.data();
+            const Bytecode::Instruction* instruction = code;
+            const Bytecode::Instruction* current{};
+            std::size_t base{0ul};
+            CompactValue* registers = reserve(function->registerCount);
+
+        #ifdef LINC_VIRTUAL_MACHINE_COMPUTED_GOTO
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wpedantic"
+            #define LINC_VIRTUAL_MACHINE_LABEL(name) &&label_##name,
+            static void* const labels[] = {LINC_BYTECODE_OPCODES(LINC_VIRTUAL_MACHINE_LABEL)};
+            #undef LINC_VIRTUAL_MACHINE_LABEL
+
+            #define LINC_VIRTUAL_MACHINE_CASE(name) label_##name:
+            #define LINC_VIRTUAL_MACHINE_DISPATCH() do { current = instruction++; goto *labels[static_cast<std::size_t>(current->code)]; } while(false)
+
+            LINC_VIRTUAL_MACHINE_DISPATCH();
+        #else
+            #define LINC_VIRTUAL_MACHINE_CASE(name) case Bytecode::OpCode::name:
+            #define LINC_VIRTUAL_MACHINE_DISPATCH() continue
+
+            for(;;)
+            {
+                current = instruction++;
+                switch(current->code)
+                {
+        #endif
+            LINC_VIRTUAL_MACHINE_CASE(Move)
+                copy(registers[current->a], registers[current->b]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(LoadConstant)
+                copy(registers[current->a], m_constants[current->b]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(LoadGlobal)
+                copy(registers[current->a], m_globals[current->b]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(StoreGlobal)
+                copy(m_globals[current->a], registers[current->b]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Jump)
+                instruction = code + current->a;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfFalse)
+                if(!registers[current->a].getBool())
+                    instruction = code + current->b;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfTrue)
+                if(registers[current->a].getBool())
+                    instruction = code + current->b;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfEquals)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left == right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfNotEquals)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left != right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfGreater)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left > right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfLess)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left < right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfGreaterEqual)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left >= right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(JumpIfLessEqual)
+                if(compare(registers[current->a], registers[current->b], [](const auto& left, const auto& right){ return left <= right; }))
+                    instruction = code + current->c;
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Switch)
+            {
+                const auto& table = function->switches[current->b];
+                const auto& operand = registers[current->a];
+                auto clause = BoundMatchExpression::Dispatch::noClause;
+
+                switch(operand.getKind())
+                {
+                case CompactValue::Kind::Boolean: clause = table.dispatch.find(operand.getBool()? 1ul: 0ul); break;
+                case CompactValue::Kind::Character: clause = table.dispatch.find(static_cast<Types::u64>(static_cast<Types::i64>(operand.getChar()))); break;
+                case CompactValue::Kind::Unsigned: clause = table.dispatch.find(operand.getU64()); break;
+                case CompactValue::Kind::Signed: clause = table.dispatch.find(static_cast<Types::u64>(operand.getI64())); break;
+                case CompactValue::Kind::Boxed:
+                {
+                    auto& box = *operand.getBox();
+                    if(box.getKind() == Value::Kind::Enumerator)
+                        clause = table.dispatch.find(box.getEnumerator().getIndex());
+                    else if(box.getKind() != Value::Kind::Primitive)
+                        break;
+                    else if(box.getPrimitive().getKind() == PrimitiveValue::Kind::String)
+                        clause = table.dispatch.find(box.getPrimitive().getStringReference());
+                    else if(auto key = BoundMatchExpression::Dispatch::getKey(box.getPrimitive()))
+                        clause = table.dispatch.find(*key);
+                    break;
+                }
+                default: break;
+                }
+
+                instruction = code + (clause == BoundMatchExpression::Dispatch::noClause? table.targets.back(): table.targets[clause]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(Test)
+                set(registers[current->a], CompactValue(registers[current->b].getBool()));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Narrow)
+                if(registers[current->b].isBoxed())
+                    copy(registers[current->a], registers[current->b]);
+                else set(registers[current->a], narrow(registers[current->b], current->kind));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Add)
+                numeric(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left + right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Subtract)
+                numeric(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left - right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Multiply)
+                numeric(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left * right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Divide)
+                if(registers[current->c].isZero())
+                    divisionByZero(registers[current->a], registers[current->b], registers[current->c], "division");
+                else numeric(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left / right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Modulo)
+                if(registers[current->c].isZero())
+                    divisionByZero(registers[current->a], registers[current->b], registers[current->c], "modulo division");
+                else numeric(registers[current->a], registers[current->b], registers[current->c], current->kind, [](auto left, auto right)
+                {
+                    // Matches PrimitiveValue: the result of a signed modulo division takes the sign of the divisor.
+                    if constexpr(std::is_same_v<decltype(left), Types::i64>)
+                        return (left % right + right) % right;
+                    else if constexpr(std::is_floating_point_v<decltype(left)>)
+                        return static_cast<decltype(left)>(std::fmod(left, right));
+                    else return left % right;
+                });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(BitwiseAnd)
+                integral(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left & right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(BitwiseOr)
+                integral(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left | right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(BitwiseXor)
+                integral(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left ^ right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(ShiftLeft)
+                integral(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left << right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(ShiftRight)
+                integral(registers[current->a], registers[current->b], registers[current->c], current->kind,
+                    [](auto left, auto right){ return left >> right; });
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Equals)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left == right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(NotEquals)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left != right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Greater)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left > right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Less)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left < right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(GreaterEqual)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left >= right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(LessEqual)
+                set(registers[current->a], CompactValue(compare(registers[current->b], registers[current->c],
+                    [](const auto& left, const auto& right){ return left <= right; })));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Negate)
+            {
+                const auto operand = registers[current->b];
+                switch(operand.getKind())
+                {
+                case CompactValue::Kind::Unsigned: set(registers[current->a], narrow(CompactValue(-operand.getU64()), current->kind)); break;
+                case CompactValue::Kind::Signed: set(registers[current->a], narrow(CompactValue(-operand.getI64()), current->kind)); break;
+                case CompactValue::Kind::Float: set(registers[current->a], CompactValue(-operand.getF32())); break;
+                case CompactValue::Kind::Double: set(registers[current->a], CompactValue(-operand.getF64())); break;
+                default: set(registers[current->a], narrow(compact(-operand.toValue()), current->kind));
+                }
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(BitwiseNot)
+            {
+                const auto operand = registers[current->b];
+                switch(operand.getKind())
+                {
+                case CompactValue::Kind::Unsigned: set(registers[current->a], narrow(CompactValue(~operand.getU64()), current->kind)); break;
+                case CompactValue::Kind::Signed: set(registers[current->a], narrow(CompactValue(~operand.getI64()), current->kind)); break;
+                default: set(registers[current->a], narrow(compact(~operand.toValue()), current->kind));
+                }
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(LogicalNot)
+                set(registers[current->a], CompactValue(!registers[current->b].getBool()));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Stringify)
+                set(registers[current->a], compact(PrimitiveValue(registers[current->b].toValue().toApplicationString())));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Count)
+                set(registers[current->a], narrow(count(registers[current->b]), current->kind));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Convert)
+            {
+                const auto operand = registers[current->b];
+                const bool is_integral = operand.getKind() == CompactValue::Kind::Unsigned || operand.getKind() == CompactValue::Kind::Signed;
+                set(registers[current->a], is_integral && current->kind != Types::Kind::invalid? narrow(operand, current->kind):
+                    compact(operand.toValue().getPrimitive().convert(current->kind)));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(Index)
+                set(registers[current->a], element(unbox(registers[current->b]), registers[current->c].getU64()));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(IndexGlobal)
+                set(registers[current->a], element(unbox(m_globals[current->b]), registers[current->c].getU64()));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(SetIndex)
+                setIndex(unbox(registers[current->a]), registers[current->b].getU64(), registers[current->c]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(SetIndexGlobal)
+                setIndex(unbox(m_globals[current->a]), registers[current->b].getU64(), registers[current->c]);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Access)
+                set(registers[current->a], compact(std::as_const(unbox(registers[current->b])).getStructure().at(current->c)));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(AccessGlobal)
+                set(registers[current->a], compact(std::as_const(unbox(m_globals[current->b])).getStructure().at(current->c)));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(SetAccess)
+                unbox(registers[current->a]).getStructure().at(current->b) = registers[current->c].toValue();
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(SetAccessGlobal)
+                unbox(m_globals[current->a]).getStructure().at(current->b) = registers[current->c].toValue();
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(ArrayPush)
+                unbox(registers[current->a]).getArray().push(registers[current->b].toValue());
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(StructurePush)
+                unbox(registers[current->a]).getStructure().push_back(registers[current->b].toValue());
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+
+            LINC_VIRTUAL_MACHINE_CASE(Enumerator)
+            {
+                const auto& enumerator = program.enumerators[current->b];
+                set(registers[current->a], compact(EnumeratorValue(enumerator.name, enumerator.index, registers[current->c].toValue())));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(EnumeratorValue)
+            {
+                const auto operand = registers[current->b];
+                if(operand.isBoxed() && operand.getBox()->getKind() == Value::Kind::Enumerator)
+                    set(registers[current->a], compact(operand.getBox()->getEnumerator().getValue()));
+                else set(registers[current->a], CompactValue{});
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(Call)
+            {
+                const auto& callee = program.functions[current->b];
+                frames.push_back(Frame{.function = function, .instruction = instruction, .base = base, .destination = current->a});
+
+                base += current->c;
+                registers = reserve(base + callee.registerCount) + base;
+                function = &callee;
+                code = instruction = callee.instructions.data();
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(ExternalCall)
+            {
+                const auto& external = program.externals[current->b];
+                std::vector<Value> arguments;
+                arguments.reserve(external.argumentCount);
+
+                for(Register i{0u}; i < external.argumentCount; ++i)
+                    arguments.push_back(registers[current->c + i].toValue());
+
+                auto result = Interpreter::evaluateExternalCall(external.name, arguments);
+
+                for(Register i{0u}; i < external.argumentCount; ++i)
+                    set(registers[current->c + i], compact(std::move(arguments[i])));
+
+                set(registers[current->a], compact(std::move(result)));
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+
+            LINC_VIRTUAL_MACHINE_CASE(Return)
+            {
+                // The result's box (if any) changes hands instead of being copied.
+                const auto result = registers[current->a];
+                registers[current->a] = CompactValue{};
+
+                if(frames.empty())
+                    return result.toValue();
+
+                const auto frame = frames.back();
+                frames.pop_back();
+
+                function = frame.function;
+                code = function->instructions.data();
+                instruction = frame.instruction;
+                base = frame.base;
+                registers = m_stack.data() + base;
+
+                set(registers[frame.destination], result);
+                LINC_VIRTUAL_MACHINE_DISPATCH();
+            }
+        #ifdef LINC_VIRTUAL_MACHINE_COMPUTED_GOTO
+            #pragma GCC diagnostic pop
+        #else
+                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(current->code);
+                }
+            }
+        #endif
+            #undef LINC_VIRTUAL_MACHINE_CASE
+            #undef LINC_VIRTUAL_MACHINE_DISPATCH
+        }
+    private:
+        /// @brief Grow the register stack to hold at least the given number of registers.
+        /// @return The (possibly relocated) beginning of the register stack.
+        CompactValue* reserve(std::size_t size)
+        {
+            if(m_stack.size() < size)
+                m_stack.resize(std::max(size, m_stack.size() * 2ul), CompactValue{});
+
+            return m_stack.data();
+        }
+
+        /// @return The compact form of a value, boxing it unless it is a scalar.
+        CompactValue compact(Value value)
+        {
+            if(auto scalar = CompactValue::fromScalar(value))
+                return *scalar;
+
+            else if(m_freeBoxes.empty())
+                return CompactValue(&m_boxes.emplace_back(std::move(value)));
+
+            auto box = m_freeBoxes.back();
+            m_freeBoxes.pop_back();
+            *box = std::move(value);
+            return CompactValue(box);
+        }
+
+        /// @brief Free the box owned by a value about to be overwritten, if any, dropping its reference to shared storage.
+        void release(CompactValue value)
+        {
+            if(!value.isBoxed())
+                return;
+
+            *value.getBox() = Value(PrimitiveValue::voidValue);
+            m_freeBoxes.push_back(value.getBox());
+        }
+
+        /// @brief Overwrite a register or global with a value whose box (if any) it takes ownership of.
+        inline void set(CompactValue& target, CompactValue value)
+        {
+            release(target);
+            target = value;
+        }
+
+        /// @brief Overwrite a register or global with a copy of another, boxing a copy of the value if it is boxed (which
+        /// only shares its storage), so that every box keeps a single owner.
+        inline void copy(CompactValue& target, const CompactValue& source)
+        {
+            if(&target == &source)
+                return;
+            else if(!source.isBoxed())
+                set(target, source);
+            else set(target, compact(*source.getBox()));
+        }
+
+        /// @return The value held by a string, array, structure or enumerator operand, which are always boxed.
+        static Value& unbox(CompactValue value)
+        {
+            if(!value.isBoxed())
+                throw LINC_EXCEPTION_INVALID_INPUT("Expected a string, array, structure or enumerator operand.");
+
+            return *value.getBox();
+        }
+
+        /// @brief Narrow the integral result of an operation to the given kind (if any), as PrimitiveValue::convert() would.
+        CompactValue narrow(CompactValue value, Types::Kind kind)
+        {
+            if(kind == Types::Kind::invalid || (value.getKind() != CompactValue::Kind::Unsigned && value.getKind() != CompactValue::Kind::Signed))
+                return value;
+
+            const auto bits = value.getKind() == CompactValue::Kind::Signed? static_cast<Types::u64>(value.getI64()): value.getU64();
+
+            switch(kind)
+            {
+            case Types::Kind::u8: return CompactValue(static_cast<Types::u64>(static_cast<Types::u8>(bits)));
+            case Types::Kind::u16: return CompactValue(static_cast<Types::u64>(static_cast<Types::u16>(bits)));
+            case Types::Kind::u32: return CompactValue(static_cast<Types::u64>(static_cast<Types::u32>(bits)));
+            case Types::Kind::u64: return CompactValue(bits);
+            case Types::Kind::i8: return CompactValue(static_cast<Types::i64>(static_cast<Types::i8>(bits)));
+            case Types::Kind::i16: return CompactValue(static_cast<Types::i64>(static_cast<Types::i16>(bits)));
+            case Types::Kind::i32: return CompactValue(static_cast<Types::i64>(static_cast<Types::i32>(bits)));
+            case Types::Kind::i64: return CompactValue(static_cast<Types::i64>(bits));
+            default: break;
+            }
+
+            return compact(value.toValue().getPrimitive().convert(kind));
+        }
+
+        /// @brief Evaluate an arithmetic operation, directly on the operands if they're numbers of the same kind, otherwise
+        /// falling back to the operators of Value.
+        template <typename OPERATION>
+        inline void numeric(CompactValue& target, CompactValue left, CompactValue right, Types::Kind kind, OPERATION operation)
+        {
+            if(left.getKind() == right.getKind())
+                switch(left.getKind())
+                {
+                case CompactValue::Kind::Unsigned: return set(target, narrow(CompactValue(operation(left.getU64(), right.getU64())), kind));
+                case CompactValue::Kind::Signed: return set(target, narrow(CompactValue(operation(left.getI64(), right.getI64())), kind));
+                case CompactValue::Kind::Float: return set(target, CompactValue(static_cast<Types::f32>(operation(left.getF32(), right.getF32()))));
+                case CompactValue::Kind::Double: return set(target, CompactValue(static_cast<Types::f64>(operation(left.getF64(), right.getF64()))));
+                default: break;
+                }
+
+            set(target, narrow(compact(operation(left.toValue(), right.toValue())), kind));
+        }
+
+        /// @brief Evaluate a bitwise operation, directly on the operands if they're integers of the same kind.
+        template <typename OPERATION>
+        inline void integral(CompactValue& target, CompactValue left, CompactValue right, Types::Kind kind, OPERATION operation)
+        {
+            if(left.getKind() == right.getKind())
+                switch(left.getKind())
+                {
+                case CompactValue::Kind::Unsigned: return set(target, narrow(CompactValue(operation(left.getU64(), right.getU64())), kind));
+                case CompactValue::Kind::Signed: return set(target, narrow(CompactValue(operation(left.getI64(), right.getI64())), kind));
+                default: break;
+                }
+
+            set(target, narrow(compact(operation(left.toValue(), right.toValue())), kind));
+        }
+
+        /// @brief Evaluate a comparison, directly on the operands if they're scalars of the same kind.
+        template <typename OPERATION>
+        static inline Types::_bool compare(CompactValue left, CompactValue right, OPERATION operation)
+        {
+            if(left.getKind() == right.getKind())
+                switch(left.getKind())
+                {
+                case CompactValue::Kind::Boolean: return operation(left.getBool(), right.getBool());
+                case CompactValue::Kind::Character: return operation(left.getChar(), right.getChar());
+                case CompactValue::Kind::Unsigned: return operation(left.getU64(), right.getU64());
+                case CompactValue::Kind::Signed: return operation(left.getI64(), right.getI64());
+                case CompactValue::Kind::Float: return operation(left.getF32(), right.getF32());
+                case CompactValue::Kind::Double: return operation(left.getF64(), right.getF64());
+                default: break;
+                }
+
+            return static_cast<Types::_bool>(operation(left.toValue(), right.toValue()));
+        }
+
+        void divisionByZero(CompactValue& target, CompactValue left, CompactValue right, std::string_view operation)
+        {
+            Reporting::push(Reporting::Report{
+                .type = Reporting::Type::Error, .stage = Reporting::Stage::Generator,
+                .message = Logger::format("Attempted $ by zero. Operands are `$` and `$`.", operation, left.toValue(), right.toValue())
+            });
+            set(target, CompactValue::invalidValue());
+        }
+
+        CompactValue count(CompactValue operand)
+        {
+            if(!operand.isBoxed())
+                switch(operand.getKind())
+                {
+                case CompactValue::Kind::Character: return CompactValue(static_cast<Types::i64>(+operand.getChar()));
+                case CompactValue::Kind::Boolean: return CompactValue(static_cast<Types::i64>(operand.getBool()));
+                default: return operand;
+                }
+
+            const auto& value = *operand.getBox();
+
+            if(value.getKind() == Value::Kind::Array)
+                return CompactValue(value.getArray().getCount());
+            else if(value.getKind() == Value::Kind::Primitive && value.getPrimitive().getKind() == PrimitiveValue::Kind::String)
+                return CompactValue(static_cast<Types::u64>(value.getPrimitive().getStringReference().size()));
+            else return compact(value);
+        }
+
+        /// @return The element of a string or array at the given index, read in place unless it is not a scalar.
+        CompactValue element(const Value& container, Types::u64 index)
+        {
+            if(container.getKind() == Value::Kind::Primitive)
+                return CompactValue(container.getPrimitive().getStringReference().at(index));
+
+            return container.getArray().visit([&](const auto& elements)
+            {
+                using Element = typename std::remove_cvref_t<decltype(elements)>::value_type;
+
+                if constexpr(std::is_same_v<Element, Types::_bool> || std::is_same_v<Element, Types::_char>
+                || std::is_same_v<Element, Types::f32> || std::is_same_v<Element, Types::f64>)
+                    return CompactValue(elements.at(index));
+                else if constexpr(std::is_integral_v<Element> && std::is_unsigned_v<Element>)
+                    return CompactValue(static_cast<Types::u64>(elements.at(index)));
+                else if constexpr(std::is_integral_v<Element>)
+                    return CompactValue(static_cast<Types::i64>(elements.at(index)));
+                else return compact(container.getArray().get(index));
+            });
+        }
+
+        /// @brief Overwrite the element of a string or array at the given index, in place if both it and the value are scalars
+        /// of the same kind.
+        static void setIndex(Value& container, Types::u64 index, CompactValue value)
+        {
+            if(container.getKind() == Value::Kind::Primitive)
+            {
+                container.getPrimitive().getStringReference().at(index) = value.getChar();
+                return;
+            }
+
+            const bool written = container.getArray().visitMutable([&](auto& elements)
+            {
+                using Element = typename std::remove_cvref_t<decltype(elements)>::value_type;
+                const auto kind = value.getKind();
+
+                if constexpr(std::is_same_v<Element, Types::_bool>)
+                    return kind == CompactValue::Kind::Boolean && (elements.at(index) = value.getBool(), true);
+                else if constexpr(std::is_same_v<Element, Types::_char>)
+                    return kind == CompactValue::Kind::Character && (elements.at(index) = value.getChar(), true);
+                else if constexpr(std::is_same_v<Element, Types::f32>)
+                    return kind == CompactValue::Kind::Float && (elements.at(index) = value.getF32(), true);
+                else if constexpr(std::is_same_v<Element, Types::f64>)
+                    return kind == CompactValue::Kind::Double && (elements.at(index) = value.getF64(), true);
+                else if constexpr(std::is_integral_v<Element>)
+                    return (kind == CompactValue::Kind::Unsigned || kind == CompactValue::Kind::Signed)
+                        && (elements.at(index) = static_cast<Element>(value.getU64()), true);
+                else return false;
+            });
+
+            if(!written)
+                container.getArray().set(index, value.toValue());
+        }
+
+        BytecodeCompiler m_compiler;
+        std::vector<CompactValue> m_stack, m_globals, m_constants;
+
+        /// Boxes of the non-scalar values held by registers, globals and constants, each owned by a single one of them.
+        std::deque<Value> m_boxes;
+        std::vector<Value*> m_freeBoxes;
+    };
+}
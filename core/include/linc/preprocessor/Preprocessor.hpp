@@ -331,8 +331,8 @@ namespace linc
         mutable std::vector<Macro> m_macros;
         mutable TokenSize m_index{0ul};
         mutable bool m_matchFailed{false};
-        static std::unordered_set<std::string> s_guardedFiles;
+        static thread_local std::unordered_set<std::string> s_guardedFiles;
     };
 
-    std::unordered_set<std::string> Preprocessor::s_guardedFiles;
+    thread_local std::unordered_set<std::string> Preprocessor::s_guardedFiles;
 }
\ No newline at end of file
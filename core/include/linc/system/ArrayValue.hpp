@@ -1,6 +1,7 @@
 #pragma once
 #include <linc/system/Exception.hpp>
 #include <linc/system/PrimitiveValue.hpp>
+#include <linc/system/Shared.hpp>
 #include <linc/system/Types.hpp>
 #include <linc/Include.hpp>
 #include <cstring>
@@ -14,13 +15,12 @@
     ArrayValue(std::vector<Types::_type> array) \
         :m_kind(Types::Kind::_type) \
     { \
-        new (&m_array_##_type) std::vector{std::move(array)}; \
+        new (&m_array_##_type) Shared{std::move(array)}; \
     } \
     ArrayValue(Types::_type value, std::size_t count) \
         :m_kind(Types::Kind::_type) \
     { \
-        new (&m_array_##_type) std::vector{value}; \
-        m_array_##_type.resize(count, value); \
+        new (&m_array_##_type) Shared{std::vector<Types::_type>(count, value)}; \
     }
 
 #define LINC_ARRAY_VALUE_PUSH(_type, type_fn) \
@@ -28,7 +28,7 @@
     { \
         if(m_kind != Types::Kind::_type) \
             throw LINC_EXCEPTION_INVALID_INPUT("Cannot push value of incorrect type to array value."); \
-        m_array_##_type.push_back(std::move(value)); \
+        m_array_##_type.mutate().push_back(std::move(value)); \
     }
 namespace linc
 {
@@ -38,43 +38,37 @@ namespace linc
         ArrayValue(std::vector<Types::_invalid_type> array)
             :m_kind(Types::Kind::invalid)
         {
-            new (&m_array_invalid) std::vector{std::move(array)};
+            new (&m_array_invalid) Shared{std::move(array)};
         }
 
         ArrayValue(Types::_invalid_type value, std::size_t count)
             :m_kind(Types::Kind::invalid)
         {
-            new (&m_array_invalid) std::vector{value};
-            m_array_invalid.resize(count);
+            new (&m_array_invalid) Shared{std::vector<Types::_invalid_type>(count, value)};
         }
 
         ArrayValue(std::vector<Types::_void_type> array)
             :m_kind(Types::Kind::_void)
         {
-            new (&m_array__void) std::vector{std::move(array)};
+            new (&m_array__void) Shared{std::move(array)};
         }
 
         ArrayValue(Types::_void_type value, std::size_t count)
             :m_kind(Types::Kind::_void)
         {
-            new (&m_array__void) std::vector{value};
-            m_array__void.resize(count);
+            new (&m_array__void) Shared{std::vector<Types::_void_type>(count, value)};
         }
 
         ArrayValue(const ArrayValue& value, std::size_t count)
-            :m_isNested(true)
+            :m_kind(Types::Kind::invalid), m_isNested(true)
         {
-            new (&m_array_array) std::vector<ArrayValue>{};
-            m_array_array.resize(count, value);
+            new (&m_array_array) Shared{std::vector<ArrayValue>(count, value)};
         }
 
         ArrayValue(std::vector<ArrayValue> array)
-            :m_isNested(true)
+            :m_kind(Types::Kind::invalid), m_isNested(true)
         {
-            new (&m_array_array) std::vector<ArrayValue>{};
-            m_array_array.reserve(array.size());
-            for(const auto& element: array)
-                m_array_array.push_back(element);
+            new (&m_array_array) Shared{std::move(array)};
         }
 
         LINC_ARRAY_TYPE_FUNCTIONS(_bool, Bool)
@@ -98,7 +92,7 @@ namespace linc
         {
             if(m_kind != Types::Kind::_void)
                 throw LINC_EXCEPTION_INVALID_INPUT("Cannot push value of incorrect type to array value.");
-            m_array__void.push_back(std::move(value));
+            m_array__void.mutate().push_back(std::move(value));
         }
 
         void push(const class Value& value);
@@ -107,28 +101,28 @@ namespace linc
         {
             if(m_isNested)
             {
-                m_array_array.~vector();
+                m_array_array.~Shared();
                 return;
             }
 
             switch(m_kind)
             {
-            case Types::Kind::invalid: m_array_invalid.~vector(); break;
-            case Types::Kind::_void: m_array__void.~vector(); break;
-            case Types::Kind::_bool: m_array__bool.~vector(); break;
-            case Types::Kind::_char: m_array__char.~vector(); break;
-            case Types::Kind::u8: m_array_u8.~vector(); break;
-            case Types::Kind::u16: m_array_u16.~vector(); break;
-            case Types::Kind::u32: m_array_u32.~vector(); break;
-            case Types::Kind::u64: m_array_u64.~vector(); break;
-            case Types::Kind::i8: m_array_i8.~vector(); break;
-            case Types::Kind::i16: m_array_i16.~vector(); break;
-            case Types::Kind::i32: m_array_i32.~vector(); break;
-            case Types::Kind::i64: m_array_i64.~vector(); break;
-            case Types::Kind::f32: m_array_f32.~vector(); break;
-            case Types::Kind::f64: m_array_f64.~vector(); break;
-            case Types::Kind::string: m_array_string.~vector(); break;
-            case Types::Kind::type: m_array_type.~vector(); break;
+            case Types::Kind::invalid: m_array_invalid.~Shared(); break;
+            case Types::Kind::_void: m_array__void.~Shared(); break;
+            case Types::Kind::_bool: m_array__bool.~Shared(); break;
+            case Types::Kind::_char: m_array__char.~Shared(); break;
+            case Types::Kind::u8: m_array_u8.~Shared(); break;
+            case Types::Kind::u16: m_array_u16.~Shared(); break;
+            case Types::Kind::u32: m_array_u32.~Shared(); break;
+            case Types::Kind::u64: m_array_u64.~Shared(); break;
+            case Types::Kind::i8: m_array_i8.~Shared(); break;
+            case Types::Kind::i16: m_array_i16.~Shared(); break;
+            case Types::Kind::i32: m_array_i32.~Shared(); break;
+            case Types::Kind::i64: m_array_i64.~Shared(); break;
+            case Types::Kind::f32: m_array_f32.~Shared(); break;
+            case Types::Kind::f64: m_array_f64.~Shared(); break;
+            case Types::Kind::string: m_array_string.~Shared(); break;
+            case Types::Kind::type: m_array_type.~Shared(); break;
             }
         }
 
@@ -137,31 +131,27 @@ namespace linc
         {
             if(m_isNested)
             {
-                new (&m_array_array) std::vector<ArrayValue>{};
-                m_array_array.reserve(other.m_array_array.size());
-                
-                for(const auto& element: other.m_array_array)
-                    m_array_array.push_back(element);
+                new (&m_array_array) Shared{other.m_array_array};
                 return;
             }
 
             switch(m_kind)
             {
-            case Types::Kind::_void: new (&m_array__void) std::vector{other.m_array__void}; break;
-            case Types::Kind::_bool: new (&m_array__bool) std::vector{other.m_array__bool}; break;
-            case Types::Kind::_char: new (&m_array__char) std::vector{other.m_array__char}; break;
-            case Types::Kind::u8: new (&m_array_u8) std::vector{other.m_array_u8}; break;
-            case Types::Kind::u16: new (&m_array_u16) std::vector{other.m_array_u16}; break;
-            case Types::Kind::u32: new (&m_array_u32) std::vector{other.m_array_u32}; break;
-            case Types::Kind::u64: new (&m_array_u64) std::vector{other.m_array_u64}; break;
-            case Types::Kind::i8: new (&m_array_i8) std::vector{other.m_array_i8}; break;
-            case Types::Kind::i16: new (&m_array_i16) std::vector{other.m_array_i16}; break;
-            case Types::Kind::i32: new (&m_array_i32) std::vector{other.m_array_i32}; break;
-            case Types::Kind::i64: new (&m_array_i64) std::vector{other.m_array_i64}; break;
-            case Types::Kind::f32: new (&m_array_f32) std::vector{other.m_array_f32}; break;
-            case Types::Kind::f64: new (&m_array_f64) std::vector{other.m_array_f64}; break;
-            case Types::Kind::string: new (&m_array_string) std::vector{other.m_array_string}; break;
-            case Types::Kind::type: new (&m_array_type) std::vector{other.m_array_type}; break;
+            case Types::Kind::_void: new (&m_array__void) Shared{other.m_array__void}; break;
+            case Types::Kind::_bool: new (&m_array__bool) Shared{other.m_array__bool}; break;
+            case Types::Kind::_char: new (&m_array__char) Shared{other.m_array__char}; break;
+            case Types::Kind::u8: new (&m_array_u8) Shared{other.m_array_u8}; break;
+            case Types::Kind::u16: new (&m_array_u16) Shared{other.m_array_u16}; break;
+            case Types::Kind::u32: new (&m_array_u32) Shared{other.m_array_u32}; break;
+            case Types::Kind::u64: new (&m_array_u64) Shared{other.m_array_u64}; break;
+            case Types::Kind::i8: new (&m_array_i8) Shared{other.m_array_i8}; break;
+            case Types::Kind::i16: new (&m_array_i16) Shared{other.m_array_i16}; break;
+            case Types::Kind::i32: new (&m_array_i32) Shared{other.m_array_i32}; break;
+            case Types::Kind::i64: new (&m_array_i64) Shared{other.m_array_i64}; break;
+            case Types::Kind::f32: new (&m_array_f32) Shared{other.m_array_f32}; break;
+            case Types::Kind::f64: new (&m_array_f64) Shared{other.m_array_f64}; break;
+            case Types::Kind::string: new (&m_array_string) Shared{other.m_array_string}; break;
+            case Types::Kind::type: new (&m_array_type) Shared{other.m_array_type}; break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
         }
@@ -174,69 +164,63 @@ namespace linc
 
             if(m_isNested)
             {
-                new (&m_array_array) std::vector<ArrayValue>{};
-                m_array_array.reserve(other.m_array_array.size());
-                
-                for(const auto& element: other.m_array_array)
-                    m_array_array.push_back(std::move(element));
+                new (&m_array_array) Shared{std::move(other.m_array_array)};
                 return;
             }
 
             switch(m_kind)
             {
-            case Types::Kind::_void: new (&m_array__void) std::vector{std::move(other.m_array__void)}; break;
-            case Types::Kind::_bool: new (&m_array__bool) std::vector{std::move(other.m_array__bool)}; break;
-            case Types::Kind::_char: new (&m_array__char) std::vector{std::move(other.m_array__char)}; break;
-            case Types::Kind::u8: new (&m_array_u8) std::vector{std::move(other.m_array_u8)}; break;
-            case Types::Kind::u16: new (&m_array_u16) std::vector{std::move(other.m_array_u16)}; break;
-            case Types::Kind::u32: new (&m_array_u32) std::vector{std::move(other.m_array_u32)}; break;
-            case Types::Kind::u64: new (&m_array_u64) std::vector{std::move(other.m_array_u64)}; break;
-            case Types::Kind::i8: new (&m_array_i8) std::vector{std::move(other.m_array_i8)}; break;
-            case Types::Kind::i16: new (&m_array_i16) std::vector{std::move(other.m_array_i16)}; break;
-            case Types::Kind::i32: new (&m_array_i32) std::vector{std::move(other.m_array_i32)}; break;
-            case Types::Kind::i64: new (&m_array_i64) std::vector{std::move(other.m_array_i64)}; break;
-            case Types::Kind::f32: new (&m_array_f32) std::vector{std::move(other.m_array_f32)}; break;
-            case Types::Kind::f64: new (&m_array_f64) std::vector{std::move(other.m_array_f64)}; break;
-            case Types::Kind::string: new (&m_array_string) std::vector{std::move(other.m_array_string)}; break;
-            case Types::Kind::type: new (&m_array_type) std::vector{std::move(other.m_array_type)}; break;
+            case Types::Kind::_void: new (&m_array__void) Shared{std::move(other.m_array__void)}; break;
+            case Types::Kind::_bool: new (&m_array__bool) Shared{std::move(other.m_array__bool)}; break;
+            case Types::Kind::_char: new (&m_array__char) Shared{std::move(other.m_array__char)}; break;
+            case Types::Kind::u8: new (&m_array_u8) Shared{std::move(other.m_array_u8)}; break;
+            case Types::Kind::u16: new (&m_array_u16) Shared{std::move(other.m_array_u16)}; break;
+            case Types::Kind::u32: new (&m_array_u32) Shared{std::move(other.m_array_u32)}; break;
+            case Types::Kind::u64: new (&m_array_u64) Shared{std::move(other.m_array_u64)}; break;
+            case Types::Kind::i8: new (&m_array_i8) Shared{std::move(other.m_array_i8)}; break;
+            case Types::Kind::i16: new (&m_array_i16) Shared{std::move(other.m_array_i16)}; break;
+            case Types::Kind::i32: new (&m_array_i32) Shared{std::move(other.m_array_i32)}; break;
+            case Types::Kind::i64: new (&m_array_i64) Shared{std::move(other.m_array_i64)}; break;
+            case Types::Kind::f32: new (&m_array_f32) Shared{std::move(other.m_array_f32)}; break;
+            case Types::Kind::f64: new (&m_array_f64) Shared{std::move(other.m_array_f64)}; break;
+            case Types::Kind::string: new (&m_array_string) Shared{std::move(other.m_array_string)}; break;
+            case Types::Kind::type: new (&m_array_type) Shared{std::move(other.m_array_type)}; break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
-
-            other.m_array_invalid = {std::vector<Types::_invalid_type>{}};
         }
 
         ArrayValue& operator=(const ArrayValue& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~ArrayValue();
             m_kind = other.m_kind;
             m_isNested = other.m_isNested;
 
             if(m_isNested)
             {
-                new (&m_array_array) std::vector<ArrayValue>{};
-                m_array_array.reserve(other.m_array_array.size());
-                
-                for(const auto& element: other.m_array_array)
-                    m_array_array.push_back(element);
+                new (&m_array_array) Shared{other.m_array_array};
                 return *this;
             }
 
             switch(m_kind)
             {
-            case Types::Kind::_void: new (&m_array__void) std::vector{other.m_array__void}; break;
-            case Types::Kind::_bool: new (&m_array__bool) std::vector{other.m_array__bool}; break;
-            case Types::Kind::_char: new (&m_array__char) std::vector{other.m_array__char}; break;
-            case Types::Kind::u8: new (&m_array_u8) std::vector{other.m_array_u8}; break;
-            case Types::Kind::u16: new (&m_array_u16) std::vector{other.m_array_u16}; break;
-            case Types::Kind::u32: new (&m_array_u32) std::vector{other.m_array_u32}; break;
-            case Types::Kind::u64: new (&m_array_u64) std::vector{other.m_array_u64}; break;
-            case Types::Kind::i8: new (&m_array_i8) std::vector{other.m_array_i8}; break;
-            case Types::Kind::i16: new (&m_array_i16) std::vector{other.m_array_i16}; break;
-            case Types::Kind::i32: new (&m_array_i32) std::vector{other.m_array_i32}; break;
-            case Types::Kind::i64: new (&m_array_i64) std::vector{other.m_array_i64}; break;
-            case Types::Kind::f32: new (&m_array_f32) std::vector{other.m_array_f32}; break;
-            case Types::Kind::f64: new (&m_array_f64) std::vector{other.m_array_f64}; break;
-            case Types::Kind::string: new (&m_array_string) std::vector{other.m_array_string}; break;
-            case Types::Kind::type: new (&m_array_type) std::vector{other.m_array_type}; break;
+            case Types::Kind::_void: new (&m_array__void) Shared{other.m_array__void}; break;
+            case Types::Kind::_bool: new (&m_array__bool) Shared{other.m_array__bool}; break;
+            case Types::Kind::_char: new (&m_array__char) Shared{other.m_array__char}; break;
+            case Types::Kind::u8: new (&m_array_u8) Shared{other.m_array_u8}; break;
+            case Types::Kind::u16: new (&m_array_u16) Shared{other.m_array_u16}; break;
+            case Types::Kind::u32: new (&m_array_u32) Shared{other.m_array_u32}; break;
+            case Types::Kind::u64: new (&m_array_u64) Shared{other.m_array_u64}; break;
+            case Types::Kind::i8: new (&m_array_i8) Shared{other.m_array_i8}; break;
+            case Types::Kind::i16: new (&m_array_i16) Shared{other.m_array_i16}; break;
+            case Types::Kind::i32: new (&m_array_i32) Shared{other.m_array_i32}; break;
+            case Types::Kind::i64: new (&m_array_i64) Shared{other.m_array_i64}; break;
+            case Types::Kind::f32: new (&m_array_f32) Shared{other.m_array_f32}; break;
+            case Types::Kind::f64: new (&m_array_f64) Shared{other.m_array_f64}; break;
+            case Types::Kind::string: new (&m_array_string) Shared{other.m_array_string}; break;
+            case Types::Kind::type: new (&m_array_type) Shared{other.m_array_type}; break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
 
@@ -245,6 +229,10 @@ namespace linc
 
         ArrayValue& operator=(ArrayValue&& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~ArrayValue();
             m_kind = other.m_kind;
             m_isNested = other.m_isNested;
             other.m_kind = Types::Kind::invalid;
@@ -252,35 +240,30 @@ namespace linc
 
             if(m_isNested)
             {
-                new (&m_array_array) std::vector<ArrayValue>{};
-                m_array_array.reserve(other.m_array_array.size());
-                
-                for(const auto& element: other.m_array_array)
-                    m_array_array.push_back(std::move(element));
+                new (&m_array_array) Shared{std::move(other.m_array_array)};
                 return *this;
             }
 
             switch(m_kind)
             {
-            case Types::Kind::_void: new (&m_array__void) std::vector{std::move(other.m_array__void)}; break;
-            case Types::Kind::_bool: new (&m_array__bool) std::vector{std::move(other.m_array__bool)}; break;
-            case Types::Kind::_char: new (&m_array__char) std::vector{std::move(other.m_array__char)}; break;
-            case Types::Kind::u8: new (&m_array_u8) std::vector{std::move(other.m_array_u8)}; break;
-            case Types::Kind::u16: new (&m_array_u16) std::vector{std::move(other.m_array_u16)}; break;
-            case Types::Kind::u32: new (&m_array_u32) std::vector{std::move(other.m_array_u32)}; break;
-            case Types::Kind::u64: new (&m_array_u64) std::vector{std::move(other.m_array_u64)}; break;
-            case Types::Kind::i8: new (&m_array_i8) std::vector{std::move(other.m_array_i8)}; break;
-            case Types::Kind::i16: new (&m_array_i16) std::vector{std::move(other.m_array_i16)}; break;
-            case Types::Kind::i32: new (&m_array_i32) std::vector{std::move(other.m_array_i32)}; break;
-            case Types::Kind::i64: new (&m_array_i64) std::vector{std::move(other.m_array_i64)}; break;
-            case Types::Kind::f32: new (&m_array_f32) std::vector{std::move(other.m_array_f32)}; break;
-            case Types::Kind::f64: new (&m_array_f64) std::vector{std::move(other.m_array_f64)}; break;
-            case Types::Kind::string: new (&m_array_string) std::vector{std::move(other.m_array_string)}; break;
-            case Types::Kind::type: new (&m_array_type) std::vector{std::move(other.m_array_type)}; break;
+            case Types::Kind::_void: new (&m_array__void) Shared{std::move(other.m_array__void)}; break;
+            case Types::Kind::_bool: new (&m_array__bool) Shared{std::move(other.m_array__bool)}; break;
+            case Types::Kind::_char: new (&m_array__char) Shared{std::move(other.m_array__char)}; break;
+            case Types::Kind::u8: new (&m_array_u8) Shared{std::move(other.m_array_u8)}; break;
+            case Types::Kind::u16: new (&m_array_u16) Shared{std::move(other.m_array_u16)}; break;
+            case Types::Kind::u32: new (&m_array_u32) Shared{std::move(other.m_array_u32)}; break;
+            case Types::Kind::u64: new (&m_array_u64) Shared{std::move(other.m_array_u64)}; break;
+            case Types::Kind::i8: new (&m_array_i8) Shared{std::move(other.m_array_i8)}; break;
+            case Types::Kind::i16: new (&m_array_i16) Shared{std::move(other.m_array_i16)}; break;
+            case Types::Kind::i32: new (&m_array_i32) Shared{std::move(other.m_array_i32)}; break;
+            case Types::Kind::i64: new (&m_array_i64) Shared{std::move(other.m_array_i64)}; break;
+            case Types::Kind::f32: new (&m_array_f32) Shared{std::move(other.m_array_f32)}; break;
+            case Types::Kind::f64: new (&m_array_f64) Shared{std::move(other.m_array_f64)}; break;
+            case Types::Kind::string: new (&m_array_string) Shared{std::move(other.m_array_string)}; break;
+            case Types::Kind::type: new (&m_array_type) Shared{std::move(other.m_array_type)}; break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
 
-            other.m_array_invalid = {std::vector<Types::_invalid_type>{}};
             return *this;
         }
 
@@ -321,63 +304,141 @@ namespace linc
 
         Types::u64 getCount() const 
         {
+            if(m_isNested)
+                return m_array_array->size();
+
+            switch(m_kind)
+            {
+            case Types::Kind::_void: return m_array__void->size();
+            case Types::Kind::_bool: return m_array__bool->size();
+            case Types::Kind::_char: return m_array__char->size();
+            case Types::Kind::u8: return m_array_u8->size();
+            case Types::Kind::u16: return m_array_u16->size();
+            case Types::Kind::u32: return m_array_u32->size();
+            case Types::Kind::u64: return m_array_u64->size();
+            case Types::Kind::i8: return m_array_i8->size();
+            case Types::Kind::i16: return m_array_i16->size();
+            case Types::Kind::i32: return m_array_i32->size();
+            case Types::Kind::i64: return m_array_i64->size();
+            case Types::Kind::f32: return m_array_f32->size();
+            case Types::Kind::f64: return m_array_f64->size();
+            case Types::Kind::string: return m_array_string->size();
+            case Types::Kind::type: return m_array_type->size();
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
+            }
+        }
+
+        /// @brief Call a function with the vector holding the elements of the array, so that they can be read in place.
+        template <typename FUNCTION>
+        decltype(auto) visit(FUNCTION&& function) const
+        {
+            if(m_isNested)
+                return function(*m_array_array);
+
+            switch(m_kind)
+            {
+            case Types::Kind::_void: return function(*m_array__void);
+            case Types::Kind::_bool: return function(*m_array__bool);
+            case Types::Kind::_char: return function(*m_array__char);
+            case Types::Kind::u8: return function(*m_array_u8);
+            case Types::Kind::u16: return function(*m_array_u16);
+            case Types::Kind::u32: return function(*m_array_u32);
+            case Types::Kind::u64: return function(*m_array_u64);
+            case Types::Kind::i8: return function(*m_array_i8);
+            case Types::Kind::i16: return function(*m_array_i16);
+            case Types::Kind::i32: return function(*m_array_i32);
+            case Types::Kind::i64: return function(*m_array_i64);
+            case Types::Kind::f32: return function(*m_array_f32);
+            case Types::Kind::f64: return function(*m_array_f64);
+            case Types::Kind::string: return function(*m_array_string);
+            case Types::Kind::type: return function(*m_array_type);
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
+            }
+        }
+
+        /// @brief Call a function with the vector holding the elements of the array, copied first if it is shared, so that
+        /// they can be written in place.
+        template <typename FUNCTION>
+        decltype(auto) visitMutable(FUNCTION&& function)
+        {
+            if(m_isNested)
+                return function(m_array_array.mutate());
+
             switch(m_kind)
             {
-            case Types::Kind::_void: return m_array__void.size();
-            case Types::Kind::_bool: return m_array__bool.size();
-            case Types::Kind::_char: return m_array__char.size();
-            case Types::Kind::u8: return m_array_u8.size();
-            case Types::Kind::u16: return m_array_u16.size();
-            case Types::Kind::u32: return m_array_u32.size();
-            case Types::Kind::u64: return m_array_u64.size();
-            case Types::Kind::i8: return m_array_i8.size();
-            case Types::Kind::i16: return m_array_i16.size();
-            case Types::Kind::i32: return m_array_i32.size();
-            case Types::Kind::i64: return m_array_i64.size();
-            case Types::Kind::f32: return m_array_f32.size();
-            case Types::Kind::f64: return m_array_f64.size();
-            case Types::Kind::string: return m_array_string.size();
-            case Types::Kind::type: return m_array_type.size();
+            case Types::Kind::_void: return function(m_array__void.mutate());
+            case Types::Kind::_bool: return function(m_array__bool.mutate());
+            case Types::Kind::_char: return function(m_array__char.mutate());
+            case Types::Kind::u8: return function(m_array_u8.mutate());
+            case Types::Kind::u16: return function(m_array_u16.mutate());
+            case Types::Kind::u32: return function(m_array_u32.mutate());
+            case Types::Kind::u64: return function(m_array_u64.mutate());
+            case Types::Kind::i8: return function(m_array_i8.mutate());
+            case Types::Kind::i16: return function(m_array_i16.mutate());
+            case Types::Kind::i32: return function(m_array_i32.mutate());
+            case Types::Kind::i64: return function(m_array_i64.mutate());
+            case Types::Kind::f32: return function(m_array_f32.mutate());
+            case Types::Kind::f64: return function(m_array_f64.mutate());
+            case Types::Kind::string: return function(m_array_string.mutate());
+            case Types::Kind::type: return function(m_array_type.mutate());
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
         }
 
         class Value get(std::size_t index) const;
+
+        /// @brief Access an element of an array of arrays in place.
+        ArrayValue& getNested(std::size_t index)
+        {
+            if(!m_isNested)
+                throw LINC_EXCEPTION_INVALID_INPUT("Cannot access an element of a primitive array as an array.");
+
+            return m_array_array.mutate().at(index);
+        }
+
+        const ArrayValue& getNested(std::size_t index) const
+        {
+            if(!m_isNested)
+                throw LINC_EXCEPTION_INVALID_INPUT("Cannot access an element of a primitive array as an array.");
+
+            return m_array_array->at(index);
+        }
+
         void set(std::size_t index, const class Value& value);
 
         ArrayValue operator+(const ArrayValue& other) const
         {
             switch(m_kind)
             {
-            case Types::Kind::_void:{ auto result = m_array__void; result.insert(result.end(), other.m_array__void.begin(), other.m_array__void.end());
+            case Types::Kind::_void:{ auto result = *m_array__void; result.insert(result.end(), other.m_array__void->begin(), other.m_array__void->end());
                 return ArrayValue(result); }
-            case Types::Kind::_bool:{ auto result = m_array__bool; result.insert(result.end(), other.m_array__bool.begin(), other.m_array__bool.end());
+            case Types::Kind::_bool:{ auto result = *m_array__bool; result.insert(result.end(), other.m_array__bool->begin(), other.m_array__bool->end());
                 return ArrayValue(result); }
-            case Types::Kind::_char:{ auto result = m_array__char; result.insert(result.end(), other.m_array__char.begin(), other.m_array__char.end());
+            case Types::Kind::_char:{ auto result = *m_array__char; result.insert(result.end(), other.m_array__char->begin(), other.m_array__char->end());
                 return ArrayValue(result); }
-            case Types::Kind::u8:{ auto result = m_array_u8; result.insert(result.end(), other.m_array_u8.begin(), other.m_array_u8.end());
+            case Types::Kind::u8:{ auto result = *m_array_u8; result.insert(result.end(), other.m_array_u8->begin(), other.m_array_u8->end());
                 return ArrayValue(result); }
-            case Types::Kind::u16:{ auto result = m_array_u16; result.insert(result.end(), other.m_array_u16.begin(), other.m_array_u16.end());
+            case Types::Kind::u16:{ auto result = *m_array_u16; result.insert(result.end(), other.m_array_u16->begin(), other.m_array_u16->end());
                 return ArrayValue(result); }
-            case Types::Kind::u32:{ auto result = m_array_u32; result.insert(result.end(), other.m_array_u32.begin(), other.m_array_u32.end());
+            case Types::Kind::u32:{ auto result = *m_array_u32; result.insert(result.end(), other.m_array_u32->begin(), other.m_array_u32->end());
                 return ArrayValue(result); }
-            case Types::Kind::u64:{ auto result = m_array_u64; result.insert(result.end(), other.m_array_u64.begin(), other.m_array_u64.end());
+            case Types::Kind::u64:{ auto result = *m_array_u64; result.insert(result.end(), other.m_array_u64->begin(), other.m_array_u64->end());
                 return ArrayValue(result); }
-            case Types::Kind::i8:{ auto result = m_array_i8; result.insert(result.end(), other.m_array_i8.begin(), other.m_array_i8.end());
+            case Types::Kind::i8:{ auto result = *m_array_i8; result.insert(result.end(), other.m_array_i8->begin(), other.m_array_i8->end());
                 return ArrayValue(result); }
-            case Types::Kind::i16:{ auto result = m_array_i16; result.insert(result.end(), other.m_array_i16.begin(), other.m_array_i16.end());
+            case Types::Kind::i16:{ auto result = *m_array_i16; result.insert(result.end(), other.m_array_i16->begin(), other.m_array_i16->end());
                 return ArrayValue(result); }
-            case Types::Kind::i32:{ auto result = m_array_i32; result.insert(result.end(), other.m_array_i32.begin(), other.m_array_i32.end());
+            case Types::Kind::i32:{ auto result = *m_array_i32; result.insert(result.end(), other.m_array_i32->begin(), other.m_array_i32->end());
                 return ArrayValue(result); }
-            case Types::Kind::i64:{ auto result = m_array_i64; result.insert(result.end(), other.m_array_i64.begin(), other.m_array_i64.end());
+            case Types::Kind::i64:{ auto result = *m_array_i64; result.insert(result.end(), other.m_array_i64->begin(), other.m_array_i64->end());
                 return ArrayValue(result); }
-            case Types::Kind::f32:{ auto result = m_array_f32; result.insert(result.end(), other.m_array_f32.begin(), other.m_array_f32.end());
+            case Types::Kind::f32:{ auto result = *m_array_f32; result.insert(result.end(), other.m_array_f32->begin(), other.m_array_f32->end());
                 return ArrayValue(result); }
-            case Types::Kind::f64:{ auto result = m_array_f64; result.insert(result.end(), other.m_array_f64.begin(), other.m_array_f64.end());
+            case Types::Kind::f64:{ auto result = *m_array_f64; result.insert(result.end(), other.m_array_f64->begin(), other.m_array_f64->end());
                 return ArrayValue(result); }
-            case Types::Kind::string:{ auto result = m_array_string; result.insert(result.end(), other.m_array_string.begin(), other.m_array_string.end());
+            case Types::Kind::string:{ auto result = *m_array_string; result.insert(result.end(), other.m_array_string->begin(), other.m_array_string->end());
                 return ArrayValue(result); }
-            case Types::Kind::type:{ auto result = m_array_type; result.insert(result.end(), other.m_array_type.begin(), other.m_array_type.end());
+            case Types::Kind::type:{ auto result = *m_array_type; result.insert(result.end(), other.m_array_type->begin(), other.m_array_type->end());
                 return ArrayValue(result); }
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
@@ -385,26 +446,28 @@ namespace linc
 
         bool operator==(const ArrayValue& other) const
         {
-            if(m_kind != other.m_kind)
+            if(m_kind != other.m_kind || m_isNested != other.m_isNested)
                 return false;
+            else if(m_isNested)
+                return *m_array_array == *other.m_array_array;
 
             switch(m_kind)
             {
-            case Types::Kind::_void: return m_array__void.size() == other.m_array__void.size();
-            case Types::Kind::_bool: return m_array__bool == other.m_array__bool;
-            case Types::Kind::_char: return m_array__char == other.m_array__char;
-            case Types::Kind::u8: return m_array_u8 == other.m_array_u8;
-            case Types::Kind::u16: return m_array_u16 == other.m_array_u16;
-            case Types::Kind::u32: return m_array_u32 == other.m_array_u32;
-            case Types::Kind::u64: return m_array_u64 == other.m_array_u64;
-            case Types::Kind::i8: return m_array_i8 == other.m_array_i8;
-            case Types::Kind::i16: return m_array_i16 == other.m_array_i16;
-            case Types::Kind::i32: return m_array_i32 == other.m_array_i32;
-            case Types::Kind::i64: return m_array_i64 == other.m_array_i64;
-            case Types::Kind::f32: return m_array_f32 == other.m_array_f32;
-            case Types::Kind::f64: return m_array_f64 == other.m_array_f64;
-            case Types::Kind::string: return m_array_string == other.m_array_string;
-            case Types::Kind::type: return m_array_type == other.m_array_type;
+            case Types::Kind::_void: return m_array__void->size() == other.m_array__void->size();
+            case Types::Kind::_bool: return *m_array__bool == *other.m_array__bool;
+            case Types::Kind::_char: return *m_array__char == *other.m_array__char;
+            case Types::Kind::u8: return *m_array_u8 == *other.m_array_u8;
+            case Types::Kind::u16: return *m_array_u16 == *other.m_array_u16;
+            case Types::Kind::u32: return *m_array_u32 == *other.m_array_u32;
+            case Types::Kind::u64: return *m_array_u64 == *other.m_array_u64;
+            case Types::Kind::i8: return *m_array_i8 == *other.m_array_i8;
+            case Types::Kind::i16: return *m_array_i16 == *other.m_array_i16;
+            case Types::Kind::i32: return *m_array_i32 == *other.m_array_i32;
+            case Types::Kind::i64: return *m_array_i64 == *other.m_array_i64;
+            case Types::Kind::f32: return *m_array_f32 == *other.m_array_f32;
+            case Types::Kind::f64: return *m_array_f64 == *other.m_array_f64;
+            case Types::Kind::string: return *m_array_string == *other.m_array_string;
+            case Types::Kind::type: return *m_array_type == *other.m_array_type;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
         }
@@ -420,21 +483,21 @@ namespace linc
 
             switch(m_kind)
             {
-            case Types::Kind::_void: for(std::size_t i{0ul}; i < m_array__void.size(); ++i) result.push_back(PrimitiveValue::voidValue); break;
-            case Types::Kind::_bool: for(const auto& value: m_array__bool) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::_char: for(const auto& value: m_array__char) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::u8: for(const auto& value: m_array_u8) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::u16: for(const auto& value: m_array_u16) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::u32: for(const auto& value: m_array_u32) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::u64: for(const auto& value: m_array_u64) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::i8: for(const auto& value: m_array_i8) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::i16: for(const auto& value: m_array_i16) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::i32: for(const auto& value: m_array_i32) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::i64: for(const auto& value: m_array_i64) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::f32: for(const auto& value: m_array_f32) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::f64: for(const auto& value: m_array_f64) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::string: for(const auto& value: m_array_string) result.push_back(PrimitiveValue(value)); break;
-            case Types::Kind::type: for(const auto& value: m_array_type) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::_void: for(std::size_t i{0ul}; i < m_array__void->size(); ++i) result.push_back(PrimitiveValue::voidValue); break;
+            case Types::Kind::_bool: for(const auto& value: *m_array__bool) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::_char: for(const auto& value: *m_array__char) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::u8: for(const auto& value: *m_array_u8) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::u16: for(const auto& value: *m_array_u16) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::u32: for(const auto& value: *m_array_u32) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::u64: for(const auto& value: *m_array_u64) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::i8: for(const auto& value: *m_array_i8) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::i16: for(const auto& value: *m_array_i16) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::i32: for(const auto& value: *m_array_i32) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::i64: for(const auto& value: *m_array_i64) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::f32: for(const auto& value: *m_array_f32) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::f64: for(const auto& value: *m_array_f64) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::string: for(const auto& value: *m_array_string) result.push_back(PrimitiveValue(value)); break;
+            case Types::Kind::type: for(const auto& value: *m_array_type) result.push_back(PrimitiveValue(value)); break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
 
@@ -452,8 +515,8 @@ namespace linc
                     result.append((i == 0ul? "": ", ") + list[i].toApplicationString());
             }
 
-            else for(std::size_t i{0ul}; i < m_array_array.size(); ++i)
-                result.append((i == 0ul? "": ", ") + m_array_array[i].toApplicationString());
+            else for(std::size_t i{0ul}; i < m_array_array->size(); ++i)
+                result.append((i == 0ul? "": ", ") + (*m_array_array)[i].toApplicationString());
 
             result.push_back(']');
             return result;            
@@ -480,11 +543,11 @@ namespace linc
                     }
                 }
             }
-            else for(std::size_t i = 0ul; i < m_array_array.size(); ++i)
+            else for(std::size_t i = 0ul; i < m_array_array->size(); ++i)
             {
-                result.append(m_array_array[i].toString());
+                result.append((*m_array_array)[i].toString());
 
-                if(i != m_array_array.size() - 1ul)
+                if(i != m_array_array->size() - 1ul)
                 {
                     result.append(Colors::push(Colors::Color::Purple));
                     result.append(", ");
@@ -499,23 +562,23 @@ namespace linc
     private:
         union
         {
-            std::vector<Types::_invalid_type> m_array_invalid;
-            std::vector<Types::_void_type> m_array__void;
-            std::vector<Types::_bool> m_array__bool;
-            std::vector<Types::_char> m_array__char;
-            std::vector<Types::u8> m_array_u8;
-            std::vector<Types::u16> m_array_u16;
-            std::vector<Types::u32> m_array_u32;
-            std::vector<Types::u64> m_array_u64;
-            std::vector<Types::i8> m_array_i8;
-            std::vector<Types::i16> m_array_i16;
-            std::vector<Types::i32> m_array_i32;
-            std::vector<Types::i64> m_array_i64;
-            std::vector<Types::f32> m_array_f32;
-            std::vector<Types::f64> m_array_f64;
-            std::vector<Types::string> m_array_string;
-            std::vector<Types::type> m_array_type;
-            std::vector<ArrayValue> m_array_array;
+            Shared<std::vector<Types::_invalid_type>> m_array_invalid;
+            Shared<std::vector<Types::_void_type>> m_array__void;
+            Shared<std::vector<Types::_bool>> m_array__bool;
+            Shared<std::vector<Types::_char>> m_array__char;
+            Shared<std::vector<Types::u8>> m_array_u8;
+            Shared<std::vector<Types::u16>> m_array_u16;
+            Shared<std::vector<Types::u32>> m_array_u32;
+            Shared<std::vector<Types::u64>> m_array_u64;
+            Shared<std::vector<Types::i8>> m_array_i8;
+            Shared<std::vector<Types::i16>> m_array_i16;
+            Shared<std::vector<Types::i32>> m_array_i32;
+            Shared<std::vector<Types::i64>> m_array_i64;
+            Shared<std::vector<Types::f32>> m_array_f32;
+            Shared<std::vector<Types::f64>> m_array_f64;
+            Shared<std::vector<Types::string>> m_array_string;
+            Shared<std::vector<Types::type>> m_array_type;
+            Shared<std::vector<ArrayValue>> m_array_array;
         };
 
         Types::Kind m_kind;
@@ -33,6 +33,6 @@ namespace linc
         /// @return The enumerator corresponding to the current color.
         [[nodiscard]] inline static Color getCurrentColor() { return s_colorStack.empty()? Color::Default: s_colorStack.top(); }
     private:
-        static std::stack<Color> s_colorStack;
+        static thread_local std::stack<Color> s_colorStack;
     };
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+#include <linc/system/Value.hpp>
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief Trivially copyable 16-byte runtime value: scalars are held inline, while strings, arrays, structures and
+    /// enumerators are boxed Values it points to. The owner of the boxes (e.g. the virtual machine) is responsible for their
+    /// lifetime, so copying a compact value never allocates nor releases anything.
+    class CompactValue final
+    {
+    public:
+        enum class Kind: Types::u8
+        {
+            Invalid, Void, Boolean, Character, Unsigned, Signed, Float, Double, Boxed
+        };
+
+        constexpr CompactValue()
+            :m_unsigned{}, m_kind(Kind::Void)
+        {}
+
+        constexpr CompactValue(Types::_bool value)
+            :m_bool(value), m_kind(Kind::Boolean)
+        {}
+
+        constexpr CompactValue(Types::_char value)
+            :m_char(value), m_kind(Kind::Character)
+        {}
+
+        constexpr CompactValue(Types::u64 value)
+            :m_unsigned(value), m_kind(Kind::Unsigned)
+        {}
+
+        constexpr CompactValue(Types::i64 value)
+            :m_signed(value), m_kind(Kind::Signed)
+        {}
+
+        constexpr CompactValue(Types::f32 value)
+            :m_float(value), m_kind(Kind::Float)
+        {}
+
+        constexpr CompactValue(Types::f64 value)
+            :m_double(value), m_kind(Kind::Double)
+        {}
+
+        explicit constexpr CompactValue(Value* box)
+            :m_box(box), m_kind(Kind::Boxed)
+        {}
+
+        /// @return The compact representation of a value if it is a scalar, std::nullopt if it needs to be boxed.
+        static std::optional<CompactValue> fromScalar(const Value& value)
+        {
+            if(value.getKind() != Value::Kind::Primitive)
+                return std::nullopt;
+
+            const auto& primitive = value.getPrimitive();
+            switch(primitive.getKind())
+            {
+            case PrimitiveValue::Kind::Invalid: return invalidValue();
+            case PrimitiveValue::Kind::Void: return CompactValue{};
+            case PrimitiveValue::Kind::Boolean: return CompactValue(primitive.getBool());
+            case PrimitiveValue::Kind::Character: return CompactValue(primitive.getChar());
+            case PrimitiveValue::Kind::Unsigned: return CompactValue(primitive.getU64());
+            case PrimitiveValue::Kind::Signed: return CompactValue(primitive.getI64());
+            case PrimitiveValue::Kind::Float: return CompactValue(primitive.getF32());
+            case PrimitiveValue::Kind::Double: return CompactValue(primitive.getF64());
+            default: return std::nullopt;
+            }
+        }
+
+        static constexpr CompactValue invalidValue()
+        {
+            CompactValue value;
+            value.m_kind = Kind::Invalid;
+            return value;
+        }
+
+        Value toValue() const
+        {
+            switch(m_kind)
+            {
+            case Kind::Invalid: return PrimitiveValue::invalidValue;
+            case Kind::Void: return PrimitiveValue::voidValue;
+            case Kind::Boolean: return PrimitiveValue(m_bool);
+            case Kind::Character: return PrimitiveValue(m_char);
+            case Kind::Unsigned: return PrimitiveValue(m_unsigned);
+            case Kind::Signed: return PrimitiveValue(m_signed);
+            case Kind::Float: return PrimitiveValue(m_float);
+            case Kind::Double: return PrimitiveValue(m_double);
+            case Kind::Boxed: return *m_box;
+            default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
+            }
+        }
+
+        [[nodiscard]] inline Kind getKind() const { return m_kind; }
+        [[nodiscard]] inline bool isBoxed() const { return m_kind == Kind::Boxed; }
+        [[nodiscard]] inline Value* getBox() const { return m_box; }
+
+        [[nodiscard]] inline Types::_bool getBool() const { return m_kind == Kind::Boxed? m_box->getPrimitive().getBool(): m_bool; }
+        [[nodiscard]] inline Types::_char getChar() const { return m_kind == Kind::Boxed? m_box->getPrimitive().getChar(): m_char; }
+        [[nodiscard]] inline Types::u64 getU64() const { return m_kind == Kind::Boxed? m_box->getPrimitive().getU64(): m_unsigned; }
+        [[nodiscard]] inline Types::i64 getI64() const { return m_kind == Kind::Boxed? m_box->getPrimitive().getI64(): m_signed; }
+        [[nodiscard]] inline Types::f32 getF32() const { return m_float; }
+        [[nodiscard]] inline Types::f64 getF64() const { return m_double; }
+
+        /// @brief The same test as PrimitiveValue::isZero(), used to detect division by zero.
+        [[nodiscard]] bool isZero() const
+        {
+            switch(m_kind)
+            {
+            case Kind::Unsigned: return m_unsigned == 0ul;
+            case Kind::Signed: return m_signed == 0l;
+            case Kind::Float: return m_float == 0;
+            case Kind::Double: return m_double == 0;
+            case Kind::Character: return m_char == 0;
+            case Kind::Boolean: return !m_bool;
+            case Kind::Void: return true;
+            case Kind::Boxed: return m_box->getKind() == Value::Kind::Primitive && m_box->getPrimitive().isZero();
+            default: return false;
+            }
+        }
+    private:
+        union
+        {
+            Types::_bool m_bool;
+            Types::_char m_char;
+            Types::u64 m_unsigned;
+            Types::i64 m_signed;
+            Types::f32 m_float;
+            Types::f64 m_double;
+            Value* m_box;
+        };
+        Kind m_kind;
+    };
+
+    static_assert(sizeof(CompactValue) <= 16ul && std::is_trivially_copyable_v<CompactValue>);
+}
@@ -33,6 +33,6 @@ namespace linc
         /// @param contents The new contents of the file.
         static void write(const std::string& filepath_string, const std::string& contents);
     private:
-        static std::unordered_map<std::filesystem::path, std::fstream*> s_fileMap;
+        static thread_local std::unordered_map<std::filesystem::path, std::fstream*> s_fileMap;
     };
 }
\ No newline at end of file
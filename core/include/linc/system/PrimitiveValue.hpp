@@ -1,6 +1,7 @@
 #pragma once
 #include <linc/system/Types.hpp>
 #include <linc/system/Colors.hpp>
+#include <linc/system/Shared.hpp>
 #include <linc/Include.hpp>
 #include <cmath>
 
@@ -36,7 +37,7 @@
         case Kind::Signed: return m_value_signed op other.m_value_signed; \
         case Kind::Float: return m_value_float op other.m_value_float; \
         case Kind::Double: return m_value_double op other.m_value_double; \
-        case Kind::String: return m_value_string op other.m_value_string; \
+        case Kind::String: return *m_value_string op *other.m_value_string; \
         case Kind::Type: return m_value_type op other.m_value_type; \
         case Kind::Void: return m_value_void op other.m_value_void; \
         default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind); \
@@ -108,7 +109,7 @@ return_type operator op() const_keyword \
     case Kind::Signed: m_value_signed = other.m_value_signed; break; \
     case Kind::Float: m_value_float = other.m_value_float; break; \
     case Kind::Double: m_value_double = other.m_value_double; break; \
-    case Kind::String: new (&m_value_string) Types::string{other.m_value_string}; break; \
+    case Kind::String: new (&m_value_string) Shared<Types::string>{other.m_value_string}; break; \
     case Kind::Type: new (&m_value_type) Types::type{other.m_value_type}; break; \
     default: m_value_invalid = other.m_value_invalid; \
     }
@@ -123,7 +124,7 @@ return_type operator op() const_keyword \
     case Kind::Signed: m_value_signed = other.m_value_signed; break; \
     case Kind::Float: m_value_float = other.m_value_float; break; \
     case Kind::Double: m_value_double = other.m_value_double; break; \
-    case Kind::String: new (&m_value_string) Types::string{std::move(other.m_value_string)}; break; \
+    case Kind::String: new (&m_value_string) Shared<Types::string>{std::move(other.m_value_string)}; break; \
     case Kind::Type: new (&m_value_type) Types::type{std::move(other.m_value_type)}; break; \
     default: m_value_invalid = other.m_value_invalid; \
     }
@@ -189,7 +190,7 @@ namespace linc
         PrimitiveValue(const Types::string& value)
             :m_kind(Kind::String)
         {
-            new (&m_value_string) std::string{value};
+            new (&m_value_string) Shared<Types::string>{value};
         }
 
         PrimitiveValue(const Types::type& value)
@@ -201,7 +202,7 @@ namespace linc
         ~PrimitiveValue()
         {
             if(m_kind == Kind::String)
-                m_value_string.~basic_string();
+                m_value_string.~Shared();
             else if(m_kind == Kind::Type)
                 m_value_type.~type();
         }
@@ -248,6 +249,10 @@ namespace linc
 
         PrimitiveValue& operator=(const PrimitiveValue& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~PrimitiveValue();
             m_kind = other.m_kind;
 
             LINC_PRIMITIVE_VALUE_COPY_SWITCH
@@ -257,6 +262,10 @@ namespace linc
 
         PrimitiveValue& operator=(PrimitiveValue&& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~PrimitiveValue();
             m_kind = other.m_kind;
             other.m_kind = Kind::Invalid; 
 
@@ -311,9 +320,26 @@ namespace linc
         LINC_PRIMITIVE_VALUE_GETTERS(i32, I32, Signed, signed)
         LINC_PRIMITIVE_VALUE_GETTERS(i64, I64, Signed, signed)
 
-        LINC_PRIMITIVE_VALUE_GETTERS(string, String, String, string)
         LINC_PRIMITIVE_VALUE_GETTERS(type, Type, Type, type)
 
+        std::optional<Types::string> getIfString() const
+        {
+            if(m_kind == Kind::String)
+                return *m_value_string;
+            else return std::nullopt;
+        }
+
+        Types::string getString() const
+        {
+            return *m_value_string;
+        }
+
+        /// @brief Access the held string without copying it.
+        inline const Types::string& getStringReference() const { return *m_value_string; }
+
+        /// @brief Access the held string mutably, copying it first only if it is shared with another value.
+        inline Types::string& getStringReference() { return m_value_string.mutate(); }
+
         LINC_PRIMITIVE_VALUE_OPERATOR_GENERIC(==)
         LINC_PRIMITIVE_VALUE_OPERATOR_GENERIC(!=)
         LINC_PRIMITIVE_VALUE_OPERATOR_NUMERIC(-, PrimitiveValue)
@@ -339,7 +365,7 @@ namespace linc
             case Kind::Signed: return m_value_signed + other.m_value_signed;
             case Kind::Float: return m_value_float + other.m_value_float;
             case Kind::Double: return m_value_double + other.m_value_double;
-            case Kind::String: return m_value_string + other.m_value_string;
+            case Kind::String: return *m_value_string + *other.m_value_string;
             default: throw LINC_EXCEPTION_ILLEGAL_VALUE(m_kind);
             }
         }
@@ -371,7 +397,7 @@ namespace linc
             case Kind::Signed: return m_value_signed;
             case Kind::Float: return m_value_float;
             case Kind::Double: return m_value_double;
-            case Kind::String: return m_value_string;
+            case Kind::String: return *m_value_string;
             case Kind::Type: return m_value_type;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
@@ -485,7 +511,7 @@ namespace linc
             case Kind::Signed: return std::to_string(m_value_signed);
             case Kind::Float: return std::to_string(m_value_float);
             case Kind::Double: return std::to_string(m_value_double);
-            case Kind::String: return m_value_string;
+            case Kind::String: return *m_value_string;
             case Kind::Type: return m_value_type.toString();
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
@@ -503,7 +529,7 @@ namespace linc
             case Kind::Signed: result.append(std::to_string(m_value_signed)); break;
             case Kind::Float: result.append(std::to_string(m_value_float)); break;
             case Kind::Double: result.append(std::to_string(m_value_double)); break;
-            case Kind::String: result.append("\"" + printableString(m_value_string) + "\""); break;
+            case Kind::String: result.append("\"" + printableString(*m_value_string) + "\""); break;
             case Kind::Character: result.append("'" + printableChar<'\''>(m_value_char) + "'"); break;
             case Kind::Type: result.append(m_value_type.toString()); break;
             default: result.append("<invalid_value>");
@@ -556,7 +582,7 @@ namespace linc
             Types::i64 m_value_signed;
             Types::f32 m_value_float;
             Types::f64 m_value_double;
-            Types::string m_value_string;
+            Shared<Types::string> m_value_string;
             Types::type m_value_type;
         };
 
@@ -34,14 +34,26 @@ namespace linc
         inline static void setSource(Code::Source source_code) { s_source = source_code; }
         inline static void setSpansEnabled(bool option) { s_spansEnabled = option; }
 
+        /// @brief While silenced, reports are recorded without being logged, e.g. for code evaluated speculatively, whose
+        /// reports are then discarded.
+        inline static void setSilenced(bool option) { s_silenced = option; }
+        [[nodiscard]] inline static bool isSilenced() { return s_silenced; }
+
+        /// @brief Discard the reports pushed after the first `count` ones.
+        static void discardReports(ReportSize count);
+
         static void push(const Report& report, bool log = true);
         static void clearReports();
         static bool hasError();
         static bool hasWarning();
     private:
         static std::string stageToString(Stage stage);
-        static Code::Source s_source;
-        static ReportList s_reports;
+
+        /// @brief The reports and the source code they refer to are kept per thread, so that concurrent compilations do not
+        /// report to each other.
+        static thread_local Code::Source s_source;
+        static thread_local ReportList s_reports;
+        static thread_local bool s_silenced;
         static bool s_spansEnabled;
     };
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include <linc/Include.hpp>
+
+namespace linc
+{
+    /// @brief Reference-counted copy-on-write storage. Copies share the held object, which is only cloned when it is
+    /// accessed mutably while shared, so that copying is constant-time while keeping value semantics.
+    template <typename T>
+    class Shared final
+    {
+    public:
+        Shared(T value)
+            :m_pointer(std::make_shared<T>(std::move(value)))
+        {}
+
+        [[nodiscard]] inline const T& operator*() const { return *m_pointer; }
+        [[nodiscard]] inline const T* operator->() const { return m_pointer.get(); }
+
+        /// @brief Access the held object mutably, first cloning it if it is shared with other copies.
+        [[nodiscard]] inline T& mutate()
+        {
+            if(m_pointer.use_count() != 1l)
+                m_pointer = std::make_shared<T>(*m_pointer);
+
+            return *m_pointer;
+        }
+
+        [[nodiscard]] inline bool isShared() const { return m_pointer.use_count() > 1l; }
+    private:
+        std::shared_ptr<T> m_pointer;
+    };
+}
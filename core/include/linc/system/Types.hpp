@@ -26,6 +26,9 @@ namespace linc
             Zero = 0, Byte = 1, Word = 2, DoubleWord = 4, QuadWord = 8
         };
 
+        /// @brief A type node. Nested types (array elements, structure members, function signatures) are canonical
+        /// nodes owned by the type interner, so that copying a type never clones its subtypes and comparing subtypes is a
+        /// pointer comparison.
         class type final
         {
         public:
@@ -35,19 +38,19 @@ namespace linc
             };
 
             using Primitive = Types::Kind;
-            using Structure = std::vector<std::pair<std::string, std::unique_ptr<const type>>>;
+            using Structure = std::vector<std::pair<std::string, const type*>>;
             using Enumeration = std::vector<std::pair<std::string, Types::type>>;
 
             struct Array final
             {
-                std::unique_ptr<const type> baseType;
+                const type* baseType;
                 std::optional<std::size_t> count;
             };
 
             struct Function final
             {
-                std::unique_ptr<const type> returnType;
-                std::vector<std::unique_ptr<const type>> argumentTypes;
+                const type* returnType;
+                std::vector<const type*> argumentTypes;
             };
 
             type(Primitive primitive, bool is_mutable = false)
@@ -57,130 +60,72 @@ namespace linc
             type(const Structure& _structure, bool is_mutable = false)
                 :kind(Kind::Structure), isMutable(is_mutable)
             {
-                new (&structure) std::vector{cloneStructure(&_structure, is_mutable)};
+                new (&structure) Structure{withMutableMembers(_structure, is_mutable)};
             }
 
             type(const Enumeration& _enumeration, bool is_mutable = false)
                 :kind(Kind::Enumeration), isMutable(is_mutable)
             {
-                new (&enumeration) std::vector{_enumeration};
+                new (&enumeration) Enumeration{_enumeration};
             }
 
             type(const Array& _array, bool is_mutable = false)
                 :kind(Kind::Array), isMutable(is_mutable)
             {
-                new (&array) Array{.baseType = _array.baseType? _array.baseType->clone(): nullptr, .count = _array.count};
+                new (&array) Array{_array};
             }
 
             type(const Function& _function, bool is_mutable = false)
                 :kind(Kind::Function), isMutable(is_mutable)
             {
-                new (&function) Function{cloneFunction(&_function)};
+                new (&function) Function{_function};
             }
 
             ~type()
             {
-                switch(kind)
-                {
-                case Kind::Array: array.~Array(); break;
-                case Kind::Structure: structure.~vector(); break;
-                case Kind::Function: function.~Function(); break;
-                case Kind::Enumeration: enumeration.~vector(); break;
-                default: break;
-                }
+                destroy();
             }
 
             type(const type& other)
                 :kind(other.kind), isMutable(other.isMutable)
             {
-                switch(kind)
-                {
-                case Kind::Primitive: primitive = other.primitive; break;
-                case Kind::Array: new (&array) Array{.baseType = other.array.baseType->clone(), .count = other.array.count}; break;
-                case Kind::Structure: new (&structure) std::vector{cloneStructure(&other.structure, other.isMutable)}; break;
-                case Kind::Function: new (&function) Function{cloneFunction(&other.function)}; break;
-                case Kind::Enumeration: new (&enumeration) Enumeration{other.enumeration}; break;
-                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
-                }
+                construct(other);
             }
 
             type(type&& other)
                 :kind(other.kind), isMutable(other.isMutable)
             {
-                switch(kind)
-                {
-                case Kind::Primitive: primitive = other.primitive; break;
-                case Kind::Array: new (&array) Array{std::move(other.array)}; break;
-                case Kind::Structure: new (&structure) std::vector{std::move(other.structure)}; break;
-                case Kind::Function: new (&function) Function{std::move(other.function)}; break;
-                case Kind::Enumeration: new (&enumeration) Enumeration{std::move(other.enumeration)}; break;
-                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
-                }
+                construct(std::move(other));
             }
 
             type& operator=(const type& other)
             {
+                if(this == &other)
+                    return *this;
+
+                destroy();
                 kind = other.kind;
                 isMutable = other.isMutable;
-
-                switch(kind)
-                {
-                case Kind::Primitive: primitive = other.primitive; break;
-                case Kind::Array: new (&array) Array{.baseType = other.array.baseType->clone(), .count = other.array.count}; break;
-                case Kind::Structure: new (&structure) std::vector{cloneStructure(&other.structure, other.isMutable)}; break;
-                case Kind::Function: new (&function) Function{cloneFunction(&other.function)}; break;
-                case Kind::Enumeration: new (&enumeration) Enumeration{other.enumeration}; break;
-                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
-                }
+                construct(other);
                 return *this;
             }
 
             type& operator=(type&& other)
             {
+                if(this == &other)
+                    return *this;
+
+                destroy();
                 kind = other.kind;
                 isMutable = other.isMutable;
-
-                switch(kind)
-                {
-                case Kind::Primitive: primitive = other.primitive; break;
-                case Kind::Array: new (&array) Array{std::move(other.array)}; break;
-                case Kind::Structure: new (&structure) std::vector{std::move(other.structure)}; break;
-                case Kind::Function: new (&function) Function{std::move(other.function)}; break;
-                case Kind::Enumeration: new (&enumeration) Enumeration{std::move(other.enumeration)}; break;
-                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
-                }
+                construct(std::move(other));
                 return *this;
             }
 
             std::string toString(bool ignore_mutability = false) const;
 
-            std::unique_ptr<const type> clone() const
-            {
-                switch(kind)
-                {
-                case Kind::Primitive: return std::make_unique<const type>(primitive, isMutable);
-                case Kind::Array: return std::make_unique<const type>(Array{.baseType = array.baseType->clone(), .count = array.count}, isMutable);
-                case Kind::Structure:
-                {
-                    Structure structure_vector;
-                    for(const auto& member: structure)
-                        structure_vector.push_back(std::pair(member.first, member.second->clone()));
-                 
-                    return std::make_unique<const type>(std::move(structure_vector), isMutable);
-                }
-                case Kind::Function:
-                {
-                    std::vector<std::unique_ptr<const type>> argument_types;
-                    for(const auto& argument_type: function.argumentTypes)
-                        argument_types.push_back(argument_type->clone());
-                    
-                    return std::make_unique<const type>(Function{.returnType = function.returnType->clone(), .argumentTypes = std::move(argument_types)},
-                        isMutable);
-                }
-                case Kind::Enumeration: return std::make_unique<const type>(enumeration, isMutable);
-                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
-                }
-            }
+            /// @return The canonical node structurally identical to this type, valid for the lifetime of the process.
+            const type* intern() const;
 
             bool operator==(const type& other) const
             {
@@ -190,24 +135,24 @@ namespace linc
                 switch(kind)
                 {
                 case Kind::Primitive: return primitive == other.primitive;
-                case Kind::Array: return *array.baseType == *other.array.baseType && array.count == other.array.count;
+                case Kind::Array: return equals(array.baseType, other.array.baseType) && array.count == other.array.count;
                 case Kind::Structure: 
                 {
                     if(structure.size() != other.structure.size()) return false;
 
                     for(Structure::size_type i{0ul}; i < structure.size(); ++i)
-                        if(*structure[i].second != *other.structure[i].second)
+                        if(!equals(structure[i].second, other.structure[i].second))
                             return false;
 
                     return true;
                 }
                 case Kind::Function:
                 {
-                    if(!function.returnType || !other.function.returnType || *function.returnType != *other.function.returnType
+                    if(!function.returnType || !other.function.returnType || !equals(function.returnType, other.function.returnType)
                     || function.argumentTypes.size() != other.function.argumentTypes.size()) return false;
 
                     for(decltype(Function::argumentTypes)::size_type i{0ul}; i < function.argumentTypes.size(); ++i)
-                        if(!function.argumentTypes[i] || !other.function.argumentTypes[i] || *function.argumentTypes[i] != *other.function.argumentTypes[i])
+                        if(!function.argumentTypes[i] || !other.function.argumentTypes[i] || !equals(function.argumentTypes[i], other.function.argumentTypes[i]))
                             return false;
 
                     return true;
@@ -231,7 +176,7 @@ namespace linc
                 case Kind::Primitive: return primitive == other.primitive;
                 case Kind::Array:
                     if(array.count && *array.count == 0ul) return true;
-                    if(!array.baseType->isAssignableTo(*other.array.baseType))
+                    if(array.baseType != other.array.baseType && !array.baseType->isAssignableTo(*other.array.baseType))
                         return false;
                     else return (array.count && other.array.count && *array.count == *other.array.count) || !other.array.count;
                 case Kind::Structure:
@@ -239,7 +184,8 @@ namespace linc
 
                     for(Structure::size_type i{0ul}; i < structure.size(); ++i)
                         if(!structure.at(i).second || !other.structure.at(i).second) return false;
-                        else if(!structure[i].second->isAssignableTo(*other.structure[i].second)) return false;
+                        else if(structure[i].second != other.structure[i].second && !structure[i].second->isAssignableTo(*other.structure[i].second))
+                            return false;
                 
                     return true;
                 case Kind::Function: return type(function) == type(other.function);
@@ -264,28 +210,63 @@ namespace linc
             };
             bool isMutable;
 
-            static Structure cloneStructure(const Structure* structure, bool is_mutable)
+            /// @brief Members of a mutable structure are mutable themselves.
+            static Structure withMutableMembers(const Structure& structure, bool is_mutable)
             {
-                Structure result;
+                if(!is_mutable)
+                    return structure;
 
-                for(const auto& type: *structure)
-                {
-                    auto clone = type.second->clone();
-                    const_cast<Types::type*>(clone.get())->isMutable = clone->isMutable || is_mutable;
-                    result.push_back(std::pair(type.first, std::move(clone)));
-                }
+                Structure result;
+                result.reserve(structure.size());
+
+                for(const auto& member: structure)
+                    if(member.second->isMutable)
+                        result.push_back(member);
+                    else
+                    {
+                        type mutable_member(*member.second);
+                        mutable_member.isMutable = true;
+                        result.push_back(std::pair(member.first, mutable_member.intern()));
+                    }
 
                 return result;
             }
-
-            static Function cloneFunction(const Function* function)
+        private:
+            /// @brief Canonical nodes are identical, so structurally equal subtypes are usually the same pointer. Only
+            /// structures differing in their member names compare equal without being identical.
+            static bool equals(const type* left, const type* right)
             {
-                std::vector<std::unique_ptr<const Types::type>> argument_types;
+                return left == right || (left && right && *left == *right);
+            }
 
-                for(const auto& argument_type: function->argumentTypes)
-                    argument_types.push_back(argument_type->clone());
+            template <typename TYPE>
+            void construct(TYPE&& other)
+            {
+                switch(kind)
+                {
+                case Kind::Primitive: primitive = other.primitive; break;
+                case Kind::Array: new (&array) Array{std::forward<TYPE>(other).array}; break;
+                case Kind::Structure:
+                    if constexpr(std::is_lvalue_reference_v<TYPE>)
+                        new (&structure) Structure{withMutableMembers(other.structure, other.isMutable)};
+                    else new (&structure) Structure{std::move(other.structure)};
+                    break;
+                case Kind::Function: new (&function) Function{std::forward<TYPE>(other).function}; break;
+                case Kind::Enumeration: new (&enumeration) Enumeration{std::forward<TYPE>(other).enumeration}; break;
+                default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(kind);
+                }
+            }
 
-                return Function{.returnType = function->returnType->clone(), .argumentTypes = std::move(argument_types)};
+            void destroy()
+            {
+                switch(kind)
+                {
+                case Kind::Array: array.~Array(); break;
+                case Kind::Structure: structure.~vector(); break;
+                case Kind::Function: function.~Function(); break;
+                case Kind::Enumeration: enumeration.~vector(); break;
+                default: break;
+                }
             }
         };
        
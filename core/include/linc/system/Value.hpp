@@ -2,6 +2,7 @@
 #include <linc/system/PrimitiveValue.hpp>
 #include <linc/system/ArrayValue.hpp>
 #include <linc/system/EnumeratorValue.hpp>
+#include <linc/system/Shared.hpp>
 
 #define LINC_VALUE_OPERATOR_UNARY_PRIMITIVE(op, return_type, const_keyword) \
 return_type operator op() const_keyword \
@@ -45,7 +46,7 @@ return_type operator op() const_keyword \
         { \
         case Kind::Primitive: return m_primitive op other.m_primitive; \
         case Kind::Array: return m_array op other.m_array; \
-        case Kind::Structure: return m_structure op other.m_structure; \
+        case Kind::Structure: return *m_structure op *other.m_structure; \
         case Kind::Enumerator: return m_enumerator op other.m_enumerator; \
         default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind); \
         } \
@@ -79,10 +80,10 @@ namespace linc
             new (&m_enumerator) EnumeratorValue{value};
         }
 
-        explicit Value(const std::vector<Value>& value)
+        explicit Value(std::vector<Value> value)
             :m_kind(Kind::Structure)
         {
-            new (&m_structure) std::vector<Value>{copyStructure(value)};
+            new (&m_structure) Shared{std::move(value)};
         }
 
         Value(const Value& other)
@@ -92,7 +93,7 @@ namespace linc
             {
             case Kind::Primitive: new (&m_primitive) PrimitiveValue{other.m_primitive}; break;
             case Kind::Array: new (&m_array) ArrayValue{other.m_array}; break;
-            case Kind::Structure: new (&m_structure) std::vector<Value>{copyStructure(other.m_structure)}; break;
+            case Kind::Structure: new (&m_structure) Shared{other.m_structure}; break;
             case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{other.m_enumerator}; break;
             default:
                 throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
@@ -101,13 +102,17 @@ namespace linc
 
         Value& operator=(const Value& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~Value();
             m_kind = other.m_kind;
 
             switch(m_kind)
             {
             case Kind::Primitive: new (&m_primitive) PrimitiveValue{other.m_primitive}; break;
             case Kind::Array: new (&m_array) ArrayValue{other.m_array}; break;
-            case Kind::Structure: new (&m_structure) std::vector<Value>{copyStructure(other.m_structure)}; break;
+            case Kind::Structure: new (&m_structure) Shared{other.m_structure}; break;
             case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{other.m_enumerator}; break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
@@ -122,10 +127,10 @@ namespace linc
 
             switch(m_kind)
             {
-            case Kind::Primitive: new (&m_primitive) PrimitiveValue{std::move(other.m_primitive)}; break;
-            case Kind::Array: new (&m_array) ArrayValue{std::move(other.m_array)}; break;
-            case Kind::Structure: new (&m_structure) std::vector<Value>{copyStructure(other.m_structure)}; break;
-            case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{std::move(other.m_enumerator)}; break;
+            case Kind::Primitive: new (&m_primitive) PrimitiveValue{std::move(other.m_primitive)}; other.m_primitive.~PrimitiveValue(); break;
+            case Kind::Array: new (&m_array) ArrayValue{std::move(other.m_array)}; other.m_array.~ArrayValue(); break;
+            case Kind::Structure: new (&m_structure) Shared{std::move(other.m_structure)}; other.m_structure.~Shared(); break;
+            case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{std::move(other.m_enumerator)}; other.m_enumerator.~EnumeratorValue(); break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
         }
@@ -136,7 +141,7 @@ namespace linc
             {
             case Kind::Primitive: m_primitive.~PrimitiveValue(); break;
             case Kind::Array: m_array.~ArrayValue(); break;
-            case Kind::Structure: m_structure.~vector(); break;
+            case Kind::Structure: m_structure.~Shared(); break;
             case Kind::Enumerator: m_enumerator.~EnumeratorValue(); break;
             default: break;
             }
@@ -144,15 +149,19 @@ namespace linc
 
         Value& operator=(Value&& other)
         {
+            if(this == &other)
+                return *this;
+
+            this->~Value();
             m_kind = other.m_kind;
             other.m_kind = Kind::Invalid;
 
             switch(m_kind)
             {
-            case Kind::Primitive: new (&m_primitive) PrimitiveValue{std::move(other.m_primitive)}; break;
-            case Kind::Array: new (&m_array) ArrayValue{std::move(other.m_array)}; break;
-            case Kind::Structure: new (&m_structure) std::vector<Value>{copyStructure(other.m_structure)}; break;
-            case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{std::move(other.m_enumerator)}; break;
+            case Kind::Primitive: new (&m_primitive) PrimitiveValue{std::move(other.m_primitive)}; other.m_primitive.~PrimitiveValue(); break;
+            case Kind::Array: new (&m_array) ArrayValue{std::move(other.m_array)}; other.m_array.~ArrayValue(); break;
+            case Kind::Structure: new (&m_structure) Shared{std::move(other.m_structure)}; other.m_structure.~Shared(); break;
+            case Kind::Enumerator: new (&m_enumerator) EnumeratorValue{std::move(other.m_enumerator)}; other.m_enumerator.~EnumeratorValue(); break;
             default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
             }
 
@@ -173,7 +182,7 @@ namespace linc
                 for(const auto& member: type.structure)
                     values.push_back(fromDefault(*member.second));
                 
-                return Value(values);
+                return Value(std::move(values));
             }
             case Types::type::Kind::Enumeration:
                 return type.enumeration.empty()? Value(PrimitiveValue::voidValue):
@@ -219,12 +228,14 @@ namespace linc
 
         inline const PrimitiveValue& getPrimitive() const { return m_primitive; }
         inline const ArrayValue& getArray() const { return m_array; }
-        inline const std::vector<Value>& getStructure() const { return m_structure; }
+        inline const std::vector<Value>& getStructure() const { return *m_structure; }
 
         inline PrimitiveValue& getPrimitive() { return m_primitive; }
         inline ArrayValue& getArray() { return m_array; }
-        inline std::vector<Value>& getStructure() { return m_structure; }
+        /// @brief Access the members mutably, copying them first only if they are shared with another value.
+        inline std::vector<Value>& getStructure() { return m_structure.mutate(); }
         inline EnumeratorValue& getEnumerator() { return m_enumerator; }
+        inline Kind getKind() const { return m_kind; }
 
         inline std::optional<PrimitiveValue> getIfPrimitive() const
         {
@@ -238,7 +249,7 @@ namespace linc
 
         inline std::optional<std::vector<Value>> getIfStructure() const
         {
-            return m_kind == Kind::Structure? std::make_optional(m_structure): std::nullopt;
+            return m_kind == Kind::Structure? std::make_optional(*m_structure): std::nullopt;
         }
 
         inline std::optional<EnumeratorValue> getIfEnumerator() const
@@ -256,8 +267,8 @@ namespace linc
             {
                 std::string result;
                 result.push_back('{');
-                for(Types::type::Structure::size_type i{0ul}; i < m_structure.size(); ++i)
-                    result.append((i == 0ul? "": ", ") + m_structure[i].toApplicationString());
+                for(Types::type::Structure::size_type i{0ul}; i < m_structure->size(); ++i)
+                    result.append((i == 0ul? "": ", ") + (*m_structure)[i].toApplicationString());
                     
                 result.push_back('}');
                 return result;
@@ -277,8 +288,8 @@ namespace linc
             {
                 std::string result;
                 result.push_back('{');
-                for(Types::type::Structure::size_type i{0ul}; i < m_structure.size(); ++i)
-                    result.append((i == 0ul? "": ", ") + m_structure[i].toString());
+                for(Types::type::Structure::size_type i{0ul}; i < m_structure->size(); ++i)
+                    result.append((i == 0ul? "": ", ") + (*m_structure)[i].toString());
                     
                 result.push_back('}');
                 return result;
@@ -289,23 +300,12 @@ namespace linc
             }
         }
     private:
-        static std::vector<Value> copyStructure(const std::vector<Value>& structure) 
-        {
-            std::vector<Value> values;
-            values.reserve(structure.size());
-            
-            for(const auto& member: structure)
-                values.push_back(member);
-            
-            return values;
-        }
-
         union
         {
             PrimitiveValue m_primitive;
             ArrayValue m_array;
             EnumeratorValue m_enumerator;
-            std::vector<Value> m_structure;
+            Shared<std::vector<Value>> m_structure;
         };
         Kind m_kind;
     };
@@ -33,10 +33,10 @@ namespace linc
             m_rightParenthesis(right_parenthesis), m_specifier(VariableForSpecifier{std::move(declaration), std::move(expression), std::move(statement)}),
             m_body(std::move(body))
         {
-            if(label)
+            if(m_label)
             {
-                addToken(label->specifier);
-                addTokens(label->identifier->getTokens());
+                addToken(m_label->specifier);
+                addTokens(m_label->identifier->getTokens());
             }
             
             addTokens(std::vector{m_forKeyword, m_leftParenthesis});
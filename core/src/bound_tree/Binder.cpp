@@ -76,45 +76,26 @@ namespace linc
     {
         m_scopes = ScopeStack<std::unique_ptr<const BoundDeclaration>>{};
         m_labels = StringStack{};
+        m_frames = {Frame{}};
+        m_scopeSlots.clear();
+        m_functionCount = 0ul;
     }
 
-    std::unique_ptr<const BoundDeclaration> BoundSymbols::find(const std::string& name, bool top_only) const
+    const BoundDeclaration* BoundSymbols::find(const std::string& name, bool top_only) const
     {
         if(auto find = top_only? m_scopes.findTop(name): m_scopes.find(name); find)
         {
-            if(auto variable = dynamic_cast<const BoundVariableDeclaration*>(find->get()))
-            {
-                if(variable->getName() == name)
-                    return variable->clone();
-            }
-            else if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(find->get()))
-            {
-                if(function->getName() == name)
-                    return function->clone();
-            }
-            else if(auto external_function = dynamic_cast<const BoundExternalDeclaration*>(find->get()))
-            {
-                if(external_function->getName() == name)
-                    return external_function->clone();
-            }
-            else if(auto structure_declaration = dynamic_cast<const BoundStructureDeclaration*>(find->get()))
-            {
-                if(structure_declaration->getName() == name)
-                    return structure_declaration->clone();
-            }
-            else if(auto enumeration_declaration = dynamic_cast<const BoundEnumerationDeclaration*>(find->get()))
-            {
-                if(enumeration_declaration->getName() == name)
-                    return enumeration_declaration->clone();
-            }
-            else throw LINC_EXCEPTION_ILLEGAL_STATE(find);
-        }   
+            if(!find->get()->isDeclaration())
+                throw LINC_EXCEPTION_ILLEGAL_STATE(find);
+
+            return find->get();
+        }
         return nullptr;
     }
 
     bool BoundSymbols::push(std::unique_ptr<const BoundDeclaration> symbol)
     {
-        std::unique_ptr<const BoundDeclaration> find{nullptr};
+        const BoundDeclaration* find{nullptr};
         std::string name;
         
         if(auto variable = dynamic_cast<const BoundVariableDeclaration*>(symbol.get()))
@@ -429,7 +410,7 @@ namespace linc
         auto default_value = declaration->getDefaultValue()? std::make_optional(bindExpression(declaration->getDefaultValue()->getExpression())):
             std::nullopt;
 
-        auto variable = std::make_unique<const BoundVariableDeclaration>(type, name, std::move(default_value));
+        auto variable = std::make_unique<const BoundVariableDeclaration>(type, name, std::move(default_value), m_boundDeclarations.allocateSlot());
 
         if(variable->getDefaultValue() && !variable->getDefaultValue().value()->getType().isAssignableTo(type))
             Reporting::push(Reporting::Report{
@@ -467,7 +448,7 @@ namespace linc
         type.isMutable = declaration->getMutabilitySpecifier().has_value(); 
         auto name = declaration->getIdentifier()->getValue();
 
-        auto variable = std::make_unique<const BoundVariableDeclaration>(type, name, std::move(value));
+        auto variable = std::make_unique<const BoundVariableDeclaration>(type, name, std::move(value), m_boundDeclarations.allocateSlot());
 
         if(!m_boundDeclarations.push(variable->clone()))
             Reporting::push(Reporting::Report{
@@ -484,10 +465,11 @@ namespace linc
         auto name = declaration->getIdentifier()->getValue();
 
         std::vector<std::unique_ptr<const BoundVariableDeclaration>> arguments;
-        std::vector<std::unique_ptr<const Types::type>> argument_types;
+        std::vector<const Types::type*> argument_types;
         arguments.reserve(declaration->getArguments()->getList().size());
         argument_types.reserve(declaration->getArguments()->getList().size());
 
+        m_boundDeclarations.beginFrame();
         m_boundDeclarations.beginScope();
         bool has_default_value{false}, has_error{false};
 
@@ -519,11 +501,14 @@ namespace linc
         }
 
         for(const auto& argument: arguments)
-            argument_types.push_back(argument->getActualType().clone());
+            argument_types.push_back(argument->getActualType().intern());
 
         ++m_inFunction;
         m_currentFunctionType = return_type;
+        m_functionPurity.push_back(true);
         auto body = bindExpression(declaration->getBody());
+        const bool pure = m_functionPurity.back();
+        m_functionPurity.pop_back();
         if(return_type == Types::invalidType) { return_type = body->getType(); return_type.isMutable = false; }
         m_currentFunctionType = Types::voidType;
         --m_inFunction;
@@ -534,16 +519,19 @@ namespace linc
                 .span = TextSpan::fromTokenInfo(declaration->getTypeSpecifier().info),
                 .message = Logger::format("$ Mutable modifier is ineffective on function return types.", declaration->getInfoString())});
 
-        auto function_type = Types::type{Types::type::Function{return_type.clone(), std::move(argument_types)}, return_type.isMutable};
-        auto function = std::make_unique<const BoundFunctionDeclaration>(function_type, name, std::move(arguments), std::move(body));
+        m_boundDeclarations.endScope();
+        const auto depth = m_boundDeclarations.getDepth();
+        const auto frame_size = m_boundDeclarations.endFrame();
+
+        auto function_type = Types::type{Types::type::Function{return_type.intern(), std::move(argument_types)}, return_type.isMutable};
+        auto function = std::make_unique<const BoundFunctionDeclaration>(function_type, name, std::move(arguments), std::move(body),
+            depth, frame_size, m_boundDeclarations.allocateFunction(), pure);
 
         if(!function->getBody()->getType().isAssignableTo(function->getReturnType()))
             Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Function '$' declared with return type `$`, but it evaluates to type `$`.",
                     declaration->getInfoString(), name, function->getReturnType(), function->getBody()->getType())});
-        
-        m_boundDeclarations.endScope();
 
         if(!has_error && !m_boundDeclarations.push(function->clone()))
             Reporting::push(Reporting::Report{
@@ -637,10 +625,20 @@ namespace linc
 
             return std::make_unique<const BoundIdentifierExpression>(value, Types::invalidType);
         }
-        else if(auto variable = dynamic_cast<const BoundVariableDeclaration*>(find.get()))
-            return std::make_unique<const BoundIdentifierExpression>(value, variable->getActualType());
+        else if(auto variable = dynamic_cast<const BoundVariableDeclaration*>(find))
+        {
+            // the values of global constants initialized with literals are known before the program runs
+            const auto& slot = variable->getSlot();
+            const auto& default_value = variable->getDefaultValue();
 
-        else if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(find.get()))
+            if(slot.depth != m_boundDeclarations.getDepth() && (slot.depth != 0ul || variable->getActualType().isMutable
+            || !default_value || default_value.value()->getKind() != BoundNode::Kind::LiteralExpression))
+                markImpure();
+
+            return std::make_unique<const BoundIdentifierExpression>(value, variable->getActualType(), slot);
+        }
+
+        else if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(find))
             return std::make_unique<const BoundIdentifierExpression>(value, function->getFunctionType());
 
         Reporting::push(Reporting::Report{
@@ -666,14 +664,14 @@ namespace linc
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Undeclared identifier '$' does not result to a namespace.", expression->getInfoString(), name)
             }), std::make_unique<const BoundEnumeratorExpression>(std::string{}, -1ul, nullptr, Types::invalidType));
-        else if(auto enumeration = dynamic_cast<const BoundEnumerationDeclaration*>(find.get()); !enumeration)
+        else if(auto enumeration = dynamic_cast<const BoundEnumerationDeclaration*>(find); !enumeration)
             return (Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Cannot namespace-access identifier '$', which is not an enumeration.",
                     expression->getInfoString(), name)
             }), std::make_unique<const BoundEnumeratorExpression>(std::string{}, -1ul, nullptr, Types::invalidType));
         
-        auto enumeration = static_cast<const BoundEnumerationDeclaration*>(find.get());
+        auto enumeration = static_cast<const BoundEnumerationDeclaration*>(find);
         auto enumerator_name = expression->getIdentifier()->getValue();
         auto type = enumeration->getActualType();
 
@@ -682,11 +680,13 @@ namespace linc
             if(enumerator_name == enumeration->getEnumerators()->getList()[i]->getName())
                 enumerator_index = i;
 
-        if(expression->getValue() && !match_identifier.empty() && enumerator_index != -1ul)
+        const bool binds_value = expression->getValue() && !match_identifier.empty() && enumerator_index != -1ul;
+
+        if(binds_value)
         {
             const auto& enumerator = enumeration->getEnumerators()->getList().at(enumerator_index);
             if(!m_boundDeclarations.push(std::make_unique<const BoundVariableDeclaration>(
-                enumerator->getActualType(), match_identifier, std::nullopt)))
+                enumerator->getActualType(), match_identifier, std::nullopt, m_boundDeclarations.allocateSlot())))
                 Reporting::push(Reporting::Report{
                     .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                     .span = TextSpan::fromTokenInfo(expression->getValue()->getTokenInfo()),
@@ -718,7 +718,7 @@ namespace linc
                     expression->getTokenInfo(), enumerator_name, name)
             }), std::make_unique<const BoundEnumeratorExpression>(std::string{}, -1ul, nullptr, Types::invalidType));
 
-        return std::make_unique<const BoundEnumeratorExpression>(name, enumerator_index, std::move(value), type);
+        return std::make_unique<const BoundEnumeratorExpression>(name, enumerator_index, std::move(value), type, binds_value);
     }
 
     const std::unique_ptr<const BoundTypeExpression> Binder::bindTypeExpression(const TypeExpression* expression)
@@ -731,12 +731,12 @@ namespace linc
 
         else if(auto function = expression->getIfFunctionRoot())
         {
-            auto return_type = bindTypeExpression(function->returnType.get())->getActualType().clone();
-            std::vector<std::unique_ptr<const Types::type>> argument_types;
+            auto return_type = bindTypeExpression(function->returnType.get())->getActualType().intern();
+            std::vector<const Types::type*> argument_types;
             argument_types.reserve(function->argumentTypes->getList().size());
 
             for(const auto& type: function->argumentTypes->getList())
-                argument_types.push_back(bindTypeExpression(type.node.get())->getActualType().clone());
+                argument_types.push_back(bindTypeExpression(type.node.get())->getActualType().intern());
 
             return std::make_unique<const BoundTypeExpression>(Types::type::Function{std::move(return_type), std::move(argument_types)}, expression->getMutabilityKeyword().has_value(),
                 std::move(specifiers));
@@ -756,17 +756,17 @@ namespace linc
                 return std::make_unique<const BoundTypeExpression>(Types::Kind::invalid, expression->getMutabilityKeyword().has_value(),
                     std::move(specifiers));
             }
-            else if(auto structure_declaration = dynamic_cast<const BoundStructureDeclaration*>(find.get()))
+            else if(auto structure_declaration = dynamic_cast<const BoundStructureDeclaration*>(find))
             {
                 Types::type::Structure types;
                 types.reserve(structure_declaration->getFields().size());
 
                 for(const auto& field: structure_declaration->getFields())
-                    types.push_back(std::pair(field->getName(), field->getActualType().clone()));
+                    types.push_back(std::pair(field->getName(), field->getActualType().intern()));
 
                 return std::make_unique<const BoundTypeExpression>(std::move(types), expression->getMutabilityKeyword().has_value(), std::move(specifiers));
             }
-            else if(auto enumeration_declaration = dynamic_cast<const BoundEnumerationDeclaration*>(find.get()))
+            else if(auto enumeration_declaration = dynamic_cast<const BoundEnumerationDeclaration*>(find))
             {
                 Types::type::Enumeration types;
                 types.reserve(enumeration_declaration->getEnumerators()->getList().size());
@@ -897,7 +897,8 @@ namespace linc
             auto range_type = Types::type(array_identifier->getType().kind == Types::type::Kind::Primitive
                 && array_identifier->getType().primitive == Types::Kind::string?
                 Types::fromKind(Types::Kind::_char): *array_identifier->getType().array.baseType);
-            auto variable_declaration = std::make_unique<const BoundVariableDeclaration>(range_type, range_specifier->valueIdentifier->getValue(), std::nullopt);
+            auto variable_declaration = std::make_unique<const BoundVariableDeclaration>(range_type, range_specifier->valueIdentifier->getValue(), std::nullopt,
+                m_boundDeclarations.allocateSlot());
 
             if(!m_boundDeclarations.push(variable_declaration->clone()))
                 Reporting::push(Reporting::Report{
@@ -932,7 +933,7 @@ namespace linc
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Cannot call undeclared function '$'.", expression->getInfoString(), name)});
 
-        else if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(find.get()); !function)
+        else if(auto function = dynamic_cast<const BoundFunctionDeclaration*>(find); !function)
             Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Cannot call identifier '$', as it is not a function.", expression->getInfoString(), name)});
@@ -985,9 +986,13 @@ namespace linc
                 });
             }
 
-            return std::make_unique<const BoundFunctionCallExpression>(function->getReturnType(), name, std::move(arguments));
+            if(!function->isPure())
+                markImpure();
+
+            return std::make_unique<const BoundFunctionCallExpression>(function->getReturnType(), name, std::move(arguments), function->getIndex());
         }
 
+        markImpure();
         return std::make_unique<const BoundFunctionCallExpression>(Types::invalidType, name, std::move(arguments));
     }
 
@@ -997,6 +1002,7 @@ namespace linc
         std::vector<std::unique_ptr<const BoundExpression>> arguments;
 
         auto find = m_boundDeclarations.find(name);
+        markImpure();
 
         if(Internals::isInternal(name))
         {
@@ -1043,7 +1049,7 @@ namespace linc
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Cannot call undeclared external function '$'.", expression->getInfoString(), name)});
 
-        else if(auto external = dynamic_cast<const BoundExternalDeclaration*>(find.get()); !external)
+        else if(auto external = dynamic_cast<const BoundExternalDeclaration*>(find); !external)
             Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Cannot call identifier '$', as it is not an external function.", expression->getInfoString(), name)});
@@ -1122,7 +1128,7 @@ namespace linc
         auto kind = bindUnaryOperatorKind(expression->getOperatorToken().type);
         auto _operator = std::make_unique<const BoundUnaryOperator>(kind, operand->getType());
 
-        if(_operator->getReturnType().primitive == Types::Kind::invalid)
+        if(_operator->getReturnType().kind == Types::type::Kind::Primitive && _operator->getReturnType().primitive == Types::Kind::invalid)
             reportInvalidUnaryOperator(kind, operand->getType(), expression->getInfo().info);
 
         return std::make_unique<const BoundUnaryExpression>(std::move(_operator), std::move(operand));
@@ -1167,7 +1173,7 @@ namespace linc
         auto kind = bindBinaryOperatorKind(expression->getOperatorToken().type);
         auto _operator = std::make_unique<const BoundBinaryOperator>(kind, left->getType(), right->getType());
 
-        if(_operator->getReturnType().primitive == Types::Kind::invalid)
+        if(_operator->getReturnType().kind == Types::type::Kind::Primitive && _operator->getReturnType().primitive == Types::Kind::invalid)
             reportInvalidBinaryOperator(kind, left->getType(), right->getType(), expression->getInfo().info);
 
         return std::make_unique<const BoundBinaryExpression>(std::move(_operator), std::move(left), std::move(right));
@@ -1180,7 +1186,7 @@ namespace linc
 
         auto conversion = std::make_unique<const BoundConversion>(inner_expression->getType(), target_type);
 
-        if(conversion->getReturnType().primitive == Types::Kind::invalid)
+        if(conversion->getReturnType().kind == Types::type::Kind::Primitive && conversion->getReturnType().primitive == Types::Kind::invalid)
             Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
                 .message = Logger::format("$ Invalid conversion expression to type `$` (from `$`).",
@@ -1212,7 +1218,7 @@ namespace linc
         }
 
         return std::make_unique<const BoundArrayInitializerExpression>(std::move(values), Types::type(Types::type::Array{
-            .baseType = type.clone(),
+            .baseType = type.intern(),
             .count = values.size() 
         }));
     }
@@ -1316,7 +1322,7 @@ namespace linc
             return std::make_unique<const BoundStructureInitializerExpression>(name, std::vector<std::unique_ptr<const BoundExpression>>{},
                 Types::invalidType);
         }
-        else if(!dynamic_cast<const BoundStructureDeclaration*>(find.get()))
+        else if(!dynamic_cast<const BoundStructureDeclaration*>(find))
         {
             Reporting::push(Reporting::Report{
                 .type = Reporting::Type::Error, .stage = Reporting::Stage::ABT,
@@ -1328,7 +1334,7 @@ namespace linc
         }
 
         std::vector<std::unique_ptr<const BoundExpression>> fields{};
-        auto structure = static_cast<const BoundStructureDeclaration*>(find.get());
+        auto structure = static_cast<const BoundStructureDeclaration*>(find);
         fields.reserve(structure->getFields().size());
 
         if(structure->getFields().size() != expression->getArguments().size())
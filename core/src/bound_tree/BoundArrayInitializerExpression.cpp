@@ -3,7 +3,7 @@
 namespace linc
 {
     BoundArrayInitializerExpression::BoundArrayInitializerExpression(std::vector<std::unique_ptr<const BoundExpression>> values, Types::type type)
-        :BoundExpression(type), m_values(std::move(values))
+        :BoundExpression(Kind::ArrayInitializerExpression, type), m_values(std::move(values))
     {}
 
     std::string BoundArrayInitializerExpression::toStringInner() const
@@ -67,14 +67,14 @@ namespace linc
             case Kind::Addition:
                 if(left_type.kind == right_type.kind)
                     return Types::type(Types::type::Array{
-                        .baseType = std::make_unique<const Types::type>(*left_type.array.baseType),
+                        .baseType = left_type.array.baseType,
                         .count = left_type.array.count && right_type.array.count? std::make_optional(*left_type.array.count + *right_type.array.count): std::nullopt
                     });
                 else return Types::invalidType;
             case Kind::AdditionAssignment:
                 if(left_type.isAssignableTo(right_type) && left_type.isMutable)
                     return Types::type(Types::type::Array{
-                        .baseType = std::make_unique<const Types::type>(*left_type.array.baseType),
+                        .baseType = left_type.array.baseType,
                         .count = left_type.array.count && right_type.array.count? std::make_optional(*left_type.array.count + *right_type.array.count): std::nullopt
                     });
             default: return Types::invalidType;
@@ -164,7 +164,7 @@ namespace linc
 
     BoundBinaryExpression::BoundBinaryExpression(std::unique_ptr<const BoundBinaryOperator> _operator, std::unique_ptr<const BoundExpression> left,
         std::unique_ptr<const BoundExpression> right)
-        :BoundExpression(_operator->getReturnType()), m_operator(std::move(_operator)), m_left(std::move(left)), m_right(std::move(right))
+        :BoundExpression(Kind::BinaryExpression, _operator->getReturnType()), m_operator(std::move(_operator)), m_left(std::move(left)), m_right(std::move(right))
     {}
 
     std::unique_ptr<const BoundExpression> BoundBinaryExpression::clone() const
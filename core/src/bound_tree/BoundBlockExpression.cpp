@@ -1,12 +1,22 @@
 #include <linc/bound_tree/BoundBlockExpression.hpp>
+#include <linc/bound_tree/BoundDeclarationStatement.hpp>
 
 namespace linc
 {
     BoundBlockExpression::BoundBlockExpression(std::vector<std::unique_ptr<const BoundStatement>> statements, std::unique_ptr<const BoundExpression> tail)
-        :BoundExpression(tail? tail->getType(): Types::fromKind(Types::Kind::_void)),
+        :BoundExpression(Kind::BlockExpression, tail? tail->getType(): Types::fromKind(Types::Kind::_void)),
         m_statements(std::move(statements)),
         m_tail(std::move(tail))
-    {}
+    {
+        for(const auto& statement: m_statements)
+            if(statement->getKind() == Kind::DeclarationStatement)
+            {
+                auto kind = static_cast<const BoundDeclarationStatement*>(statement.get())->getDeclaration()->getKind();
+                
+                if(kind == Kind::FunctionDeclaration || kind == Kind::EnumerationDeclaration)
+                    m_hasScopedDeclarations = true;
+            }
+    }
 
     std::unique_ptr<const BoundExpression> BoundBlockExpression::clone() const
     {
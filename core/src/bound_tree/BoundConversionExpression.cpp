@@ -52,7 +52,7 @@ namespace linc
 
     BoundConversionExpression::BoundConversionExpression(std::unique_ptr<const BoundExpression> expression,
         std::unique_ptr<const BoundConversion> conversion)
-        :BoundExpression(conversion->getReturnType()), m_expression(std::move(expression)), m_conversion(std::move(conversion))
+        :BoundExpression(Kind::ConversionExpression, conversion->getReturnType()), m_expression(std::move(expression)), m_conversion(std::move(conversion))
     {}
         
     std::unique_ptr<const BoundExpression> BoundConversionExpression::clone() const
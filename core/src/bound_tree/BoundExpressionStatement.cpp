@@ -3,7 +3,7 @@
 namespace linc
 {
     BoundExpressionStatement::BoundExpressionStatement(std::unique_ptr<const BoundExpression> expression)
-        :m_expression(std::move(expression))
+        :BoundStatement(Kind::ExpressionStatement), m_expression(std::move(expression))
     {}
 
     std::unique_ptr<const BoundStatement> BoundExpressionStatement::clone() const
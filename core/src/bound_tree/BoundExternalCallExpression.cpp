@@ -4,7 +4,7 @@ namespace linc
 {
     BoundExternalCallExpression::BoundExternalCallExpression(Types::type type, const std::string& name, 
         std::vector<std::unique_ptr<const BoundExpression>> arguments)
-        :BoundExpression(type), m_name(name), m_arguments(std::move(arguments))
+        :BoundExpression(Kind::ExternalCallExpression, type), m_name(name), m_arguments(std::move(arguments))
     {}
 
     std::unique_ptr<const BoundExpression> BoundExternalCallExpression::clone() const
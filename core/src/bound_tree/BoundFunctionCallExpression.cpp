@@ -3,8 +3,8 @@
 namespace linc
 {
     BoundFunctionCallExpression::BoundFunctionCallExpression(Types::type type, const std::string& name, 
-        std::vector<Argument> arguments)
-        :BoundExpression(type), m_name(name), m_arguments(std::move(arguments))
+        std::vector<Argument> arguments, std::optional<Types::u64> index)
+        :BoundExpression(Kind::FunctionCallExpression, type), m_name(name), m_arguments(std::move(arguments)), m_index(index)
     {}
 
     std::unique_ptr<const BoundExpression> BoundFunctionCallExpression::clone() const
@@ -16,7 +16,7 @@ namespace linc
                 .value = std::move(argument.value->clone())
             });
 
-        return std::make_unique<const BoundFunctionCallExpression>(getType(), m_name, std::move(arguments));
+        return std::make_unique<const BoundFunctionCallExpression>(getType(), m_name, std::move(arguments), m_index);
     }
 
     std::string BoundFunctionCallExpression::toStringInner() const
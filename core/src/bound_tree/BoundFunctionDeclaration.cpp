@@ -4,8 +4,9 @@ namespace linc
 {
     BoundFunctionDeclaration::BoundFunctionDeclaration(const Types::type& function_type, const std::string& name, 
         std::vector<std::unique_ptr<const BoundVariableDeclaration>> arguments, 
-        std::unique_ptr<const BoundExpression> body)
-        :m_functionType(function_type), m_name(name), m_arguments(std::move(arguments)), m_body(std::move(body))
+        std::shared_ptr<const BoundExpression> body, Types::u64 depth, Types::u64 frame_size, Types::u64 index, bool pure)
+        :BoundDeclaration(Kind::FunctionDeclaration), m_functionType(function_type), m_name(name), m_arguments(std::move(arguments)), m_body(std::move(body)),
+        m_depth(depth), m_frameSize(frame_size), m_index(index), m_pure(pure)
     {}
 
     std::unique_ptr<const BoundDeclaration> BoundFunctionDeclaration::clone() const
@@ -16,10 +17,12 @@ namespace linc
                 argument->getActualType(), argument->getName(),
                     argument->getDefaultValue().has_value()? 
                     std::make_optional(std::move(argument->getDefaultValue().value()->clone())):
-                    std::nullopt
+                    std::nullopt,
+                argument->getSlot()
             ));
 
-        return std::make_unique<const BoundFunctionDeclaration>(getFunctionType(), m_name, std::move(arguments), std::move(m_body->clone()));
+        return std::make_unique<const BoundFunctionDeclaration>(getFunctionType(), m_name, std::move(arguments), m_body,
+            m_depth, m_frameSize, m_index, m_pure);
     }
 
     std::string BoundFunctionDeclaration::toStringInner() const
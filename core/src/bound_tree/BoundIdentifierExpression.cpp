@@ -2,19 +2,23 @@
 
 namespace linc
 {
-    BoundIdentifierExpression::BoundIdentifierExpression(const std::string& value, const Types::type type)
-        :BoundExpression(type), m_value(value)
+    BoundIdentifierExpression::BoundIdentifierExpression(const std::string& value, const Types::type type, std::optional<Slot> slot)
+        :BoundExpression(Kind::IdentifierExpression, type), m_value(value), m_slot(slot)
     {}
 
     std::unique_ptr<const BoundExpression> BoundIdentifierExpression::clone() const
     {
-        return std::make_unique<const BoundIdentifierExpression>(m_value, getType());
+        return std::make_unique<const BoundIdentifierExpression>(m_value, getType(), m_slot);
     }
 
     const std::string& BoundIdentifierExpression::getValue() const { return m_value; }
     
     std::string BoundIdentifierExpression::toStringInner() const
     {
+        if(m_slot)
+            return Logger::format("Identifier Expression (=$) (@$:$)", PrimitiveValue(m_value), PrimitiveValue(m_slot->depth),
+                PrimitiveValue(m_slot->index));
+        
         return Logger::format("Identifier Expression (=$)", PrimitiveValue(m_value));
     }
     
@@ -12,7 +12,7 @@ namespace linc
 {
     BoundIfExpression::BoundIfExpression(Types::type type, std::unique_ptr<const BoundExpression> test_expression,
         std::unique_ptr<const BoundExpression> if_body, std::unique_ptr<const BoundExpression> else_body)
-        :BoundExpression(type), m_testExpression(std::move(test_expression)), m_ifBody(std::move(if_body)),
+        :BoundExpression(Kind::IfExpression, type), m_testExpression(std::move(test_expression)), m_ifBody(std::move(if_body)),
         m_elseBody(std::move(else_body))
     {
         LINC_BOUND_IF_ELSE_EXPRESSION_TYPECHECK;
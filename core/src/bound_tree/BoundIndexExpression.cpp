@@ -4,7 +4,7 @@ namespace linc
 {
     BoundIndexExpression::BoundIndexExpression(std::unique_ptr<const BoundExpression> array, std::unique_ptr<const BoundExpression> index,
         const Types::type& type)
-        :BoundExpression(type), m_array(std::move(array)), m_index(std::move(index))
+        :BoundExpression(Kind::IndexExpression, type), m_array(std::move(array)), m_index(std::move(index))
     {}
 
     std::unique_ptr<const BoundExpression> BoundIndexExpression::clone() const
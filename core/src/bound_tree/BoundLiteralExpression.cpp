@@ -5,7 +5,7 @@ namespace linc
     PrimitiveValue BoundLiteralExpression::getValue() const { return m_value; }
 
     BoundLiteralExpression::BoundLiteralExpression(const PrimitiveValue& value, const Types::type& type)
-        :BoundExpression(type), m_value(value)
+        :BoundExpression(Kind::LiteralExpression, type), m_value(value)
     {}
 
     std::string BoundLiteralExpression::toStringInner() const
@@ -0,0 +1,117 @@
+#include <linc/bound_tree/BoundMatchExpression.hpp>
+#include <linc/bound_tree/BoundLiteralExpression.hpp>
+#include <linc/bound_tree/BoundEnumeratorExpression.hpp>
+#include <algorithm>
+
+namespace linc
+{
+    std::optional<Types::u64> BoundMatchExpression::Dispatch::getKey(const PrimitiveValue& value)
+    {
+        switch(value.getKind())
+        {
+        case PrimitiveValue::Kind::Boolean: return value.getBool()? 1ul: 0ul;
+        case PrimitiveValue::Kind::Character: return static_cast<Types::u64>(static_cast<Types::i64>(value.getChar()));
+        case PrimitiveValue::Kind::Unsigned: return value.getU64();
+        case PrimitiveValue::Kind::Signed: return static_cast<Types::u64>(value.getI64());
+        default: return std::nullopt;
+        }
+    }
+
+    std::size_t BoundMatchExpression::Dispatch::find(Types::u64 key) const
+    {
+        switch(kind)
+        {
+        case Kind::Table:
+            // keys below the minimum wrap around to indices past the end of the table
+            return key - minimum < table.size()? table[key - minimum]: noClause;
+        case Kind::Tree:
+        {
+            auto find = std::ranges::lower_bound(cases, key, [&](Types::u64 first, Types::u64 second)
+            {
+                return isSigned? static_cast<Types::i64>(first) < static_cast<Types::i64>(second): first < second;
+            }, [](const auto& entry){ return entry.first; });
+
+            return find != cases.end() && find->first == key? find->second: noClause;
+        }
+        default: return noClause;
+        }
+    }
+
+    std::size_t BoundMatchExpression::Dispatch::find(const Types::string& key) const
+    {
+        auto find = strings.find(key);
+        return find != strings.end()? find->second: noClause;
+    }
+
+    BoundMatchExpression::BoundMatchExpression(std::unique_ptr<const BoundExpression> test_expression,
+        std::unique_ptr<const BoundNodeListClause<BoundMatchClause>> clauses, const Types::type& type)
+        :BoundExpression(Kind::MatchExpression, type), m_testExpression(std::move(test_expression)), m_clauses(std::move(clauses)),
+        m_dispatch(computeDispatch())
+    {}
+
+    std::optional<BoundMatchExpression::Dispatch> BoundMatchExpression::computeDispatch() const
+    {
+        const auto& test_type = m_testExpression->getType();
+        const bool is_enumeration = test_type.kind == Types::type::Kind::Enumeration;
+
+        if(!is_enumeration && test_type.kind != Types::type::Kind::Primitive)
+            return std::nullopt;
+
+        const bool is_string = !is_enumeration && test_type.primitive == Types::Kind::string;
+        Dispatch dispatch{.kind = is_string? Dispatch::Kind::Hash: Dispatch::Kind::Tree,
+            .isSigned = !is_enumeration && (Types::isSigned(test_type.primitive) || test_type.primitive == Types::Kind::_char)};
+
+        const auto& clauses = m_clauses->getList();
+        for(std::size_t clause{0ul}; clause < clauses.size(); ++clause)
+            for(const auto& value: clauses[clause]->getValues()->getList())
+            {
+                if(is_enumeration && value->getKind() == BoundNode::Kind::EnumeratorExpression)
+                {
+                    // enumerators of the tested enumeration are equal if their index is, as long as their value is not compared
+                    auto enumerator = static_cast<const BoundEnumeratorExpression*>(value.get());
+                    if(enumerator->getValue() && !enumerator->bindsValue())
+                        return std::nullopt;
+
+                    dispatch.cases.emplace_back(enumerator->getEnumeratorIndex(), clause);
+                    continue;
+                }
+                else if(value->getKind() != BoundNode::Kind::LiteralExpression || is_enumeration)
+                    return std::nullopt;
+
+                auto literal = static_cast<const BoundLiteralExpression*>(value.get())->getValue();
+
+                if(is_string && literal.getKind() == PrimitiveValue::Kind::String)
+                    dispatch.strings.try_emplace(literal.getStringReference(), clause);
+                else if(auto key = Dispatch::getKey(literal); key && !is_string)
+                    dispatch.cases.emplace_back(*key, clause);
+                else return std::nullopt;
+            }
+
+        if(dispatch.strings.size() + dispatch.cases.size() < Dispatch::minimumValues)
+            return std::nullopt;
+        else if(is_string)
+            return dispatch;
+
+        // the first clause a key belongs to matches it, as when testing values in order
+        std::ranges::stable_sort(dispatch.cases, [&](const auto& first, const auto& second)
+        {
+            return dispatch.isSigned? static_cast<Types::i64>(first.first) < static_cast<Types::i64>(second.first): first.first < second.first;
+        });
+
+        auto duplicates = std::ranges::unique(dispatch.cases, {}, [](const auto& entry){ return entry.first; });
+        dispatch.cases.erase(duplicates.begin(), duplicates.end());
+
+        const auto range = dispatch.cases.back().first - dispatch.cases.front().first;
+        if(range >= Dispatch::maximumTableSize || range + 1ul > dispatch.cases.size() * Dispatch::minimumTableDensity)
+            return dispatch;
+
+        dispatch.kind = Dispatch::Kind::Table;
+        dispatch.minimum = dispatch.cases.front().first;
+        dispatch.table.assign(range + 1ul, Dispatch::noClause);
+
+        for(const auto& [key, clause]: dispatch.cases)
+            dispatch.table[key - dispatch.minimum] = clause;
+
+        return dispatch;
+    }
+}
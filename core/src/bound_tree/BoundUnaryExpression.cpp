@@ -89,7 +89,7 @@ namespace linc
     }
 
     BoundUnaryExpression::BoundUnaryExpression(std::unique_ptr<const BoundUnaryOperator> _operator, std::unique_ptr<const BoundExpression> operand)
-        :BoundExpression(_operator->getReturnType()), m_operator(std::move(_operator)), m_operand(std::move(operand))
+        :BoundExpression(Kind::UnaryExpression, _operator->getReturnType()), m_operator(std::move(_operator)), m_operand(std::move(operand))
     {}
 
     std::unique_ptr<const BoundExpression> BoundUnaryExpression::clone() const
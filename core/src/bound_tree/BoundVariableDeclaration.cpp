@@ -3,18 +3,19 @@
 namespace linc
 {
     BoundVariableDeclaration::BoundVariableDeclaration(Types::type type, const std::string& name,
-        std::optional<std::unique_ptr<const BoundExpression>> default_value)
-        :m_actualType(type), m_name(name), m_defaultValue(std::move(default_value))
+        std::optional<std::unique_ptr<const BoundExpression>> default_value, Slot slot)
+        :BoundDeclaration(Kind::VariableDeclaration), m_actualType(type), m_name(name), m_defaultValue(std::move(default_value)), m_slot(slot)
     {}
 
     std::unique_ptr<const BoundDeclaration> BoundVariableDeclaration::clone() const
     {
         return std::make_unique<const BoundVariableDeclaration>(m_actualType, m_name, 
-            m_defaultValue.has_value()? std::make_optional(m_defaultValue.value()->clone()): std::nullopt);
+            m_defaultValue.has_value()? std::make_optional(m_defaultValue.value()->clone()): std::nullopt, m_slot);
     }
     
     std::string BoundVariableDeclaration::toStringInner() const
     {
-        return Logger::format("Variable Declaration (=$) (::$)", PrimitiveValue(m_name), PrimitiveValue(m_actualType));
+        return Logger::format("Variable Declaration (=$) (::$) (@$:$)", PrimitiveValue(m_name), PrimitiveValue(m_actualType),
+            PrimitiveValue(m_slot.depth), PrimitiveValue(m_slot.index));
     }
 }
\ No newline at end of file
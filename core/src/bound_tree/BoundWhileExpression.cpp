@@ -5,7 +5,7 @@ namespace linc
     BoundWhileExpression::BoundWhileExpression(std::string_view label, Types::type type, std::unique_ptr<const BoundExpression> test_expression,
         std::unique_ptr<const BoundExpression> while_body, std::unique_ptr<const BoundExpression> finally_body,
         std::unique_ptr<const BoundExpression> else_body)
-        :BoundExpression(type), m_label(label), m_testExpression(std::move(test_expression)), m_whileBody(std::move(while_body)), m_finallyBody(std::move(finally_body)),
+        :BoundExpression(Kind::WhileExpression, type), m_label(label), m_testExpression(std::move(test_expression)), m_whileBody(std::move(while_body)), m_finallyBody(std::move(finally_body)),
         m_elseBody(std::move(else_body))
     {
         if(!m_testExpression->getType().isCompatible(Types::fromKind(Types::Kind::_bool)))
@@ -1,18 +1,520 @@
 #include <linc/generator/Optimizer.hpp>
+#include <linc/System.hpp>
+#include <linc/Generator.hpp>
+#include <algorithm>
+#include <ranges>
 
 namespace linc
 {
+    Types::u64 Optimizer::s_inliningThreshold{Optimizer::defaultInliningThreshold};
+    thread_local std::unordered_map<Types::u64, std::unique_ptr<const BoundDeclaration>> Optimizer::s_functions;
+    thread_local std::optional<Optimizer::Frame> Optimizer::s_frame;
+    thread_local std::map<std::pair<Types::u64, Types::u64>, PrimitiveValue> Optimizer::s_constants;
+    thread_local Interpreter Optimizer::s_evaluator;
+    thread_local std::vector<Types::u64> Optimizer::s_inlining;
+    thread_local Types::u64 Optimizer::s_inlinedCount{0ul};
+
     std::unique_ptr<const BoundNode> Optimizer::optimizeNode(const BoundNode* node)
     {
-        if(auto expression = dynamic_cast<const BoundExpression*>(node))
-            return optimizeExpression(std::move(expression));
+        if(node->isExpression())
+            return optimizeExpression(static_cast<const BoundExpression*>(node));
 
-        else if(auto statement = dynamic_cast<const BoundStatement*>(node))
-            return optimizeStatement(std::move(statement));
+        else if(node->isStatement())
+            return optimizeStatement(static_cast<const BoundStatement*>(node));
         
-        else if(auto declaration = dynamic_cast<const BoundDeclaration*>(node))
-            return optimizeDeclaration(std::move(declaration));
+        else if(node->isDeclaration())
+            return optimizeDeclaration(static_cast<const BoundDeclaration*>(node));
 
         else throw LINC_EXCEPTION_INVALID_INPUT("Encountered unrecognized node while optimizing");
     }
-}
\ No newline at end of file
+
+    std::unique_ptr<const BoundExpression> Optimizer::optimizeFunctionCallExpression(const BoundFunctionCallExpression* expression)
+    {
+        std::vector<BoundFunctionCallExpression::Argument> arguments;
+        arguments.reserve(expression->getArguments().size());
+
+        for(const auto& argument: expression->getArguments())
+            arguments.push_back(BoundFunctionCallExpression::Argument{.name = argument.name, .value = optimizeExpression(argument.value.get())});
+
+        auto call = std::make_unique<const BoundFunctionCallExpression>(expression->getType(), expression->getName(), std::move(arguments),
+            expression->getIndex());
+
+        if(auto evaluated = evaluateFunctionCall(call.get()))
+            return evaluated;
+
+        else if(auto inlined = inlineFunctionCall(call.get()))
+            return inlined;
+
+        return call;
+    }
+
+    std::unique_ptr<const BoundExpression> Optimizer::inlineFunctionCall(const BoundFunctionCallExpression* expression)
+    {
+        if(!s_frame || s_inliningThreshold == 0ul || !expression->getIndex() || s_inlining.size() > s_maximumInliningDepth
+        || std::ranges::find(s_inlining, *expression->getIndex()) != s_inlining.end())
+            return nullptr;
+
+        auto find = s_functions.find(*expression->getIndex());
+        if(find == s_functions.end())
+            return nullptr;
+
+        // only functions declared globally are inlined, as nested ones may refer to the frames of the functions enclosing them
+        auto function = static_cast<const BoundFunctionDeclaration*>(find->second.get());
+        const auto& parameters = function->getArguments();
+
+        if(function->getDepth() != 1ul || parameters.size() != expression->getArguments().size()
+        || !(function->getBody()->getType() == expression->getType()))
+            return nullptr;
+
+        Substitution substitution{.calleeDepth = function->getDepth(), .callerDepth = s_frame->depth, .base = s_frame->size,
+            .prefix = Logger::format("__inlined$_", s_inlinedCount), .cost = 0ul};
+
+        auto body = substituteExpression(function->getBody(), substitution);
+        if(!body)
+            return nullptr;
+
+        ++s_inlinedCount;
+        s_frame->size += std::max<Types::u64>(function->getFrameSize(), parameters.size());
+
+        // the arguments are evaluated in order into the parameters, which are declared in the same slots as in a call
+        const auto constants = s_constants;
+        std::vector<std::unique_ptr<const BoundStatement>> statements;
+        statements.reserve(parameters.size());
+
+        for(std::size_t i{0ul}; i < parameters.size(); ++i)
+        {
+            auto parameter = std::make_unique<const BoundVariableDeclaration>(parameters[i]->getActualType(),
+                substitution.prefix + parameters[i]->getName(), std::make_optional(expression->getArguments()[i].value->clone()),
+                BoundVariableDeclaration::Slot{.depth = substitution.callerDepth, .index = substitution.base + parameters[i]->getSlot().index});
+
+            declareConstant(parameter.get(), *parameter->getDefaultValue());
+            statements.push_back(std::make_unique<const BoundDeclarationStatement>(std::move(parameter)));
+        }
+
+        s_inlining.push_back(function->getIndex());
+        auto tail = optimizeExpression(body.get());
+        s_inlining.pop_back();
+
+        s_constants = constants;
+        return eliminateDeadDeclarations(std::move(statements), std::move(tail));
+    }
+
+    std::unique_ptr<const BoundExpression> Optimizer::evaluateFunctionCall(const BoundFunctionCallExpression* expression)
+    {
+        const auto& type = expression->getType();
+        auto find = expression->getIndex()? s_functions.find(*expression->getIndex()): s_functions.end();
+
+        if(find == s_functions.end() || !static_cast<const BoundFunctionDeclaration*>(find->second.get())->isPure()
+        || type.kind != Types::type::Kind::Primitive || type.primitive == Types::Kind::_void || type.primitive == Types::Kind::invalid
+        || !std::ranges::all_of(expression->getArguments(), [](const auto& argument)
+            { return argument.value->getKind() == BoundNode::Kind::LiteralExpression; }))
+            return nullptr;
+
+        // errors the call would report or throw (e.g. dividing by zero, indexing out of bounds) are left to be reported
+        // when the program runs
+        struct Silence final
+        {
+            const Reporting::ReportSize count{Reporting::getReports().size()};
+            const bool silenced{Reporting::isSilenced()};
+
+            ~Silence()
+            {
+                Reporting::setSilenced(silenced);
+                Reporting::discardReports(count);
+            }
+        };
+
+        std::optional<Value> result;
+        bool reported{};
+
+        try
+        {
+            Silence silence;
+            Reporting::setSilenced(true);
+            result = s_evaluator.evaluateBounded(expression, s_evaluationSteps);
+            reported = Reporting::getReports().size() != silence.count;
+        }
+        catch(...)
+        {
+            return nullptr;
+        }
+
+        auto value = result && !reported? result->getIfPrimitive(): std::nullopt;
+        if(!value || value->getKind() == PrimitiveValue::Kind::Invalid || value->getKind() == PrimitiveValue::Kind::Void)
+            return nullptr;
+
+        return std::make_unique<const BoundLiteralExpression>(*value, type);
+    }
+
+    void Optimizer::registerDeclaration(const BoundDeclaration* declaration)
+    {
+        if(declaration->getKind() == BoundNode::Kind::FunctionDeclaration)
+        {
+            auto function = static_cast<const BoundFunctionDeclaration*>(declaration);
+            if(s_functions.try_emplace(function->getIndex(), function->clone()).second)
+                s_evaluator.evaluateDeclaration(function);
+        }
+        else s_evaluator.evaluateDeclaration(declaration);
+    }
+
+    void Optimizer::reset()
+    {
+        s_functions.clear();
+        s_constants.clear();
+        s_evaluator.reset();
+        s_inlinedCount = 0ul;
+    }
+
+    std::unique_ptr<const BoundExpression> Optimizer::foldConstantExpression(std::unique_ptr<const BoundExpression> expression)
+    {
+        // the operands are literals, so the interpreter never needs a frame or any steps to evaluate the expression, and
+        // operations that compiled code computes differently (such as a division by zero) are left to run time
+        auto result = s_evaluator.evaluateBounded(expression.get(), 0ul);
+        auto value = result? result->getIfPrimitive(): std::nullopt;
+
+        if(!value || value->getKind() == PrimitiveValue::Kind::Invalid || value->getKind() == PrimitiveValue::Kind::Void)
+            return expression;
+
+        return std::make_unique<const BoundLiteralExpression>(*value, expression->getType());
+    }
+
+    void Optimizer::declareConstant(const BoundVariableDeclaration* declaration, const BoundExpression* value)
+    {
+        const auto slot = std::pair{declaration->getSlot().depth, declaration->getSlot().index};
+        const auto& type = declaration->getActualType();
+
+        // pure functions may read the global constants whose declarations are initialized with literals
+        if(slot.first == 0ul && !type.isMutable && declaration->getDefaultValue()
+        && declaration->getDefaultValue().value()->getKind() == BoundNode::Kind::LiteralExpression)
+            s_evaluator.evaluateDeclaration(declaration);
+
+        if(!type.isMutable && type.kind == Types::type::Kind::Primitive && value && value->getKind() == BoundNode::Kind::LiteralExpression
+        && value->getType().kind == Types::type::Kind::Primitive && value->getType().primitive == type.primitive)
+            s_constants.insert_or_assign(slot, static_cast<const BoundLiteralExpression*>(value)->getValue());
+
+        // the slot may have been used by a variable of an earlier scope
+        else s_constants.erase(slot);
+    }
+
+    bool Optimizer::isPure(const BoundExpression* expression)
+    {
+        switch(expression->getKind())
+        {
+        case BoundNode::Kind::LiteralExpression:
+        case BoundNode::Kind::IdentifierExpression:
+        case BoundNode::Kind::TypeExpression:
+            return true;
+
+        case BoundNode::Kind::UnaryExpression:
+        {
+            auto unary_expression = static_cast<const BoundUnaryExpression*>(expression);
+            const auto kind = unary_expression->getOperator()->getKind();
+
+            return kind != BoundUnaryOperator::Kind::Increment && kind != BoundUnaryOperator::Kind::Decrement
+                && isPure(unary_expression->getOperand());
+        }
+        case BoundNode::Kind::BinaryExpression:
+        {
+            auto binary_expression = static_cast<const BoundBinaryExpression*>(expression);
+            switch(binary_expression->getOperator()->getKind())
+            {
+            case BoundBinaryOperator::Kind::Assignment:
+            case BoundBinaryOperator::Kind::AdditionAssignment:
+            case BoundBinaryOperator::Kind::SubtractionAssignment:
+            case BoundBinaryOperator::Kind::MultiplicationAssignment:
+            case BoundBinaryOperator::Kind::DivisionAssignment:
+            case BoundBinaryOperator::Kind::ModuloAssignment:
+                return false;
+
+            // dividing by zero reports an error
+            case BoundBinaryOperator::Kind::Division:
+            case BoundBinaryOperator::Kind::Modulo:
+                if(binary_expression->getRight()->getKind() != BoundNode::Kind::LiteralExpression)
+                    return false;
+                else if(auto right = static_cast<const BoundLiteralExpression*>(binary_expression->getRight())->getValue(); right.isZero())
+                    return false;
+                [[fallthrough]];
+            default: return isPure(binary_expression->getLeft()) && isPure(binary_expression->getRight());
+            }
+        }
+        case BoundNode::Kind::ConversionExpression:
+            return isPure(static_cast<const BoundConversionExpression*>(expression)->getExpression());
+
+        case BoundNode::Kind::IfExpression:
+        {
+            auto if_expression = static_cast<const BoundIfExpression*>(expression);
+            return isPure(if_expression->getTestExpression()) && isPure(if_expression->getIfBody())
+                && (!if_expression->getElseBody() || isPure(if_expression->getElseBody()));
+        }
+        case BoundNode::Kind::BlockExpression:
+        {
+            auto block_expression = static_cast<const BoundBlockExpression*>(expression);
+            for(const auto& statement: block_expression->getStatements())
+            {
+                if(statement->getKind() == BoundNode::Kind::ExpressionStatement)
+                {
+                    if(!isPure(static_cast<const BoundExpressionStatement*>(statement.get())->getExpression()))
+                        return false;
+                }
+                else if(statement->getKind() == BoundNode::Kind::DeclarationStatement)
+                {
+                    auto declaration = static_cast<const BoundDeclarationStatement*>(statement.get())->getDeclaration();
+                    if(declaration->getKind() != BoundNode::Kind::VariableDeclaration)
+                        return false;
+
+                    const auto& value = static_cast<const BoundVariableDeclaration*>(declaration)->getDefaultValue();
+                    if(value && !isPure(*value))
+                        return false;
+                }
+                else return false;
+            }
+
+            return !block_expression->getTail() || isPure(block_expression->getTail());
+        }
+        default: return false;
+        }
+    }
+
+    bool Optimizer::references(const BoundNode* node, const BoundVariableDeclaration::Slot& slot)
+    {
+        const auto references_any = [&slot](const std::vector<const BoundNode*>& nodes)
+        {
+            return std::ranges::any_of(nodes, [&slot](const BoundNode* child){ return references(child, slot); });
+        };
+
+        switch(node->getKind())
+        {
+        case BoundNode::Kind::LiteralExpression:
+        case BoundNode::Kind::TypeExpression:
+        case BoundNode::Kind::BreakStatement:
+        case BoundNode::Kind::ContinueStatement:
+            return false;
+
+        case BoundNode::Kind::IdentifierExpression:
+        {
+            const auto& identifier_slot = static_cast<const BoundIdentifierExpression*>(node)->getSlot();
+            return !identifier_slot || (identifier_slot->depth == slot.depth && identifier_slot->index == slot.index);
+        }
+        case BoundNode::Kind::BlockExpression:
+        {
+            auto tail = static_cast<const BoundBlockExpression*>(node)->getTail();
+            return references_any(node->getChildren()) || (tail && references(tail, slot));
+        }
+        case BoundNode::Kind::FunctionCallExpression:
+            return std::ranges::any_of(static_cast<const BoundFunctionCallExpression*>(node)->getArguments(),
+                [&slot](const auto& argument){ return references(argument.value.get(), slot); });
+
+        case BoundNode::Kind::ExternalCallExpression:
+            return std::ranges::any_of(static_cast<const BoundExternalCallExpression*>(node)->getArguments(),
+                [&slot](const auto& argument){ return references(argument.get(), slot); });
+
+        case BoundNode::Kind::ReturnStatement:
+        {
+            auto expression = static_cast<const BoundReturnStatement*>(node)->getExpression();
+            return expression && references(expression, slot);
+        }
+        case BoundNode::Kind::DeclarationStatement:
+            // nested functions may refer to the variables of the frames enclosing them
+            if(static_cast<const BoundDeclarationStatement*>(node)->getDeclaration()->getKind() != BoundNode::Kind::VariableDeclaration)
+                return true;
+            [[fallthrough]];
+        case BoundNode::Kind::VariableDeclaration:
+        case BoundNode::Kind::ExpressionStatement:
+        case BoundNode::Kind::UnaryExpression:
+        case BoundNode::Kind::BinaryExpression:
+        case BoundNode::Kind::ConversionExpression:
+        case BoundNode::Kind::IndexExpression:
+        case BoundNode::Kind::IfExpression:
+        case BoundNode::Kind::WhileExpression:
+            return references_any(node->getChildren());
+
+        default: return true;
+        }
+    }
+
+    std::unique_ptr<const BoundExpression> Optimizer::eliminateDeadDeclarations(std::vector<std::unique_ptr<const BoundStatement>> statements,
+        std::unique_ptr<const BoundExpression> tail)
+    {
+        // the statements are visited backwards, so that the variables only used by dead declarations are dead as well
+        std::vector<std::unique_ptr<const BoundStatement>> live_statements;
+        live_statements.reserve(statements.size());
+
+        for(auto& statement: statements | std::views::reverse)
+        {
+            if(statement->getKind() == BoundNode::Kind::DeclarationStatement)
+            {
+                auto declaration = static_cast<const BoundDeclarationStatement*>(statement.get())->getDeclaration();
+                if(declaration->getKind() == BoundNode::Kind::VariableDeclaration)
+                {
+                    auto variable = static_cast<const BoundVariableDeclaration*>(declaration);
+                    const auto& value = variable->getDefaultValue();
+
+                    if((!value || isPure(*value)) && !(tail && references(tail.get(), variable->getSlot()))
+                    && std::ranges::none_of(live_statements, [&](const auto& live){ return references(live.get(), variable->getSlot()); }))
+                        continue;
+                }
+            }
+
+            live_statements.push_back(std::move(statement));
+        }
+
+        std::ranges::reverse(live_statements);
+        return std::make_unique<const BoundBlockExpression>(std::move(live_statements), std::move(tail));
+    }
+
+    std::unique_ptr<const BoundExpression> Optimizer::substituteExpression(const BoundExpression* expression, Substitution& substitution)
+    {
+        if(++substitution.cost > s_inliningThreshold)
+            return nullptr;
+
+        switch(expression->getKind())
+        {
+        case BoundNode::Kind::LiteralExpression:
+        case BoundNode::Kind::TypeExpression:
+            return expression->clone();
+
+        case BoundNode::Kind::IdentifierExpression:
+        {
+            auto identifier = static_cast<const BoundIdentifierExpression*>(expression);
+            const auto& slot = identifier->getSlot();
+
+            if(!slot || slot->depth != substitution.calleeDepth)
+                return nullptr;
+
+            return std::make_unique<const BoundIdentifierExpression>(substitution.prefix + identifier->getValue(), identifier->getType(),
+                BoundIdentifierExpression::Slot{.depth = substitution.callerDepth, .index = substitution.base + slot->index});
+        }
+        case BoundNode::Kind::UnaryExpression:
+        {
+            auto unary_expression = static_cast<const BoundUnaryExpression*>(expression);
+            auto operand = substituteExpression(unary_expression->getOperand(), substitution);
+            return operand? std::make_unique<const BoundUnaryExpression>(unary_expression->getOperator()->clone(), std::move(operand)): nullptr;
+        }
+        case BoundNode::Kind::BinaryExpression:
+        {
+            auto binary_expression = static_cast<const BoundBinaryExpression*>(expression);
+            auto left = substituteExpression(binary_expression->getLeft(), substitution);
+            auto right = left? substituteExpression(binary_expression->getRight(), substitution): nullptr;
+
+            return right? std::make_unique<const BoundBinaryExpression>(binary_expression->getOperator()->clone(), std::move(left),
+                std::move(right)): nullptr;
+        }
+        case BoundNode::Kind::ConversionExpression:
+        {
+            auto conversion_expression = static_cast<const BoundConversionExpression*>(expression);
+            auto operand = substituteExpression(conversion_expression->getExpression(), substitution);
+
+            return operand? std::make_unique<const BoundConversionExpression>(std::move(operand),
+                conversion_expression->getConversion()->clone()): nullptr;
+        }
+        case BoundNode::Kind::IndexExpression:
+        {
+            auto index_expression = static_cast<const BoundIndexExpression*>(expression);
+            auto array = substituteExpression(index_expression->getArray(), substitution);
+            auto index = array? substituteExpression(index_expression->getIndex(), substitution): nullptr;
+
+            return index? std::make_unique<const BoundIndexExpression>(std::move(array), std::move(index), index_expression->getType()): nullptr;
+        }
+        case BoundNode::Kind::IfExpression:
+        {
+            auto if_expression = static_cast<const BoundIfExpression*>(expression);
+            auto test = substituteExpression(if_expression->getTestExpression(), substitution);
+            auto if_body = test? substituteExpression(if_expression->getIfBody(), substitution): nullptr;
+            
+            if(!if_body)
+                return nullptr;
+
+            std::unique_ptr<const BoundExpression> else_body;
+            if(if_expression->getElseBody() && !(else_body = substituteExpression(if_expression->getElseBody(), substitution)))
+                return nullptr;
+
+            return std::make_unique<const BoundIfExpression>(if_expression->getType(), std::move(test), std::move(if_body), std::move(else_body));
+        }
+        case BoundNode::Kind::BlockExpression:
+        {
+            auto block_expression = static_cast<const BoundBlockExpression*>(expression);
+            std::vector<std::unique_ptr<const BoundStatement>> statements;
+            statements.reserve(block_expression->getStatements().size());
+
+            for(const auto& statement: block_expression->getStatements())
+                if(auto substituted = substituteStatement(statement.get(), substitution))
+                    statements.push_back(std::move(substituted));
+                else return nullptr;
+
+            std::unique_ptr<const BoundExpression> tail;
+            if(block_expression->getTail() && !(tail = substituteExpression(block_expression->getTail(), substitution)))
+                return nullptr;
+
+            return std::make_unique<const BoundBlockExpression>(std::move(statements), std::move(tail));
+        }
+        case BoundNode::Kind::FunctionCallExpression:
+        {
+            // calls are made by name in compiled code, so the functions called by the body must be visible from any caller
+            auto call = static_cast<const BoundFunctionCallExpression*>(expression);
+            auto find = call->getIndex()? s_functions.find(*call->getIndex()): s_functions.end();
+
+            if(find == s_functions.end() || static_cast<const BoundFunctionDeclaration*>(find->second.get())->getDepth() != 1ul)
+                return nullptr;
+
+            std::vector<BoundFunctionCallExpression::Argument> arguments;
+            arguments.reserve(call->getArguments().size());
+
+            for(const auto& argument: call->getArguments())
+                if(auto value = substituteExpression(argument.value.get(), substitution))
+                    arguments.push_back(BoundFunctionCallExpression::Argument{.name = argument.name, .value = std::move(value)});
+                else return nullptr;
+
+            return std::make_unique<const BoundFunctionCallExpression>(call->getType(), call->getName(), std::move(arguments), call->getIndex());
+        }
+        case BoundNode::Kind::ExternalCallExpression:
+        {
+            auto call = static_cast<const BoundExternalCallExpression*>(expression);
+            std::vector<std::unique_ptr<const BoundExpression>> arguments;
+            arguments.reserve(call->getArguments().size());
+
+            for(const auto& argument: call->getArguments())
+                if(auto value = substituteExpression(argument.get(), substitution))
+                    arguments.push_back(std::move(value));
+                else return nullptr;
+
+            return std::make_unique<const BoundExternalCallExpression>(call->getType(), call->getName(), std::move(arguments));
+        }
+        default: return nullptr;
+        }
+    }
+
+    std::unique_ptr<const BoundStatement> Optimizer::substituteStatement(const BoundStatement* statement, Substitution& substitution)
+    {
+        if(++substitution.cost > s_inliningThreshold)
+            return nullptr;
+
+        switch(statement->getKind())
+        {
+        case BoundNode::Kind::ExpressionStatement:
+        {
+            auto expression = substituteExpression(static_cast<const BoundExpressionStatement*>(statement)->getExpression(), substitution);
+            return expression? std::make_unique<const BoundExpressionStatement>(std::move(expression)): nullptr;
+        }
+        case BoundNode::Kind::DeclarationStatement:
+        {
+            // functions and enumerations declared by the body would be scoped to it by name, so only variables are moved
+            auto declaration = static_cast<const BoundDeclarationStatement*>(statement)->getDeclaration();
+            if(declaration->getKind() != BoundNode::Kind::VariableDeclaration)
+                return nullptr;
+
+            auto variable = static_cast<const BoundVariableDeclaration*>(declaration);
+            if(variable->getSlot().depth != substitution.calleeDepth)
+                return nullptr;
+
+            std::optional<std::unique_ptr<const BoundExpression>> value;
+            if(variable->getDefaultValue() && !(value = substituteExpression(*variable->getDefaultValue(), substitution)).value())
+                return nullptr;
+
+            return std::make_unique<const BoundDeclarationStatement>(std::make_unique<const BoundVariableDeclaration>(variable->getActualType(),
+                substitution.prefix + variable->getName(), std::move(value),
+                BoundVariableDeclaration::Slot{.depth = substitution.callerDepth, .index = substitution.base + variable->getSlot().index}));
+        }
+        default: return nullptr;
+        }
+    }
+}
@@ -6,25 +6,25 @@ namespace linc
     Value ArrayValue::get(std::size_t index) const
     {
         if(m_isNested)
-            return m_array_array.at(index);
+            return m_array_array->at(index);
         
         switch(m_kind)
         {
         case Types::Kind::_void: return PrimitiveValue::voidValue; break;
-        case Types::Kind::_bool: return PrimitiveValue(m_array__bool.at(index)); break;
-        case Types::Kind::_char: return PrimitiveValue(m_array__char.at(index)); break;
-        case Types::Kind::u8: return PrimitiveValue(m_array_u8.at(index)); break;
-        case Types::Kind::u16: return PrimitiveValue(m_array_u16.at(index)); break;
-        case Types::Kind::u32: return PrimitiveValue(m_array_u32.at(index)); break;
-        case Types::Kind::u64: return PrimitiveValue(m_array_u64.at(index)); break;
-        case Types::Kind::i8: return PrimitiveValue(m_array_i8.at(index)); break;
-        case Types::Kind::i16: return PrimitiveValue(m_array_i16.at(index)); break;
-        case Types::Kind::i32: return PrimitiveValue(m_array_i32.at(index)); break;
-        case Types::Kind::i64: return PrimitiveValue(m_array_i64.at(index)); break;
-        case Types::Kind::f32: return PrimitiveValue(m_array_f32.at(index)); break;
-        case Types::Kind::f64: return PrimitiveValue(m_array_f64.at(index)); break;
-        case Types::Kind::string: return PrimitiveValue(m_array_string.at(index)); break;
-        case Types::Kind::type: return PrimitiveValue(m_array_type.at(index)); break;
+        case Types::Kind::_bool: return PrimitiveValue(m_array__bool->at(index)); break;
+        case Types::Kind::_char: return PrimitiveValue(m_array__char->at(index)); break;
+        case Types::Kind::u8: return PrimitiveValue(m_array_u8->at(index)); break;
+        case Types::Kind::u16: return PrimitiveValue(m_array_u16->at(index)); break;
+        case Types::Kind::u32: return PrimitiveValue(m_array_u32->at(index)); break;
+        case Types::Kind::u64: return PrimitiveValue(m_array_u64->at(index)); break;
+        case Types::Kind::i8: return PrimitiveValue(m_array_i8->at(index)); break;
+        case Types::Kind::i16: return PrimitiveValue(m_array_i16->at(index)); break;
+        case Types::Kind::i32: return PrimitiveValue(m_array_i32->at(index)); break;
+        case Types::Kind::i64: return PrimitiveValue(m_array_i64->at(index)); break;
+        case Types::Kind::f32: return PrimitiveValue(m_array_f32->at(index)); break;
+        case Types::Kind::f64: return PrimitiveValue(m_array_f64->at(index)); break;
+        case Types::Kind::string: return PrimitiveValue(m_array_string->at(index)); break;
+        case Types::Kind::type: return PrimitiveValue(m_array_type->at(index)); break;
         default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
         }
     }
@@ -33,27 +33,27 @@ namespace linc
     {
         if(m_isNested)
         {
-            m_array_array.at(index) = value.getArray();
+            m_array_array.mutate().at(index) = value.getArray();
             return;
         }
 
         switch(m_kind)
         {
-        case Types::Kind::_void: m_array__void.at(index) = value.getPrimitive().getVoid(); break;
-        case Types::Kind::_bool: m_array__bool.at(index) = value.getPrimitive().getBool(); break;
-        case Types::Kind::_char: m_array__char.at(index) = value.getPrimitive().getChar(); break;
-        case Types::Kind::u8: m_array_u8.at(index) = value.getPrimitive().getU8(); break;
-        case Types::Kind::u16: m_array_u16.at(index) = value.getPrimitive().getU16(); break;
-        case Types::Kind::u32: m_array_u32.at(index) = value.getPrimitive().getU32(); break;
-        case Types::Kind::u64: m_array_u64.at(index) = value.getPrimitive().getU64(); break;
-        case Types::Kind::i8: m_array_i8.at(index) = value.getPrimitive().getI8(); break;
-        case Types::Kind::i16: m_array_i16.at(index) = value.getPrimitive().getI16(); break;
-        case Types::Kind::i32: m_array_i32.at(index) = value.getPrimitive().getI32(); break;
-        case Types::Kind::i64: m_array_i64.at(index) = value.getPrimitive().getI64(); break;
-        case Types::Kind::f32: m_array_f32.at(index) = value.getPrimitive().getF32(); break;
-        case Types::Kind::f64: m_array_f64.at(index) = value.getPrimitive().getF64(); break;
-        case Types::Kind::string: m_array_string.at(index) = value.getPrimitive().getString(); break;
-        case Types::Kind::type: m_array_type.at(index) = value.getPrimitive().getType(); break;
+        case Types::Kind::_void: m_array__void.mutate().at(index) = value.getPrimitive().getVoid(); break;
+        case Types::Kind::_bool: m_array__bool.mutate().at(index) = value.getPrimitive().getBool(); break;
+        case Types::Kind::_char: m_array__char.mutate().at(index) = value.getPrimitive().getChar(); break;
+        case Types::Kind::u8: m_array_u8.mutate().at(index) = value.getPrimitive().getU8(); break;
+        case Types::Kind::u16: m_array_u16.mutate().at(index) = value.getPrimitive().getU16(); break;
+        case Types::Kind::u32: m_array_u32.mutate().at(index) = value.getPrimitive().getU32(); break;
+        case Types::Kind::u64: m_array_u64.mutate().at(index) = value.getPrimitive().getU64(); break;
+        case Types::Kind::i8: m_array_i8.mutate().at(index) = value.getPrimitive().getI8(); break;
+        case Types::Kind::i16: m_array_i16.mutate().at(index) = value.getPrimitive().getI16(); break;
+        case Types::Kind::i32: m_array_i32.mutate().at(index) = value.getPrimitive().getI32(); break;
+        case Types::Kind::i64: m_array_i64.mutate().at(index) = value.getPrimitive().getI64(); break;
+        case Types::Kind::f32: m_array_f32.mutate().at(index) = value.getPrimitive().getF32(); break;
+        case Types::Kind::f64: m_array_f64.mutate().at(index) = value.getPrimitive().getF64(); break;
+        case Types::Kind::string: m_array_string.mutate().at(index) = value.getPrimitive().getString(); break;
+        case Types::Kind::type: m_array_type.mutate().at(index) = value.getPrimitive().getType(); break;
         default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(m_kind);
         }
     }
@@ -62,7 +62,7 @@ namespace linc
     {
         if(m_isNested)
         {
-            m_array_array.push_back(value.getArray());
+            m_array_array.mutate().push_back(value.getArray());
             return;
         }
 
@@ -3,7 +3,7 @@
 
 namespace linc
 {
-    std::stack<Colors::Color> Colors::s_colorStack{};
+    thread_local std::stack<Colors::Color> Colors::s_colorStack{};
 
     std::string Colors::push(Color color)
     {
@@ -2,7 +2,7 @@
 
 namespace linc
 {
-    std::unordered_map<std::filesystem::path, std::fstream*> Files::s_fileMap;
+    thread_local std::unordered_map<std::filesystem::path, std::fstream*> Files::s_fileMap;
 
     std::string Files::toAbsolute(const std::string& filepath_string)
     {
@@ -2,8 +2,9 @@
 
 namespace linc
 {
-    Reporting::ReportList Reporting::s_reports = {};
-    Code::Source Reporting::s_source = {};
+    thread_local Reporting::ReportList Reporting::s_reports = {};
+    thread_local Code::Source Reporting::s_source = {};
+    thread_local bool Reporting::s_silenced = false;
     bool Reporting::s_spansEnabled = true;
 
 
@@ -26,7 +27,7 @@ namespace linc
     void Reporting::push(const Report& report, bool log)
     {
         s_reports.push_back(report);
-        if(log) [[likely]] 
+        if(log && !s_silenced) [[likely]] 
         {
             if(report.isInvalid() || !s_spansEnabled)
                 Logger::log(report.type, "$ $", stageToString(report.stage), report.message);
@@ -41,6 +42,12 @@ namespace linc
         s_reports.clear();
     }
 
+    void Reporting::discardReports(ReportSize count)
+    {
+        if(s_reports.size() > count)
+            s_reports.resize(count);
+    }
+
     bool Reporting::hasError()
     {
         for(const auto& report: s_reports)
@@ -1,4 +1,5 @@
 #include <linc/system/Types.hpp>
+#include <mutex>
 
 #define LINC_TYPE_MAP_PAIR(first, second) std::pair<std::string, linc::Types::Kind>(first, linc::Types::Kind::second)
 
@@ -133,6 +134,106 @@ namespace linc
         return result;
     }
 
+    namespace
+    {
+        /// @brief Owns the canonical type nodes. Children of canonical nodes are canonical themselves, so that identity
+        /// only needs to compare them by address.
+        /// @note The interner is process-wide and never frees a node on purpose: canonical pointers are held by bound
+        /// trees, values and declarations that outlive a single compilation (the REPL and lincenv keep them across
+        /// inputs), and since nodes are deduplicated structurally its size is bounded by the number of distinct types
+        /// seen, not by the number of compilations.
+        class TypeInterner final
+        {
+        public:
+            const Types::type* intern(const Types::type& type)
+            {
+                // Copying may itself intern the members of a structure that was made mutable after its construction.
+                Types::type copy(type);
+                std::lock_guard lock(m_mutex);
+
+                if(auto find = m_nodes.find(&copy); find != m_nodes.end())
+                    return *find;
+
+                const auto* node = &m_storage.emplace_back(std::move(copy));
+                m_nodes.insert(node);
+                return node;
+            }
+        private:
+            static inline void combine(std::size_t& seed, std::size_t value)
+            {
+                seed ^= value + 0x9e3779b97f4a7c15ul + (seed << 6ul) + (seed >> 2ul);
+            }
+
+            struct Hash final
+            {
+                std::size_t operator()(const Types::type* type) const
+                {
+                    std::size_t seed{static_cast<std::size_t>(type->kind) << 1ul | type->isMutable};
+
+                    switch(type->kind)
+                    {
+                    case Types::type::Kind::Primitive: combine(seed, static_cast<std::size_t>(type->primitive)); break;
+                    case Types::type::Kind::Array:
+                        combine(seed, std::hash<const Types::type*>{}(type->array.baseType));
+                        combine(seed, type->array.count.value_or(~0ul));
+                        break;
+                    case Types::type::Kind::Structure:
+                        for(const auto& member: type->structure)
+                        {
+                            combine(seed, std::hash<std::string>{}(member.first));
+                            combine(seed, std::hash<const Types::type*>{}(member.second));
+                        }
+                        break;
+                    case Types::type::Kind::Function:
+                        combine(seed, std::hash<const Types::type*>{}(type->function.returnType));
+                        for(const auto* argument: type->function.argumentTypes)
+                            combine(seed, std::hash<const Types::type*>{}(argument));
+                        break;
+                    case Types::type::Kind::Enumeration:
+                        for(const auto& enumerator: type->enumeration)
+                            combine(seed, std::hash<std::string>{}(enumerator.first));
+                        break;
+                    }
+
+                    return seed;
+                }
+            };
+
+            /// @brief Unlike Types::type::operator==, structure member names are part of the identity of a type.
+            struct Identical final
+            {
+                bool operator()(const Types::type* left, const Types::type* right) const
+                {
+                    if(left->kind != right->kind || left->isMutable != right->isMutable)
+                        return false;
+
+                    switch(left->kind)
+                    {
+                    case Types::type::Kind::Primitive: return left->primitive == right->primitive;
+                    case Types::type::Kind::Array: return left->array.baseType == right->array.baseType && left->array.count == right->array.count;
+                    case Types::type::Kind::Structure: return left->structure == right->structure;
+                    case Types::type::Kind::Function: return left->function.returnType == right->function.returnType
+                        && left->function.argumentTypes == right->function.argumentTypes;
+                    case Types::type::Kind::Enumeration: return left->enumeration == right->enumeration;
+                    default: throw LINC_EXCEPTION_OUT_OF_BOUNDS(left->kind);
+                    }
+                }
+            };
+
+            std::deque<Types::type> m_storage;
+            std::unordered_set<const Types::type*, Hash, Identical> m_nodes;
+
+            /// @brief Types are shared between threads compiling concurrently.
+            std::mutex m_mutex;
+        };
+    }
+
+    const Types::type* Types::type::intern() const
+    {
+        static TypeInterner interner;
+        return interner.intern(*this);
+    }
+
     auto Types::fromKind(Kind kind) -> type
     {
         return type(kind);
@@ -0,0 +1,149 @@
+#pragma once
+#include <linc/Include.hpp>
+#include <linc/lexer/Token.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/// @brief On-disk cache of the object files (and assembly) compiled from preprocessed token streams. Entries are keyed by a
+/// hash of the tokens, which include every file included transitively, and of the compiler configuration, so that an unchanged
+/// file is not compiled again. Safe to use from concurrent compilations.
+class BuildCache final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief What an entry records about the compilation it saved.
+    struct Entry final
+    {
+        bool hasMain;
+        Clock::duration compileTime;
+    };
+
+    BuildCache(std::filesystem::path directory, std::string_view configuration)
+        :m_directory(std::move(directory)), m_configuration(configuration)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+    }
+
+    /// @brief Identify the running compiler by a hash of its executable, which links linc_core statically, so that no object
+    /// compiled by another build of the compiler is reused, even one of the same version.
+    /// @return The hash of the executable, or std::nullopt if it cannot be read (and objects cannot be cached safely).
+    [[nodiscard]] static std::optional<std::string> getCompilerIdentity(const std::filesystem::path& executable)
+    {
+        std::ifstream file(executable, std::ios::binary);
+        if(!file)
+            return std::nullopt;
+
+        std::uint64_t hash{s_offsetBasis};
+        std::vector<char> buffer(1ul << 16ul);
+
+        while(file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || file.gcount() != 0)
+            combine(hash, std::string_view{buffer.data(), static_cast<std::size_t>(file.gcount())});
+
+        return std::to_string(hash);
+    }
+
+    /// @brief Get the key of the entry for a preprocessed token stream (64-bit FNV-1a over the tokens and the configuration).
+    [[nodiscard]] std::uint64_t getKey(const std::vector<linc::Token>& tokens) const
+    {
+        std::uint64_t hash{s_offsetBasis};
+        auto combine = [&](std::string_view bytes){ BuildCache::combine(hash, bytes); };
+
+        combine(m_configuration);
+        for(const auto& token: tokens)
+        {
+            const char header[]{static_cast<char>(token.type), static_cast<char>(token.value.has_value()),
+                static_cast<char>(token.numberBase? static_cast<unsigned char>(*token.numberBase) + 1u: 0u)};
+            combine(std::string_view{header, sizeof(header)});
+
+            if(token.value)
+            {
+                combine(*token.value);
+                combine(std::string_view{"\0", 1ul});
+            }
+        }
+
+        return hash;
+    }
+
+    /// @brief Copy the object file (and the assembly, if requested) of an entry to the specified paths, if there is such an entry.
+    std::optional<Entry> load(std::uint64_t key, const std::string& object, const std::optional<std::string>& assembly)
+    {
+        const auto path = getPath(key);
+        std::ifstream metadata(path.string() + ".entry");
+        bool has_main{};
+        std::int64_t nanoseconds{};
+
+        std::error_code error;
+        auto start = Clock::now();
+
+        if(!(metadata >> has_main >> nanoseconds)
+        || !std::filesystem::copy_file(path.string() + ".o", object, std::filesystem::copy_options::overwrite_existing, error)
+        || (assembly && !std::filesystem::copy_file(path.string() + ".asm", *assembly, std::filesystem::copy_options::overwrite_existing, error)))
+        {
+            ++m_misses;
+            return std::nullopt;
+        }
+
+        const Entry entry{.hasMain = has_main, .compileTime = std::chrono::nanoseconds(nanoseconds)};
+        ++m_hits;
+        m_saved += std::max(entry.compileTime - (Clock::now() - start), Clock::duration::zero()).count();
+        return entry;
+    }
+
+    /// @brief Record the object file (and the assembly) compiled for a key. Entries are complete once their metadata is written,
+    /// and every file is renamed into place, so that concurrent compilations of identical files do not read partial entries.
+    void store(std::uint64_t key, const std::string& object, const std::optional<std::string>& assembly, const Entry& entry)
+    {
+        const auto path = getPath(key);
+        const auto suffix = linc::Logger::format(".$.$", std::hash<std::thread::id>{}(std::this_thread::get_id()),
+            Clock::now().time_since_epoch().count());
+
+        auto place = [&](const std::string& source, const std::string& destination)
+        {
+            std::error_code error;
+            if(!std::filesystem::copy_file(source, destination + suffix, std::filesystem::copy_options::overwrite_existing, error))
+                return false;
+
+            std::filesystem::rename(destination + suffix, destination, error);
+            return !error;
+        };
+
+        if(!place(object, path.string() + ".o") || (assembly && !place(*assembly, path.string() + ".asm")))
+            return;
+
+        std::ofstream(path.string() + ".entry" + suffix) << entry.hasMain << ' '
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(entry.compileTime).count() << '\n';
+
+        std::error_code error;
+        std::filesystem::rename(path.string() + ".entry" + suffix, path.string() + ".entry", error);
+    }
+
+    [[nodiscard]] inline std::size_t getHits() const { return m_hits; }
+    [[nodiscard]] inline std::size_t getMisses() const { return m_misses; }
+    [[nodiscard]] inline Clock::duration getTimeSaved() const { return Clock::duration(m_saved.load()); }
+private:
+    static constexpr std::uint64_t s_offsetBasis{0xCBF29CE484222325ul}, s_prime{0x100000001B3ul};
+
+    static void combine(std::uint64_t& hash, std::string_view bytes)
+    {
+        for(auto byte: bytes)
+            hash = (hash ^ static_cast<unsigned char>(byte)) * s_prime;
+    }
+
+    [[nodiscard]] std::filesystem::path getPath(std::uint64_t key) const
+    {
+        std::string name(16ul, '0');
+        for(std::size_t i{0ul}; i < name.size(); ++i)
+            name[name.size() - i - 1ul] = "0123456789abcdef"[(key >> (4ul * i)) & 0xFul];
+
+        return m_directory / name;
+    }
+
+    const std::filesystem::path m_directory;
+    const std::string m_configuration;
+    std::atomic<std::size_t> m_hits{0ul}, m_misses{0ul};
+    std::atomic<Clock::rep> m_saved{0};
+};
@@ -16,6 +16,7 @@ extern "C"
     DWORD WINAPI GetLastError(void);
     DWORD WINAPI GetConsoleMode(HANDLE hConsoleHandle, LPDWORD lpMode);
     BOOL WINAPI SetConsoleMode(HANDLE hConsoleHandle, DWORD dwMode);
+    DWORD WINAPI GetModuleFileNameA(HANDLE hModule, char* lpFilename, DWORD nSize);
 }
 
 namespace linc
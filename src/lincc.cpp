@@ -7,7 +7,12 @@
 #include <linc/Binder.hpp>
 #include <linc/Generator.hpp>
 #include <linc/generator/Optimizer.hpp>
+#include <linc/generator/AssemblerAMD64.hpp>
 #include "Arguments.hpp"
+#include "BuildCache.hpp"
+#include <charconv>
+#include <thread>
+#include <atomic>
 #ifdef LINC_WINDOWS
 #include "Windows.hpp"
 #endif
@@ -30,6 +35,18 @@ static inline std::string getPath(std::string_view str)
     return std::filesystem::path(str).parent_path().string();
 }
 
+/// @brief Get the path of the running lincc executable.
+static std::filesystem::path getExecutablePath()
+{
+#ifdef LINC_WINDOWS
+    std::string path(4096ul, '\0');
+    path.resize(GetModuleFileNameA(nullptr, path.data(), static_cast<DWORD>(path.size())));
+    return path;
+#else
+    return "/proc/self/exe";
+#endif
+}
+
 static inline bool executableExists(std::string_view executable_name)
 {
     const static std::string path = []()
@@ -55,7 +72,7 @@ static inline bool executableExists(std::string_view executable_name)
     return false;
 }
 
-static auto compileCode(const std::string& raw_code, const std::string& filepath, std::vector<std::string> include_directories, bool optimization)
+static auto preprocessCode(const std::string& raw_code, const std::string& filepath, std::vector<std::string> include_directories)
 {
     auto code = linc::Code::toSource(raw_code, filepath);
 
@@ -64,8 +81,11 @@ static auto compileCode(const std::string& raw_code, const std::string& filepath
     auto tokens = lexer();
 
     linc::Preprocessor preprocessor(tokens, filepath);
-    auto processed_code = preprocessor();
+    return preprocessor();
+}
 
+static auto compileCode(const std::vector<linc::Token>& processed_code, const std::string& filepath, bool optimization)
+{
     linc::Parser parser;
     parser.set(processed_code, filepath);
     linc::Binder binder;
@@ -79,17 +99,100 @@ static auto compileCode(const std::string& raw_code, const std::string& filepath
         return linc::Generator::operator()(&bound_program, linc::Target{
             .architecture = linc::Target::Architecture::AMD64,
             .platform = linc::Target::Platform::Unix
-        });
+        }, optimization);
     else return std::pair<std::string, bool>({}, {});
 }
 
+/// @brief The result of compiling an input file to an object file, on whichever thread compiled it.
+struct CompilationUnit final
+{
+    std::string object;
+    bool hasMain{false}, isFailed{false};
+    std::exception_ptr exception;
+};
+
+static CompilationUnit compileFile(const std::string& file, const std::filesystem::path& stem, const std::vector<std::string>& include_directories,
+    bool optimization, bool external_assembler, BuildCache* cache)
+{
+    CompilationUnit unit;
+
+    try
+    {
+        // reports and include guards are kept per thread, and must not carry over from the previous file compiled on it
+        linc::Reporting::clearReports();
+        linc::Preprocessor::reset();
+
+        const auto filepath = stem / getFilename(file);
+        const auto assembly_file = linc::Logger::format("$.asm", filepath);
+        const auto processed_code = preprocessCode(linc::Files::read(file), linc::Files::toAbsolute(file), include_directories);
+        unit.object = linc::Logger::format("$.o", filepath);
+
+        std::optional<std::uint64_t> key;
+        if(cache && !linc::Reporting::hasError())
+        {
+            key = cache->getKey(processed_code);
+            if(auto entry = cache->load(*key, unit.object, external_assembler? std::optional{assembly_file}: std::nullopt))
+            {
+                unit.hasMain = entry->hasMain;
+                return unit;
+            }
+        }
+
+        const auto start = BuildCache::Clock::now();
+        auto [assembly, file_main] = compileCode(processed_code, linc::Files::toAbsolute(file), optimization);
+        unit.hasMain = file_main;
+
+        if(assembly.empty())
+        {
+            unit.isFailed = true;
+            return unit;
+        }
+
+        auto store = [&](bool has_assembly)
+        {
+            if(key)
+                cache->store(*key, unit.object, has_assembly? std::optional{assembly_file}: std::nullopt, BuildCache::Entry{
+                    .hasMain = file_main, .compileTime = BuildCache::Clock::now() - start
+                });
+        };
+
+        if(!external_assembler)
+        {
+            try
+            {
+                linc::Files::write(unit.object, linc::AssemblerAMD64::assemble(assembly).write());
+                store(false);
+                return unit;
+            }
+            catch(const linc::Exception& e)
+            {
+                if(!executableExists(LINC_ASSEMBLER))
+                    throw;
+
+                linc::Logger::log(linc::Logger::Type::Warning, "$; falling back to `$`.", e.info(), LINC_ASSEMBLER);
+            }
+        }
+
+        linc::Files::write(assembly_file, assembly);
+        if(std::system(linc::Logger::format("$ -felf64 $ -o $", LINC_ASSEMBLER, assembly_file, unit.object).c_str()) == 0)
+            store(true);
+    }
+    catch(...)
+    {
+        unit.exception = std::current_exception();
+    }
+
+    return unit;
+}
+
 int main(int argument_count, const char** arguments)
 try 
 {
 #ifdef LINC_WINDOWS
     linc::Windows::enableAnsi();
 #endif
-    const static auto option_include = 'i', option_output = 'o', option_version = 'v', option_optimization = 'O', option_compile_only = 'c', option_notice = 'C';
+    const static auto option_include = 'i', option_output = 'o', option_version = 'v', option_optimization = 'O', option_compile_only = 'c', option_notice = 'C',
+        option_assembly = 'S', option_jobs = 'j', option_no_cache = 'n', option_statistics = 's', option_inline_threshold = 't';
     constexpr const char* notice = 
         #include "notice"
     ;
@@ -102,6 +205,15 @@ try
         std::pair(option_optimization, Arguments::Option{.description = "Use optimization.", .flag = true}),
         std::pair(option_compile_only, Arguments::Option{.description = "Compile to object file(s) only; do not link.", .flag = true}),
         std::pair(option_notice, Arguments::Option{.description = "Display the legal notice.", .flag = true}),
+        std::pair(option_assembly, Arguments::Option{.description = "Write NASM assembly and assemble it with `nasm`, instead of "
+            "encoding object files in-process.", .flag = true}),
+        std::pair(option_jobs, Arguments::Option{.description = "Compile up to the specified number of files concurrently (0 for one per "
+            "hardware thread)."}),
+        std::pair(option_no_cache, Arguments::Option{.description = "Compile every file, instead of reusing the objects cached for unchanged "
+            "files in `.linccache`.", .flag = true}),
+        std::pair(option_statistics, Arguments::Option{.description = "Display build cache statistics.", .flag = true}),
+        std::pair(option_inline_threshold, Arguments::Option{.description = "Inline calls to functions with up to the specified number of "
+            "nodes in their body when optimizing (0 to disable inlining)."}),
     }, std::vector<std::pair<std::string, char>>{
         std::pair("--include", option_include),
         std::pair("--output", option_output),
@@ -109,6 +221,11 @@ try
         std::pair("--optimization", option_optimization),
         std::pair("--compile-only", option_compile_only),
         std::pair("--notice", option_notice),
+        std::pair("--assembly", option_assembly),
+        std::pair("--jobs", option_jobs),
+        std::pair("--no-cache", option_no_cache),
+        std::pair("--statistics", option_statistics),
+        std::pair("--inline-threshold", option_inline_threshold),
     });
 
     if(!linc::Reporting::getReports().empty())
@@ -123,7 +240,7 @@ try
         linc::Logger::log(linc::Logger::Type::Info, "Linc version $", LINC_VERSION);
         return LINC_EXIT_SUCCESS;
     }
-    else if(!executableExists(LINC_ASSEMBLER))
+    else if(!argument_handler.get(option_assembly).empty() && !executableExists(LINC_ASSEMBLER))
     {
         linc::Reporting::push(linc::Reporting::Report{
             .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
@@ -143,6 +260,7 @@ try
     auto files = argument_handler.getDefaults();
     auto output = argument_handler.get(option_output);
     auto optimization = !argument_handler.get(option_optimization).empty(); 
+    auto external_assembler = !argument_handler.get(option_assembly).empty();
 
     bool found_entry_point{false};
     std::string binary_filename;
@@ -166,11 +284,38 @@ try
         return LINC_EXIT_COMPILATION_FAILURE;
     }
 
-    std::vector<std::pair<std::string, bool>> code;
-    std::string linker_command{linc::Logger::format("LD_LIBRARY_PATH=$/lib $ ", LINC_INSTALL_PATH, LINC_LINKER)};
+    auto jobs_option = argument_handler.get(option_jobs);
+    std::size_t jobs{1ul};
 
-    for(const auto& file: files)
+    if(jobs_option.size() > 1ul || (!jobs_option.empty() && std::from_chars(jobs_option[0ul].data(),
+        jobs_option[0ul].data() + jobs_option[0ul].size(), jobs).ptr != jobs_option[0ul].data() + jobs_option[0ul].size()))
     {
+        linc::Reporting::push(linc::Reporting::Report{
+            .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
+            .message = "Expected a single, non-negative number of jobs."
+        });
+        return LINC_EXIT_COMPILATION_FAILURE;
+    }
+    else if(jobs == 0ul)
+        jobs = std::max(std::thread::hardware_concurrency(), 1u);
+
+    auto inline_threshold_option = argument_handler.get(option_inline_threshold);
+    std::size_t inline_threshold{linc::Optimizer::defaultInliningThreshold};
+
+    if(inline_threshold_option.size() > 1ul || (!inline_threshold_option.empty() && std::from_chars(inline_threshold_option[0ul].data(),
+        inline_threshold_option[0ul].data() + inline_threshold_option[0ul].size(), inline_threshold).ptr
+            != inline_threshold_option[0ul].data() + inline_threshold_option[0ul].size()))
+    {
+        linc::Reporting::push(linc::Reporting::Report{
+            .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
+            .message = "Expected a single, non-negative inlining threshold."
+        });
+        return LINC_EXIT_COMPILATION_FAILURE;
+    }
+
+    linc::Optimizer::setInliningThreshold(inline_threshold);
+
+    for(const auto& file: files)
         if(!linc::Files::exists(file))
         {
             linc::Reporting::push(linc::Reporting::Report{
@@ -179,33 +324,68 @@ try
             });
             return LINC_EXIT_COMPILATION_FAILURE;
         }
-        auto raw_code = linc::Files::read(file);
-        auto build_directory = getPath(binary_filename);
-        auto [assembly, file_main] = compileCode(raw_code, linc::Files::toAbsolute(file), argument_handler.get(option_include), optimization);
-        if(file_main)
+
+    auto build_directory = getPath(binary_filename);
+    auto stem = build_directory.empty()? std::filesystem::current_path(): std::filesystem::path(build_directory);
+    auto include_directories = argument_handler.get(option_include);
+
+    // cached objects are only valid for the compiler and the options that produced them
+    std::optional<BuildCache> cache;
+    if(argument_handler.get(option_no_cache).empty())
+        if(auto identity = BuildCache::getCompilerIdentity(getExecutablePath()))
+            cache.emplace(stem / ".linccache", linc::Logger::format("$ $ amd64-unix $ $ $", LINC_VERSION, *identity, optimization,
+                external_assembler, inline_threshold));
+
+    // files are compiled and assembled by the calling thread and up to `jobs - 1` workers, each taking the next file left
+    std::vector<CompilationUnit> units(files.size());
+    std::atomic<std::size_t> next_file{0ul};
+
+    auto compileFiles = [&]()
+    {
+        for(std::size_t index; (index = next_file++) < files.size();)
+            units[index] = compileFile(files[index], stem, include_directories, optimization, external_assembler,
+                cache? &*cache: nullptr);
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        for(std::size_t i{1ul}; i < std::min(jobs, files.size()); ++i)
+            workers.emplace_back(compileFiles);
+
+        compileFiles();
+    }
+
+    if(cache && !argument_handler.get(option_statistics).empty())
+        linc::Logger::log(linc::Logger::Type::Info, "Build cache: $ hit(s), $ miss(es), $ ms of compilation saved.", cache->getHits(),
+            cache->getMisses(), std::chrono::duration<double, std::milli>(cache->getTimeSaved()).count());
+
+    std::string linker_command{linc::Logger::format("LD_LIBRARY_PATH=$/lib $ ", LINC_INSTALL_PATH, LINC_LINKER)};
+
+    for(std::size_t i{0ul}; i < units.size(); ++i)
+    {
+        const auto& unit = units[i];
+        if(unit.exception)
+            std::rethrow_exception(unit.exception);
+
+        if(unit.hasMain)
         {
             if(found_entry_point)
             {
                 linc::Reporting::push(linc::Reporting::Report{
                     .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
-                    .message = linc::Logger::format("Redefinition of entry-point function main between different files.", file)
+                    .message = linc::Logger::format("Redefinition of entry-point function main between different files.", files[i])
                 });
                 return LINC_EXIT_COMPILATION_FAILURE;
             }
             else found_entry_point = true;
             
-            if(binary_filename.empty()) binary_filename = getFilename(file);
+            if(binary_filename.empty()) binary_filename = getFilename(files[i]);
         }
 
-        if(assembly.empty())
+        if(unit.isFailed)
             return LINC_EXIT_COMPILATION_FAILURE;
 
-        auto stem = build_directory.empty()? std::filesystem::current_path(): std::filesystem::path(build_directory);
-        auto filepath = stem / getFilename(file);
-
-        linc::Files::write(linc::Logger::format("$.asm", filepath), assembly);
-        std::system(linc::Logger::format("$ -felf64 $:#1.asm -o $.o", LINC_ASSEMBLER, filepath).c_str());
-        linc::Logger::append(linker_command, "$.o ", filepath);
+        linc::Logger::append(linker_command, "$ ", unit.object);
     }
 
     if(!argument_handler.get(option_compile_only).empty())
@@ -7,6 +7,7 @@
 #include <linc/Binder.hpp>
 #include <linc/Generator.hpp>
 #include "Arguments.hpp"
+#include <charconv>
 #ifdef LINC_WINDOWS
 #include "Windows.hpp"
 #endif
@@ -24,7 +25,7 @@
 #define LINC_EXCEPTION_WARNING "This is probaby not intended, please contact the developer of this software to fix it."
 #endif
 
-static int evaluateFile(std::string filepath, int argc, const char** argv, Arguments& argument_handler)
+static int evaluateFile(std::string filepath, int argc, const char** argv, Arguments& argument_handler, std::size_t memoization_capacity)
 {
     filepath = linc::Files::toAbsolute(filepath);
 
@@ -53,6 +54,9 @@ static int evaluateFile(std::string filepath, int argc, const char** argv, Argum
     auto program = parser();
     auto bound_program = binder.bindProgram(&program);
     bool errors{false};
+
+    if(!argument_handler.get('O').empty())
+        bound_program = linc::Optimizer::optimizeProgram(bound_program);
     
     for(const auto& report: linc::Reporting::getReports())
         if(report.type == linc::Reporting::Type::Error)
@@ -60,21 +64,65 @@ static int evaluateFile(std::string filepath, int argc, const char** argv, Argum
 
     if(!errors)
     {
-        linc::Interpreter interpreter;
-        std::vector<linc::NodeListClause<linc::Expression>::DelimitedNode> arguments;
-        for(int i{0}; i < argc; ++i)
-            arguments.push_back(linc::NodeListClause<linc::Expression>::DelimitedNode{
-                .delimiter = i == argc - 1? std::nullopt: std::make_optional(linc::Token{.type = linc::Token::Type::Comma}),
-                .node = std::make_unique<const linc::LiteralExpression>(linc::Token{
-                    .type = linc::Token::Type::StringLiteral,
-                    .value = argv[i]
-                })
+        auto argument_list = [&]()
+        {
+            std::vector<linc::NodeListClause<linc::Expression>::DelimitedNode> arguments;
+            for(int i{0}; i < argc; ++i)
+                arguments.push_back(linc::NodeListClause<linc::Expression>::DelimitedNode{
+                    .delimiter = i == argc - 1? std::nullopt: std::make_optional(linc::Token{.type = linc::Token::Type::Comma}),
+                    .node = std::make_unique<const linc::LiteralExpression>(linc::Token{
+                        .type = linc::Token::Type::StringLiteral,
+                        .value = argv[i]
+                    })
+                });
+
+            return std::make_unique<const linc::ArrayInitializerExpression>(
+                linc::Token{.type = linc::Token::Type::SquareLeft}, linc::Token{.type = linc::Token::Type::SquareRight}, 
+                std::make_unique<const linc::NodeListClause<linc::Expression>>(std::move(arguments), linc::Token::Info{})
+            );
+        };
+
+        const auto engines = argument_handler.get('E');
+        const auto engine = engines.empty()? std::string{"tree"}: engines.back();
+
+        if(engine == "vm" && memoization_capacity != 0ul)
+            linc::Reporting::push(linc::Reporting::Report{
+                .type = linc::Reporting::Type::Warning, .stage = linc::Reporting::Stage::Environment,
+                .message = "Memoization is only supported by the tree-walking interpreter, which is used instead."
             });
+        else if(engine == "vm")
+        {
+            linc::VirtualMachine virtual_machine;
+            
+            if(auto result = virtual_machine.evaluateProgram(&bound_program, binder, argument_list()))
+                return *result;
 
-        return interpreter.evaluateProgram(&bound_program, binder, std::make_unique<const linc::ArrayInitializerExpression>(
-            linc::Token{.type = linc::Token::Type::SquareLeft}, linc::Token{.type = linc::Token::Type::SquareRight}, 
-            std::make_unique<const linc::NodeListClause<linc::Expression>>(std::move(arguments), linc::Token::Info{})
-        ));
+            linc::Reporting::push(linc::Reporting::Report{
+                .type = linc::Reporting::Type::Warning, .stage = linc::Reporting::Stage::Environment,
+                .message = linc::Logger::format("Falling back to the tree-walking interpreter: $", virtual_machine.getUnsupportedReason())
+            });
+        }
+        else if(engine != "tree")
+        {
+            linc::Reporting::push(linc::Reporting::Report{
+                .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
+                .message = linc::Logger::format("Unknown engine `$`, expected `tree` or `vm`.", engine)
+            });
+            return LINC_EXIT_COMPILATION_FAILURE;
+        }
+
+        linc::Interpreter interpreter;
+        interpreter.setMemoizationCapacity(memoization_capacity);
+        const auto result = interpreter.evaluateProgram(&bound_program, binder, argument_list());
+
+        if(memoization_capacity != 0ul)
+        {
+            const auto& statistics = interpreter.getMemoizationStatistics();
+            linc::Logger::log(linc::Logger::Type::Info, "Memoization: $ hit(s) and $ miss(es) on calls to pure functions, $ result(s) evicted "
+                "(capacity of $).", statistics.hits, statistics.misses, statistics.evictions, memoization_capacity);
+        }
+
+        return result;
     }
     else return LINC_EXIT_COMPILATION_FAILURE;
 }
@@ -93,7 +141,8 @@ try
 #ifdef LINC_WINDOWS
     linc::Windows::enableAnsi();
 #endif
-    const static auto option_include = 'i', option_eval = 'e', option_version = 'v', option_optimization = 'O', option_notice = 'C';
+    const static auto option_include = 'i', option_eval = 'e', option_version = 'v', option_optimization = 'O', option_notice = 'C',
+        option_engine = 'E', option_inline_threshold = 't', option_memoize = 'M';
     constexpr const char* notice = 
         #include "notice"
     ;
@@ -104,12 +153,20 @@ try
         std::pair(option_version, Arguments::Option{.description = "Display the current Linc version in use.", .flag = true}),
         std::pair(option_optimization, Arguments::Option{.description = "Use optimization.", .flag = true}),
         std::pair(option_notice, Arguments::Option{.description = "Display the legal notice.", .flag = true}),
+        std::pair(option_engine, Arguments::Option{.description = "Select the execution engine for files: `tree` (default) or `vm`."}),
+        std::pair(option_inline_threshold, Arguments::Option{.description = "Inline calls to functions with up to the specified number of "
+            "nodes in their body when optimizing (0 to disable inlining)."}),
+        std::pair(option_memoize, Arguments::Option{.description = "Cache the results of calls to pure functions by their arguments, "
+            "keeping up to the specified number of most recently used results (tree-walking interpreter only)."}),
     }, std::vector<std::pair<std::string, char>>{
         std::pair("--include", option_include),
         std::pair("--eval", option_eval),
         std::pair("--version", option_version),
         std::pair("--optimization", option_optimization),
         std::pair("--notice", option_notice),
+        std::pair("--engine", option_engine),
+        std::pair("--inline-threshold", option_inline_threshold),
+        std::pair("--memoize", option_memoize),
     });
 
     if(!linc::Reporting::getReports().empty())
@@ -125,6 +182,36 @@ try
         return LINC_EXIT_SUCCESS;
     }
 
+    auto inline_threshold_option = argument_handler.get(option_inline_threshold);
+    std::size_t inline_threshold{linc::Optimizer::defaultInliningThreshold};
+
+    if(inline_threshold_option.size() > 1ul || (!inline_threshold_option.empty() && std::from_chars(inline_threshold_option[0ul].data(),
+        inline_threshold_option[0ul].data() + inline_threshold_option[0ul].size(), inline_threshold).ptr
+            != inline_threshold_option[0ul].data() + inline_threshold_option[0ul].size()))
+    {
+        linc::Reporting::push(linc::Reporting::Report{
+            .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
+            .message = "Expected a single, non-negative inlining threshold."
+        });
+        return LINC_EXIT_COMPILATION_FAILURE;
+    }
+
+    linc::Optimizer::setInliningThreshold(inline_threshold);
+
+    auto memoize_option = argument_handler.get(option_memoize);
+    std::size_t memoization_capacity{0ul};
+
+    if(memoize_option.size() > 1ul || (!memoize_option.empty() && std::from_chars(memoize_option[0ul].data(),
+        memoize_option[0ul].data() + memoize_option[0ul].size(), memoization_capacity).ptr
+            != memoize_option[0ul].data() + memoize_option[0ul].size()))
+    {
+        linc::Reporting::push(linc::Reporting::Report{
+            .type = linc::Reporting::Type::Error, .stage = linc::Reporting::Stage::Environment,
+            .message = "Expected a single, non-negative memoization capacity."
+        });
+        return LINC_EXIT_COMPILATION_FAILURE;
+    }
+
     auto files = argument_handler.getDefaults();
     auto evaluate_expressions = argument_handler.get(option_eval);
 
@@ -152,7 +239,7 @@ try
     }
 
     if(files.size() != 0ul)
-        return evaluateFile(files.at(0ul), argument_count, arguments, argument_handler);
+        return evaluateFile(files.at(0ul), argument_count, arguments, argument_handler, memoization_capacity);
 
     bool show_tree{false}, show_lexer{false}, optimization{!argument_handler.get(option_optimization).empty()};
 
@@ -161,6 +248,7 @@ try
     linc::Parser parser;
     
     bool success{true};
+    interpreter.setMemoizationCapacity(memoization_capacity);
 
     auto init = [&]()
     {
@@ -294,7 +382,7 @@ try
             _arguments[0ul] = arguments[0ul];
             _arguments[1ul] = filename.c_str();
 
-            evaluateFile(filename, 2ul, _arguments, argument_handler);
+            evaluateFile(filename, 2ul, _arguments, argument_handler, memoization_capacity);
             delete[] _arguments;
             continue;
         }
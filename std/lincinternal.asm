@@ -7,24 +7,53 @@
 %define SYS_EXIT 60
 %define STR_BUFFER_SIZE 1024
 
+; allocations of up to 4088 bytes take blocks of 32 << class bytes (header included) from per-class free lists, or else from a
+; region refilled with large mmaps; larger ones are mapped individually
+%define MEMORY_CLASS_COUNT 8
+%define MEMORY_MINIMUM_SHIFT 5
+%define MEMORY_REGION_SIZE 0x100000
+
 %define STDOUT 1
 %define STDIN 0
 
 section .bss
     __std_string_buffer: resb STR_BUFFER_SIZE
+    __memory_free_lists: resq MEMORY_CLASS_COUNT
+    __memory_region_next: resq 1
+    __memory_region_end: resq 1
 section .data
+    ; strings are preceded by a header of their capacity and their length (see __string_alloc)
+    dq 0, 4
     __std_true_literal db "true", 0
+    dq 0, 5
     __std_false_literal db "false", 0
+    ; the string and memory primitives jump through these, which select the best implementation for the processor on first use
+    __memory_copy_implementation dq __simd_resolve_memory_copy
+    __cstring_length_implementation dq __simd_resolve_cstring_length
+    __string_equals_implementation dq __simd_resolve_string_equals
 section .text
     global __memory_copy:function
+    global __memory_copy_scalar:function
+    global __memory_copy_sse2:function
+    global __memory_copy_avx2:function
     global __memory_alloc:function
     global __memory_free:function
 
     global __mod_f32:function
     global __mod_f64:function
 
+    global __string_alloc:function
     global __string_length:function
     global __string_equals:function
+    global __string_append:function
+    global __string_char_append:function
+    global __cstring_length:function
+    global __cstring_length_scalar:function
+    global __cstring_length_sse2:function
+    global __cstring_length_avx2:function
+    global __string_equals_scalar:function
+    global __string_equals_sse2:function
+    global __string_equals_avx2:function
     global __string_concat:function
     global __string_char_concat:function
     global __char_string_concat:function
@@ -48,17 +77,76 @@ section .text
     global sys_close:function
     global sys_exit:function
 
-__memory_copy:
-    test rdx, rdx
-    jz .done
-    mov rcx, rdx
-    rep movsb
+; __memory_alloc(u64): u64 - returns zeroed memory, preserving every register but rax
+__memory_alloc:
+    push rcx
+    push rdx
+    push rsi
+    push rdi
+    lea rcx, [rdi + 7] ; the block must hold the header: rcx = size + 8 - 1
+    xor edx, edx ; class 0 below the minimum block size
+    cmp rcx, (1 << MEMORY_MINIMUM_SHIFT)
+    jb .small
+    bsr rdx, rcx
+    sub rdx, MEMORY_MINIMUM_SHIFT - 1 ; rdx = log2(next power of two of size + 8) - MEMORY_MINIMUM_SHIFT
+    cmp rdx, MEMORY_CLASS_COUNT
+    jae .large
+.small:
+    lea rsi, [rel __memory_free_lists]
+    mov rax, [rsi + rdx * 8]
+    test rax, rax
+    jz .bump
+    mov rdi, [rax + 8] ; pop the free block, linked through [block + 8], the first quadword after its class header
+    mov [rsi + rdx * 8], rdi
+    mov [rax], rdx
+    lea rdi, [rax + 8]
+    mov rsi, rax
+    mov ecx, edx
+    mov eax, (1 << MEMORY_MINIMUM_SHIFT) / 8
+    shl rax, cl ; the block size in quadwords...
+    lea rcx, [rax - 1] ; ...minus the header
+    xor eax, eax
+    rep stosq ; freed blocks are zeroed when reused
+    lea rax, [rsi + 8]
+    jmp .done
+.bump:
+    mov ecx, edx
+    mov esi, (1 << MEMORY_MINIMUM_SHIFT)
+    shl rsi, cl ; rsi = block size
+    mov rax, [rel __memory_region_next]
+    lea rdi, [rax + rsi]
+    cmp rdi, [rel __memory_region_end]
+    ja .refill
+    mov [rel __memory_region_next], rdi
+    mov [rax], rdx ; fresh blocks are already zeroed by mmap
+    add rax, 8
+    jmp .done
+.refill:
+    mov rsi, MEMORY_REGION_SIZE ; the rest of the current region is left unused
+    call .map
+    mov [rel __memory_region_next], rax
+    add rax, MEMORY_REGION_SIZE
+    mov [rel __memory_region_end], rax
+    jmp .small
+.large:
+    lea rsi, [rdi + 8]
+    call .map
+    mov [rax], rsi ; large blocks record their mapped size instead of a class
+    add rax, 8
 .done:
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
     ret
-
-__memory_alloc:
-    add rdi, 8
-    mov rsi, rdi
+.map: ; maps rsi bytes, preserving every register but rax
+    push rdi
+    push rdx
+    push rcx
+    push r8
+    push r9
+    push r10
+    push r11
     xor rdi, rdi
     mov rdx, 3
     mov r10, 0x22
@@ -66,14 +154,31 @@ __memory_alloc:
     mov r9, 0
     mov rax, SYS_MMAP
     syscall
-
-    mov [rax], rsi
-    add rax, 8
+    pop r11
+    pop r10
+    pop r9
+    pop r8
+    pop rcx
+    pop rdx
+    pop rdi
     ret
 
+; __memory_free(u64): void
 __memory_free:
+    test rdi, rdi
+    jz .done
     sub rdi, 8
-    mov rsi, [rdi]
+    mov rax, [rdi]
+    cmp rax, MEMORY_CLASS_COUNT
+    jae .large
+    lea rdx, [rel __memory_free_lists]
+    mov rcx, [rdx + rax * 8] ; push the block to the free list of its class
+    mov [rdi + 8], rcx
+    mov [rdx + rax * 8], rdi
+.done:
+    ret
+.large:
+    mov rsi, rax
     mov rax, SYS_MUNMAP
     syscall
     ret
@@ -94,7 +199,162 @@ __mod_f64:
     subsd xmm0, xmm2
     ret
 
-__string_length:
+; the byte string and memory primitives below have scalar, SSE2 and AVX2 implementations: SSE2 is part of the x86-64 baseline, and
+; AVX2 is selected through CPUID when both the processor and the operating system (through XCR0) support it. Every vector load
+; is either aligned, or checked not to cross a page boundary, so no implementation reads from a page the string does not touch.
+; all of them preserve every general purpose register, but rax, rcx and the ones documented, and clobber xmm0-xmm2 (ymm0-ymm2)
+__memory_copy:
+    jmp [rel __memory_copy_implementation]
+
+; __cstring_length(bytes): u64 - the length of NUL-terminated bytes which carry no string header
+__cstring_length:
+    jmp [rel __cstring_length_implementation]
+
+; compares the characters of strings of the same length only
+__string_equals:
+    mov rax, [rdi - 8]
+    cmp rax, [rsi - 8]
+    jne .false
+    jmp [rel __string_equals_implementation]
+.false:
+    xor eax, eax
+    ret
+
+__simd_resolve_memory_copy:
+    call __simd_select
+    jmp [rel __memory_copy_implementation]
+
+__simd_resolve_cstring_length:
+    call __simd_select
+    jmp [rel __cstring_length_implementation]
+
+__simd_resolve_string_equals:
+    call __simd_select
+    jmp [rel __string_equals_implementation]
+
+; __simd_select() - points every primitive at its best implementation, preserving every register
+__simd_select:
+    push rax
+    push rbx
+    push rcx
+    push rdx
+    lea rax, [rel __memory_copy_sse2]
+    mov [rel __memory_copy_implementation], rax
+    lea rax, [rel __cstring_length_sse2]
+    mov [rel __cstring_length_implementation], rax
+    lea rax, [rel __string_equals_sse2]
+    mov [rel __string_equals_implementation], rax
+    mov eax, 1
+    cpuid
+    and ecx, 0x18000000 ; OSXSAVE and AVX
+    cmp ecx, 0x18000000
+    jne .done
+    xor ecx, ecx
+    xgetbv
+    and eax, 6 ; the operating system saves the xmm and ymm state
+    cmp eax, 6
+    jne .done
+    mov eax, 7
+    xor ecx, ecx
+    cpuid
+    test ebx, 0x20 ; AVX2
+    jz .done
+    lea rax, [rel __memory_copy_avx2]
+    mov [rel __memory_copy_implementation], rax
+    lea rax, [rel __cstring_length_avx2]
+    mov [rel __cstring_length_implementation], rax
+    lea rax, [rel __string_equals_avx2]
+    mov [rel __string_equals_implementation], rax
+.done:
+    pop rdx
+    pop rcx
+    pop rbx
+    pop rax
+    ret
+
+; __memory_copy(dest, source, count) - leaves rdi and rsi past the copied bytes, like rep movsb, and clobbers rdx
+__memory_copy_scalar:
+    test rdx, rdx
+    jz .done
+    mov rcx, rdx
+    rep movsb
+.done:
+    ret
+
+__memory_copy_sse2:
+    cmp rdx, 16
+    jb .small
+    cmp rdx, 4096 ; rep movsb is fastest for large copies on processors with enhanced rep movsb
+    jae __memory_copy_scalar
+    movdqu xmm1, [rsi + rdx - 16] ; the last 16 bytes, which the loop may only partially copy
+    sub rdx, 16
+    xor ecx, ecx
+.loop:
+    movdqu xmm0, [rsi + rcx]
+    movdqu [rdi + rcx], xmm0
+    add rcx, 16
+    cmp rcx, rdx
+    jb .loop
+    movdqu [rdi + rdx], xmm1
+    add rdx, 16
+    add rdi, rdx
+    add rsi, rdx
+    ret
+.small: ; copies of less than 16 bytes use two overlapping moves of the largest size that fits
+    cmp rdx, 8
+    jb .dword
+    mov rcx, [rsi]
+    mov [rdi], rcx
+    mov rcx, [rsi + rdx - 8]
+    mov [rdi + rdx - 8], rcx
+    jmp .advance
+.dword:
+    cmp rdx, 4
+    jb .byte
+    mov ecx, [rsi]
+    mov [rdi], ecx
+    mov ecx, [rsi + rdx - 4]
+    mov [rdi + rdx - 4], ecx
+    jmp .advance
+.byte:
+    test rdx, rdx
+    jz .done
+    mov cl, [rsi]
+    mov [rdi], cl
+    mov cl, [rsi + rdx - 1]
+    mov [rdi + rdx - 1], cl
+    cmp rdx, 2
+    jbe .advance
+    mov cl, [rsi + 1]
+    mov [rdi + 1], cl
+.advance:
+    add rdi, rdx
+    add rsi, rdx
+.done:
+    ret
+
+__memory_copy_avx2:
+    cmp rdx, 32
+    jb __memory_copy_sse2
+    cmp rdx, 4096
+    jae __memory_copy_scalar
+    vmovdqu ymm1, [rsi + rdx - 32]
+    sub rdx, 32
+    xor ecx, ecx
+.loop:
+    vmovdqu ymm0, [rsi + rcx]
+    vmovdqu [rdi + rcx], ymm0
+    add rcx, 32
+    cmp rcx, rdx
+    jb .loop
+    vmovdqu [rdi + rdx], ymm1
+    vzeroupper
+    add rdx, 32
+    add rdi, rdx
+    add rsi, rdx
+    ret
+
+__cstring_length_scalar:
     xor rax, rax
 .loop:
     mov cl, byte [rdi + rax]
@@ -104,7 +364,69 @@ __string_length:
     dec rax
     ret
 
-__string_equals:
+; loads the aligned blocks containing the string, ignoring the bytes of the first one which precede it
+__cstring_length_sse2:
+    push rdx
+    mov rax, rdi
+    and rax, -16
+    pxor xmm0, xmm0
+    movdqa xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1
+    mov ecx, edi
+    and ecx, 15
+    shr edx, cl
+    test edx, edx
+    jnz .first
+.loop:
+    add rax, 16
+    movdqa xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1
+    test edx, edx
+    jz .loop
+    bsf edx, edx
+    sub rax, rdi
+    add rax, rdx
+    pop rdx
+    ret
+.first:
+    bsf eax, edx
+    pop rdx
+    ret
+
+__cstring_length_avx2:
+    push rdx
+    mov rax, rdi
+    and rax, -32
+    vpxor xmm0, xmm0, xmm0
+    vpcmpeqb ymm1, ymm0, [rax]
+    vpmovmskb edx, ymm1
+    mov ecx, edi
+    and ecx, 31
+    shr edx, cl
+    test edx, edx
+    jnz .first
+.loop:
+    add rax, 32
+    vpcmpeqb ymm1, ymm0, [rax]
+    vpmovmskb edx, ymm1
+    test edx, edx
+    jz .loop
+    vzeroupper
+    bsf edx, edx
+    sub rax, rdi
+    add rax, rdx
+    pop rdx
+    ret
+.first:
+    vzeroupper
+    bsf eax, edx
+    pop rdx
+    ret
+
+; __string_equals_*(first, second): bool - compares NUL-terminated bytes, clobbering rdx, rdi and rsi
+__string_equals_scalar:
     cmp rdi, rsi
     je .true
 .loop:
@@ -126,92 +448,221 @@ __string_equals:
     mov rax, 0
     ret
 
+; compares unaligned blocks of both strings while neither crosses a page boundary, and single bytes otherwise
+__string_equals_sse2:
+    cmp rdi, rsi
+    je .true
+    pxor xmm0, xmm0
+.loop:
+    mov eax, edi
+    or eax, esi
+    and eax, 4095
+    cmp eax, 4096 - 16
+    ja .byte
+    movdqu xmm1, [rdi]
+    movdqu xmm2, [rsi]
+    pcmpeqb xmm2, xmm1 ; the equal bytes
+    pcmpeqb xmm1, xmm0 ; the end of the first string
+    pmovmskb eax, xmm2
+    pmovmskb edx, xmm1
+    xor eax, 0xFFFF
+    or eax, edx
+    jnz .end
+    add rdi, 16
+    add rsi, 16
+    jmp .loop
+.end: ; the strings are equal if they first differ at the end of the first one
+    bsf eax, eax
+    movzx edx, byte [rdi + rax]
+    cmp dl, byte [rsi + rax]
+    jne .false
+.true:
+    mov rax, -1
+    ret
+.byte:
+    movzx eax, byte [rdi]
+    cmp al, byte [rsi]
+    jne .false
+    test al, al
+    jz .true
+    inc rdi
+    inc rsi
+    jmp .loop
+.false:
+    xor eax, eax
+    ret
+
+__string_equals_avx2:
+    cmp rdi, rsi
+    je .true
+    vpxor xmm0, xmm0, xmm0
+.loop:
+    mov eax, edi
+    or eax, esi
+    and eax, 4095
+    cmp eax, 4096 - 32
+    ja .byte
+    vmovdqu ymm1, [rdi]
+    vpcmpeqb ymm2, ymm1, [rsi]
+    vpcmpeqb ymm1, ymm1, ymm0
+    vpmovmskb eax, ymm2
+    vpmovmskb edx, ymm1
+    not eax
+    or eax, edx
+    jnz .end
+    add rdi, 32
+    add rsi, 32
+    jmp .loop
+.end:
+    vzeroupper
+    bsf eax, eax
+    movzx edx, byte [rdi + rax]
+    cmp dl, byte [rsi + rax]
+    jne .false
+.true:
+    vzeroupper
+    mov rax, -1
+    ret
+.byte:
+    movzx eax, byte [rdi]
+    cmp al, byte [rsi]
+    jne .false
+    test al, al
+    jz .true
+    inc rdi
+    inc rsi
+    jmp .loop
+.false:
+    vzeroupper
+    xor eax, eax
+    ret
+
+; strings point to their characters, which are NUL-terminated and preceded by a header of their capacity ([string - 16]) and
+; their length ([string - 8]). strings with a capacity were built by __string_append for a single variable, and may be appended
+; to in place up to it; the generated code clears the capacity of the string of a variable whenever it is copied elsewhere, so
+; strings with no capacity (like literals) may be shared, and are never modified
+
+; __string_alloc(u64): string - a zeroed string of the given length with no capacity, preserving every register but rax
+__string_alloc:
+    push rdi
+    add rdi, 17 ; the header and the terminator
+    call __memory_alloc
+    pop rdi
+    mov [rax + 8], rdi
+    add rax, 16
+    ret
+
+; __string_length(string): u64
+__string_length:
+    mov rax, [rdi - 8]
+    ret
+
 __string_concat:
-    push rbx ; caller saved registers that are in use
+    push rbx
     push r12
-    push r13
-    push r14
-    call __string_length ; length of the first string (arg 0)
     mov rbx, rdi ; rbx = arg 0
-    mov rdi, rsi ; dest = arg 1
-    mov r13, rsi ; r13 = arg 1
-    mov r14, rax ; r11 = strlen(arg 0)
-    call __string_length ; length of the second string (arg 1)
-    mov r12, rax ; r12 = strlen(arg 1)
-    add rax, r14 ; rax = strlen(arg 1) + strlen(arg 2)
-    inc rax ; rax = strlen(arg 1) + strlen(arg 2) + 1
-    mov rdi, rax ; dest = rax (memory to allocate)
-    call __memory_alloc ; allocate the memory
+    mov r12, rsi ; r12 = arg 1
+    mov rdi, [rbx - 8]
+    add rdi, [r12 - 8] ; rdi = length(arg 0) + length(arg 1)
+    call __string_alloc
     push rax
-    mov rdi, rax ; dest = the new address
+    mov rdi, rax ; dest = the new string
     mov rsi, rbx ; source = arg 0
-    mov rdx, r14 ; count = strlen(arg 0)
+    mov rdx, [rbx - 8] ; count = length(arg 0)
     call __memory_copy ; first copy
-    mov byte [rdi], 'a'
-    mov rsi, r13 ; source = arg 1
-    mov rdx, r12 ; count = strlen(arg 1)
-    call __memory_copy ; second copy
+    mov rsi, r12 ; source = arg 1
+    mov rdx, [r12 - 8] ; count = length(arg 1)
+    call __memory_copy ; second copy, followed by the zeroed terminator
     pop rax
-    pop r14
-    pop r13 ; restore caller saved registers
     pop r12
     pop rbx
     ret
 
+; characters are concatenated as strings of a single character on the stack
 __string_char_concat:
-    call __string_length
-    push rax
-    push rdi
     push rsi
-    mov rdi, rax
-    inc rdi
-    call __memory_alloc
-    pop r8
-    pop rsi
-    pop rdx
-    mov rdi, rax
-    call __memory_copy
-    mov byte [rdi], r8b
+    push 1
+    push 0
+    lea rsi, [rsp + 16]
+    call __string_concat
+    add rsp, 24
     ret
 
 __char_string_concat:
-    mov rdx, rdi
-    mov rdi, rsi
-    call __string_length
-    mov rsi, rdx
-    push rax
     push rdi
-    push rsi
-    mov rdi, rax
-    inc rdi
-    call __memory_alloc
-    pop rcx
-    mov byte [rax], cl
-    inc rax
-    pop rsi
-    pop rdx
-    mov rdi, rax
-    call __memory_copy
-    dec rax
+    push 1
+    push 0
+    lea rdi, [rsp + 16]
+    call __string_concat
+    add rsp, 24
     ret
 
 __char_concat:
     push rdi
-    push rsi
-    mov rdi, 3
-    call __memory_alloc
-    pop rsi
+    mov rdi, 2
+    call __string_alloc
     pop rdi
     mov byte [rax], dil
     mov byte [rax + 1], sil
-    ret 
+    ret
+
+; __string_append(string, string): string - appends in place if the first string has the capacity, or else copies both strings
+; into a new one with twice the capacity needed (the first one is not freed, as an operand read earlier may still refer to it)
+__string_append:
+    mov rax, [rdi - 8]
+    mov rdx, [rsi - 8]
+    lea rcx, [rax + rdx]
+    cmp rcx, [rdi - 16]
+    ja .grow
+    mov [rdi - 8], rcx
+    push rdi
+    add rdi, rax
+    call __memory_copy
+    mov byte [rdi], 0
+    pop rax
+    ret
+.grow:
+    push rbx
+    push r12
+    push r13
+    mov rbx, rdi ; rbx = arg 0
+    mov r12, rsi ; r12 = arg 1
+    mov r13, rcx ; r13 = the length of the result
+    lea rdi, [rcx * 2 + 16 + 17] ; the capacity, the header and the terminator
+    call __memory_alloc
+    lea rcx, [r13 * 2 + 16]
+    mov [rax], rcx
+    mov [rax + 8], r13
+    add rax, 16
+    push rax
+    mov rdi, rax
+    mov rsi, rbx
+    mov rdx, [rbx - 8]
+    call __memory_copy
+    mov rsi, r12
+    mov rdx, [r12 - 8]
+    call __memory_copy
+    pop rax
+    pop r13
+    pop r12
+    pop rbx
+    ret
+
+__string_char_append:
+    push rsi
+    push 1
+    push 0
+    lea rsi, [rsp + 16]
+    call __string_append
+    add rsp, 24
+    ret
 
 __signed_to_string:
     push rdi; save rdi - number
     call __count_digits_signed; count the digits of the number
     push rax; save count
-    lea rdi, [rax + 1]; allocation = digit count + 1 (for nul termination)
-    call __memory_alloc; __memory_alloc(__count_digits_signed(rdi) + 1)
+    mov rdi, rax; length = digit count
+    call __string_alloc; __string_alloc(__count_digits_signed(rdi))
     xor r8b, r8b; clear negative flag
     pop rcx; restore count
     pop rdi; restore rdi - number
@@ -248,8 +699,8 @@ __unsigned_to_string:
     push rdi; save rdi - number
     call __count_digits_unsigned; count the digits of the number
     push rax; save count
-    lea rdi, [rax + 1]; vvv
-    call __memory_alloc; __memory_alloc(__count_digits_unsigned(rdi) + 1)
+    mov rdi, rax; length = digit count
+    call __string_alloc; __string_alloc(__count_digits_unsigned(rdi))
     pop rcx; restore count
     pop rdi; restore rdi - number
     test rdi, rdi; number test cases
@@ -275,10 +726,10 @@ __unsigned_to_string:
 
 __char_to_string:
     push rdi
-    mov rdi, 2
-    call __memory_alloc
+    mov rdi, 1
+    call __string_alloc
     pop rdi
-    mov qword [rax], rdi
+    mov byte [rax], dil
     ret
 
 __bool_to_string:
@@ -301,12 +752,7 @@ putc:
 
 ; puts(string): void
 puts:
-    xor rdx, rdx
-.loop:
-    inc rdx
-    mov cl, [rdi + rdx]
-    cmp cl, 0
-    jnz .loop
+    mov rdx, [rdi - 8]
     mov rsi, rdi
     mov rax, SYS_WRITE
     mov rdi, STDOUT
@@ -394,7 +840,7 @@ readraw:
     sub rsi, rax
     mov rdi, rsi
     mov r11, rsi
-    call __memory_alloc
+    call __string_alloc
     mov rdx, r11
     mov rdi, rax
     lea rsi, [rel __std_string_buffer]
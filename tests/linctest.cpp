@@ -6,6 +6,15 @@
 #include <linc/BoundTree.hpp> 
 #include <linc/Binder.hpp>
 #include <linc/Generator.hpp>
+#include <linc/generator/AssemblerAMD64.hpp>
+#include <linc/generator/PeepholeOptimizerAMD64.hpp>
+#ifndef LINC_WINDOWS
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/// @brief Exit code of a test that could not run in this environment (see SKIP_RETURN_CODE in testing.cmake).
+static constexpr int s_skipped{77};
 
 [[nodiscard]] static std::unique_ptr<const linc::BoundExpression> const evaluate_expression(const std::string& expression_raw)
 {
@@ -65,9 +74,532 @@
 
 }
 
+/// @brief Lex, preprocess, parse and bind a complete program.
+[[nodiscard]] static linc::BoundProgram bind_program(linc::Binder& binder, const std::string& program_raw)
+{
+    const auto test_path = "testing";
+    auto code = linc::Code::toSource(program_raw, test_path);
+    linc::Lexer lexer(code, true);
+    linc::Preprocessor preprocessor(lexer(), test_path);
+    linc::Parser parser;
+    parser.set(preprocessor(), test_path);
+
+    auto program = parser();
+    return binder.bindProgram(&program);
+}
+
+/// @brief The argument list passed to main(), which is empty for every test program.
+[[nodiscard]] static std::unique_ptr<const linc::ArrayInitializerExpression> empty_argument_list()
+{
+    return std::make_unique<const linc::ArrayInitializerExpression>(
+        linc::Token{.type = linc::Token::Type::SquareLeft}, linc::Token{.type = linc::Token::Type::SquareRight},
+        std::make_unique<const linc::NodeListClause<linc::Expression>>(
+            std::vector<linc::NodeListClause<linc::Expression>::DelimitedNode>{}, linc::Token::Info{})
+    );
+}
+
+/// @return Whether a node, or any node beneath it, calls a function declared by the program.
+[[nodiscard]] static bool contains_call(const linc::BoundNode* node)
+{
+    if(node->getKind() == linc::BoundNode::Kind::FunctionCallExpression)
+        return true;
+
+    else if(node->getKind() == linc::BoundNode::Kind::BlockExpression)
+        if(auto tail = static_cast<const linc::BoundBlockExpression*>(node)->getTail(); tail && contains_call(tail))
+            return true;
+
+    return std::ranges::any_of(node->getChildren(), contains_call);
+}
+
+/// @return The number of statements in the blocks of a node, including the blocks nested within them.
+[[nodiscard]] static std::size_t count_statements(const linc::BoundNode* node)
+{
+    std::size_t count{0ul};
+
+    if(node->getKind() == linc::BoundNode::Kind::BlockExpression)
+    {
+        auto block = static_cast<const linc::BoundBlockExpression*>(node);
+        count = block->getStatements().size() + (block->getTail()? count_statements(block->getTail()): 0ul);
+    }
+
+    for(auto child: node->getChildren())
+        count += count_statements(child);
+
+    return count;
+}
+
+/// @return The body of the function main() of a program, or nullptr if it declares no such function.
+[[nodiscard]] static const linc::BoundExpression* find_main(const linc::BoundProgram& program)
+{
+    for(const auto& declaration: program.declarations)
+        if(declaration->getKind() == linc::BoundNode::Kind::FunctionDeclaration
+        && static_cast<const linc::BoundFunctionDeclaration*>(declaration.get())->getName() == "main")
+            return static_cast<const linc::BoundFunctionDeclaration*>(declaration.get())->getBody();
+
+    return nullptr;
+}
+
+/// @brief Compare the exit code of a run of a test program with the expected one.
+[[nodiscard]] static bool check_exit_code(std::string_view run, int exit_code, int expected_exit_code)
+{
+    if(exit_code == expected_exit_code)
+        return true;
+
+    linc::Logger::println("[TEST] Exit code comparison failed! The program exited with '$' when $ ('$' was expected).",
+        exit_code, run, expected_exit_code);
+    return false;
+}
+
+/// @brief Run a program with both engines of lincenv: the tree-walking interpreter and the virtual machine. When the
+/// virtual machine is expected to fall back, the program must be rejected by it instead of being run.
+[[nodiscard]] static bool run_engines(const std::string& program_raw, int expected_exit_code, bool fallback)
+{
+    linc::Binder binder;
+    auto program = bind_program(binder, program_raw);
+
+    if(linc::Reporting::hasError())
+    {
+        linc::Logger::println("[TEST] Binding the program failed.");
+        return false;
+    }
+
+    linc::Interpreter interpreter;
+    if(!check_exit_code("interpreted", interpreter.evaluateProgram(&program, binder, empty_argument_list()), expected_exit_code))
+        return false;
+
+    linc::VirtualMachine virtual_machine;
+    auto exit_code = virtual_machine.evaluateProgram(&program, binder, empty_argument_list());
+
+    if(fallback && exit_code)
+    {
+        linc::Logger::println("[TEST] Fallback check failed! The virtual machine ran the program instead of rejecting it.");
+        return false;
+    }
+    else if(!fallback && !exit_code)
+    {
+        linc::Logger::println("[TEST] Engine check failed! The virtual machine rejected the program: $.",
+            virtual_machine.getUnsupportedReason());
+        return false;
+    }
+
+    return fallback || check_exit_code("run by the virtual machine", *exit_code, expected_exit_code);
+}
+
+/// @brief Interpret a program before and after optimizing it with inlining disabled, so that only the calls folded to
+/// constants disappear from main().
+/// @param folded Whether main() must be left without any calls after optimization.
+[[nodiscard]] static bool run_folding(const std::string& program_raw, int expected_exit_code, bool folded)
+{
+    linc::Binder binder;
+    auto program = bind_program(binder, program_raw);
+
+    if(linc::Reporting::hasError())
+    {
+        linc::Logger::println("[TEST] Binding the program failed.");
+        return false;
+    }
+
+    linc::Interpreter interpreter;
+    if(!check_exit_code("interpreted", interpreter.evaluateProgram(&program, binder, empty_argument_list()), expected_exit_code))
+        return false;
+
+    linc::Optimizer::setInliningThreshold(0ul);
+    auto optimized_program = linc::Optimizer::optimizeProgram(program);
+    auto main = find_main(optimized_program);
+
+    if(!main)
+    {
+        linc::Logger::println("[TEST] The optimized program declares no main() function.");
+        return false;
+    }
+    else if(linc::Reporting::isSilenced())
+    {
+        linc::Logger::println("[TEST] Optimizing the program left the reports silenced.");
+        return false;
+    }
+    else if(contains_call(main) == folded)
+    {
+        linc::Logger::println(folded? "[TEST] Folding check failed! The optimized main() still calls a function.":
+            "[TEST] Folding check failed! The optimized main() no longer calls any function.");
+        return false;
+    }
+
+    linc::Interpreter optimized_interpreter;
+    return check_exit_code("interpreted after optimization",
+        optimized_interpreter.evaluateProgram(&optimized_program, binder, empty_argument_list()), expected_exit_code);
+}
+
+/// @brief Interpret a program before and after optimizing it.
+/// @param statements The number of statements expected to be left in main() after optimization, if any.
+[[nodiscard]] static bool run_optimized(const std::string& program_raw, int expected_exit_code, std::optional<std::size_t> statements)
+{
+    linc::Binder binder;
+    auto program = bind_program(binder, program_raw);
+
+    if(linc::Reporting::hasError())
+    {
+        linc::Logger::println("[TEST] Binding the program failed.");
+        return false;
+    }
+
+    linc::Interpreter interpreter;
+    if(!check_exit_code("interpreted", interpreter.evaluateProgram(&program, binder, empty_argument_list()), expected_exit_code))
+        return false;
+
+    auto optimized_program = linc::Optimizer::optimizeProgram(program);
+    auto main = find_main(optimized_program);
+
+    if(!main)
+    {
+        linc::Logger::println("[TEST] The optimized program declares no main() function.");
+        return false;
+    }
+    else if(statements && count_statements(main) != *statements)
+    {
+        linc::Logger::println("[TEST] Statement count check failed! The optimized main() has $ statement(s) ($ were expected).",
+            count_statements(main), *statements);
+        return false;
+    }
+
+    linc::Interpreter optimized_interpreter;
+    return check_exit_code("interpreted after optimization",
+        optimized_interpreter.evaluateProgram(&optimized_program, binder, empty_argument_list()), expected_exit_code);
+}
+
+/// @brief Interpret a program with a memoization cache of the given capacity and compare how the calls to pure functions
+/// were served by it.
+[[nodiscard]] static bool run_memoized(const std::string& program_raw, int expected_exit_code, std::size_t capacity,
+    linc::Types::u64 hits, linc::Types::u64 misses)
+{
+    linc::Binder binder;
+    auto program = bind_program(binder, program_raw);
+
+    if(linc::Reporting::hasError())
+    {
+        linc::Logger::println("[TEST] Binding the program failed.");
+        return false;
+    }
+
+    linc::Interpreter interpreter;
+    interpreter.setMemoizationCapacity(capacity);
+
+    if(!check_exit_code("interpreted", interpreter.evaluateProgram(&program, binder, empty_argument_list()), expected_exit_code))
+        return false;
+
+    const auto& statistics = interpreter.getMemoizationStatistics();
+
+    if(statistics.hits != hits || statistics.misses != misses)
+    {
+        linc::Logger::println("[TEST] Memoization check failed! The cache had $ hit(s) and $ miss(es) ($ and $ were expected).",
+            statistics.hits, statistics.misses, hits, misses);
+        return false;
+    }
+
+    return true;
+}
+
+/// @brief Compile a program to an executable with the AMD64 backend and run it, with and without optimization.
+/// The runtime is assembled with `nasm` and the executables are linked with `ld`, the test being skipped without them.
+[[nodiscard]] static int run_compiled(const std::string& program_raw, int expected_exit_code)
+{
+#ifdef LINC_WINDOWS
+    linc::Logger::println("[TEST] Compiled programs are only tested on Unix platforms.");
+    return s_skipped;
+#else
+    if(std::system("command -v nasm >/dev/null 2>&1 && command -v ld >/dev/null 2>&1") != 0)
+    {
+        linc::Logger::println("[TEST] `nasm` or `ld` not found in PATH; skipping the test.");
+        return s_skipped;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / linc::Logger::format("linctest_$", getpid());
+    const auto runtime = (directory / "runtime.o").string();
+    std::filesystem::create_directories(directory);
+
+    auto compile_and_run = [&](std::string_view name, bool optimization) -> std::optional<int>
+    {
+        linc::Binder binder;
+        auto program = bind_program(binder, program_raw);
+
+        if(optimization)
+            program = linc::Optimizer::optimizeProgram(program);
+
+        const linc::Target target{.architecture = linc::Target::Architecture::AMD64, .platform = linc::Target::Platform::Unix};
+        auto [assembly, has_main] = linc::Generator::operator()(&program, target, optimization);
+
+        if(linc::Reporting::hasError() || !has_main)
+            return std::nullopt;
+
+        const auto stem = (directory / name).string();
+        linc::Files::write(stem + ".o", linc::AssemblerAMD64::assemble(assembly).write());
+
+        if(std::system(linc::Logger::format("ld -o $ $.o $", stem, stem, runtime).c_str()) != 0)
+            return std::nullopt;
+
+        const auto status = std::system(stem.c_str());
+        return WIFEXITED(status)? std::make_optional(WEXITSTATUS(status)): std::nullopt;
+    };
+
+    bool succeeded = std::system(linc::Logger::format("nasm -felf64 $ -o $", LINC_TEST_RUNTIME, runtime).c_str()) == 0;
+
+    if(!succeeded)
+        linc::Logger::println("[TEST] Failed to assemble the runtime.");
+
+    // calls are only folded, not inlined, without an inlining threshold, while the arguments of inlined calls are
+    // propagated into the inlined body
+    for(auto [name, optimization, threshold]: {std::tuple{"unoptimized", false, 0ul}, std::tuple{"optimized", true, 0ul},
+        std::tuple{"inlined", true, linc::Optimizer::defaultInliningThreshold}})
+    {
+        if(!succeeded)
+            break;
+
+        linc::Optimizer::setInliningThreshold(threshold);
+        auto exit_code = compile_and_run(name, optimization);
+
+        if(!exit_code)
+        {
+            linc::Logger::println("[TEST] Building or running the $ executable failed.", name);
+            succeeded = false;
+        }
+        else succeeded = check_exit_code(linc::Logger::format("compiled $", name), *exit_code, expected_exit_code & 0xff);
+    }
+
+    std::filesystem::remove_all(directory);
+    return succeeded? EXIT_SUCCESS: EXIT_FAILURE;
+#endif
+}
+
+/// @brief Run the peephole optimizer over an instruction sequence that one of its rules rewrites, and compare the result
+/// with the sequence it is expected to produce.
+/// @param rule_name The name of the rule (see PeepholeOptimizerAMD64::getRuleName()).
+[[nodiscard]] static bool run_peephole(std::string_view rule_name)
+{
+    using Emitter = linc::EmitterAMD64;
+    using Peephole = linc::PeepholeOptimizerAMD64;
+    using Binary = Emitter::BinaryInstruction;
+    using Unary = Emitter::UnaryInstruction;
+    using Nullary = Emitter::NullaryInstruction;
+
+    struct Case final
+    {
+        Peephole::Rule rule;
+        std::function<void(Emitter&)> input, expected;
+        std::size_t removed;
+    };
+
+    const std::array cases{
+        Case{.rule = Peephole::Rule::SelfMove, .input = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Move, "rax", "rax");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.nullary(Nullary::Return);
+        }, .removed = 1ul},
+        Case{.rule = Peephole::Rule::PushPop, .input = [](Emitter& emitter)
+        {
+            emitter.push("rax");
+            emitter.pop("rcx");
+            emitter.push("rdx");
+            emitter.pop("rdx");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Move, "rcx", "rax");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 3ul},
+        Case{.rule = Peephole::Rule::StackAdjustment, .input = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Subtract, "rsp", "8");
+            emitter.binary(Binary::Subtract, "rsp", "16");
+            emitter.binary(Binary::Add, "rsp", "0");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Subtract, "rsp", "24");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 2ul},
+        Case{.rule = Peephole::Rule::StoreForwarding, .input = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Move, "qword [rbp - 8]", "rax");
+            emitter.binary(Binary::Move, "rcx", "qword [rbp - 8]");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.binary(Binary::Move, "qword [rbp - 8]", "rax");
+            emitter.binary(Binary::Move, "rcx", "rax");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 0ul},
+        Case{.rule = Peephole::Rule::ConditionalChain, .input = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.label("f");
+            emitter.binary(Binary::Compare, "rax", "rcx");
+            emitter.unary(Unary::SetIfLess, "al");
+            emitter.test("al");
+            emitter.unary(Unary::JumpIfZero, "f");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.label("f");
+            emitter.binary(Binary::Compare, "rax", "rcx");
+            emitter.unary(Unary::SetIfLess, "al");
+            emitter.unary(Unary::JumpIfGreaterEqual, "f");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 1ul},
+        Case{.rule = Peephole::Rule::JumpThreading, .input = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.global("g");
+            emitter.label("f");
+            emitter.unary(Unary::JumpIfZero, "first");
+            emitter.nullary(Nullary::Return);
+            emitter.label("first");
+            emitter.unary(Unary::Jump, "g");
+            emitter.label("g");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.global("g");
+            emitter.label("f");
+            emitter.unary(Unary::JumpIfZero, "g");
+            emitter.nullary(Nullary::Return);
+            emitter.label("g");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 1ul},
+        Case{.rule = Peephole::Rule::UnreachableCode, .input = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.global("g");
+            emitter.label("f");
+            emitter.nullary(Nullary::Return);
+            emitter.binary(Binary::Move, "rax", "1");
+            emitter.binary(Binary::Add, "rax", "rcx");
+            emitter.label("g");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.global("g");
+            emitter.label("f");
+            emitter.nullary(Nullary::Return);
+            emitter.label("g");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 2ul},
+        Case{.rule = Peephole::Rule::DeadLabel, .input = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.label("f");
+            emitter.label("unused");
+            emitter.nullary(Nullary::Return);
+        }, .expected = [](Emitter& emitter)
+        {
+            emitter.global("f");
+            emitter.label("f");
+            emitter.nullary(Nullary::Return);
+        }, .removed = 1ul}
+    };
+
+    auto find = std::ranges::find_if(cases, [&](const auto& test_case){ return Peephole::getRuleName(test_case.rule) == rule_name; });
+
+    if(find == cases.end())
+    {
+        linc::Logger::println("[TEST] Unknown peephole rule '$'.", rule_name);
+        return false;
+    }
+
+    Emitter input, expected;
+    find->input(input);
+    find->expected(expected);
+
+    Peephole peephole(input);
+    peephole.run();
+
+    const auto& statistic = peephole.getStatistics()[static_cast<std::size_t>(find->rule)];
+
+    if(input.getCodeSegment() != expected.getCodeSegment())
+    {
+        linc::Logger::println("[TEST] Peephole check failed! The rewritten code is:\n$\nwhile this was expected:\n$",
+            input.getCodeSegment(), expected.getCodeSegment());
+        return false;
+    }
+    else if(statistic.applied == 0ul || statistic.removed != find->removed)
+    {
+        linc::Logger::println("[TEST] Peephole statistics check failed! The rule removed $ instruction(s) in $ rewrite(s) ($ were "
+            "expected to be removed).", statistic.removed, statistic.applied, find->removed);
+        return false;
+    }
+
+    return true;
+}
+
+/// @brief Run a test program in the given mode.
+/// @param mode One of `--engines` (the interpreter and the virtual machine exit with the given code), `--fallback` (the
+/// interpreter exits with the given code and the virtual machine rejects the program), `--folded` or `--unfolded` (the
+/// program exits with the given code before and after optimization, which leaves main() without or with calls),
+/// `--optimized` (likewise, leaving main() with the number of statements given as a parameter, if any), `--inlining` (the
+/// program exits with the given code when optimized with inlining disabled and at the default threshold), `--memoized`
+/// (the program exits with the given code when interpreted with the cache capacity given as the first parameter, the
+/// cache having the numbers of hits and misses given as the next two parameters) and `--compiled`
+/// (the compiled program exits with the given code, modulo 256, with and without optimization).
+/// @param parameters The arguments of the test following the expected exit code.
+/// @return The exit code of the test.
+[[nodiscard]] static int run_program(std::string_view mode, const std::string& program_raw, int expected_exit_code,
+    const std::vector<std::string>& parameters)
+{
+    auto result = [](bool succeeded){ return succeeded? EXIT_SUCCESS: EXIT_FAILURE; };
+
+    if(mode == "--engines" || mode == "--fallback")
+        return result(run_engines(program_raw, expected_exit_code, mode == "--fallback"));
+
+    else if(mode == "--folded" || mode == "--unfolded")
+        return result(run_folding(program_raw, expected_exit_code, mode == "--folded"));
+
+    else if(mode == "--optimized")
+        return result(run_optimized(program_raw, expected_exit_code,
+            parameters.empty()? std::nullopt: std::make_optional(std::stoul(parameters.front()))));
+
+    else if(mode == "--inlining")
+        return result(std::ranges::all_of(std::array{0ul, linc::Optimizer::defaultInliningThreshold}, [&](auto threshold)
+        {
+            linc::Optimizer::setInliningThreshold(threshold);
+            return run_optimized(program_raw, expected_exit_code, std::nullopt);
+        }));
+
+    else if(mode == "--memoized" && parameters.size() == 3ul)
+        return result(run_memoized(program_raw, expected_exit_code, std::stoul(parameters[0ul]), std::stoul(parameters[1ul]),
+            std::stoul(parameters[2ul])));
+
+    else if(mode == "--compiled")
+        return run_compiled(program_raw, expected_exit_code);
+
+    linc::Logger::println("[TEST] Unknown test mode '$'.", mode);
+    return EXIT_FAILURE;
+}
+
 int main(int argument_count, char** arguments)
 try {
-    if(argument_count != 4ul)
+    if(argument_count == 3 && std::string_view(arguments[1ul]) == "--peephole")
+    {
+        if(!run_peephole(arguments[2ul]))
+            return EXIT_FAILURE;
+
+        linc::Logger::println("[TEST] Test succeeded.");
+        return EXIT_SUCCESS;
+    }
+    else if(argument_count >= 4 && std::string_view(arguments[1ul]).starts_with("--"))
+    {
+        const auto status = run_program(arguments[1ul], arguments[2ul], std::stoi(arguments[3ul]),
+            std::vector<std::string>(arguments + 4ul, arguments + argument_count));
+
+        if(status == EXIT_SUCCESS)
+            linc::Logger::println("[TEST] Test succeeded.");
+
+        return status;
+    }
+    else if(argument_count != 4ul)
     {
         linc::Logger::println("[TEST] Incorrect number of arguments given to test.");
         return EXIT_FAILURE;
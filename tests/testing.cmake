@@ -1,5 +1,6 @@
 add_executable(linctest ${CMAKE_CURRENT_SOURCE_DIR}/tests/linctest.cpp)
 target_link_libraries(linctest linc_core)
+target_compile_definitions(linctest PRIVATE LINC_TEST_RUNTIME="${CMAKE_CURRENT_SOURCE_DIR}/std/lincinternal.asm")
 
 include(CTest)
 enable_testing()
@@ -10,6 +11,13 @@ macro(linc_test arg1 arg2 type)
     math(EXPR index "${index}+1")
 endmacro()
 
+set(program_index 0)
+macro(linc_program_test mode program exit_code)
+    add_test(PROGRAM_TEST_${program_index} ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --${mode} ${program} ${exit_code} ${ARGN})
+    set_tests_properties(PROGRAM_TEST_${program_index} PROPERTIES SKIP_RETURN_CODE 77)
+    math(EXPR program_index "${program_index}+1")
+endmacro()
+
 linc_test("1i8 + 1i8" "2i8" "i8")
 linc_test("1i16 + 1i16" "2i16" "i16")
 linc_test("1i32 + 1i32" "2i32" "i32")
@@ -162,3 +170,87 @@ linc_test("21845i16 ^ 43690i16" "-1i16" "i16")
 linc_test("1431655765i32 ^ 2863311530i32" "-1i32" "i32")
 linc_test("6148914691236517205i64 ^ 12297829382473034410i64" "-1i64" "i64")
 
+
+linc_test("{ x := 2\; { y := x * 3\; y + x } }" "8" "i32")
+linc_test("{ x := 2\; { x := 5\; x }\; x }" "2" "i32")
+linc_test("{ total: mut i32 = 0\; for(i: mut i32 = 0 i < 4 ++i\;) { j := i * 2\; total = total + j\; }\; total + 0 }" "12" "i32")
+linc_test("{ fn add(a: i32, b: i32): i32 { c := a + b\; c }\; add(2, 3) + add(4, 5) }" "14" "i32")
+linc_test("{ fn outer(a: i32): i32 { fn inner(b: i32): i32 { b * 10 }\; inner(a) + a }\; outer(3) }" "33" "i32")
+
+linc_test("{ fn f(n: i32): i32 { for(i: mut i32 = 0 i < 10 ++i\;) { if i == n { return i * 2\; }\; }\; -1 }\; f(3) + f(20) }" "5" "i32")
+linc_test("{ hits: mut i32 = 0\; ~outer for(i: mut i32 = 0 i < 4 ++i\;) { for(j: mut i32 = 0 j < 4 ++j\;) { if j == 2 { continue outer\; }\; ++hits\; }\; }\; hits + 0 }" "8" "i32")
+linc_test("{ n: mut i32 = 0\; ~outer while n < 10 { while true { n += 3\; break outer\; }\; n += 100\; }\; n + 0 }" "3" "i32")
+linc_test("{ n: mut i32 = 0\; while n < 10 { ++n\; if n % 2 == 0 { continue\; }\; n += 10\; }\; n + 0 }" "11" "i32")
+
+linc_test("{ a: mut i32[4u64] = [1, 2, 3, 4]\; a[2u64] += 10\; ++a[0u64]\; a[0u64] + a[2u64] }" "15" "i32")
+linc_test("{ m: mut i32[2u64][2u64] = [[1, 2], [3, 4]]\; i: mut u64 = 0u64\; m[1u64][++i - 1u64] *= 5\; m[1u64][0u64] + as i32 (i + 0u64) }" "16" "i32")
+linc_test("{ struct S { n: mut u64 v: mut u8[3u64] }\; s: mut S = S{.n = 1u64, .v = [1u8, 2u8, 3u8]}\; ++s.v[s.n]\; s.v[1u64] + 0u8 }" "3u8" "u8")
+
+linc_test("{ x: mut i32[3u64] = [1, 2, 3]\; y := x\; x[0u64] = 9\; y[0u64] + x[0u64] }" "10" "i32")
+linc_test("{ s := \"abc\"\; t: mut string = s\; t[0u64] = 'z'\; s + t }" "\"abczbc\"" "string")
+linc_test("{ struct P { a: mut i32 b: i32 }\; p: mut P = P{.a = 1, .b = 2}\; q := p\; p.a = 5\; q.a + p.a }" "6" "i32")
+linc_test("{ a: mut i32[3u64] = [1, 2, 3]\; total: mut i32 = 0\; for(v in a) { a[2u64] = 100\; total = total + v\; }\; total + a[2u64] }" "106" "i32")
+
+linc_test("{ n: mut i32 = 0\; x := ++n + ++n * 10\; x * 100 + n }" "2102" "i32")
+
+linc_program_test(engines "fn fibonacci(count: u64): u64 { first: mut u64 = 0u64\; second: mut u64 = 1u64\; for(i: mut u64 = 0u64 i < count ++i\;) { first = first + second\; second = first - second\; }\; first } fn main(): i32 as i32 (fibonacci(12u64))" 144)
+linc_program_test(engines "fn step(value: i32, index: i32): i32 { if index % 2 == 0 { return value - index\; }\; value * 2 - 7 } fn main(): i32 { total: mut i32 = 1\; for(i: mut i32 = 0 i < 6 ++i\;) { total = step(total, i)\; }\; total }" -57)
+linc_program_test(engines "count: mut i32 = 0 fn main(): i32 { i: mut i32 = 0\; while i < 100 { ++i\; if i % 3 == 0 { continue\; }\; if i > 50 { break\; }\; ++count\; }\; count }" 34)
+linc_program_test(engines "fn main(): i32 { word := \"engine\"\; total: mut i32 = 0\; for(i: mut u64 = 0u64 i < +word ++i\;) { total += match word[i] { 'e' => 1, 'n' => 10, 'g' => 100 }\; }\; total }" 122)
+linc_program_test(engines "tape: mut u8[2u64] fn widen(x: u8): i32 as i32 (x) fn main(): i32 { text := \"a-b-c\"\; i: mut u64 = 0u64\; n: mut i32 = 0\; while i + 1u64 < +text { if text[++i] == '-' { --tape[0u64]\; ++n\; }\; }\; n * 1000 + widen(tape[0u64]) }" 2254)
+linc_program_test(engines "fn widen(x: i8): i32 as i32 (x) fn main(): i32 { values: mut i8[3u64] = [-3i8, 5i8, -7i8]\; total: mut i32 = 0\; for(i: mut u64 = 0u64 i < 3u64 ++i\;) { values[i] *= 2i8\; if values[i] <= -6i8 { total += 1\; } else if values[i] != 10i8 { total += 100\; }\; }\; total * 100 + widen(values[2u64]) }" 186)
+linc_program_test(engines "fn done(x: f64, steps: i32): i32 if x >= 4.0d { steps } else { 0 } fn main(): i32 { x: mut f64 = 0.5d\; steps: mut i32 = 0\; while x < 4.0d { x = x * 2.0d\; ++steps\; }\; done(x, steps) }" 3)
+linc_program_test(fallback "fn main(): i32 { fn twice(x: i32): i32 x * 2\; twice(21) }" 42)
+linc_program_test(fallback "fn main(): i32 { base := 40\; fn add(x: i32): i32 base + x\; add(2) }" 42)
+
+linc_program_test(folded "fn square(x: i32): i32 x * x fn main(): i32 square(7) - 9" 40)
+linc_program_test(folded "fn sum(n: u64): u64 { total: mut u64 = 0u64\; for(i: mut u64 = 0u64 i < n ++i\;) { total += i\; }\; total } fn main(): i32 as i32 (sum(10u64))" 45)
+linc_program_test(unfolded "fn main(): i32 { base := 40\; fn add(x: i32): i32 base + x\; add(2) }" 42)
+linc_program_test(unfolded "offset: mut i32 = 3 fn shifted(x: i32): i32 x + offset fn main(): i32 { offset = 5\; shifted(1) }" 6)
+linc_program_test(unfolded "fn quiet(x: i32): i32 { puts(\"\")\; x } fn main(): i32 quiet(9)" 9)
+linc_program_test(unfolded "fn spin(n: u64): u64 { i: mut u64 = 0u64\; while i < n { ++i\; }\; i } fn main(): i32 as i32 (spin(100000u64) % 256u64)" 160)
+linc_program_test(unfolded "fn divide(x: i32, y: i32): i32 x / y fn main(): i32 { flag: mut bool = false\; if flag { divide(1, 0) } else { 7 } }" 7)
+linc_program_test(unfolded "fn divs(x: i32, y: i32): i32 x / y + x % y * 1000 fn main(): i32 divs(-47, 5) + 2100" 5091)
+linc_program_test(unfolded "fn shift(x: u32, n: u8): u32 x << n fn main(): i32 as i32 (shift(1u, 33u8))" 0)
+linc_program_test(unfolded "fn pick(i: u64): i32 { a: i32[3u64] = [1, 2, 3]\; a[i] } fn main(): i32 { flag: mut bool = false\; if flag { pick(5u64) } else { 7 } }" 7)
+linc_program_test(unfolded "fn first(s: string): char s[0u64] fn main(): i32 { flag: mut bool = false\; if flag { as i32 (first(\"\")) } else { 7 } }" 7)
+linc_program_test(compiled "fn divs(x: i32, y: i32): i32 x / y + x % y * 1000 fn main(): i32 divs(-47, 5) + 2100" 91)
+linc_program_test(compiled "fn remainder(x: i32, y: i32): i32 { r: mut i32 = x\; r %= y\; r } fn main(): i32 remainder(47, -5) + 10" 12)
+linc_program_test(compiled "fn shift(x: u32, n: u8): u32 x << n fn main(): i32 as i32 (shift(1u, 33u8))" 2)
+
+linc_program_test(optimized "fn main(): i32 { x := 4\; y := x * 2\; if y > 5 { 1 } else { 2 } }" 1 0)
+linc_program_test(optimized "fn main(): i32 { n: mut i32 = 1\; while n < 100 { n *= 3\; if n > 20 { break\; n = 0\; }\; continue\; n = 1000\; }\; return n\; n = 7\; n }" 27 7)
+linc_program_test(optimized "fn main(): i32 { n: mut i32 = 0\; unused := ++n\; dead := n * 2\; n }" 1 2)
+linc_program_test(compiled "fn divs(x: i32, y: i32): i32 x / y + x % y * 1000 fn main(): i32 { a: i32 = -47\; divs(a, 5) + 2100 }" 91)
+
+linc_program_test(inlining "counter: mut i32 = 0 fn next(): i32 { ++counter\; counter } fn combine(a: i32, b: i32, c: i32): i32 a * 100 + b * 10 + c fn main(): i32 combine(next(), next(), next())" 123)
+linc_program_test(inlining "counter: mut i32 = 0 fn bump(): i32 { ++counter\; counter } fn first(a: i32, b: i32): i32 a fn main(): i32 { x := first(5, bump())\; x * 10 + counter }" 51)
+linc_program_test(inlining "counter: mut i32 = 0 fn bump(): i32 { ++counter\; counter } fn twice(x: i32): i32 x + x fn main(): i32 twice(bump()) * 10 + counter" 21)
+linc_program_test(inlining "fn clamp(x: i32): i32 { if x > 10 { return 10\; }\; x } fn main(): i32 { n: mut i32 = 42\; clamp(n) + clamp(3) }" 13)
+linc_program_test(inlining "fn f1(x: i32): i32 x + 1 fn f2(x: i32): i32 f1(x) * 2 fn f3(x: i32): i32 f2(x) + 3 fn f4(x: i32): i32 f3(x) * 2 fn f5(x: i32): i32 f4(x) + 5 fn f6(x: i32): i32 f5(x) * 2 fn main(): i32 { n: mut i32 = 1\; f6(n) }" 38)
+linc_program_test(compiled "counter: mut i32 = 0 fn next(): i32 { ++counter\; counter } fn combine(a: i32, b: i32, c: i32): i32 a * 100 + b * 10 + c fn main(): i32 combine(next(), next(), next()) - 100" 23)
+linc_program_test(compiled "fn f1(x: i32): i32 x + 1 fn f2(x: i32): i32 f1(x) * 2 fn f3(x: i32): i32 f2(x) + 3 fn f4(x: i32): i32 f3(x) * 2 fn f5(x: i32): i32 f4(x) + 5 fn f6(x: i32): i32 f5(x) * 2 fn main(): i32 { n: mut i32 = 1\; f6(n) }" 38)
+
+# main() is pure as well, so its call is one more miss; cyclic calls over 32 arguments evict every result from a cache of 16
+linc_program_test(memoized "fn square(n: u64): u64 n * n fn main(): i32 { total: mut u64 = 0u64\; for(i: mut u64 = 0u64 i < 96u64 ++i\;) { total += square(i % 32u64)\; }\; as i32 (total % 256u64) }" 16 64 64 33)
+linc_program_test(memoized "fn square(n: u64): u64 n * n fn main(): i32 { total: mut u64 = 0u64\; for(i: mut u64 = 0u64 i < 96u64 ++i\;) { total += square(i % 32u64)\; }\; as i32 (total % 256u64) }" 16 32 64 33)
+linc_program_test(memoized "fn square(n: u64): u64 n * n fn main(): i32 { total: mut u64 = 0u64\; for(i: mut u64 = 0u64 i < 96u64 ++i\;) { total += square(i % 32u64)\; }\; as i32 (total % 256u64) }" 16 16 0 97)
+linc_program_test(memoized "fn show(x: f64): string @x fn main(): i32 { a := show(0.0d)\; b := show(-0.0d)\; if a == b { 1 } else { 2 } }" 2 16 0 3)
+
+linc_program_test(engines "fn pick(x: u8): i32 match x { 10u8 => 1, 11u8 => 2, 12u8 => 3, 11u8 => 40, 13u8 => 5 } fn main(): i32 { total: mut i32 = 0\; for(i: mut u8 = 8u8 i < 15u8 ++i\;) { total = total * 10 + pick(i)\; }\; total }" 12350)
+linc_program_test(engines "fn value(i: i32): i32 match i { 0 => 7, 1 => -1000, 2 => 3, 3 => 90000, 4 => 500, 5 => 8 } fn pick(x: i32): i32 match x { -1000 => 1, 7 => 2, 500 => 3, 7 => 40, 90000 => 4 } fn main(): i32 { total: mut i32 = 0\; for(i: mut i32 = 0 i < 6 ++i\;) { total = total * 10 + pick(value(i))\; }\; total }" 210430)
+linc_program_test(engines "fn letter(i: u64): char { word := \"abcxdba\"\; word[i] } fn pick(c: char): i32 match c { 'a' => 1, 'b' => 2, 'c' => 3, 'b' => 40, 'd' => 4 } fn main(): i32 { total: mut i32 = 0\; for(i: mut u64 = 0u64 i < 7u64 ++i\;) { total = total * 10 + pick(letter(i))\; }\; total }" 1230421)
+linc_program_test(engines "fn pick(s: string): i32 match s { \"red\" => 1, \"green\" => 2, \"blue\" => 3, \"red\" => 40, \"black\" => 4 } fn main(): i32 pick(\"blue\") * 1000 + pick(\"red\") * 100 + pick(\"white\") * 10 + pick(\"black\")" 3104)
+linc_program_test(engines "enum Color { Red, Green, Blue, Cyan, Magenta } fn pick(c: Color): i32 match c { Color::Red => 1, Color::Green => 2, Color::Blue => 3, Color::Green => 40, Color::Cyan => 4 } fn main(): i32 pick(Color::Cyan) * 1000 + pick(Color::Green) * 100 + pick(Color::Magenta) * 10 + pick(Color::Red)" 4201)
+linc_program_test(compiled "fn pick(x: u8): i32 match x { 10u8 => 1, 11u8 => 2, 12u8 => 3, 11u8 => 40, 13u8 => 5 } fn main(): i32 { total: mut i32 = 0\; for(i: mut u8 = 8u8 i < 15u8 ++i\;) { total = total * 10 + pick(i)\; }\; total }" 12350)
+linc_program_test(compiled "fn value(i: i32): i32 match i { 0 => 7, 1 => -1000, 2 => 3, 3 => 90000, 4 => 500, 5 => 8 } fn pick(x: i32): i32 match x { -1000 => 1, 7 => 2, 500 => 3, 7 => 40, 90000 => 4 } fn main(): i32 { total: mut i32 = 0\; for(i: mut i32 = 0 i < 6 ++i\;) { total = total * 10 + pick(value(i))\; }\; total }" 210430)
+linc_program_test(compiled "fn letter(i: u64): char { word := \"abcxdba\"\; word[i] } fn pick(c: char): i32 match c { 'a' => 1, 'b' => 2, 'c' => 3, 'b' => 40, 'd' => 4 } fn main(): i32 { total: mut i32 = 0\; for(i: mut u64 = 0u64 i < 7u64 ++i\;) { total = total * 10 + pick(letter(i))\; }\; total }" 1230421)
+
+add_test(PEEPHOLE_TEST_0 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "self moves")
+add_test(PEEPHOLE_TEST_1 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "push/pop elimination")
+add_test(PEEPHOLE_TEST_2 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "stack adjustments")
+add_test(PEEPHOLE_TEST_3 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "store-to-load forwarding")
+add_test(PEEPHOLE_TEST_4 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "set-test chains")
+add_test(PEEPHOLE_TEST_5 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "jump threading")
+add_test(PEEPHOLE_TEST_6 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "unreachable code")
+add_test(PEEPHOLE_TEST_7 ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/linctest --peephole "dead labels")